@@ -94,6 +94,13 @@ cp -Rf $MANTA_INSTALLATION/mantaflowgit/README.md $BLENDER_MANTA_EXTERN
 # Cleanup left over dir
 rm -r $BLENDER_TMP
 
+# Re-apply Blender's local modifications, see README.blender
+cd $BLENDER_INSTALLATION/blender/
+if ! git apply extern/mantaflow/patches/blender.patch; then
+  echo "Failed to apply extern/mantaflow/patches/blender.patch, update it for the new Mantaflow files"
+  exit 1
+fi
+
 echo "Successfully copied new Mantaflow files to" $BLENDER_INSTALLATION/blender/extern/mantaflow/
 
 # ==================== 6) CHECK CMAKE SETUP ==============================================
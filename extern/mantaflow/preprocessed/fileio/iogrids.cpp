@@ -974,10 +974,14 @@ template<> void writeGridVDB(const string &name, Grid<int> *grid)
 
   openvdb::io::File file(name);
 
+  // Only store non-background voxels so that empty regions stay sparse on disk.
   FOR_IJK(*grid)
   {
+    const int v = (*grid)(i, j, k);
+    if (v == 0)
+      continue;
     openvdb::Coord xyz(i, j, k);
-    accessor.setValue(xyz, (*grid)(i, j, k));
+    accessor.setValue(xyz, v);
   }
 
   // Add the grid pointer to a container.
@@ -1048,10 +1052,14 @@ template<> void writeGridVDB(const string &name, Grid<Real> *grid)
 
   openvdb::io::File file(name);
 
+  // Only store non-background voxels so that empty regions stay sparse on disk.
   FOR_IJK(*grid)
   {
+    const Real v = (*grid)(i, j, k);
+    if (v == 0)
+      continue;
     openvdb::Coord xyz(i, j, k);
-    accessor.setValue(xyz, (*grid)(i, j, k));
+    accessor.setValue(xyz, v);
   }
 
   // Add the grid pointer to a container.
@@ -1121,11 +1129,14 @@ template<> void writeGridVDB(const string &name, Grid<Vec3> *grid)
   gridVDB->setName(grid->getName());
 
   openvdb::io::File file(name);
+  // Only store non-background voxels so that empty regions stay sparse on disk.
   FOR_IJK(*grid)
   {
     openvdb::Coord xyz(i, j, k);
     Vec3 v = (*grid)(i, j, k);
     openvdb::Vec3f vo((float)v[0], (float)v[1], (float)v[2]);
+    if (vo == openvdb::Vec3f::zero())
+      continue;
     accessor.setValue(xyz, vo);
   }
 
@@ -749,6 +749,34 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_texture_limit
     )
 
+    use_texture_cache: BoolProperty(
+        name="Texture Cache",
+        description="Load image textures on demand in tiles and mipmap levels instead of loading full images, "
+        "keeping memory usage within the texture cache size (CPU only)",
+        default=False,
+    )
+
+    texture_cache_size: IntProperty(
+        name="Cache Size",
+        description="Maximum memory used by the texture cache, in megabytes",
+        min=64, max=1048576,
+        default=1024,
+    )
+
+    texture_cache_auto_convert: BoolProperty(
+        name="Auto Convert",
+        description="Convert images that are not tiled and mipmapped to .tx files in the cache directory, "
+        "so filtered mipmap levels are computed only once",
+        default=True,
+    )
+
+    texture_cache_path: StringProperty(
+        name="Cache Directory",
+        description="Absolute path of the directory for converted .tx files, the user cache directory when empty",
+        subtype='DIR_PATH',
+        default="",
+    )
+
     ao_bounces: IntProperty(
         name="AO Bounces",
         default=0,
@@ -1505,6 +1533,12 @@ class CyclesPreferences(bpy.types.AddonPreferences):
 
     devices: bpy.props.CollectionProperty(type=CyclesDeviceSettings)
 
+    peer_memory: BoolProperty(
+        name="Distribute memory across devices",
+        description="Make more room for large scenes to fit by distributing memory across interconnected devices (e.g. via NVLink) rather than duplicating it",
+        default=False,
+    )
+
     def find_existing_device_entry(self, device):
         for device_entry in self.devices:
             if device_entry.id == device[2] and device_entry.type == device[1]:
@@ -1611,6 +1645,10 @@ class CyclesPreferences(bpy.types.AddonPreferences):
         elif self.compute_device_type == 'OPENCL':
             self._draw_devices(row, 'OPENCL', devices)
 
+        if self.compute_device_type in {'CUDA', 'OPTIX'} and len(devices) > 1:
+            row = layout.row()
+            row.prop(self, "peer_memory")
+
     def draw(self, context):
         self.draw_impl(self.layout, context)
 
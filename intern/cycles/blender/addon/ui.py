@@ -718,7 +718,39 @@ class CYCLES_RENDER_PT_performance_final_render(CyclesButtonsPanel, Panel):
         col = layout.column()
 
         col.prop(rd, "use_save_buffers")
-        col.prop(rd, "use_persistent_data", text="Persistent Images")
+        sub = col.column()
+        sub.active = rd.use_save_buffers
+        sub.prop(rd, "use_save_buffers_half_float", text="Half Float")
+        col.prop(rd, "use_persistent_data", text="Persistent Data")
+
+
+class CYCLES_RENDER_PT_performance_texture_cache(CyclesButtonsPanel, Panel):
+    bl_label = "Texture Cache"
+    bl_parent_id = "CYCLES_RENDER_PT_performance"
+    bl_options = {'DEFAULT_CLOSED'}
+
+    def draw_header(self, context):
+        layout = self.layout
+        cscene = context.scene.cycles
+
+        layout.active = use_cpu(context)
+        layout.prop(cscene, "use_texture_cache", text="")
+
+    def draw(self, context):
+        layout = self.layout
+        layout.use_property_split = True
+        layout.use_property_decorate = False
+
+        cscene = context.scene.cycles
+
+        layout.active = cscene.use_texture_cache and use_cpu(context)
+
+        col = layout.column()
+        col.prop(cscene, "texture_cache_size")
+        col.prop(cscene, "texture_cache_auto_convert")
+        sub = col.column()
+        sub.active = cscene.texture_cache_auto_convert
+        sub.prop(cscene, "texture_cache_path", text="Directory")
 
 
 class CYCLES_RENDER_PT_performance_viewport(CyclesButtonsPanel, Panel):
@@ -2294,6 +2326,7 @@ classes = (
     CYCLES_RENDER_PT_performance_tiles,
     CYCLES_RENDER_PT_performance_acceleration_structure,
     CYCLES_RENDER_PT_performance_final_render,
+    CYCLES_RENDER_PT_performance_texture_cache,
     CYCLES_RENDER_PT_performance_viewport,
     CYCLES_RENDER_PT_passes,
     CYCLES_RENDER_PT_passes_data,
@@ -109,6 +109,14 @@ DeviceInfo blender_device_info(BL::Preferences &b_preferences, BL::Scene &b_scen
       if (!used_devices.empty()) {
         int threads = blender_device_threads(b_scene);
         device = Device::get_multi_device(used_devices, threads, background);
+
+        /* Share scene memory between devices that can access each other's memory. */
+        if (!device.multi_devices.empty() && get_boolean(cpreferences, "peer_memory")) {
+          device.has_peer_memory = true;
+          foreach (DeviceInfo &subinfo, device.multi_devices) {
+            subinfo.has_peer_memory = true;
+          }
+        }
       }
       /* Else keep using the CPU device that was set before. */
     }
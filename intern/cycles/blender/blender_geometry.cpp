@@ -29,7 +29,8 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
                                      BL::Object &b_ob,
                                      BL::Object &b_ob_instance,
                                      bool object_updated,
-                                     bool use_particle_hair)
+                                     bool use_particle_hair,
+                                     vector<TaskRunFunction> *geom_tasks)
 {
   /* Test if we can instance or if the object is modified. */
   BL::ID b_ob_data = b_ob.data();
@@ -81,6 +82,16 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
     sync = geometry_map.update(geom, b_key_id);
   }
 
+  /* Even if not tagged for recalc, we may need to sync anyway
+   * because the shader needs different geometry attributes. */
+  bool attribute_recalc = false;
+
+  foreach (Shader *shader, geom->used_shaders) {
+    if (shader->need_update_geometry) {
+      attribute_recalc = true;
+    }
+  }
+
   if (!sync) {
     /* If transform was applied to geometry, need full update. */
     if (object_updated && geom->transform_applied) {
@@ -91,20 +102,8 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
     else if (geom->used_shaders != used_shaders) {
       ;
     }
-    else {
-      /* Even if not tagged for recalc, we may need to sync anyway
-       * because the shader needs different geometry attributes. */
-      bool attribute_recalc = false;
-
-      foreach (Shader *shader, geom->used_shaders) {
-        if (shader->need_update_geometry) {
-          attribute_recalc = true;
-        }
-      }
-
-      if (!attribute_recalc) {
-        return geom;
-      }
+    else if (!attribute_recalc) {
+      return geom;
     }
   }
 
@@ -113,32 +112,70 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
     return geom;
   }
 
-  progress.set_sync_status("Synchronizing object", b_ob.name());
-
   geometry_synced.insert(geom);
 
   geom->name = ustring(b_ob_data.name().c_str());
 
   if (use_particle_hair) {
+    progress.set_sync_status("Synchronizing object", b_ob.name());
     sync_hair(b_depsgraph, b_ob, geom, used_shaders);
+    return geom;
   }
-  else if (object_fluid_gas_domain_find(b_ob)) {
-    Mesh *mesh = static_cast<Mesh *>(geom);
-    sync_volume(b_ob, mesh, used_shaders);
+
+  /* Data tagged for recalc often did not actually change, as with objects that only moved
+   * or depend on the frame through a driver. Such meshes can keep their existing data as
+   * long as nothing else that goes into the export changed either. */
+  const bool use_content_hash = sync && geom->used_shaders == used_shaders &&
+                                !attribute_recalc && !geom->transform_applied &&
+                                scene->need_motion() == Scene::MOTION_NONE;
+
+  Mesh *mesh = static_cast<Mesh *>(geom);
+
+  if (geom_tasks) {
+    /* For instances b_ob is a temporary that only lives while iterating, the instanced
+     * object has the same evaluated data and stays valid until the deferred export. */
+    geom_tasks->push_back(function_bind(&BlenderSync::sync_surface_geometry,
+                                        this,
+                                        b_depsgraph,
+                                        b_ob_instance,
+                                        mesh,
+                                        used_shaders,
+                                        use_content_hash));
   }
   else {
-    Mesh *mesh = static_cast<Mesh *>(geom);
-    sync_mesh(b_depsgraph, b_ob, mesh, used_shaders);
+    sync_surface_geometry(b_depsgraph, b_ob, mesh, used_shaders, use_content_hash);
   }
 
   return geom;
 }
 
+void BlenderSync::sync_surface_geometry(BL::Depsgraph b_depsgraph,
+                                        BL::Object b_ob,
+                                        Mesh *mesh,
+                                        const vector<Shader *> &used_shaders,
+                                        bool use_content_hash)
+{
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  progress.set_sync_status("Synchronizing object", b_ob.name());
+
+  if (object_fluid_gas_domain_find(b_ob)) {
+    sync_volume(b_ob, mesh, used_shaders);
+  }
+  else {
+    sync_mesh(b_depsgraph, b_ob, mesh, used_shaders, use_content_hash);
+  }
+}
+
 void BlenderSync::sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                                        BL::Object &b_ob,
+                                       BL::Object &b_ob_instance,
                                        Object *object,
                                        float motion_time,
-                                       bool use_particle_hair)
+                                       bool use_particle_hair,
+                                       vector<TaskRunFunction> *geom_tasks)
 {
   /* Ensure we only sync instanced geometry once. */
   Geometry *geom = object->geometry;
@@ -165,6 +202,11 @@ void BlenderSync::sync_geometry_motion(BL::Depsgraph &b_depsgraph,
   else if (object_fluid_gas_domain_find(b_ob)) {
     /* No volume motion blur support yet. */
   }
+  else if (geom_tasks) {
+    Mesh *mesh = static_cast<Mesh *>(geom);
+    geom_tasks->push_back(function_bind(
+        &BlenderSync::sync_mesh_motion, this, b_depsgraph, b_ob_instance, mesh, motion_step));
+  }
   else {
     Mesh *mesh = static_cast<Mesh *>(geom);
     sync_mesh_motion(b_depsgraph, b_ob, mesh, motion_step);
@@ -746,18 +746,16 @@ static void create_mesh(Scene *scene,
   mesh->reserve_mesh(numverts, numtris);
   mesh->reserve_subd_faces(numfaces, numngons, numcorners);
 
-  /* create vertex coordinates and normals */
-  BL::Mesh::vertices_iterator v;
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v)
-    mesh->add_vertex(get_float3(v->co()));
+  /* create vertex coordinates and normals, read straight from the Blender mesh arrays
+   * since going through RNA for every element dominates the export time */
+  mesh->verts.resize(numverts, make_float3(0.0f, 0.0f, 0.0f));
 
   AttributeSet &attributes = (subdivision) ? mesh->subd_attributes : mesh->attributes;
   Attribute *attr_N = attributes.add(ATTR_STD_VERTEX_NORMAL);
   float3 *N = attr_N->data_float3();
 
-  for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v, ++N)
-    *N = get_float3(v->normal());
-  N = attr_N->data_float3();
+  BKE_mesh_vert_coords_normals_get_strided(
+      b_mesh.ptr.data, &mesh->verts[0].x, &N->x, sizeof(float3) / sizeof(float));
 
   /* create generated coordinates from undeformed coordinates */
   const bool need_default_tangent = (subdivision == false) && (b_mesh.uv_layers.length() == 0) &&
@@ -772,6 +770,7 @@ static void create_mesh(Scene *scene,
     float3 *generated = attr->data_float3();
     size_t i = 0;
 
+    BL::Mesh::vertices_iterator v;
     for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end(); ++v) {
       generated[i++] = get_float3(v->undeformed_co()) * size - loc;
     }
@@ -779,28 +778,35 @@ static void create_mesh(Scene *scene,
 
   /* create faces */
   if (!subdivision) {
-    BL::Mesh::loop_triangles_iterator t;
+    /* Create triangles. Material indices are filled into the shader array and then
+     * clamped to the used shaders in place.
+     *
+     * NOTE: Autosmooth is already taken care about.
+     */
+    mesh->triangles.resize(numtris * 3);
+    mesh->shader.resize(numtris);
+    mesh->smooth.resize(numtris);
 
-    for (b_mesh.loop_triangles.begin(t); t != b_mesh.loop_triangles.end(); ++t) {
-      BL::MeshPolygon p = b_mesh.polygons[t->polygon_index()];
-      int3 vi = get_int3(t->vertices());
+    BKE_mesh_runtime_looptri_export(
+        b_mesh.ptr.data, &mesh->triangles[0], &mesh->shader[0], &mesh->smooth[0]);
+
+    const int max_shader = used_shaders.size() - 1;
+    for (int i = 0; i < numtris; i++) {
+      mesh->shader[i] = clamp(mesh->shader[i], 0, max_shader);
+      mesh->smooth[i] = mesh->smooth[i] || use_loop_normals;
+    }
 
-      int shader = clamp(p.material_index(), 0, used_shaders.size() - 1);
-      bool smooth = p.use_smooth() || use_loop_normals;
+    if (use_loop_normals) {
+      BL::Mesh::loop_triangles_iterator t;
 
-      if (use_loop_normals) {
+      for (b_mesh.loop_triangles.begin(t); t != b_mesh.loop_triangles.end(); ++t) {
+        int3 vi = get_int3(t->vertices());
         BL::Array<float, 9> loop_normals = t->split_normals();
         for (int i = 0; i < 3; i++) {
           N[vi[i]] = make_float3(
               loop_normals[i * 3], loop_normals[i * 3 + 1], loop_normals[i * 3 + 2]);
         }
       }
-
-      /* Create triangles.
-       *
-       * NOTE: Autosmooth is already taken care about.
-       */
-      mesh->add_triangle(vi[0], vi[1], vi[2], shader, smooth);
     }
   }
   else {
@@ -944,44 +950,63 @@ static void sync_mesh_fluid_motion(BL::Object &b_ob, Scene *scene, Mesh *mesh)
 void BlenderSync::sync_mesh(BL::Depsgraph b_depsgraph,
                             BL::Object b_ob,
                             Mesh *mesh,
-                            const vector<Shader *> &used_shaders)
+                            const vector<Shader *> &used_shaders,
+                            bool use_content_hash)
 {
-  array<int> oldtriangles;
-  array<Mesh::SubdFace> oldsubd_faces;
-  array<int> oldsubd_face_corners;
-  oldtriangles.steal_data(mesh->triangles);
-  oldsubd_faces.steal_data(mesh->subd_faces);
-  oldsubd_face_corners.steal_data(mesh->subd_face_corners);
-
-  mesh->clear();
-  mesh->used_shaders = used_shaders;
-
-  mesh->subdivision_type = Mesh::SUBDIVISION_NONE;
+  Mesh::SubdivisionType subdivision_type = Mesh::SUBDIVISION_NONE;
+  BL::Mesh b_mesh(PointerRNA_NULL);
+  uint source_hash = 0;
 
   if (view_layer.use_surfaces) {
     /* Adaptive subdivision setup. Not for baking since that requires
      * exact mapping to the Blender mesh. */
     if (!scene->bake_manager->get_baking()) {
-      mesh->subdivision_type = object_subdivision_type(b_ob, preview, experimental);
+      subdivision_type = object_subdivision_type(b_ob, preview, experimental);
     }
 
+    /* Attribute requests come from the shaders, so those are set before converting. */
+    mesh->used_shaders = used_shaders;
+
     /* For some reason, meshes do not need this... */
     bool need_undeformed = mesh->need_attribute(scene, ATTR_STD_GENERATED);
-    BL::Mesh b_mesh = object_to_mesh(
-        b_data, b_ob, b_depsgraph, need_undeformed, mesh->subdivision_type);
+    b_mesh = object_to_mesh(b_data, b_ob, b_depsgraph, need_undeformed, subdivision_type);
 
     if (b_mesh) {
-      /* Sync mesh itself. */
-      if (mesh->subdivision_type != Mesh::SUBDIVISION_NONE)
-        create_subd_mesh(
-            scene, mesh, b_ob, b_mesh, mesh->used_shaders, dicing_rate, max_subdivisions);
-      else
-        create_mesh(scene, mesh, b_mesh, mesh->used_shaders, false);
-
-      free_object_to_mesh(b_data, b_ob, b_mesh);
+      source_hash = BKE_mesh_content_hash(b_mesh.ptr.data);
     }
   }
 
+  /* Keep the existing data if the Blender mesh is identical to the one it was created from.
+   * Subdivision depends on the camera through the dicing rate, so it is always redone. */
+  if (use_content_hash && b_mesh && subdivision_type == Mesh::SUBDIVISION_NONE &&
+      mesh->subdivision_type == Mesh::SUBDIVISION_NONE && source_hash == mesh->source_hash) {
+    free_object_to_mesh(b_data, b_ob, b_mesh);
+    return;
+  }
+
+  array<int> oldtriangles;
+  array<Mesh::SubdFace> oldsubd_faces;
+  array<int> oldsubd_face_corners;
+  oldtriangles.steal_data(mesh->triangles);
+  oldsubd_faces.steal_data(mesh->subd_faces);
+  oldsubd_face_corners.steal_data(mesh->subd_face_corners);
+
+  mesh->clear();
+  mesh->used_shaders = used_shaders;
+  mesh->subdivision_type = subdivision_type;
+  mesh->source_hash = source_hash;
+
+  if (b_mesh) {
+    /* Sync mesh itself. */
+    if (mesh->subdivision_type != Mesh::SUBDIVISION_NONE)
+      create_subd_mesh(
+          scene, mesh, b_ob, b_mesh, mesh->used_shaders, dicing_rate, max_subdivisions);
+    else
+      create_mesh(scene, mesh, b_mesh, mesh->used_shaders, false);
+
+    free_object_to_mesh(b_data, b_ob, b_mesh);
+  }
+
   /* mesh fluid motion mantaflow */
   sync_mesh_fluid_motion(b_ob, scene, mesh);
 
@@ -1039,12 +1064,18 @@ void BlenderSync::sync_mesh_motion(BL::Depsgraph b_depsgraph,
     /* NOTE: We don't copy more that existing amount of vertices to prevent
      * possible memory corruption.
      */
-    BL::Mesh::vertices_iterator v;
-    int i = 0;
-    for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end() && i < numverts; ++v, ++i) {
-      mP[i] = get_float3(v->co());
-      if (mN)
-        mN[i] = get_float3(v->normal());
+    if (b_mesh.vertices.length() == numverts) {
+      BKE_mesh_vert_coords_normals_get_strided(
+          b_mesh.ptr.data, &mP->x, (mN) ? &mN->x : NULL, sizeof(float3) / sizeof(float));
+    }
+    else {
+      BL::Mesh::vertices_iterator v;
+      int i = 0;
+      for (b_mesh.vertices.begin(v); v != b_mesh.vertices.end() && i < numverts; ++v, ++i) {
+        mP[i] = get_float3(v->co());
+        if (mN)
+          mN[i] = get_float3(v->normal());
+      }
     }
     if (new_attribute) {
       /* In case of new attribute, we verify if there really was any motion. */
@@ -97,7 +97,8 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
                                  bool use_particle_hair,
                                  bool show_lights,
                                  BlenderObjectCulling &culling,
-                                 bool *use_portal)
+                                 bool *use_portal,
+                                 vector<TaskRunFunction> *geom_tasks)
 {
   const bool is_instance = b_instance.is_instance();
   BL::Object b_ob = b_instance.object();
@@ -192,7 +193,13 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
 
       /* mesh deformation */
       if (object->geometry)
-        sync_geometry_motion(b_depsgraph, b_ob, object, motion_time, use_particle_hair);
+        sync_geometry_motion(b_depsgraph,
+                             b_ob,
+                             b_ob_instance,
+                             object,
+                             motion_time,
+                             use_particle_hair,
+                             geom_tasks);
     }
 
     return object;
@@ -206,7 +213,7 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
 
   /* mesh sync */
   object->geometry = sync_geometry(
-      b_depsgraph, b_ob, b_ob_instance, object_updated, use_particle_hair);
+      b_depsgraph, b_ob, b_ob_instance, object_updated, use_particle_hair, geom_tasks);
 
   /* special case not tracked by object update flags */
 
@@ -247,9 +254,12 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
 
   /* object sync
    * transform comparison should not be needed, but duplis don't work perfect
-   * in the depsgraph and may not signal changes, so this is a workaround */
-  if (object_updated || (object->geometry && object->geometry->need_update) ||
-      tfm != object->tfm) {
+   * in the depsgraph and may not signal changes, so this is a workaround.
+   * Geometry may still be waiting to be exported, so test if it is synced in this
+   * pass rather than looking at its update flag. */
+  bool geometry_updated = object->geometry &&
+                          geometry_synced.find(object->geometry) != geometry_synced.end();
+  if (object_updated || geometry_updated || tfm != object->tfm) {
     object->name = b_ob.name().c_str();
     object->pass_id = b_ob.pass_index();
     object->color = get_float3(b_ob.color());
@@ -337,6 +347,10 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
   /* initialize culling */
   BlenderObjectCulling culling(scene, b_scene);
 
+  /* Geometry export is collected during the object loop and run in parallel afterwards,
+   * so that the loop never reads geometry that is being written to. */
+  vector<TaskRunFunction> geom_tasks;
+
   /* object loop */
   bool cancel = false;
   bool use_portal = false;
@@ -369,7 +383,8 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
                   false,
                   show_lights,
                   culling,
-                  &use_portal);
+                  &use_portal,
+                  &geom_tasks);
     }
 
     /* Particle hair as separate object. */
@@ -381,8 +396,19 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
                   true,
                   show_lights,
                   culling,
-                  &use_portal);
+                  &use_portal,
+                  &geom_tasks);
+    }
+
+    cancel = progress.get_cancel();
+  }
+
+  if (!cancel) {
+    TaskPool geom_task_pool;
+    foreach (TaskRunFunction &task, geom_tasks) {
+      geom_task_pool.push(task);
     }
+    geom_task_pool.wait_work();
 
     cancel = progress.get_cancel();
   }
@@ -693,7 +693,10 @@ void BlenderSync::free_data_after_sync(BL::Depsgraph &b_depsgraph)
    * footprint during synchronization process.
    */
   const bool is_interface_locked = b_engine.render() && b_engine.render().use_lock_interface();
-  const bool can_free_caches = BlenderSession::headless || is_interface_locked;
+  /* Persistent data reuses the evaluated data for the next frame. */
+  const bool is_persistent_data = b_engine.render() && b_engine.render().use_persistent_data();
+  const bool can_free_caches = (BlenderSession::headless || is_interface_locked) &&
+                               !is_persistent_data;
   if (!can_free_caches) {
     return;
   }
@@ -748,6 +751,11 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
     params.texture_limit = 0;
   }
 
+  params.use_texture_cache = RNA_boolean_get(&cscene, "use_texture_cache");
+  params.texture_cache_size = RNA_int_get(&cscene, "texture_cache_size");
+  params.texture_cache_auto_convert = RNA_boolean_get(&cscene, "texture_cache_auto_convert");
+  params.texture_cache_path = get_string(cscene, "texture_cache_path");
+
   /* TODO(sergey): Once OSL supports per-microarchitecture optimization get
    * rid of this.
    */
@@ -30,6 +30,7 @@
 
 #include "util/util_map.h"
 #include "util/util_set.h"
+#include "util/util_task.h"
 #include "util/util_transform.h"
 #include "util/util_vector.h"
 
@@ -136,7 +137,8 @@ class BlenderSync {
                       bool use_particle_hair,
                       bool show_lights,
                       BlenderObjectCulling &culling,
-                      bool *use_portal);
+                      bool *use_portal,
+                      vector<TaskRunFunction> *geom_tasks);
 
   /* Volume */
   void sync_volume(BL::Object &b_ob, Mesh *mesh, const vector<Shader *> &used_shaders);
@@ -145,7 +147,8 @@ class BlenderSync {
   void sync_mesh(BL::Depsgraph b_depsgraph,
                  BL::Object b_ob,
                  Mesh *mesh,
-                 const vector<Shader *> &used_shaders);
+                 const vector<Shader *> &used_shaders,
+                 bool use_content_hash);
   void sync_mesh_motion(BL::Depsgraph b_depsgraph, BL::Object b_ob, Mesh *mesh, int motion_step);
 
   /* Hair */
@@ -171,12 +174,20 @@ class BlenderSync {
                           BL::Object &b_ob,
                           BL::Object &b_ob_instance,
                           bool object_updated,
-                          bool use_particle_hair);
+                          bool use_particle_hair,
+                          vector<TaskRunFunction> *geom_tasks);
   void sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                             BL::Object &b_ob,
+                            BL::Object &b_ob_instance,
                             Object *object,
                             float motion_time,
-                            bool use_particle_hair);
+                            bool use_particle_hair,
+                            vector<TaskRunFunction> *geom_tasks);
+  void sync_surface_geometry(BL::Depsgraph b_depsgraph,
+                             BL::Object b_ob,
+                             Mesh *mesh,
+                             const vector<Shader *> &used_shaders,
+                             bool use_content_hash);
 
   /* Light */
   void sync_light(BL::Object &b_parent,
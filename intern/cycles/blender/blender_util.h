@@ -36,6 +36,15 @@ void BKE_image_user_frame_calc(void *ima, void *iuser, int cfra);
 void BKE_image_user_file_path(void *iuser, void *ima, char *path);
 unsigned char *BKE_image_get_pixels_for_frame(void *image, int frame, int tile);
 float *BKE_image_get_float_pixels_for_frame(void *image, int frame, int tile);
+unsigned int BKE_mesh_content_hash(const void *mesh);
+void BKE_mesh_vert_coords_normals_get_strided(const void *mesh,
+                                              float *r_coords,
+                                              float *r_normals,
+                                              int stride);
+void BKE_mesh_runtime_looptri_export(void *mesh,
+                                     int *r_tri_verts,
+                                     int *r_tri_mat_nr,
+                                     bool *r_tri_smooth);
 }
 
 CCL_NAMESPACE_BEGIN
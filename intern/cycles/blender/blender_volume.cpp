@@ -81,6 +81,7 @@ void BlenderSync::sync_volume(BL::Object &b_ob, Mesh *mesh, const vector<Shader
 
   mesh->clear();
   mesh->used_shaders = used_shaders;
+  mesh->source_hash = 0;
 
   /* Smoke domain. */
   sync_smoke_volume(scene, b_ob, mesh, b_scene.frame_current());
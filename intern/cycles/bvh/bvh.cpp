@@ -103,7 +103,13 @@ int BVHStackEntry::encodeIdx() const
 BVH::BVH(const BVHParams &params_,
          const vector<Geometry *> &geometry_,
          const vector<Object *> &objects_)
-    : params(params_), geometry(geometry_), objects(objects_)
+    : params(params_),
+      geometry(geometry_),
+      objects(objects_),
+      build_sah_cost(0.0f),
+      sah_cost(0.0f),
+      pack_modified(false),
+      refit_sah_area(0.0f)
 {
 }
 
@@ -175,6 +181,9 @@ void BVH::build(Progress &progress, Stats *)
     return;
   }
 
+  build_sah_cost = root->computeSubtreeSAHCost(params);
+  sah_cost = build_sah_cost;
+
   /* pack triangles */
   progress.set_substatus("Packing BVH triangles and strands");
   pack_primitives();
@@ -187,6 +196,7 @@ void BVH::build(Progress &progress, Stats *)
   /* pack nodes */
   progress.set_substatus("Packing BVH nodes");
   pack_nodes(root);
+  pack_modified = true;
 
   /* free build nodes */
   root->deleteSubtree();
@@ -196,14 +206,37 @@ void BVH::build(Progress &progress, Stats *)
 
 void BVH::refit(Progress &progress)
 {
+  /* Instanced BVH's might have been refitted or rebuilt as well, so the top level arrays are
+   * stripped down to their own part and the instances merged in again. */
+  if (params.top_level) {
+    unpack_instances();
+  }
+
   progress.set_substatus("Packing BVH primitives");
   pack_primitives();
 
   if (progress.get_cancel())
     return;
 
+  if (params.top_level) {
+    pack_instances(pack.top_level_nodes_size, pack.top_level_leaf_nodes_size);
+  }
+
   progress.set_substatus("Refitting BVH nodes");
+  refit_sah_area = 0.0f;
   refit_nodes();
+  pack_modified = true;
+}
+
+void BVH::refit_sah_add(const BoundBox &bounds, int num_children, int num_primitives)
+{
+  refit_sah_area += bounds.safe_area() * params.cost(num_children, num_primitives);
+}
+
+void BVH::refit_sah_finish(const BoundBox &root_bounds)
+{
+  const float root_area = root_bounds.safe_area();
+  sah_cost = (root_area > 0.0f) ? refit_sah_area / root_area : 0.0f;
 }
 
 void BVH::refit_primitives(int start, int end, BoundBox &bbox, uint &visibility)
@@ -305,12 +338,10 @@ void BVH::pack_primitives()
       }
     }
   }
-  /* Reserve size for arrays. */
-  pack.prim_tri_index.clear();
+  /* Reserve size for arrays. Existing data is not cleared, for the top level BVH the data of
+   * instances is kept in place past these sizes when refitting. */
   pack.prim_tri_index.resize(tidx_size);
-  pack.prim_tri_verts.clear();
   pack.prim_tri_verts.resize(num_prim_triangles * 3);
-  pack.prim_visibility.clear();
   pack.prim_visibility.resize(tidx_size);
   /* Fill in all the arrays. */
   size_t prim_triangle_index = 0;
@@ -349,6 +380,10 @@ void BVH::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
   const bool use_qbvh = (params.bvh_layout == BVH_LAYOUT_BVH4);
   const bool use_obvh = (params.bvh_layout == BVH_LAYOUT_BVH8);
 
+  pack.top_level_prim_size = pack.prim_index.size();
+  pack.top_level_nodes_size = nodes_size;
+  pack.top_level_leaf_nodes_size = leaf_nodes_size;
+
   /* Adjust primitive index to point to the triangle in the global array, for
    * geometry with transform applied and already in the top level BVH.
    */
@@ -449,6 +484,31 @@ void BVH::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
 
     geometry_map[geom] = pack.object_node[object_offset - 1];
 
+    /* Skip copying instance data that is unchanged and still in place. */
+    const PackedInstance packed_instance = {bvh,
+                                            geom_prim_offset,
+                                            pack_prim_index_offset,
+                                            pack_prim_tri_verts_offset,
+                                            pack_nodes_offset,
+                                            pack_leaf_nodes_offset};
+    map<const Geometry *, PackedInstance>::iterator packed_it = packed_instances.find(geom);
+    const bool is_packed = !bvh->pack_modified && packed_it != packed_instances.end() &&
+                           packed_it->second == packed_instance;
+    packed_instances[geom] = packed_instance;
+    bvh->pack_modified = false;
+
+    if (is_packed) {
+      pack_prim_index_offset += bvh->pack.prim_index.size();
+      pack_prim_tri_verts_offset += bvh->pack.prim_tri_verts.size();
+      pack_nodes_offset += bvh->pack.nodes.size();
+      pack_leaf_nodes_offset += bvh->pack.leaf_nodes.size();
+
+      nodes_offset += bvh->pack.nodes.size();
+      nodes_leaf_offset += bvh->pack.leaf_nodes.size();
+      prim_offset += bvh->pack.prim_index.size();
+      continue;
+    }
+
     /* merge primitive, object and triangle indexes */
     if (bvh->pack.prim_index.size()) {
       size_t bvh_prim_index_size = bvh->pack.prim_index.size();
@@ -577,4 +637,25 @@ void BVH::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
   }
 }
 
+void BVH::unpack_instances()
+{
+  const size_t prim_size = pack.top_level_prim_size;
+
+  pack.prim_index.resize(prim_size);
+  pack.prim_type.resize(prim_size);
+  pack.prim_object.resize(prim_size);
+  if (pack.prim_time.size()) {
+    pack.prim_time.resize(prim_size);
+  }
+  pack.nodes.resize(pack.top_level_nodes_size);
+  pack.leaf_nodes.resize(pack.top_level_leaf_nodes_size);
+
+  /* Primitive indices are local to their geometry again, as when packing after a build. */
+  for (size_t i = 0; i < prim_size; i++) {
+    if (pack.prim_index[i] != -1) {
+      pack.prim_index[i] -= objects[pack.prim_object[i]]->geometry->prim_offset;
+    }
+  }
+}
+
 CCL_NAMESPACE_END
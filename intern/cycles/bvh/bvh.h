@@ -20,6 +20,7 @@
 
 #include "bvh/bvh_params.h"
 #include "util/util_array.h"
+#include "util/util_map.h"
 #include "util/util_types.h"
 #include "util/util_vector.h"
 
@@ -70,9 +71,18 @@ struct PackedBVH {
   /* index of the root node. */
   int root_index;
 
+  /* Number of top level primitives, inner and leaf nodes, before instanced BVH's were merged
+   * in. Needed to refit only the top level part of the tree. */
+  size_t top_level_prim_size;
+  size_t top_level_nodes_size;
+  size_t top_level_leaf_nodes_size;
+
   PackedBVH()
   {
     root_index = 0;
+    top_level_prim_size = 0;
+    top_level_nodes_size = 0;
+    top_level_leaf_nodes_size = 0;
   }
 };
 
@@ -87,6 +97,13 @@ class BVH {
   vector<Geometry *> geometry;
   vector<Object *> objects;
 
+  /* Surface area heuristic cost of the tree when it was built, and after the last refit. */
+  float build_sah_cost;
+  float sah_cost;
+
+  /* Packed data changed since it was last merged into a top level BVH. */
+  bool pack_modified;
+
   static BVH *create(const BVHParams &params,
                      const vector<Geometry *> &geometry,
                      const vector<Object *> &objects);
@@ -101,6 +118,13 @@ class BVH {
 
   void refit(Progress &progress);
 
+  /* Refitting keeps the topology of the tree, which gets increasingly inefficient to traverse
+   * as primitives move away from where they were when it was built. */
+  bool need_rebuild_after_refit() const
+  {
+    return sah_cost > build_sah_cost * params.refit_max_sah_ratio;
+  }
+
  protected:
   BVH(const BVHParams &params,
       const vector<Geometry *> &geometry,
@@ -109,6 +133,34 @@ class BVH {
   /* Refit range of primitives. */
   void refit_primitives(int start, int end, BoundBox &bbox, uint &visibility);
 
+  /* Accumulate SAH cost of refitted nodes, normalized by the root bounds when done. */
+  float refit_sah_area;
+  void refit_sah_add(const BoundBox &bounds, int num_children, int num_primitives);
+  void refit_sah_finish(const BoundBox &root_bounds);
+
+  /* Restore top level arrays as they were before merging instances. */
+  void unpack_instances();
+
+  /* Where the BVH of an instanced geometry was merged into the top level arrays. When refitting,
+   * instances that are unchanged and still at the same place are not copied again. */
+  struct PackedInstance {
+    const BVH *bvh;
+    int geom_prim_offset;
+    size_t prim_offset;
+    size_t prim_tri_verts_offset;
+    size_t nodes_offset;
+    size_t leaf_nodes_offset;
+
+    bool operator==(const PackedInstance &other) const
+    {
+      return bvh == other.bvh && geom_prim_offset == other.geom_prim_offset &&
+             prim_offset == other.prim_offset &&
+             prim_tri_verts_offset == other.prim_tri_verts_offset &&
+             nodes_offset == other.nodes_offset && leaf_nodes_offset == other.leaf_nodes_offset;
+    }
+  };
+  map<const Geometry *, PackedInstance> packed_instances;
+
   /* triangles and strands */
   void pack_primitives();
   void pack_triangle(int idx, float4 storage[3]);
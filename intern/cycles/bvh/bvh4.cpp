@@ -375,11 +375,10 @@ void BVH4::pack_nodes(const BVHNode *root)
 
 void BVH4::refit_nodes()
 {
-  assert(!params.top_level);
-
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
   refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+  refit_sah_finish(bbox);
 }
 
 void BVH4::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
@@ -390,6 +389,7 @@ void BVH4::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     int4 c = data[0];
 
     BVH::refit_primitives(c.x, c.y, bbox, visibility);
+    refit_sah_add(bbox, 0, c.y - c.x);
 
     /* TODO(sergey): This is actually a copy of pack_leaf(),
      * but this chunk of code only knows actual data and has
@@ -441,6 +441,8 @@ void BVH4::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     else {
       pack_aligned_node(idx, child_bbox, &c[0], visibility, 0.0f, 1.0f, num_nodes);
     }
+
+    refit_sah_add(bbox, num_nodes, 0);
   }
 }
 
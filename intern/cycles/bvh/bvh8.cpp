@@ -406,11 +406,10 @@ void BVH8::pack_nodes(const BVHNode *root)
 
 void BVH8::refit_nodes()
 {
-  assert(!params.top_level);
-
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
   refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+  refit_sah_finish(bbox);
 }
 
 void BVH8::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
@@ -485,6 +484,8 @@ void BVH8::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
       visibility |= ob->visibility;
     }
 
+    refit_sah_add(bbox, 0, c.y - c.x);
+
     float4 leaf_data[BVH_ONODE_LEAF_SIZE];
     leaf_data[0].x = __int_as_float(c.x);
     leaf_data[0].y = __int_as_float(c.y);
@@ -537,6 +538,8 @@ void BVH8::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     else {
       pack_aligned_node(idx, child_bbox, child, visibility, 0.0f, 1.0f, num_nodes);
     }
+
+    refit_sah_add(bbox, num_nodes, 0);
   }
 }
 
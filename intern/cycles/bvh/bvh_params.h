@@ -56,6 +56,10 @@ class BVHParams {
   float sah_node_cost;
   float sah_primitive_cost;
 
+  /* Refitted trees keep their topology, and get rebuilt once their SAH cost exceeds the cost
+   * at build time by this factor. */
+  float refit_max_sah_ratio;
+
   /* number of primitives in leaf */
   int min_leaf_size;
   int max_triangle_leaf_size;
@@ -107,6 +111,8 @@ class BVHParams {
     sah_node_cost = 1.0f;
     sah_primitive_cost = 1.0f;
 
+    refit_max_sah_ratio = 1.5f;
+
     min_leaf_size = 1;
     max_triangle_leaf_size = 8;
     max_motion_triangle_leaf_size = 8;
@@ -126,6 +132,19 @@ class BVHParams {
     curve_subdivisions = 4;
   }
 
+  /* Parameters that change how the tree is built, so refitting an existing tree is not
+   * possible. */
+  bool modified(const BVHParams &params) const
+  {
+    return !(top_level == params.top_level && bvh_layout == params.bvh_layout &&
+             use_spatial_split == params.use_spatial_split &&
+             use_unaligned_nodes == params.use_unaligned_nodes &&
+             num_motion_curve_steps == params.num_motion_curve_steps &&
+             num_motion_triangle_steps == params.num_motion_triangle_steps &&
+             bvh_type == params.bvh_type && curve_flags == params.curve_flags &&
+             curve_subdivisions == params.curve_subdivisions);
+  }
+
   /* SAH costs */
   __forceinline float cost(int num_nodes, int num_primitives) const
   {
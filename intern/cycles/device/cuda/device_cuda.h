@@ -118,6 +118,8 @@ class CUDADevice : public Device {
   virtual string compile_kernel_get_common_cflags(
       const DeviceRequestedFeatures &requested_features, bool filter = false, bool split = false);
 
+  static string compile_kernel_get_source_md5();
+
   string compile_kernel(const DeviceRequestedFeatures &requested_features,
                         const char *name,
                         const char *base = "cuda",
@@ -125,6 +127,8 @@ class CUDADevice : public Device {
 
   virtual bool load_kernels(const DeviceRequestedFeatures &requested_features);
 
+  virtual bool check_peer_access(Device *peer_device);
+
   void load_functions();
 
   void reserve_local_memory(const DeviceRequestedFeatures &requested_features);
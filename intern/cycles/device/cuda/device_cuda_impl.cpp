@@ -331,6 +331,21 @@ string CUDADevice::compile_kernel_get_common_cflags(
   return cflags;
 }
 
+/* Hash of all kernel sources. The sources don't change while Blender is running, so compute it
+ * only once instead of reading the whole source tree every time kernels are loaded by a device.
+ */
+string CUDADevice::compile_kernel_get_source_md5()
+{
+  static thread_mutex source_md5_mutex;
+  static string source_md5;
+
+  thread_scoped_lock lock(source_md5_mutex);
+  if (source_md5.empty()) {
+    source_md5 = path_files_md5_hash(path_get("source"));
+  }
+  return source_md5;
+}
+
 string CUDADevice::compile_kernel(const DeviceRequestedFeatures &requested_features,
                                   const char *name,
                                   const char *base,
@@ -362,7 +377,7 @@ string CUDADevice::compile_kernel(const DeviceRequestedFeatures &requested_featu
 
   /* Try to use locally compiled kernel. */
   string source_path = path_get("source");
-  const string source_md5 = path_files_md5_hash(source_path);
+  const string source_md5 = compile_kernel_get_source_md5();
 
   /* We include cflags into md5 so changing cuda toolkit or changing other
    * compiler command line arguments makes sure cubin gets re-built.
@@ -538,6 +553,55 @@ bool CUDADevice::load_kernels(const DeviceRequestedFeatures &requested_features)
   return (result == CUDA_SUCCESS);
 }
 
+bool CUDADevice::check_peer_access(Device *peer_device)
+{
+  if (peer_device == this) {
+    return false;
+  }
+  if (peer_device->info.type != DEVICE_CUDA && peer_device->info.type != DEVICE_OPTIX) {
+    return false;
+  }
+
+  CUDADevice *const peer_device_cuda = static_cast<CUDADevice *>(peer_device);
+
+  int can_access = 0;
+  cuda_assert(cuDeviceCanAccessPeer(&can_access, cuDevice, peer_device_cuda->cuDevice));
+  if (can_access == 0) {
+    return false;
+  }
+
+  /* 3D textures are stored in arrays, so these need to be accessible as well. */
+  cuda_assert(cuDeviceGetP2PAttribute(&can_access,
+                                      CU_DEVICE_P2P_ATTRIBUTE_ARRAY_ACCESS_ACCESS_SUPPORTED,
+                                      cuDevice,
+                                      peer_device_cuda->cuDevice));
+  if (can_access == 0) {
+    return false;
+  }
+
+  /* Enable peer access in both directions. */
+  {
+    const CUDAContextScope scope(this);
+    CUresult result = cuCtxEnablePeerAccess(peer_device_cuda->cuContext, 0);
+    if (result != CUDA_SUCCESS && result != CUDA_ERROR_PEER_ACCESS_ALREADY_ENABLED) {
+      cuda_error_message(string_printf("Failed to enable peer access on CUDA context (%s)",
+                                       cuewErrorString(result)));
+      return false;
+    }
+  }
+  {
+    const CUDAContextScope scope(peer_device_cuda);
+    CUresult result = cuCtxEnablePeerAccess(cuContext, 0);
+    if (result != CUDA_SUCCESS && result != CUDA_ERROR_PEER_ACCESS_ALREADY_ENABLED) {
+      cuda_error_message(string_printf("Failed to enable peer access on CUDA context (%s)",
+                                       cuewErrorString(result)));
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void CUDADevice::load_functions()
 {
   /* TODO: load all functions here. */
@@ -767,8 +831,10 @@ CUDADevice::CUDAMem *CUDADevice::generic_alloc(device_memory &mem, size_t pitch_
   size_t total = 0, free = 0;
   cuMemGetInfo(&free, &total);
 
-  /* Move textures to host memory if needed. */
-  if (!move_texture_to_host && !is_image && (size + headroom) >= free && can_map_host) {
+  /* Move textures to host memory if needed. Not done when sharing memory
+   * with peer devices, since those would keep using the old pointers. */
+  if (!move_texture_to_host && !is_image && (size + headroom) >= free && can_map_host &&
+      !info.has_peer_memory) {
     move_textures_to_host(size + headroom - free, is_texture);
     cuMemGetInfo(&free, &total);
   }
@@ -793,8 +859,12 @@ CUDADevice::CUDAMem *CUDADevice::generic_alloc(device_memory &mem, size_t pitch_
     }
     else if (map_host_used + size < map_host_limit) {
       /* Allocate host memory ourselves. */
-      mem_alloc_result = cuMemHostAlloc(
-          &shared_pointer, size, CU_MEMHOSTALLOC_DEVICEMAP | CU_MEMHOSTALLOC_WRITECOMBINED);
+      /* Peer devices may access this memory too, which needs it to be portable. */
+      unsigned int flags = CU_MEMHOSTALLOC_DEVICEMAP | CU_MEMHOSTALLOC_WRITECOMBINED;
+      if (info.has_peer_memory) {
+        flags |= CU_MEMHOSTALLOC_PORTABLE;
+      }
+      mem_alloc_result = cuMemHostAlloc(&shared_pointer, size, flags);
 
       assert((mem_alloc_result == CUDA_SUCCESS && shared_pointer != 0) ||
              (mem_alloc_result != CUDA_SUCCESS && shared_pointer == 0));
@@ -1052,8 +1122,11 @@ void CUDADevice::tex_alloc(device_memory &mem)
 
   /* Data Storage */
   if (mem.interpolation == INTERPOLATION_NONE) {
-    generic_alloc(mem);
-    generic_copy_to(mem);
+    /* Memory owned by a peer device only needs its pointer bound. */
+    if (mem.is_resident(this)) {
+      generic_alloc(mem);
+      generic_copy_to(mem);
+    }
 
     const_copy_to(bind_name.c_str(), &mem.device_pointer, sizeof(mem.device_pointer));
     return;
@@ -1090,7 +1163,25 @@ void CUDADevice::tex_alloc(device_memory &mem)
   size_t src_pitch = mem.data_width * dsize * mem.data_elements;
   size_t dst_pitch = src_pitch;
 
-  if (mem.data_depth > 1) {
+  if (!mem.is_resident(this)) {
+    /* Memory was allocated and filled by a peer device, only create a
+     * texture object referencing it on this device. */
+    cmem = &cuda_mem_map[&mem];
+    cmem->texobject = 0;
+
+    if (mem.data_depth > 1) {
+      array_3d = (CUarray)mem.device_pointer;
+    }
+    else if (mem.data_height > 0) {
+      /* Match the pitch used by the owning device. */
+      int alignment = 0;
+      cuda_assert(cuDeviceGetAttribute(&alignment,
+                                       CU_DEVICE_ATTRIBUTE_TEXTURE_PITCH_ALIGNMENT,
+                                       static_cast<CUDADevice *>(mem.device)->cuDevice));
+      dst_pitch = align_up(src_pitch, alignment);
+    }
+  }
+  else if (mem.data_depth > 1) {
     /* 3D texture using array, there is no API for linear memory. */
     CUDA_ARRAY3D_DESCRIPTOR desc;
 
@@ -1243,7 +1334,11 @@ void CUDADevice::tex_free(device_memory &mem)
       cuTexObjectDestroy(cmem.texobject);
     }
 
-    if (cmem.array) {
+    if (!mem.is_resident(this)) {
+      /* Memory is owned and freed by a peer device. */
+      cuda_mem_map.erase(cuda_mem_map.find(&mem));
+    }
+    else if (cmem.array) {
       /* Free array. */
       cuArrayDestroy(cmem.array);
       stats.mem_free(mem.device_size);
@@ -81,6 +81,8 @@ class DeviceInfo {
   bool has_osl;              /* Support Open Shading Language. */
   bool use_split_kernel;     /* Use split or mega kernel. */
   bool has_profiling;        /* Supports runtime collection of profiling info. */
+  bool has_texture_cache;    /* Supports loading image textures on demand. */
+  bool has_peer_memory;      /* Share scene memory with peer devices instead of duplicating. */
   int cpu_threads;
   vector<DeviceInfo> multi_devices;
   vector<DeviceInfo> denoising_devices;
@@ -97,6 +99,8 @@ class DeviceInfo {
     has_osl = false;
     use_split_kernel = false;
     has_profiling = false;
+    has_texture_cache = false;
+    has_peer_memory = false;
   }
 
   bool operator==(const DeviceInfo &info)
@@ -360,6 +364,11 @@ class Device {
     return NULL;
   }
 
+  /* texture cache for on demand image loading, only for CPU device */
+  virtual void set_texture_cache(void * /*texture_system*/)
+  {
+  }
+
   /* load/compile kernels, must be called before adding tasks */
   virtual bool load_kernels(const DeviceRequestedFeatures & /*requested_features*/)
   {
@@ -433,6 +442,19 @@ class Device {
   {
   }
 
+  /* Enable direct access to the memory of another device, returns false if
+   * the devices can not share memory. */
+  virtual bool check_peer_access(Device * /*peer_device*/)
+  {
+    return false;
+  }
+  /* Test if the memory referenced by key was allocated on the sub device,
+   * rather than on a peer device it is shared with. */
+  virtual bool is_resident(device_ptr /*key*/, Device *sub_device)
+  {
+    return sub_device == this;
+  }
+
   /* static */
   static Device *create(DeviceInfo &info,
                         Stats &stats,
@@ -293,6 +293,8 @@ class CPUDevice : public Device {
 #ifdef WITH_OSL
     kernel_globals.osl = &osl_globals;
 #endif
+    kernel_globals.texture_cache = NULL;
+    kernel_globals.texture_cache_tdata = NULL;
     use_split_kernel = DebugFlags().cpu.split_kernel;
     if (use_split_kernel) {
       VLOG(1) << "Will be using split kernel.";
@@ -482,6 +484,7 @@ class CPUDevice : public Device {
 
       TextureInfo &info = texture_info[flat_slot];
       info.data = (uint64_t)mem.host_pointer;
+      info.cache_handle = (uint64_t)mem.texture_cache_handle;
       info.cl_buffer = 0;
       info.interpolation = mem.interpolation;
       info.extension = mem.extension;
@@ -516,6 +519,11 @@ class CPUDevice : public Device {
 #endif
   }
 
+  void set_texture_cache(void *texture_system)
+  {
+    kernel_globals.texture_cache = texture_system;
+  }
+
   void thread_run(DeviceTask *task)
   {
     if (task->type == DeviceTask::RENDER)
@@ -897,6 +905,11 @@ class CPUDevice : public Device {
           break;
       }
 
+      if (tile.stealing_state == RenderTile::CAN_BE_STOLEN && task.get_tile_stolen()) {
+        tile.stealing_state = RenderTile::WAS_STOLEN;
+        break;
+      }
+
       for (int y = tile.y; y < tile.y + tile.h; y++) {
         for (int x = tile.x; x < tile.x + tile.w; x++) {
           if (use_coverage) {
@@ -1001,6 +1014,10 @@ class CPUDevice : public Device {
         }
       }
       else if (tile.task == RenderTile::DENOISE) {
+        /* Tiles are denoised as soon as their neighbors are rendered, by the same threads that
+         * path trace the remaining tiles.
+         * TODO: OpenImageDenoise is only available as a compositor node that runs on the full
+         * frame, it would have to be added as a Cycles denoiser to run per tile here. */
         denoise(denoising, tile);
         task.update_progress(&tile, tile.w * tile.h);
       }
@@ -1153,6 +1170,7 @@ class CPUDevice : public Device {
 #ifdef WITH_OSL
     OSLShader::thread_init(&kg, &kernel_globals, &osl_globals);
 #endif
+    kernel_texture_cache_thread_init(&kg);
     return kg;
   }
 
@@ -1175,6 +1193,7 @@ class CPUDevice : public Device {
 #ifdef WITH_OSL
     OSLShader::thread_free(kg);
 #endif
+    kernel_texture_cache_thread_free(kg);
   }
 
   virtual bool load_kernels(const DeviceRequestedFeatures &requested_features_)
@@ -1321,6 +1340,7 @@ void device_cpu_info(vector<DeviceInfo> &devices)
   info.has_osl = true;
   info.has_half_images = true;
   info.has_profiling = true;
+  info.has_texture_cache = true;
 
   devices.insert(devices.begin(), info);
 }
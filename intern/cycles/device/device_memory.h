@@ -210,6 +210,8 @@ class device_memory {
   const char *name;
   InterpolationType interpolation;
   ExtensionType extension;
+  /* Image read through the texture cache, instead of from the host pointer. */
+  void *texture_cache_handle;
 
   /* Pointers. */
   Device *device;
@@ -223,6 +225,7 @@ class device_memory {
 
   void swap_device(Device *new_device, size_t new_device_size, device_ptr new_device_ptr);
   void restore_device();
+  bool is_resident(Device *sub_device) const;
 
  protected:
   friend class CUDADevice;
@@ -437,6 +440,15 @@ template<typename T> class device_vector : public device_memory {
     device_copy_from(y, w, h, sizeof(T));
   }
 
+  /* Hand the data over to another device, keeping the host memory around. */
+  void move_device(Device *new_device)
+  {
+    copy_from_device();
+    device_free();
+    device = new_device;
+    copy_to_device();
+  }
+
   void zero_to_device()
   {
     device_zero();
@@ -34,37 +34,47 @@ CCL_NAMESPACE_BEGIN
 class MultiDevice : public Device {
  public:
   struct SubDevice {
-    explicit SubDevice(Device *device_) : device(device_)
+    SubDevice() : device(NULL), peer_island_index(-1)
     {
     }
 
+    Stats stats;
     Device *device;
     map<device_ptr, device_ptr> ptr_map;
+    int peer_island_index;
   };
 
   list<SubDevice> devices, denoising_devices;
+  vector<vector<SubDevice *>> peer_islands;
   device_ptr unique_key;
 
   MultiDevice(DeviceInfo &info, Stats &stats, Profiler &profiler, bool background_)
       : Device(info, stats, profiler, background_), unique_key(1)
   {
     foreach (DeviceInfo &subinfo, info.multi_devices) {
-      Device *device = Device::create(subinfo, sub_stats_, profiler, background);
-
       /* Always add CPU devices at the back since GPU devices can change
        * host memory pointers, which CPU uses as device pointer. */
+      SubDevice *sub;
       if (subinfo.type == DEVICE_CPU) {
-        devices.push_back(SubDevice(device));
+        devices.emplace_back();
+        sub = &devices.back();
       }
       else {
-        devices.push_front(SubDevice(device));
+        devices.emplace_front();
+        sub = &devices.front();
       }
+
+      /* Each device keeps its own statistics, which are used to balance
+       * memory distributed across peer devices. The list keeps them at a
+       * fixed address. */
+      sub->device = Device::create(subinfo, sub->stats, profiler, background);
     }
 
     foreach (DeviceInfo &subinfo, info.denoising_devices) {
-      Device *device = Device::create(subinfo, sub_stats_, profiler, background);
+      denoising_devices.emplace_back();
+      SubDevice *sub = &denoising_devices.back();
 
-      denoising_devices.push_back(SubDevice(device));
+      sub->device = Device::create(subinfo, sub->stats, profiler, background);
     }
 
 #ifdef WITH_NETWORK
@@ -76,10 +86,53 @@ class MultiDevice : public Device {
 
     foreach (string &server, servers) {
       Device *device = device_network_create(info, stats, profiler, server.c_str());
-      if (device)
-        devices.push_back(SubDevice(device));
+      if (device) {
+        devices.emplace_back();
+        devices.back().device = device;
+      }
     }
 #endif
+
+    /* Group devices into islands that can all access each other's memory.
+     * Without peer memory every device forms its own island. */
+    foreach (SubDevice &sub, devices) {
+      if (sub.peer_island_index >= 0) {
+        continue;
+      }
+
+      peer_islands.emplace_back();
+      sub.peer_island_index = (int)peer_islands.size() - 1;
+      vector<SubDevice *> &island = peer_islands.back();
+      island.push_back(&sub);
+
+      if (!info.has_peer_memory) {
+        continue;
+      }
+
+      foreach (SubDevice &peer_sub, devices) {
+        if (peer_sub.peer_island_index >= 0 ||
+            peer_sub.device->info.type != sub.device->info.type) {
+          continue;
+        }
+
+        bool has_peer_access = true;
+        foreach (SubDevice *island_sub, island) {
+          if (!peer_sub.device->check_peer_access(island_sub->device)) {
+            has_peer_access = false;
+            break;
+          }
+        }
+
+        if (has_peer_access) {
+          peer_sub.peer_island_index = sub.peer_island_index;
+          island.push_back(&peer_sub);
+        }
+      }
+
+      if (island.size() > 1) {
+        VLOG(1) << "Sharing memory between " << island.size() << " peer devices.";
+      }
+    }
   }
 
   ~MultiDevice()
@@ -191,6 +244,64 @@ class MultiDevice : public Device {
     return devices.front().device->osl_memory();
   }
 
+  void set_texture_cache(void *texture_system)
+  {
+    foreach (SubDevice &sub, devices) {
+      sub.device->set_texture_cache(texture_system);
+    }
+  }
+
+  /* Scene data is uploaded once and then only read by the kernels, so it is
+   * allocated on a single device in each peer island and accessed by the
+   * other devices from there. Render buffers and other working memory are
+   * written to during rendering and stay on every device. */
+  bool is_distributed(const device_memory &mem) const
+  {
+    return mem.type == MEM_TEXTURE && peer_islands.size() < devices.size();
+  }
+
+  /* Find the device in the island that owns the memory with the given key,
+   * or for new memory the device with the least memory in use. */
+  SubDevice *find_suitable_mem_device(device_ptr key, const vector<SubDevice *> &island)
+  {
+    SubDevice *owner_sub = island.front();
+    foreach (SubDevice *island_sub, island) {
+      if (key ? (island_sub->ptr_map.find(key) != island_sub->ptr_map.end()) :
+                (island_sub->stats.mem_used < owner_sub->stats.mem_used)) {
+        owner_sub = island_sub;
+      }
+    }
+    return owner_sub;
+  }
+
+  /* Find the device that owns the memory with the given key, which is either
+   * the device itself or one of its peers. */
+  SubDevice *find_matching_mem_device(device_ptr key, SubDevice &sub)
+  {
+    if (sub.peer_island_index < 0 || sub.ptr_map.find(key) != sub.ptr_map.end()) {
+      return &sub;
+    }
+
+    foreach (SubDevice *owner_sub, peer_islands[sub.peer_island_index]) {
+      if (owner_sub->ptr_map.find(key) != owner_sub->ptr_map.end()) {
+        return owner_sub;
+      }
+    }
+
+    return &sub;
+  }
+
+  bool is_resident(device_ptr key, Device *sub_device)
+  {
+    foreach (SubDevice &sub, devices) {
+      if (sub.device == sub_device) {
+        return find_matching_mem_device(key, sub)->device == sub_device;
+      }
+    }
+
+    return true;
+  }
+
   void mem_alloc(device_memory &mem)
   {
     device_ptr key = unique_key++;
@@ -215,13 +326,34 @@ class MultiDevice : public Device {
     device_ptr key = (existing_key) ? existing_key : unique_key++;
     size_t existing_size = mem.device_size;
 
-    foreach (SubDevice &sub, devices) {
-      mem.device = sub.device;
-      mem.device_pointer = (existing_key) ? sub.ptr_map[existing_key] : 0;
-      mem.device_size = existing_size;
+    if (is_distributed(mem)) {
+      foreach (const vector<SubDevice *> &island, peer_islands) {
+        SubDevice *owner_sub = find_suitable_mem_device(existing_key, island);
+        mem.device = owner_sub->device;
+        mem.device_pointer = (existing_key) ? owner_sub->ptr_map[existing_key] : 0;
+        mem.device_size = existing_size;
 
-      sub.device->mem_copy_to(mem);
-      sub.ptr_map[key] = mem.device_pointer;
+        owner_sub->device->mem_copy_to(mem);
+        owner_sub->ptr_map[key] = mem.device_pointer;
+
+        /* Peer devices still need to bind the memory of the owner, to
+         * create texture objects and update kernel globals. */
+        foreach (SubDevice *island_sub, island) {
+          if (island_sub != owner_sub) {
+            island_sub->device->mem_copy_to(mem);
+          }
+        }
+      }
+    }
+    else {
+      foreach (SubDevice &sub, devices) {
+        mem.device = sub.device;
+        mem.device_pointer = (existing_key) ? sub.ptr_map[existing_key] : 0;
+        mem.device_size = existing_size;
+
+        sub.device->mem_copy_to(mem);
+        sub.ptr_map[key] = mem.device_pointer;
+      }
     }
 
     mem.device = this;
@@ -285,13 +417,34 @@ class MultiDevice : public Device {
     device_ptr key = mem.device_pointer;
     size_t existing_size = mem.device_size;
 
-    foreach (SubDevice &sub, devices) {
-      mem.device = sub.device;
-      mem.device_pointer = sub.ptr_map[key];
-      mem.device_size = existing_size;
+    if (is_distributed(mem)) {
+      foreach (const vector<SubDevice *> &island, peer_islands) {
+        SubDevice *owner_sub = find_matching_mem_device(key, *island.front());
+
+        /* Release the references of peer devices before the owner frees the memory. */
+        foreach (SubDevice *island_sub, island) {
+          mem.device = owner_sub->device;
+          mem.device_pointer = owner_sub->ptr_map[key];
+          mem.device_size = existing_size;
+
+          if (island_sub != owner_sub) {
+            island_sub->device->mem_free(mem);
+          }
+        }
 
-      sub.device->mem_free(mem);
-      sub.ptr_map.erase(sub.ptr_map.find(key));
+        owner_sub->device->mem_free(mem);
+        owner_sub->ptr_map.erase(owner_sub->ptr_map.find(key));
+      }
+    }
+    else {
+      foreach (SubDevice &sub, devices) {
+        mem.device = sub.device;
+        mem.device_pointer = sub.ptr_map[key];
+        mem.device_size = existing_size;
+
+        sub.device->mem_free(mem);
+        sub.ptr_map.erase(sub.ptr_map.find(key));
+      }
     }
 
     if (strcmp(mem.name, "RenderBuffers") == 0) {
@@ -548,9 +701,6 @@ class MultiDevice : public Device {
     foreach (SubDevice &sub, denoising_devices)
       sub.device->task_cancel();
   }
-
- protected:
-  Stats sub_stats_;
 };
 
 Device *device_multi_create(DeviceInfo &info, Stats &stats, Profiler &profiler, bool background)
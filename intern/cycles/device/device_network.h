@@ -165,20 +165,18 @@ class RPCSend {
     /* get string from stream */
     string archive_str = archive_stream.str();
 
-    /* first send fixed size header with size of following data */
+    /* first a fixed size header with size of following data */
     ostringstream header_stream;
     header_stream << setw(8) << hex << archive_str.size();
     string header_str = header_stream.str();
 
-    boost::asio::write(
-        socket, boost::asio::buffer(header_str), boost::asio::transfer_all(), error);
+    /* then the actual data, gathered into a single write so the small header
+     * doesn't go out as a separate packet and stall on delayed acknowledgement */
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.push_back(boost::asio::buffer(header_str));
+    buffers.push_back(boost::asio::buffer(archive_str));
 
-    if (error.value())
-      error_func->network_error(error.message());
-
-    /* then send actual data */
-    boost::asio::write(
-        socket, boost::asio::buffer(archive_str), boost::asio::transfer_all(), error);
+    boost::asio::write(socket, buffers, boost::asio::transfer_all(), error);
 
     if (error.value())
       error_func->network_error(error.message());
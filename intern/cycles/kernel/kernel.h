@@ -40,6 +40,9 @@ bool kernel_osl_use(KernelGlobals *kg);
 void kernel_const_copy(KernelGlobals *kg, const char *name, void *host, size_t size);
 void kernel_tex_copy(KernelGlobals *kg, const char *name, void *mem, size_t size);
 
+void kernel_texture_cache_thread_init(KernelGlobals *kg);
+void kernel_texture_cache_thread_free(KernelGlobals *kg);
+
 #define KERNEL_ARCH cpu
 #include "kernel/kernels/cpu/kernel_cpu.h"
 
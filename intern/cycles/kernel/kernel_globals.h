@@ -64,6 +64,11 @@ typedef struct KernelGlobals {
   OSLThreadData *osl_tdata;
 #  endif
 
+  /* OpenImageIO texture system and its per-thread data, for image textures that
+   * are loaded on demand. See #TextureInfo.cache_handle. */
+  void *texture_cache;
+  void *texture_cache_tdata;
+
   /* **** Run-time data ****  */
 
   /* Heap-allocated storage for transparent shadows intersections. */
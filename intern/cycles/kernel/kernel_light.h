@@ -1071,7 +1071,12 @@ ccl_device int light_distribution_sample(KernelGlobals *kg, float *randu)
   /* This is basically std::upper_bound as used by pbrt, to find a point light or
    * triangle to emit from, proportional to area. a good improvement would be to
    * also sample proportional to power, though it's not so well defined with
-   * arbitrary shaders. */
+   * arbitrary shaders.
+   *
+   * TODO: many lights sampling (a light tree). Selection probabilities are global, MIS on
+   * emission hits, background_light_pdf() and the branched path "sample all lights" loops
+   * rely on pdf_triangles and pdf_lights being constant. A light tree needs a pdf that depends
+   * on the shading point to be passed through all of these first. */
   int first = 0;
   int len = kernel_data.integrator.num_distribution + 1;
   float r = *randu;
@@ -19,6 +19,17 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Lookup of images that are loaded on demand, implemented once for all instruction sets in
+ * kernel_texture_cache.cpp. The differentials are used to choose the mip level.
+ * The result is returned as plain floats, since float4 differs between instruction sets. */
+bool kernel_texture_cache_lookup(KernelGlobals *kg,
+                                 const TextureInfo &info,
+                                 float x,
+                                 float y,
+                                 float2 duv_dx,
+                                 float2 duv_dy,
+                                 float r_rgba[4]);
+
 /* Make template functions private so symbols don't conflict between kernels with different
  * instruction sets. */
 namespace {
@@ -470,10 +481,26 @@ template<typename T> struct TextureInterpolator {
 #undef SET_CUBIC_SPLINE_WEIGHTS
 };
 
+ccl_device float4 kernel_tex_image_interp_cache(
+    KernelGlobals *kg, const TextureInfo &info, float x, float y, float2 duv_dx, float2 duv_dy)
+{
+  float rgba[4];
+  if (!kernel_texture_cache_lookup(kg, info, x, y, duv_dx, duv_dy, rgba)) {
+    return make_float4(
+        TEX_IMAGE_MISSING_R, TEX_IMAGE_MISSING_G, TEX_IMAGE_MISSING_B, TEX_IMAGE_MISSING_A);
+  }
+  return make_float4(rgba[0], rgba[1], rgba[2], rgba[3]);
+}
+
 ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, float y)
 {
   const TextureInfo &info = kernel_tex_fetch(__texture_info, id);
 
+  if (info.cache_handle) {
+    return kernel_tex_image_interp_cache(
+        kg, info, x, y, make_float2(0.0f, 0.0f), make_float2(0.0f, 0.0f));
+  }
+
   switch (kernel_tex_type(id)) {
     case IMAGE_DATA_TYPE_HALF:
       return TextureInterpolator<half>::interp(info, x, y);
@@ -498,6 +525,20 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, fl
   }
 }
 
+/* Same as #kernel_tex_image_interp, using the texture coordinate differentials to choose the
+ * mip level of images that are loaded on demand. */
+ccl_device float4 kernel_tex_image_interp_diff(
+    KernelGlobals *kg, int id, float x, float y, float2 duv_dx, float2 duv_dy)
+{
+  const TextureInfo &info = kernel_tex_fetch(__texture_info, id);
+
+  if (info.cache_handle) {
+    return kernel_tex_image_interp_cache(kg, info, x, y, duv_dx, duv_dy);
+  }
+
+  return kernel_tex_image_interp(kg, id, x, y);
+}
+
 ccl_device float4 kernel_tex_image_interp_3d(
     KernelGlobals *kg, int id, float x, float y, float z, InterpolationType interp)
 {
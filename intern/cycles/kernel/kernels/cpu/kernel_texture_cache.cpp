@@ -0,0 +1,111 @@
+/*
+ * Copyright 2011-2020 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Image texture lookups through the OpenImageIO texture system, for images that are
+ * loaded on demand in tiles and mip levels rather than in full.
+ *
+ * This is compiled once and shared by the kernels for all instruction sets. */
+
+/* So ImathMath is included before our kernel_cpu_compat. */
+#include <OpenImageIO/texture.h>
+
+#include "kernel/kernel.h"
+
+// clang-format off
+#include "kernel/kernel_compat_cpu.h"
+#include "kernel/split/kernel_split_data_types.h"
+#include "kernel/kernel_globals.h"
+#include "kernel/kernels/cpu/kernel_cpu_image.h"
+// clang-format on
+
+CCL_NAMESPACE_BEGIN
+
+void kernel_texture_cache_thread_init(KernelGlobals *kg)
+{
+  OIIO::TextureSystem *ts = (OIIO::TextureSystem *)kg->texture_cache;
+  kg->texture_cache_tdata = (ts) ? ts->create_thread_info() : NULL;
+}
+
+void kernel_texture_cache_thread_free(KernelGlobals *kg)
+{
+  if (kg->texture_cache_tdata) {
+    OIIO::TextureSystem *ts = (OIIO::TextureSystem *)kg->texture_cache;
+    ts->destroy_thread_info((OIIO::TextureSystem::Perthread *)kg->texture_cache_tdata);
+    kg->texture_cache_tdata = NULL;
+  }
+}
+
+bool kernel_texture_cache_lookup(KernelGlobals *kg,
+                                 const TextureInfo &info,
+                                 float x,
+                                 float y,
+                                 float2 duv_dx,
+                                 float2 duv_dy,
+                                 float r_rgba[4])
+{
+  OIIO::TextureSystem *ts = (OIIO::TextureSystem *)kg->texture_cache;
+  if (ts == NULL) {
+    return false;
+  }
+
+  OIIO::TextureOpt options;
+
+  switch (info.interpolation) {
+    case INTERPOLATION_CLOSEST:
+      options.interpmode = OIIO::TextureOpt::InterpClosest;
+      break;
+    case INTERPOLATION_CUBIC:
+      options.interpmode = OIIO::TextureOpt::InterpBicubic;
+      break;
+    case INTERPOLATION_SMART:
+      options.interpmode = OIIO::TextureOpt::InterpSmartBicubic;
+      break;
+    default:
+      options.interpmode = OIIO::TextureOpt::InterpBilinear;
+      break;
+  }
+
+  switch (info.extension) {
+    case EXTENSION_REPEAT:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapPeriodic;
+      break;
+    case EXTENSION_EXTEND:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapClamp;
+      break;
+    default:
+      options.swrap = options.twrap = OIIO::TextureOpt::WrapBlack;
+      break;
+  }
+
+  /* Images without an alpha channel are opaque. */
+  options.fill = 1.0f;
+
+  /* Zero differentials give the most detailed mip level. The vertical axis is flipped, since
+   * OpenImageIO has the image origin at the top. */
+  return ts->texture((OIIO::TextureSystem::TextureHandle *)info.cache_handle,
+                     (OIIO::TextureSystem::Perthread *)kg->texture_cache_tdata,
+                     options,
+                     x,
+                     1.0f - y,
+                     duv_dx.x,
+                     -duv_dx.y,
+                     duv_dy.x,
+                     -duv_dy.y,
+                     4,
+                     r_rgba);
+}
+
+CCL_NAMESPACE_END
@@ -18,7 +18,6 @@ CCL_NAMESPACE_BEGIN
 
 ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSortLocals *locals)
 {
-#ifndef __KERNEL_CUDA__
   int tid = ccl_global_id(1) * ccl_global_size(0) + ccl_global_id(0);
   uint qsize = kernel_split_params.queue_index[QUEUE_ACTIVE_AND_REGENERATED_RAYS];
   if (tid == 0) {
@@ -55,7 +54,7 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
   ccl_barrier(CCL_LOCAL_MEM_FENCE);
 
   /* skip sorting for cpu split kernel */
-#  ifdef __KERNEL_OPENCL__
+#if defined(__KERNEL_OPENCL__) || defined(__KERNEL_CUDA__)
 
   /* bitonic sort */
   for (uint length = 1; length < SHADER_SORT_BLOCK_SIZE; length <<= 1) {
@@ -77,7 +76,7 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
       }
     }
   }
-#  endif /* __KERNEL_OPENCL__ */
+#endif /* __KERNEL_OPENCL__ || __KERNEL_CUDA__ */
 
   /* copy to destination */
   for (uint i = 0; i < SHADER_SORT_BLOCK_SIZE; i += SHADER_SORT_LOCAL_SIZE) {
@@ -91,7 +90,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
                                                               kernel_split_state.queue_data[ini];
     }
   }
-#endif /* __KERNEL_CUDA__ */
 }
 
 CCL_NAMESPACE_END
@@ -18,14 +18,20 @@ CCL_NAMESPACE_BEGIN
 
 #ifdef __TEXTURES__
 
-ccl_device float4 svm_image_texture(KernelGlobals *kg, int id, float x, float y, uint flags)
+ccl_device float4 svm_image_texture(
+    KernelGlobals *kg, int id, float x, float y, float2 duv_dx, float2 duv_dy, uint flags)
 {
   if (id == -1) {
     return make_float4(
         TEX_IMAGE_MISSING_R, TEX_IMAGE_MISSING_G, TEX_IMAGE_MISSING_B, TEX_IMAGE_MISSING_A);
   }
 
+#  ifdef __KERNEL_CPU__
+  /* Differentials are only used by the texture cache, which is CPU only. */
+  float4 r = kernel_tex_image_interp_diff(kg, id, x, y, duv_dx, duv_dy);
+#  else
   float4 r = kernel_tex_image_interp(kg, id, x, y);
+#  endif
   const float alpha = r.w;
 
   if ((flags & NODE_IMAGE_ALPHA_UNASSOCIATE) && alpha != 1.0f && alpha != 0.0f) {
@@ -44,6 +50,26 @@ ccl_device float4 svm_image_texture(KernelGlobals *kg, int id, float x, float y,
   return r;
 }
 
+/* Differentials of the UV map the image is looked up with, to choose the mip level. */
+ccl_device_inline void svm_image_uv_differentials(
+    KernelGlobals *kg, ShaderData *sd, uint attr_id, float2 *duv_dx, float2 *duv_dy)
+{
+  if (sd->object == OBJECT_NONE) {
+    return;
+  }
+
+  const AttributeDescriptor desc = find_attribute(kg, sd, attr_id);
+  if (desc.type == NODE_ATTR_FLOAT2) {
+    primitive_attribute_float2(kg, sd, desc, duv_dx, duv_dy);
+  }
+  else if (desc.type == NODE_ATTR_FLOAT3) {
+    float3 dx, dy;
+    primitive_attribute_float3(kg, sd, desc, &dx, &dy);
+    *duv_dx = make_float2(dx.x, dx.y);
+    *duv_dy = make_float2(dy.x, dy.y);
+  }
+}
+
 /* Remap coordnate from 0..1 box to -1..-1 */
 ccl_device_inline float3 texco_remap_square(float3 co)
 {
@@ -71,6 +97,13 @@ ccl_device void svm_node_tex_image(
     tex_co = make_float2(co.x, co.y);
   }
 
+  float2 duv_dx = make_float2(0.0f, 0.0f);
+  float2 duv_dy = make_float2(0.0f, 0.0f);
+  if (flags & NODE_IMAGE_UV_DIFFERENTIALS) {
+    uint4 diff_node = read_node(kg, offset);
+    svm_image_uv_differentials(kg, sd, diff_node.x, &duv_dx, &duv_dy);
+  }
+
   /* TODO(lukas): Consider moving tile information out of the SVM node.
    * TextureInfo seems a reasonable candidate. */
   int id = -1;
@@ -114,7 +147,7 @@ ccl_device void svm_node_tex_image(
     id = -num_nodes;
   }
 
-  float4 f = svm_image_texture(kg, id, tex_co.x, tex_co.y, flags);
+  float4 f = svm_image_texture(kg, id, tex_co.x, tex_co.y, duv_dx, duv_dy, flags);
 
   if (stack_valid(out_offset))
     stack_store_float3(stack, out_offset, make_float3(f.x, f.y, f.z));
@@ -204,15 +237,18 @@ ccl_device void svm_node_tex_image_box(KernelGlobals *kg, ShaderData *sd, float
   /* Map so that no textures are flipped, rotation is somewhat arbitrary. */
   if (weight.x > 0.0f) {
     float2 uv = make_float2((signed_N.x < 0.0f) ? 1.0f - co.y : co.y, co.z);
-    f += weight.x * svm_image_texture(kg, id, uv.x, uv.y, flags);
+    f += weight.x * svm_image_texture(
+        kg, id, uv.x, uv.y, make_float2(0.0f, 0.0f), make_float2(0.0f, 0.0f), flags);
   }
   if (weight.y > 0.0f) {
     float2 uv = make_float2((signed_N.y > 0.0f) ? 1.0f - co.x : co.x, co.z);
-    f += weight.y * svm_image_texture(kg, id, uv.x, uv.y, flags);
+    f += weight.y * svm_image_texture(
+        kg, id, uv.x, uv.y, make_float2(0.0f, 0.0f), make_float2(0.0f, 0.0f), flags);
   }
   if (weight.z > 0.0f) {
     float2 uv = make_float2((signed_N.z > 0.0f) ? 1.0f - co.y : co.y, co.x);
-    f += weight.z * svm_image_texture(kg, id, uv.x, uv.y, flags);
+    f += weight.z * svm_image_texture(
+        kg, id, uv.x, uv.y, make_float2(0.0f, 0.0f), make_float2(0.0f, 0.0f), flags);
   }
 
   if (stack_valid(out_offset))
@@ -242,7 +278,8 @@ ccl_device void svm_node_tex_environment(KernelGlobals *kg,
   else
     uv = direction_to_mirrorball(co);
 
-  float4 f = svm_image_texture(kg, id, uv.x, uv.y, flags);
+  float4 f = svm_image_texture(
+      kg, id, uv.x, uv.y, make_float2(0.0f, 0.0f), make_float2(0.0f, 0.0f), flags);
 
   if (stack_valid(out_offset))
     stack_store_float3(stack, out_offset, make_float3(f.x, f.y, f.z));
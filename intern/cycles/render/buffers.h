@@ -131,6 +131,9 @@ class DisplayBuffer {
 class RenderTile {
  public:
   typedef enum { PATH_TRACE = (1 << 0), DENOISE = (1 << 1) } Task;
+  /* Tiles rendered on the CPU may be handed over to an idle GPU device
+   * once there are no more tiles left to schedule. */
+  typedef enum { NO_STEALING = 0, CAN_BE_STOLEN, WAS_STOLEN } StealingState;
 
   Task task;
   int x, y, w, h;
@@ -146,6 +149,7 @@ class RenderTile {
   int device_size;
 
   RenderBuffers *buffers;
+  StealingState stealing_state;
 
   RenderTile();
 };
@@ -193,15 +193,24 @@ void Geometry::compute_bvh(
     vector<Object *> objects;
     objects.push_back(&object);
 
-    if (bvh && !need_update_rebuild) {
+    bool need_rebuild = (bvh == NULL || need_update_rebuild);
+
+    if (!need_rebuild) {
       progress->set_status(msg, "Refitting BVH");
 
       bvh->geometry = geometry;
       bvh->objects = objects;
 
       bvh->refit(*progress);
+
+      if (bvh->need_rebuild_after_refit()) {
+        VLOG(1) << "Rebuilding BVH of " << name << ", refitted SAH cost " << bvh->sah_cost
+                << " versus " << bvh->build_sah_cost << " after build.";
+        need_rebuild = true;
+      }
     }
-    else {
+
+    if (need_rebuild) {
       progress->set_status(msg, "Building BVH");
 
       BVHParams bparams;
@@ -265,10 +274,12 @@ GeometryManager::GeometryManager()
 {
   need_update = true;
   need_flags_update = true;
+  bvh = NULL;
 }
 
 GeometryManager::~GeometryManager()
 {
+  free_bvh();
 }
 
 void GeometryManager::update_osl_attributes(Device *device,
@@ -1009,14 +1020,86 @@ void GeometryManager::device_update_mesh(
   }
 }
 
+/* Copy packed BVH arrays to the device. The host data is moved over, unless the BVH is kept
+ * for refitting in the next update. */
+template<typename T>
+static void device_copy_bvh_array(device_vector<T> &dvec, array<T> &data, bool keep_data)
+{
+  if (data.size() == 0) {
+    return;
+  }
+
+  if (keep_data) {
+    T *dvec_data = dvec.alloc(data.size());
+    memcpy(dvec_data, data.data(), sizeof(T) * data.size());
+  }
+  else {
+    dvec.steal_data(data);
+  }
+  dvec.copy_to_device();
+}
+
+bool GeometryManager::can_refit_bvh(Scene *scene,
+                                    const BVHParams &bparams,
+                                    bool topology_changed) const
+{
+  if (bvh == NULL || topology_changed || bvh->params.modified(bparams)) {
+    return false;
+  }
+
+  if (bvh->objects != scene->objects || bvh->geometry != scene->geometry) {
+    return false;
+  }
+
+  for (size_t i = 0; i < scene->objects.size(); i++) {
+    if (bvh_object_geometry[i] != scene->objects[i]->geometry) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < scene->geometry.size(); i++) {
+    const Geometry *geom = scene->geometry[i];
+    if (bvh_geometry_instanced[i] != geom->need_build_bvh(bparams.bvh_layout) ||
+        bvh_geometry_motion_blur[i] != geom->has_motion_blur()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void GeometryManager::bvh_state_store(Scene *scene)
+{
+  bvh_object_geometry.clear();
+  bvh_geometry_instanced.clear();
+  bvh_geometry_motion_blur.clear();
+
+  foreach (Object *object, scene->objects) {
+    bvh_object_geometry.push_back(object->geometry);
+  }
+
+  foreach (Geometry *geom, scene->geometry) {
+    bvh_geometry_instanced.push_back(geom->need_build_bvh(bvh->params.bvh_layout));
+    bvh_geometry_motion_blur.push_back(geom->has_motion_blur());
+  }
+}
+
+void GeometryManager::free_bvh()
+{
+  delete bvh;
+  bvh = NULL;
+
+  bvh_object_geometry.clear();
+  bvh_geometry_instanced.clear();
+  bvh_geometry_motion_blur.clear();
+}
+
 void GeometryManager::device_update_bvh(Device *device,
                                         DeviceScene *dscene,
                                         Scene *scene,
+                                        bool topology_changed,
                                         Progress &progress)
 {
-  /* bvh build */
-  progress.set_status("Updating Scene BVH", "Building");
-
   BVHParams bparams;
   bparams.top_level = true;
   bparams.bvh_layout = BVHParams::best_bvh_layout(scene->params.bvh_layout,
@@ -1032,16 +1115,44 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG(1) << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
-#ifdef WITH_EMBREE
-  if (bparams.bvh_layout == BVH_LAYOUT_EMBREE) {
-    if (dscene->data.bvh.scene) {
-      BVHEmbree::destroy(dscene->data.bvh.scene);
+  /* Only keep the BVH around for interactive updates, and for layouts packed by Cycles itself,
+   * as it costs a second copy of the BVH in host memory. */
+  const bool keep_bvh = !scene->params.background && (bparams.bvh_layout == BVH_LAYOUT_BVH2 ||
+                                                      bparams.bvh_layout == BVH_LAYOUT_BVH4 ||
+                                                      bparams.bvh_layout == BVH_LAYOUT_BVH8);
+
+  if (keep_bvh && can_refit_bvh(scene, bparams, topology_changed)) {
+    /* bvh refit */
+    progress.set_status("Updating Scene BVH", "Refitting");
+
+    bvh->refit(progress);
+
+    if (bvh->need_rebuild_after_refit()) {
+      VLOG(1) << "Rebuilding scene BVH, refitted SAH cost " << bvh->sah_cost << " versus "
+              << bvh->build_sah_cost << " after build.";
+      free_bvh();
     }
   }
+  else {
+    free_bvh();
+  }
+
+  if (bvh == NULL) {
+    /* bvh build */
+    progress.set_status("Updating Scene BVH", "Building");
+
+#ifdef WITH_EMBREE
+    if (bparams.bvh_layout == BVH_LAYOUT_EMBREE) {
+      if (dscene->data.bvh.scene) {
+        BVHEmbree::destroy(dscene->data.bvh.scene);
+      }
+    }
 #endif
 
-  BVH *bvh = BVH::create(bparams, scene->geometry, scene->objects);
-  bvh->build(progress, &device->stats);
+    bvh = BVH::create(bparams, scene->geometry, scene->objects);
+    bvh->build(progress, &device->stats);
+    bvh_state_store(scene);
+  }
 
   if (progress.get_cancel()) {
 #ifdef WITH_EMBREE
@@ -1051,7 +1162,7 @@ void GeometryManager::device_update_bvh(Device *device,
       }
     }
 #endif
-    delete bvh;
+    free_bvh();
     return;
   }
 
@@ -1060,46 +1171,16 @@ void GeometryManager::device_update_bvh(Device *device,
 
   PackedBVH &pack = bvh->pack;
 
-  if (pack.nodes.size()) {
-    dscene->bvh_nodes.steal_data(pack.nodes);
-    dscene->bvh_nodes.copy_to_device();
-  }
-  if (pack.leaf_nodes.size()) {
-    dscene->bvh_leaf_nodes.steal_data(pack.leaf_nodes);
-    dscene->bvh_leaf_nodes.copy_to_device();
-  }
-  if (pack.object_node.size()) {
-    dscene->object_node.steal_data(pack.object_node);
-    dscene->object_node.copy_to_device();
-  }
-  if (pack.prim_tri_index.size()) {
-    dscene->prim_tri_index.steal_data(pack.prim_tri_index);
-    dscene->prim_tri_index.copy_to_device();
-  }
-  if (pack.prim_tri_verts.size()) {
-    dscene->prim_tri_verts.steal_data(pack.prim_tri_verts);
-    dscene->prim_tri_verts.copy_to_device();
-  }
-  if (pack.prim_type.size()) {
-    dscene->prim_type.steal_data(pack.prim_type);
-    dscene->prim_type.copy_to_device();
-  }
-  if (pack.prim_visibility.size()) {
-    dscene->prim_visibility.steal_data(pack.prim_visibility);
-    dscene->prim_visibility.copy_to_device();
-  }
-  if (pack.prim_index.size()) {
-    dscene->prim_index.steal_data(pack.prim_index);
-    dscene->prim_index.copy_to_device();
-  }
-  if (pack.prim_object.size()) {
-    dscene->prim_object.steal_data(pack.prim_object);
-    dscene->prim_object.copy_to_device();
-  }
-  if (pack.prim_time.size()) {
-    dscene->prim_time.steal_data(pack.prim_time);
-    dscene->prim_time.copy_to_device();
-  }
+  device_copy_bvh_array(dscene->bvh_nodes, pack.nodes, keep_bvh);
+  device_copy_bvh_array(dscene->bvh_leaf_nodes, pack.leaf_nodes, keep_bvh);
+  device_copy_bvh_array(dscene->object_node, pack.object_node, keep_bvh);
+  device_copy_bvh_array(dscene->prim_tri_index, pack.prim_tri_index, keep_bvh);
+  device_copy_bvh_array(dscene->prim_tri_verts, pack.prim_tri_verts, keep_bvh);
+  device_copy_bvh_array(dscene->prim_type, pack.prim_type, keep_bvh);
+  device_copy_bvh_array(dscene->prim_visibility, pack.prim_visibility, keep_bvh);
+  device_copy_bvh_array(dscene->prim_index, pack.prim_index, keep_bvh);
+  device_copy_bvh_array(dscene->prim_object, pack.prim_object, keep_bvh);
+  device_copy_bvh_array(dscene->prim_time, pack.prim_time, keep_bvh);
 
   dscene->data.bvh.root = pack.root_index;
   dscene->data.bvh.bvh_layout = bparams.bvh_layout;
@@ -1107,7 +1188,9 @@ void GeometryManager::device_update_bvh(Device *device,
 
   bvh->copy_to_device(progress, dscene);
 
-  delete bvh;
+  if (!keep_bvh) {
+    free_bvh();
+  }
 }
 
 void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Progress &progress)
@@ -1356,6 +1439,14 @@ void GeometryManager::device_update(Device *device,
       return;
   }
 
+  /* Topology changes are only known until the geometry BVH's are updated. */
+  bool topology_changed = false;
+  foreach (Geometry *geom, scene->geometry) {
+    if (geom->need_update && geom->need_update_rebuild) {
+      topology_changed = true;
+    }
+  }
+
   TaskPool pool;
 
   size_t i = 0;
@@ -1389,7 +1480,7 @@ void GeometryManager::device_update(Device *device,
   if (progress.get_cancel())
     return;
 
-  device_update_bvh(device, dscene, scene, progress);
+  device_update_bvh(device, dscene, scene, topology_changed, progress);
   if (progress.get_cancel())
     return;
 
@@ -148,6 +148,10 @@ class GeometryManager {
   bool need_update;
   bool need_flags_update;
 
+  /* Top level BVH from the previous update. Kept in interactive sessions, to refit it instead
+   * of building it from scratch when only vertex positions or object transforms changed. */
+  BVH *bvh;
+
   /* Constructor/Destructor */
   GeometryManager();
   ~GeometryManager();
@@ -160,6 +164,9 @@ class GeometryManager {
   /* Updates */
   void tag_update(Scene *scene);
 
+  /* Free the top level BVH kept for refitting, when the geometry it was built from is freed. */
+  void free_bvh();
+
   /* Statistics */
   void collect_statistics(const Scene *scene, RenderStats *stats);
 
@@ -193,11 +200,25 @@ class GeometryManager {
                                 Scene *scene,
                                 Progress &progress);
 
-  void device_update_bvh(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
+  void device_update_bvh(Device *device,
+                         DeviceScene *dscene,
+                         Scene *scene,
+                         bool topology_changed,
+                         Progress &progress);
+
+  /* Check whether the top level BVH can be refitted for the current scene. */
+  bool can_refit_bvh(Scene *scene, const BVHParams &bparams, bool topology_changed) const;
+  void bvh_state_store(Scene *scene);
 
   void device_update_displacement_images(Device *device, Scene *scene, Progress &progress);
 
   void device_update_volume_images(Device *device, Scene *scene, Progress &progress);
+
+  /* State of geometry and objects when the top level BVH was built, which has to be the same
+   * for refitting to give a valid tree. */
+  vector<Geometry *> bvh_object_geometry;
+  vector<bool> bvh_geometry_instanced;
+  vector<bool> bvh_geometry_motion_blur;
 };
 
 CCL_NAMESPACE_END
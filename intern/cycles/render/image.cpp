@@ -23,11 +23,17 @@
 #include "util/util_foreach.h"
 #include "util/util_image_impl.h"
 #include "util/util_logging.h"
+#include "util/util_md5.h"
 #include "util/util_path.h"
 #include "util/util_progress.h"
+#include "util/util_set.h"
 #include "util/util_texture.h"
 #include "util/util_unique_ptr.h"
 
+#include <OpenImageIO/filesystem.h>
+#include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/texture.h>
+
 #ifdef WITH_OSL
 #  include <OSL/oslexec.h>
 #endif
@@ -98,11 +104,13 @@ ImageManager::ImageManager(const DeviceInfo &info)
 {
   need_update = true;
   osl_texture_system = NULL;
+  texture_cache = NULL;
   animation_frame = 0;
 
   /* Set image limits */
   max_num_images = TEX_NUM_MAX;
   has_half_images = info.has_half_images;
+  has_texture_cache = info.has_texture_cache;
 
   for (size_t type = 0; type < IMAGE_DATA_NUM_TYPES; type++) {
     tex_num_images[type] = 0;
@@ -115,6 +123,10 @@ ImageManager::~ImageManager()
     for (size_t slot = 0; slot < images[type].size(); slot++)
       assert(!images[type][slot]);
   }
+
+  if (texture_cache) {
+    OIIO::TextureSystem::destroy((OIIO::TextureSystem *)texture_cache);
+  }
 }
 
 void ImageManager::set_osl_texture_system(void *texture_system)
@@ -122,6 +134,11 @@ void ImageManager::set_osl_texture_system(void *texture_system)
   osl_texture_system = texture_system;
 }
 
+bool ImageManager::use_texture_cache(const Scene *scene) const
+{
+  return has_texture_cache && scene->params.use_texture_cache;
+}
+
 bool ImageManager::set_animation_frame_update(int frame)
 {
   if (frame != animation_frame) {
@@ -713,6 +730,168 @@ bool ImageManager::file_load_image(Image *img,
   return true;
 }
 
+template<typename DeviceType>
+bool ImageManager::texture_cache_load_image(Scene *scene,
+                                            Image *img,
+                                            device_vector<DeviceType> &tex_img)
+{
+  if (!use_texture_cache(scene) || img->key.builtin_data || img->metadata.depth > 1) {
+    return false;
+  }
+
+  /* The texture cache reads pixels as they are stored in the file with associated alpha,
+   * other color spaces and alpha modes are converted on load. */
+  if (!(img->metadata.colorspace == u_colorspace_raw ||
+        img->metadata.colorspace == u_colorspace_srgb) ||
+      !image_associate_alpha(img)) {
+    return false;
+  }
+
+  if (!path_exists(img->key.filename) || path_is_directory(img->key.filename)) {
+    return false;
+  }
+
+  const string filename = texture_cache_tx_file(scene, img->key.filename);
+
+  OIIO::TextureSystem *ts = (OIIO::TextureSystem *)texture_cache;
+  /* Drop cached tiles of files that were modified since they were read, for reloaded images. */
+  ts->invalidate(ustring(filename), false);
+  OIIO::TextureSystem::TextureHandle *handle = ts->get_texture_handle(ustring(filename));
+  if (handle == NULL || !ts->good(handle)) {
+    return false;
+  }
+
+  /* Only allocate a placeholder pixel, lookups go through the texture cache. */
+  thread_scoped_lock device_lock(device_mutex);
+  DeviceType *pixels = tex_img.alloc(1, 1);
+  memset((void *)pixels, 0, sizeof(DeviceType));
+  tex_img.texture_cache_handle = handle;
+
+  return true;
+}
+
+/* .tx files being written, images are loaded in parallel and several slots may use one file. */
+static thread_mutex tx_convert_mutex;
+static thread_condition_variable tx_convert_cond;
+static set<string> tx_converting;
+
+static bool texture_cache_tx_is_valid(const string &tx_filename, const string &filename)
+{
+  return path_exists(tx_filename) &&
+         path_modified_time(tx_filename) >= path_modified_time(filename);
+}
+
+static bool texture_cache_tx_convert(const string &filename, const string &tx_filename)
+{
+  VLOG(1) << "Converting image " << filename << " to " << tx_filename << ".";
+
+  path_create_directories(tx_filename);
+
+  ImageSpec config;
+  config.tile_width = 64;
+  config.tile_height = 64;
+  config.tile_depth = 1;
+  /* Filter the mip levels better than the box filter used when generating them on the fly. */
+  config.attribute("maketx:filtername", "lanczos3");
+
+  /* Write to a temporary file and move it in place once complete, so an interrupted conversion
+   * never leaves a partial .tx file that would be considered up to date afterwards. This also
+   * keeps other processes sharing the cache directory from reading a file being written. */
+  const string tmp_filename = OIIO::Filesystem::unique_path(tx_filename + ".%%%%%%%%.tmp.tx");
+
+  if (!OIIO::ImageBufAlgo::make_texture(
+          OIIO::ImageBufAlgo::MakeTxTexture, filename, tmp_filename, config)) {
+    VLOG(1) << "Failed to convert image " << filename << ": " << OIIO::geterror();
+    path_remove(tmp_filename);
+    return false;
+  }
+
+  string error;
+  if (!OIIO::Filesystem::rename(tmp_filename, tx_filename, error)) {
+    VLOG(1) << "Failed to move converted image to " << tx_filename << ": " << error;
+    path_remove(tmp_filename);
+    return false;
+  }
+
+  return true;
+}
+
+/* Images that are not tiled and mip-mapped are converted to a .tx file in the cache directory
+ * once, so the texture cache reads precomputed and filtered mip levels instead of generating
+ * them from the full resolution image in memory. Returns the file to look up. */
+string ImageManager::texture_cache_tx_file(Scene *scene, const string &filename)
+{
+  if (!scene->params.texture_cache_auto_convert) {
+    return filename;
+  }
+
+  unique_ptr<ImageInput> in = unique_ptr<ImageInput>(ImageInput::create(filename));
+  ImageSpec spec;
+  if (!in || !in->open(filename, spec)) {
+    return filename;
+  }
+  const bool is_mipmapped = (spec.tile_width > 0) && in->seek_subimage(0, 1);
+  in->close();
+
+  if (is_mipmapped) {
+    return filename;
+  }
+
+  const string cache_path = (scene->params.texture_cache_path.empty()) ?
+                                path_cache_get("textures") :
+                                scene->params.texture_cache_path;
+  /* Include a hash of the full path, images with the same name may be in different folders. */
+  const string tx_filename = path_join(cache_path,
+                                       string_printf("%s_%s.tx",
+                                                     path_filename(filename).c_str(),
+                                                     util_md5_string(filename).c_str()));
+
+  {
+    /* Convert each file only once, other slots using the same file wait for the result. */
+    thread_scoped_lock lock(tx_convert_mutex);
+    while (tx_converting.find(tx_filename) != tx_converting.end()) {
+      tx_convert_cond.wait(lock);
+    }
+    if (texture_cache_tx_is_valid(tx_filename, filename)) {
+      return tx_filename;
+    }
+    tx_converting.insert(tx_filename);
+  }
+
+  const bool converted = texture_cache_tx_convert(filename, tx_filename);
+
+  {
+    thread_scoped_lock lock(tx_convert_mutex);
+    tx_converting.erase(tx_filename);
+  }
+  tx_convert_cond.notify_all();
+
+  return (converted) ? tx_filename : filename;
+}
+
+void ImageManager::texture_cache_update(Device *device, Scene *scene)
+{
+  if (!use_texture_cache(scene)) {
+    return;
+  }
+
+  /* Not the texture system shared with OSL, so the memory budget is only used by images that
+   * are loaded here. */
+  if (texture_cache == NULL) {
+    texture_cache = OIIO::TextureSystem::create(false);
+  }
+
+  OIIO::TextureSystem *ts = (OIIO::TextureSystem *)texture_cache;
+  ts->attribute("max_memory_MB", (float)scene->params.texture_cache_size);
+  /* Files that are not tiled or mip-mapped are still read in tiles, with the mip levels
+   * generated as needed. */
+  ts->attribute("autotile", 64);
+  ts->attribute("automip", 1);
+  ts->attribute("gray_to_rgb", 1);
+
+  device->set_texture_cache(texture_cache);
+}
+
 static void image_set_device_memory(ImageManager::Image *img, device_memory *mem)
 {
   img->mem = mem;
@@ -752,7 +931,8 @@ void ImageManager::device_load_image(
     device_vector<float4> *tex_img = new device_vector<float4>(
         device, img->mem_name.c_str(), MEM_TEXTURE);
 
-    if (!file_load_image<TypeDesc::FLOAT, float>(img, type, texture_limit, *tex_img)) {
+    if (!texture_cache_load_image(scene, img, *tex_img) &&
+        !file_load_image<TypeDesc::FLOAT, float>(img, type, texture_limit, *tex_img)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
       float *pixels = (float *)tex_img->alloc(1, 1);
@@ -772,7 +952,8 @@ void ImageManager::device_load_image(
     device_vector<float> *tex_img = new device_vector<float>(
         device, img->mem_name.c_str(), MEM_TEXTURE);
 
-    if (!file_load_image<TypeDesc::FLOAT, float>(img, type, texture_limit, *tex_img)) {
+    if (!texture_cache_load_image(scene, img, *tex_img) &&
+        !file_load_image<TypeDesc::FLOAT, float>(img, type, texture_limit, *tex_img)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
       float *pixels = (float *)tex_img->alloc(1, 1);
@@ -789,7 +970,8 @@ void ImageManager::device_load_image(
     device_vector<uchar4> *tex_img = new device_vector<uchar4>(
         device, img->mem_name.c_str(), MEM_TEXTURE);
 
-    if (!file_load_image<TypeDesc::UINT8, uchar>(img, type, texture_limit, *tex_img)) {
+    if (!texture_cache_load_image(scene, img, *tex_img) &&
+        !file_load_image<TypeDesc::UINT8, uchar>(img, type, texture_limit, *tex_img)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
       uchar *pixels = (uchar *)tex_img->alloc(1, 1);
@@ -809,7 +991,8 @@ void ImageManager::device_load_image(
     device_vector<uchar> *tex_img = new device_vector<uchar>(
         device, img->mem_name.c_str(), MEM_TEXTURE);
 
-    if (!file_load_image<TypeDesc::UINT8, uchar>(img, type, texture_limit, *tex_img)) {
+    if (!texture_cache_load_image(scene, img, *tex_img) &&
+        !file_load_image<TypeDesc::UINT8, uchar>(img, type, texture_limit, *tex_img)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
       uchar *pixels = (uchar *)tex_img->alloc(1, 1);
@@ -826,7 +1009,8 @@ void ImageManager::device_load_image(
     device_vector<half4> *tex_img = new device_vector<half4>(
         device, img->mem_name.c_str(), MEM_TEXTURE);
 
-    if (!file_load_image<TypeDesc::HALF, half>(img, type, texture_limit, *tex_img)) {
+    if (!texture_cache_load_image(scene, img, *tex_img) &&
+        !file_load_image<TypeDesc::HALF, half>(img, type, texture_limit, *tex_img)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
       half *pixels = (half *)tex_img->alloc(1, 1);
@@ -846,7 +1030,8 @@ void ImageManager::device_load_image(
     device_vector<uint16_t> *tex_img = new device_vector<uint16_t>(
         device, img->mem_name.c_str(), MEM_TEXTURE);
 
-    if (!file_load_image<TypeDesc::USHORT, uint16_t>(img, type, texture_limit, *tex_img)) {
+    if (!texture_cache_load_image(scene, img, *tex_img) &&
+        !file_load_image<TypeDesc::USHORT, uint16_t>(img, type, texture_limit, *tex_img)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
       uint16_t *pixels = (uint16_t *)tex_img->alloc(1, 1);
@@ -863,7 +1048,8 @@ void ImageManager::device_load_image(
     device_vector<ushort4> *tex_img = new device_vector<ushort4>(
         device, img->mem_name.c_str(), MEM_TEXTURE);
 
-    if (!file_load_image<TypeDesc::USHORT, uint16_t>(img, type, texture_limit, *tex_img)) {
+    if (!texture_cache_load_image(scene, img, *tex_img) &&
+        !file_load_image<TypeDesc::USHORT, uint16_t>(img, type, texture_limit, *tex_img)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
       uint16_t *pixels = (uint16_t *)tex_img->alloc(1, 1);
@@ -883,7 +1069,8 @@ void ImageManager::device_load_image(
     device_vector<half> *tex_img = new device_vector<half>(
         device, img->mem_name.c_str(), MEM_TEXTURE);
 
-    if (!file_load_image<TypeDesc::HALF, half>(img, type, texture_limit, *tex_img)) {
+    if (!texture_cache_load_image(scene, img, *tex_img) &&
+        !file_load_image<TypeDesc::HALF, half>(img, type, texture_limit, *tex_img)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
       half *pixels = (half *)tex_img->alloc(1, 1);
@@ -928,6 +1115,8 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     return;
   }
 
+  texture_cache_update(device, scene);
+
   TaskPool pool;
   for (int type = 0; type < IMAGE_DATA_NUM_TYPES; type++) {
     for (size_t slot = 0; slot < images[type].size(); slot++) {
@@ -970,6 +1159,8 @@ void ImageManager::device_update_slot(Device *device,
     device_free_image(device, type, slot);
   }
   else if (image->need_load) {
+    texture_cache_update(device, scene);
+
     if (!osl_texture_system || image->key.builtin_data)
       device_load_image(device, scene, type, slot, progress);
   }
@@ -124,6 +124,9 @@ class ImageManager {
   void set_osl_texture_system(void *texture_system);
   bool set_animation_frame_update(int frame);
 
+  /* Whether file images are loaded on demand through the texture cache. */
+  bool use_texture_cache(const Scene *scene) const;
+
   device_memory *image_memory(int flat_slot);
 
   void collect_statistics(RenderStats *stats);
@@ -170,12 +173,14 @@ class ImageManager {
   int tex_num_images[IMAGE_DATA_NUM_TYPES];
   int max_num_images;
   bool has_half_images;
+  bool has_texture_cache;
 
   thread_mutex device_mutex;
   int animation_frame;
 
   vector<Image *> images[IMAGE_DATA_NUM_TYPES];
   void *osl_texture_system;
+  void *texture_cache;
 
   bool file_load_image_generic(Image *img, unique_ptr<ImageInput> *in);
 
@@ -185,6 +190,11 @@ class ImageManager {
                        int texture_limit,
                        device_vector<DeviceType> &tex_img);
 
+  template<typename DeviceType>
+  bool texture_cache_load_image(Scene *scene, Image *img, device_vector<DeviceType> &tex_img);
+  void texture_cache_update(Device *device, Scene *scene);
+  string texture_cache_tx_file(Scene *scene, const string &filename);
+
   void metadata_detect_colorspace(ImageMetaData &metadata, const char *file_format);
 
   void device_load_image(
@@ -153,6 +153,8 @@ Mesh::Mesh() : Geometry(node_type, Geometry::MESH), subd_attributes(this, ATTR_P
   subd_params = NULL;
 
   patch_table = NULL;
+
+  source_hash = 0;
 }
 
 Mesh::~Mesh()
@@ -157,6 +157,10 @@ class Mesh : public Geometry {
 
   size_t num_subd_verts;
 
+  /* Hash of the data this mesh was created from, set by the host application so it can
+   * skip exporting data that did not change. Zero when unknown. */
+  uint source_hash;
+
  private:
   unordered_map<int, int> vert_to_stitching_key_map; /* real vert index -> stitching index */
   unordered_multimap<int, int>
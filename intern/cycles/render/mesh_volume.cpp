@@ -170,6 +170,8 @@ class VolumeMeshBuilder {
   void create_mesh(vector<float3> &vertices, vector<int> &indices, vector<float3> &face_normals);
 
  private:
+  void add_node_index(int index_x, int index_y, int index_z);
+
   void generate_vertices_and_quads(vector<int3> &vertices_is, vector<QuadData> &quads);
 
   void convert_object_space(const vector<int3> &vertices, vector<float3> &out_vertices);
@@ -207,6 +209,11 @@ void VolumeMeshBuilder::add_node(int x, int y, int z)
   const int index_y = (y / CUBE_SIZE) + pad_offset.y;
   const int index_z = (z / CUBE_SIZE) + pad_offset.z;
 
+  add_node_index(index_x, index_y, index_z);
+}
+
+void VolumeMeshBuilder::add_node_index(int index_x, int index_y, int index_z)
+{
   assert((index_x >= 0) && (index_y >= 0) && (index_z >= 0));
 
   const size_t index = compute_voxel_index(res, index_x, index_y, index_z);
@@ -223,10 +230,25 @@ void VolumeMeshBuilder::add_node(int x, int y, int z)
 
 void VolumeMeshBuilder::add_node_with_padding(int x, int y, int z)
 {
-  for (int px = x - params->pad_size; px < x + params->pad_size; ++px) {
-    for (int py = y - params->pad_size; py < y + params->pad_size; ++py) {
-      for (int pz = z - params->pad_size; pz < z + params->pad_size; ++pz) {
-        add_node(px, py, pz);
+  /* Voxels in the padded range map to a contiguous range of nodes, since the
+   * mapping to index space is monotonic. Add those nodes directly instead of
+   * mapping every voxel of the padded range. */
+  const int pad_size = params->pad_size;
+  if (pad_size <= 0) {
+    return;
+  }
+
+  const int min_x = ((x - pad_size) / CUBE_SIZE) + pad_offset.x;
+  const int min_y = ((y - pad_size) / CUBE_SIZE) + pad_offset.y;
+  const int min_z = ((z - pad_size) / CUBE_SIZE) + pad_offset.z;
+  const int max_x = ((x + pad_size - 1) / CUBE_SIZE) + pad_offset.x;
+  const int max_y = ((y + pad_size - 1) / CUBE_SIZE) + pad_offset.y;
+  const int max_z = ((z + pad_size - 1) / CUBE_SIZE) + pad_offset.z;
+
+  for (int index_x = min_x; index_x <= max_x; ++index_x) {
+    for (int index_y = min_y; index_y <= max_y; ++index_y) {
+      for (int index_z = min_z; index_z <= max_z; ++index_z) {
+        add_node_index(index_x, index_y, index_z);
       }
     }
   }
@@ -451,18 +473,23 @@ void GeometryManager::create_volume_mesh(Scene *scene, Mesh *mesh, Progress &pro
     for (int y = 0; y < resolution.y; ++y) {
       for (int x = 0; x < resolution.x; ++x) {
         size_t voxel_index = compute_voxel_index(resolution, x, y, z);
+        bool is_active = false;
 
-        for (size_t i = 0; i < voxel_grids.size(); ++i) {
+        for (size_t i = 0; i < voxel_grids.size() && !is_active; ++i) {
           const VoxelAttributeGrid &voxel_grid = voxel_grids[i];
           const int channels = voxel_grid.channels;
 
           for (int c = 0; c < channels; c++) {
             if (voxel_grid.data[voxel_index * channels + c] >= isovalue) {
-              builder.add_node_with_padding(x, y, z);
+              is_active = true;
               break;
             }
           }
         }
+
+        if (is_active) {
+          builder.add_node_with_padding(x, y, z);
+        }
       }
     }
   }
@@ -435,6 +435,27 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
       }
     }
 
+    /* Images in the texture cache choose their mip level from the texture coordinate
+     * differentials, which can only be computed when the coordinate is a UV map as is. */
+    int uv_attr = ATTR_STD_NONE;
+    if (projection == NODE_IMAGE_PROJ_FLAT && vector_in->link && tex_mapping.skip() &&
+        image_manager->use_texture_cache(compiler.scene)) {
+      ShaderNode *link_node = vector_in->link->parent;
+      if (link_node->type == TextureCoordinateNode::node_type &&
+          vector_in->link->name() == "UV" && !((TextureCoordinateNode *)link_node)->from_dupli) {
+        uv_attr = compiler.attribute(ATTR_STD_UV);
+      }
+      else if (link_node->type == UVMapNode::node_type &&
+               !((UVMapNode *)link_node)->from_dupli) {
+        const ustring attribute = ((UVMapNode *)link_node)->attribute;
+        uv_attr = (attribute.empty()) ? compiler.attribute(ATTR_STD_UV) :
+                                        compiler.attribute(attribute);
+      }
+    }
+    if (uv_attr != ATTR_STD_NONE) {
+      flags |= NODE_IMAGE_UV_DIFFERENTIALS;
+    }
+
     if (projection != NODE_IMAGE_PROJ_BOX) {
       /* If there only is one image (a very common case), we encode it as a negative value. */
       int num_nodes;
@@ -453,6 +474,10 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
                                                flags),
                         projection);
 
+      if (flags & NODE_IMAGE_UV_DIFFERENTIALS) {
+        compiler.add_node(uv_attr, 0, 0, 0);
+      }
+
       if (num_nodes > 0) {
         for (int i = 0; i < num_nodes; i++) {
           int4 node;
@@ -5767,6 +5792,13 @@ void MapRangeNode::expand(ShaderGraph *graph)
   }
 }
 
+void MapRangeNode::constant_fold(const ConstantFolder &folder)
+{
+  if (folder.all_inputs_constant()) {
+    folder.make_constant(svm_map_range(type, value, from_min, from_max, to_min, to_max, steps));
+  }
+}
+
 void MapRangeNode::compile(SVMCompiler &compiler)
 {
   ShaderInput *value_in = input("Value");
@@ -1328,6 +1328,7 @@ class MapRangeNode : public ShaderNode {
     return NODE_GROUP_LEVEL_3;
   }
   void expand(ShaderGraph *graph);
+  void constant_fold(const ConstantFolder &folder);
 
   float value, from_min, from_max, to_min, to_max, steps;
   NodeMapRangeType type;
@@ -133,6 +133,8 @@ void Scene::free_memory(bool final)
   lights.clear();
   particle_systems.clear();
 
+  geometry_manager->free_bvh();
+
   if (device) {
     camera->device_free(device, &dscene, this);
     film->device_free(device, &dscene, this);
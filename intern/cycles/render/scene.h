@@ -169,6 +169,12 @@ class SceneParams {
   int num_bvh_time_steps;
   bool persistent_data;
   int texture_limit;
+  /* Load image textures on demand in tiles and mip levels, with a fixed memory budget. */
+  bool use_texture_cache;
+  int texture_cache_size; /* In megabytes. */
+  /* Convert images to tiled and mip-mapped .tx files for the texture cache. */
+  bool texture_cache_auto_convert;
+  string texture_cache_path; /* Directory for .tx files, user cache directory if empty. */
 
   bool background;
 
@@ -182,6 +188,9 @@ class SceneParams {
     num_bvh_time_steps = 0;
     persistent_data = false;
     texture_limit = 0;
+    use_texture_cache = false;
+    texture_cache_size = 1024;
+    texture_cache_auto_convert = true;
     background = true;
   }
 
@@ -192,7 +201,11 @@ class SceneParams {
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
-             persistent_data == params.persistent_data && texture_limit == params.texture_limit);
+             persistent_data == params.persistent_data && texture_limit == params.texture_limit &&
+             use_texture_cache == params.use_texture_cache &&
+             texture_cache_size == params.texture_cache_size &&
+             texture_cache_auto_convert == params.texture_cache_auto_convert &&
+             texture_cache_path == params.texture_cache_path);
   }
 };
 
@@ -29,6 +29,7 @@
 #include "render/session.h"
 #include "render/bake.h"
 
+#include "util/util_atomic.h"
 #include "util/util_foreach.h"
 #include "util/util_function.h"
 #include "util/util_logging.h"
@@ -86,6 +87,8 @@ Session::Session(const SessionParams &params_)
   gpu_need_display_buffer_update = false;
   pause = false;
   kernels_loaded = false;
+  tile_stealing_state = NOT_STEALING;
+  stealable_tiles = 0;
 
   /* TODO(sergey): Check if it's indeed optimal value for the split kernel. */
   max_closure_global = 1;
@@ -395,6 +398,11 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
   int device_num = device->device_number(tile_device);
 
   while (!tile_manager.next_tile(tile, device_num, tile_types)) {
+    /* No tiles left to schedule, try taking over one that is still rendering. */
+    if ((tile_types & RenderTile::PATH_TRACE) && steal_tile(rtile, tile_device, tile_lock)) {
+      return true;
+    }
+
     /* Wait for denoising tiles to become available */
     if ((tile_types & RenderTile::DENOISE) && !progress.get_cancel() && tile_manager.has_tiles()) {
       denoising_cond.wait(tile_lock);
@@ -413,6 +421,18 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
   rtile.resolution = tile_manager.state.resolution_divider;
   rtile.tile_index = tile->index;
   rtile.task = tile->state == Tile::DENOISE ? RenderTile::DENOISE : RenderTile::PATH_TRACE;
+  rtile.stealing_state = RenderTile::NO_STEALING;
+
+  /* Only path tracing tiles in their own buffers can be moved to another
+   * device halfway through. Adaptive sampling and accurate cryptomatte keep
+   * per-tile state on the device that rendered the first samples. */
+  const KernelFilm &kfilm = scene->dscene.data.film;
+  if (rtile.task == RenderTile::PATH_TRACE && tile_device->info.type == DEVICE_CPU && !buffers &&
+      !params.progressive_refine && !kfilm.pass_adaptive_aux_buffer &&
+      !(kfilm.cryptomatte_passes & CRYPT_ACCURATE)) {
+    rtile.stealing_state = RenderTile::CAN_BE_STOLEN;
+    stealable_tiles++;
+  }
 
   tile_lock.unlock();
 
@@ -477,10 +497,79 @@ void Session::update_tile_sample(RenderTile &rtile)
   update_status_time();
 }
 
+bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_lock &tile_lock)
+{
+  /* Devices whose tiles can be stolen don't steal themselves. */
+  if (tile_device->info.type == DEVICE_CPU || stealable_tiles == 0) {
+    return false;
+  }
+
+  /* Only one device steals at a time. */
+  while (tile_stealing_state != NOT_STEALING) {
+    tile_steal_cond.wait(tile_lock);
+  }
+
+  /* Ask the CPU threads for a tile and wait until one is handed over, or
+   * until all stealable tiles have finished rendering. */
+  tile_stealing_state = WAITING_FOR_TILE;
+  while (tile_stealing_state != GOT_TILE && stealable_tiles > 0) {
+    tile_steal_cond.wait(tile_lock);
+  }
+
+  const bool got_tile = (tile_stealing_state == GOT_TILE);
+  if (got_tile) {
+    rtile = stolen_tile;
+  }
+
+  tile_stealing_state = NOT_STEALING;
+  tile_steal_cond.notify_all();
+
+  if (!got_tile) {
+    return false;
+  }
+
+  tile_lock.unlock();
+
+  /* Continue with the remaining samples on this device. */
+  rtile.buffers->buffer.move_device(tile_device);
+  rtile.buffer = rtile.buffers->buffer.device_pointer;
+  rtile.stealing_state = RenderTile::NO_STEALING;
+  rtile.num_samples -= (rtile.sample - rtile.start_sample);
+  rtile.start_sample = rtile.sample;
+
+  VLOG(2) << "Stole tile " << rtile.tile_index << " with " << rtile.num_samples
+          << " samples left.";
+
+  return true;
+}
+
+bool Session::get_tile_stolen()
+{
+  /* Called by CPU threads between samples, give up the tile if a device is waiting for one. */
+  return atomic_cas_uint32(&tile_stealing_state, WAITING_FOR_TILE, RELEASING_TILE) ==
+         WAITING_FOR_TILE;
+}
+
 void Session::release_tile(RenderTile &rtile)
 {
   thread_scoped_lock tile_lock(tile_mutex);
 
+  if (rtile.stealing_state != RenderTile::NO_STEALING) {
+    stealable_tiles--;
+
+    if (rtile.stealing_state == RenderTile::WAS_STOLEN) {
+      /* Hand the tile over to the waiting device instead of finishing it. */
+      stolen_tile = rtile;
+      tile_stealing_state = GOT_TILE;
+      tile_steal_cond.notify_all();
+      return;
+    }
+    else if (stealable_tiles == 0) {
+      /* Wake up a waiting device, there is nothing left to steal. */
+      tile_steal_cond.notify_all();
+    }
+  }
+
   progress.add_finished_tile(rtile.task == RenderTile::DENOISE);
 
   bool delete_tile;
@@ -1098,6 +1187,7 @@ void Session::render(bool with_denoising)
   task.map_neighbor_tiles = function_bind(&Session::map_neighbor_tiles, this, _1, _2);
   task.unmap_neighbor_tiles = function_bind(&Session::unmap_neighbor_tiles, this, _1, _2);
   task.get_cancel = function_bind(&Progress::get_cancel, &this->progress);
+  task.get_tile_stolen = function_bind(&Session::get_tile_stolen, this);
   task.update_tile_sample = function_bind(&Session::update_tile_sample, this, _1);
   task.update_progress_sample = function_bind(&Progress::add_samples, &this->progress, _1, _2);
   task.need_finish_queue = params.progressive_refine;
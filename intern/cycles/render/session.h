@@ -202,6 +202,8 @@ class Session {
   bool acquire_tile(RenderTile &tile, Device *tile_device, uint tile_types);
   void update_tile_sample(RenderTile &tile);
   void release_tile(RenderTile &tile);
+  bool steal_tile(RenderTile &tile, Device *tile_device, thread_scoped_lock &tile_lock);
+  bool get_tile_stolen();
 
   void map_neighbor_tiles(RenderTile *tiles, Device *tile_device);
   void unmap_neighbor_tiles(RenderTile *tiles, Device *tile_device);
@@ -224,6 +226,14 @@ class Session {
   thread_mutex display_mutex;
   thread_condition_variable denoising_cond;
 
+  /* Tile stealing: once all tiles are scheduled, idle GPU devices take over
+   * tiles that are still being rendered on the CPU. */
+  enum TileStealingState { NOT_STEALING, WAITING_FOR_TILE, RELEASING_TILE, GOT_TILE };
+  uint32_t tile_stealing_state;
+  int stealable_tiles;
+  RenderTile stolen_tile;
+  thread_condition_variable tile_steal_cond;
+
   bool kernels_loaded;
   DeviceRequestedFeatures loaded_kernel_features;
 
@@ -1005,6 +1005,46 @@ TEST_F(RenderGraph, constant_fold_math_clamp)
   graph.finalize(scene);
 }
 
+/*
+ * Tests: Map Range with all constant inputs (clamp false).
+ */
+TEST_F(RenderGraph, constant_fold_map_range)
+{
+  EXPECT_ANY_MESSAGE(log);
+  CORRECT_INFO_MESSAGE(log, "Folding MapRange::Result to constant (3).");
+
+  builder
+      .add_node(ShaderNodeBuilder<MapRangeNode>("MapRange")
+                    .set(&MapRangeNode::type, NODE_MAP_RANGE_LINEAR)
+                    .set(&MapRangeNode::clamp, false)
+                    .set("Value", 0.5f)
+                    .set("To Min", 2.0f)
+                    .set("To Max", 4.0f))
+      .output_value("MapRange::Result");
+
+  graph.finalize(scene);
+}
+
+/*
+ * Tests: Map Range with all constant inputs (clamp true).
+ */
+TEST_F(RenderGraph, constant_fold_map_range_clamp)
+{
+  EXPECT_ANY_MESSAGE(log);
+  CORRECT_INFO_MESSAGE(log, "Folding clamp::Result to constant (4).");
+
+  builder
+      .add_node(ShaderNodeBuilder<MapRangeNode>("MapRange")
+                    .set(&MapRangeNode::type, NODE_MAP_RANGE_LINEAR)
+                    .set(&MapRangeNode::clamp, true)
+                    .set("Value", 2.0f)
+                    .set("To Min", 2.0f)
+                    .set("To Max", 4.0f))
+      .output_value("MapRange::Result");
+
+  graph.finalize(scene);
+}
+
 /*
  * Graph for testing partial folds of Math with one constant argument.
  * Includes 2 tests: constant on each side.
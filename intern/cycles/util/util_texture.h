@@ -91,6 +91,8 @@ typedef enum ExtensionType {
 typedef struct TextureInfo {
   /* Pointer, offset or texture depending on device. */
   uint64_t data;
+  /* Texture cache handle, used instead of data when not zero (CPU only). */
+  uint64_t cache_handle;
   /* Buffer number for OpenCL. */
   uint cl_buffer;
   /* Interpolation and extension type. */
@@ -120,6 +120,12 @@
 #  define FFMPEG_HAVE_AVFRAME_SAMPLE_RATE
 #endif
 
+/* Hardware decoding through a device context, #avcodec_get_hw_config() is FFmpeg 4.0+. */
+#if defined(AV_USING_FFMPEG) && (LIBAVCODEC_VERSION_MAJOR >= 58)
+#  define FFMPEG_HAVE_HW_DECODE
+#  include <libavutil/hwcontext.h>
+#endif
+
 #if ((LIBAVUTIL_VERSION_MAJOR > 51) || \
      (LIBAVUTIL_VERSION_MAJOR == 51) && (LIBAVUTIL_VERSION_MINOR >= 21))
 #  define FFMPEG_FFV1_ALPHA_SUPPORTED
@@ -230,6 +230,17 @@ extern const char *(*MEM_name_ptr)(void *vmemh);
 /* Switch allocator to slower but fully guarded mode. */
 void MEM_use_guarded_allocator(void);
 
+typedef enum eMEMLockfreeBackend {
+  /* Small blocks are kept in per-thread caches when freed, for the next allocations. */
+  MEM_LOCKFREE_BACKEND_THREAD_CACHE = 0,
+  /* All blocks are allocated and freed by the system allocator directly,
+   * which is jemalloc (or the TBB malloc proxy on Windows) in builds using it. */
+  MEM_LOCKFREE_BACKEND_SYSTEM = 1,
+} eMEMLockfreeBackend;
+
+/* Choose how the lock-free allocator gets memory, can be changed at any time. */
+void MEM_use_lockfree_backend(eMEMLockfreeBackend backend);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -130,3 +130,8 @@ void MEM_use_guarded_allocator(void)
   MEM_name_ptr = MEM_guarded_name_ptr;
 #endif
 }
+
+void MEM_use_lockfree_backend(eMEMLockfreeBackend backend)
+{
+  MEM_lockfree_set_backend(backend);
+}
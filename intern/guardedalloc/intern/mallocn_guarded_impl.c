@@ -732,6 +732,7 @@ void MEM_guarded_printmemlist_stats(void)
   MemPrintBlock *pb, *printblock;
   unsigned int totpb, a, b;
   size_t mem_in_use_slop = 0;
+  size_t mem_in_use_copy, peak_mem_copy;
 
   mem_lock_thread();
 
@@ -777,6 +778,13 @@ void MEM_guarded_printmemlist_stats(void)
       break;
   }
 
+  mem_in_use_copy = mem_in_use;
+  peak_mem_copy = peak_mem;
+
+  /* Block names are static strings, so the lock isn't needed for sorting and printing,
+   * which would otherwise stall all allocating threads while the statistics are written. */
+  mem_unlock_thread();
+
   /* sort by name and add together blocks with the same name */
   if (totpb > 1) {
     qsort(printblock, totpb, sizeof(MemPrintBlock), compare_name);
@@ -802,8 +810,8 @@ void MEM_guarded_printmemlist_stats(void)
     qsort(printblock, totpb, sizeof(MemPrintBlock), compare_len);
   }
 
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
-  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use_copy / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n", (double)peak_mem_copy / (double)(1024 * 1024));
   printf("slop memory len: %.3f MB\n", (double)mem_in_use_slop / (double)(1024 * 1024));
   printf(" ITEMS TOTAL-MiB AVERAGE-KiB TYPE\n");
   for (a = 0, pb = printblock; a < totpb; a++, pb++) {
@@ -818,8 +826,6 @@ void MEM_guarded_printmemlist_stats(void)
     free(printblock);
   }
 
-  mem_unlock_thread();
-
 #ifdef HAVE_MALLOC_STATS
   printf("System Statistics:\n");
   malloc_stats();
@@ -23,8 +23,15 @@
 #include <stdlib.h>
 #include <string.h> /* memcpy */
 #include <stdarg.h>
+#include <stdint.h>
 #include <sys/types.h>
 
+#if defined(WIN32)
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#endif
+
 #include "MEM_guardedalloc.h"
 
 /* to ensure strict conversions */
@@ -43,9 +50,12 @@ typedef struct MemHeadAligned {
   size_t len;
 } MemHeadAligned;
 
+/* Usage of the blocks which are not accounted for by any #MemThreadData
+ * (only when allocating the thread data itself failed). */
 static unsigned int totblock = 0;
 static size_t mem_in_use = 0, mmap_in_use = 0, peak_mem = 0;
 static bool malloc_debug_memset = false;
+static bool use_thread_cache = true;
 
 static void (*error_callback)(const char *) = NULL;
 static void (*thread_lock_callback)(void) = NULL;
@@ -74,6 +84,283 @@ MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
 #endif
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Thread Data
+ *
+ * Every thread counts the memory it allocates and frees in its own #MemThreadData,
+ * so threads don't contend on shared counters. Totals are only summed up when requested.
+ *
+ * Small blocks are not given back to the system when freed but kept in size-class caches of
+ * the freeing thread, which its next allocations of the same size-class take from.
+ * \{ */
+
+#if defined(_MSC_VER)
+#  define MEM_THREAD_LOCAL __declspec(thread)
+#else
+#  define MEM_THREAD_LOCAL __thread
+#endif
+
+/* Largest (4 bytes aligned) length of the blocks kept in thread caches. */
+#define MEM_SMALL_LEN_MAX 512
+/* Blocks up to #MEM_SMALL_LEN_MAX are allocated with their length rounded up to this step,
+ * so any block of a size-class can be re-used for any length of the same class. */
+#define MEM_SMALL_LEN_STEP 16
+#define MEM_SMALL_CLASS_NUM (MEM_SMALL_LEN_MAX / MEM_SMALL_LEN_STEP)
+/* Memory kept in the cache of each size-class of a thread, in bytes. */
+#define MEM_SMALL_CACHE_SIZE (32 * 1024)
+
+/* Peak memory is updated every time the memory used by a thread grew by this amount. */
+#define MEM_PEAK_UPDATE_THRESHOLD (64 * 1024)
+
+#define MEM_SMALL_CLASS_FROM_LEN(len) \
+  (((len) == 0) ? 0 : (unsigned int)(((len) + (MEM_SMALL_LEN_STEP - 1)) / MEM_SMALL_LEN_STEP) - 1)
+#define MEM_SMALL_CLASS_LEN(size_class) (((size_t)(size_class) + 1) * MEM_SMALL_LEN_STEP)
+
+/* Free block of a thread cache, stored in place of the block data. */
+typedef struct MemFreeBlock {
+  struct MemFreeBlock *next;
+} MemFreeBlock;
+
+typedef struct MemThreadCache {
+  MemFreeBlock *free_blocks;
+  unsigned int free_num;
+} MemThreadCache;
+
+typedef struct MemThreadData {
+  struct MemThreadData *next;
+  /* Zero once the thread exited, so the data can be taken over by a new thread. Counters are
+   * kept as they are in this case, the totals remain correct this way. */
+  unsigned int is_used;
+
+  /* Only written by the owning thread. Signed, since blocks can be freed by another thread
+   * than the one which allocated them. */
+  int64_t totblock;
+  int64_t mem_in_use;
+  int64_t mmap_in_use;
+  /* Value of #mem_in_use when the peak memory was last updated. */
+  int64_t mem_in_use_peak_update;
+
+  MemThreadCache caches[MEM_SMALL_CLASS_NUM];
+} MemThreadData;
+
+/* All thread data ever allocated, entries are never removed. */
+static MemThreadData *thread_data_list = NULL;
+static MEM_THREAD_LOCAL MemThreadData *thread_data = NULL;
+
+/* Protects creating the thread data, which only happens once for every thread. */
+static unsigned int thread_data_lock = 0;
+static bool thread_data_key_is_init = false;
+#if defined(WIN32)
+static DWORD thread_data_key;
+#else
+static pthread_key_t thread_data_key;
+#endif
+
+static void mem_thread_cache_flush(MemThreadData *td)
+{
+  for (unsigned int i = 0; i < MEM_SMALL_CLASS_NUM; i++) {
+    MemThreadCache *cache = &td->caches[i];
+    while (cache->free_blocks) {
+      MemFreeBlock *block = cache->free_blocks;
+      cache->free_blocks = block->next;
+      free(((MemHead *)block) - 1);
+    }
+    cache->free_num = 0;
+  }
+}
+
+#if defined(WIN32)
+static void WINAPI mem_thread_data_release(void *td_v)
+#else
+static void mem_thread_data_release(void *td_v)
+#endif
+{
+  MemThreadData *td = td_v;
+  if (td == NULL) {
+    return;
+  }
+  mem_thread_cache_flush(td);
+  /* Blocks freed by later destructors of this thread are accounted for in new thread data. */
+  thread_data = NULL;
+  atomic_cas_u(&td->is_used, 1, 0);
+}
+
+static MemThreadData *mem_thread_data_ensure(void)
+{
+  while (atomic_cas_u(&thread_data_lock, 0, 1) != 0) {
+    /* pass */
+  }
+
+  if (!thread_data_key_is_init) {
+#if defined(WIN32)
+    thread_data_key = FlsAlloc(mem_thread_data_release);
+#else
+    pthread_key_create(&thread_data_key, mem_thread_data_release);
+#endif
+    thread_data_key_is_init = true;
+  }
+
+  MemThreadData *td = NULL;
+  for (MemThreadData *td_iter = thread_data_list; td_iter; td_iter = td_iter->next) {
+    if (atomic_cas_u(&td_iter->is_used, 0, 1) == 0) {
+      td = td_iter;
+      break;
+    }
+  }
+
+  if (td == NULL) {
+    td = aligned_malloc(sizeof(MemThreadData), 64);
+    if (td != NULL) {
+      memset(td, 0, sizeof(MemThreadData));
+      td->is_used = 1;
+      td->next = thread_data_list;
+      /* Totals are summed up without locking, publish the initialized data atomically. */
+      atomic_cas_ptr((void **)&thread_data_list, td->next, td);
+    }
+  }
+
+  atomic_cas_u(&thread_data_lock, 1, 0);
+
+  if (UNLIKELY(td == NULL)) {
+    return NULL;
+  }
+
+  td->mem_in_use_peak_update = td->mem_in_use;
+
+#if defined(WIN32)
+  FlsSetValue(thread_data_key, td);
+#else
+  pthread_setspecific(thread_data_key, td);
+#endif
+  thread_data = td;
+  return td;
+}
+
+MEM_INLINE MemThreadData *mem_thread_data_get(void)
+{
+  MemThreadData *td = thread_data;
+  if (UNLIKELY(td == NULL)) {
+    td = mem_thread_data_ensure();
+  }
+  return td;
+}
+
+static size_t mem_total_in_use(void)
+{
+  int64_t total = (int64_t)mem_in_use;
+  for (MemThreadData *td = thread_data_list; td; td = td->next) {
+    total += td->mem_in_use;
+  }
+  return (total > 0) ? (size_t)total : 0;
+}
+
+static size_t mem_total_mmap_in_use(void)
+{
+  int64_t total = (int64_t)mmap_in_use;
+  for (MemThreadData *td = thread_data_list; td; td = td->next) {
+    total += td->mmap_in_use;
+  }
+  return (total > 0) ? (size_t)total : 0;
+}
+
+static unsigned int mem_total_blocks_in_use(void)
+{
+  int64_t total = (int64_t)totblock;
+  for (MemThreadData *td = thread_data_list; td; td = td->next) {
+    total += td->totblock;
+  }
+  return (total > 0) ? (unsigned int)total : 0;
+}
+
+static void memory_usage_add(size_t len, bool is_mmap)
+{
+  MemThreadData *td = mem_thread_data_get();
+  if (LIKELY(td)) {
+    td->totblock++;
+    td->mem_in_use += (int64_t)len;
+    if (UNLIKELY(is_mmap)) {
+      td->mmap_in_use += (int64_t)len;
+    }
+    if (UNLIKELY(td->mem_in_use - td->mem_in_use_peak_update > MEM_PEAK_UPDATE_THRESHOLD)) {
+      td->mem_in_use_peak_update = td->mem_in_use;
+      update_maximum(&peak_mem, mem_total_in_use());
+    }
+  }
+  else {
+    atomic_add_and_fetch_u(&totblock, 1);
+    atomic_add_and_fetch_z(&mem_in_use, len);
+    if (UNLIKELY(is_mmap)) {
+      atomic_add_and_fetch_z(&mmap_in_use, len);
+    }
+    update_maximum(&peak_mem, mem_total_in_use());
+  }
+}
+
+static void memory_usage_sub(size_t len, bool is_mmap)
+{
+  MemThreadData *td = mem_thread_data_get();
+  if (LIKELY(td)) {
+    td->totblock--;
+    td->mem_in_use -= (int64_t)len;
+    if (UNLIKELY(is_mmap)) {
+      td->mmap_in_use -= (int64_t)len;
+    }
+    if (td->mem_in_use < td->mem_in_use_peak_update) {
+      td->mem_in_use_peak_update = td->mem_in_use;
+    }
+  }
+  else {
+    atomic_sub_and_fetch_u(&totblock, 1);
+    atomic_sub_and_fetch_z(&mem_in_use, len);
+    if (UNLIKELY(is_mmap)) {
+      atomic_sub_and_fetch_z(&mmap_in_use, len);
+    }
+  }
+}
+
+/* Allocate a block of at least \a len bytes after its #MemHead,
+ * taking it from the thread cache when possible. */
+MEM_INLINE MemHead *mem_small_block_alloc(size_t len)
+{
+  const unsigned int size_class = MEM_SMALL_CLASS_FROM_LEN(len);
+  if (LIKELY(use_thread_cache)) {
+    MemThreadData *td = mem_thread_data_get();
+    if (LIKELY(td)) {
+      MemThreadCache *cache = &td->caches[size_class];
+      MemFreeBlock *block = cache->free_blocks;
+      if (block) {
+        cache->free_blocks = block->next;
+        cache->free_num--;
+        return ((MemHead *)block) - 1;
+      }
+    }
+  }
+  return (MemHead *)malloc(MEM_SMALL_CLASS_LEN(size_class) + sizeof(MemHead));
+}
+
+/* Free a block allocated by #mem_small_block_alloc, keeping it in the thread cache when
+ * possible. */
+MEM_INLINE void mem_small_block_free(MemHead *memh, size_t len)
+{
+  const unsigned int size_class = MEM_SMALL_CLASS_FROM_LEN(len);
+  if (LIKELY(use_thread_cache)) {
+    MemThreadData *td = mem_thread_data_get();
+    if (LIKELY(td)) {
+      MemThreadCache *cache = &td->caches[size_class];
+      if (cache->free_num < MEM_SMALL_CACHE_SIZE / MEM_SMALL_CLASS_LEN(size_class)) {
+        MemFreeBlock *block = (MemFreeBlock *)PTR_FROM_MEMHEAD(memh);
+        block->next = cache->free_blocks;
+        cache->free_blocks = block;
+        cache->free_num++;
+        return;
+      }
+    }
+  }
+  free(memh);
+}
+
+/** \} */
+
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
 #endif
@@ -130,11 +417,9 @@ void MEM_lockfree_freeN(void *vmemh)
     return;
   }
 
-  atomic_sub_and_fetch_u(&totblock, 1);
-  atomic_sub_and_fetch_z(&mem_in_use, len);
+  memory_usage_sub(len, MEMHEAD_IS_MMAP(memh));
 
   if (MEMHEAD_IS_MMAP(memh)) {
-    atomic_sub_and_fetch_z(&mmap_in_use, len);
 #if defined(WIN32)
     /* our windows mmap implementation is not thread safe */
     mem_lock_thread();
@@ -153,6 +438,9 @@ void MEM_lockfree_freeN(void *vmemh)
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
       aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
     }
+    else if (len <= MEM_SMALL_LEN_MAX) {
+      mem_small_block_free(memh, len);
+    }
     else {
       free(memh);
     }
@@ -264,20 +552,26 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  if (len <= MEM_SMALL_LEN_MAX) {
+    memh = mem_small_block_alloc(len);
+    if (LIKELY(memh)) {
+      memset(memh + 1, 0, len);
+    }
+  }
+  else {
+    memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  }
 
   if (LIKELY(memh)) {
     memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memory_usage_add(len, false);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)mem_total_in_use());
   return NULL;
 }
 
@@ -291,7 +585,7 @@ void *MEM_lockfree_calloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)mem_total_in_use());
     abort();
     return NULL;
   }
@@ -305,7 +599,12 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  if (len <= MEM_SMALL_LEN_MAX) {
+    memh = mem_small_block_alloc(len);
+  }
+  else {
+    memh = (MemHead *)malloc(len + sizeof(MemHead));
+  }
 
   if (LIKELY(memh)) {
     if (UNLIKELY(malloc_debug_memset && len)) {
@@ -313,16 +612,14 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
     }
 
     memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memory_usage_add(len, false);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)mem_total_in_use());
   return NULL;
 }
 
@@ -336,7 +633,7 @@ void *MEM_lockfree_malloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)mem_total_in_use());
     abort();
     return NULL;
   }
@@ -384,16 +681,14 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
 
     memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
     memh->alignment = (short)alignment;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    memory_usage_add(len, false);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)mem_total_in_use());
   return NULL;
 }
 
@@ -420,12 +715,7 @@ void *MEM_lockfree_mapallocN(size_t len, const char *str)
 
   if (memh != (MemHead *)-1) {
     memh->len = len | (size_t)MEMHEAD_MMAP_FLAG;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    atomic_add_and_fetch_z(&mmap_in_use, len);
-
-    update_maximum(&peak_mem, mem_in_use);
-    update_maximum(&peak_mem, mmap_in_use);
+    memory_usage_add(len, true);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -434,7 +724,7 @@ void *MEM_lockfree_mapallocN(size_t len, const char *str)
       "len=" SIZET_FORMAT " in %s, total %u\n",
       SIZET_ARG(len),
       str,
-      (unsigned int)mmap_in_use);
+      (unsigned int)mem_total_mmap_in_use());
   return MEM_lockfree_callocN(len, str);
 }
 
@@ -454,8 +744,18 @@ void MEM_lockfree_callbackmemlist(void (*func)(void *))
 
 void MEM_lockfree_printmemlist_stats(void)
 {
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
-  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n", (double)mem_total_in_use() / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n",
+         (double)MEM_lockfree_get_peak_memory() / (double)(1024 * 1024));
+  if (use_thread_cache) {
+    size_t cached_len = 0;
+    for (MemThreadData *td = thread_data_list; td; td = td->next) {
+      for (unsigned int i = 0; i < MEM_SMALL_CLASS_NUM; i++) {
+        cached_len += td->caches[i].free_num * MEM_SMALL_CLASS_LEN(i);
+      }
+    }
+    printf("thread caches len: %.3f MB\n", (double)cached_len / (double)(1024 * 1024));
+  }
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -487,29 +787,40 @@ void MEM_lockfree_set_memory_debug(void)
   malloc_debug_memset = true;
 }
 
+void MEM_lockfree_set_backend(eMEMLockfreeBackend backend)
+{
+  use_thread_cache = (backend == MEM_LOCKFREE_BACKEND_THREAD_CACHE);
+  if (!use_thread_cache && thread_data != NULL) {
+    /* Caches of other threads are flushed when they exit. */
+    mem_thread_cache_flush(thread_data);
+  }
+}
+
 size_t MEM_lockfree_get_memory_in_use(void)
 {
-  return mem_in_use;
+  return mem_total_in_use();
 }
 
 size_t MEM_lockfree_get_mapped_memory_in_use(void)
 {
-  return mmap_in_use;
+  return mem_total_mmap_in_use();
 }
 
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void)
 {
-  return totblock;
+  return mem_total_blocks_in_use();
 }
 
 /* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
-  peak_mem = mem_in_use;
+  peak_mem = mem_total_in_use();
 }
 
 size_t MEM_lockfree_get_peak_memory(void)
 {
+  /* Peak is only updated once the memory used by a thread grew significantly. */
+  update_maximum(&peak_mem, mem_total_in_use());
   return peak_mem;
 }
 
@@ -32,6 +32,9 @@
 #include <opensubdiv/osd/cpuPatchTable.h>
 #include <opensubdiv/osd/cpuVertexBuffer.h>
 #include <opensubdiv/osd/mesh.h>
+#ifdef OPENSUBDIV_HAS_OPENMP
+#  include <opensubdiv/osd/ompEvaluator.h>
+#endif
 #include <opensubdiv/osd/types.h>
 #include <opensubdiv/version.h>
 
@@ -54,6 +57,18 @@ using OpenSubdiv::Osd::CpuPatchTable;
 using OpenSubdiv::Osd::CpuVertexBuffer;
 using OpenSubdiv::Osd::PatchCoord;
 
+// Evaluator used to apply vertex stencils when coarse positions change.
+//
+// This is the part which runs for every update of a deformed mesh, and it
+// is called once per update from a single thread, so it is safe to use the
+// OpenMP evaluator for it. Patch evaluation keeps using CpuEvaluator since
+// it is already invoked from multiple threads.
+#ifdef OPENSUBDIV_HAS_OPENMP
+typedef OpenSubdiv::Osd::OmpEvaluator CpuStencilEvaluator;
+#else
+typedef CpuEvaluator CpuStencilEvaluator;
+#endif
+
 namespace opensubdiv_capi {
 
 namespace {
@@ -279,6 +294,9 @@ class FaceVaryingVolatileEval {
 
 // Volatile evaluator which can be used from threads.
 //
+// STENCIL_EVALUATOR is used for refinement of vertex and varying data. It is
+// expected to be a host side evaluator which does not need an instance.
+//
 // TODO(sergey): Make it possible to evaluate coordinates in chunks.
 // TODO(sergey): Make it possible to evaluate multiple face varying layers.
 //               (or maybe, it's cheap to create new evaluator for existing
@@ -288,7 +306,8 @@ template<typename SRC_VERTEX_BUFFER,
          typename STENCIL_TABLE,
          typename PATCH_TABLE,
          typename EVALUATOR,
-         typename DEVICE_CONTEXT = void>
+         typename DEVICE_CONTEXT = void,
+         typename STENCIL_EVALUATOR = EVALUATOR>
 class VolatileEvalOutput {
  public:
   typedef OpenSubdiv::Osd::EvaluatorCacheT<EVALUATOR> EvaluatorCache;
@@ -389,28 +408,19 @@ class VolatileEvalOutput {
     // Evaluate vertex positions.
     BufferDescriptor dst_desc = src_desc_;
     dst_desc.offset += num_coarse_vertices_ * src_desc_.stride;
-    const EVALUATOR *eval_instance = OpenSubdiv::Osd::GetEvaluator<EVALUATOR>(
-        evaluator_cache_, src_desc_, dst_desc, device_context_);
-    EVALUATOR::EvalStencils(src_data_,
-                            src_desc_,
-                            src_data_,
-                            dst_desc,
-                            vertex_stencils_,
-                            eval_instance,
-                            device_context_);
+    STENCIL_EVALUATOR::EvalStencils(
+        src_data_, src_desc_, src_data_, dst_desc, vertex_stencils_, NULL, device_context_);
     // Evaluate varying data.
     if (hasVaryingData()) {
       BufferDescriptor dst_varying_desc = src_varying_desc_;
       dst_varying_desc.offset += num_coarse_vertices_ * src_varying_desc_.stride;
-      eval_instance = OpenSubdiv::Osd::GetEvaluator<EVALUATOR>(
-          evaluator_cache_, src_varying_desc_, dst_varying_desc, device_context_);
-      EVALUATOR::EvalStencils(src_varying_data_,
-                              src_varying_desc_,
-                              src_varying_data_,
-                              dst_varying_desc,
-                              varying_stencils_,
-                              eval_instance,
-                              device_context_);
+      STENCIL_EVALUATOR::EvalStencils(src_varying_data_,
+                                      src_varying_desc_,
+                                      src_varying_data_,
+                                      dst_varying_desc,
+                                      varying_stencils_,
+                                      NULL,
+                                      device_context_);
     }
     // Evaluate face-varying data.
     if (hasFaceVaryingData()) {
@@ -544,7 +554,9 @@ class CpuEvalOutput : public VolatileEvalOutput<CpuVertexBuffer,
                                                 CpuVertexBuffer,
                                                 StencilTable,
                                                 CpuPatchTable,
-                                                CpuEvaluator> {
+                                                CpuEvaluator,
+                                                void,
+                                                CpuStencilEvaluator> {
  public:
   CpuEvalOutput(const StencilTable *vertex_stencils,
                 const StencilTable *varying_stencils,
@@ -556,12 +568,14 @@ class CpuEvalOutput : public VolatileEvalOutput<CpuVertexBuffer,
                            CpuVertexBuffer,
                            StencilTable,
                            CpuPatchTable,
-                           CpuEvaluator>(vertex_stencils,
-                                         varying_stencils,
-                                         all_face_varying_stencils,
-                                         face_varying_width,
-                                         patch_table,
-                                         evaluator_cache)
+                           CpuEvaluator,
+                           void,
+                           CpuStencilEvaluator>(vertex_stencils,
+                                                varying_stencils,
+                                                all_face_varying_stencils,
+                                                face_varying_width,
+                                                patch_table,
+                                                evaluator_cache)
   {
   }
 };
@@ -221,6 +221,10 @@ const UserDef U_default = {
             .temp_win_sizey = 600,
         },
 
+    .sequencer_disk_cache_dir = "",
+    .sequencer_disk_cache_size_limit = 100,
+    .sequencer_disk_cache_compression = USER_SEQ_DISK_CACHE_COMPRESSION_LOW,
+
     .runtime =
         {
             .is_dirty = 0,
@@ -29,6 +29,7 @@ bpy_types.BlendDataLibraries.load = _bpy._library_load
 bpy_types.BlendDataLibraries.write = _bpy._library_write
 bpy_types.BlendData.user_map = _bpy._rna_id_collection_user_map
 bpy_types.BlendData.batch_remove = _bpy._rna_id_collection_batch_remove
+bpy_types.BlendData.batch_set = _bpy._rna_id_collection_batch_set
 bpy_types.BlendData.orphans_purge = _bpy._rna_id_collection_orphans_purge
 
 
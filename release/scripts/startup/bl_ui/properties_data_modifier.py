@@ -271,6 +271,7 @@ class DATA_PT_modifiers(ModifierButtonsPanel, Panel):
 
         if ob.type == 'MESH':
             box.row().prop(md, "read_data")
+            box.prop(md, "use_viewport_bounds")
 
     def CAST(self, layout, ob, md):
         split = layout.split(factor=0.25)
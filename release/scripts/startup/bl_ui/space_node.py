@@ -641,6 +641,8 @@ class NODE_PT_quality(bpy.types.Panel):
         col.prop(tree, "use_groupnode_buffer")
         col.prop(tree, "use_two_pass")
         col.prop(tree, "use_viewer_border")
+        col.prop(tree, "use_full_frame")
+        col.prop(tree, "cache_limit")
         col.separator()
         col.prop(snode, "use_auto_render")
 
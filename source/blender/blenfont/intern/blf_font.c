@@ -111,6 +111,13 @@ static void blf_batch_draw_init(void)
 static void blf_batch_draw_exit(void)
 {
   GPU_BATCH_DISCARD_SAFE(g_batch.batch);
+
+  GlyphAtlasBLF *atlas = &g_batch.atlas;
+  if (atlas->texture) {
+    GPU_texture_free(atlas->texture);
+  }
+  MEM_SAFE_FREE(atlas->bitmap_result);
+  memset(atlas, 0, sizeof(*atlas));
 }
 
 void blf_batch_draw_vao_clear(void)
@@ -126,7 +133,6 @@ void blf_batch_draw_begin(FontBLF *font)
     blf_batch_draw_init();
   }
 
-  const bool font_changed = (g_batch.font != font);
   const bool simple_shader = ((font->flags & (BLF_ROTATION | BLF_MATRIX | BLF_ASPECT)) == 0);
   const bool shader_changed = (simple_shader != g_batch.simple_shader);
 
@@ -155,11 +161,11 @@ void blf_batch_draw_begin(FontBLF *font)
       GPU_matrix_set(g_batch.mat);
     }
 
-    /* flush cache if config is not the same. */
-    if (mat_changed || font_changed || shader_changed) {
+    /* flush cache if config is not the same.
+     * Glyphs of all fonts share the same atlas, so a font change doesn't need a flush. */
+    if (mat_changed || shader_changed) {
       blf_batch_draw();
       g_batch.simple_shader = simple_shader;
-      g_batch.font = font;
     }
     else {
       /* Nothing changed continue batching. */
@@ -175,22 +181,21 @@ void blf_batch_draw_begin(FontBLF *font)
   else {
     /* flush cache */
     blf_batch_draw();
-    g_batch.font = font;
     g_batch.simple_shader = simple_shader;
   }
 }
 
 static GPUTexture *blf_batch_cache_texture_load(void)
 {
-  GlyphCacheBLF *gc = g_batch.glyph_cache;
-  BLI_assert(gc);
-  BLI_assert(gc->bitmap_len > 0);
+  GlyphAtlasBLF *atlas = &g_batch.atlas;
+  BLI_assert(atlas->texture);
+  BLI_assert(atlas->bitmap_len > 0);
 
-  if (gc->bitmap_len > gc->bitmap_len_landed) {
-    const int tex_width = GPU_texture_width(gc->texture);
+  if (atlas->bitmap_len > atlas->bitmap_len_landed) {
+    const int tex_width = GPU_texture_width(atlas->texture);
 
-    int bitmap_len_landed = gc->bitmap_len_landed;
-    int remain = gc->bitmap_len - bitmap_len_landed;
+    int bitmap_len_landed = atlas->bitmap_len_landed;
+    int remain = atlas->bitmap_len - bitmap_len_landed;
     int offset_x = bitmap_len_landed % tex_width;
     int offset_y = bitmap_len_landed / tex_width;
 
@@ -198,9 +203,9 @@ static GPUTexture *blf_batch_cache_texture_load(void)
     while (remain) {
       int remain_row = tex_width - offset_x;
       int width = remain > remain_row ? remain_row : remain;
-      GPU_texture_update_sub(gc->texture,
+      GPU_texture_update_sub(atlas->texture,
                              GPU_DATA_UNSIGNED_BYTE,
-                             &gc->bitmap_result[bitmap_len_landed],
+                             &atlas->bitmap_result[bitmap_len_landed],
                              offset_x,
                              offset_y,
                              0,
@@ -214,10 +219,10 @@ static GPUTexture *blf_batch_cache_texture_load(void)
       offset_y += 1;
     }
 
-    gc->bitmap_len_landed = bitmap_len_landed;
+    atlas->bitmap_len_landed = bitmap_len_landed;
   }
 
-  return gc->texture;
+  return atlas->texture;
 }
 
 void blf_batch_draw(void)
@@ -1281,7 +1286,6 @@ static void blf_font_fill(FontBLF *font)
 #if BLF_BLUR_ENABLE
   font->blur = 0;
 #endif
-  font->tex_size_max = -1;
 
   font->buf_info.fbuf = NULL;
   font->buf_info.cbuf = NULL;
@@ -219,12 +219,6 @@ void blf_glyph_cache_free(GlyphCacheBLF *gc)
       blf_glyph_free(g);
     }
   }
-  if (gc->texture) {
-    GPU_texture_free(gc->texture);
-  }
-  if (gc->bitmap_result) {
-    MEM_freeN(gc->bitmap_result);
-  }
   MEM_freeN(gc);
 }
 
@@ -455,44 +449,67 @@ static void blf_glyph_calc_rect_shadow(rctf *rect, GlyphBLF *g, float x, float y
   blf_glyph_calc_rect(rect, g, x + (float)font->shadow_x, y + (float)font->shadow_y);
 }
 
-void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, float y)
+/* Copy the glyph bitmap in the shared atlas. Glyphs of different fonts, sizes and dpi can then be
+ * drawn in the same batch. */
+static void blf_glyph_atlas_add(GlyphBLF *g)
 {
-  if ((!g->width) || (!g->height)) {
-    return;
+  GlyphAtlasBLF *atlas = &g_batch.atlas;
+
+  if (atlas->generation == 0) {
+    atlas->tex_size_max = GPU_max_texture_size();
+    atlas->generation = 1;
   }
 
-  if (g->glyph_cache == NULL) {
-    if (font->tex_size_max == -1) {
-      font->tex_size_max = GPU_max_texture_size();
-    }
+  const int buff_size = g->width * g->height;
+  int bitmap_len = atlas->bitmap_len + buff_size;
 
-    g->offset = gc->bitmap_len;
+  if ((bitmap_len > BLF_GLYPH_ATLAS_LEN_MAX) && (atlas->bitmap_len > 0)) {
+    /* The atlas is full. Draw the glyphs still using it and evict all of them,
+     * only the glyphs drawn after this are added back. */
+    blf_batch_draw();
+    atlas->bitmap_len = 0;
+    atlas->bitmap_len_landed = 0;
+    atlas->generation++;
+    bitmap_len = buff_size;
+  }
 
-    int buff_size = g->width * g->height;
-    int bitmap_len = gc->bitmap_len + buff_size;
+  if (bitmap_len > atlas->bitmap_len_alloc) {
+    int w = atlas->tex_size_max;
+    int h = bitmap_len / w + 1;
 
-    if (bitmap_len > gc->bitmap_len_alloc) {
-      int w = font->tex_size_max;
-      int h = bitmap_len / w + 1;
+    atlas->bitmap_len_alloc = w * h;
+    atlas->bitmap_result = MEM_reallocN(atlas->bitmap_result, (size_t)atlas->bitmap_len_alloc);
 
-      gc->bitmap_len_alloc = w * h;
-      gc->bitmap_result = MEM_reallocN(gc->bitmap_result, (size_t)gc->bitmap_len_alloc);
+    /* Keep in sync with the texture. */
+    if (atlas->texture) {
+      GPU_texture_free(atlas->texture);
+    }
+    atlas->texture = GPU_texture_create_nD(
+        w, h, 0, 1, NULL, GPU_R8, GPU_DATA_UNSIGNED_BYTE, 0, false, NULL);
 
-      /* Keep in sync with the texture. */
-      if (gc->texture) {
-        GPU_texture_free(gc->texture);
-      }
-      gc->texture = GPU_texture_create_nD(
-          w, h, 0, 1, NULL, GPU_R8, GPU_DATA_UNSIGNED_BYTE, 0, false, NULL);
+    atlas->bitmap_len_landed = 0;
+  }
 
-      gc->bitmap_len_landed = 0;
-    }
+  g->offset = atlas->bitmap_len;
+  g->atlas_generation = atlas->generation;
+
+  memcpy(&atlas->bitmap_result[atlas->bitmap_len], g->bitmap, (size_t)buff_size);
+  atlas->bitmap_len = bitmap_len;
+}
 
-    memcpy(&gc->bitmap_result[gc->bitmap_len], g->bitmap, (size_t)buff_size);
-    gc->bitmap_len = bitmap_len;
+void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, float y)
+{
+  if ((!g->width) || (!g->height)) {
+    return;
+  }
 
+  if (g->atlas_generation == 0) {
     gc->glyphs_len_free--;
-    g->glyph_cache = gc;
+    blf_glyph_atlas_add(g);
+  }
+  else if (g->atlas_generation != g_batch.atlas.generation) {
+    /* Evicted from the atlas since it was last drawn. */
+    blf_glyph_atlas_add(g);
   }
 
   if (font->flags & BLF_CLIPPING) {
@@ -505,11 +522,6 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
     }
   }
 
-  if (g_batch.glyph_cache != g->glyph_cache) {
-    blf_batch_draw();
-    g_batch.glyph_cache = g->glyph_cache;
-  }
-
   if (font->flags & BLF_SHADOW) {
     rctf rect_ofs;
     blf_glyph_calc_rect_shadow(&rect_ofs, g, x, y, font);
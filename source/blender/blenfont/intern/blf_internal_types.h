@@ -29,8 +29,26 @@
 
 #define BLF_BATCH_DRAW_LEN_MAX 2048 /* in glyph */
 
+/* Size of the glyph atlas before it gets evicted, in bytes (one byte per pixel). */
+#define BLF_GLYPH_ATLAS_LEN_MAX (4 * 1024 * 1024)
+
+/* Texture storing the bitmaps of the glyphs of all fonts, sizes and dpi. */
+typedef struct GlyphAtlasBLF {
+  struct GPUTexture *texture;
+  char *bitmap_result;
+  int bitmap_len;
+  int bitmap_len_landed;
+  int bitmap_len_alloc;
+
+  /* max texture size. */
+  int tex_size_max;
+
+  /* Incremented every time the atlas is evicted, glyphs added with an older
+   * generation have to be added again before being drawn. */
+  int generation;
+} GlyphAtlasBLF;
+
 typedef struct BatchBLF {
-  struct FontBLF *font; /* can only batch glyph from the same font */
   struct GPUBatch *batch;
   struct GPUVertBuf *verts;
   struct GPUVertBufRaw pos_step, col_step, offset_step, glyph_size_step;
@@ -39,7 +57,7 @@ typedef struct BatchBLF {
   float ofs[2];    /* copy of font->pos */
   float mat[4][4]; /* previous call modelmatrix. */
   bool enabled, active, simple_shader;
-  struct GlyphCacheBLF *glyph_cache;
+  GlyphAtlasBLF atlas;
 } BatchBLF;
 
 extern BatchBLF g_batch;
@@ -71,13 +89,6 @@ typedef struct GlyphCacheBLF {
   /* fast ascii lookup */
   struct GlyphBLF *glyph_ascii_table[256];
 
-  /* texture array, to draw the glyphs. */
-  GPUTexture *texture;
-  char *bitmap_result;
-  int bitmap_len;
-  int bitmap_len_landed;
-  int bitmap_len_alloc;
-
   /* and the bigger glyph in the font. */
   int glyph_width_max;
   int glyph_height_max;
@@ -111,9 +122,12 @@ typedef struct GlyphBLF {
   /* avoid conversion to int while drawing */
   int advance_i;
 
-  /* position inside the texture where this glyph is store. */
+  /* position inside the atlas where this glyph is store. */
   int offset;
 
+  /* Generation of the atlas the glyph was added to (0 when never added). */
+  int atlas_generation;
+
   /* Bitmap data, from freetype. Take care that this
    * can be NULL.
    */
@@ -130,8 +144,6 @@ typedef struct GlyphBLF {
    */
   float pos_x;
   float pos_y;
-
-  struct GlyphCacheBLF *glyph_cache;
 } GlyphBLF;
 
 typedef struct FontBufInfoBLF {
@@ -214,9 +226,6 @@ typedef struct FontBLF {
   /* font size. */
   unsigned int size;
 
-  /* max texture size. */
-  int tex_size_max;
-
   /* font options. */
   int flags;
 
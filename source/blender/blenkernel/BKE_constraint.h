@@ -184,6 +184,13 @@ void BKE_constraints_proxylocal_extract(struct ListBase *dst, struct ListBase *s
 bool BKE_constraints_proxylocked_owner(struct Object *ob, struct bPoseChannel *pchan);
 
 /* Constraint Evaluation function prototypes */
+void BKE_constraints_init_evalob(struct bConstraintOb *cob,
+                                 struct Depsgraph *depsgraph,
+                                 struct Scene *scene,
+                                 struct Object *ob,
+                                 void *subdata,
+                                 short datatype);
+void BKE_constraints_apply_evalob(struct bConstraintOb *cob);
 struct bConstraintOb *BKE_constraints_make_evalob(struct Depsgraph *depsgraph,
                                                   struct Scene *scene,
                                                   struct Object *ob,
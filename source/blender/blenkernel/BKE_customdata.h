@@ -73,6 +73,12 @@ typedef enum eCDAllocType {
   CD_REFERENCE = 3,
   /** Do a full copy of all layers, only allowed if source has same number of elements. */
   CD_DUPLICATE = 4,
+  /**
+   * Share the data of the source layers, counting users of it. Shared layers are to be made
+   * unique with CustomData_duplicate_referenced_layer() before they are modified.
+   * Layers which can not be shared are duplicated.
+   */
+  CD_SHARE = 5,
 } eCDAllocType;
 
 #define CD_TYPE_AS_MASK(_type) (CustomDataMask)((CustomDataMask)1 << (CustomDataMask)(_type))
@@ -253,6 +259,13 @@ void CustomData_copy_data_named(const struct CustomData *source,
                                 int source_index,
                                 int dest_index,
                                 int count);
+/* like CustomData_copy_data, but gathers the source elements at src_indices
+ * into count consecutive dest elements starting at dest_index */
+void CustomData_copy_data_indices(const struct CustomData *source,
+                                  struct CustomData *dest,
+                                  const int *src_indices,
+                                  int dest_index,
+                                  int count);
 void CustomData_copy_elements(int type, void *src_data_ofs, void *dst_data_ofs, int count);
 void CustomData_bmesh_copy_data(const struct CustomData *source,
                                 struct CustomData *dest,
@@ -296,6 +309,16 @@ void CustomData_interp(const struct CustomData *source,
                        const float *sub_weights,
                        int count,
                        int dest_index);
+/* like CustomData_interp without sub_weights, for dest_count consecutive dest
+ * elements interpolated from the same source elements, each with its own weights
+ * (weights holds dest_count * count values) */
+void CustomData_interp_batch(const struct CustomData *source,
+                             struct CustomData *dest,
+                             const int *src_indices,
+                             const float *weights,
+                             int count,
+                             int dest_index,
+                             int dest_count);
 void CustomData_bmesh_interp_n(struct CustomData *data,
                                const void **src_blocks,
                                const float *weights,
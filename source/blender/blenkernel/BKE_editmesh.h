@@ -84,6 +84,13 @@ typedef struct BMEditMesh {
    */
   char needs_flush_to_id;
 
+  /**
+   * Only vertex coordinates changed since the last update (set by transform),
+   * lets the draw cache keep the buffers that only depend on topology.
+   * Cleared once the evaluated mesh has been updated.
+   */
+  char is_deform_update;
+
 } BMEditMesh;
 
 /* editmesh.c */
@@ -102,6 +102,9 @@ typedef struct EffectorCache {
 
   float frame;
   int flag;
+
+  /* precalculated scene settings, constant for all effected points */
+  bool scene_color_manage;
 } EffectorCache;
 
 typedef struct EffectorRelation {
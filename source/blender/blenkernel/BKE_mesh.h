@@ -186,6 +186,7 @@ void BKE_mesh_material_remap(struct Mesh *me, const unsigned int *remap, unsigne
 void BKE_mesh_smooth_flag_set(struct Mesh *me, const bool use_smooth);
 
 const char *BKE_mesh_cmp(struct Mesh *me1, struct Mesh *me2, float thresh);
+uint BKE_mesh_content_hash(const struct Mesh *me);
 
 struct BoundBox *BKE_mesh_boundbox_get(struct Object *ob);
 
@@ -258,6 +259,10 @@ void BKE_mesh_count_selected_items(const struct Mesh *mesh, int r_count[3]);
 
 float (*BKE_mesh_vert_coords_alloc(const struct Mesh *mesh, int *r_vert_len))[3];
 void BKE_mesh_vert_coords_get(const struct Mesh *mesh, float (*vert_coords)[3]);
+void BKE_mesh_vert_coords_normals_get_strided(const struct Mesh *mesh,
+                                              float *r_coords,
+                                              float *r_normals,
+                                              int stride);
 
 void BKE_mesh_vert_coords_apply_with_mat4(struct Mesh *mesh,
                                           const float (*vert_coords)[3],
@@ -685,6 +690,8 @@ enum {
   BKE_MESH_BATCH_DIRTY_SHADING,
   BKE_MESH_BATCH_DIRTY_UVEDIT_ALL,
   BKE_MESH_BATCH_DIRTY_UVEDIT_SELECT,
+  /** Only vertex coordinates changed, topology and custom-data are unchanged. */
+  BKE_MESH_BATCH_DIRTY_DEFORM,
 };
 void BKE_mesh_batch_cache_dirty_tag(struct Mesh *me, int mode);
 void BKE_mesh_batch_cache_free(struct Mesh *me);
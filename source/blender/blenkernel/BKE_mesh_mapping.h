@@ -247,6 +247,14 @@ int *BKE_mesh_calc_smoothgroups(const struct MEdge *medge,
                                 const int totloop,
                                 int *r_totgroup,
                                 const bool use_bitflags);
+int *BKE_mesh_calc_poly_islands(const struct MEdge *medge,
+                                const int totedge,
+                                const struct MPoly *mpoly,
+                                const int totpoly,
+                                const struct MLoop *mloop,
+                                const int totloop,
+                                const struct MeshElemMap *edge_poly_map,
+                                int *r_totgroup);
 
 /* use on looptri vertex values */
 #define BKE_MESH_TESSTRI_VINDEX_ORDER(_tri, _v) \
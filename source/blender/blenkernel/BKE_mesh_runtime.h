@@ -37,11 +37,22 @@ struct Depsgraph;
 struct KeyBlock;
 struct MLoop;
 struct MLoopTri;
+struct MeshElemMap;
 struct MVertTri;
 struct Mesh;
 struct Object;
 struct Scene;
 
+/** Maps cached in #Mesh_Runtime.topology_cache, see #BKE_mesh_runtime_topology_map_ensure. */
+typedef enum eMeshTopologyMap {
+  MESH_TOPOLOGY_MAP_VERT_POLY = 0,
+  MESH_TOPOLOGY_MAP_VERT_LOOP = 1,
+  MESH_TOPOLOGY_MAP_VERT_EDGE = 2,
+  MESH_TOPOLOGY_MAP_EDGE_POLY = 3,
+  MESH_TOPOLOGY_MAP_EDGE_LOOP = 4,
+} eMeshTopologyMap;
+#define MESH_TOPOLOGY_MAP_NUM 5
+
 void BKE_mesh_runtime_reset(struct Mesh *mesh);
 void BKE_mesh_runtime_reset_on_copy(struct Mesh *mesh, const int flag);
 int BKE_mesh_runtime_looptri_len(const struct Mesh *mesh);
@@ -52,10 +63,20 @@ bool BKE_mesh_runtime_clear_edit_data(struct Mesh *mesh);
 void BKE_mesh_runtime_clear_geometry(struct Mesh *mesh);
 void BKE_mesh_runtime_clear_cache(struct Mesh *mesh);
 
+const struct MeshElemMap *BKE_mesh_runtime_topology_map_ensure(struct Mesh *mesh,
+                                                               const eMeshTopologyMap type);
+const int *BKE_mesh_runtime_poly_islands_ensure(struct Mesh *mesh, int *r_islands_num);
+int BKE_mesh_runtime_topology_generation(struct Mesh *mesh);
+void BKE_mesh_runtime_topology_cache_share(struct Mesh *mesh_dst, const struct Mesh *mesh_src);
+
 void BKE_mesh_runtime_verttri_from_looptri(struct MVertTri *r_verttri,
                                            const struct MLoop *mloop,
                                            const struct MLoopTri *looptri,
                                            int looptri_num);
+void BKE_mesh_runtime_looptri_export(struct Mesh *mesh,
+                                     int *r_tri_verts,
+                                     int *r_tri_mat_nr,
+                                     bool *r_tri_smooth);
 
 /* NOTE: the functions below are defined in DerivedMesh.c, and are intended to be moved
  * to a more suitable location when that file is removed.
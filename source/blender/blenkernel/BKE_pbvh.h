@@ -74,6 +74,10 @@ typedef enum {
   PBVH_FullyUnmasked = 1 << 12,
 
   PBVH_UpdateTopology = 1 << 13,
+
+  /* Partial draw buffer updates, #PBVH_UpdateDrawBuffers updates all attributes. */
+  PBVH_UpdateDrawMask = 1 << 14,
+  PBVH_UpdateDrawColor = 1 << 15,
 } PBVHNodeFlags;
 
 typedef struct PBVHFrustumPlanes {
@@ -245,6 +249,7 @@ bool BKE_pbvh_bmesh_update_topology(PBVH *bvh,
 
 void BKE_pbvh_node_mark_update(PBVHNode *node);
 void BKE_pbvh_node_mark_update_mask(PBVHNode *node);
+void BKE_pbvh_node_mark_update_color(PBVHNode *node);
 void BKE_pbvh_node_mark_update_visibility(PBVHNode *node);
 void BKE_pbvh_node_mark_rebuild_draw(PBVHNode *node);
 void BKE_pbvh_node_mark_redraw(PBVHNode *node);
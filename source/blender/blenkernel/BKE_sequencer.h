@@ -86,9 +86,13 @@ void BKE_sequence_iterator_end(SeqIterator *iter);
   } \
   ((void)0)
 
+#define SEQ_PREFETCH_MAX_WORKERS 8
+
 typedef enum eSeqTaskId {
   SEQ_TASK_MAIN_RENDER,
+  /* Prefetch worker N uses SEQ_TASK_PREFETCH_RENDER + N. */
   SEQ_TASK_PREFETCH_RENDER,
+  SEQ_TASK_NUM = SEQ_TASK_PREFETCH_RENDER + SEQ_PREFETCH_MAX_WORKERS,
 } eSeqTaskId;
 
 typedef struct SeqRenderData {
@@ -226,8 +226,8 @@ Subdiv *BKE_subdiv_new_from_mesh(const SubdivSettings *settings, const struct Me
 
 /* Similar to above, but will not re-create descriptor if it was created for the
  * same settings and topology.
- * If settings or topology did change, the existing descriptor is freed and a
- * new one is created from scratch.
+ * If settings or topology did change, the existing descriptor is released to the
+ * cache and a matching descriptor is taken from the cache or created from scratch.
  *
  * NOTE: It is allowed to pass NULL as an existing subdivision surface
  * descriptor. This will create a new descriptor without any extra checks.
@@ -241,6 +241,17 @@ Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
 
 void BKE_subdiv_free(Subdiv *subdiv);
 
+/* ================================= CACHE ================================== */
+
+/* Hand descriptor which is no longer used by its owner over to the global cache,
+ * so it can be re-used by BKE_subdiv_update_from_converter() for the same topology
+ * instead of being re-created from scratch.
+ * The descriptor must not be accessed by the caller afterwards. */
+void BKE_subdiv_cache_release(Subdiv *subdiv);
+
+/* Free all cached descriptors. */
+void BKE_subdiv_cache_free(void);
+
 /* ============================ DISPLACEMENT API ============================ */
 
 void BKE_subdiv_displacement_attach_from_multires(Subdiv *subdiv,
@@ -31,6 +31,7 @@ extern "C" {
 #endif
 
 struct Mesh;
+struct OpenSubdiv_PatchCoord;
 struct Subdiv;
 
 /* Returns true if evaluator is ready for use. */
@@ -96,6 +97,21 @@ void BKE_subdiv_eval_displacement(struct Subdiv *subdiv,
 void BKE_subdiv_eval_final_point(
     struct Subdiv *subdiv, const int ptex_face_index, const float u, const float v, float r_P[3]);
 
+/* Batched queries.
+ *
+ * Evaluate limit surface at all given patch coordinates with a single call to the
+ * evaluator, which is much cheaper than evaluating points one by one.
+ * Derivatives are optional: either both r_dPdu and r_dPdv are NULL or none of them.
+ * Output arrays are expected to have num_patch_coords elements. */
+
+void BKE_subdiv_eval_limit_points_and_derivatives(
+    struct Subdiv *subdiv,
+    const struct OpenSubdiv_PatchCoord *patch_coords,
+    const int num_patch_coords,
+    float (*r_P)[3],
+    float (*r_dPdu)[3],
+    float (*r_dPdv)[3]);
+
 /* Patch queries at given resolution.
  *
  * Will evaluate patch at uniformly distributed (u, v) coordinates on a grid
@@ -1736,6 +1736,51 @@ static void mesh_runtime_check_normals_valid(const Mesh *mesh)
   BLI_assert(!(mesh->runtime.cd_dirty_poly & CD_MASK_NORMAL));
 }
 
+/**
+ * Playback of a deformed mesh (armature, shape keys, ...) creates a new evaluated mesh on every
+ * update, which used to throw away all of its GPU buffers.
+ * Take the previous evaluated mesh so its batch cache can be moved over
+ * when only the vertex coordinates can have changed, see #mesh_batch_cache_deform_reuse.
+ */
+static Mesh *mesh_batch_cache_deform_source_take(Object *ob,
+                                                 const CustomData_MeshMasks *dataMask,
+                                                 const bool need_mapping)
+{
+  if (!ob->runtime.is_data_eval_owned || ob->runtime.data_eval == NULL ||
+      GS(ob->runtime.data_eval->name) != ID_ME) {
+    return NULL;
+  }
+  Mesh *mesh_prev = (Mesh *)ob->runtime.data_eval;
+  if (mesh_prev->runtime.batch_cache == NULL || !mesh_prev->runtime.deformed_only ||
+      mesh_prev->runtime.subdiv_ccg != NULL || mesh_prev->edit_mesh != NULL) {
+    return NULL;
+  }
+  /* The original mesh was copied again, its topology or custom-data may have changed. */
+  const ID *id_orig = ob->runtime.data_orig;
+  if (id_orig == NULL || (id_orig->recalc & ID_RECALC_COPY_ON_WRITE)) {
+    return NULL;
+  }
+  if (ob->runtime.last_need_mapping != need_mapping ||
+      memcmp(&ob->runtime.last_data_mask, dataMask, sizeof(*dataMask)) != 0) {
+    return NULL;
+  }
+  /* Detach, so it isn't freed with the other derived caches. */
+  ob->runtime.data_eval = NULL;
+  return mesh_prev;
+}
+
+static void mesh_batch_cache_deform_reuse(Mesh *mesh_prev, Mesh *mesh_eval, const bool is_owned)
+{
+  if (is_owned && mesh_eval->runtime.deformed_only && mesh_eval->runtime.batch_cache == NULL &&
+      mesh_eval->totvert == mesh_prev->totvert && mesh_eval->totedge == mesh_prev->totedge &&
+      mesh_eval->totloop == mesh_prev->totloop && mesh_eval->totpoly == mesh_prev->totpoly) {
+    mesh_eval->runtime.batch_cache = mesh_prev->runtime.batch_cache;
+    mesh_eval->runtime.is_deform_update = true;
+    mesh_prev->runtime.batch_cache = NULL;
+  }
+  BKE_mesh_eval_delete(mesh_prev);
+}
+
 static void mesh_build_data(struct Depsgraph *depsgraph,
                             Scene *scene,
                             Object *ob,
@@ -1748,6 +1793,8 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  Mesh *mesh_prev = mesh_batch_cache_deform_source_take(ob, dataMask, need_mapping);
+
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1785,6 +1832,10 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
   const bool is_mesh_eval_owned = (mesh_eval != mesh->runtime.mesh_eval);
   BKE_object_eval_assign_data(ob, &mesh_eval->id, is_mesh_eval_owned);
 
+  if (mesh_prev != NULL) {
+    mesh_batch_cache_deform_reuse(mesh_prev, mesh_eval, is_mesh_eval_owned);
+  }
+
   ob->runtime.mesh_deform_eval = mesh_deform_eval;
   ob->runtime.last_data_mask = *dataMask;
   ob->runtime.last_need_mapping = need_mapping;
@@ -35,6 +35,7 @@
 #include "BLI_dynstr.h"
 #include "BLI_listbase.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 
@@ -1665,6 +1666,47 @@ void BKE_keyingsets_free(ListBase *list)
 /* ***************************************** */
 /* Evaluation Data-Setting Backend */
 
+/* Check that an already resolved property can be animated at the given array index. */
+static bool animsys_rna_setting_validate(PointerRNA *ptr,
+                                         const char *path,
+                                         const int array_index,
+                                         PathResolvedRNA *r_result)
+{
+  if ((ptr->owner_id != NULL) && !RNA_property_animateable(&r_result->ptr, r_result->prop)) {
+    return false;
+  }
+
+  int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+
+  if (array_len && array_index >= array_len) {
+    if (G.debug & G_DEBUG) {
+      CLOG_WARN(&LOG,
+                "Animato: Invalid array index. ID = '%s',  '%s[%d]', array length is %d",
+                (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
+                path,
+                array_index,
+                array_len - 1);
+    }
+    return false;
+  }
+
+  r_result->prop_index = array_len ? array_index : -1;
+  return true;
+}
+
+static void animsys_rna_path_invalid_warn(PointerRNA *ptr, const char *path, const int array_index)
+{
+  /* XXX don't tag as failed yet though, as there are some legit situations (Action Constraint)
+   * where some channels will not exist, but shouldn't lock up Action */
+  if (G.debug & G_DEBUG) {
+    CLOG_WARN(&LOG,
+              "Animato: Invalid path. ID = '%s',  '%s[%d]'",
+              (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
+              path,
+              array_index);
+  }
+}
+
 bool BKE_animsys_store_rna_setting(PointerRNA *ptr,
                                    /* typically 'fcu->rna_path', 'fcu->array_index' */
                                    const char *rna_path,
@@ -1678,42 +1720,55 @@ bool BKE_animsys_store_rna_setting(PointerRNA *ptr,
   if (path) {
     /* get property to write to */
     if (RNA_path_resolve_property(ptr, path, &r_result->ptr, &r_result->prop)) {
-      if ((ptr->owner_id == NULL) || RNA_property_animateable(&r_result->ptr, r_result->prop)) {
-        int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
-
-        if (array_len && array_index >= array_len) {
-          if (G.debug & G_DEBUG) {
-            CLOG_WARN(&LOG,
-                      "Animato: Invalid array index. ID = '%s',  '%s[%d]', array length is %d",
-                      (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
-                      path,
-                      array_index,
-                      array_len - 1);
-          }
-        }
-        else {
-          r_result->prop_index = array_len ? array_index : -1;
-          success = true;
-        }
-      }
+      success = animsys_rna_setting_validate(ptr, path, array_index, r_result);
     }
     else {
       /* failed to get path */
-      /* XXX don't tag as failed yet though, as there are some legit situations (Action Constraint)
-       * where some channels will not exist, but shouldn't lock up Action */
-      if (G.debug & G_DEBUG) {
-        CLOG_WARN(&LOG,
-                  "Animato: Invalid path. ID = '%s',  '%s[%d]'",
-                  (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
-                  path,
-                  array_index);
-      }
+      animsys_rna_path_invalid_warn(ptr, path, array_index);
     }
   }
 
   return success;
 }
 
+/* Last resolved RNA path of a channel list. Consecutive F-Curves usually animate the
+ * components of the same array property (e.g. `location[0]` to `location[2]`),
+ * so this avoids parsing the same path again for each of them. */
+typedef struct AnimRNAPathCache {
+  const char *rna_path;
+  PointerRNA ptr;
+  /* NULL when `rna_path` could not be resolved. */
+  PropertyRNA *prop;
+} AnimRNAPathCache;
+
+/* Same as #BKE_animsys_store_rna_setting, reusing the cached path resolution when possible. */
+static bool animsys_store_rna_setting_cached(PointerRNA *ptr,
+                                             const char *rna_path,
+                                             const int array_index,
+                                             AnimRNAPathCache *cache,
+                                             PathResolvedRNA *r_result)
+{
+  if (rna_path == NULL) {
+    return false;
+  }
+
+  if (cache->rna_path == NULL || !STREQ(cache->rna_path, rna_path)) {
+    cache->rna_path = rna_path;
+    if (!RNA_path_resolve_property(ptr, rna_path, &cache->ptr, &cache->prop)) {
+      cache->prop = NULL;
+    }
+  }
+
+  if (cache->prop == NULL) {
+    animsys_rna_path_invalid_warn(ptr, rna_path, array_index);
+    return false;
+  }
+
+  r_result->ptr = cache->ptr;
+  r_result->prop = cache->prop;
+  return animsys_rna_setting_validate(ptr, rna_path, array_index, r_result);
+}
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > ((1.0f - FLT_EPSILON)))
 
@@ -1885,6 +1940,108 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/* Channel lists with at least this many F-Curves calculate their values in parallel. */
+#define ANIMSYS_FCURVES_PARALLEL_THRESHOLD 256
+
+static bool animsys_fcurve_is_evaluated(FCurve *fcu)
+{
+  /* Check if this F-Curve doesn't belong to a muted group. */
+  if ((fcu->grp != NULL) && (fcu->grp->flag & AGRP_MUTED)) {
+    return false;
+  }
+  /* Check if this curve should be skipped. */
+  if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED))) {
+    return false;
+  }
+  /* Skip empty curves, as if muted. */
+  if (BKE_fcurve_is_empty(fcu)) {
+    return false;
+  }
+  return true;
+}
+
+/* Write the value of an F-Curve, and to the original data-block when `ptr_orig` is given. */
+static void animsys_write_fcurve_value(PathResolvedRNA *anim_rna,
+                                       const FCurve *fcu,
+                                       const float curval,
+                                       PointerRNA *ptr_orig,
+                                       AnimRNAPathCache *orig_path_cache)
+{
+  BKE_animsys_write_rna_setting(anim_rna, curval);
+  if (ptr_orig != NULL) {
+    PathResolvedRNA orig_anim_rna;
+    if (animsys_store_rna_setting_cached(
+            ptr_orig, fcu->rna_path, fcu->array_index, orig_path_cache, &orig_anim_rna)) {
+      BKE_animsys_write_rna_setting(&orig_anim_rna, curval);
+    }
+  }
+}
+
+typedef struct AnimsysFCurvesEvalData {
+  FCurve **fcurves;
+  PathResolvedRNA *anim_rna;
+  float *values;
+  float ctime;
+} AnimsysFCurvesEvalData;
+
+static void animsys_evaluate_fcurve_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  AnimsysFCurvesEvalData *data = userdata;
+  data->values[i] = calculate_fcurve(&data->anim_rna[i], data->fcurves[i], data->ctime);
+}
+
+/* Same as the loop in #animsys_evaluate_fcurves, but the curve values are calculated in
+ * parallel. Paths are resolved and values are written single threaded, in list order. */
+static void animsys_evaluate_fcurves_parallel(PointerRNA *ptr,
+                                              ListBase *list,
+                                              const int fcurves_len,
+                                              float ctime,
+                                              PointerRNA *ptr_orig)
+{
+  AnimRNAPathCache path_cache = {NULL};
+  AnimRNAPathCache orig_path_cache = {NULL};
+  bool use_threading = true;
+  int num = 0;
+
+  AnimsysFCurvesEvalData data = {
+      .fcurves = MEM_mallocN(sizeof(*data.fcurves) * fcurves_len, __func__),
+      .anim_rna = MEM_mallocN(sizeof(*data.anim_rna) * fcurves_len, __func__),
+      .values = MEM_mallocN(sizeof(*data.values) * fcurves_len, __func__),
+      .ctime = ctime,
+  };
+
+  for (FCurve *fcu = list->first; fcu; fcu = fcu->next) {
+    if (!animsys_fcurve_is_evaluated(fcu)) {
+      continue;
+    }
+    if (animsys_store_rna_setting_cached(
+            ptr, fcu->rna_path, fcu->array_index, &path_cache, &data.anim_rna[num])) {
+      /* Drivers may run Python, which can't be evaluated from multiple threads. */
+      if (fcu->driver != NULL) {
+        use_threading = false;
+      }
+      data.fcurves[num++] = fcu;
+    }
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = use_threading;
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, num, &data, animsys_evaluate_fcurve_cb, &settings);
+
+  for (int i = 0; i < num; i++) {
+    animsys_write_fcurve_value(
+        &data.anim_rna[i], data.fcurves[i], data.values[i], ptr_orig, &orig_path_cache);
+  }
+
+  MEM_freeN(data.fcurves);
+  MEM_freeN(data.anim_rna);
+  MEM_freeN(data.values);
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -1895,27 +2052,35 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      float ctime,
                                      bool flush_to_original)
 {
+  PointerRNA ptr_orig;
+  if (flush_to_original && !animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
+    flush_to_original = false;
+  }
+
+  const int fcurves_len = BLI_listbase_count_at_most(list, ANIMSYS_FCURVES_PARALLEL_THRESHOLD);
+  if (fcurves_len == ANIMSYS_FCURVES_PARALLEL_THRESHOLD) {
+    animsys_evaluate_fcurves_parallel(ptr,
+                                      list,
+                                      BLI_listbase_count(list),
+                                      ctime,
+                                      flush_to_original ? &ptr_orig : NULL);
+    return;
+  }
+
+  AnimRNAPathCache path_cache = {NULL};
+  AnimRNAPathCache orig_path_cache = {NULL};
+
   /* Calculate then execute each curve. */
   for (FCurve *fcu = list->first; fcu; fcu = fcu->next) {
-    /* Check if this F-Curve doesn't belong to a muted group. */
-    if ((fcu->grp != NULL) && (fcu->grp->flag & AGRP_MUTED)) {
-      continue;
-    }
-    /* Check if this curve should be skipped. */
-    if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED))) {
-      continue;
-    }
-    /* Skip empty curves, as if muted. */
-    if (BKE_fcurve_is_empty(fcu)) {
+    if (!animsys_fcurve_is_evaluated(fcu)) {
       continue;
     }
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_store_rna_setting_cached(
+            ptr, fcu->rna_path, fcu->array_index, &path_cache, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, ctime);
-      BKE_animsys_write_rna_setting(&anim_rna, curval);
-      if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
-      }
+      animsys_write_fcurve_value(
+          &anim_rna, fcu, curval, flush_to_original ? &ptr_orig : NULL, &orig_path_cache);
     }
   }
 }
@@ -1926,6 +2091,7 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
 /* Evaluate Drivers */
 static void animsys_evaluate_drivers(PointerRNA *ptr, AnimData *adt, float ctime)
 {
+  AnimRNAPathCache path_cache = {NULL};
   FCurve *fcu;
 
   /* drivers are stored as F-Curves, but we cannot use the standard code, as we need to check if
@@ -1944,7 +2110,8 @@ static void animsys_evaluate_drivers(PointerRNA *ptr, AnimData *adt, float ctime
          * NOTE: for 'layering' option later on, we should check if we should remove old value
          * before adding new to only be done when drivers only changed. */
         PathResolvedRNA anim_rna;
-        if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+        if (animsys_store_rna_setting_cached(
+                ptr, fcu->rna_path, fcu->array_index, &path_cache, &anim_rna)) {
           const float curval = calculate_fcurve(&anim_rna, fcu, ctime);
           ok = BKE_animsys_write_rna_setting(&anim_rna, curval);
         }
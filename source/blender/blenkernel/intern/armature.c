@@ -1450,6 +1450,7 @@ static float dist_bone_deform(
 }
 
 static void pchan_bone_deform(bPoseChannel *pchan,
+                              const bool use_bbone,
                               float weight,
                               float vec[3],
                               DualQuat *dq,
@@ -1457,13 +1458,11 @@ static void pchan_bone_deform(bPoseChannel *pchan,
                               const float co[3],
                               float *contrib)
 {
-  Bone *bone = pchan->bone;
-
   if (!weight) {
     return;
   }
 
-  if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
+  if (use_bbone) {
     b_bone_deform(pchan, co, weight, vec, dq, mat);
   }
   else {
@@ -1474,6 +1473,18 @@ static void pchan_bone_deform(bPoseChannel *pchan,
   (*contrib) += weight;
 }
 
+/**
+ * Deform data for a vertex group, resolved once per evaluation
+ * so the per-weight loop doesn't need to look into the bone.
+ */
+typedef struct ArmatureDeformGroup {
+  /** NULL when the group has no deforming bone. */
+  bPoseChannel *pchan;
+  bool use_bbone;
+  /** #BONE_MULT_VG_ENV: multiply the group weight by the envelope. */
+  bool use_envelope_mult;
+} ArmatureDeformGroup;
+
 typedef struct ArmatureUserdata {
   Object *armOb;
   Object *target;
@@ -1493,7 +1504,11 @@ typedef struct ArmatureUserdata {
   MDeformVert *dverts;
 
   int defbase_tot;
-  bPoseChannel **defnrToPC;
+  const ArmatureDeformGroup *deform_groups;
+
+  /** Deforming pose channels, used for envelopes. */
+  bPoseChannel **deform_pchans;
+  int deform_pchans_len;
 
   float premat[4][4];
   float postmat[4][4];
@@ -1514,7 +1529,6 @@ static void armature_vert_task(void *__restrict userdata,
 
   MDeformVert *dvert;
   DualQuat sumdq, *dq = NULL;
-  bPoseChannel *pchan;
   float *co, dco[3];
   float sumvec[3], summat[3][3];
   float *vec = NULL, (*smat)[3] = NULL;
@@ -1588,35 +1602,32 @@ static void armature_vert_task(void *__restrict userdata,
     unsigned int j;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const uint index = dw->def_nr;
-      if (index < data->defbase_tot && (pchan = data->defnrToPC[index])) {
+      const ArmatureDeformGroup *dgroup;
+      if (index < data->defbase_tot && (dgroup = &data->deform_groups[index])->pchan) {
         float weight = dw->weight;
-        Bone *bone = pchan->bone;
 
         deformed = 1;
 
-        if (bone && bone->flag & BONE_MULT_VG_ENV) {
+        if (dgroup->use_envelope_mult) {
+          Bone *bone = dgroup->pchan->bone;
           weight *= distfactor_to_bone(
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
         }
 
-        pchan_bone_deform(pchan, weight, vec, dq, smat, co, &contrib);
+        pchan_bone_deform(dgroup->pchan, dgroup->use_bbone, weight, vec, dq, smat, co, &contrib);
       }
     }
     /* if there are vertexgroups but not groups with bones
      * (like for softbody groups) */
     if (deformed == 0 && use_envelope) {
-      for (pchan = data->armOb->pose->chanbase.first; pchan; pchan = pchan->next) {
-        if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-          contrib += dist_bone_deform(pchan, vec, dq, smat, co);
-        }
+      for (int k = 0; k < data->deform_pchans_len; k++) {
+        contrib += dist_bone_deform(data->deform_pchans[k], vec, dq, smat, co);
       }
     }
   }
   else if (use_envelope) {
-    for (pchan = data->armOb->pose->chanbase.first; pchan; pchan = pchan->next) {
-      if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-        contrib += dist_bone_deform(pchan, vec, dq, smat, co);
-      }
+    for (int k = 0; k < data->deform_pchans_len; k++) {
+      contrib += dist_bone_deform(data->deform_pchans[k], vec, dq, smat, co);
     }
   }
 
@@ -1682,7 +1693,9 @@ void armature_deform_verts(Object *armOb,
                            bGPDstroke *gps)
 {
   bArmature *arm = armOb->data;
-  bPoseChannel **defnrToPC = NULL;
+  ArmatureDeformGroup *deform_groups = NULL;
+  bPoseChannel **deform_pchans = NULL;
+  int deform_pchans_len = 0;
   MDeformVert *dverts = NULL;
   bDeformGroup *dg;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -1745,24 +1758,36 @@ void armature_deform_verts(Object *armOb,
       }
 
       if (use_dverts) {
-        defnrToPC = MEM_callocN(sizeof(*defnrToPC) * defbase_tot, "defnrToBone");
+        deform_groups = MEM_callocN(sizeof(*deform_groups) * defbase_tot, "defnrToBone");
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
          */
         for (i = 0, dg = target->defbase.first; dg; i++, dg = dg->next) {
-          defnrToPC[i] = BKE_pose_channel_find_name(armOb->pose, dg->name);
+          bPoseChannel *pchan = BKE_pose_channel_find_name(armOb->pose, dg->name);
           /* exclude non-deforming bones */
-          if (defnrToPC[i]) {
-            if (defnrToPC[i]->bone->flag & BONE_NO_DEFORM) {
-              defnrToPC[i] = NULL;
-            }
+          if (pchan && !(pchan->bone->flag & BONE_NO_DEFORM)) {
+            Bone *bone = pchan->bone;
+            deform_groups[i].pchan = pchan;
+            deform_groups[i].use_bbone = (bone->segments > 1 &&
+                                          pchan->runtime.bbone_segments == bone->segments);
+            deform_groups[i].use_envelope_mult = (bone->flag & BONE_MULT_VG_ENV) != 0;
           }
         }
       }
     }
   }
 
+  if (use_envelope) {
+    const int pchans_len = BLI_listbase_count(&armOb->pose->chanbase);
+    deform_pchans = MEM_mallocN(sizeof(*deform_pchans) * pchans_len, __func__);
+    LISTBASE_FOREACH (bPoseChannel *, pchan, &armOb->pose->chanbase) {
+      if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
+        deform_pchans[deform_pchans_len++] = pchan;
+      }
+    }
+  }
+
   ArmatureUserdata data = {.armOb = armOb,
                            .target = target,
                            .mesh = mesh,
@@ -1777,7 +1802,9 @@ void armature_deform_verts(Object *armOb,
                            .target_totvert = target_totvert,
                            .dverts = dverts,
                            .defbase_tot = defbase_tot,
-                           .defnrToPC = defnrToPC};
+                           .deform_groups = deform_groups,
+                           .deform_pchans = deform_pchans,
+                           .deform_pchans_len = deform_pchans_len};
 
   float obinv[4][4];
   invert_m4_m4(obinv, target->obmat);
@@ -1790,9 +1817,8 @@ void armature_deform_verts(Object *armOb,
   settings.min_iter_per_thread = 32;
   BLI_task_parallel_range(0, numVerts, &data, armature_vert_task, &settings);
 
-  if (defnrToPC) {
-    MEM_freeN(defnrToPC);
-  }
+  MEM_SAFE_FREE(deform_groups);
+  MEM_SAFE_FREE(deform_pchans);
 }
 
 /* ************ END Armature Deform ******************* */
@@ -2881,26 +2907,26 @@ void BKE_pose_where_is_bone(struct Depsgraph *depsgraph,
   if (do_extra) {
     /* Do constraints */
     if (pchan->constraints.first) {
-      bConstraintOb *cob;
+      bConstraintOb cob;
       float vec[3];
 
       /* make a copy of location of PoseChannel for later */
       copy_v3_v3(vec, pchan->pose_mat[3]);
 
       /* prepare PoseChannel for Constraint solving
-       * - makes a copy of matrix, and creates temporary struct to use
+       * - makes a copy of matrix into a temporary struct on the stack
        */
-      cob = BKE_constraints_make_evalob(depsgraph, scene, ob, pchan, CONSTRAINT_OBTYPE_BONE);
+      BKE_constraints_init_evalob(&cob, depsgraph, scene, ob, pchan, CONSTRAINT_OBTYPE_BONE);
 
       /* Solve PoseChannel's Constraints */
 
       /* ctime doesn't alter objects. */
-      BKE_constraints_solve(depsgraph, &pchan->constraints, cob, ctime);
+      BKE_constraints_solve(depsgraph, &pchan->constraints, &cob, ctime);
 
       /* cleanup after Constraint Solving
-       * - applies matrix back to pchan, and frees temporary struct used
+       * - applies matrix back to pchan
        */
-      BKE_constraints_clear_evalob(cob);
+      BKE_constraints_apply_evalob(&cob);
 
       /* prevent constraints breaking a chain */
       if (pchan->bone->flag & BONE_CONNECTED) {
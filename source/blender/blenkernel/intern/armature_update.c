@@ -759,10 +759,28 @@ void BKE_pose_bone_done(struct Depsgraph *depsgraph, struct Object *object, int
   DEG_debug_print_eval_subdata(
       depsgraph, __func__, object->id.name, object, "pchan", pchan->name, pchan);
   if (pchan->bone) {
-    invert_m4_m4(imat, pchan->bone->arm_mat);
-    mul_m4_m4m4(pchan->chan_mat, pchan->pose_mat, imat);
-    if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-      mat4_to_dquat(&pchan->runtime.deform_dual_quat, pchan->bone->arm_mat, pchan->chan_mat);
+    bPoseChannel_Runtime *runtime = &pchan->runtime;
+    const bool deform = !(pchan->bone->flag & BONE_NO_DEFORM);
+    /* Bones which didn't move since the previous evaluation (static or not animated ones) keep
+     * their deformation matrices, avoiding the matrix inversion and dual quaternion conversion.
+     * The dual quaternion is only cached for deforming bones, so the flag is part of the key. */
+    if (runtime->deform_cache_valid == (deform ? 2 : 1) &&
+        memcmp(runtime->deform_cache_pose_mat, pchan->pose_mat, sizeof(pchan->pose_mat)) == 0 &&
+        memcmp(runtime->deform_cache_arm_mat,
+               pchan->bone->arm_mat,
+               sizeof(runtime->deform_cache_arm_mat)) == 0) {
+      copy_m4_m4(pchan->chan_mat, runtime->deform_cache_chan_mat);
+    }
+    else {
+      invert_m4_m4(imat, pchan->bone->arm_mat);
+      mul_m4_m4m4(pchan->chan_mat, pchan->pose_mat, imat);
+      if (deform) {
+        mat4_to_dquat(&runtime->deform_dual_quat, pchan->bone->arm_mat, pchan->chan_mat);
+      }
+      copy_m4_m4(runtime->deform_cache_pose_mat, pchan->pose_mat);
+      copy_m4_m4(runtime->deform_cache_arm_mat, pchan->bone->arm_mat);
+      copy_m4_m4(runtime->deform_cache_chan_mat, pchan->chan_mat);
+      runtime->deform_cache_valid = deform ? 2 : 1;
     }
   }
   pose_channel_flush_to_orig_if_needed(depsgraph, object, pchan);
@@ -927,6 +945,7 @@ void BKE_pose_eval_proxy_copy_bone(struct Depsgraph *depsgraph, Object *object,
   }
   BKE_pose_copy_pchan_result(pchan, pchan_from);
   copy_dq_dq(&pchan->runtime.deform_dual_quat, &pchan_from->runtime.deform_dual_quat);
+  pchan->runtime.deform_cache_valid = 0;
   BKE_pchan_bbone_segments_cache_copy(pchan, pchan_from);
 
   pose_channel_flush_to_orig_if_needed(depsgraph, object, pchan);
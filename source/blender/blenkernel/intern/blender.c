@@ -57,6 +57,7 @@
 #include "BKE_studiolight.h"
 
 #include "DEG_depsgraph.h"
+#include "DEG_depsgraph_debug.h"
 
 #include "RE_pipeline.h"
 #include "RE_render_ext.h"
@@ -90,6 +91,7 @@ void BKE_blender_free(void)
   IMB_exit();
   BKE_cachefiles_exit();
   BKE_images_exit();
+  DEG_profile_end();
   DEG_free_node_types();
 
   BKE_brush_system_exit();
@@ -38,6 +38,7 @@
 
 #include "DNA_scene_types.h"
 
+#include "BLI_ghash.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
@@ -47,7 +48,9 @@
 #include "BKE_blendfile.h"
 #include "BKE_context.h"
 #include "BKE_global.h"
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
+#include "BKE_scene.h"
 
 #include "BLO_undofile.h"
 #include "BLO_readfile.h"
@@ -61,7 +64,11 @@
 
 #define UNDO_DISK 0
 
-bool BKE_memfile_undo_decode(MemFileUndoData *mfu, bContext *C)
+/**
+ * \param mfu_reference: Undo data the current Main was last written to or read from (optional).
+ * Data-blocks which did not change since are kept, along with their evaluated copies.
+ */
+bool BKE_memfile_undo_decode(MemFileUndoData *mfu, MemFileUndoData *mfu_reference, bContext *C)
 {
   Main *bmain = CTX_data_main(C);
   char mainstr[sizeof(bmain->name)];
@@ -72,12 +79,21 @@ bool BKE_memfile_undo_decode(MemFileUndoData *mfu, bContext *C)
   fileflags = G.fileflags;
   G.fileflags |= G_FILE_NO_UI;
 
+  /* Depsgraphs are freed along with the old scenes, keep them for the new ones. */
+  GHash *depsgraphs = NULL;
+  if (!UNDO_DISK && mfu_reference != NULL) {
+    depsgraphs = BKE_scene_undo_depsgraphs_extract(bmain);
+  }
+
   if (UNDO_DISK) {
     success = BKE_blendfile_read(C, mfu->filename, &(const struct BlendFileReadParams){0}, NULL);
   }
   else {
-    success = BKE_blendfile_read_from_memfile(
-        C, &mfu->memfile, &(const struct BlendFileReadParams){0}, NULL);
+    struct BlendFileReadParams params = {0};
+    if (mfu_reference != NULL) {
+      params.undo_reference_memfile = &mfu_reference->memfile;
+    }
+    success = BKE_blendfile_read_from_memfile(C, &mfu->memfile, &params, NULL);
   }
 
   /* Restore, bmain has been re-allocated. */
@@ -85,11 +101,18 @@ bool BKE_memfile_undo_decode(MemFileUndoData *mfu, bContext *C)
   BLI_strncpy(bmain->name, mainstr, sizeof(bmain->name));
   G.fileflags = fileflags;
 
+  if (depsgraphs != NULL) {
+    BKE_scene_undo_depsgraphs_restore(bmain, depsgraphs);
+  }
+
   if (success) {
     /* important not to update time here, else non keyed transforms are lost */
     DEG_on_visible_update(bmain, false);
   }
 
+  /* Main is in the state of the decoded step now. */
+  BKE_main_id_tag_all(bmain, LIB_TAG_UNDO_CHANGED | LIB_TAG_UNDO_OLD_ID_REUSED, false);
+
   return success;
 }
 
@@ -116,6 +139,9 @@ MemFileUndoData *BKE_memfile_undo_encode(Main *bmain, MemFileUndoData *mfu_prev)
     BLI_strncpy(mfu->filename, filename, sizeof(mfu->filename));
   }
   else {
+    /* Changes are tracked from the state which is written now. */
+    BKE_main_id_tag_all(bmain, LIB_TAG_UNDO_CHANGED, false);
+
     MemFile *prevfile = (mfu_prev) ? &(mfu_prev->memfile) : NULL;
     /* success = */ /* UNUSED */ BLO_write_file_mem(bmain, prevfile, &mfu->memfile, G.fileflags);
     mfu->undo_size = mfu->memfile.size;
@@ -1321,6 +1321,27 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
   bool is_cached = bvhcache_find(*bvh_cache, bvh_cache_type, &tree);
   BLI_rw_mutex_unlock(&cache_rwlock);
 
+  /* Build the tree without holding the global cache lock, so trees of other meshes can be built
+   * at the same time. The mesh mutex keeps other threads from building the same tree. */
+  ThreadMutex *build_mutex = NULL;
+  BVHCache **bvh_cache_build = bvh_cache;
+  if (is_cached == false && mesh->runtime.eval_mutex != NULL) {
+    build_mutex = mesh->runtime.eval_mutex;
+    BLI_mutex_lock(build_mutex);
+
+    BLI_rw_mutex_lock(&cache_rwlock, THREAD_LOCK_READ);
+    is_cached = bvhcache_find(*bvh_cache, bvh_cache_type, &tree);
+    BLI_rw_mutex_unlock(&cache_rwlock);
+
+    if (is_cached) {
+      BLI_mutex_unlock(build_mutex);
+      build_mutex = NULL;
+    }
+    else {
+      bvh_cache_build = NULL;
+    }
+  }
+
   if (is_cached && tree == NULL) {
     memset(data, 0, sizeof(*data));
     return tree;
@@ -1339,8 +1360,6 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
               mesh->medge, mesh->totedge, mesh->mvert, verts_len, &loose_vert_len);
         }
 
-        /* TODO: a global mutex lock held during the expensive operation of
-         * building the BVH tree is really bad for performance. */
         tree = bvhtree_from_mesh_verts_ex(data,
                                           mesh->mvert,
                                           verts_len,
@@ -1351,7 +1370,7 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                           tree_type,
                                           6,
                                           bvh_cache_type,
-                                          bvh_cache);
+                                          bvh_cache_build);
 
         if (loose_verts_mask != NULL) {
           MEM_freeN(loose_verts_mask);
@@ -1386,7 +1405,7 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                           tree_type,
                                           6,
                                           bvh_cache_type,
-                                          bvh_cache);
+                                          bvh_cache_build);
 
         if (loose_edges_mask != NULL) {
           MEM_freeN(loose_edges_mask);
@@ -1416,7 +1435,7 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                           tree_type,
                                           6,
                                           bvh_cache_type,
-                                          bvh_cache);
+                                          bvh_cache_build);
       }
       else {
         /* Setup BVHTreeFromMesh */
@@ -1452,7 +1471,7 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                             tree_type,
                                             6,
                                             bvh_cache_type,
-                                            bvh_cache);
+                                            bvh_cache_build);
       }
       else {
         /* Setup BVHTreeFromMesh */
@@ -1468,6 +1487,17 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
       break;
   }
 
+  if (build_mutex != NULL) {
+    BLI_rw_mutex_lock(&cache_rwlock, THREAD_LOCK_WRITE);
+    bvhcache_insert(bvh_cache, tree, bvh_cache_type);
+    BLI_rw_mutex_unlock(&cache_rwlock);
+    BLI_mutex_unlock(build_mutex);
+
+    if (data->tree != NULL) {
+      data->cached = true;
+    }
+  }
+
   if (data->tree != NULL) {
 #ifdef DEBUG
     if (BLI_bvhtree_get_tree_type(data->tree) != tree_type) {
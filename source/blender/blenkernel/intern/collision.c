@@ -903,12 +903,18 @@ static void cloth_selfcollision_impulse_vert(const float clamp_sq,
   vert->impulse_count++;
 }
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+/**
+ * Compute the impulses of a single self collision pair.
+ * Only reads the cloth state, so pairs can be handled in parallel.
+ *
+ * \return true when the pair needs a response.
+ */
+static bool cloth_selfcollision_impulse_calc(ClothModifierData *clmd,
+                                             const CollPair *collpair,
+                                             float ia[3][3],
+                                             float ib[3][3])
 {
-  int result = 0;
+  bool result = false;
   Cloth *cloth1;
   float w1, w2, w3, u1, u2, u3;
   float v1[3], v2[3], relativeVelocity[3];
@@ -916,93 +922,107 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
 
   cloth1 = clmd->clothObject;
 
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float ia[3][3] = {{0.0f}};
-    float ib[3][3] = {{0.0f}};
+  /* Compute barycentric coordinates for both collision points. */
+  collision_compute_barycentric(collpair->pa,
+                                cloth1->verts[collpair->ap1].tx,
+                                cloth1->verts[collpair->ap2].tx,
+                                cloth1->verts[collpair->ap3].tx,
+                                &w1,
+                                &w2,
+                                &w3);
 
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
-    }
+  collision_compute_barycentric(collpair->pb,
+                                cloth1->verts[collpair->bp1].tx,
+                                cloth1->verts[collpair->bp2].tx,
+                                cloth1->verts[collpair->bp3].tx,
+                                &u1,
+                                &u2,
+                                &u3);
 
-    /* Compute barycentric coordinates for both collision points. */
-    collision_compute_barycentric(collpair->pa,
-                                  cloth1->verts[collpair->ap1].tx,
-                                  cloth1->verts[collpair->ap2].tx,
-                                  cloth1->verts[collpair->ap3].tx,
-                                  &w1,
-                                  &w2,
-                                  &w3);
+  /* Calculate relative "velocity". */
+  collision_interpolateOnTriangle(v1,
+                                  cloth1->verts[collpair->ap1].tv,
+                                  cloth1->verts[collpair->ap2].tv,
+                                  cloth1->verts[collpair->ap3].tv,
+                                  w1,
+                                  w2,
+                                  w3);
+
+  collision_interpolateOnTriangle(v2,
+                                  cloth1->verts[collpair->bp1].tv,
+                                  cloth1->verts[collpair->bp2].tv,
+                                  cloth1->verts[collpair->bp3].tv,
+                                  u1,
+                                  u2,
+                                  u3);
 
-    collision_compute_barycentric(collpair->pb,
-                                  cloth1->verts[collpair->bp1].tx,
-                                  cloth1->verts[collpair->bp2].tx,
-                                  cloth1->verts[collpair->bp3].tx,
-                                  &u1,
-                                  &u2,
-                                  &u3);
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-    /* Calculate relative "velocity". */
-    collision_interpolateOnTriangle(v1,
-                                    cloth1->verts[collpair->ap1].tv,
-                                    cloth1->verts[collpair->ap2].tv,
-                                    cloth1->verts[collpair->ap3].tv,
-                                    w1,
-                                    w2,
-                                    w3);
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
 
-    collision_interpolateOnTriangle(v2,
-                                    cloth1->verts[collpair->bp1].tv,
-                                    cloth1->verts[collpair->bp2].tv,
-                                    cloth1->verts[collpair->bp3].tv,
-                                    u1,
-                                    u2,
-                                    u3);
+  /* TODO: Impulses should be weighed by mass as this is self col,
+   * this has to be done after mass distribution is implemented. */
 
-    sub_v3_v3v3(relativeVelocity, v2, v1);
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0, d = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3], time_multiplier;
 
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
 
-    /* TODO: Impulses should be weighed by mass as this is self col,
-     * this has to be done after mass distribution is implemented. */
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
 
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0, d = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3], time_multiplier;
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
 
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
+      impulse = magtangent / 1.5;
 
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
+      VECADDMUL(ia[0], vrel_t_pre, w1 * impulse);
+      VECADDMUL(ia[1], vrel_t_pre, w2 * impulse);
+      VECADDMUL(ia[2], vrel_t_pre, w3 * impulse);
 
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
+      VECADDMUL(ib[0], vrel_t_pre, -u1 * impulse);
+      VECADDMUL(ib[1], vrel_t_pre, -u2 * impulse);
+      VECADDMUL(ib[2], vrel_t_pre, -u3 * impulse);
+    }
 
-        impulse = magtangent / 1.5;
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 3.0f;
 
-        VECADDMUL(ia[0], vrel_t_pre, w1 * impulse);
-        VECADDMUL(ia[1], vrel_t_pre, w2 * impulse);
-        VECADDMUL(ia[2], vrel_t_pre, w3 * impulse);
+    VECADDMUL(ia[0], collpair->normal, w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, w3 * impulse);
 
-        VECADDMUL(ib[0], vrel_t_pre, -u1 * impulse);
-        VECADDMUL(ib[1], vrel_t_pre, -u2 * impulse);
-        VECADDMUL(ib[2], vrel_t_pre, -u3 * impulse);
+    VECADDMUL(ib[0], collpair->normal, -u1 * impulse);
+    VECADDMUL(ib[1], collpair->normal, -u2 * impulse);
+    VECADDMUL(ib[2], collpair->normal, -u3 * impulse);
+
+    time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
+
+    d = clmd->coll_parms->selfepsilon * 8.0f / 9.0f * 2.0f - collpair->distance;
+
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0 * impulse);
       }
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 3.0f;
+      repulse = max_ff(impulse, repulse);
+
+      impulse = repulse / 1.5f;
 
       VECADDMUL(ia[0], collpair->normal, w1 * impulse);
       VECADDMUL(ia[1], collpair->normal, w2 * impulse);
@@ -1011,70 +1031,118 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
       VECADDMUL(ib[0], collpair->normal, -u1 * impulse);
       VECADDMUL(ib[1], collpair->normal, -u2 * impulse);
       VECADDMUL(ib[2], collpair->normal, -u3 * impulse);
+    }
 
-      time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
+    result = true;
+  }
+  else {
+    float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
+    float d;
 
-      d = clmd->coll_parms->selfepsilon * 8.0f / 9.0f * 2.0f - collpair->distance;
+    d = clmd->coll_parms->selfepsilon * 8.0f / 9.0f * 2.0f - collpair->distance;
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = MIN2(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+    if (d > ALMOST_ZERO) {
+      /* Stay on the safe side and clamp repulse. */
+      float repulse = d * 1.0f / time_multiplier;
+      float impulse = repulse / 9.0f;
 
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0 * impulse);
-        }
+      VECADDMUL(ia[0], collpair->normal, w1 * impulse);
+      VECADDMUL(ia[1], collpair->normal, w2 * impulse);
+      VECADDMUL(ia[2], collpair->normal, w3 * impulse);
 
-        repulse = max_ff(impulse, repulse);
+      VECADDMUL(ib[0], collpair->normal, -u1 * impulse);
+      VECADDMUL(ib[1], collpair->normal, -u2 * impulse);
+      VECADDMUL(ib[2], collpair->normal, -u3 * impulse);
 
-        impulse = repulse / 1.5f;
+      result = true;
+    }
+  }
 
-        VECADDMUL(ia[0], collpair->normal, w1 * impulse);
-        VECADDMUL(ia[1], collpair->normal, w2 * impulse);
-        VECADDMUL(ia[2], collpair->normal, w3 * impulse);
 
-        VECADDMUL(ib[0], collpair->normal, -u1 * impulse);
-        VECADDMUL(ib[1], collpair->normal, -u2 * impulse);
-        VECADDMUL(ib[2], collpair->normal, -u3 * impulse);
-      }
+  return result;
+}
 
-      result = 1;
-    }
-    else {
-      float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-      float d;
+typedef struct SelfCollisionImpulse {
+  float ia[3][3];
+  float ib[3][3];
+  /** -1 for pairs that are skipped, otherwise the result of the impulse calculation. */
+  int result;
+} SelfCollisionImpulse;
 
-      d = clmd->coll_parms->selfepsilon * 8.0f / 9.0f * 2.0f - collpair->distance;
+typedef struct SelfCollisionImpulseData {
+  ClothModifierData *clmd;
+  const CollPair *collisions;
+  SelfCollisionImpulse *impulses;
+} SelfCollisionImpulseData;
 
-      if (d > ALMOST_ZERO) {
-        /* Stay on the safe side and clamp repulse. */
-        float repulse = d * 1.0f / time_multiplier;
-        float impulse = repulse / 9.0f;
+static void cloth_selfcollision_impulse_cb(void *__restrict userdata,
+                                           const int index,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SelfCollisionImpulseData *data = (SelfCollisionImpulseData *)userdata;
+  const CollPair *collpair = &data->collisions[index];
+  SelfCollisionImpulse *impulse = &data->impulses[index];
 
-        VECADDMUL(ia[0], collpair->normal, w1 * impulse);
-        VECADDMUL(ia[1], collpair->normal, w2 * impulse);
-        VECADDMUL(ia[2], collpair->normal, w3 * impulse);
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    impulse->result = -1;
+    return;
+  }
 
-        VECADDMUL(ib[0], collpair->normal, -u1 * impulse);
-        VECADDMUL(ib[1], collpair->normal, -u2 * impulse);
-        VECADDMUL(ib[2], collpair->normal, -u3 * impulse);
+  zero_m3(impulse->ia);
+  zero_m3(impulse->ib);
+  impulse->result = cloth_selfcollision_impulse_calc(
+      data->clmd, collpair, impulse->ia, impulse->ib);
+}
 
-        result = 1;
-      }
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               uint collision_count,
+                                               const float dt)
+{
+  int result = 0;
+  Cloth *cloth1 = clmd->clothObject;
+  float clamp_sq = clmd->coll_parms->self_clamp * dt;
+  clamp_sq *= clamp_sq;
+
+  SelfCollisionImpulse *impulses = MEM_malloc_arrayN(
+      collision_count, sizeof(*impulses), "cloth self collision impulses");
+
+  /* The impulses only depend on the state before this pass, compute them in parallel. */
+  SelfCollisionImpulseData data = {
+      .clmd = clmd,
+      .collisions = collpair,
+      .impulses = impulses,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = true;
+  BLI_task_parallel_range(
+      0, (int)collision_count, &data, cloth_selfcollision_impulse_cb, &settings);
+
+  /* Apply in order, so the result doesn't depend on threading. */
+  const SelfCollisionImpulse *impulse = impulses;
+  for (int i = 0; i < collision_count; i++, collpair++, impulse++) {
+    if (impulse->result == -1) {
+      continue;
     }
 
-    if (result) {
-      float clamp_sq = clmd->coll_parms->self_clamp * dt;
-      clamp_sq *= clamp_sq;
+    result |= impulse->result;
 
-      cloth_selfcollision_impulse_vert(clamp_sq, ia[0], &cloth1->verts[collpair->ap1]);
-      cloth_selfcollision_impulse_vert(clamp_sq, ia[1], &cloth1->verts[collpair->ap2]);
-      cloth_selfcollision_impulse_vert(clamp_sq, ia[2], &cloth1->verts[collpair->ap3]);
+    if (result) {
+      cloth_selfcollision_impulse_vert(clamp_sq, impulse->ia[0], &cloth1->verts[collpair->ap1]);
+      cloth_selfcollision_impulse_vert(clamp_sq, impulse->ia[1], &cloth1->verts[collpair->ap2]);
+      cloth_selfcollision_impulse_vert(clamp_sq, impulse->ia[2], &cloth1->verts[collpair->ap3]);
 
-      cloth_selfcollision_impulse_vert(clamp_sq, ib[0], &cloth1->verts[collpair->bp1]);
-      cloth_selfcollision_impulse_vert(clamp_sq, ib[1], &cloth1->verts[collpair->bp2]);
-      cloth_selfcollision_impulse_vert(clamp_sq, ib[2], &cloth1->verts[collpair->bp3]);
+      cloth_selfcollision_impulse_vert(clamp_sq, impulse->ib[0], &cloth1->verts[collpair->bp1]);
+      cloth_selfcollision_impulse_vert(clamp_sq, impulse->ib[1], &cloth1->verts[collpair->bp2]);
+      cloth_selfcollision_impulse_vert(clamp_sq, impulse->ib[2], &cloth1->verts[collpair->bp3]);
     }
   }
 
+  MEM_freeN(impulses);
+
   return result;
 }
 
@@ -120,16 +120,16 @@ void BKE_constraint_unique_name(bConstraint *con, ListBase *list)
 
 /* ----------------- Evaluation Loop Preparation --------------- */
 
-/* package an object/bone for use in constraint evaluation */
-/* This function MEM_calloc's a bConstraintOb struct,
- * that will need to be freed after evaluation */
-bConstraintOb *BKE_constraints_make_evalob(
-    Depsgraph *depsgraph, Scene *scene, Object *ob, void *subdata, short datatype)
+/* package an object/bone for use in constraint evaluation, into caller owned storage
+ * (typically on the stack, to avoid allocating for every evaluated object or bone) */
+void BKE_constraints_init_evalob(bConstraintOb *cob,
+                                 Depsgraph *depsgraph,
+                                 Scene *scene,
+                                 Object *ob,
+                                 void *subdata,
+                                 short datatype)
 {
-  bConstraintOb *cob;
-
-  /* create regardless of whether we have any data! */
-  cob = MEM_callocN(sizeof(bConstraintOb), "bConstraintOb");
+  memset(cob, 0, sizeof(*cob));
 
   /* for system time, part of deglobalization, code nicer later with local time (ton) */
   cob->scene = scene;
@@ -196,20 +196,28 @@ bConstraintOb *BKE_constraints_make_evalob(
       unit_m4(cob->startmat);
       break;
   }
+}
+
+/* package an object/bone for use in constraint evaluation */
+/* This function allocates a bConstraintOb struct,
+ * that will need to be freed after evaluation (with BKE_constraints_clear_evalob) */
+bConstraintOb *BKE_constraints_make_evalob(
+    Depsgraph *depsgraph, Scene *scene, Object *ob, void *subdata, short datatype)
+{
+  bConstraintOb *cob;
+
+  /* create regardless of whether we have any data! */
+  cob = MEM_mallocN(sizeof(bConstraintOb), "bConstraintOb");
+  BKE_constraints_init_evalob(cob, depsgraph, scene, ob, subdata, datatype);
 
   return cob;
 }
 
-/* cleanup after constraint evaluation */
-void BKE_constraints_clear_evalob(bConstraintOb *cob)
+/* copy the result of constraint evaluation back to the owner */
+void BKE_constraints_apply_evalob(bConstraintOb *cob)
 {
   float delta[4][4], imat[4][4];
 
-  /* prevent crashes */
-  if (cob == NULL) {
-    return;
-  }
-
   /* calculate delta of constraints evaluation */
   invert_m4_m4(imat, cob->startmat);
   /* XXX This would seem to be in wrong order. However, it does not work in 'right' order -
@@ -243,6 +251,17 @@ void BKE_constraints_clear_evalob(bConstraintOb *cob)
       break;
     }
   }
+}
+
+/* cleanup after constraint evaluation */
+void BKE_constraints_clear_evalob(bConstraintOb *cob)
+{
+  /* prevent crashes */
+  if (cob == NULL) {
+    return;
+  }
+
+  BKE_constraints_apply_evalob(cob);
 
   /* free tempolary struct */
   MEM_freeN(cob);
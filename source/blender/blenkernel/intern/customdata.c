@@ -54,6 +54,8 @@
 
 #include "CLG_log.h"
 
+#include "atomic_ops.h"
+
 /* only for customdata_data_transfer_interp_normal_normals */
 #include "data_transfer_intern.h"
 
@@ -65,6 +67,11 @@ BLI_STATIC_ASSERT(ARRAY_SIZE(((CustomData *)NULL)->typemap) == CD_NUMTYPES, "siz
 
 static CLG_LogRef LOG = {"bke.customdata"};
 
+/** Users counter of the layer data shared between several #CustomDataLayer. */
+typedef struct CustomDataSharing {
+  int users;
+} CustomDataSharing;
+
 /** Update mask_dst with layers defined in mask_src (equivalent to a bitwise OR). */
 void CustomData_MeshMasks_update(CustomData_MeshMasks *mask_dst,
                                  const CustomData_MeshMasks *mask_src)
@@ -1853,6 +1860,78 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 }
 #endif
 
+/**
+ * Only plain arrays are shared, layers with allocated elements (like #MDeformVert) are not.
+ * Vertices are not shared either: evaluation writes their normals in place
+ * (#BKE_mesh_ensure_normals_for_display and friends), which would modify the original mesh.
+ */
+static bool customData_layer_can_share(const CustomDataLayer *layer)
+{
+  if (layer->data == NULL || (layer->flag & (CD_FLAG_NOFREE | CD_FLAG_EXTERNAL))) {
+    return false;
+  }
+  if (layer->type == CD_MVERT) {
+    return false;
+  }
+  const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+  return (typeInfo->copy == NULL && typeInfo->free == NULL);
+}
+
+static bool customData_layer_is_shared(const CustomDataLayer *layer)
+{
+  return (layer->sharing != NULL) && (layer->sharing->users > 1);
+}
+
+static CustomDataSharing *customData_layer_sharing_ensure(CustomDataLayer *layer)
+{
+  if (layer->sharing == NULL) {
+    /* The same original layer might be copied by several dependency graphs at once. */
+    CustomDataSharing *sharing = MEM_mallocN(sizeof(*sharing), __func__);
+    sharing->users = 1;
+    if (atomic_cas_ptr((void **)&layer->sharing, NULL, sharing) != NULL) {
+      MEM_freeN(sharing);
+    }
+  }
+  return layer->sharing;
+}
+
+/**
+ * Stop sharing the data of the layer, without freeing it.
+ * \return true when this layer was the last user of the data.
+ */
+static bool customData_layer_sharing_release(CustomDataLayer *layer)
+{
+  CustomDataSharing *sharing = layer->sharing;
+  if (sharing == NULL) {
+    return true;
+  }
+  layer->sharing = NULL;
+  if (atomic_sub_and_fetch_int32(&sharing->users, 1) != 0) {
+    return false;
+  }
+  MEM_freeN(sharing);
+  return true;
+}
+
+/* Make sure the layer is the only user of its data, so it can be modified. */
+static void customData_layer_unshare(CustomDataLayer *layer)
+{
+  if (layer->sharing == NULL) {
+    return;
+  }
+  if (!customData_layer_is_shared(layer)) {
+    /* Last user, simply take ownership of the data. */
+    customData_layer_sharing_release(layer);
+    return;
+  }
+  void *data_copy = MEM_dupallocN(layer->data);
+  if (customData_layer_sharing_release(layer)) {
+    /* All other users went away in the meantime. */
+    MEM_freeN(layer->data);
+  }
+  layer->data = data_copy;
+}
+
 bool CustomData_merge(const struct CustomData *source,
                       struct CustomData *dest,
                       CustomDataMask mask,
@@ -1904,6 +1983,7 @@ bool CustomData_merge(const struct CustomData *source,
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
         data = layer->data;
         break;
       default:
@@ -1915,8 +1995,28 @@ bool CustomData_merge(const struct CustomData *source,
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
+    else if ((alloctype == CD_SHARE && customData_layer_can_share(layer)) ||
+             (alloctype == CD_REFERENCE && layer->sharing != NULL)) {
+      /* Referencing data which is already shared becomes one more user of it, so the reference
+       * does not depend on the life-time of the source layer. */
+      newlayer = customData_add_layer__internal(
+          dest, type, CD_ASSIGN, data, totelem, layer->name);
+      if (newlayer) {
+        newlayer->sharing = customData_layer_sharing_ensure((CustomDataLayer *)layer);
+        atomic_add_and_fetch_int32(&newlayer->sharing->users, 1);
+      }
+    }
     else {
-      newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
+      newlayer = customData_add_layer__internal(dest,
+                                                type,
+                                                (alloctype == CD_SHARE) ? CD_DUPLICATE : alloctype,
+                                                data,
+                                                totelem,
+                                                layer->name);
+      if (newlayer && alloctype == CD_ASSIGN) {
+        /* Assigned data is owned by the new layer now, so is its users count. */
+        newlayer->sharing = layer->sharing;
+      }
     }
 
     if (newlayer) {
@@ -1945,6 +2045,7 @@ void CustomData_realloc(CustomData *data, int totelem)
     if (layer->flag & CD_FLAG_NOFREE) {
       continue;
     }
+    customData_layer_unshare(layer);
     typeInfo = layerType_getInfo(layer->type);
     layer->data = MEM_reallocN(layer->data, (size_t)totelem * typeInfo->size);
   }
@@ -1969,6 +2070,11 @@ static void customData_free_layer__internal(CustomDataLayer *layer, int totelem)
 {
   const LayerTypeInfo *typeInfo;
 
+  if (!customData_layer_sharing_release(layer)) {
+    /* Data is still used by other layers. */
+    return;
+  }
+
   if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
     typeInfo = layerType_getInfo(layer->type);
 
@@ -2367,6 +2473,7 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
   data->layers[index].type = type;
   data->layers[index].flag = flag;
   data->layers[index].data = newlayerdata;
+  data->layers[index].sharing = NULL;
 
   /* Set default name if none exists. Note we only call DATA_()  once
    * we know there is a default name, to avoid overhead of locale lookups
@@ -2571,6 +2678,9 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
 
     layer->flag &= ~CD_FLAG_NOFREE;
   }
+  else {
+    customData_layer_unshare(layer);
+  }
 
   return layer->data;
 }
@@ -2624,7 +2734,7 @@ bool CustomData_is_referenced_layer(struct CustomData *data, int type)
 
   layer = &data->layers[layer_index];
 
-  return (layer->flag & CD_FLAG_NOFREE) != 0;
+  return (layer->flag & CD_FLAG_NOFREE) != 0 || customData_layer_is_shared(layer);
 }
 
 void CustomData_free_temporary(CustomData *data, int totelem)
@@ -2776,6 +2886,102 @@ void CustomData_copy_data(
   }
 }
 
+/**
+ * Gather elements of a layer, for #CustomData_copy_data_indices.
+ */
+static void CustomData_copy_data_layer_indices(const CustomData *source,
+                                               CustomData *dest,
+                                               int src_i,
+                                               int dst_i,
+                                               const int *src_indices,
+                                               int dst_index,
+                                               int count)
+{
+  const void *src_data = source->layers[src_i].data;
+  void *dst_data = dest->layers[dst_i].data;
+  const LayerTypeInfo *typeInfo = layerType_getInfo(source->layers[src_i].type);
+  const size_t size = (size_t)typeInfo->size;
+
+  if (!src_data || !dst_data) {
+    if (!(src_data == NULL && dst_data == NULL)) {
+      CLOG_WARN(&LOG,
+                "null data for %s type (%p --> %p), skipping",
+                layerType_getName(source->layers[src_i].type),
+                (void *)src_data,
+                (void *)dst_data);
+    }
+    return;
+  }
+
+  dst_data = POINTER_OFFSET(dst_data, (size_t)dst_index * size);
+
+  if (typeInfo->copy) {
+    for (int i = 0; i < count; i++) {
+      typeInfo->copy(POINTER_OFFSET(src_data, (size_t)src_indices[i] * size),
+                     POINTER_OFFSET(dst_data, (size_t)i * size),
+                     1);
+    }
+    return;
+  }
+
+  /* Constant sizes for the common types, so the copies get inlined. */
+#define GATHER_ELEMS(elem_size) \
+  for (int i = 0; i < count; i++) { \
+    memcpy(POINTER_OFFSET(dst_data, (size_t)i * (elem_size)), \
+           POINTER_OFFSET(src_data, (size_t)src_indices[i] * (elem_size)), \
+           (elem_size)); \
+  } \
+  ((void)0)
+
+  switch (size) {
+    case 4:
+      GATHER_ELEMS(4);
+      break;
+    case 8:
+      GATHER_ELEMS(8);
+      break;
+    case 12:
+      GATHER_ELEMS(12);
+      break;
+    case 16:
+      GATHER_ELEMS(16);
+      break;
+    default:
+      GATHER_ELEMS(size);
+      break;
+  }
+
+#undef GATHER_ELEMS
+}
+
+void CustomData_copy_data_indices(
+    const CustomData *source, CustomData *dest, const int *src_indices, int dest_index, int count)
+{
+  int src_i, dest_i;
+
+  if (count == 0) {
+    return;
+  }
+
+  /* copies a layer at a time, matching layers as CustomData_copy_data does */
+  dest_i = 0;
+  for (src_i = 0; src_i < source->totlayer; src_i++) {
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+      dest_i++;
+    }
+
+    if (dest_i >= dest->totlayer) {
+      return;
+    }
+
+    if (dest->layers[dest_i].type == source->layers[src_i].type) {
+      CustomData_copy_data_layer_indices(
+          source, dest, src_i, dest_i, src_indices, dest_index, count);
+      dest_i++;
+    }
+  }
+}
+
 void CustomData_copy_layer_type_data(const CustomData *source,
                                      CustomData *destination,
                                      int type,
@@ -2886,6 +3092,65 @@ void CustomData_interp(const CustomData *source,
   }
 }
 
+void CustomData_interp_batch(const CustomData *source,
+                             CustomData *dest,
+                             const int *src_indices,
+                             const float *weights,
+                             int count,
+                             int dest_index,
+                             int dest_count)
+{
+  int src_i, dest_i;
+  int j;
+  const void *source_buf[SOURCE_BUF_SIZE];
+  const void **sources = source_buf;
+
+  if (count > SOURCE_BUF_SIZE) {
+    sources = MEM_malloc_arrayN(count, sizeof(*sources), __func__);
+  }
+
+  /* interpolates a layer at a time, the sources only need to be looked up once per layer */
+  dest_i = 0;
+  for (src_i = 0; src_i < source->totlayer; src_i++) {
+    const LayerTypeInfo *typeInfo = layerType_getInfo(source->layers[src_i].type);
+    if (!typeInfo->interp) {
+      continue;
+    }
+
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+      dest_i++;
+    }
+
+    if (dest_i >= dest->totlayer) {
+      break;
+    }
+
+    if (dest->layers[dest_i].type == source->layers[src_i].type) {
+      void *src_data = source->layers[src_i].data;
+      void *dst_data = dest->layers[dest_i].data;
+
+      for (j = 0; j < count; j++) {
+        sources[j] = POINTER_OFFSET(src_data, (size_t)src_indices[j] * typeInfo->size);
+      }
+
+      for (j = 0; j < dest_count; j++) {
+        typeInfo->interp(
+            sources,
+            weights ? &weights[j * count] : NULL,
+            NULL,
+            count,
+            POINTER_OFFSET(dst_data, (size_t)(dest_index + j) * typeInfo->size));
+      }
+
+      dest_i++;
+    }
+  }
+
+  if (count > SOURCE_BUF_SIZE) {
+    MEM_freeN((void *)sources);
+  }
+}
+
 /**
  * Swap data inside each item, for all layers.
  * This only applies to item types that may store several sub-item data
@@ -3058,6 +3323,8 @@ void *CustomData_set_layer(const CustomData *data, int type, void *ptr)
     return NULL;
   }
 
+  /* The previous data is handed over to the caller, unless other layers are still using it. */
+  customData_layer_sharing_release(&data->layers[layer_index]);
   data->layers[layer_index].data = ptr;
 
   return ptr;
@@ -3071,6 +3338,7 @@ void *CustomData_set_layer_n(const struct CustomData *data, int type, int n, voi
     return NULL;
   }
 
+  customData_layer_sharing_release(&data->layers[layer_index]);
   data->layers[layer_index].data = ptr;
 
   return ptr;
@@ -3688,7 +3956,7 @@ bool CustomData_has_referenced(const struct CustomData *data)
 {
   int i;
   for (i = 0; i < data->totlayer; i++) {
-    if (data->layers[i].flag & CD_FLAG_NOFREE) {
+    if (data->layers[i].flag & CD_FLAG_NOFREE || customData_layer_is_shared(&data->layers[i])) {
       return true;
     }
   }
@@ -4059,7 +4327,8 @@ void CustomData_file_write_prepare(CustomData *data,
         }
         write_layers_size += chunk_size;
       }
-      write_layers[j++] = *layer;
+      write_layers[j] = *layer;
+      write_layers[j++].sharing = NULL;
     }
   }
   BLI_assert(j == data->totlayer);
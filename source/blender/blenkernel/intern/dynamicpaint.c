@@ -3920,7 +3920,8 @@ typedef struct DynamicPaintPaintData {
   Object *brushOb;
   const Scene *scene;
   const float timescale;
-  const int c_index;
+  /** Surface points inside grid cells that the brush can reach. */
+  const int *point_index;
 
   Mesh *mesh;
   const MVert *mvert;
@@ -3949,12 +3950,10 @@ static void dynamic_paint_paint_mesh_cell_point_cb_ex(
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
   const PaintBakeData *bData = sData->bData;
-  VolumeGrid *grid = bData->grid;
 
   const DynamicPaintBrushSettings *brush = data->brush;
 
   const float timescale = data->timescale;
-  const int c_index = data->c_index;
 
   const MVert *mvert = data->mvert;
   const MLoop *mloop = data->mloop;
@@ -3965,7 +3964,7 @@ static void dynamic_paint_paint_mesh_cell_point_cb_ex(
 
   BVHTreeFromMesh *treeData = data->treeData;
 
-  const int index = grid->t_index[grid->s_pos[c_index] + id];
+  const int index = data->point_index[id];
   const int samples = bData->s_num[index];
   int ss;
   float total_sample = (float)samples;
@@ -4341,7 +4340,8 @@ static int dynamicPaint_paintMesh(Depsgraph *depsgraph,
     if (grid && meshBrush_boundsIntersect(&grid->grid_bounds, &mesh_bb, brush, brush_radius)) {
       /* Build a bvh tree from transformed vertices */
       if (BKE_bvhtree_from_mesh_get(&treeData, mesh, BVHTREE_FROM_LOOPTRI, 4)) {
-        int c_index;
+        int *point_index = MEM_mallocN(sizeof(*point_index) * sData->total_points, __func__);
+        int c_index, num_points = 0;
         int total_cells = grid->dim[0] * grid->dim[1] * grid->dim[2];
 
         /* loop through space partitioning grid */
@@ -4352,32 +4352,36 @@ static int dynamicPaint_paintMesh(Depsgraph *depsgraph,
             continue;
           }
 
-          /* loop through cell points and process brush */
-          DynamicPaintPaintData data = {
-              .surface = surface,
-              .brush = brush,
-              .brushOb = brushOb,
-              .scene = scene,
-              .timescale = timescale,
-              .c_index = c_index,
-              .mesh = mesh,
-              .mvert = mvert,
-              .mloop = mloop,
-              .mlooptri = mlooptri,
-              .brush_radius = brush_radius,
-              .avg_brushNor = avg_brushNor,
-              .brushVelocity = brushVelocity,
-              .treeData = &treeData,
-          };
-          TaskParallelSettings settings;
-          BLI_parallel_range_settings_defaults(&settings);
-          settings.use_threading = (grid->s_num[c_index] > 250);
-          BLI_task_parallel_range(0,
-                                  grid->s_num[c_index],
-                                  &data,
-                                  dynamic_paint_paint_mesh_cell_point_cb_ex,
-                                  &settings);
+          /* gather cell points, so they are all processed in a single parallel loop */
+          memcpy(&point_index[num_points],
+                 &grid->t_index[grid->s_pos[c_index]],
+                 sizeof(*point_index) * grid->s_num[c_index]);
+          num_points += grid->s_num[c_index];
         }
+
+        DynamicPaintPaintData data = {
+            .surface = surface,
+            .brush = brush,
+            .brushOb = brushOb,
+            .scene = scene,
+            .timescale = timescale,
+            .point_index = point_index,
+            .mesh = mesh,
+            .mvert = mvert,
+            .mloop = mloop,
+            .mlooptri = mlooptri,
+            .brush_radius = brush_radius,
+            .avg_brushNor = avg_brushNor,
+            .brushVelocity = brushVelocity,
+            .treeData = &treeData,
+        };
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.use_threading = (num_points > 250);
+        BLI_task_parallel_range(
+            0, num_points, &data, dynamic_paint_paint_mesh_cell_point_cb_ex, &settings);
+
+        MEM_freeN(point_index);
       }
     }
     /* free bvh tree */
@@ -4404,14 +4408,12 @@ static void dynamic_paint_paint_particle_cell_point_cb_ex(
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
   const PaintBakeData *bData = sData->bData;
-  VolumeGrid *grid = bData->grid;
 
   const DynamicPaintBrushSettings *brush = data->brush;
 
   const ParticleSystem *psys = data->psys;
 
   const float timescale = data->timescale;
-  const int c_index = data->c_index;
 
   KDTree_3d *tree = data->treeData;
 
@@ -4420,7 +4422,7 @@ static void dynamic_paint_paint_particle_cell_point_cb_ex(
   const float range = solidradius + smooth;
   const float particle_timestep = 0.04f * psys->part->timetweak;
 
-  const int index = grid->t_index[grid->s_pos[c_index] + id];
+  const int index = data->point_index[id];
   float disp_intersect = 0.0f;
   float radius = 0.0f;
   float strength = 0.0f;
@@ -4647,7 +4649,8 @@ static int dynamicPaint_paintParticles(DynamicPaintSurface *surface,
 
   /* only continue if particle bb is close enough to canvas bb */
   if (boundsIntersectDist(&grid->grid_bounds, &part_bb, range)) {
-    int c_index;
+    int *point_index = MEM_mallocN(sizeof(*point_index) * sData->total_points, __func__);
+    int c_index, num_points = 0;
     int total_cells = grid->dim[0] * grid->dim[1] * grid->dim[2];
 
     /* balance tree */
@@ -4660,25 +4663,29 @@ static int dynamicPaint_paintParticles(DynamicPaintSurface *surface,
         continue;
       }
 
-      /* loop through cell points */
-      DynamicPaintPaintData data = {
-          .surface = surface,
-          .brush = brush,
-          .psys = psys,
-          .solidradius = solidradius,
-          .timescale = timescale,
-          .c_index = c_index,
-          .treeData = tree,
-      };
-      TaskParallelSettings settings;
-      BLI_parallel_range_settings_defaults(&settings);
-      settings.use_threading = (grid->s_num[c_index] > 250);
-      BLI_task_parallel_range(0,
-                              grid->s_num[c_index],
-                              &data,
-                              dynamic_paint_paint_particle_cell_point_cb_ex,
-                              &settings);
+      /* gather cell points, so they are all processed in a single parallel loop */
+      memcpy(&point_index[num_points],
+             &grid->t_index[grid->s_pos[c_index]],
+             sizeof(*point_index) * grid->s_num[c_index]);
+      num_points += grid->s_num[c_index];
     }
+
+    DynamicPaintPaintData data = {
+        .surface = surface,
+        .brush = brush,
+        .psys = psys,
+        .solidradius = solidradius,
+        .timescale = timescale,
+        .point_index = point_index,
+        .treeData = tree,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (num_points > 250);
+    BLI_task_parallel_range(
+        0, num_points, &data, dynamic_paint_paint_particle_cell_point_cb_ex, &settings);
+
+    MEM_freeN(point_index);
   }
   BLI_threaded_malloc_end();
   BLI_kdtree_3d_free(tree);
@@ -160,6 +160,8 @@ static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *ef
     BLI_rng_srandom(eff->pd->rng, eff->pd->seed + cfra);
   }
 
+  eff->scene_color_manage = BKE_scene_check_color_management_enabled(eff->scene);
+
   if (eff->pd->forcefield == PFIELD_GUIDE && eff->ob->type == OB_CURVE) {
     Curve *cu = eff->ob->data;
     if (cu->flag & CU_PATH) {
@@ -636,7 +638,6 @@ int get_effector_data(EffectorCache *eff,
                       EffectedPoint *point,
                       int real_velocity)
 {
-  float cfra = DEG_get_ctime(eff->depsgraph);
   int ret = 0;
 
   /* In case surface object is in Edit mode when loading the .blend,
@@ -687,7 +688,7 @@ int get_effector_data(EffectorCache *eff,
       sim.psys = eff->psys;
 
       /* TODO: time from actual previous calculated frame (step might not be 1) */
-      state.time = cfra - 1.0f;
+      state.time = DEG_get_ctime(eff->depsgraph) - 1.0f;
       ret = psys_get_particle_state(&sim, *efd->index, &state, 0);
 
       /* TODO */
@@ -817,7 +818,7 @@ static void do_texture_effector(EffectorCache *eff,
   float nabla = eff->pd->tex_nabla;
   int hasrgb;
   short mode = eff->pd->tex_mode;
-  bool scene_color_manage;
+  const bool scene_color_manage = eff->scene_color_manage;
 
   if (!eff->pd->tex) {
     return;
@@ -841,8 +842,6 @@ static void do_texture_effector(EffectorCache *eff,
     madd_v3_v3fl(tex_co, efd->nor, fac);
   }
 
-  scene_color_manage = BKE_scene_check_color_management_enabled(eff->scene);
-
   hasrgb = multitex_ext(
       eff->pd->tex, tex_co, NULL, NULL, 0, result, 0, NULL, scene_color_manage, false);
 
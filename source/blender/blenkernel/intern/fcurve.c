@@ -2666,6 +2666,19 @@ static void berekeny(float f1, float f2, float f3, float f4, float *o, int b)
 /* -------------------------- */
 
 /* Calculate F-Curve value for 'evaltime' using BezTriple keyframes */
+/* Check whether evaltime lies strictly inside the segment ending at keyframe `index`,
+ * i.e. where #binarysearch_bezt_index_ex() would return `index` without an exact match. */
+static bool fcurve_segment_contains(const FCurve *fcu,
+                                    const BezTriple *bezts,
+                                    const int index,
+                                    const float evaltime,
+                                    const float threshold)
+{
+  return (index > 0) && (index < (int)fcu->totvert) &&
+         (evaltime - bezts[index - 1].vec[1][0] > threshold) &&
+         (bezts[index].vec[1][0] - evaltime > threshold);
+}
+
 static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime)
 {
   const float eps = 1.e-8f;
@@ -2798,7 +2811,22 @@ static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime
      *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
      *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
      */
-    a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+    const float threshold = 0.0001f;
+    const int hint = fcu->segment_hint;
+
+    /* Playback evaluates the same segment again or moves on to the next one most of the time,
+     * so check those before falling back to the search. */
+    if (fcurve_segment_contains(fcu, bezts, hint, evaltime, threshold)) {
+      a = hint;
+    }
+    else if (hint < (int)fcu->totvert &&
+             fcurve_segment_contains(fcu, bezts, hint + 1, evaltime, threshold)) {
+      a = hint + 1;
+    }
+    else {
+      a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, threshold, &exact);
+    }
+    fcu->segment_hint = exact ? a + 1 : a;
 
     if (exact) {
       /* index returned must be interpreted differently when it sits on top of an existing keyframe
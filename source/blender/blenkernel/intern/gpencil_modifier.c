@@ -30,6 +30,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_math_geom.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -858,6 +859,69 @@ void BKE_gpencil_prepare_eval_data(Depsgraph *depsgraph, Scene *scene, Object *o
   BKE_gpencil_update_orig_pointers(ob_orig, (Object *)ob);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Parallel Stroke Deform
+ * \{ */
+
+typedef struct GpencilDeformStrokeItem {
+  bGPDlayer *gpl;
+  bGPDframe *gpf;
+  bGPDstroke *gps;
+} GpencilDeformStrokeItem;
+
+typedef struct GpencilDeformStrokeData {
+  GpencilModifierData *md;
+  const GpencilModifierTypeInfo *mti;
+  Depsgraph *depsgraph;
+  Object *ob;
+  GpencilDeformStrokeItem *items;
+} GpencilDeformStrokeData;
+
+/* Deform modifiers that change the stroke list of the frame (and not only the stroke itself)
+ * can't run in parallel. */
+static bool gpencil_modifier_deform_is_stroke_local(const GpencilModifierData *md)
+{
+  if (md->type == eGpencilModifierType_Simplify) {
+    const SimplifyGpencilModifierData *mmd = (const SimplifyGpencilModifierData *)md;
+    /* Merging points may dissolve the whole stroke. */
+    return (mmd->mode != GP_SIMPLIFY_MERGE);
+  }
+  return true;
+}
+
+static void gpencil_deform_stroke_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GpencilDeformStrokeData *data = (GpencilDeformStrokeData *)userdata;
+  GpencilDeformStrokeItem *item = &data->items[i];
+  data->mti->deformStroke(data->md, data->depsgraph, data->ob, item->gpl, item->gpf, item->gps);
+}
+
+/* Apply a deform modifier to the strokes of all layers (retimed frame only), in parallel. */
+static void gpencil_modifier_deform_strokes(GpencilModifierData *md,
+                                            const GpencilModifierTypeInfo *mti,
+                                            Depsgraph *depsgraph,
+                                            Object *ob,
+                                            GpencilDeformStrokeItem *items,
+                                            const int items_len)
+{
+  GpencilDeformStrokeData data = {
+      .md = md,
+      .mti = mti,
+      .depsgraph = depsgraph,
+      .ob = ob,
+      .items = items,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, items_len, &data, gpencil_deform_stroke_cb, &settings);
+}
+
+/** \} */
+
 /* Calculate gpencil modifiers */
 void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
@@ -892,6 +956,24 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 
       /* Apply deform modifiers and Time remap (only change geometry). */
       if ((time_remap) || (mti && mti->deformStroke)) {
+        const bool use_threading = (mti->deformStroke != NULL) &&
+                                   gpencil_modifier_deform_is_stroke_local(md);
+        GpencilDeformStrokeItem *items = NULL;
+        int items_len = 0;
+
+        if (use_threading) {
+          int stroke_len = 0;
+          LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd->layers) {
+            bGPDframe *gpf = BKE_gpencil_frame_retime_get(depsgraph, scene, ob, gpl);
+            if (gpf != NULL) {
+              stroke_len += BLI_listbase_count(&gpf->strokes);
+            }
+          }
+          if (stroke_len > 0) {
+            items = MEM_mallocN(sizeof(*items) * stroke_len, __func__);
+          }
+        }
+
         LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd->layers) {
           bGPDframe *gpf = BKE_gpencil_frame_retime_get(depsgraph, scene, ob, gpl);
           if (gpf == NULL) {
@@ -899,11 +981,23 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
           }
 
           if (mti->deformStroke) {
-            LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
-              mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
+            if (use_threading) {
+              LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+                items[items_len++] = (GpencilDeformStrokeItem){gpl, gpf, gps};
+              }
+            }
+            else {
+              LISTBASE_FOREACH_MUTABLE (bGPDstroke *, gps, &gpf->strokes) {
+                mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
+              }
             }
           }
         }
+
+        if (items != NULL) {
+          gpencil_modifier_deform_strokes(md, mti, depsgraph, ob, items, items_len);
+          MEM_freeN(items);
+        }
       }
     }
   }
@@ -30,6 +30,7 @@
 #include "BLI_blenlib.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -787,6 +788,95 @@ static void cp_cu_key(Curve *cu,
   }
 }
 
+/** A key block contributing to #key_evaluate_relative_coords. */
+typedef struct KeyRelativeBlock {
+  float (*from)[3];
+  float (*reffrom)[3];
+  const float *weights;
+  float value;
+} KeyRelativeBlock;
+
+typedef struct KeyRelativeData {
+  float (*coords)[3];
+  const KeyRelativeBlock *blocks;
+  int blocks_len;
+} KeyRelativeData;
+
+static void key_evaluate_relative_coords_cb(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KeyRelativeData *data = userdata;
+  float *co = data->coords[i];
+
+  /* Same order as evaluating one key block after the other, so the result is identical. */
+  for (int j = 0; j < data->blocks_len; j++) {
+    const KeyRelativeBlock *block = &data->blocks[j];
+    const float weight = block->weights ? (block->weights[i] * block->value) : block->value;
+    rel_flerp(KEYELEM_FLOAT_LEN_COORD, co, block->reffrom[i], block->from[i], weight);
+  }
+}
+
+/**
+ * Version of #key_evaluate_relative for keys which only store coordinates (meshes & lattices),
+ * gathers the key blocks with an influence once, then evaluates all of them per vertex in
+ * parallel.
+ */
+static void key_evaluate_relative_coords(const int start,
+                                         const int end,
+                                         const int tot,
+                                         char *basispoin,
+                                         Key *key,
+                                         KeyBlock *actkb,
+                                         float **per_keyblock_weights)
+{
+  const int keyblocks_len = BLI_listbase_count(&key->block);
+  KeyRelativeBlock *blocks = MEM_mallocN(sizeof(*blocks) * keyblocks_len, __func__);
+  char **freefrom = MEM_callocN(sizeof(*freefrom) * keyblocks_len, __func__);
+  int blocks_len = 0;
+  KeyBlock *kb;
+  int keyblock_index;
+
+  for (kb = key->block.first, keyblock_index = 0; kb; kb = kb->next, keyblock_index++) {
+    if (kb == key->refkey || (kb->flag & KEYBLOCK_MUTE) || kb->curval == 0.0f ||
+        kb->totelem != tot) {
+      continue;
+    }
+    /* reference now can be any block */
+    KeyBlock *refb = BLI_findlink(&key->block, kb->relative);
+    if (refb == NULL) {
+      continue;
+    }
+
+    KeyRelativeBlock *block = &blocks[blocks_len];
+    block->from = (float(*)[3])key_block_get_data(key, actkb, kb, &freefrom[blocks_len]);
+    /* For meshes, use the original values instead of the bmesh values to
+     * maintain a constant offset. */
+    block->reffrom = refb->data;
+    block->weights = per_keyblock_weights ? per_keyblock_weights[keyblock_index] : NULL;
+    block->value = kb->curval;
+    blocks_len++;
+  }
+
+  if (blocks_len != 0) {
+    KeyRelativeData data = {
+        .coords = (float(*)[3])basispoin,
+        .blocks = blocks,
+        .blocks_len = blocks_len,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(start, end, &data, key_evaluate_relative_coords_cb, &settings);
+  }
+
+  for (int i = 0; i < blocks_len; i++) {
+    MEM_SAFE_FREE(freefrom[i]);
+  }
+  MEM_freeN(freefrom);
+  MEM_freeN(blocks);
+}
+
 static void key_evaluate_relative(const int start,
                                   int end,
                                   const int tot,
@@ -825,6 +915,12 @@ static void key_evaluate_relative(const int start,
 
   /* step 2: do it */
 
+  if (key->elemstr[0] == KEYELEM_FLOAT_LEN_COORD && key->elemstr[1] == IPO_FLOAT &&
+      key->elemstr[2] == 0 && step == 1 && poinsize == key->elemsize) {
+    key_evaluate_relative_coords(start, end, tot, basispoin, key, actkb, per_keyblock_weights);
+    return;
+  }
+
   for (kb = key->block.first, keyblock_index = 0; kb; kb = kb->next, keyblock_index++) {
     if (kb != key->refkey) {
       float icuval = kb->curval;
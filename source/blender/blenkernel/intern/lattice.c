@@ -346,6 +346,11 @@ typedef struct LatticeDeformData {
   Object *object;
   float *latticedata;
   float latmat[4][4];
+
+  /* Resolved once for all deformed points: the (edit) lattice and its vertex group. */
+  const Lattice *lt;
+  const MDeformVert *dvert;
+  int defgrp_index;
 } LatticeDeformData;
 
 LatticeDeformData *init_latt_deform(Object *oblatt, Object *ob)
@@ -413,33 +418,34 @@ LatticeDeformData *init_latt_deform(Object *oblatt, Object *ob)
   lattice_deform_data->object = oblatt;
   copy_m4_m4(lattice_deform_data->latmat, latmat);
 
+  lattice_deform_data->lt = lt;
+  lattice_deform_data->dvert = lt->dvert;
+  lattice_deform_data->defgrp_index = (lt->vgroup[0] && lt->dvert) ?
+                                          BKE_object_defgroup_name_index(oblatt, lt->vgroup) :
+                                          -1;
+
   return lattice_deform_data;
 }
 
 void calc_latt_deform(LatticeDeformData *lattice_deform_data, float co[3], float weight)
 {
-  Object *ob = lattice_deform_data->object;
-  Lattice *lt = ob->data;
+  const Lattice *lt = lattice_deform_data->lt;
   float u, v, w, tu[4], tv[4], tw[4];
   float vec[3];
   int idx_w, idx_v, idx_u;
   int ui, vi, wi, uu, vv, ww;
 
   /* vgroup influence */
-  int defgrp_index = -1;
+  const int defgrp_index = lattice_deform_data->defgrp_index;
   float co_prev[3], weight_blend = 0.0f;
-  MDeformVert *dvert = BKE_lattice_deform_verts_get(ob);
+  const MDeformVert *dvert = lattice_deform_data->dvert;
   float *__restrict latticedata = lattice_deform_data->latticedata;
 
-  if (lt->editlatt) {
-    lt = lt->editlatt->latt;
-  }
   if (latticedata == NULL) {
     return;
   }
 
-  if (lt->vgroup[0] && dvert) {
-    defgrp_index = BKE_object_defgroup_name_index(ob, lt->vgroup);
+  if (defgrp_index != -1) {
     copy_v3_v3(co_prev, co);
   }
 
@@ -650,6 +650,10 @@ int BKE_layer_collection_findindex(ViewLayer *view_layer, const LayerCollection
  * in at least one layer collection. That list is also synchronized here, and
  * stores state like selection. */
 
+/* Collections with at least this many children use hashed lookups while syncing,
+ * linear lookups would make syncing quadratic in the number of children. */
+#define LAYER_COLLECTION_SYNC_HASH_MIN 32
+
 static short layer_collection_sync(ViewLayer *view_layer,
                                    const ListBase *lb_scene,
                                    ListBase *lb_layer,
@@ -663,17 +667,30 @@ static short layer_collection_sync(ViewLayer *view_layer,
    * For local edits we can make editing operating do the appropriate thing, but for
    * linking we can only sync after the fact. */
 
+  GSet *scene_collections = NULL;
+  GHash *layer_collections = NULL;
+  if (BLI_listbase_count_at_most(lb_scene, LAYER_COLLECTION_SYNC_HASH_MIN) ==
+      LAYER_COLLECTION_SYNC_HASH_MIN) {
+    scene_collections = BLI_gset_ptr_new_ex(__func__, BLI_listbase_count(lb_scene));
+    for (const CollectionChild *child = lb_scene->first; child; child = child->next) {
+      BLI_gset_add(scene_collections, child->collection);
+    }
+  }
+
   /* Remove layer collections that no longer have a corresponding scene collection. */
   for (LayerCollection *lc = lb_layer->first; lc;) {
     /* Note ID remap can set lc->collection to NULL when deleting collections. */
     LayerCollection *lc_next = lc->next;
-    Collection *collection = (lc->collection) ?
-                                 BLI_findptr(lb_scene,
-                                             lc->collection,
-                                             offsetof(CollectionChild, collection)) :
-                                 NULL;
+    bool has_collection = false;
+    if (lc->collection) {
+      has_collection = (scene_collections != NULL) ?
+                           BLI_gset_haskey(scene_collections, lc->collection) :
+                           (BLI_findptr(lb_scene,
+                                        lc->collection,
+                                        offsetof(CollectionChild, collection)) != NULL);
+    }
 
-    if (!collection) {
+    if (!has_collection) {
       if (lc == view_layer->active_collection) {
         view_layer->active_collection = NULL;
       }
@@ -686,13 +703,24 @@ static short layer_collection_sync(ViewLayer *view_layer,
     lc = lc_next;
   }
 
+  if (scene_collections != NULL) {
+    BLI_gset_free(scene_collections, NULL);
+    layer_collections = BLI_ghash_ptr_new_ex(__func__, BLI_listbase_count(lb_layer));
+    for (LayerCollection *lc = lb_layer->first; lc; lc = lc->next) {
+      BLI_ghash_insert(layer_collections, lc->collection, lc);
+    }
+  }
+
   /* Add layer collections for any new scene collections, and ensure order is the same. */
   ListBase new_lb_layer = {NULL, NULL};
   short runtime_flag = 0;
 
   for (const CollectionChild *child = lb_scene->first; child; child = child->next) {
     Collection *collection = child->collection;
-    LayerCollection *lc = BLI_findptr(lb_layer, collection, offsetof(LayerCollection, collection));
+    LayerCollection *lc = (layer_collections != NULL) ?
+                              BLI_ghash_lookup(layer_collections, collection) :
+                              BLI_findptr(
+                                  lb_layer, collection, offsetof(LayerCollection, collection));
 
     if (lc) {
       BLI_remlink(lb_layer, lc);
@@ -806,6 +834,10 @@ static short layer_collection_sync(ViewLayer *view_layer,
     runtime_flag |= lc->runtime_flag;
   }
 
+  if (layer_collections != NULL) {
+    BLI_ghash_free(layer_collections, NULL, NULL);
+  }
+
   /* Replace layer collection list with new one. */
   *lb_layer = new_lb_layer;
   BLI_assert(BLI_listbase_count(lb_scene) == BLI_listbase_count(lb_layer));
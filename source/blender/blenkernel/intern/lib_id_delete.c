@@ -297,6 +297,13 @@ static void id_delete(Main *bmain, const bool do_tagged_deletion)
 
   base_count = set_listbasepointers(bmain, lbarray);
 
+  /* Let remapping only visit actual users of deleted IDs, instead of all IDs of Main for each of
+   * them. Unlinking never adds new usages, so relations remain valid until IDs get freed. */
+  const bool use_own_relations = (bmain->relations == NULL);
+  if (use_own_relations) {
+    BKE_main_relations_create(bmain, 0);
+  }
+
   BKE_main_lock(bmain);
   if (do_tagged_deletion) {
     /* Main idea of batch deletion is to remove all IDs to be deleted from Main database.
@@ -385,6 +392,10 @@ static void id_delete(Main *bmain, const bool do_tagged_deletion)
   }
   BKE_main_unlock(bmain);
 
+  if (use_own_relations) {
+    BKE_main_relations_free(bmain);
+  }
+
   /* In usual reversed order, such that all usage of a given ID, even 'never NULL' ones,
    * have been already cleared when we reach it
    * (e.g. Objects being processed before meshes, they'll have already released their 'reference'
@@ -387,6 +387,27 @@ static void libblock_remap_data(
     BKE_library_foreach_ID_link(
         NULL, id, foreach_libblock_remap_callback, (void *)r_id_remap_data, foreach_id_flags);
   }
+  else if (bmain->relations != NULL) {
+    /* Only process IDs actually using given old_id, when the caller built Main relations.
+     * Entries of a same user are contiguous, since relations are built one ID at a time. */
+    MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->id_used_to_user, old_id);
+    ID *id_prev = NULL;
+
+    for (; entry != NULL; entry = entry->next) {
+      ID *id_curr = (ID *)entry->id_pointer;
+      if (id_curr == id_prev) {
+        continue;
+      }
+      id_prev = id_curr;
+      r_id_remap_data->id = id_curr;
+      libblock_remap_data_preprocess(r_id_remap_data);
+      BKE_library_foreach_ID_link(NULL,
+                                  id_curr,
+                                  foreach_libblock_remap_callback,
+                                  (void *)r_id_remap_data,
+                                  foreach_id_flags);
+    }
+  }
   else {
     /* Note that this is a very 'brute force' approach,
      * maybe we could use some depsgraph to only process objects actually using given old_id...
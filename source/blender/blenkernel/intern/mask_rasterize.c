@@ -1451,11 +1451,28 @@ float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float x
   return value;
 }
 
+/**
+ * Value of all samples outside of the bounds of every layer,
+ * this only depends on layer blending and inversion.
+ */
+static float maskrasterize_handle_sample_outside(MaskRasterHandle *mr_handle)
+{
+  const rctf *bounds = &mr_handle->bounds;
+  float xy[2] = {0.0f, 0.0f};
+  /* When there are no bounds (no visible layers) any point is outside. */
+  if (bounds->xmin <= bounds->xmax) {
+    xy[0] = bounds->xmin - 1.0f;
+    xy[1] = bounds->ymin - 1.0f;
+  }
+  return BKE_maskrasterize_handle_sample(mr_handle, xy);
+}
+
 typedef struct MaskRasterizeBufferData {
   MaskRasterHandle *mr_handle;
   float x_inv, y_inv;
   float x_px_ofs, y_px_ofs;
   uint width;
+  float value_outside;
 
   float *buffer;
 } MaskRasterizeBufferData;
@@ -1473,13 +1490,28 @@ static void maskrasterize_buffer_cb(void *__restrict userdata,
   const float x_inv = data->x_inv;
   const float x_px_ofs = data->x_px_ofs;
 
+  const rctf *bounds = &mr_handle->bounds;
+  const float value_outside = data->value_outside;
+
   uint i = (uint)y * width;
   float xy[2];
   xy[1] = ((float)y * data->y_inv) + data->y_px_ofs;
+
+  /* Rows outside all layers are constant, masks often cover a small part of the frame. */
+  if (xy[1] < bounds->ymin || xy[1] > bounds->ymax) {
+    copy_vn_fl(&buffer[i], (int)width, value_outside);
+    return;
+  }
+
   for (uint x = 0; x < width; x++, i++) {
     xy[0] = ((float)x * x_inv) + x_px_ofs;
 
-    buffer[i] = BKE_maskrasterize_handle_sample(mr_handle, xy);
+    if (xy[0] < bounds->xmin || xy[0] > bounds->xmax) {
+      buffer[i] = value_outside;
+    }
+    else {
+      buffer[i] = BKE_maskrasterize_handle_sample(mr_handle, xy);
+    }
   }
 }
 
@@ -1501,6 +1533,7 @@ void BKE_maskrasterize_buffer(MaskRasterHandle *mr_handle,
       .x_px_ofs = x_inv * 0.5f,
       .y_px_ofs = y_inv * 0.5f,
       .width = width,
+      .value_outside = maskrasterize_handle_sample_outside(mr_handle),
       .buffer = buffer,
   };
   TaskParallelSettings settings;
@@ -33,6 +33,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_ghash.h"
 #include "BLI_hash.h"
+#include "BLI_hash_mm3.h"
 #include "BLI_math.h"
 #include "BLI_linklist.h"
 #include "BLI_memarena.h"
@@ -108,7 +109,13 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
 
   mesh_dst->mat = MEM_dupallocN(mesh_src->mat);
 
-  const eCDAllocType alloc_type = (flag & LIB_ID_COPY_CD_REFERENCE) ? CD_REFERENCE : CD_DUPLICATE;
+  eCDAllocType alloc_type = CD_DUPLICATE;
+  if (flag & LIB_ID_COPY_CD_REFERENCE) {
+    alloc_type = CD_REFERENCE;
+  }
+  else if (flag & LIB_ID_COPY_CD_SHARE) {
+    alloc_type = CD_SHARE;
+  }
   CustomData_copy(&mesh_src->vdata, &mesh_dst->vdata, mask.vmask, alloc_type, mesh_dst->totvert);
   CustomData_copy(&mesh_src->edata, &mesh_dst->edata, mask.emask, alloc_type, mesh_dst->totedge);
   CustomData_copy(&mesh_src->ldata, &mesh_dst->ldata, mask.lmask, alloc_type, mesh_dst->totloop);
@@ -122,6 +129,11 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
 
   BKE_mesh_update_customdata_pointers(mesh_dst, do_tessface);
 
+  if (alloc_type == CD_REFERENCE) {
+    /* Evaluated copies reuse the adjacency data of the mesh they reference. */
+    BKE_mesh_runtime_topology_cache_share(mesh_dst, mesh_src);
+  }
+
   mesh_dst->edit_mesh = NULL;
 
   mesh_dst->mselect = MEM_dupallocN(mesh_dst->mselect);
@@ -583,6 +595,45 @@ bool BKE_mesh_has_custom_loop_normals(Mesh *me)
   }
 }
 
+static uint mesh_customdata_hash(const CustomData *data, const int totelem, uint hash)
+{
+  for (int i = 0; i < data->totlayer; i++) {
+    const CustomDataLayer *layer = &data->layers[i];
+
+    hash = BLI_hash_mm3((const uchar *)&layer->type, sizeof(layer->type), hash);
+    hash = BLI_hash_mm3((const uchar *)layer->name, strlen(layer->name), hash);
+    if (layer->data) {
+      hash = BLI_hash_mm3(
+          (const uchar *)layer->data, (size_t)CustomData_sizeof(layer->type) * totelem, hash);
+    }
+  }
+  return hash;
+}
+
+/**
+ * Hash of the geometry and custom data layers of the mesh, for render engines to detect meshes
+ * that were tagged for update without actually changing. Reads all the mesh data, so this is
+ * only cheap compared to converting the mesh.
+ */
+uint BKE_mesh_content_hash(const Mesh *me)
+{
+  const int totelem[4] = {me->totvert, me->totedge, me->totpoly, me->totloop};
+  uint hash = BLI_hash_mm3((const uchar *)totelem, sizeof(totelem), 0);
+
+  hash = BLI_hash_mm3((const uchar *)me->loc, sizeof(me->loc), hash);
+  hash = BLI_hash_mm3((const uchar *)me->size, sizeof(me->size), hash);
+  hash = BLI_hash_mm3((const uchar *)&me->texflag, sizeof(me->texflag), hash);
+  hash = BLI_hash_mm3((const uchar *)&me->flag, sizeof(me->flag), hash);
+  hash = BLI_hash_mm3((const uchar *)&me->smoothresh, sizeof(me->smoothresh), hash);
+
+  hash = mesh_customdata_hash(&me->vdata, me->totvert, hash);
+  hash = mesh_customdata_hash(&me->edata, me->totedge, hash);
+  hash = mesh_customdata_hash(&me->pdata, me->totpoly, hash);
+  hash = mesh_customdata_hash(&me->ldata, me->totloop, hash);
+
+  return hash;
+}
+
 /** Free (or release) any data used by this mesh (does not free the mesh itself). */
 void BKE_mesh_free(Mesh *me)
 {
@@ -1583,6 +1634,28 @@ void BKE_mesh_vert_coords_get(const Mesh *mesh, float (*vert_coords)[3])
   }
 }
 
+/**
+ * Copy coordinates and normals into arrays with \a stride floats per vertex, for callers that
+ * store padded vectors. Either output may be NULL.
+ */
+void BKE_mesh_vert_coords_normals_get_strided(const Mesh *mesh,
+                                              float *r_coords,
+                                              float *r_normals,
+                                              int stride)
+{
+  const MVert *mvert = mesh->mvert;
+  if (r_coords) {
+    for (int i = 0; i < mesh->totvert; i++) {
+      copy_v3_v3(&r_coords[i * stride], mvert[i].co);
+    }
+  }
+  if (r_normals) {
+    for (int i = 0; i < mesh->totvert; i++) {
+      normal_short_to_float_v3(&r_normals[i * stride], mvert[i].no);
+    }
+  }
+}
+
 float (*BKE_mesh_vert_coords_alloc(const Mesh *mesh, int *r_vert_len))[3]
 {
   float(*vert_coords)[3] = MEM_mallocN(sizeof(float[3]) * mesh->totvert, __func__);
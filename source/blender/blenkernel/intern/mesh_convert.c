@@ -545,23 +545,27 @@ Mesh *BKE_mesh_new_nomain_from_curve_displist(Object *ob, ListBase *dispbase)
     return BKE_mesh_new_nomain(0, 0, 0, 0, 0);
   }
 
-  mesh = BKE_mesh_new_nomain(totvert, totedge, 0, totloop, totpoly);
+  /* Create the mesh with empty primary layers and hand the arrays over to them,
+   * instead of allocating the layers and copying everything a second time. */
+  mesh = BKE_mesh_new_nomain(0, 0, 0, 0, 0);
   mesh->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
 
-  memcpy(mesh->mvert, allvert, totvert * sizeof(MVert));
-  memcpy(mesh->medge, alledge, totedge * sizeof(MEdge));
-  memcpy(mesh->mloop, allloop, totloop * sizeof(MLoop));
-  memcpy(mesh->mpoly, allpoly, totpoly * sizeof(MPoly));
+  mesh->totvert = totvert;
+  mesh->totedge = totedge;
+  mesh->totloop = totloop;
+  mesh->totpoly = totpoly;
+
+  CustomData_set_layer(&mesh->vdata, CD_MVERT, allvert);
+  CustomData_set_layer(&mesh->edata, CD_MEDGE, alledge);
+  CustomData_set_layer(&mesh->ldata, CD_MLOOP, allloop);
+  CustomData_set_layer(&mesh->pdata, CD_MPOLY, allpoly);
 
   if (alluv) {
     const char *uvname = "UVMap";
     CustomData_add_layer_named(&mesh->ldata, CD_MLOOPUV, CD_ASSIGN, alluv, totloop, uvname);
   }
 
-  MEM_freeN(allvert);
-  MEM_freeN(alledge);
-  MEM_freeN(allloop);
-  MEM_freeN(allpoly);
+  BKE_mesh_update_customdata_pointers(mesh, false);
 
   return mesh;
 }
@@ -42,8 +42,10 @@
 #include "BLI_linklist.h"
 #include "BLI_linklist_stack.h"
 #include "BLI_alloca.h"
+#include "BLI_array_parallel.h"
 #include "BLI_stack.h"
 #include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "BKE_customdata.h"
 #include "BKE_global.h"
@@ -758,12 +760,27 @@ void BKE_lnor_space_custom_normal_to_data(MLoopNorSpace *lnor_space,
   }
 }
 
+/** Minimum amount of loops to make threading worth it. */
 #define LOOP_SPLIT_TASK_BLOCK_SIZE 1024
 
+/** The kind of smooth fan a loop is the entry point of, see #loop_split_entry_type_get. */
+enum {
+  LOOP_SPLIT_ENTRY_NONE = 0,
+  LOOP_SPLIT_ENTRY_SINGLE = 1,
+  LOOP_SPLIT_ENTRY_FAN = 2,
+};
+
+/** Values of #LoopSplitTaskDataCommon.loop_cyclic_fans, see #loop_split_cyclic_fan_walk. */
+enum {
+  LOOP_SPLIT_CYCLIC_UNVISITED = 0,
+  LOOP_SPLIT_CYCLIC_VISITED = 1,
+  LOOP_SPLIT_CYCLIC_ENTRY = 2,
+};
+
 typedef struct LoopSplitTaskData {
   /* Specific to each instance (each task). */
 
-  /** We have to create those outside of tasks, since afaik memarena is not threadsafe. */
+  /** Allocated outside of tasks (in a single block), since memarena is not threadsafe. */
   MLoopNorSpace *lnor_space;
   float (*lnor)[3];
   const MLoop *ml_curr;
@@ -798,6 +815,20 @@ typedef struct LoopSplitTaskDataCommon {
   int *loop_to_poly;
   const float (*polynors)[3];
 
+  /** Number of loops using each vertex. */
+  int *vert_loops_num;
+  /** Vertex to loops map, only while looking for cyclic smooth fans. */
+  int *vert_loops_offsets;
+  int *vert_loops;
+  /** #LOOP_SPLIT_CYCLIC_ENTRY for the entry loop of each cyclic smooth fan. */
+  char *loop_cyclic_fans;
+  /** Optional, #LOOP_SPLIT_ENTRY_NONE etc. for each loop, when computed in a previous pass. */
+  char *loop_entry_types;
+  /** Optional, index of the first lnor space of each poly in #lnor_spaces. */
+  int *poly_space_offsets;
+  MLoopNorSpace *lnor_spaces;
+
+  int numVerts;
   int numEdges;
   int numLoops;
   int numPolys;
@@ -808,12 +839,55 @@ typedef struct LoopSplitTaskDataCommon {
 /* See comment about edge_to_loops below. */
 #define IS_EDGE_SHARP(_e2l) (ELEM((_e2l)[1], INDEX_UNSET, INDEX_INVALID))
 
+static void mesh_loops_prepare_cb(void *__restrict userdata,
+                                  const int mp_index,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoopSplitTaskDataCommon *data = userdata;
+  const MVert *mverts = data->mverts;
+  const MPoly *mp = &data->mpolys[mp_index];
+  const MLoop *ml = &data->mloops[mp->loopstart];
+
+  float(*loopnors)[3] = data->loopnors; /* Note: loopnors may be NULL here. */
+  int *loop_to_poly = data->loop_to_poly;
+  int *vert_loops_num = data->vert_loops_num;
+
+  for (int i = 0; i < mp->totloop; i++, ml++) {
+    const int ml_index = mp->loopstart + i;
+
+    loop_to_poly[ml_index] = mp_index;
+
+    /* Pre-populate all loop normals as if their verts were all-smooth,
+     * this way we don't have to compute those later!
+     */
+    if (loopnors) {
+      normal_short_to_float_v3(loopnors[ml_index], mverts[ml->v].no);
+    }
+    if (vert_loops_num) {
+      atomic_add_and_fetch_int32(&vert_loops_num[ml->v], 1);
+    }
+  }
+}
+
+/**
+ * Fill the per-loop data that does not depend on other polys (loop to poly mapping,
+ * default smooth loop normals and vertex valence), in parallel.
+ */
+static void mesh_loops_prepare(LoopSplitTaskDataCommon *data)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  settings.use_threading = (data->numLoops >= LOOP_SPLIT_TASK_BLOCK_SIZE * 8);
+
+  BLI_task_parallel_range(0, data->numPolys, data, mesh_loops_prepare_cb, &settings);
+}
+
 static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
                                  const bool check_angle,
                                  const float split_angle,
                                  const bool do_sharp_edges_tag)
 {
-  const MVert *mverts = data->mverts;
   const MEdge *medges = data->medges;
   const MLoop *mloops = data->mloops;
 
@@ -822,7 +896,6 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
   const int numEdges = data->numEdges;
   const int numPolys = data->numPolys;
 
-  float(*loopnors)[3] = data->loopnors; /* Note: loopnors may be NULL here. */
   const float(*polynors)[3] = data->polynors;
 
   int(*edge_to_loops)[2] = data->edge_to_loops;
@@ -846,15 +919,6 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
     for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++) {
       e2l = edge_to_loops[ml_curr->e];
 
-      loop_to_poly[ml_curr_index] = mp_index;
-
-      /* Pre-populate all loop normals as if their verts were all-smooth,
-       * this way we don't have to compute those later!
-       */
-      if (loopnors) {
-        normal_short_to_float_v3(loopnors[ml_curr_index], mverts[ml_curr->v].no);
-      }
-
       /* Check whether current edge might be smooth or sharp */
       if ((e2l[0] | e2l[1]) == 0) {
         /* 'Empty' edge until now, set e2l[0] (and e2l[1] to INDEX_UNSET to tag it as unset). */
@@ -952,9 +1016,11 @@ void BKE_edges_sharp_from_angle_set(const struct MVert *mverts,
       .loop_to_poly = loop_to_poly,
       .polynors = polynors,
       .numEdges = numEdges,
+      .numLoops = numLoops,
       .numPolys = numPolys,
   };
 
+  mesh_loops_prepare(&common_data);
   mesh_edges_sharp_tag(&common_data, true, split_angle, true);
 
   MEM_freeN(edge_to_loops);
@@ -1300,80 +1366,54 @@ static void loop_split_worker_do(LoopSplitTaskDataCommon *common_data,
   }
 }
 
-static void loop_split_worker(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
+/**
+ * Walk the smooth fan around the vertex of given loop (starting with its previous edge), marking
+ * the loops of the fan as visited. Cyclic smooth fans have no obvious 'entry point', and yet we
+ * need to walk them once, and only once. The loop of the fan that comes first in poly order is
+ * marked as entry, which does not depend on where the walk started.
+ *
+ * A walk stops on loops visited before, so that each loop is only walked over once.
+ */
+static void loop_split_cyclic_fan_walk(LoopSplitTaskDataCommon *common_data,
+                                       const int ml_curr_index,
+                                       const int max_steps)
 {
-  LoopSplitTaskDataCommon *common_data = BLI_task_pool_userdata(pool);
-  LoopSplitTaskData *data = taskdata;
-
-  /* Temp edge vectors stack, only used when computing lnor spacearr. */
-  BLI_Stack *edge_vectors = common_data->lnors_spacearr ?
-                                BLI_stack_new(sizeof(float[3]), __func__) :
-                                NULL;
-
-#ifdef DEBUG_TIME
-  TIMEIT_START_AVERAGED(loop_split_worker);
-#endif
+  const MLoop *mloops = common_data->mloops;
+  const MPoly *mpolys = common_data->mpolys;
+  const int(*edge_to_loops)[2] = common_data->edge_to_loops;
+  const int *loop_to_poly = common_data->loop_to_poly;
+  char *loop_cyclic_fans = common_data->loop_cyclic_fans;
 
-  for (int i = 0; i < LOOP_SPLIT_TASK_BLOCK_SIZE; i++, data++) {
-    /* A NULL ml_curr is used to tag ended data! */
-    if (data->ml_curr == NULL) {
-      break;
-    }
+  const int mp_curr_index = loop_to_poly[ml_curr_index];
+  const MPoly *mp_curr = &mpolys[mp_curr_index];
+  const int ml_prev_index = (ml_curr_index == mp_curr->loopstart) ?
+                                mp_curr->loopstart + mp_curr->totloop - 1 :
+                                ml_curr_index - 1;
+  const MLoop *ml_curr = &mloops[ml_curr_index];
+  const MLoop *ml_prev = &mloops[ml_prev_index];
 
-    loop_split_worker_do(common_data, data, edge_vectors);
-  }
+  loop_cyclic_fans[ml_curr_index] = LOOP_SPLIT_CYCLIC_VISITED;
 
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
+  const int *e2lfan_curr = edge_to_loops[ml_prev->e];
+  if (IS_EDGE_SHARP(edge_to_loops[ml_curr->e]) || IS_EDGE_SHARP(e2lfan_curr)) {
+    /* Sharp loop, so not a cyclic smooth fan... */
+    return;
   }
 
-#ifdef DEBUG_TIME
-  TIMEIT_END_AVERAGED(loop_split_worker);
-#endif
-}
-
-/**
- * Check whether given loop is part of an unknown-so-far cyclic smooth fan, or not.
- * Needed because cyclic smooth fans have no obvious 'entry point',
- * and yet we need to walk them once, and only once.
- */
-static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
-                                                         const MPoly *mpolys,
-                                                         const int (*edge_to_loops)[2],
-                                                         const int *loop_to_poly,
-                                                         const int *e2l_prev,
-                                                         BLI_bitmap *skip_loops,
-                                                         const MLoop *ml_curr,
-                                                         const MLoop *ml_prev,
-                                                         const int ml_curr_index,
-                                                         const int ml_prev_index,
-                                                         const int mp_curr_index)
-{
   const unsigned int mv_pivot_index = ml_curr->v; /* The vertex we are "fanning" around! */
-  const int *e2lfan_curr;
-  const MLoop *mlfan_curr;
+  const MLoop *mlfan_curr = ml_prev;
   /* mlfan_vert_index: the loop of our current edge might not be the loop of our current vertex! */
-  int mlfan_curr_index, mlfan_vert_index, mpfan_curr_index;
-
-  e2lfan_curr = e2l_prev;
-  if (IS_EDGE_SHARP(e2lfan_curr)) {
-    /* Sharp loop, so not a cyclic smooth fan... */
-    return false;
-  }
-
-  mlfan_curr = ml_prev;
-  mlfan_curr_index = ml_prev_index;
-  mlfan_vert_index = ml_curr_index;
-  mpfan_curr_index = mp_curr_index;
+  int mlfan_curr_index = ml_prev_index;
+  int mlfan_vert_index = ml_curr_index;
+  int mpfan_curr_index = mp_curr_index;
 
-  BLI_assert(mlfan_curr_index >= 0);
-  BLI_assert(mlfan_vert_index >= 0);
-  BLI_assert(mpfan_curr_index >= 0);
+  /* The loop of the fan coming first in poly order. */
+  int ml_first_index = ml_curr_index;
+  int mp_first_index = mp_curr_index;
 
-  BLI_assert(!BLI_BITMAP_TEST(skip_loops, mlfan_vert_index));
-  BLI_BITMAP_ENABLE(skip_loops, mlfan_vert_index);
-
-  while (true) {
+  /* A fan cannot have more loops than the vertex, this only protects against endless walks
+   * around degenerate geometry that never comes back to the initial loop. */
+  for (int step = 0; step < max_steps; step++) {
     /* Find next loop of the smooth fan. */
     BKE_mesh_loop_manifold_fan_around_vert_next(mloops,
                                                 mpolys,
@@ -1385,200 +1425,272 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
                                                 &mlfan_vert_index,
                                                 &mpfan_curr_index);
 
-    e2lfan_curr = edge_to_loops[mlfan_curr->e];
+    if (mlfan_vert_index == ml_curr_index) {
+      /* We walked around a whole cyclic smooth fan. */
+      loop_cyclic_fans[ml_first_index] = LOOP_SPLIT_CYCLIC_ENTRY;
+      return;
+    }
+    if (loop_cyclic_fans[mlfan_vert_index] != LOOP_SPLIT_CYCLIC_UNVISITED) {
+      /* Rest of a fan walked before, cyclic fans are always walked entirely so it is not one. */
+      return;
+    }
+    loop_cyclic_fans[mlfan_vert_index] = LOOP_SPLIT_CYCLIC_VISITED;
+
+    if ((mpfan_curr_index < mp_first_index) ||
+        (mpfan_curr_index == mp_first_index && mlfan_vert_index < ml_first_index)) {
+      ml_first_index = mlfan_vert_index;
+      mp_first_index = mpfan_curr_index;
+    }
 
+    e2lfan_curr = edge_to_loops[mlfan_curr->e];
     if (IS_EDGE_SHARP(e2lfan_curr)) {
       /* Sharp loop/edge, so not a cyclic smooth fan... */
-      return false;
-    }
-    /* Smooth loop/edge... */
-    else if (BLI_BITMAP_TEST(skip_loops, mlfan_vert_index)) {
-      if (mlfan_vert_index == ml_curr_index) {
-        /* We walked around a whole cyclic smooth fan without finding any already-processed loop,
-         * means we can use initial ml_curr/ml_prev edge as start for this smooth fan. */
-        return true;
-      }
-      /* ... already checked in some previous looping, we can abort. */
-      return false;
-    }
-    else {
-      /* ... we can skip it in future, and keep checking the smooth fan. */
-      BLI_BITMAP_ENABLE(skip_loops, mlfan_vert_index);
+      return;
     }
   }
 }
 
-static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common_data)
+static void loop_split_cyclic_fans_cb(void *__restrict userdata,
+                                      const int mv_index,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
-  float(*loopnors)[3] = common_data->loopnors;
+  LoopSplitTaskDataCommon *common_data = userdata;
+  const int *vert_loops_offsets = common_data->vert_loops_offsets;
+  const int *vert_loops = &common_data->vert_loops[vert_loops_offsets[mv_index]];
+  const int vert_loops_num = vert_loops_offsets[mv_index + 1] - vert_loops_offsets[mv_index];
+
+  /* All loops of a fan use this vertex, so no other task touches them. */
+  for (int i = 0; i < vert_loops_num; i++) {
+    if (common_data->loop_cyclic_fans[vert_loops[i]] == LOOP_SPLIT_CYCLIC_UNVISITED) {
+      loop_split_cyclic_fan_walk(common_data, vert_loops[i], vert_loops_num);
+    }
+  }
+}
 
+/**
+ * Find the entry loops of all cyclic smooth fans, walking each fan only once.
+ * Fans are walked per vertex, using a vertex to loops map.
+ */
+static void loop_split_cyclic_fans_find(LoopSplitTaskDataCommon *common_data,
+                                        TaskParallelSettings *settings)
+{
   const MLoop *mloops = common_data->mloops;
-  const MPoly *mpolys = common_data->mpolys;
-  const int *loop_to_poly = common_data->loop_to_poly;
-  const int(*edge_to_loops)[2] = common_data->edge_to_loops;
+  const int numVerts = common_data->numVerts;
   const int numLoops = common_data->numLoops;
-  const int numPolys = common_data->numPolys;
 
-  const MPoly *mp;
-  int mp_index;
+  int *vert_loops_offsets = MEM_malloc_arrayN(
+      (size_t)numVerts + 1, sizeof(*vert_loops_offsets), __func__);
+  int *vert_loops = MEM_malloc_arrayN((size_t)numLoops, sizeof(*vert_loops), __func__);
 
-  const MLoop *ml_curr;
-  const MLoop *ml_prev;
-  int ml_curr_index;
-  int ml_prev_index;
+  /* Offsets of the end of each vertex range, decremented while filling to their start. */
+  int offset = 0;
+  for (int mv_index = 0; mv_index < numVerts; mv_index++) {
+    offset += common_data->vert_loops_num[mv_index];
+    vert_loops_offsets[mv_index] = offset;
+  }
+  vert_loops_offsets[numVerts] = offset;
+  for (int ml_index = 0; ml_index < numLoops; ml_index++) {
+    vert_loops[--vert_loops_offsets[mloops[ml_index].v]] = ml_index;
+  }
 
-  BLI_bitmap *skip_loops = BLI_BITMAP_NEW(numLoops, __func__);
+  common_data->vert_loops_offsets = vert_loops_offsets;
+  common_data->vert_loops = vert_loops;
+  common_data->loop_cyclic_fans = MEM_calloc_arrayN(
+      (size_t)numLoops, sizeof(*common_data->loop_cyclic_fans), __func__);
 
-  LoopSplitTaskData *data_buff = NULL;
-  int data_idx = 0;
+  BLI_task_parallel_range(0, numVerts, common_data, loop_split_cyclic_fans_cb, settings);
 
-  /* Temp edge vectors stack, only used when computing lnor spacearr
-   * (and we are not multi-threading). */
-  BLI_Stack *edge_vectors = NULL;
+  MEM_freeN(vert_loops_offsets);
+  MEM_freeN(vert_loops);
+  common_data->vert_loops_offsets = NULL;
+  common_data->vert_loops = NULL;
+}
 
-#ifdef DEBUG_TIME
-  TIMEIT_START_AVERAGED(loop_split_generator);
-#endif
+static char loop_split_entry_type_get(const LoopSplitTaskDataCommon *common_data,
+                                      const MLoop *ml_curr,
+                                      const MLoop *ml_prev,
+                                      const int ml_curr_index,
+                                      const int ml_prev_index,
+                                      const int mp_index)
+{
+  const int *e2l_curr = common_data->edge_to_loops[ml_curr->e];
+  const int *e2l_prev = common_data->edge_to_loops[ml_prev->e];
+
+  /* A smooth edge, we have to check for cyclic smooth fan case.
+   * If we find a new, never-processed cyclic smooth fan, we can do it now using that loop/edge
+   * as 'entry point', otherwise we can skip it. */
+  if (!IS_EDGE_SHARP(e2l_curr)) {
+    return (common_data->loop_cyclic_fans[ml_curr_index] == LOOP_SPLIT_CYCLIC_ENTRY) ?
+               LOOP_SPLIT_ENTRY_FAN :
+               LOOP_SPLIT_ENTRY_NONE;
+  }
+
+  /* We *do not need* to check/tag loops as already computed!
+   * Due to the fact a loop only links to one of its two edges,
+   * a same fan *will never be walked more than once!*
+   * Since we consider edges having neighbor polys with inverted
+   * (flipped) normals as sharp, we are sure that no fan will be skipped,
+   * even only considering the case (sharp curr_edge, smooth prev_edge),
+   * and not the alternative (smooth curr_edge, sharp prev_edge).
+   * All this due/thanks to link between normals and loop ordering (i.e. winding).
+   */
+  return IS_EDGE_SHARP(e2l_prev) ? LOOP_SPLIT_ENTRY_SINGLE : LOOP_SPLIT_ENTRY_FAN;
+}
 
-  if (!pool) {
-    if (lnors_spacearr) {
-      edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
-    }
-  }
+static void loop_split_entries_cb(void *__restrict userdata,
+                                  const int mp_index,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoopSplitTaskDataCommon *common_data = userdata;
+  const MPoly *mp = &common_data->mpolys[mp_index];
+  const MLoop *mloops = common_data->mloops;
+  char *loop_entry_types = common_data->loop_entry_types;
 
-  /* We now know edges that can be smoothed (with their vector, and their two loops),
-   * and edges that will be hard! Now, time to generate the normals.
-   */
-  for (mp = mpolys, mp_index = 0; mp_index < numPolys; mp++, mp_index++) {
-    float(*lnors)[3];
-    const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
-    ml_curr_index = mp->loopstart;
-    ml_prev_index = ml_last_index;
+  const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
+  int ml_prev_index = ml_last_index;
+  int entries_num = 0;
 
-    ml_curr = &mloops[ml_curr_index];
-    ml_prev = &mloops[ml_prev_index];
-    lnors = &loopnors[ml_curr_index];
+  for (int ml_curr_index = mp->loopstart; ml_curr_index <= ml_last_index; ml_curr_index++) {
+    const char type = loop_split_entry_type_get(common_data,
+                                                &mloops[ml_curr_index],
+                                                &mloops[ml_prev_index],
+                                                ml_curr_index,
+                                                ml_prev_index,
+                                                mp_index);
+    loop_entry_types[ml_curr_index] = type;
+    entries_num += (type != LOOP_SPLIT_ENTRY_NONE);
+    ml_prev_index = ml_curr_index;
+  }
 
-    for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++, lnors++) {
-      const int *e2l_curr = edge_to_loops[ml_curr->e];
-      const int *e2l_prev = edge_to_loops[ml_prev->e];
+  common_data->poly_space_offsets[mp_index] = entries_num;
+}
 
-#if 0
-      printf("Checking loop %d / edge %u / vert %u (sharp edge: %d, skiploop: %d)...",
-             ml_curr_index,
-             ml_curr->e,
-             ml_curr->v,
-             IS_EDGE_SHARP(e2l_curr),
-             BLI_BITMAP_TEST_BOOL(skip_loops, ml_curr_index));
-#endif
+typedef struct LoopSplitTLS {
+  /** Temp edge vectors stack, only used when computing lnor spacearr. */
+  BLI_Stack *edge_vectors;
+} LoopSplitTLS;
 
-      /* A smooth edge, we have to check for cyclic smooth fan case.
-       * If we find a new, never-processed cyclic smooth fan, we can do it now using that loop/edge
-       * as 'entry point', otherwise we can skip it. */
-
-      /* Note: In theory, we could make loop_split_generator_check_cyclic_smooth_fan() store
-       * mlfan_vert_index'es and edge indexes in two stacks, to avoid having to fan again around
-       * the vert during actual computation of clnor & clnorspace. However, this would complicate
-       * the code, add more memory usage, and despite its logical complexity,
-       * loop_manifold_fan_around_vert_next() is quite cheap in term of CPU cycles,
-       * so really think it's not worth it. */
-      if (!IS_EDGE_SHARP(e2l_curr) && (BLI_BITMAP_TEST(skip_loops, ml_curr_index) ||
-                                       !loop_split_generator_check_cyclic_smooth_fan(mloops,
-                                                                                     mpolys,
-                                                                                     edge_to_loops,
-                                                                                     loop_to_poly,
-                                                                                     e2l_prev,
-                                                                                     skip_loops,
-                                                                                     ml_curr,
-                                                                                     ml_prev,
-                                                                                     ml_curr_index,
-                                                                                     ml_prev_index,
-                                                                                     mp_index))) {
-        //              printf("SKIPPING!\n");
+static void loop_split_compute_cb(void *__restrict userdata,
+                                  const int mp_index,
+                                  const TaskParallelTLS *__restrict tls)
+{
+  LoopSplitTaskDataCommon *common_data = userdata;
+  LoopSplitTLS *tls_data = tls->userdata_chunk;
+  const MPoly *mp = &common_data->mpolys[mp_index];
+  const MLoop *mloops = common_data->mloops;
+  const char *loop_entry_types = common_data->loop_entry_types;
+  MLoopNorSpace *lnor_space = NULL;
+  if (common_data->lnor_spaces) {
+    lnor_space = &common_data->lnor_spaces[common_data->poly_space_offsets[mp_index]];
+  }
+
+  const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
+  int ml_prev_index = ml_last_index;
+
+  for (int ml_curr_index = mp->loopstart; ml_curr_index <= ml_last_index; ml_curr_index++) {
+    const MLoop *ml_curr = &mloops[ml_curr_index];
+    const MLoop *ml_prev = &mloops[ml_prev_index];
+    const char type = loop_entry_types ?
+                          loop_entry_types[ml_curr_index] :
+                          loop_split_entry_type_get(common_data,
+                                                    ml_curr,
+                                                    ml_prev,
+                                                    ml_curr_index,
+                                                    ml_prev_index,
+                                                    mp_index);
+
+    if (type != LOOP_SPLIT_ENTRY_NONE) {
+      LoopSplitTaskData data = {
+          .ml_curr = ml_curr,
+          .ml_prev = ml_prev,
+          .ml_curr_index = ml_curr_index,
+          .mp_index = mp_index,
+      };
+      if (type == LOOP_SPLIT_ENTRY_SINGLE) {
+        data.lnor = &common_data->loopnors[ml_curr_index];
       }
       else {
-        LoopSplitTaskData *data, data_local;
+        data.ml_prev_index = ml_prev_index;
+        data.e2l_prev = common_data->edge_to_loops[ml_prev->e]; /* Also tag as 'fan' task. */
+      }
+      if (lnor_space) {
+        data.lnor_space = lnor_space++;
+        if (tls_data->edge_vectors == NULL) {
+          tls_data->edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
+        }
+      }
+      loop_split_worker_do(common_data, &data, tls_data->edge_vectors);
+    }
 
-        //              printf("PROCESSING!\n");
+    ml_prev_index = ml_curr_index;
+  }
+}
 
-        if (pool) {
-          if (data_idx == 0) {
-            data_buff = MEM_calloc_arrayN(
-                LOOP_SPLIT_TASK_BLOCK_SIZE, sizeof(*data_buff), __func__);
-          }
-          data = &data_buff[data_idx];
-        }
-        else {
-          data = &data_local;
-          memset(data, 0, sizeof(*data));
-        }
+static void loop_split_compute_finalize(void *__restrict UNUSED(userdata),
+                                        void *__restrict chunk)
+{
+  LoopSplitTLS *tls_data = chunk;
+  if (tls_data->edge_vectors) {
+    BLI_stack_free(tls_data->edge_vectors);
+  }
+}
 
-        if (IS_EDGE_SHARP(e2l_curr) && IS_EDGE_SHARP(e2l_prev)) {
-          data->lnor = lnors;
-          data->ml_curr = ml_curr;
-          data->ml_prev = ml_prev;
-          data->ml_curr_index = ml_curr_index;
-#if 0 /* Not needed for 'single' loop. */
-          data->ml_prev_index = ml_prev_index;
-          data->e2l_prev = NULL; /* Tag as 'single' task. */
-#endif
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
-        }
-        /* We *do not need* to check/tag loops as already computed!
-         * Due to the fact a loop only links to one of its two edges,
-         * a same fan *will never be walked more than once!*
-         * Since we consider edges having neighbor polys with inverted
-         * (flipped) normals as sharp, we are sure that no fan will be skipped,
-         * even only considering the case (sharp curr_edge, smooth prev_edge),
-         * and not the alternative (smooth curr_edge, sharp prev_edge).
-         * All this due/thanks to link between normals and loop ordering (i.e. winding).
-         */
-        else {
-#if 0 /* Not needed for 'fan' loops. */
-          data->lnor = lnors;
+/**
+ * Compute all loop normals (and their lnor spaces) in data-parallel passes over the polys.
+ * Every smooth fan is always evaluated from the same entry loop and in the same order,
+ * so the result does not depend on the number of threads.
+ */
+static void loop_split_generator(LoopSplitTaskDataCommon *common_data)
+{
+  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
+  const int numLoops = common_data->numLoops;
+  const int numPolys = common_data->numPolys;
+
+#ifdef DEBUG_TIME
+  TIMEIT_START_AVERAGED(loop_split_generator);
 #endif
-          data->ml_curr = ml_curr;
-          data->ml_prev = ml_prev;
-          data->ml_curr_index = ml_curr_index;
-          data->ml_prev_index = ml_prev_index;
-          data->e2l_prev = e2l_prev; /* Also tag as 'fan' task. */
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
-        }
 
-        if (pool) {
-          data_idx++;
-          if (data_idx == LOOP_SPLIT_TASK_BLOCK_SIZE) {
-            BLI_task_pool_push(pool, loop_split_worker, data_buff, true, TASK_PRIORITY_LOW);
-            data_idx = 0;
-          }
-        }
-        else {
-          loop_split_worker_do(common_data, data, edge_vectors);
-        }
-      }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  /* Not enough loops to be worth the whole threading overhead... */
+  settings.use_threading = (numLoops >= LOOP_SPLIT_TASK_BLOCK_SIZE * 8);
 
-      ml_prev = ml_curr;
-      ml_prev_index = ml_curr_index;
+  loop_split_cyclic_fans_find(common_data, &settings);
+
+  if (lnors_spacearr) {
+    /* Lnor spaces have to be allocated outside of the tasks, find all entry loops first. */
+    common_data->loop_entry_types = MEM_malloc_arrayN(
+        (size_t)numLoops, sizeof(*common_data->loop_entry_types), __func__);
+    common_data->poly_space_offsets = MEM_malloc_arrayN(
+        (size_t)numPolys, sizeof(*common_data->poly_space_offsets), __func__);
+
+    BLI_task_parallel_range(0, numPolys, common_data, loop_split_entries_cb, &settings);
+
+    int spaces_num = 0;
+    for (int mp_index = 0; mp_index < numPolys; mp_index++) {
+      const int poly_spaces_num = common_data->poly_space_offsets[mp_index];
+      common_data->poly_space_offsets[mp_index] = spaces_num;
+      spaces_num += poly_spaces_num;
+    }
+    if (spaces_num != 0) {
+      common_data->lnor_spaces = BLI_memarena_calloc(
+          lnors_spacearr->mem, sizeof(*common_data->lnor_spaces) * (size_t)spaces_num);
+      lnors_spacearr->num_spaces += spaces_num;
     }
   }
 
-  /* Last block of data... Since it is calloc'ed and we use first NULL item as stopper,
-   * everything is fine. */
-  if (pool && data_idx) {
-    BLI_task_pool_push(pool, loop_split_worker, data_buff, true, TASK_PRIORITY_LOW);
-  }
+  LoopSplitTLS tls_data = {NULL};
+  settings.userdata_chunk = &tls_data;
+  settings.userdata_chunk_size = sizeof(tls_data);
+  settings.func_finalize = loop_split_compute_finalize;
 
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
-  }
-  MEM_freeN(skip_loops);
+  BLI_task_parallel_range(0, numPolys, common_data, loop_split_compute_cb, &settings);
+
+  MEM_SAFE_FREE(common_data->loop_cyclic_fans);
+  MEM_SAFE_FREE(common_data->loop_entry_types);
+  MEM_SAFE_FREE(common_data->poly_space_offsets);
+  common_data->lnor_spaces = NULL;
 
 #ifdef DEBUG_TIME
   TIMEIT_END_AVERAGED(loop_split_generator);
@@ -1591,7 +1703,7 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
  * (splitting edges).
  */
 void BKE_mesh_normals_loop_split(const MVert *mverts,
-                                 const int UNUSED(numVerts),
+                                 const int numVerts,
                                  MEdge *medges,
                                  const int numEdges,
                                  MLoop *mloops,
@@ -1662,6 +1774,9 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
                           r_loop_to_poly :
                           MEM_malloc_arrayN((size_t)numLoops, sizeof(*loop_to_poly), __func__);
 
+  /* Number of loops using each vertex. */
+  int *vert_loops_num = MEM_calloc_arrayN((size_t)numVerts, sizeof(*vert_loops_num), __func__);
+
   /* When using custom loop normals, disable the angle feature! */
   const bool check_angle = (split_angle < (float)M_PI) && (clnors_data == NULL);
 
@@ -1691,33 +1806,23 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
       .edge_to_loops = edge_to_loops,
       .loop_to_poly = loop_to_poly,
       .polynors = polynors,
+      .vert_loops_num = vert_loops_num,
+      .numVerts = numVerts,
       .numEdges = numEdges,
       .numLoops = numLoops,
       .numPolys = numPolys,
   };
 
+  /* Per-loop data not depending on neighbor polys. */
+  mesh_loops_prepare(&common_data);
+
   /* This first loop check which edges are actually smooth, and compute edge vectors. */
   mesh_edges_sharp_tag(&common_data, check_angle, split_angle, false);
 
-  if (numLoops < LOOP_SPLIT_TASK_BLOCK_SIZE * 8) {
-    /* Not enough loops to be worth the whole threading overhead... */
-    loop_split_generator(NULL, &common_data);
-  }
-  else {
-    TaskScheduler *task_scheduler;
-    TaskPool *task_pool;
-
-    task_scheduler = BLI_task_scheduler_get();
-    task_pool = BLI_task_pool_create(task_scheduler, &common_data);
-
-    loop_split_generator(task_pool, &common_data);
-
-    BLI_task_pool_work_and_wait(task_pool);
-
-    BLI_task_pool_free(task_pool);
-  }
+  loop_split_generator(&common_data);
 
   MEM_freeN(edge_to_loops);
+  MEM_freeN(vert_loops_num);
   if (!r_loop_to_poly) {
     MEM_freeN(loop_to_poly);
   }
@@ -3222,146 +3327,205 @@ int BKE_mesh_tessface_calc_ex(CustomData *fdata,
 #undef ML_TO_MF_QUAD
 }
 
+/* Polygons are triangulated on multiple threads above this number. */
+#define MESH_LOOPTRI_PARALLEL_MIN_LEN 4096
+
 /**
- * Calculate tessellation into #MLoopTri which exist only for this purpose.
+ * Triangulate a single polygon into \a mlt.
+ *
+ * \param pa_arena: Arena for n-gons, created on first use.
+ * \return the number of triangles.
  */
-void BKE_mesh_recalc_looptri(const MLoop *mloop,
-                             const MPoly *mpoly,
-                             const MVert *mvert,
-                             int totloop,
-                             int totpoly,
-                             MLoopTri *mlooptri)
+BLI_INLINE int mesh_recalc_looptri_poly(const MLoop *mloop,
+                                        const MPoly *mp,
+                                        const MVert *mvert,
+                                        const unsigned int poly_index,
+                                        MLoopTri *mlt,
+                                        MemArena **pa_arena)
 {
-  /* use this to avoid locking pthread for _every_ polygon
-   * and calling the fill function */
-
-#define USE_TESSFACE_SPEEDUP
+  const unsigned int mp_loopstart = (unsigned int)mp->loopstart;
+  const unsigned int mp_totloop = (unsigned int)mp->totloop;
+
+  if (mp_totloop == 3) {
+    ARRAY_SET_ITEMS(mlt->tri, mp_loopstart, mp_loopstart + 1, mp_loopstart + 2);
+    mlt->poly = poly_index;
+    return 1;
+  }
+  if (mp_totloop == 4) {
+    const unsigned int l1 = mp_loopstart, l2 = l1 + 1, l3 = l1 + 2, l4 = l1 + 3;
+    /* Split along the 2-4 diagonal instead of 1-3 to avoid a degenerate triangle. */
+    const bool flip = is_quad_flip_v3_first_third_fast(mvert[mloop[l1].v].co,
+                                                       mvert[mloop[l2].v].co,
+                                                       mvert[mloop[l3].v].co,
+                                                       mvert[mloop[l4].v].co);
+    ARRAY_SET_ITEMS(mlt[0].tri, l1, l2, flip ? l4 : l3);
+    ARRAY_SET_ITEMS(mlt[1].tri, flip ? l2 : l1, l3, l4);
+    mlt[0].poly = mlt[1].poly = poly_index;
+    return 2;
+  }
+  if (mp_totloop < 3) {
+    return 0;
+  }
 
-  const MPoly *mp;
   const MLoop *ml;
-  MLoopTri *mlt;
-  MemArena *arena = NULL;
-  int poly_index, mlooptri_index;
-  unsigned int j;
+  const float *co_curr, *co_prev;
 
-  mlooptri_index = 0;
-  mp = mpoly;
-  for (poly_index = 0; poly_index < totpoly; poly_index++, mp++) {
-    const unsigned int mp_loopstart = (unsigned int)mp->loopstart;
-    const unsigned int mp_totloop = (unsigned int)mp->totloop;
-    unsigned int l1, l2, l3;
-    if (mp_totloop < 3) {
-      /* do nothing */
-    }
+  float normal[3];
 
-#ifdef USE_TESSFACE_SPEEDUP
-
-#  define ML_TO_MLT(i1, i2, i3) \
-    { \
-      mlt = &mlooptri[mlooptri_index]; \
-      l1 = mp_loopstart + i1; \
-      l2 = mp_loopstart + i2; \
-      l3 = mp_loopstart + i3; \
-      ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3); \
-      mlt->poly = (unsigned int)poly_index; \
-    } \
-    ((void)0)
-
-    else if (mp_totloop == 3) {
-      ML_TO_MLT(0, 1, 2);
-      mlooptri_index++;
-    }
-    else if (mp_totloop == 4) {
-      ML_TO_MLT(0, 1, 2);
-      MLoopTri *mlt_a = mlt;
-      mlooptri_index++;
-      ML_TO_MLT(0, 2, 3);
-      MLoopTri *mlt_b = mlt;
-      mlooptri_index++;
-
-      if (UNLIKELY(is_quad_flip_v3_first_third_fast(mvert[mloop[mlt_a->tri[0]].v].co,
-                                                    mvert[mloop[mlt_a->tri[1]].v].co,
-                                                    mvert[mloop[mlt_a->tri[2]].v].co,
-                                                    mvert[mloop[mlt_b->tri[2]].v].co))) {
-        /* flip out of degenerate 0-2 state. */
-        mlt_a->tri[2] = mlt_b->tri[2];
-        mlt_b->tri[0] = mlt_a->tri[1];
-      }
-    }
-#endif /* USE_TESSFACE_SPEEDUP */
-    else {
-      const float *co_curr, *co_prev;
+  float axis_mat[3][3];
+  float(*projverts)[2];
+  unsigned int(*tris)[3];
+  unsigned int j;
 
-      float normal[3];
+  const unsigned int totfilltri = mp_totloop - 2;
 
-      float axis_mat[3][3];
-      float(*projverts)[2];
-      unsigned int(*tris)[3];
+  if (UNLIKELY(*pa_arena == NULL)) {
+    *pa_arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+  }
+  MemArena *arena = *pa_arena;
 
-      const unsigned int totfilltri = mp_totloop - 2;
+  tris = BLI_memarena_alloc(arena, sizeof(*tris) * (size_t)totfilltri);
+  projverts = BLI_memarena_alloc(arena, sizeof(*projverts) * (size_t)mp_totloop);
 
-      if (UNLIKELY(arena == NULL)) {
-        arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
-      }
+  zero_v3(normal);
 
-      tris = BLI_memarena_alloc(arena, sizeof(*tris) * (size_t)totfilltri);
-      projverts = BLI_memarena_alloc(arena, sizeof(*projverts) * (size_t)mp_totloop);
+  /* calc normal, flipped: to get a positive 2d cross product */
+  ml = mloop + mp_loopstart;
+  co_prev = mvert[ml[mp_totloop - 1].v].co;
+  for (j = 0; j < mp_totloop; j++, ml++) {
+    co_curr = mvert[ml->v].co;
+    add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
+    co_prev = co_curr;
+  }
+  if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
+    normal[2] = 1.0f;
+  }
 
-      zero_v3(normal);
+  /* project verts to 2d */
+  axis_dominant_v3_to_m3_negate(axis_mat, normal);
 
-      /* calc normal, flipped: to get a positive 2d cross product */
-      ml = mloop + mp_loopstart;
-      co_prev = mvert[ml[mp_totloop - 1].v].co;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        co_curr = mvert[ml->v].co;
-        add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
-        co_prev = co_curr;
-      }
-      if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
-        normal[2] = 1.0f;
-      }
+  ml = mloop + mp_loopstart;
+  for (j = 0; j < mp_totloop; j++, ml++) {
+    mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
+  }
 
-      /* project verts to 2d */
-      axis_dominant_v3_to_m3_negate(axis_mat, normal);
+  BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, arena);
 
-      ml = mloop + mp_loopstart;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
-      }
+  /* apply fill */
+  for (j = 0; j < totfilltri; j++, mlt++) {
+    const unsigned int *tri = tris[j];
+    ARRAY_SET_ITEMS(mlt->tri, mp_loopstart + tri[0], mp_loopstart + tri[1], mp_loopstart + tri[2]);
+    mlt->poly = poly_index;
+  }
 
-      BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, arena);
+  BLI_memarena_clear(arena);
 
-      /* apply fill */
-      for (j = 0; j < totfilltri; j++) {
-        unsigned int *tri = tris[j];
+  return (int)totfilltri;
+}
 
-        mlt = &mlooptri[mlooptri_index];
+typedef struct LoopTriData {
+  const MLoop *mloop;
+  const MPoly *mpoly;
+  const MVert *mvert;
+  /* Index of the first triangle of every polygon. */
+  int *tri_offsets;
+  MLoopTri *mlooptri;
+} LoopTriData;
+
+typedef struct LoopTriDataChunk {
+  MemArena *arena;
+} LoopTriDataChunk;
+
+static void mesh_recalc_looptri_count_cb(void *__restrict userdata,
+                                         const int index,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoopTriData *data = userdata;
+  data->tri_offsets[index] = max_ii(data->mpoly[index].totloop - 2, 0);
+}
 
-        /* set loop indices, transformed to vert indices later */
-        l1 = mp_loopstart + tri[0];
-        l2 = mp_loopstart + tri[1];
-        l3 = mp_loopstart + tri[2];
+static void mesh_recalc_looptri_poly_cb(void *__restrict userdata,
+                                        const int index,
+                                        const TaskParallelTLS *__restrict tls)
+{
+  LoopTriData *data = userdata;
+  LoopTriDataChunk *data_chunk = tls->userdata_chunk;
+  mesh_recalc_looptri_poly(data->mloop,
+                           &data->mpoly[index],
+                           data->mvert,
+                           (unsigned int)index,
+                           &data->mlooptri[data->tri_offsets[index]],
+                           &data_chunk->arena);
+}
 
-        ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3);
-        mlt->poly = (unsigned int)poly_index;
+static void mesh_recalc_looptri_finalize(void *__restrict UNUSED(userdata),
+                                         void *__restrict chunk)
+{
+  LoopTriDataChunk *data_chunk = chunk;
+  if (data_chunk->arena) {
+    BLI_memarena_free(data_chunk->arena);
+  }
+}
 
-        mlooptri_index++;
-      }
+/**
+ * Calculate tessellation into #MLoopTri which exist only for this purpose.
+ *
+ * Large meshes are tessellated on multiple threads, with the first triangle of every polygon
+ * found with a prefix sum over the triangle counts.
+ */
+void BKE_mesh_recalc_looptri(const MLoop *mloop,
+                             const MPoly *mpoly,
+                             const MVert *mvert,
+                             int totloop,
+                             int totpoly,
+                             MLoopTri *mlooptri)
+{
+  if (totpoly < MESH_LOOPTRI_PARALLEL_MIN_LEN || BLI_system_thread_count() == 1) {
+    MemArena *arena = NULL;
+    int mlooptri_index = 0;
+
+    for (int poly_index = 0; poly_index < totpoly; poly_index++) {
+      mlooptri_index += mesh_recalc_looptri_poly(mloop,
+                                                 &mpoly[poly_index],
+                                                 mvert,
+                                                 (unsigned int)poly_index,
+                                                 &mlooptri[mlooptri_index],
+                                                 &arena);
+    }
 
-      BLI_memarena_clear(arena);
+    if (arena) {
+      BLI_memarena_free(arena);
     }
-  }
 
-  if (arena) {
-    BLI_memarena_free(arena);
-    arena = NULL;
+    BLI_assert(mlooptri_index == poly_to_tri_count(totpoly, totloop));
+    UNUSED_VARS_NDEBUG(totloop);
+    return;
   }
 
-  BLI_assert(mlooptri_index == poly_to_tri_count(totpoly, totloop));
-  UNUSED_VARS_NDEBUG(totloop);
+  LoopTriData data = {
+      .mloop = mloop,
+      .mpoly = mpoly,
+      .mvert = mvert,
+      .tri_offsets = MEM_malloc_arrayN((size_t)totpoly, sizeof(int), __func__),
+      .mlooptri = mlooptri,
+  };
+  LoopTriDataChunk data_chunk = {NULL};
 
-#undef USE_TESSFACE_SPEEDUP
-#undef ML_TO_MLT
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+
+  BLI_task_parallel_range(0, totpoly, &data, mesh_recalc_looptri_count_cb, &settings);
+  const int looptri_len = BLI_parallel_prefix_sum_int(data.tri_offsets, totpoly);
+  BLI_assert(looptri_len == poly_to_tri_count(totpoly, totloop));
+  UNUSED_VARS_NDEBUG(looptri_len, totloop);
+
+  settings.userdata_chunk = &data_chunk;
+  settings.userdata_chunk_size = sizeof(data_chunk);
+  settings.func_finalize = mesh_recalc_looptri_finalize;
+  BLI_task_parallel_range(0, totpoly, &data, mesh_recalc_looptri_poly_cb, &settings);
+
+  MEM_freeN(data.tri_offsets);
 }
 
 static void bm_corners_to_loops_ex(ID *id,
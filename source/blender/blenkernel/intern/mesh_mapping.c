@@ -23,13 +23,18 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "DNA_meshdata_types.h"
 #include "DNA_vec_types.h"
 
 #include "BLI_buffer.h"
 #include "BLI_utildefines.h"
+#include "BLI_array_parallel.h"
 #include "BLI_bitmap.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "BKE_mesh_mapping.h"
 #include "BKE_customdata.h"
@@ -194,60 +199,204 @@ void BKE_mesh_uv_vert_map_free(UvVertMap *vmap)
   }
 }
 
+/* Below this, the maps are built on the calling thread. */
+#define MESH_MAP_PARALLEL_MIN_LEN 4096
+/* Value lists up to this length are sorted with insertion sort. */
+#define MESH_MAP_INSERTION_SORT_MAX 16
+
 /**
- * Generates a map where the key is the vertex and the value is a list
- * of polys or loops that use that vertex as a corner. The lists are allocated
- * from one memory pool.
+ * Maps are built in two passes over the elements that add values to keys: the first pass only
+ * counts the values of each key, after which each key gets its range of the memory, which the
+ * second pass fills.
  *
- * Wrapped by #BKE_mesh_vert_poly_map_create & BKE_mesh_vert_loop_map_create
+ * On multiple threads, the count of each key is incremented atomically, and the values of each
+ * key are sorted afterwards, so they are in the same order as when adding them on one thread.
  */
-static void mesh_vert_poly_or_loop_map_create(MeshElemMap **r_map,
-                                              int **r_mem,
-                                              const MPoly *mpoly,
-                                              const MLoop *mloop,
-                                              int totvert,
-                                              int totpoly,
-                                              int totloop,
-                                              const bool do_loops)
+typedef struct MeshMapBuildData {
+  const MPoly *mpoly;
+  const MLoop *mloop;
+  const MEdge *medge;
+  const MLoopTri *mlooptri;
+
+  MeshElemMap *map;
+  int *offsets;
+  /* NULL while counting. */
+  int *mem;
+  /* Number of values added together, these are sorted by the first one. */
+  int stride;
+
+  bool use_threading;
+  bool do_loops;
+  bool do_verts;
+} MeshMapBuildData;
+
+/**
+ * Reserve room for #MeshMapBuildData.stride values of \a key.
+ *
+ * \return where to write the values, NULL while counting.
+ */
+BLI_INLINE int *mesh_map_add(MeshMapBuildData *data, const uint key)
 {
-  MeshElemMap *map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totvert, __func__);
-  int *indices, *index_iter;
-  int i, j;
+  MeshElemMap *map_ele = &data->map[key];
+  int index;
 
-  indices = index_iter = MEM_mallocN(sizeof(int) * (size_t)totloop, __func__);
+  if (data->use_threading) {
+    index = atomic_fetch_and_add_int32(&map_ele->count, data->stride);
+  }
+  else {
+    index = map_ele->count;
+    map_ele->count += data->stride;
+  }
+  return data->mem ? &map_ele->indices[index] : NULL;
+}
 
-  /* Count number of polys for each vertex */
-  for (i = 0; i < totpoly; i++) {
-    const MPoly *p = &mpoly[i];
+static int mesh_map_values_cmp(const void *a, const void *b)
+{
+  const int value_a = *(const int *)a;
+  const int value_b = *(const int *)b;
+  return (value_a > value_b) - (value_a < value_b);
+}
 
-    for (j = 0; j < p->totloop; j++) {
-      map[mloop[p->loopstart + j].v].count++;
+static void mesh_map_sort_values(int *values, const int len, const int stride)
+{
+  if (len > MESH_MAP_INSERTION_SORT_MAX * stride) {
+    qsort(values, (size_t)(len / stride), sizeof(*values) * (size_t)stride, mesh_map_values_cmp);
+    return;
+  }
+
+  for (int i = stride; i < len; i += stride) {
+    int tmp[2];
+    int j;
+    memcpy(tmp, &values[i], sizeof(*values) * (size_t)stride);
+    for (j = i; j > 0 && values[j - stride] > tmp[0]; j -= stride) {
+      memcpy(&values[j], &values[j - stride], sizeof(*values) * (size_t)stride);
     }
+    memcpy(&values[j], tmp, sizeof(*values) * (size_t)stride);
   }
+}
 
-  /* Assign indices mem */
-  for (i = 0; i < totvert; i++) {
-    map[i].indices = index_iter;
-    index_iter += map[i].count;
+static void mesh_map_offsets_cb(void *__restrict userdata,
+                                const int key,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshMapBuildData *data = userdata;
+  data->offsets[key] = data->map[key].count;
+}
 
-    /* Reset 'count' for use as index in last loop */
-    map[i].count = 0;
+static void mesh_map_indices_cb(void *__restrict userdata,
+                                const int key,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshMapBuildData *data = userdata;
+  data->map[key].indices = &data->mem[data->offsets[key]];
+  data->map[key].count = 0;
+}
+
+static void mesh_map_finalize_cb(void *__restrict userdata,
+                                 const int key,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshMapBuildData *data = userdata;
+  MeshElemMap *map_ele = &data->map[key];
+
+  if (data->use_threading) {
+    mesh_map_sort_values(map_ele->indices, map_ele->count, data->stride);
   }
+  if (data->do_verts) {
+    /* Replace the edges by their other vertex. */
+    for (int i = 0; i < map_ele->count; i++) {
+      const MEdge *e = &data->medge[map_ele->indices[i]];
+      map_ele->indices[i] = (int)((e->v1 == (uint)key) ? e->v2 : e->v1);
+    }
+  }
+}
 
-  /* Find the users */
-  for (i = 0; i < totpoly; i++) {
-    const MPoly *p = &mpoly[i];
+/**
+ * Build a map with \a totkey keys, calling \a func for each of the \a totelem elements that add
+ * values to the map with #mesh_map_add.
+ */
+static void mesh_map_build(MeshElemMap **r_map,
+                           int **r_mem,
+                           const int totkey,
+                           const int totelem,
+                           TaskParallelRangeFunc func,
+                           MeshMapBuildData *data)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+
+  data->map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totkey, __func__);
+  data->offsets = MEM_mallocN(sizeof(int) * (size_t)totkey, __func__);
+  data->mem = NULL;
+  data->use_threading = (totelem >= MESH_MAP_PARALLEL_MIN_LEN) &&
+                        (BLI_system_thread_count() > 1);
+  if (data->stride == 0) {
+    data->stride = 1;
+  }
+
+  /* Count the values of each key. */
+  settings.use_threading = data->use_threading;
+  BLI_task_parallel_range(0, totelem, data, func, &settings);
+
+  settings.use_threading = (totkey >= MESH_MAP_PARALLEL_MIN_LEN);
+  BLI_task_parallel_range(0, totkey, data, mesh_map_offsets_cb, &settings);
+  const int mem_len = BLI_parallel_prefix_sum_int(data->offsets, totkey);
+  data->mem = MEM_mallocN(sizeof(int) * (size_t)max_ii(mem_len, 1), __func__);
+  BLI_task_parallel_range(0, totkey, data, mesh_map_indices_cb, &settings);
 
-    for (j = 0; j < p->totloop; j++) {
-      unsigned int v = mloop[p->loopstart + j].v;
+  /* Fill in the values. */
+  settings.use_threading = data->use_threading;
+  BLI_task_parallel_range(0, totelem, data, func, &settings);
 
-      map[v].indices[map[v].count] = do_loops ? p->loopstart + j : i;
-      map[v].count++;
+  if (data->use_threading || data->do_verts) {
+    settings.use_threading = (totkey >= MESH_MAP_PARALLEL_MIN_LEN);
+    BLI_task_parallel_range(0, totkey, data, mesh_map_finalize_cb, &settings);
+  }
+
+  MEM_freeN(data->offsets);
+
+  *r_map = data->map;
+  *r_mem = data->mem;
+}
+
+static void mesh_vert_poly_or_loop_map_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshMapBuildData *data = userdata;
+  const MPoly *p = &data->mpoly[i];
+
+  for (int j = 0; j < p->totloop; j++) {
+    int *r_value = mesh_map_add(data, data->mloop[p->loopstart + j].v);
+    if (r_value) {
+      *r_value = data->do_loops ? p->loopstart + j : i;
     }
   }
+}
 
-  *r_map = map;
-  *r_mem = indices;
+/**
+ * Generates a map where the key is the vertex and the value is a list
+ * of polys or loops that use that vertex as a corner. The lists are allocated
+ * from one memory pool.
+ *
+ * Wrapped by #BKE_mesh_vert_poly_map_create & BKE_mesh_vert_loop_map_create
+ */
+static void mesh_vert_poly_or_loop_map_create(MeshElemMap **r_map,
+                                              int **r_mem,
+                                              const MPoly *mpoly,
+                                              const MLoop *mloop,
+                                              int totvert,
+                                              int totpoly,
+                                              int UNUSED(totloop),
+                                              const bool do_loops)
+{
+  MeshMapBuildData data = {
+      .mpoly = mpoly,
+      .mloop = mloop,
+      .do_loops = do_loops,
+  };
+  mesh_map_build(r_map, r_mem, totvert, totpoly, mesh_vert_poly_or_loop_map_cb, &data);
 }
 
 /**
@@ -282,6 +431,21 @@ void BKE_mesh_vert_loop_map_create(MeshElemMap **r_map,
   mesh_vert_poly_or_loop_map_create(r_map, r_mem, mpoly, mloop, totvert, totpoly, totloop, true);
 }
 
+static void mesh_vert_looptri_map_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshMapBuildData *data = userdata;
+  const MLoopTri *mlt = &data->mlooptri[i];
+
+  for (int j = 0; j < 3; j++) {
+    int *r_value = mesh_map_add(data, data->mloop[mlt->tri[j]].v);
+    if (r_value) {
+      *r_value = i;
+    }
+  }
+}
+
 /**
  * Generates a map where the key is the edge and the value
  * is a list of looptris that use that edge.
@@ -296,39 +460,27 @@ void BKE_mesh_vert_looptri_map_create(MeshElemMap **r_map,
                                       const MLoop *mloop,
                                       const int UNUSED(totloop))
 {
-  MeshElemMap *map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totvert, __func__);
-  int *indices = MEM_mallocN(sizeof(int) * (size_t)totlooptri * 3, __func__);
-  int *index_step;
-  const MLoopTri *mlt;
-  int i;
-
-  /* count face users */
-  for (i = 0, mlt = mlooptri; i < totlooptri; mlt++, i++) {
-    for (int j = 3; j--;) {
-      map[mloop[mlt->tri[j]].v].count++;
-    }
-  }
+  MeshMapBuildData data = {
+      .mloop = mloop,
+      .mlooptri = mlooptri,
+  };
+  mesh_map_build(r_map, r_mem, totvert, totlooptri, mesh_vert_looptri_map_cb, &data);
+}
 
-  /* create offsets */
-  index_step = indices;
-  for (i = 0; i < totvert; i++) {
-    map[i].indices = index_step;
-    index_step += map[i].count;
+static void mesh_vert_edge_map_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshMapBuildData *data = userdata;
+  const MEdge *e = &data->medge[i];
+  int *r_value;
 
-    /* re-count, using this as an index below */
-    map[i].count = 0;
+  if ((r_value = mesh_map_add(data, e->v1))) {
+    *r_value = i;
   }
-
-  /* assign looptri-edge users */
-  for (i = 0, mlt = mlooptri; i < totlooptri; mlt++, i++) {
-    for (int j = 3; j--;) {
-      MeshElemMap *map_ele = &map[mloop[mlt->tri[j]].v];
-      map_ele->indices[map_ele->count++] = i;
-    }
+  if ((r_value = mesh_map_add(data, e->v2))) {
+    *r_value = i;
   }
-
-  *r_map = map;
-  *r_mem = indices;
 }
 
 /**
@@ -339,40 +491,10 @@ void BKE_mesh_vert_looptri_map_create(MeshElemMap **r_map,
 void BKE_mesh_vert_edge_map_create(
     MeshElemMap **r_map, int **r_mem, const MEdge *medge, int totvert, int totedge)
 {
-  MeshElemMap *map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totvert, "vert-edge map");
-  int *indices = MEM_mallocN(sizeof(int[2]) * (size_t)totedge, "vert-edge map mem");
-  int *i_pt = indices;
-
-  int i;
-
-  /* Count number of edges for each vertex */
-  for (i = 0; i < totedge; i++) {
-    map[medge[i].v1].count++;
-    map[medge[i].v2].count++;
-  }
-
-  /* Assign indices mem */
-  for (i = 0; i < totvert; i++) {
-    map[i].indices = i_pt;
-    i_pt += map[i].count;
-
-    /* Reset 'count' for use as index in last loop */
-    map[i].count = 0;
-  }
-
-  /* Find the users */
-  for (i = 0; i < totedge; i++) {
-    const unsigned int v[2] = {medge[i].v1, medge[i].v2};
-
-    map[v[0]].indices[map[v[0]].count] = i;
-    map[v[1]].indices[map[v[1]].count] = i;
-
-    map[v[0]].count++;
-    map[v[1]].count++;
-  }
-
-  *r_map = map;
-  *r_mem = indices;
+  MeshMapBuildData data = {
+      .medge = medge,
+  };
+  mesh_map_build(r_map, r_mem, totvert, totedge, mesh_vert_edge_map_cb, &data);
 }
 
 /**
@@ -382,40 +504,29 @@ void BKE_mesh_vert_edge_map_create(
 void BKE_mesh_vert_edge_vert_map_create(
     MeshElemMap **r_map, int **r_mem, const MEdge *medge, int totvert, int totedge)
 {
-  MeshElemMap *map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totvert, "vert-edge map");
-  int *indices = MEM_mallocN(sizeof(int[2]) * (size_t)totedge, "vert-edge map mem");
-  int *i_pt = indices;
-
-  int i;
-
-  /* Count number of edges for each vertex */
-  for (i = 0; i < totedge; i++) {
-    map[medge[i].v1].count++;
-    map[medge[i].v2].count++;
-  }
-
-  /* Assign indices mem */
-  for (i = 0; i < totvert; i++) {
-    map[i].indices = i_pt;
-    i_pt += map[i].count;
-
-    /* Reset 'count' for use as index in last loop */
-    map[i].count = 0;
-  }
-
-  /* Find the users */
-  for (i = 0; i < totedge; i++) {
-    const unsigned int v[2] = {medge[i].v1, medge[i].v2};
-
-    map[v[0]].indices[map[v[0]].count] = (int)v[1];
-    map[v[1]].indices[map[v[1]].count] = (int)v[0];
+  MeshMapBuildData data = {
+      .medge = medge,
+      .do_verts = true,
+  };
+  mesh_map_build(r_map, r_mem, totvert, totedge, mesh_vert_edge_map_cb, &data);
+}
 
-    map[v[0]].count++;
-    map[v[1]].count++;
+static void mesh_edge_loop_map_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshMapBuildData *data = userdata;
+  const MPoly *mp = &data->mpoly[i];
+
+  for (int j = 0; j < mp->totloop; j++) {
+    const int loop = mp->loopstart + j;
+    int *r_value = mesh_map_add(data, data->mloop[loop].e);
+    if (r_value) {
+      r_value[0] = loop;
+      /* The last edge/loop of the poly must point back to the first loop. */
+      r_value[1] = (j == mp->totloop - 1) ? mp->loopstart : loop + 1;
+    }
   }
-
-  *r_map = map;
-  *r_mem = indices;
 }
 
 /**
@@ -430,50 +541,29 @@ void BKE_mesh_edge_loop_map_create(MeshElemMap **r_map,
                                    const MPoly *mpoly,
                                    const int totpoly,
                                    const MLoop *mloop,
-                                   const int totloop)
+                                   const int UNUSED(totloop))
 {
-  MeshElemMap *map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totedge, "edge-poly map");
-  int *indices = MEM_mallocN(sizeof(int) * (size_t)totloop * 2, "edge-poly map mem");
-  int *index_step;
-  const MPoly *mp;
-  int i;
-
-  /* count face users */
-  for (i = 0, mp = mpoly; i < totpoly; mp++, i++) {
-    const MLoop *ml;
-    int j = mp->totloop;
-    for (ml = &mloop[mp->loopstart]; j--; ml++) {
-      map[ml->e].count += 2;
-    }
-  }
-
-  /* create offsets */
-  index_step = indices;
-  for (i = 0; i < totedge; i++) {
-    map[i].indices = index_step;
-    index_step += map[i].count;
+  MeshMapBuildData data = {
+      .mpoly = mpoly,
+      .mloop = mloop,
+      .stride = 2,
+  };
+  mesh_map_build(r_map, r_mem, totedge, totpoly, mesh_edge_loop_map_cb, &data);
+}
 
-    /* re-count, using this as an index below */
-    map[i].count = 0;
-  }
+static void mesh_edge_poly_map_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshMapBuildData *data = userdata;
+  const MPoly *mp = &data->mpoly[i];
 
-  /* assign loop-edge users */
-  for (i = 0, mp = mpoly; i < totpoly; mp++, i++) {
-    const MLoop *ml;
-    MeshElemMap *map_ele;
-    const int max_loop = mp->loopstart + mp->totloop;
-    int j = mp->loopstart;
-    for (ml = &mloop[j]; j < max_loop; j++, ml++) {
-      map_ele = &map[ml->e];
-      map_ele->indices[map_ele->count++] = j;
-      map_ele->indices[map_ele->count++] = j + 1;
+  for (int j = 0; j < mp->totloop; j++) {
+    int *r_value = mesh_map_add(data, data->mloop[mp->loopstart + j].e);
+    if (r_value) {
+      *r_value = i;
     }
-    /* last edge/loop of poly, must point back to first loop! */
-    map_ele->indices[map_ele->count - 1] = mp->loopstart;
   }
-
-  *r_map = map;
-  *r_mem = indices;
 }
 
 /**
@@ -488,45 +578,13 @@ void BKE_mesh_edge_poly_map_create(MeshElemMap **r_map,
                                    const MPoly *mpoly,
                                    const int totpoly,
                                    const MLoop *mloop,
-                                   const int totloop)
+                                   const int UNUSED(totloop))
 {
-  MeshElemMap *map = MEM_callocN(sizeof(MeshElemMap) * (size_t)totedge, "edge-poly map");
-  int *indices = MEM_mallocN(sizeof(int) * (size_t)totloop, "edge-poly map mem");
-  int *index_step;
-  const MPoly *mp;
-  int i;
-
-  /* count face users */
-  for (i = 0, mp = mpoly; i < totpoly; mp++, i++) {
-    const MLoop *ml;
-    int j = mp->totloop;
-    for (ml = &mloop[mp->loopstart]; j--; ml++) {
-      map[ml->e].count++;
-    }
-  }
-
-  /* create offsets */
-  index_step = indices;
-  for (i = 0; i < totedge; i++) {
-    map[i].indices = index_step;
-    index_step += map[i].count;
-
-    /* re-count, using this as an index below */
-    map[i].count = 0;
-  }
-
-  /* assign poly-edge users */
-  for (i = 0, mp = mpoly; i < totpoly; mp++, i++) {
-    const MLoop *ml;
-    int j = mp->totloop;
-    for (ml = &mloop[mp->loopstart]; j--; ml++) {
-      MeshElemMap *map_ele = &map[ml->e];
-      map_ele->indices[map_ele->count++] = i;
-    }
-  }
-
-  *r_map = map;
-  *r_mem = indices;
+  MeshMapBuildData data = {
+      .mpoly = mpoly,
+      .mloop = mloop,
+  };
+  mesh_map_build(r_map, r_mem, totedge, totpoly, mesh_edge_poly_map_cb, &data);
 }
 
 /**
@@ -887,6 +945,55 @@ int *BKE_mesh_calc_smoothgroups(const MEdge *medge,
   return poly_groups;
 }
 
+static bool poly_is_island_boundary_none_cb(const MPoly *UNUSED(mp),
+                                            const MLoop *UNUSED(ml),
+                                            const MEdge *UNUSED(me),
+                                            const int UNUSED(nbr_egde_users),
+                                            const MPoly *UNUSED(mpoly_array),
+                                            const MeshElemMap *UNUSED(edge_poly_map),
+                                            void *UNUSED(user_data))
+{
+  return false;
+}
+
+/**
+ * Calculate the islands of polygons connected by edges.
+ *
+ * \param edge_poly_map: Optional, computed when NULL.
+ * \param r_totgroup: The total number of islands.
+ * \return Polygon aligned array of island index values, starting at 1
+ * (as #BKE_mesh_calc_smoothgroups).
+ * Note it's callers's responsibility to MEM_freeN returned array.
+ */
+int *BKE_mesh_calc_poly_islands(const MEdge *medge,
+                                const int totedge,
+                                const MPoly *mpoly,
+                                const int totpoly,
+                                const MLoop *mloop,
+                                const int totloop,
+                                const MeshElemMap *edge_poly_map,
+                                int *r_totgroup)
+{
+  int *poly_groups = NULL;
+
+  poly_edge_loop_islands_calc(medge,
+                              totedge,
+                              mpoly,
+                              totpoly,
+                              mloop,
+                              totloop,
+                              (MeshElemMap *)edge_poly_map,
+                              false,
+                              poly_is_island_boundary_none_cb,
+                              NULL,
+                              &poly_groups,
+                              r_totgroup,
+                              NULL,
+                              NULL);
+
+  return poly_groups;
+}
+
 #define MISLAND_DEFAULT_BUFSIZE 64
 
 void BKE_mesh_loop_islands_init(MeshIslandStore *island_store,
@@ -32,6 +32,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_object_types.h"
@@ -316,6 +317,29 @@ Mesh *BKE_mesh_remesh_voxel_to_mesh_nomain(Mesh *mesh,
   return new_mesh;
 }
 
+typedef struct ReprojectPaintMaskData {
+  BVHTreeFromMesh *bvhtree;
+  const MVert *target_verts;
+  float *target_mask;
+  const float *source_mask;
+} ReprojectPaintMaskData;
+
+static void reproject_paint_mask_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReprojectPaintMaskData *data = userdata;
+  BVHTreeFromMesh *bvhtree = data->bvhtree;
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = FLT_MAX;
+  BLI_bvhtree_find_nearest(
+      bvhtree->tree, data->target_verts[i].co, &nearest, bvhtree->nearest_callback, bvhtree);
+  if (nearest.index != -1) {
+    data->target_mask[i] = data->source_mask[nearest.index];
+  }
+}
+
 void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
 {
   BVHTreeFromMesh bvhtree = {
@@ -342,20 +366,52 @@ void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
         &source->vdata, CD_PAINT_MASK, CD_CALLOC, NULL, source->totvert);
   }
 
-  for (int i = 0; i < target->totvert; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    copy_v3_v3(from_co, target_verts[i].co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_mask[i] = source_mask[nearest.index];
-    }
-  }
+  ReprojectPaintMaskData data = {
+      .bvhtree = &bvhtree,
+      .target_verts = target_verts,
+      .target_mask = target_mask,
+      .source_mask = source_mask,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, target->totvert, &data, reproject_paint_mask_cb, &settings);
+
   free_bvhtree_from_mesh(&bvhtree);
 }
 
+typedef struct ReprojectFaceSetsData {
+  BVHTreeFromMesh *bvhtree;
+  const MPoly *target_polys;
+  const MVert *target_verts;
+  const MLoop *target_loops;
+  int *target_face_sets;
+  const int *source_face_sets;
+  const MLoopTri *source_looptri;
+} ReprojectFaceSetsData;
+
+static void reproject_sculpt_face_sets_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReprojectFaceSetsData *data = userdata;
+  BVHTreeFromMesh *bvhtree = data->bvhtree;
+  float from_co[3];
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = FLT_MAX;
+  const MPoly *mpoly = &data->target_polys[i];
+  BKE_mesh_calc_poly_center(
+      mpoly, &data->target_loops[mpoly->loopstart], data->target_verts, from_co);
+  BLI_bvhtree_find_nearest(bvhtree->tree, from_co, &nearest, bvhtree->nearest_callback, bvhtree);
+  if (nearest.index != -1) {
+    data->target_face_sets[i] = data->source_face_sets[data->source_looptri[nearest.index].poly];
+  }
+  else {
+    data->target_face_sets[i] = 1;
+  }
+}
+
 void BKE_remesh_reproject_sculpt_face_sets(Mesh *target, Mesh *source)
 {
   BVHTreeFromMesh bvhtree = {
@@ -387,21 +443,20 @@ void BKE_remesh_reproject_sculpt_face_sets(Mesh *target, Mesh *source)
   const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(source);
   BKE_bvhtree_from_mesh_get(&bvhtree, source, BVHTREE_FROM_LOOPTRI, 2);
 
-  for (int i = 0; i < target->totpoly; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    const MPoly *mpoly = &target_polys[i];
-    BKE_mesh_calc_poly_center(mpoly, &target_loops[mpoly->loopstart], target_verts, from_co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_face_sets[i] = source_face_sets[looptri[nearest.index].poly];
-    }
-    else {
-      target_face_sets[i] = 1;
-    }
-  }
+  ReprojectFaceSetsData data = {
+      .bvhtree = &bvhtree,
+      .target_polys = target_polys,
+      .target_verts = target_verts,
+      .target_loops = target_loops,
+      .target_face_sets = target_face_sets,
+      .source_face_sets = source_face_sets,
+      .source_looptri = looptri,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, target->totpoly, &data, reproject_sculpt_face_sets_cb, &settings);
+
   free_bvhtree_from_mesh(&bvhtree);
 }
 
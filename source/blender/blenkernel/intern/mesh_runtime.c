@@ -35,10 +35,235 @@
 #include "BKE_bvhutils.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_subdiv_ccg.h"
 #include "BKE_shrinkwrap.h"
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh Topology Cache
+ *
+ * Data that only depends on the topology (the edge, poly and loop arrays), computed on demand.
+ *
+ * The cache is shared by copies of a mesh that reference its topology arrays, as evaluated meshes
+ * do, so modifiers evaluated on such copies reuse the data for as long as the topology stays the
+ * same. #BKE_mesh_runtime_clear_geometry must be called when the topology changes in-place.
+ * \{ */
+
+typedef struct MeshTopologyCache {
+  /** Number of meshes using this cache. */
+  int users;
+  /** Unique for every cache, see #BKE_mesh_runtime_topology_generation. */
+  int generation;
+  /** Protects the data below while it is computed. */
+  ThreadMutex mutex;
+
+  /* The topology this cache was created for. */
+  const MEdge *medge;
+  const MPoly *mpoly;
+  const MLoop *mloop;
+  int totvert, totedge, totpoly, totloop;
+
+  MeshElemMap *maps[MESH_TOPOLOGY_MAP_NUM];
+  int *maps_mem[MESH_TOPOLOGY_MAP_NUM];
+
+  int *poly_islands;
+  int poly_islands_num;
+} MeshTopologyCache;
+
+/* Protects the #Mesh_Runtime.topology_cache pointers and the cache users. */
+static ThreadMutex topology_cache_lock = BLI_MUTEX_INITIALIZER;
+static int topology_cache_generation = 0;
+
+static bool mesh_topology_cache_matches(const MeshTopologyCache *cache, const Mesh *mesh)
+{
+  return (cache->medge == mesh->medge) && (cache->mpoly == mesh->mpoly) &&
+         (cache->mloop == mesh->mloop) && (cache->totvert == mesh->totvert) &&
+         (cache->totedge == mesh->totedge) && (cache->totpoly == mesh->totpoly) &&
+         (cache->totloop == mesh->totloop);
+}
+
+/* Must be called with #topology_cache_lock held. */
+static void mesh_topology_cache_release(MeshTopologyCache *cache)
+{
+  BLI_assert(cache->users > 0);
+  if (--cache->users != 0) {
+    return;
+  }
+
+  for (int i = 0; i < MESH_TOPOLOGY_MAP_NUM; i++) {
+    MEM_SAFE_FREE(cache->maps[i]);
+    MEM_SAFE_FREE(cache->maps_mem[i]);
+  }
+  MEM_SAFE_FREE(cache->poly_islands);
+  BLI_mutex_end(&cache->mutex);
+  MEM_freeN(cache);
+}
+
+/**
+ * Get the cache of \a mesh, replacing it when the topology changed since it was created.
+ * Must be called with #topology_cache_lock held.
+ */
+static MeshTopologyCache *mesh_topology_cache_get_locked(Mesh *mesh)
+{
+  MeshTopologyCache *cache = mesh->runtime.topology_cache;
+
+  if (cache != NULL && !mesh_topology_cache_matches(cache, mesh)) {
+    mesh_topology_cache_release(cache);
+    cache = NULL;
+  }
+
+  if (cache == NULL) {
+    cache = MEM_callocN(sizeof(*cache), __func__);
+    cache->users = 1;
+    cache->generation = atomic_add_and_fetch_int32(&topology_cache_generation, 1);
+    BLI_mutex_init(&cache->mutex);
+
+    cache->medge = mesh->medge;
+    cache->mpoly = mesh->mpoly;
+    cache->mloop = mesh->mloop;
+    cache->totvert = mesh->totvert;
+    cache->totedge = mesh->totedge;
+    cache->totpoly = mesh->totpoly;
+    cache->totloop = mesh->totloop;
+
+    mesh->runtime.topology_cache = cache;
+  }
+  return cache;
+}
+
+static MeshTopologyCache *mesh_topology_cache_get(Mesh *mesh)
+{
+  BLI_mutex_lock(&topology_cache_lock);
+  MeshTopologyCache *cache = mesh_topology_cache_get_locked(mesh);
+  BLI_mutex_unlock(&topology_cache_lock);
+  return cache;
+}
+
+static void mesh_topology_cache_clear(Mesh *mesh)
+{
+  if (mesh->runtime.topology_cache == NULL) {
+    return;
+  }
+  BLI_mutex_lock(&topology_cache_lock);
+  mesh_topology_cache_release(mesh->runtime.topology_cache);
+  mesh->runtime.topology_cache = NULL;
+  BLI_mutex_unlock(&topology_cache_lock);
+}
+
+/**
+ * Share the topology cache of \a mesh_src with \a mesh_dst, when it references the same topology
+ * arrays. A cache is created for \a mesh_src when it has none yet, so that data computed for
+ * either of the meshes is available to both.
+ */
+void BKE_mesh_runtime_topology_cache_share(Mesh *mesh_dst, const Mesh *mesh_src)
+{
+  BLI_assert(mesh_dst->runtime.topology_cache == NULL);
+
+  /* Only the runtime data of the source is modified. */
+  Mesh *mesh_src_mut = (Mesh *)mesh_src;
+
+  BLI_mutex_lock(&topology_cache_lock);
+  MeshTopologyCache *cache = mesh_topology_cache_get_locked(mesh_src_mut);
+  if (mesh_topology_cache_matches(cache, mesh_dst)) {
+    cache->users++;
+    mesh_dst->runtime.topology_cache = cache;
+  }
+  BLI_mutex_unlock(&topology_cache_lock);
+}
+
+/**
+ * Get an adjacency map of \a mesh, computing it when it isn't cached yet.
+ *
+ * The map stays valid until the topology of the mesh changes, or the mesh is freed.
+ */
+const MeshElemMap *BKE_mesh_runtime_topology_map_ensure(Mesh *mesh, const eMeshTopologyMap type)
+{
+  MeshTopologyCache *cache = mesh_topology_cache_get(mesh);
+
+  BLI_mutex_lock(&cache->mutex);
+  if (cache->maps[type] == NULL) {
+    MeshElemMap **r_map = &cache->maps[type];
+    int **r_mem = &cache->maps_mem[type];
+    switch (type) {
+      case MESH_TOPOLOGY_MAP_VERT_POLY:
+        BKE_mesh_vert_poly_map_create(
+            r_map, r_mem, mesh->mpoly, mesh->mloop, mesh->totvert, mesh->totpoly, mesh->totloop);
+        break;
+      case MESH_TOPOLOGY_MAP_VERT_LOOP:
+        BKE_mesh_vert_loop_map_create(
+            r_map, r_mem, mesh->mpoly, mesh->mloop, mesh->totvert, mesh->totpoly, mesh->totloop);
+        break;
+      case MESH_TOPOLOGY_MAP_VERT_EDGE:
+        BKE_mesh_vert_edge_map_create(r_map, r_mem, mesh->medge, mesh->totvert, mesh->totedge);
+        break;
+      case MESH_TOPOLOGY_MAP_EDGE_POLY:
+        BKE_mesh_edge_poly_map_create(r_map,
+                                      r_mem,
+                                      mesh->medge,
+                                      mesh->totedge,
+                                      mesh->mpoly,
+                                      mesh->totpoly,
+                                      mesh->mloop,
+                                      mesh->totloop);
+        break;
+      case MESH_TOPOLOGY_MAP_EDGE_LOOP:
+        BKE_mesh_edge_loop_map_create(r_map,
+                                      r_mem,
+                                      mesh->medge,
+                                      mesh->totedge,
+                                      mesh->mpoly,
+                                      mesh->totpoly,
+                                      mesh->mloop,
+                                      mesh->totloop);
+        break;
+    }
+  }
+  const MeshElemMap *map = cache->maps[type];
+  BLI_mutex_unlock(&cache->mutex);
+
+  return map;
+}
+
+/**
+ * Get the island of every polygon of \a mesh, as computed by #BKE_mesh_calc_poly_islands.
+ */
+const int *BKE_mesh_runtime_poly_islands_ensure(Mesh *mesh, int *r_islands_num)
+{
+  /* Ensured first, the cache mutex isn't recursive. */
+  const MeshElemMap *edge_poly_map = BKE_mesh_runtime_topology_map_ensure(
+      mesh, MESH_TOPOLOGY_MAP_EDGE_POLY);
+  MeshTopologyCache *cache = mesh_topology_cache_get(mesh);
+
+  BLI_mutex_lock(&cache->mutex);
+  if (cache->poly_islands == NULL && mesh->totpoly != 0) {
+    cache->poly_islands = BKE_mesh_calc_poly_islands(mesh->medge,
+                                                     mesh->totedge,
+                                                     mesh->mpoly,
+                                                     mesh->totpoly,
+                                                     mesh->mloop,
+                                                     mesh->totloop,
+                                                     edge_poly_map,
+                                                     &cache->poly_islands_num);
+  }
+  const int *poly_islands = cache->poly_islands;
+  *r_islands_num = cache->poly_islands_num;
+  BLI_mutex_unlock(&cache->mutex);
+
+  return poly_islands;
+}
+
+/**
+ * A number that changes whenever the topology of \a mesh changes, so callers that keep their
+ * own topology dependent data can tell when it has to be computed again.
+ */
+int BKE_mesh_runtime_topology_generation(Mesh *mesh)
+{
+  return mesh_topology_cache_get(mesh)->generation;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Mesh Runtime Struct Utils
  * \{ */
@@ -65,7 +290,9 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   runtime->mesh_eval = NULL;
   runtime->edit_data = NULL;
   runtime->batch_cache = NULL;
+  runtime->is_deform_update = false;
   runtime->subdiv_ccg = NULL;
+  runtime->topology_cache = NULL;
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
   runtime->bvh_cache = NULL;
   runtime->shrinkwrap_data = NULL;
@@ -192,6 +419,32 @@ void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
   }
 }
 
+/**
+ * Fill three vertex indices per loop triangle in \a r_tri_verts, along with the material index
+ * and smooth flag of the polygon each triangle belongs to. Meant for exporters that would
+ * otherwise look these up one triangle at a time.
+ */
+void BKE_mesh_runtime_looptri_export(Mesh *mesh,
+                                     int *r_tri_verts,
+                                     int *r_tri_mat_nr,
+                                     bool *r_tri_smooth)
+{
+  const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(mesh);
+  const int looptri_len = BKE_mesh_runtime_looptri_len(mesh);
+  const MLoop *mloop = mesh->mloop;
+  const MPoly *mpoly = mesh->mpoly;
+
+  for (int i = 0; i < looptri_len; i++) {
+    const MLoopTri *lt = &looptri[i];
+    const MPoly *mp = &mpoly[lt->poly];
+    r_tri_verts[i * 3 + 0] = mloop[lt->tri[0]].v;
+    r_tri_verts[i * 3 + 1] = mloop[lt->tri[1]].v;
+    r_tri_verts[i * 3 + 2] = mloop[lt->tri[2]].v;
+    r_tri_mat_nr[i] = mp->mat_nr;
+    r_tri_smooth[i] = (mp->flag & ME_SMOOTH) != 0;
+  }
+}
+
 bool BKE_mesh_runtime_ensure_edit_data(struct Mesh *mesh)
 {
   if (mesh->runtime.edit_data != NULL) {
@@ -235,6 +488,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
     mesh->runtime.subdiv_ccg = NULL;
   }
   BKE_shrinkwrap_discard_boundary_data(mesh);
+  mesh_topology_cache_clear(mesh);
 }
 
 /** \} */
@@ -42,6 +42,7 @@
 #include "DNA_node_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_view3d_types.h"
 
 #include "BLI_utildefines.h"
@@ -370,13 +371,19 @@ static ImBuf *movieclip_load_sequence_file(MovieClip *clip,
 static void movieclip_open_anim_file(MovieClip *clip)
 {
   char str[FILE_MAX];
+  int flags;
 
   if (!clip->anim) {
     BLI_strncpy(str, clip->name, FILE_MAX);
     BLI_path_abs(str, ID_BLEND_PATH_FROM_GLOBAL(&clip->id));
 
     /* FIXME: make several stream accessible in image editor, too */
-    clip->anim = openanim(str, IB_rect, 0, clip->colorspace_settings.name);
+    flags = IB_rect | IB_animseekindex;
+    if (U.video_flag & USER_VIDEO_HW_DECODE) {
+      flags |= IB_animhwaccel;
+    }
+
+    clip->anim = openanim(str, flags, 0, clip->colorspace_settings.name);
 
     if (clip->anim) {
       if (clip->flag & MCLIP_USE_PROXY_CUSTOM_DIR) {
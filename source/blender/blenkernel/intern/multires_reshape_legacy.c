@@ -45,6 +45,8 @@
 
 #include "DEG_depsgraph_query.h"
 
+#include "opensubdiv_capi_type.h"
+
 static void multires_reshape_init_mmd(MultiresModifierData *reshape_mmd,
                                       const MultiresModifierData *mmd)
 {
@@ -185,25 +187,23 @@ static void multires_reshape_tangent_matrix_for_corner(const MPoly *coarse_poly,
   BKE_multires_construct_tangent_matrix(r_tangent_matrix, dPdu, dPdv, tangent_corner);
 }
 
-static void multires_reshape_vertex_from_final_data(MultiresReshapeContext *ctx,
-                                                    const int ptex_face_index,
-                                                    const float corner_u,
-                                                    const float corner_v,
-                                                    const int coarse_poly_index,
-                                                    const int coarse_corner,
-                                                    const float final_P[3],
-                                                    const float final_mask)
+/* Same as multires_reshape_vertex_from_final_data(), with the limit surface already evaluated. */
+static void multires_reshape_vertex_from_limit_and_final_data(MultiresReshapeContext *ctx,
+                                                              const float corner_u,
+                                                              const float corner_v,
+                                                              const int coarse_poly_index,
+                                                              const int coarse_corner,
+                                                              const float P[3],
+                                                              const float dPdu[3],
+                                                              const float dPdv[3],
+                                                              const float final_P[3],
+                                                              const float final_mask)
 {
-  Subdiv *subdiv = ctx->subdiv;
   const int grid_size = ctx->top_grid_size;
   const Mesh *coarse_mesh = ctx->coarse_mesh;
   const MPoly *coarse_mpoly = coarse_mesh->mpoly;
   const MPoly *coarse_poly = &coarse_mpoly[coarse_poly_index];
   const int loop_index = coarse_poly->loopstart + coarse_corner;
-  /* Evaluate limit surface. */
-  float P[3], dPdu[3], dPdv[3];
-  multires_reshape_sample_surface(
-      subdiv, coarse_poly, coarse_corner, corner_u, corner_v, ptex_face_index, P, dPdu, dPdv);
   /* Construct tangent matrix which matches orientation of the current
    * displacement grid. */
   float tangent_matrix[3][3], inv_tangent_matrix[3][3];
@@ -232,6 +232,39 @@ static void multires_reshape_vertex_from_final_data(MultiresReshapeContext *ctx,
   }
 }
 
+static void multires_reshape_vertex_from_final_data(MultiresReshapeContext *ctx,
+                                                    const int ptex_face_index,
+                                                    const float corner_u,
+                                                    const float corner_v,
+                                                    const int coarse_poly_index,
+                                                    const int coarse_corner,
+                                                    const float final_P[3],
+                                                    const float final_mask)
+{
+  const MPoly *coarse_poly = &ctx->coarse_mesh->mpoly[coarse_poly_index];
+  /* Evaluate limit surface. */
+  float P[3], dPdu[3], dPdv[3];
+  multires_reshape_sample_surface(ctx->subdiv,
+                                  coarse_poly,
+                                  coarse_corner,
+                                  corner_u,
+                                  corner_v,
+                                  ptex_face_index,
+                                  P,
+                                  dPdu,
+                                  dPdv);
+  multires_reshape_vertex_from_limit_and_final_data(ctx,
+                                                    corner_u,
+                                                    corner_v,
+                                                    coarse_poly_index,
+                                                    coarse_corner,
+                                                    P,
+                                                    dPdu,
+                                                    dPdv,
+                                                    final_P,
+                                                    final_mask);
+}
+
 /* =============================================================================
  * Helpers to propagate displacement to higher levels.
  */
@@ -311,38 +344,47 @@ static void multires_reshape_init_level_key(CCGKey *key,
   key->grid_bytes = key->elem_size * key->grid_area;
 }
 
-static void multires_reshape_store_original_grids(MultiresPropagateData *data)
+static void multires_reshape_store_original_grid_task(
+    void *__restrict userdata, const int grid_index, const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  const int num_grids = data->num_grids;
+  MultiresPropagateData *data = userdata;
   /* Original data to be backed up. */
   const MDisps *mdisps = data->mdisps;
   const GridPaintMask *grid_paint_mask = data->grid_paint_mask;
-  /* Allocate grids for backup. */
   CCGKey *orig_key = &data->reshape_level_key;
-  CCGElem **orig_grids_data = allocate_grids(orig_key, num_grids);
-  /* Fill in grids. */
+  CCGElem *orig_grid = data->orig_grids_data[grid_index];
+  /* Fill in grid. */
   const int orig_grid_size = data->reshape_grid_size;
   const int top_grid_size = data->top_grid_size;
   const int skip = (top_grid_size - 1) / (orig_grid_size - 1);
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    CCGElem *orig_grid = orig_grids_data[grid_index];
-    for (int y = 0; y < orig_grid_size; y++) {
-      const int top_y = y * skip;
-      for (int x = 0; x < orig_grid_size; x++) {
-        const int top_x = x * skip;
-        const int top_index = top_y * top_grid_size + top_x;
-        memcpy(CCG_grid_elem_co(orig_key, orig_grid, x, y),
-               mdisps[grid_index].disps[top_index],
-               sizeof(float) * 3);
-        if (orig_key->has_mask) {
-          *CCG_grid_elem_mask(
-              orig_key, orig_grid, x, y) = grid_paint_mask[grid_index].data[top_index];
-        }
+  for (int y = 0; y < orig_grid_size; y++) {
+    const int top_y = y * skip;
+    for (int x = 0; x < orig_grid_size; x++) {
+      const int top_x = x * skip;
+      const int top_index = top_y * top_grid_size + top_x;
+      memcpy(CCG_grid_elem_co(orig_key, orig_grid, x, y),
+             mdisps[grid_index].disps[top_index],
+             sizeof(float) * 3);
+      if (orig_key->has_mask) {
+        *CCG_grid_elem_mask(
+            orig_key, orig_grid, x, y) = grid_paint_mask[grid_index].data[top_index];
       }
     }
   }
-  /* Store in the context. */
-  data->orig_grids_data = orig_grids_data;
+}
+
+static void multires_reshape_store_original_grids(MultiresPropagateData *data)
+{
+  /* Allocate grids for backup, stored in the context. */
+  data->orig_grids_data = allocate_grids(&data->reshape_level_key, data->num_grids);
+  /* Fill in grids. */
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  BLI_task_parallel_range(0,
+                          data->num_grids,
+                          data,
+                          multires_reshape_store_original_grid_task,
+                          &parallel_range_settings);
 }
 
 static void multires_reshape_propagate_prepare(MultiresPropagateData *data,
@@ -389,9 +431,9 @@ static void multires_reshape_propagate_prepare_from_mmd(MultiresPropagateData *d
  * grids at top level (meaning, the result grids are only partially filled
  * in). */
 static void multires_reshape_calculate_delta(MultiresPropagateData *data,
-                                             CCGElem **delta_grids_data)
+                                             const int grid_index,
+                                             CCGElem *delta_grid)
 {
-  const int num_grids = data->num_grids;
   /* At this point those custom data layers has updated data for the
    * level we are propagating from. */
   const MDisps *mdisps = data->mdisps;
@@ -403,23 +445,20 @@ static void multires_reshape_calculate_delta(MultiresPropagateData *data,
   const int reshape_grid_size = data->reshape_grid_size;
   const int delta_grid_size = data->top_grid_size;
   const int skip = (top_grid_size - 1) / (reshape_grid_size - 1);
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    /*const*/ CCGElem *orig_grid = data->orig_grids_data[grid_index];
-    CCGElem *delta_grid = delta_grids_data[grid_index];
-    for (int y = 0; y < reshape_grid_size; y++) {
-      const int top_y = y * skip;
-      for (int x = 0; x < reshape_grid_size; x++) {
-        const int top_x = x * skip;
-        const int top_index = top_y * delta_grid_size + top_x;
-        sub_v3_v3v3(CCG_grid_elem_co(delta_level_key, delta_grid, top_x, top_y),
-                    mdisps[grid_index].disps[top_index],
-                    CCG_grid_elem_co(reshape_key, orig_grid, x, y));
-        if (delta_level_key->has_mask) {
-          const float old_mask_value = *CCG_grid_elem_mask(reshape_key, orig_grid, x, y);
-          const float new_mask_value = grid_paint_mask[grid_index].data[top_index];
-          *CCG_grid_elem_mask(delta_level_key, delta_grid, top_x, top_y) = new_mask_value -
-                                                                           old_mask_value;
-        }
+  /*const*/ CCGElem *orig_grid = data->orig_grids_data[grid_index];
+  for (int y = 0; y < reshape_grid_size; y++) {
+    const int top_y = y * skip;
+    for (int x = 0; x < reshape_grid_size; x++) {
+      const int top_x = x * skip;
+      const int top_index = top_y * delta_grid_size + top_x;
+      sub_v3_v3v3(CCG_grid_elem_co(delta_level_key, delta_grid, top_x, top_y),
+                  mdisps[grid_index].disps[top_index],
+                  CCG_grid_elem_co(reshape_key, orig_grid, x, y));
+      if (delta_level_key->has_mask) {
+        const float old_mask_value = *CCG_grid_elem_mask(reshape_key, orig_grid, x, y);
+        const float new_mask_value = grid_paint_mask[grid_index].data[top_index];
+        *CCG_grid_elem_mask(delta_level_key, delta_grid, top_x, top_y) = new_mask_value -
+                                                                         old_mask_value;
       }
     }
   }
@@ -524,22 +563,11 @@ BLI_INLINE void multires_reshape_propagate_and_smooth_delta_grid(MultiresPropaga
   }
 }
 
-/* Entry point to propagate+smooth. */
-static void multires_reshape_propagate_and_smooth_delta(MultiresPropagateData *data,
-                                                        CCGElem **delta_grids_data)
-{
-  const int num_grids = data->num_grids;
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    CCGElem *delta_grid = delta_grids_data[grid_index];
-    multires_reshape_propagate_and_smooth_delta_grid(data, delta_grid);
-  }
-}
-
 /* Apply smoothed deltas on the actual data layers. */
 static void multires_reshape_propagate_apply_delta(MultiresPropagateData *data,
-                                                   CCGElem **delta_grids_data)
+                                                   const int grid_index,
+                                                   CCGElem *delta_grid)
 {
-  const int num_grids = data->num_grids;
   /* At this point those custom data layers has updated data for the
    * level we are propagating from. */
   MDisps *mdisps = data->mdisps;
@@ -552,55 +580,63 @@ static void multires_reshape_propagate_apply_delta(MultiresPropagateData *data,
   const int skip = (top_grid_size - 1) / (orig_grid_size - 1);
   /* Restore grid values at the reshape level. Those values are to be changed
    * to the accommodate for the smooth delta. */
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    CCGElem *orig_grid = orig_grids_data[grid_index];
-    for (int y = 0; y < orig_grid_size; y++) {
-      const int top_y = y * skip;
-      for (int x = 0; x < orig_grid_size; x++) {
-        const int top_x = x * skip;
-        const int top_index = top_y * top_grid_size + top_x;
-        copy_v3_v3(mdisps[grid_index].disps[top_index],
-                   CCG_grid_elem_co(orig_key, orig_grid, x, y));
-        if (grid_paint_mask != NULL) {
-          grid_paint_mask[grid_index].data[top_index] = *CCG_grid_elem_mask(
-              orig_key, orig_grid, x, y);
-        }
+  CCGElem *orig_grid = orig_grids_data[grid_index];
+  for (int y = 0; y < orig_grid_size; y++) {
+    const int top_y = y * skip;
+    for (int x = 0; x < orig_grid_size; x++) {
+      const int top_x = x * skip;
+      const int top_index = top_y * top_grid_size + top_x;
+      copy_v3_v3(mdisps[grid_index].disps[top_index],
+                 CCG_grid_elem_co(orig_key, orig_grid, x, y));
+      if (grid_paint_mask != NULL) {
+        grid_paint_mask[grid_index].data[top_index] = *CCG_grid_elem_mask(
+            orig_key, orig_grid, x, y);
       }
     }
   }
   /* Add smoothed delta to all the levels. */
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    CCGElem *delta_grid = delta_grids_data[grid_index];
-    for (int y = 0; y < top_grid_size; y++) {
-      for (int x = 0; x < top_grid_size; x++) {
-        const int top_index = y * top_grid_size + x;
-        add_v3_v3(mdisps[grid_index].disps[top_index],
-                  CCG_grid_elem_co(delta_level_key, delta_grid, x, y));
-        if (delta_level_key->has_mask) {
-          grid_paint_mask[grid_index].data[top_index] += *CCG_grid_elem_mask(
-              delta_level_key, delta_grid, x, y);
-        }
+  for (int y = 0; y < top_grid_size; y++) {
+    for (int x = 0; x < top_grid_size; x++) {
+      const int top_index = y * top_grid_size + x;
+      add_v3_v3(mdisps[grid_index].disps[top_index],
+                CCG_grid_elem_co(delta_level_key, delta_grid, x, y));
+      if (delta_level_key->has_mask) {
+        grid_paint_mask[grid_index].data[top_index] += *CCG_grid_elem_mask(
+            delta_level_key, delta_grid, x, y);
       }
     }
   }
 }
 
-static void multires_reshape_propagate(MultiresPropagateData *data)
+/* Grids are independent from each other, so every grid is propagated on its own, using a single
+ * delta grid at the top level instead of keeping deltas of all grids around. */
+static void multires_reshape_propagate_grid_task(void *__restrict userdata,
+                                                 const int grid_index,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  if (data->reshape_level == data->top_level) {
-    return;
-  }
-  const int num_grids = data->num_grids;
-  /* Calculate delta made at the reshape level. */
+  MultiresPropagateData *data = userdata;
   CCGKey *delta_level_key = &data->top_level_key;
-  CCGElem **delta_grids_data = allocate_grids(delta_level_key, num_grids);
-  multires_reshape_calculate_delta(data, delta_grids_data);
+  CCGElem *delta_grid = MEM_calloc_arrayN(
+      delta_level_key->elem_size, delta_level_key->grid_area, "reshape delta grid elems");
+  /* Calculate delta made at the reshape level. */
+  multires_reshape_calculate_delta(data, grid_index, delta_grid);
   /* Propagate deltas to the higher levels. */
-  multires_reshape_propagate_and_smooth_delta(data, delta_grids_data);
+  multires_reshape_propagate_and_smooth_delta_grid(data, delta_grid);
   /* Finally, apply smoothed deltas. */
-  multires_reshape_propagate_apply_delta(data, delta_grids_data);
+  multires_reshape_propagate_apply_delta(data, grid_index, delta_grid);
   /* Cleanup. */
-  free_grids(delta_grids_data, num_grids);
+  MEM_freeN(delta_grid);
+}
+
+static void multires_reshape_propagate(MultiresPropagateData *data)
+{
+  if (data->reshape_level == data->top_level) {
+    return;
+  }
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  BLI_task_parallel_range(
+      0, data->num_grids, data, multires_reshape_propagate_grid_task, &parallel_range_settings);
 }
 
 static void multires_reshape_propagate_free(MultiresPropagateData *data)
@@ -966,17 +1002,34 @@ static void reshape_from_ccg_task(void *__restrict userdata,
   const int key_grid_size = key->grid_size;
   const int key_grid_size_1 = key_grid_size - 1;
   const int resolution = key_grid_size;
+  const int resolution_area = resolution * resolution;
   const float resolution_1_inv = 1.0f / (float)(resolution - 1);
   const int start_ptex_face_index = data->reshape_ctx.face_ptex_offset[coarse_poly_index];
   const bool is_quad = (coarse_poly->totloop == 4);
+  /* Limit surface of a whole corner grid is evaluated at once. */
+  OpenSubdiv_PatchCoord *patch_coords = MEM_malloc_arrayN(
+      resolution_area, sizeof(*patch_coords), "reshape patch coords");
+  float(*P)[3] = MEM_malloc_arrayN(resolution_area, sizeof(*P), "reshape limit P");
+  float(*dPdu)[3] = MEM_malloc_arrayN(resolution_area, sizeof(*dPdu), "reshape limit dPdu");
+  float(*dPdv)[3] = MEM_malloc_arrayN(resolution_area, sizeof(*dPdv), "reshape limit dPdv");
   for (int corner = 0; corner < coarse_poly->totloop; corner++) {
-    for (int y = 0; y < resolution; y++) {
+    /* Quad faces consists of a single ptex face. */
+    const int ptex_face_index = is_quad ? start_ptex_face_index : start_ptex_face_index + corner;
+    for (int y = 0, i = 0; y < resolution; y++) {
+      const float corner_v = y * resolution_1_inv;
+      for (int x = 0; x < resolution; x++, i++) {
+        const float corner_u = x * resolution_1_inv;
+        patch_coords[i].ptex_face = ptex_face_index;
+        multires_reshape_corner_coord_to_ptex(
+            coarse_poly, corner, corner_u, corner_v, &patch_coords[i].u, &patch_coords[i].v);
+      }
+    }
+    BKE_subdiv_eval_limit_points_and_derivatives(
+        data->reshape_ctx.subdiv, patch_coords, resolution_area, P, dPdu, dPdv);
+    for (int y = 0, i = 0; y < resolution; y++) {
       const float corner_v = y * resolution_1_inv;
-      for (int x = 0; x < resolution; x++) {
+      for (int x = 0; x < resolution; x++, i++) {
         const float corner_u = x * resolution_1_inv;
-        /* Quad faces consists of a single ptex face. */
-        const int ptex_face_index = is_quad ? start_ptex_face_index :
-                                              start_ptex_face_index + corner;
         float grid_u, grid_v;
         BKE_subdiv_ptex_face_uv_to_grid_uv(corner_u, corner_v, &grid_u, &grid_v);
         /*const*/ CCGElem *grid = grids[coarse_poly->loopstart + corner];
@@ -987,17 +1040,23 @@ static void reshape_from_ccg_task(void *__restrict userdata,
         if (key->has_mask) {
           final_mask = *CCG_elem_mask(key, grid_element);
         }
-        multires_reshape_vertex_from_final_data(&data->reshape_ctx,
-                                                ptex_face_index,
-                                                corner_u,
-                                                corner_v,
-                                                coarse_poly_index,
-                                                corner,
-                                                final_P,
-                                                final_mask);
+        multires_reshape_vertex_from_limit_and_final_data(&data->reshape_ctx,
+                                                          corner_u,
+                                                          corner_v,
+                                                          coarse_poly_index,
+                                                          corner,
+                                                          P[i],
+                                                          dPdu[i],
+                                                          dPdv[i],
+                                                          final_P,
+                                                          final_mask);
       }
     }
   }
+  MEM_freeN(patch_coords);
+  MEM_freeN(P);
+  MEM_freeN(dPdu);
+  MEM_freeN(dPdv);
 }
 
 bool multiresModifier_reshapeFromCCG(const int tot_level, Mesh *coarse_mesh, SubdivCCG *subdiv_ccg)
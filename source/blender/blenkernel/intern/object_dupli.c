@@ -28,6 +28,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_memarena.h"
 #include "BLI_string_utf8.h"
 
 #include "BLI_math.h"
@@ -64,6 +65,15 @@
 
 /* Dupli-Geometry */
 
+/**
+ * Container of the list returned by #object_duplilist, the list must stay the first member.
+ * Dupli objects are allocated from an arena, instancers can generate a very large amount of them.
+ */
+typedef struct DupliList {
+  ListBase list;
+  MemArena *arena;
+} DupliList;
+
 typedef struct DupliContext {
   Depsgraph *depsgraph;
   /** XXX child objects are selected from this group if set, could be nicer. */
@@ -82,7 +92,7 @@ typedef struct DupliContext {
   const struct DupliGenerator *gen;
 
   /** Result containers. */
-  ListBase *duplilist; /* legacy doubly-linked list */
+  DupliList *duplilist; /* legacy doubly-linked list */
 } DupliContext;
 
 typedef struct DupliGenerator {
@@ -151,8 +161,12 @@ static DupliObject *make_dupli(const DupliContext *ctx, Object *ob, float mat[4]
 
   /* add a DupliObject instance to the result container */
   if (ctx->duplilist) {
-    dob = MEM_callocN(sizeof(DupliObject), "dupli object");
-    BLI_addtail(ctx->duplilist, dob);
+    DupliList *duplilist = ctx->duplilist;
+    if (duplilist->arena == NULL) {
+      duplilist->arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+    }
+    dob = BLI_memarena_calloc(duplilist->arena, sizeof(DupliObject));
+    BLI_addtail(&duplilist->list, dob);
   }
   else {
     return NULL;
@@ -1124,7 +1138,7 @@ static const DupliGenerator *get_dupli_generator(const DupliContext *ctx)
 /* Returns a list of DupliObject */
 ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
 {
-  ListBase *duplilist = MEM_callocN(sizeof(ListBase), "duplilist");
+  DupliList *duplilist = MEM_callocN(sizeof(DupliList), "duplilist");
   DupliContext ctx;
   init_context(&ctx, depsgraph, sce, ob, NULL);
   if (ctx.gen) {
@@ -1132,11 +1146,14 @@ ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
     ctx.gen->make_duplis(&ctx);
   }
 
-  return duplilist;
+  return &duplilist->list;
 }
 
 void free_object_duplilist(ListBase *lb)
 {
-  BLI_freelistN(lb);
-  MEM_freeN(lb);
+  DupliList *duplilist = (DupliList *)lb;
+  if (duplilist->arena != NULL) {
+    BLI_memarena_free(duplilist->arena);
+  }
+  MEM_freeN(duplilist);
 }
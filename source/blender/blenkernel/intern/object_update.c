@@ -119,23 +119,23 @@ void BKE_object_eval_parent(Depsgraph *depsgraph, Object *ob)
 
 void BKE_object_eval_constraints(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
-  bConstraintOb *cob;
+  bConstraintOb cob;
   float ctime = BKE_scene_frame_get(scene);
 
   DEG_debug_print_eval(depsgraph, __func__, ob->id.name, ob);
 
   /* evaluate constraints stack */
   /* TODO: split this into:
-   * - pre (i.e. BKE_constraints_make_evalob, per-constraint (i.e.
+   * - pre (i.e. BKE_constraints_init_evalob, per-constraint (i.e.
    * - inner body of BKE_constraints_solve),
-   * - post (i.e. BKE_constraints_clear_evalob)
+   * - post (i.e. BKE_constraints_apply_evalob)
    *
    * Not sure why, this is from Joshua - sergey
    *
    */
-  cob = BKE_constraints_make_evalob(depsgraph, scene, ob, NULL, CONSTRAINT_OBTYPE_OBJECT);
-  BKE_constraints_solve(depsgraph, &ob->constraints, cob, ctime);
-  BKE_constraints_clear_evalob(cob);
+  BKE_constraints_init_evalob(&cob, depsgraph, scene, ob, NULL, CONSTRAINT_OBTYPE_OBJECT);
+  BKE_constraints_solve(depsgraph, &ob->constraints, &cob, ctime);
+  BKE_constraints_apply_evalob(&cob);
 }
 
 void BKE_object_eval_transform_final(Depsgraph *depsgraph, Object *ob)
@@ -334,11 +334,47 @@ void BKE_object_eval_uber_transform(Depsgraph *depsgraph, Object *object)
   BKE_object_eval_proxy_copy(depsgraph, object);
 }
 
+/**
+ * Check whether only the vertex coordinates changed since the last update
+ * (edit-mesh transform or deform-only playback),
+ * in which case the draw cache can keep the buffers that only depend on topology.
+ */
+static bool object_batch_cache_is_deform_update(Mesh *me)
+{
+  /* Batch cache moved over from the previous evaluated mesh, see #mesh_build_data. */
+  if (me->runtime.is_deform_update) {
+    me->runtime.is_deform_update = false;
+    return true;
+  }
+
+  BMEditMesh *em = me->edit_mesh;
+  if (em == NULL || !em->is_deform_update) {
+    return false;
+  }
+  /* The flag is only meaningful for a single update. */
+  em->is_deform_update = false;
+
+  /* Generative modifiers may change the topology of the evaluated mesh. */
+  const Mesh *me_eval[2] = {em->mesh_eval_final, em->mesh_eval_cage};
+  for (int i = 0; i < ARRAY_SIZE(me_eval); i++) {
+    if (me_eval[i] == NULL) {
+      continue;
+    }
+    if (!(me_eval[i]->runtime.is_original || me_eval[i]->runtime.deformed_only)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void BKE_object_batch_cache_dirty_tag(Object *ob)
 {
   switch (ob->type) {
     case OB_MESH:
-      BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_ALL);
+      BKE_mesh_batch_cache_dirty_tag(ob->data,
+                                     object_batch_cache_is_deform_update(ob->data) ?
+                                         BKE_MESH_BATCH_DIRTY_DEFORM :
+                                         BKE_MESH_BATCH_DIRTY_ALL);
       break;
     case OB_LATTICE:
       BKE_lattice_batch_cache_dirty_tag(ob->data, BKE_LATTICE_BATCH_DIRTY_ALL);
@@ -2333,10 +2333,34 @@ void psys_find_parents(ParticleSimulationData *sim, const bool use_render_params
 
   BLI_kdtree_3d_balance(tree);
 
-  for (; p < totchild; p++, cpa++) {
-    psys_particle_on_emitter(
-        sim->psmd, from, cpa->num, DMCACHE_ISCHILD, cpa->fuv, cpa->foffset, co, 0, 0, 0, orco);
-    cpa->parent = BLI_kdtree_3d_find_nearest(tree, orco, NULL);
+  if (p < totchild) {
+    /* Look up all children at once, which is much faster than one by one. */
+    const int orcos_len = totchild - p;
+    float(*orcos)[3] = MEM_mallocN(sizeof(*orcos) * (size_t)orcos_len, __func__);
+    KDTreeNearest_3d *nearest = MEM_mallocN(sizeof(*nearest) * (size_t)orcos_len, __func__);
+
+    for (int i = 0; i < orcos_len; i++) {
+      psys_particle_on_emitter(sim->psmd,
+                               from,
+                               cpa[i].num,
+                               DMCACHE_ISCHILD,
+                               cpa[i].fuv,
+                               cpa[i].foffset,
+                               co,
+                               0,
+                               0,
+                               0,
+                               orcos[i]);
+    }
+
+    BLI_kdtree_3d_find_nearest_batch(tree, orcos, (uint)orcos_len, nearest);
+
+    for (int i = 0; i < orcos_len; i++) {
+      cpa[i].parent = nearest[i].index;
+    }
+
+    MEM_freeN(orcos);
+    MEM_freeN(nearest);
   }
 
   BLI_kdtree_3d_free(tree);
@@ -2457,6 +2481,8 @@ static void psys_task_init_path(ParticleTask *task, ParticleSimulationData *sim)
 
 /* note: this function must be thread safe, except for branching! */
 static void psys_thread_create_path(ParticleTask *task,
+                                    PTCacheEdit *edit,
+                                    ParticleCacheKey **pcache,
                                     struct ChildParticle *cpa,
                                     ParticleCacheKey *child_keys,
                                     int i)
@@ -2466,10 +2492,6 @@ static void psys_thread_create_path(ParticleTask *task,
   ParticleSystem *psys = ctx->sim.psys;
   ParticleSettings *part = psys->part;
   ParticleCacheKey **cache = psys->childcache;
-  PTCacheEdit *edit = psys_orig_edit_get(psys);
-  ParticleCacheKey **pcache = psys_in_edit_mode(ctx->sim.depsgraph, psys) && edit ?
-                                  edit->pathcache :
-                                  psys->pathcache;
   ParticleCacheKey *child, *key[4];
   ParticleTexture ptex;
   float *cpa_fuv = 0, *par_rot = 0, rot[4];
@@ -2800,10 +2822,16 @@ static void exec_child_path_cache(TaskPool *__restrict UNUSED(pool),
   ChildParticle *cpa;
   int i;
 
+  /* Same for all children, look it up once per task. */
+  PTCacheEdit *edit = psys_orig_edit_get(psys);
+  ParticleCacheKey **pcache = psys_in_edit_mode(ctx->sim.depsgraph, psys) && edit ?
+                                  edit->pathcache :
+                                  psys->pathcache;
+
   cpa = psys->child + task->begin;
   for (i = task->begin; i < task->end; i++, cpa++) {
     BLI_assert(i < psys->totchildcache);
-    psys_thread_create_path(task, cpa, cache[i], i);
+    psys_thread_create_path(task, edit, pcache, cpa, cache[i], i);
   }
 }
 
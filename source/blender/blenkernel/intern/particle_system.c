@@ -1699,23 +1699,28 @@ static void sph_evaluate_func(BVHTree *tree,
 
   pfr->tot_neighbors = 0;
 
+  if (tree) {
+    pfr->npsys = psys[0];
+    pfr->massfac = psys[0]->part->mass / pfr->mass;
+    pfr->use_size = psys[0]->part->flag & PART_SIZEMASS;
+
+    BLI_bvhtree_range_query(tree, co, interaction_radius, callback, pfr);
+    return;
+  }
+
+  /* This runs for every particle from all threads,
+   * take the lock once for all systems rather than for each of them. */
+  BLI_rw_mutex_lock(&psys_bvhtree_rwlock, THREAD_LOCK_READ);
+
   for (i = 0; i < 10 && psys[i]; i++) {
     pfr->npsys = psys[i];
     pfr->massfac = psys[i]->part->mass / pfr->mass;
     pfr->use_size = psys[i]->part->flag & PART_SIZEMASS;
 
-    if (tree) {
-      BLI_bvhtree_range_query(tree, co, interaction_radius, callback, pfr);
-      break;
-    }
-    else {
-      BLI_rw_mutex_lock(&psys_bvhtree_rwlock, THREAD_LOCK_READ);
-
-      BLI_bvhtree_range_query(psys[i]->bvhtree, co, interaction_radius, callback, pfr);
-
-      BLI_rw_mutex_unlock(&psys_bvhtree_rwlock);
-    }
+    BLI_bvhtree_range_query(psys[i]->bvhtree, co, interaction_radius, callback, pfr);
   }
+
+  BLI_rw_mutex_unlock(&psys_bvhtree_rwlock);
 }
 static void sph_density_accum_cb(void *userdata, int index, const float co[3], float squared_dist)
 {
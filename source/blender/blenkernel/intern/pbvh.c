@@ -55,6 +55,10 @@
 
 #define STACK_FIXED_DEPTH 100
 
+/* Any of the flags requesting an update of the draw buffers. */
+#define PBVH_UpdateDrawBuffersAny \
+  (PBVH_UpdateDrawBuffers | PBVH_UpdateDrawMask | PBVH_UpdateDrawColor)
+
 typedef struct PBVHStack {
   PBVHNode *node;
   bool revisiting;
@@ -254,7 +258,9 @@ void pbvh_grow_nodes(PBVH *bvh, int totnode)
 }
 
 /* Add a vertex to the map, with a positive value for unique vertices and
- * a negative value for additional vertices */
+ * a negative value for additional vertices.
+ *
+ * Leaves are built in parallel, the first leaf to claim a vertex in the bitmap owns it. */
 static int map_insert_vert(
     PBVH *bvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
 {
@@ -263,8 +269,7 @@ static int map_insert_vert(
   key = POINTER_FROM_INT(vertex);
   if (!BLI_ghash_ensure_p(map, key, &value_p)) {
     int value_i;
-    if (BLI_BITMAP_TEST(bvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(bvh->vert_bitmap, vertex);
+    if (BLI_BITMAP_TEST_AND_SET_ATOMIC(bvh->vert_bitmap, vertex) == 0) {
       value_i = *uniq_verts;
       (*uniq_verts)++;
     }
@@ -391,6 +396,7 @@ static void build_grid_leaf_node(PBVH *bvh, PBVHNode *node)
   BKE_pbvh_node_mark_rebuild_draw(node);
 }
 
+/* Vertex maps and visibility of the leaves are computed afterwards by #build_leaves. */
 static void build_leaf(PBVH *bvh, int node_index, BBC *prim_bbc, int offset, int count)
 {
   bvh->nodes[node_index].flag |= PBVH_Leaf;
@@ -400,15 +406,32 @@ static void build_leaf(PBVH *bvh, int node_index, BBC *prim_bbc, int offset, int
 
   /* Still need vb for searches */
   update_vb(bvh, &bvh->nodes[node_index], prim_bbc, offset, count);
+}
 
+static void build_leaves_task_cb(void *__restrict userdata,
+                                 const int n,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVH *bvh = userdata;
+  PBVHNode *node = &bvh->nodes[n];
+  if (!(node->flag & PBVH_Leaf)) {
+    return;
+  }
   if (bvh->looptri) {
-    build_mesh_leaf_node(bvh, bvh->nodes + node_index);
+    build_mesh_leaf_node(bvh, node);
   }
   else {
-    build_grid_leaf_node(bvh, bvh->nodes + node_index);
+    build_grid_leaf_node(bvh, node);
   }
 }
 
+static void build_leaves(PBVH *bvh)
+{
+  PBVHParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, bvh->totnode);
+  BKE_pbvh_parallel_range(0, bvh->totnode, bvh, build_leaves_task_cb, &settings);
+}
+
 /* Return zero if all primitives in the node can be drawn with the
  * same material (including flat/smooth shading), non-zero otherwise */
 static bool leaf_needs_material_split(PBVH *bvh, int offset, int count)
@@ -528,6 +551,41 @@ static void pbvh_build(PBVH *bvh, BB *cb, BBC *prim_bbc, int totprim)
 
   bvh->totnode = 1;
   build_sub(bvh, 0, cb, prim_bbc, 0, totprim);
+  build_leaves(bvh);
+}
+
+typedef struct PBVHBuildBBCData {
+  PBVH *bvh;
+  BBC *prim_bbc;
+} PBVHBuildBBCData;
+
+static void pbvh_build_mesh_bbc_task_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict tls)
+{
+  PBVHBuildBBCData *data = userdata;
+  PBVH *bvh = data->bvh;
+  const MLoopTri *lt = &bvh->looptri[i];
+  const int sides = 3;
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  for (int j = 0; j < sides; j++) {
+    BB_expand((BB *)bbc, bvh->verts[bvh->mloop[lt->tri[j]].v].co);
+  }
+
+  BBC_update_centroid(bbc);
+
+  /* Bounding box of all centroids. */
+  BB_expand((BB *)tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void pbvh_build_mesh_bbc_reduce(const void *__restrict UNUSED(userdata),
+                                       void *__restrict chunk_join,
+                                       void *__restrict chunk)
+{
+  BB_expand_with_bb((BB *)chunk_join, (BB *)chunk);
 }
 
 /**
@@ -572,21 +630,16 @@ void BKE_pbvh_build_mesh(PBVH *bvh,
   /* For each face, store the AABB and the AABB centroid */
   prim_bbc = MEM_mallocN(sizeof(BBC) * looptri_num, "prim_bbc");
 
-  for (int i = 0; i < looptri_num; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const int sides = 3;
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < sides; j++) {
-      BB_expand((BB *)bbc, verts[bvh->mloop[lt->tri[j]].v].co);
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  PBVHBuildBBCData data = {
+      .bvh = bvh,
+      .prim_bbc = prim_bbc,
+  };
+  PBVHParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, looptri_num > LEAF_LIMIT, looptri_num);
+  settings.userdata_chunk = &cb;
+  settings.userdata_chunk_size = sizeof(cb);
+  settings.func_reduce = pbvh_build_mesh_bbc_reduce;
+  BKE_pbvh_parallel_range(0, looptri_num, &data, pbvh_build_mesh_bbc_task_cb, &settings);
 
   if (looptri_num) {
     pbvh_build(bvh, &cb, prim_bbc, looptri_num);
@@ -1240,12 +1293,19 @@ void pbvh_update_BB_redraw(PBVH *bvh, PBVHNode **nodes, int totnode, int flag)
   BKE_pbvh_parallel_range(0, totnode, &data, pbvh_update_BB_redraw_task_cb, &settings);
 }
 
-static int pbvh_get_buffers_update_flags(PBVH *bvh, bool show_vcol)
+static int pbvh_get_buffers_update_flags(PBVH *bvh, PBVHNode *node, bool show_vcol)
 {
   int update_flags = 0;
   update_flags |= bvh->show_mask ? GPU_PBVH_BUFFERS_SHOW_MASK : 0;
   update_flags |= show_vcol ? GPU_PBVH_BUFFERS_SHOW_VCOL : 0;
   update_flags |= bvh->show_face_sets ? GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS : 0;
+
+  if (node->flag & PBVH_UpdateDrawBuffers) {
+    update_flags |= GPU_PBVH_BUFFERS_UPDATE_COORDS | GPU_PBVH_BUFFERS_UPDATE_MASK |
+                    GPU_PBVH_BUFFERS_UPDATE_COLOR;
+  }
+  update_flags |= (node->flag & PBVH_UpdateDrawMask) ? GPU_PBVH_BUFFERS_UPDATE_MASK : 0;
+  update_flags |= (node->flag & PBVH_UpdateDrawColor) ? GPU_PBVH_BUFFERS_UPDATE_COLOR : 0;
   return update_flags;
 }
 
@@ -1284,8 +1344,8 @@ static void pbvh_update_draw_buffer_cb(void *__restrict userdata,
     }
   }
 
-  if (node->flag & PBVH_UpdateDrawBuffers) {
-    const int update_flags = pbvh_get_buffers_update_flags(bvh, data->show_vcol);
+  if (node->flag & PBVH_UpdateDrawBuffersAny) {
+    const int update_flags = pbvh_get_buffers_update_flags(bvh, node, data->show_vcol);
     switch (bvh->type) {
       case PBVH_GRIDS:
         GPU_pbvh_grid_buffers_update(node->draw_buffers,
@@ -1332,7 +1392,7 @@ static void pbvh_update_draw_buffers(
         GPU_pbvh_buffers_free(node->draw_buffers);
         node->draw_buffers = NULL;
       }
-      else if ((node->flag & PBVH_UpdateDrawBuffers) && node->draw_buffers) {
+      else if ((node->flag & PBVH_UpdateDrawBuffersAny) && node->draw_buffers) {
         if (bvh->type == PBVH_GRIDS) {
           GPU_pbvh_grid_buffers_update_free(
               node->draw_buffers, bvh->grid_flag_mats, node->prim_indices);
@@ -1704,7 +1764,12 @@ void BKE_pbvh_node_mark_update(PBVHNode *node)
 
 void BKE_pbvh_node_mark_update_mask(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawMask | PBVH_UpdateRedraw;
+}
+
+void BKE_pbvh_node_mark_update_color(PBVHNode *node)
+{
+  node->flag |= PBVH_UpdateDrawColor | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_visibility(PBVHNode *node)
@@ -2653,7 +2718,7 @@ void BKE_pbvh_draw_cb(PBVH *bvh,
   PBVHNode **nodes;
   int totnode;
 
-  const int update_flag = PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers;
+  const int update_flag = PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffersAny;
 
   if (!update_only_visible) {
     /* Update all draw buffers, also those outside the view. */
@@ -2679,12 +2744,12 @@ void BKE_pbvh_draw_cb(PBVH *bvh,
   for (int a = 0; a < totnode; a++) {
     PBVHNode *node = nodes[a];
 
-    if (node->flag & PBVH_UpdateDrawBuffers) {
+    if (node->flag & PBVH_UpdateDrawBuffersAny) {
       /* Flush buffers uses OpenGL, so not in parallel. */
       GPU_pbvh_buffers_update_flush(node->draw_buffers);
     }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffersAny);
 
     if (!(node->flag & PBVH_FullyHidden)) {
       draw_fn(user_data, node->draw_buffers);
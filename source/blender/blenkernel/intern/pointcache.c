@@ -2052,6 +2052,10 @@ static int ptcache_frame_from_filename(const char *filename, const char *ext)
 #define MAX_PTCACHE_PATH FILE_MAX
 #define MAX_PTCACHE_FILE (FILE_MAX * 2)
 
+/* Cache files are read and written in small pieces (per point for uncompressed caches),
+ * a larger stdio buffer saves many system calls, which matters most on network storage. */
+#define PTCACHE_FILE_BUFFER_SIZE (1 << 18)
+
 static int ptcache_path(PTCacheID *pid, char *filename)
 {
   Library *lib = (pid->ob) ? pid->ob->id.lib : NULL;
@@ -2191,6 +2195,8 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
     return NULL;
   }
 
+  setvbuf(fp, NULL, _IOFBF, PTCACHE_FILE_BUFFER_SIZE);
+
   pf = MEM_mallocN(sizeof(PTCacheFile), "PTCacheFile");
   pf->fp = fp;
   pf->old_format = 0;
@@ -1562,8 +1562,16 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(
-    Depsgraph *depsgraph, Scene *scene, RigidBodyWorld *rbw, Object *ob, RigidBodyOb *rbo)
+/**
+ * \param effectors: Effectors of the world, shared by all bodies since no body
+ * that receives forces can be an effector itself (may be NULL).
+ */
+static void rigidbody_update_sim_ob(Scene *scene,
+                                    RigidBodyWorld *rbw,
+                                    ViewLayer *view_layer,
+                                    ListBase *effectors,
+                                    Object *ob,
+                                    RigidBodyOb *rbo)
 {
   float loc[3];
   float rot[4];
@@ -1574,7 +1582,6 @@ static void rigidbody_update_sim_ob(
     return;
   }
 
-  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
   Base *base = BKE_view_layer_base_find(view_layer, ob);
   const bool is_selected = base ? (base->flag & BASE_SELECTED) != 0 : false;
 
@@ -1620,12 +1627,8 @@ static void rigidbody_update_sim_ob(
   /* only dynamic bodies need effector update */
   else if (rbo->type == RBO_TYPE_ACTIVE &&
            ((ob->pd == NULL) || (ob->pd->forcefield == PFIELD_NULL))) {
-    EffectorWeights *effector_weights = rbw->effector_weights;
     EffectedPoint epoint;
-    ListBase *effectors;
 
-    /* get effectors present in the group specified by effector_weights */
-    effectors = BKE_effectors_create(depsgraph, ob, NULL, effector_weights);
     if (effectors) {
       float eff_force[3] = {0.0f, 0.0f, 0.0f};
       float eff_loc[3], eff_vel[3];
@@ -1641,7 +1644,7 @@ static void rigidbody_update_sim_ob(
       /* Calculate net force of effectors, and apply to sim object:
        * - we use 'central force' since apply force requires a "relative position"
        *   which we don't have... */
-      BKE_effectors_apply(effectors, NULL, effector_weights, &epoint, eff_force, NULL);
+      BKE_effectors_apply(effectors, NULL, rbw->effector_weights, &epoint, eff_force, NULL);
       if (G.f & G_DEBUG) {
         printf("\tapplying force (%f,%f,%f) to '%s'\n",
                eff_force[0],
@@ -1658,9 +1661,6 @@ static void rigidbody_update_sim_ob(
     else if (G.f & G_DEBUG) {
       printf("\tno forces to apply to '%s'\n", ob->id.name + 2);
     }
-
-    /* cleanup */
-    BKE_effectors_free(effectors);
   }
   /* NOTE: passive objects don't need to be updated since they don't move */
 
@@ -1756,13 +1756,24 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
         }
       }
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
-
-      /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo);
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  /* Update simulation objects in a second pass, once all transforms are up to date.
+   * The effectors are gathered once here instead of for every body. */
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+  ListBase *effectors = BKE_effectors_create(depsgraph, NULL, NULL, rbw->effector_weights);
+
+  for (int i = 0; i < rbw->numbodies; i++) {
+    Object *ob = rbw->objects[i];
+    if (ob && ob->type == OB_MESH && ob->rigidbody_object) {
+      rigidbody_update_sim_ob(scene, rbw, view_layer, effectors, ob, ob->rigidbody_object);
+    }
+  }
+
+  BKE_effectors_free(effectors);
+
   /* update constraints */
   if (rbw->constraints == NULL) { /* no constraints, move on */
     return;
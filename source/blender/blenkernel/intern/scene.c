@@ -1359,7 +1359,9 @@ void BKE_scene_graph_evaluated_ensure(Depsgraph *depsgraph, Main *bmain)
 }
 
 /* applies changes right away, does all sets too */
-void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph, Main *bmain)
+void BKE_scene_graph_update_for_newframe_ex(Depsgraph *depsgraph,
+                                            Main *bmain,
+                                            const bool clear_recalc)
 {
   Scene *scene = DEG_get_input_scene(depsgraph);
   ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
@@ -1405,7 +1407,9 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph, Main *bmain)
     /* Inform editors about possible changes. */
     DEG_ids_check_recalc(bmain, depsgraph, scene, view_layer, true);
     /* clear recalc flags */
-    DEG_ids_clear_recalc(bmain, depsgraph);
+    if (clear_recalc) {
+      DEG_ids_clear_recalc(bmain, depsgraph);
+    }
 
     /* If user callback did not tag anything for update we can skip second iteration.
      * Otherwise we update scene once again, but without running callbacks to bring
@@ -1416,6 +1420,11 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph, Main *bmain)
   }
 }
 
+void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph, Main *bmain)
+{
+  BKE_scene_graph_update_for_newframe_ex(depsgraph, bmain, true);
+}
+
 /**
  * Ensures given scene/view_layer pair has a valid, up-to-date depsgraph.
  *
@@ -2100,6 +2109,89 @@ Depsgraph *BKE_scene_get_depsgraph(Main *bmain, Scene *scene, ViewLayer *view_la
   return depsgraph;
 }
 
+/* Undo re-allocates scenes and view layers, so depsgraphs are identified by names meanwhile. */
+static void scene_undo_depsgraph_key_get(const Scene *scene,
+                                         const ViewLayer *view_layer,
+                                         char r_key[MAX_ID_NAME + MAX_NAME + 1])
+{
+  BLI_snprintf(r_key, MAX_ID_NAME + MAX_NAME + 1, "%s\t%s", scene->id.name, view_layer->name);
+}
+
+/**
+ * Take ownership of the depsgraphs of all local scenes before undo frees them with the old Main,
+ * so evaluated copies of the data-blocks which undo keeps unchanged can be re-used.
+ */
+GHash *BKE_scene_undo_depsgraphs_extract(Main *bmain)
+{
+  GHash *depsgraph_extract = BLI_ghash_str_new(__func__);
+
+  LISTBASE_FOREACH (Scene *, scene, &bmain->scenes) {
+    if (scene->depsgraph_hash == NULL || ID_IS_LINKED(scene)) {
+      continue;
+    }
+    LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
+      DepsgraphKey key;
+      key.view_layer = view_layer;
+      Depsgraph *depsgraph = BLI_ghash_popkey(scene->depsgraph_hash, &key, depsgraph_key_free);
+      if (depsgraph == NULL) {
+        continue;
+      }
+      char key_full[MAX_ID_NAME + MAX_NAME + 1];
+      scene_undo_depsgraph_key_get(scene, view_layer, key_full);
+      BLI_ghash_insert(depsgraph_extract, BLI_strdup(key_full), depsgraph);
+    }
+  }
+
+  return depsgraph_extract;
+}
+
+/**
+ * Give the depsgraphs taken by #BKE_scene_undo_depsgraphs_extract to the matching scenes and
+ * view layers of the new \a bmain, and free the ones which are not used anymore.
+ * Relations are rebuilt immediately, since the graphs still reference the freed data-blocks.
+ */
+void BKE_scene_undo_depsgraphs_restore(Main *bmain, GHash *depsgraph_extract)
+{
+  LISTBASE_FOREACH (Scene *, scene, &bmain->scenes) {
+    if (ID_IS_LINKED(scene)) {
+      continue;
+    }
+    LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
+      char key_full[MAX_ID_NAME + MAX_NAME + 1];
+      scene_undo_depsgraph_key_get(scene, view_layer, key_full);
+      Depsgraph *depsgraph = BLI_ghash_popkey(depsgraph_extract, key_full, MEM_freeN);
+      if (depsgraph == NULL) {
+        continue;
+      }
+
+      BKE_scene_ensure_depsgraph_hash(scene);
+      DepsgraphKey key;
+      key.view_layer = view_layer;
+      DepsgraphKey **key_ptr;
+      Depsgraph **depsgraph_ptr;
+      if (BLI_ghash_ensure_p_ex(
+              scene->depsgraph_hash, &key, (void ***)&key_ptr, (void ***)&depsgraph_ptr)) {
+        DEG_graph_free(depsgraph);
+        continue;
+      }
+      *key_ptr = MEM_mallocN(sizeof(DepsgraphKey), __func__);
+      **key_ptr = key;
+      *depsgraph_ptr = depsgraph;
+
+      DEG_graph_replace_owners(depsgraph, bmain, scene, view_layer);
+      DEG_graph_tag_relations_update(depsgraph);
+      DEG_graph_relations_update(depsgraph, bmain, scene, view_layer);
+
+      /* The restored scene may be at another frame than the one last evaluated. */
+      if (DEG_get_ctime(depsgraph) != BKE_scene_frame_get(scene)) {
+        DEG_graph_id_tag_update(bmain, depsgraph, &scene->id, ID_RECALC_TIME);
+      }
+    }
+  }
+
+  BLI_ghash_free(depsgraph_extract, MEM_freeN, depsgraph_key_value_free);
+}
+
 /* -------------------------------------------------------------------- */
 /** \name Scene Orientation
  * \{ */
@@ -20,18 +20,28 @@
  * \ingroup bke
  */
 
+#include <limits.h>
 #include <stddef.h>
+#include <stdio.h>
 #include <memory.h>
 
+#include "zlib.h"
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_sequence_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
+#include "IMB_colormanagement.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
 
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
 #include "BLI_mempool.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
 #include "BLI_threads.h"
 #include "BLI_listbase.h"
 #include "BLI_ghash.h"
@@ -63,6 +73,13 @@
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Disk cache:
+ * When enabled, final and composite images that are recycled from the memory cache are
+ * written to the disk cache directory and read back when they are missing from memory.
+ * Files are keyed by blend file, scene, strip name and frame instead of pointers, so they are
+ * valid after reloading the file. Strip invalidation removes affected files, the directory is
+ * trimmed to the size limit by removing the oldest files.
  */
 
 typedef struct SeqCache {
@@ -70,8 +87,13 @@ typedef struct SeqCache {
   ThreadMutex iterator_mutex;
   struct BLI_mempool *keys_pool;
   struct BLI_mempool *items_pool;
-  struct SeqCacheKey *last_key;
+  /* Last linked key of the frame being rendered, per #eSeqTaskId. */
+  struct SeqCacheKey *last_key[SEQ_TASK_NUM];
   size_t memory_used;
+  /* Serializes access to files in the disk cache directory. */
+  ThreadMutex disk_mutex;
+  size_t disk_size_used;
+  bool disk_size_known;
 } SeqCache;
 
 typedef struct SeqCacheItem {
@@ -172,6 +194,461 @@ static size_t seq_cache_get_mem_total(void)
   return ((size_t)U.memcachelimit) * 1024 * 1024;
 }
 
+/* ************************** Disk cache ************************** */
+
+#define SEQ_DISK_CACHE_VERSION 1
+#define SEQ_DISK_CACHE_COLORSPACE_LEN 64
+
+typedef struct SeqDiskCacheHeader {
+  char magic[4];
+  int version;
+  int x, y;
+  int planes;
+  int is_float;
+  unsigned int data_size;
+  unsigned int raw_size;
+  char colorspace[SEQ_DISK_CACHE_COLORSPACE_LEN];
+  char scene_colorspace[SEQ_DISK_CACHE_COLORSPACE_LEN];
+} SeqDiskCacheHeader;
+
+/* Image evicted from memory, waiting to be written once the cache lock is released. */
+typedef struct SeqDiskCacheWrite {
+  struct SeqDiskCacheWrite *next, *prev;
+  char path[FILE_MAX];
+  char scene_colorspace[SEQ_DISK_CACHE_COLORSPACE_LEN];
+  struct ImBuf *ibuf;
+} SeqDiskCacheWrite;
+
+typedef struct SeqDiskCacheFile {
+  struct SeqDiskCacheFile *next, *prev;
+  char path[FILE_MAX];
+  size_t size;
+  int64_t mtime;
+} SeqDiskCacheFile;
+
+static size_t seq_disk_cache_get_size_limit(void)
+{
+  return ((size_t)U.sequencer_disk_cache_size_limit) * 1024 * 1024 * 1024;
+}
+
+/* Directory holding the disk cache of all scenes in the blend file.
+ * Unsaved files have no stable name and are not cached on disk. */
+static bool seq_disk_cache_get_project_dir(const char *blendfile_path, char *r_path)
+{
+  if (U.sequencer_disk_cache_dir[0] == '\0' || blendfile_path[0] == '\0') {
+    return false;
+  }
+
+  char project_dir[FILE_MAXFILE];
+  BLI_snprintf(
+      project_dir, sizeof(project_dir), "%s_seq_cache", BLI_path_basename(blendfile_path));
+  BLI_path_join(r_path, FILE_MAX, U.sequencer_disk_cache_dir, project_dir, NULL);
+  BLI_path_abs(r_path, blendfile_path);
+  return true;
+}
+
+static bool seq_disk_cache_get_scene_dir(Scene *scene, const char *blendfile_path, char *r_path)
+{
+  char project_dir[FILE_MAX];
+  if (!scene->ed || (scene->ed->cache_flag & SEQ_CACHE_DISK_CACHE_ENABLE) == 0 ||
+      !seq_disk_cache_get_project_dir(blendfile_path, project_dir)) {
+    return false;
+  }
+
+  char scene_name[MAX_ID_NAME];
+  BLI_strncpy(scene_name, scene->id.name + 2, sizeof(scene_name));
+  BLI_filename_make_safe(scene_name);
+  BLI_path_join(r_path, FILE_MAX, project_dir, scene_name, NULL);
+  return true;
+}
+
+static void seq_disk_cache_get_seq_dir(const char *scene_dir, Sequence *seq, char *r_path)
+{
+  char seq_name[sizeof(seq->name)];
+  BLI_strncpy(seq_name, seq->name + 2, sizeof(seq_name));
+  BLI_filename_make_safe(seq_name);
+  BLI_path_join(r_path, FILE_MAX, scene_dir, seq_name, NULL);
+}
+
+static bool seq_disk_cache_get_file_path(const SeqCacheKey *key, char *r_path)
+{
+  const SeqRenderData *context = &key->context;
+  const float cfra = key->seq->start + key->nfra;
+
+  if ((key->type & (SEQ_CACHE_STORE_FINAL_OUT | SEQ_CACHE_STORE_COMPOSITE)) == 0 ||
+      context->bmain == NULL || cfra != (float)(int)cfra) {
+    return false;
+  }
+
+  char scene_dir[FILE_MAX], seq_dir[FILE_MAX];
+  if (!seq_disk_cache_get_scene_dir(
+          context->scene, BKE_main_blendfile_path(context->bmain), scene_dir)) {
+    return false;
+  }
+  seq_disk_cache_get_seq_dir(scene_dir, key->seq, seq_dir);
+
+  char filename[FILE_MAXFILE];
+  BLI_snprintf(filename,
+               sizeof(filename),
+               "%d-%d-%dx%d-%d-%d.dcf",
+               key->type,
+               (int)cfra,
+               context->rectx,
+               context->recty,
+               context->preview_render_size,
+               context->view_id);
+  BLI_path_join(r_path, FILE_MAX, seq_dir, filename, NULL);
+  return true;
+}
+
+static void seq_disk_cache_collect_files(const char *dir, ListBase *r_files)
+{
+  struct direntry *filelist;
+  unsigned int nbr = BLI_filelist_dir_contents(dir, &filelist);
+
+  for (unsigned int i = 0; i < nbr; i++) {
+    struct direntry *file = &filelist[i];
+
+    if (FILENAME_IS_CURRPAR(file->relname)) {
+      continue;
+    }
+    if (S_ISDIR(file->type)) {
+      seq_disk_cache_collect_files(file->path, r_files);
+      continue;
+    }
+    if (!BLI_path_extension_check(file->relname, ".dcf")) {
+      continue;
+    }
+
+    SeqDiskCacheFile *cache_file = MEM_callocN(sizeof(SeqDiskCacheFile), "SeqDiskCacheFile");
+    BLI_strncpy(cache_file->path, file->path, sizeof(cache_file->path));
+    cache_file->size = (size_t)file->s.st_size;
+    cache_file->mtime = (int64_t)file->s.st_mtime;
+    BLI_addtail(r_files, cache_file);
+  }
+
+  BLI_filelist_free(filelist, nbr);
+}
+
+static int seq_disk_cache_file_cmp(const void *a_, const void *b_)
+{
+  const SeqDiskCacheFile *a = a_;
+  const SeqDiskCacheFile *b = b_;
+
+  return (a->mtime > b->mtime) - (a->mtime < b->mtime);
+}
+
+/* Remove the least recently written files until the project directory fits the size limit.
+ * Also measures the directory the first time a file is written in this session. */
+static void seq_disk_cache_enforce_limits(SeqCache *cache, const char *project_dir)
+{
+  const size_t size_limit = seq_disk_cache_get_size_limit();
+
+  if (cache->disk_size_known && cache->disk_size_used <= size_limit) {
+    return;
+  }
+
+  ListBase files = {NULL, NULL};
+  seq_disk_cache_collect_files(project_dir, &files);
+  BLI_listbase_sort(&files, seq_disk_cache_file_cmp);
+
+  cache->disk_size_used = 0;
+  LISTBASE_FOREACH (SeqDiskCacheFile *, file, &files) {
+    cache->disk_size_used += file->size;
+  }
+
+  LISTBASE_FOREACH (SeqDiskCacheFile *, file, &files) {
+    if (cache->disk_size_used <= size_limit) {
+      break;
+    }
+    if (BLI_delete(file->path, false, false) == 0) {
+      cache->disk_size_used -= file->size;
+    }
+  }
+
+  BLI_freelistN(&files);
+  cache->disk_size_known = true;
+}
+
+static size_t seq_disk_cache_write_file(const char *path,
+                                        ImBuf *ibuf,
+                                        const char *scene_colorspace)
+{
+  const bool is_float = ibuf->rect_float != NULL;
+  const void *raw_data = is_float ? (void *)ibuf->rect_float : (void *)ibuf->rect;
+  const size_t raw_size = (size_t)ibuf->x * ibuf->y * 4 *
+                          (is_float ? sizeof(float) : sizeof(unsigned char));
+
+  if (raw_data == NULL || (is_float && ibuf->channels != 4) || raw_size > UINT_MAX) {
+    return 0;
+  }
+
+  void *data = (void *)raw_data;
+  uLongf data_size = raw_size;
+
+  if (U.sequencer_disk_cache_compression != USER_SEQ_DISK_CACHE_COMPRESSION_NONE) {
+    const int level = (U.sequencer_disk_cache_compression == USER_SEQ_DISK_CACHE_COMPRESSION_LOW) ?
+                          Z_BEST_SPEED :
+                          Z_DEFAULT_COMPRESSION;
+    data_size = compressBound(raw_size);
+    data = MEM_mallocN(data_size, "SeqDiskCache compressed");
+
+    if (compress2(data, &data_size, raw_data, raw_size, level) != Z_OK) {
+      MEM_freeN(data);
+      return 0;
+    }
+  }
+
+  SeqDiskCacheHeader header = {{0}};
+  memcpy(header.magic, "BSDC", sizeof(header.magic));
+  header.version = SEQ_DISK_CACHE_VERSION;
+  header.x = ibuf->x;
+  header.y = ibuf->y;
+  header.planes = ibuf->planes;
+  header.is_float = is_float;
+  header.data_size = (unsigned int)data_size;
+  header.raw_size = (unsigned int)raw_size;
+  BLI_strncpy(header.colorspace,
+              is_float ? IMB_colormanagement_get_float_colorspace(ibuf) :
+                         IMB_colormanagement_get_rect_colorspace(ibuf),
+              sizeof(header.colorspace));
+  BLI_strncpy(header.scene_colorspace, scene_colorspace, sizeof(header.scene_colorspace));
+
+  char dir[FILE_MAX];
+  BLI_split_dir_part(path, dir, sizeof(dir));
+  BLI_dir_create_recursive(dir);
+
+  size_t written = 0;
+  FILE *file = BLI_fopen(path, "wb");
+  if (file) {
+    if (fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(data, data_size, 1, file) == 1) {
+      written = sizeof(header) + data_size;
+    }
+    fclose(file);
+
+    if (written == 0) {
+      BLI_delete(path, false, false);
+    }
+  }
+
+  if (data != raw_data) {
+    MEM_freeN(data);
+  }
+
+  return written;
+}
+
+static ImBuf *seq_disk_cache_read_file(const char *path, const char *scene_colorspace)
+{
+  FILE *file = BLI_fopen(path, "rb");
+  if (!file) {
+    return NULL;
+  }
+
+  SeqDiskCacheHeader header;
+  const size_t file_size = BLI_file_size(path);
+
+  if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, "BSDC", 4) != 0 ||
+      header.version != SEQ_DISK_CACHE_VERSION ||
+      file_size != sizeof(header) + header.data_size ||
+      !STREQLEN(header.scene_colorspace, scene_colorspace, sizeof(header.scene_colorspace)) ||
+      (size_t)header.x * header.y * 4 * (header.is_float ? sizeof(float) : 1) !=
+          header.raw_size) {
+    fclose(file);
+    return NULL;
+  }
+
+  void *data = MEM_mallocN(header.data_size, "SeqDiskCache file");
+  if (fread(data, header.data_size, 1, file) != 1) {
+    MEM_freeN(data);
+    fclose(file);
+    return NULL;
+  }
+  fclose(file);
+
+  ImBuf *ibuf = IMB_allocImBuf(
+      header.x, header.y, header.planes, header.is_float ? IB_rectfloat : IB_rect);
+  void *raw_data = header.is_float ? (void *)ibuf->rect_float : (void *)ibuf->rect;
+  bool ok;
+
+  if (header.data_size == header.raw_size) {
+    memcpy(raw_data, data, header.raw_size);
+    ok = true;
+  }
+  else {
+    uLongf raw_size = header.raw_size;
+    ok = uncompress(raw_data, &raw_size, data, header.data_size) == Z_OK &&
+         raw_size == header.raw_size;
+  }
+  MEM_freeN(data);
+
+  if (!ok) {
+    IMB_freeImBuf(ibuf);
+    return NULL;
+  }
+
+  header.colorspace[sizeof(header.colorspace) - 1] = '\0';
+  if (header.is_float) {
+    IMB_colormanagement_assign_float_colorspace(ibuf, header.colorspace);
+  }
+  else {
+    IMB_colormanagement_assign_rect_colorspace(ibuf, header.colorspace);
+  }
+
+  return ibuf;
+}
+
+/* Queue the image of a key that is about to be recycled to be written to disk. */
+static void seq_disk_cache_queue_write(SeqCache *cache, SeqCacheKey *key, ListBase *r_writes)
+{
+  if (r_writes == NULL || key->is_temp_cache) {
+    return;
+  }
+
+  SeqCacheItem *item = BLI_ghash_lookup(cache->hash, key);
+  if (item == NULL || item->ibuf == NULL) {
+    return;
+  }
+
+  SeqDiskCacheWrite *write = MEM_callocN(sizeof(SeqDiskCacheWrite), "SeqDiskCacheWrite");
+  if (!seq_disk_cache_get_file_path(key, write->path)) {
+    MEM_freeN(write);
+    return;
+  }
+
+  BLI_strncpy(write->scene_colorspace,
+              key->context.scene->sequencer_colorspace_settings.name,
+              sizeof(write->scene_colorspace));
+  write->ibuf = item->ibuf;
+  IMB_refImBuf(write->ibuf);
+  BLI_addtail(r_writes, write);
+}
+
+static void seq_disk_cache_write_queued(Scene *scene, ListBase *writes)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  char project_dir[FILE_MAX];
+
+  if (BLI_listbase_is_empty(writes)) {
+    return;
+  }
+
+  BLI_mutex_lock(&cache->disk_mutex);
+  LISTBASE_FOREACH (SeqDiskCacheWrite *, write, writes) {
+    /* Entries are removed on invalidation, so an existing file is up to date. */
+    if (!BLI_exists(write->path)) {
+      cache->disk_size_used += seq_disk_cache_write_file(
+          write->path, write->ibuf, write->scene_colorspace);
+    }
+    IMB_freeImBuf(write->ibuf);
+  }
+
+  if (seq_disk_cache_get_project_dir(BKE_main_blendfile_path_from_global(), project_dir)) {
+    seq_disk_cache_enforce_limits(cache, project_dir);
+  }
+  BLI_mutex_unlock(&cache->disk_mutex);
+
+  BLI_freelistN(writes);
+}
+
+static ImBuf *seq_disk_cache_read(Scene *scene, SeqCacheKey *key)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  char path[FILE_MAX];
+
+  if (!cache || !seq_disk_cache_get_file_path(key, path)) {
+    return NULL;
+  }
+
+  BLI_mutex_lock(&cache->disk_mutex);
+  ImBuf *ibuf = NULL;
+  if (BLI_exists(path)) {
+    ibuf = seq_disk_cache_read_file(path, scene->sequencer_colorspace_settings.name);
+    if (ibuf == NULL) {
+      /* Stale or damaged file, it will be written again. */
+      BLI_delete(path, false, false);
+    }
+  }
+  BLI_mutex_unlock(&cache->disk_mutex);
+
+  return ibuf;
+}
+
+/* Remove files of given type in frame range from strip directory. */
+static void seq_disk_cache_delete_range(SeqCache *cache,
+                                        const char *seq_dir,
+                                        int type,
+                                        int range_start,
+                                        int range_end)
+{
+  struct direntry *filelist;
+  unsigned int nbr = BLI_filelist_dir_contents(seq_dir, &filelist);
+
+  for (unsigned int i = 0; i < nbr; i++) {
+    struct direntry *file = &filelist[i];
+    int file_type, file_cfra;
+
+    if (S_ISDIR(file->type) || sscanf(file->relname, "%d-%d-", &file_type, &file_cfra) != 2) {
+      continue;
+    }
+
+    if (file_type == type && file_cfra >= range_start && file_cfra <= range_end) {
+      if (BLI_delete(file->path, false, false) == 0 &&
+          cache->disk_size_used >= (size_t)file->s.st_size) {
+        cache->disk_size_used -= (size_t)file->s.st_size;
+      }
+    }
+  }
+
+  BLI_filelist_free(filelist, nbr);
+}
+
+static void seq_disk_cache_invalidate(Scene *scene,
+                                      Sequence *seq,
+                                      Sequence *seq_changed,
+                                      int range_start,
+                                      int range_end,
+                                      int invalidate_types)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  char scene_dir[FILE_MAX], seq_dir[FILE_MAX];
+
+  if (!seq_disk_cache_get_scene_dir(scene, BKE_main_blendfile_path_from_global(), scene_dir) ||
+      !BLI_is_dir(scene_dir)) {
+    return;
+  }
+
+  BLI_mutex_lock(&cache->disk_mutex);
+
+  /* Final images are stored in directory of the topmost strip, check all of them. */
+  if (invalidate_types & SEQ_CACHE_STORE_FINAL_OUT) {
+    struct direntry *filelist;
+    unsigned int nbr = BLI_filelist_dir_contents(scene_dir, &filelist);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      if (S_ISDIR(filelist[i].type) && !FILENAME_IS_CURRPAR(filelist[i].relname)) {
+        seq_disk_cache_delete_range(
+            cache, filelist[i].path, SEQ_CACHE_STORE_FINAL_OUT, range_start, range_end);
+      }
+    }
+    BLI_filelist_free(filelist, nbr);
+  }
+
+  if (invalidate_types & SEQ_CACHE_STORE_COMPOSITE) {
+    seq_disk_cache_get_seq_dir(scene_dir, seq, seq_dir);
+    seq_disk_cache_delete_range(cache,
+                                seq_dir,
+                                SEQ_CACHE_STORE_COMPOSITE,
+                                seq_changed->startdisp,
+                                seq_changed->enddisp);
+  }
+
+  BLI_mutex_unlock(&cache->disk_mutex);
+}
+
+/* ************************** Memory cache ************************** */
+
 static void seq_cache_keyfree(void *val)
 {
   SeqCacheKey *key = val;
@@ -200,7 +677,7 @@ static void seq_cache_put(SeqCache *cache, SeqCacheKey *key, ImBuf *ibuf)
 
   if (BLI_ghash_reinsert(cache->hash, key, item, seq_cache_keyfree, seq_cache_valfree)) {
     IMB_refImBuf(ibuf);
-    cache->last_key = key;
+    cache->last_key[key->task_id] = key;
     cache->memory_used += IMB_get_size_in_memory(ibuf);
   }
 }
@@ -297,7 +774,9 @@ static SeqCacheKey *seq_cache_choose_key(Scene *scene, SeqCacheKey *lkey, SeqCac
   return finalkey;
 }
 
-static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
+/* Remove all keys linked to base. When r_disk_writes is given, images that belong to the disk
+ * cache are queued to be written once the cache is unlocked. */
+static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base, ListBase *r_disk_writes)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   if (!cache) {
@@ -308,6 +787,7 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
 
   while (base) {
     SeqCacheKey *prev = base->link_prev;
+    seq_disk_cache_queue_write(cache, base, r_disk_writes);
     BLI_ghash_remove(cache->hash, base, seq_cache_keyfree, seq_cache_valfree);
     base = prev;
   }
@@ -315,6 +795,7 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
   base = next;
   while (base) {
     next = base->link_next;
+    seq_disk_cache_queue_write(cache, base, r_disk_writes);
     BLI_ghash_remove(cache->hash, base, seq_cache_keyfree, seq_cache_valfree);
     base = next;
   }
@@ -342,7 +823,7 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
 
     /* this shouldn't happen, but better be safe than sorry */
     if (!item->ibuf) {
-      seq_cache_recycle_linked(scene, key);
+      seq_cache_recycle_linked(scene, key, NULL);
       /* can not continue iterating after linked remove */
       BLI_ghashIterator_init(&gh_iter, cache->hash);
       continue;
@@ -391,21 +872,26 @@ bool BKE_sequencer_cache_recycle_item(Scene *scene)
     return false;
   }
 
+  ListBase disk_writes = {NULL, NULL};
+  bool recycled = true;
+
   seq_cache_lock(scene);
 
   while (cache->memory_used > memory_total) {
     SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene);
 
     if (finalkey) {
-      seq_cache_recycle_linked(scene, finalkey);
+      seq_cache_recycle_linked(scene, finalkey, &disk_writes);
     }
     else {
-      seq_cache_unlock(scene);
-      return false;
+      recycled = false;
+      break;
     }
   }
   seq_cache_unlock(scene);
-  return true;
+
+  seq_disk_cache_write_queued(scene, &disk_writes);
+  return recycled;
 }
 
 static void seq_cache_set_temp_cache_linked(Scene *scene, SeqCacheKey *base)
@@ -440,8 +926,8 @@ static void BKE_sequencer_cache_create(Scene *scene)
     cache->keys_pool = BLI_mempool_create(sizeof(SeqCacheKey), 0, 64, BLI_MEMPOOL_NOP);
     cache->items_pool = BLI_mempool_create(sizeof(SeqCacheItem), 0, 64, BLI_MEMPOOL_NOP);
     cache->hash = BLI_ghash_new(seq_cache_hashhash, seq_cache_hashcmp, "SeqCache hash");
-    cache->last_key = NULL;
     BLI_mutex_init(&cache->iterator_mutex);
+    BLI_mutex_init(&cache->disk_mutex);
     scene->ed->cache = cache;
   }
   BLI_mutex_unlock(&cache_create_lock);
@@ -482,6 +968,7 @@ void BKE_sequencer_cache_destruct(Scene *scene)
   BLI_mempool_destroy(cache->keys_pool);
   BLI_mempool_destroy(cache->items_pool);
   BLI_mutex_end(&cache->iterator_mutex);
+  BLI_mutex_end(&cache->disk_mutex);
   MEM_freeN(cache);
   scene->ed->cache = NULL;
 }
@@ -511,7 +998,7 @@ void BKE_sequencer_cache_cleanup(Scene *scene)
     BLI_ghashIterator_step(&gh_iter);
     BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
   }
-  cache->last_key = NULL;
+  memset(cache->last_key, 0, sizeof(cache->last_key));
   seq_cache_unlock(scene);
 }
 
@@ -568,8 +1055,25 @@ void BKE_sequencer_cache_cleanup_sequence(Scene *scene,
       BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
     }
   }
-  cache->last_key = NULL;
+  memset(cache->last_key, 0, sizeof(cache->last_key));
   seq_cache_unlock(scene);
+
+  seq_disk_cache_invalidate(scene, seq, seq_changed, range_start, range_end, invalidate_types);
+}
+
+/* Look up memory cache only. */
+static ImBuf *seq_cache_lookup(Scene *scene, SeqCacheKey *key)
+{
+  seq_cache_lock(scene);
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  ImBuf *ibuf = NULL;
+
+  if (cache && key->seq) {
+    ibuf = seq_cache_get(cache, key);
+  }
+  seq_cache_unlock(scene);
+
+  return ibuf;
 }
 
 struct ImBuf *BKE_sequencer_cache_get(const SeqRenderData *context,
@@ -587,24 +1091,25 @@ struct ImBuf *BKE_sequencer_cache_get(const SeqRenderData *context,
 
   if (!scene->ed->cache) {
     BKE_sequencer_cache_create(scene);
-    return NULL;
   }
 
-  seq_cache_lock(scene);
-  SeqCache *cache = seq_cache_get_from_scene(scene);
-  ImBuf *ibuf = NULL;
+  if (!seq) {
+    return NULL;
+  }
 
-  if (cache && seq) {
-    SeqCacheKey key;
+  SeqCacheKey key;
+  key.seq = seq;
+  key.context = *context;
+  key.nfra = cfra - seq->start;
+  key.type = type;
 
-    key.seq = seq;
-    key.context = *context;
-    key.nfra = cfra - seq->start;
-    key.type = type;
+  ImBuf *ibuf = seq_cache_lookup(scene, &key);
 
-    ibuf = seq_cache_get(cache, &key);
+  /* Images read from disk are not put back into memory, they would be recycled right away
+   * when playing back a range larger than the memory cache. */
+  if (ibuf == NULL && !context->skip_cache && !context->is_proxy_render) {
+    ibuf = seq_disk_cache_read(scene, &key);
   }
-  seq_cache_unlock(scene);
 
   return ibuf;
 }
@@ -625,8 +1130,9 @@ bool BKE_sequencer_cache_put_if_possible(
     return true;
   }
   else {
-    seq_cache_set_temp_cache_linked(scene, scene->ed->cache->last_key);
-    scene->ed->cache->last_key = NULL;
+    SeqCache *cache = seq_cache_get_from_scene(scene);
+    seq_cache_set_temp_cache_linked(scene, cache->last_key[context->task_id]);
+    cache->last_key[context->task_id] = NULL;
     return false;
   }
 }
@@ -647,7 +1153,13 @@ void BKE_sequencer_cache_put(
   }
 
   /* Prevent reinserting, it breaks cache key linking */
-  ImBuf *test = BKE_sequencer_cache_get(context, seq, cfra, type);
+  SeqCacheKey test_key;
+  test_key.seq = seq;
+  test_key.context = *context;
+  test_key.nfra = cfra - seq->start;
+  test_key.type = type;
+
+  ImBuf *test = seq_cache_lookup(scene, &test_key);
   if (test) {
     IMB_freeImBuf(test);
     return;
@@ -688,30 +1200,33 @@ void BKE_sequencer_cache_put(
   key->is_temp_cache = true;
   key->task_id = context->task_id;
 
+  /* Frames rendered by different tasks at the same time are linked separately. */
+  SeqCacheKey **last_key = &cache->last_key[key->task_id];
+
   /* Item stored for later use */
   if (flag & type) {
     key->is_temp_cache = false;
-    key->link_prev = cache->last_key;
+    key->link_prev = *last_key;
   }
 
-  SeqCacheKey *temp_last_key = cache->last_key;
+  SeqCacheKey *temp_last_key = *last_key;
   seq_cache_put(cache, key, i);
 
   /* Restore pointer to previous item as this one will be freed when stack is rendered */
   if (key->is_temp_cache) {
-    cache->last_key = temp_last_key;
+    *last_key = temp_last_key;
   }
 
   /* Set last_key's reference to this key so we can look up chain backwards
-   * Item is already put in cache, so cache->last_key points to current key;
+   * Item is already put in cache, so last_key points to current key;
    */
   if (flag & type && temp_last_key) {
-    temp_last_key->link_next = cache->last_key;
+    temp_last_key->link_next = *last_key;
   }
 
   /* Reset linking */
   if (key->type == SEQ_CACHE_STORE_FINAL_OUT) {
-    cache->last_key = NULL;
+    *last_key = NULL;
   }
 
   seq_cache_unlock(scene);
@@ -753,7 +1268,7 @@ void BKE_sequencer_cache_iterate(
     interrupt = callback(userdata, key->seq, key->nfra, key->type, key->cost);
   }
 
-  cache->last_key = NULL;
+  memset(cache->last_key, 0, sizeof(cache->last_key));
   seq_cache_unlock(scene);
 }
 
@@ -28,6 +28,10 @@
 #include <math.h>
 #include <stdlib.h>
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h" /* windows needs for M_PI */
@@ -191,6 +195,73 @@ static void init_alpha_over_or_under(Sequence *seq)
   seq->seq1 = seq2;
 }
 
+#ifdef __SSE2__
+/* Load a straight alpha byte pixel as premultiplied floats. */
+BLI_INLINE __m128 straight_uchar_to_premul_float_sse2(const unsigned char *cp)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i c = _mm_unpacklo_epi16(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int *)cp), zero), zero);
+  const float fac = cp[3] * (1.0f / 255.0f) * (1.0f / 255.0f);
+
+  return _mm_mul_ps(_mm_cvtepi32_ps(c), _mm_setr_ps(fac, fac, fac, 1.0f / 255.0f));
+}
+
+BLI_INLINE void premul_float_to_straight_uchar_sse2(unsigned char *rt, __m128 color)
+{
+  const float alpha = _mm_cvtss_f32(_mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3)));
+  const float alpha_inv = (alpha == 0.0f || alpha == 1.0f) ? 1.0f : 1.0f / alpha;
+
+  color = _mm_mul_ps(color, _mm_setr_ps(alpha_inv, alpha_inv, alpha_inv, 1.0f));
+  const __m128i c = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(color, _mm_set1_ps(255.0f)),
+                                                _mm_set1_ps(0.5f)));
+  const __m128i c16 = _mm_packs_epi32(c, c);
+  *(int *)rt = _mm_cvtsi128_si32(_mm_packus_epi16(c16, c16));
+}
+#endif
+
+static void alphaover_row_byte(
+    float fac, int x, const unsigned char *cp1, const unsigned char *cp2, unsigned char *rt)
+{
+  if (fac <= 0.0f) {
+    memcpy(rt, cp2, sizeof(unsigned int) * x);
+    return;
+  }
+
+  while (x--) {
+    /* rt = rt1 over rt2  (alpha from rt1) */
+    const float mfac = 1.0f - fac * (cp1[3] * (1.0f / 255.0f));
+
+    if (mfac <= 0.0f) {
+      *((unsigned int *)rt) = *((unsigned int *)cp1);
+    }
+    else {
+#ifdef __SSE2__
+      const __m128 rt1 = straight_uchar_to_premul_float_sse2(cp1);
+      const __m128 rt2 = straight_uchar_to_premul_float_sse2(cp2);
+
+      premul_float_to_straight_uchar_sse2(
+          rt, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(fac), rt1), _mm_mul_ps(_mm_set1_ps(mfac), rt2)));
+#else
+      float tempc[4], rt1[4], rt2[4];
+
+      straight_uchar_to_premul_float(rt1, cp1);
+      straight_uchar_to_premul_float(rt2, cp2);
+
+      tempc[0] = fac * rt1[0] + mfac * rt2[0];
+      tempc[1] = fac * rt1[1] + mfac * rt2[1];
+      tempc[2] = fac * rt1[2] + mfac * rt2[2];
+      tempc[3] = fac * rt1[3] + mfac * rt2[3];
+
+      premul_float_to_straight_uchar(rt, tempc);
+#endif
+    }
+    cp1 += 4;
+    cp2 += 4;
+    rt += 4;
+  }
+}
+
 static void do_alphaover_effect_byte(float facf0,
                                      float facf1,
                                      int x,
@@ -199,87 +270,83 @@ static void do_alphaover_effect_byte(float facf0,
                                      unsigned char *rect2,
                                      unsigned char *out)
 {
-  float fac2, mfac, fac, fac4;
   int xo;
   unsigned char *cp1, *cp2, *rt;
-  float tempc[4], rt1[4], rt2[4];
 
   xo = x;
   cp1 = rect1;
   cp2 = rect2;
   rt = out;
 
-  fac2 = facf0;
-  fac4 = facf1;
-
   while (y--) {
-    x = xo;
-    while (x--) {
-      /* rt = rt1 over rt2  (alpha from rt1) */
-
-      straight_uchar_to_premul_float(rt1, cp1);
-      straight_uchar_to_premul_float(rt2, cp2);
-
-      fac = fac2;
-      mfac = 1.0f - fac2 * rt1[3];
-
-      if (fac <= 0.0f) {
-        *((unsigned int *)rt) = *((unsigned int *)cp2);
-      }
-      else if (mfac <= 0.0f) {
-        *((unsigned int *)rt) = *((unsigned int *)cp1);
-      }
-      else {
-        tempc[0] = fac * rt1[0] + mfac * rt2[0];
-        tempc[1] = fac * rt1[1] + mfac * rt2[1];
-        tempc[2] = fac * rt1[2] + mfac * rt2[2];
-        tempc[3] = fac * rt1[3] + mfac * rt2[3];
-
-        premul_float_to_straight_uchar(rt, tempc);
-      }
-      cp1 += 4;
-      cp2 += 4;
-      rt += 4;
-    }
+    alphaover_row_byte(facf0, xo, cp1, cp2, rt);
+    cp1 += xo * 4;
+    cp2 += xo * 4;
+    rt += xo * 4;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
-      straight_uchar_to_premul_float(rt1, cp1);
-      straight_uchar_to_premul_float(rt2, cp2);
-
-      fac = fac4;
-      mfac = 1.0f - (fac4 * rt1[3]);
+    alphaover_row_byte(facf1, xo, cp1, cp2, rt);
+    cp1 += xo * 4;
+    cp2 += xo * 4;
+    rt += xo * 4;
+  }
+}
 
-      if (fac <= 0.0f) {
-        *((unsigned int *)rt) = *((unsigned int *)cp2);
-      }
-      else if (mfac <= 0.0f) {
-        *((unsigned int *)rt) = *((unsigned int *)cp1);
-      }
-      else {
-        tempc[0] = fac * rt1[0] + mfac * rt2[0];
-        tempc[1] = fac * rt1[1] + mfac * rt2[1];
-        tempc[2] = fac * rt1[2] + mfac * rt2[2];
-        tempc[3] = fac * rt1[3] + mfac * rt2[3];
+static void alphaover_row_float(
+    float fac, int x, const float *rt1, const float *rt2, float *rt)
+{
+  if (fac <= 0.0f) {
+    memcpy(rt, rt2, 4 * sizeof(float) * x);
+    return;
+  }
 
-        premul_float_to_straight_uchar(rt, tempc);
-      }
-      cp1 += 4;
-      cp2 += 4;
-      rt += 4;
+#ifdef __SSE2__
+  const __m128 vfac = _mm_set1_ps(fac);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 zero = _mm_setzero_ps();
+
+  while (x--) {
+    /* rt = rt1 over rt2  (alpha from rt1) */
+    const __m128 c1 = _mm_loadu_ps(rt1);
+    const __m128 c2 = _mm_loadu_ps(rt2);
+    const __m128 mfac = _mm_sub_ps(
+        one, _mm_mul_ps(vfac, _mm_shuffle_ps(c1, c1, _MM_SHUFFLE(3, 3, 3, 3))));
+    const __m128 blend = _mm_add_ps(_mm_mul_ps(vfac, c1), _mm_mul_ps(mfac, c2));
+    const __m128 use_c1 = _mm_cmple_ps(mfac, zero);
+
+    _mm_storeu_ps(rt, _mm_or_ps(_mm_and_ps(use_c1, c1), _mm_andnot_ps(use_c1, blend)));
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
+  }
+#else
+  while (x--) {
+    /* rt = rt1 over rt2  (alpha from rt1) */
+    const float mfac = 1.0f - (fac * rt1[3]);
+
+    if (mfac <= 0.0f) {
+      memcpy(rt, rt1, 4 * sizeof(float));
     }
+    else {
+      rt[0] = fac * rt1[0] + mfac * rt2[0];
+      rt[1] = fac * rt1[1] + mfac * rt2[1];
+      rt[2] = fac * rt1[2] + mfac * rt2[2];
+      rt[3] = fac * rt1[3] + mfac * rt2[3];
+    }
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
   }
+#endif
 }
 
 static void do_alphaover_effect_float(
     float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
 {
-  float fac2, mfac, fac, fac4;
   int xo;
   float *rt1, *rt2, *rt;
 
@@ -288,60 +355,21 @@ static void do_alphaover_effect_float(
   rt2 = rect2;
   rt = out;
 
-  fac2 = facf0;
-  fac4 = facf1;
-
   while (y--) {
-    x = xo;
-    while (x--) {
-      /* rt = rt1 over rt2  (alpha from rt1) */
-
-      fac = fac2;
-      mfac = 1.0f - (fac2 * rt1[3]);
-
-      if (fac <= 0.0f) {
-        memcpy(rt, rt2, 4 * sizeof(float));
-      }
-      else if (mfac <= 0) {
-        memcpy(rt, rt1, 4 * sizeof(float));
-      }
-      else {
-        rt[0] = fac * rt1[0] + mfac * rt2[0];
-        rt[1] = fac * rt1[1] + mfac * rt2[1];
-        rt[2] = fac * rt1[2] + mfac * rt2[2];
-        rt[3] = fac * rt1[3] + mfac * rt2[3];
-      }
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    alphaover_row_float(facf0, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
-      fac = fac4;
-      mfac = 1.0f - (fac4 * rt1[3]);
-
-      if (fac <= 0.0f) {
-        memcpy(rt, rt2, 4 * sizeof(float));
-      }
-      else if (mfac <= 0.0f) {
-        memcpy(rt, rt1, 4 * sizeof(float));
-      }
-      else {
-        rt[0] = fac * rt1[0] + mfac * rt2[0];
-        rt[1] = fac * rt1[1] + mfac * rt2[1];
-        rt[2] = fac * rt1[2] + mfac * rt2[2];
-        rt[3] = fac * rt1[3] + mfac * rt2[3];
-      }
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    alphaover_row_float(facf1, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
   }
 }
 
@@ -584,6 +612,48 @@ static void do_alphaunder_effect(const SeqRenderData *context,
 
 /*********************** Cross *************************/
 
+static void cross_row_byte(
+    int fac1, int fac2, int x, const unsigned char *rt1, const unsigned char *rt2, unsigned char *rt)
+{
+#ifdef __SSE2__
+  /* Factors add up to 256, so the weighted sum of two channels fits 16 bits. */
+  if (fac2 >= 0 && fac2 <= 256) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i f1 = _mm_set1_epi16((short)fac1);
+    const __m128i f2 = _mm_set1_epi16((short)fac2);
+
+    for (; x >= 4; x -= 4) {
+      const __m128i c1 = _mm_loadu_si128((const __m128i *)rt1);
+      const __m128i c2 = _mm_loadu_si128((const __m128i *)rt2);
+      const __m128i lo = _mm_srli_epi16(
+          _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(c1, zero), f1),
+                        _mm_mullo_epi16(_mm_unpacklo_epi8(c2, zero), f2)),
+          8);
+      const __m128i hi = _mm_srli_epi16(
+          _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(c1, zero), f1),
+                        _mm_mullo_epi16(_mm_unpackhi_epi8(c2, zero), f2)),
+          8);
+
+      _mm_storeu_si128((__m128i *)rt, _mm_packus_epi16(lo, hi));
+      rt1 += 16;
+      rt2 += 16;
+      rt += 16;
+    }
+  }
+#endif
+
+  while (x--) {
+    rt[0] = (fac1 * rt1[0] + fac2 * rt2[0]) >> 8;
+    rt[1] = (fac1 * rt1[1] + fac2 * rt2[1]) >> 8;
+    rt[2] = (fac1 * rt1[2] + fac2 * rt2[2]) >> 8;
+    rt[3] = (fac1 * rt1[3] + fac2 * rt2[3]) >> 8;
+
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
+  }
+}
+
 static void do_cross_effect_byte(float facf0,
                                  float facf1,
                                  int x,
@@ -607,35 +677,49 @@ static void do_cross_effect_byte(float facf0,
   fac3 = 256 - fac4;
 
   while (y--) {
-    x = xo;
-    while (x--) {
-      rt[0] = (fac1 * rt1[0] + fac2 * rt2[0]) >> 8;
-      rt[1] = (fac1 * rt1[1] + fac2 * rt2[1]) >> 8;
-      rt[2] = (fac1 * rt1[2] + fac2 * rt2[2]) >> 8;
-      rt[3] = (fac1 * rt1[3] + fac2 * rt2[3]) >> 8;
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    cross_row_byte(fac1, fac2, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
-      rt[0] = (fac3 * rt1[0] + fac4 * rt2[0]) >> 8;
-      rt[1] = (fac3 * rt1[1] + fac4 * rt2[1]) >> 8;
-      rt[2] = (fac3 * rt1[2] + fac4 * rt2[2]) >> 8;
-      rt[3] = (fac3 * rt1[3] + fac4 * rt2[3]) >> 8;
+    cross_row_byte(fac3, fac4, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
+  }
+}
 
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+static void cross_row_float(
+    float fac1, float fac2, int x, const float *rt1, const float *rt2, float *rt)
+{
+#ifdef __SSE2__
+  const __m128 f1 = _mm_set1_ps(fac1);
+  const __m128 f2 = _mm_set1_ps(fac2);
+
+  while (x--) {
+    _mm_storeu_ps(rt,
+                  _mm_add_ps(_mm_mul_ps(f1, _mm_loadu_ps(rt1)), _mm_mul_ps(f2, _mm_loadu_ps(rt2))));
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
   }
+#else
+  while (x--) {
+    rt[0] = fac1 * rt1[0] + fac2 * rt2[0];
+    rt[1] = fac1 * rt1[1] + fac2 * rt2[1];
+    rt[2] = fac1 * rt1[2] + fac2 * rt2[2];
+    rt[3] = fac1 * rt1[3] + fac2 * rt2[3];
+
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
+  }
+#endif
 }
 
 static void do_cross_effect_float(
@@ -656,34 +740,20 @@ static void do_cross_effect_float(
   fac3 = 1.0f - fac4;
 
   while (y--) {
-    x = xo;
-    while (x--) {
-      rt[0] = fac1 * rt1[0] + fac2 * rt2[0];
-      rt[1] = fac1 * rt1[1] + fac2 * rt2[1];
-      rt[2] = fac1 * rt1[2] + fac2 * rt2[2];
-      rt[3] = fac1 * rt1[3] + fac2 * rt2[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    cross_row_float(fac1, fac2, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
-      rt[0] = fac3 * rt1[0] + fac4 * rt2[0];
-      rt[1] = fac3 * rt1[1] + fac4 * rt2[1];
-      rt[2] = fac3 * rt1[2] + fac4 * rt2[2];
-      rt[3] = fac3 * rt1[3] + fac4 * rt2[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    cross_row_float(fac3, fac4, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
   }
 }
 
@@ -1017,6 +1087,51 @@ static void do_gammacross_effect(const SeqRenderData *context,
 
 /*********************** Add *************************/
 
+static void add_row_byte(
+    int fac, int x, const unsigned char *cp1, const unsigned char *cp2, unsigned char *rt)
+{
+#ifdef __SSE2__
+  /* fac * alpha fits 16 bits, the scaled channel is added with saturation. */
+  if (fac >= 0 && fac <= 256) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i f = _mm_set1_epi16((short)fac);
+    const __m128i rgb_mask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+
+    for (; x >= 4; x -= 4) {
+      const __m128i c1 = _mm_loadu_si128((const __m128i *)cp1);
+      const __m128i c2 = _mm_loadu_si128((const __m128i *)cp2);
+      __m128i add[2];
+
+      for (int i = 0; i < 2; i++) {
+        const __m128i c2_16 = i ? _mm_unpackhi_epi8(c2, zero) : _mm_unpacklo_epi8(c2, zero);
+        const __m128i alpha = _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(c2_16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i m = _mm_mullo_epi16(alpha, f);
+
+        add[i] = _mm_and_si128(_mm_mulhi_epu16(m, c2_16), rgb_mask);
+      }
+
+      _mm_storeu_si128((__m128i *)rt, _mm_adds_epu8(c1, _mm_packus_epi16(add[0], add[1])));
+      cp1 += 16;
+      cp2 += 16;
+      rt += 16;
+    }
+  }
+#endif
+
+  while (x--) {
+    const int m = fac * (int)cp2[3];
+    rt[0] = min_ii(cp1[0] + ((m * cp2[0]) >> 16), 255);
+    rt[1] = min_ii(cp1[1] + ((m * cp2[1]) >> 16), 255);
+    rt[2] = min_ii(cp1[2] + ((m * cp2[2]) >> 16), 255);
+    rt[3] = cp1[3];
+
+    cp1 += 4;
+    cp2 += 4;
+    rt += 4;
+  }
+}
+
 static void do_add_effect_byte(float facf0,
                                float facf1,
                                int x,
@@ -1037,45 +1152,62 @@ static void do_add_effect_byte(float facf0,
   fac3 = (int)(256.0f * facf1);
 
   while (y--) {
-    x = xo;
-
-    while (x--) {
-      const int m = fac1 * (int)cp2[3];
-      rt[0] = min_ii(cp1[0] + ((m * cp2[0]) >> 16), 255);
-      rt[1] = min_ii(cp1[1] + ((m * cp2[1]) >> 16), 255);
-      rt[2] = min_ii(cp1[2] + ((m * cp2[2]) >> 16), 255);
-      rt[3] = cp1[3];
-
-      cp1 += 4;
-      cp2 += 4;
-      rt += 4;
-    }
+    add_row_byte(fac1, xo, cp1, cp2, rt);
+    cp1 += xo * 4;
+    cp2 += xo * 4;
+    rt += xo * 4;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
-      const int m = fac3 * (int)cp2[3];
-      rt[0] = min_ii(cp1[0] + ((m * cp2[0]) >> 16), 255);
-      rt[1] = min_ii(cp1[1] + ((m * cp2[1]) >> 16), 255);
-      rt[2] = min_ii(cp1[2] + ((m * cp2[2]) >> 16), 255);
-      rt[3] = cp1[3];
+    add_row_byte(fac3, xo, cp1, cp2, rt);
+    cp1 += xo * 4;
+    cp2 += xo * 4;
+    rt += xo * 4;
+  }
+}
 
-      cp1 += 4;
-      cp2 += 4;
-      rt += 4;
-    }
+static void add_row_float(float fac, int x, const float *rt1, const float *rt2, float *rt)
+{
+#ifdef __SSE2__
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 mfac = _mm_set1_ps(1.0f - fac);
+  const __m128 rgb_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+  while (x--) {
+    const __m128 c1 = _mm_loadu_ps(rt1);
+    const __m128 c2 = _mm_loadu_ps(rt2);
+    const __m128 m = _mm_mul_ps(
+        _mm_sub_ps(one, _mm_mul_ps(_mm_shuffle_ps(c1, c1, _MM_SHUFFLE(3, 3, 3, 3)), mfac)),
+        _mm_shuffle_ps(c2, c2, _MM_SHUFFLE(3, 3, 3, 3)));
+    const __m128 sum = _mm_add_ps(c1, _mm_mul_ps(m, c2));
+
+    _mm_storeu_ps(rt, _mm_or_ps(_mm_and_ps(rgb_mask, sum), _mm_andnot_ps(rgb_mask, c1)));
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
+  }
+#else
+  while (x--) {
+    const float m = (1.0f - (rt1[3] * (1.0f - fac))) * rt2[3];
+    rt[0] = rt1[0] + m * rt2[0];
+    rt[1] = rt1[1] + m * rt2[1];
+    rt[2] = rt1[2] + m * rt2[2];
+    rt[3] = rt1[3];
+
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
   }
+#endif
 }
 
 static void do_add_effect_float(
     float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
 {
   int xo;
-  float fac1, fac3;
   float *rt1, *rt2, *rt;
 
   xo = x;
@@ -1083,40 +1215,21 @@ static void do_add_effect_float(
   rt2 = rect2;
   rt = out;
 
-  fac1 = facf0;
-  fac3 = facf1;
-
   while (y--) {
-    x = xo;
-    while (x--) {
-      const float m = (1.0f - (rt1[3] * (1.0f - fac1))) * rt2[3];
-      rt[0] = rt1[0] + m * rt2[0];
-      rt[1] = rt1[1] + m * rt2[1];
-      rt[2] = rt1[2] + m * rt2[2];
-      rt[3] = rt1[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    add_row_float(facf0, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
-      const float m = (1.0f - (rt1[3] * (1.0f - fac3))) * rt2[3];
-      rt[0] = rt1[0] + m * rt2[0];
-      rt[1] = rt1[1] + m * rt2[1];
-      rt[2] = rt1[2] + m * rt2[2];
-      rt[3] = rt1[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    add_row_float(facf1, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
   }
 }
 
@@ -1396,6 +1509,54 @@ static void do_drop_effect_float(
 
 /*********************** Mul *************************/
 
+static void mul_row_byte(
+    int fac, int x, const unsigned char *rt1, const unsigned char *rt2, unsigned char *rt)
+{
+#ifdef __SSE2__
+  /* Same as the scalar code below: a - ceil(fac * a * (255 - b) / 65536), split into the high
+   * and low 16 bits of the product so it fits SSE2 multiplies. */
+  if (fac >= 0 && fac <= 256) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i f = _mm_set1_epi16((short)fac);
+    const __m128i c255 = _mm_set1_epi16(255);
+
+    for (; x >= 4; x -= 4) {
+      const __m128i c1 = _mm_loadu_si128((const __m128i *)rt1);
+      const __m128i c2 = _mm_loadu_si128((const __m128i *)rt2);
+      __m128i res[2];
+
+      for (int i = 0; i < 2; i++) {
+        const __m128i a = i ? _mm_unpackhi_epi8(c1, zero) : _mm_unpacklo_epi8(c1, zero);
+        const __m128i b = i ? _mm_unpackhi_epi8(c2, zero) : _mm_unpacklo_epi8(c2, zero);
+        const __m128i t = _mm_mullo_epi16(a, _mm_sub_epi16(c255, b));
+        const __m128i hi = _mm_mulhi_epu16(t, f);
+        const __m128i lo_zero = _mm_cmpeq_epi16(_mm_mullo_epi16(t, f), zero);
+        /* Round up, unless the low bits are zero (lo_zero is -1 there). */
+        const __m128i ceil = _mm_add_epi16(_mm_add_epi16(hi, _mm_set1_epi16(1)), lo_zero);
+
+        res[i] = _mm_sub_epi16(a, ceil);
+      }
+
+      _mm_storeu_si128((__m128i *)rt, _mm_packus_epi16(res[0], res[1]));
+      rt1 += 16;
+      rt2 += 16;
+      rt += 16;
+    }
+  }
+#endif
+
+  while (x--) {
+    rt[0] = rt1[0] + ((fac * rt1[0] * (rt2[0] - 255)) >> 16);
+    rt[1] = rt1[1] + ((fac * rt1[1] * (rt2[1] - 255)) >> 16);
+    rt[2] = rt1[2] + ((fac * rt1[2] * (rt2[2] - 255)) >> 16);
+    rt[3] = rt1[3] + ((fac * rt1[3] * (rt2[3] - 255)) >> 16);
+
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
+  }
+}
+
 static void do_mul_effect_byte(float facf0,
                                float facf1,
                                int x,
@@ -1416,50 +1577,60 @@ static void do_mul_effect_byte(float facf0,
   fac3 = (int)(256.0f * facf1);
 
   /* formula:
-   * fac * (a * b) + (1 - fac) * a  => fac * a * (b - 1) + axaux = c * px + py * s; //+centx
-   * yaux = -s * px + c * py; //+centy
+   * fac * (a * b) + (1 - fac) * a  =>  fac * a * (b - 1) + a
    */
 
   while (y--) {
-
-    x = xo;
-    while (x--) {
-
-      rt[0] = rt1[0] + ((fac1 * rt1[0] * (rt2[0] - 255)) >> 16);
-      rt[1] = rt1[1] + ((fac1 * rt1[1] * (rt2[1] - 255)) >> 16);
-      rt[2] = rt1[2] + ((fac1 * rt1[2] * (rt2[2] - 255)) >> 16);
-      rt[3] = rt1[3] + ((fac1 * rt1[3] * (rt2[3] - 255)) >> 16);
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    mul_row_byte(fac1, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
+    mul_row_byte(fac3, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
+  }
+}
 
-      rt[0] = rt1[0] + ((fac3 * rt1[0] * (rt2[0] - 255)) >> 16);
-      rt[1] = rt1[1] + ((fac3 * rt1[1] * (rt2[1] - 255)) >> 16);
-      rt[2] = rt1[2] + ((fac3 * rt1[2] * (rt2[2] - 255)) >> 16);
-      rt[3] = rt1[3] + ((fac3 * rt1[3] * (rt2[3] - 255)) >> 16);
+static void mul_row_float(float fac, int x, const float *rt1, const float *rt2, float *rt)
+{
+#ifdef __SSE2__
+  const __m128 vfac = _mm_set1_ps(fac);
+  const __m128 one = _mm_set1_ps(1.0f);
 
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+  while (x--) {
+    const __m128 c1 = _mm_loadu_ps(rt1);
+    const __m128 c2 = _mm_loadu_ps(rt2);
+
+    _mm_storeu_ps(rt, _mm_add_ps(c1, _mm_mul_ps(_mm_mul_ps(vfac, c1), _mm_sub_ps(c2, one))));
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
+  }
+#else
+  while (x--) {
+    rt[0] = rt1[0] + fac * rt1[0] * (rt2[0] - 1.0f);
+    rt[1] = rt1[1] + fac * rt1[1] * (rt2[1] - 1.0f);
+    rt[2] = rt1[2] + fac * rt1[2] * (rt2[2] - 1.0f);
+    rt[3] = rt1[3] + fac * rt1[3] * (rt2[3] - 1.0f);
+
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
   }
+#endif
 }
 
 static void do_mul_effect_float(
     float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
 {
   int xo;
-  float fac1, fac3;
   float *rt1, *rt2, *rt;
 
   xo = x;
@@ -1467,42 +1638,25 @@ static void do_mul_effect_float(
   rt2 = rect2;
   rt = out;
 
-  fac1 = facf0;
-  fac3 = facf1;
-
   /* formula:
    * fac * (a * b) + (1 - fac) * a  =>  fac * a * (b - 1) + a
    */
 
   while (y--) {
-    x = xo;
-    while (x--) {
-      rt[0] = rt1[0] + fac1 * rt1[0] * (rt2[0] - 1.0f);
-      rt[1] = rt1[1] + fac1 * rt1[1] * (rt2[1] - 1.0f);
-      rt[2] = rt1[2] + fac1 * rt1[2] * (rt2[2] - 1.0f);
-      rt[3] = rt1[3] + fac1 * rt1[3] * (rt2[3] - 1.0f);
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    mul_row_float(facf0, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
-      rt[0] = rt1[0] + fac3 * rt1[0] * (rt2[0] - 1.0f);
-      rt[1] = rt1[1] + fac3 * rt1[1] * (rt2[1] - 1.0f);
-      rt[2] = rt1[2] + fac3 * rt1[2] * (rt2[2] - 1.0f);
-      rt[3] = rt1[3] + fac3 * rt1[3] * (rt2[3] - 1.0f);
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    mul_row_float(facf1, xo, rt1, rt2, rt);
+    rt1 += xo * 4;
+    rt2 += xo * 4;
+    rt += xo * 4;
   }
 }
 
@@ -39,6 +39,7 @@
 #include "DNA_object_types.h"
 #include "DNA_sound_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_math.h"
 #include "BLI_fileops.h"
@@ -47,6 +48,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -903,6 +905,20 @@ void BKE_sequence_calc(Scene *scene, Sequence *seq)
   }
 }
 
+/* ImBuf flags movie strips are opened with. */
+static int seq_anim_ib_flags(const Sequence *seq)
+{
+  int flags = IB_rect | IB_animseekindex;
+
+  if (seq->flag & SEQ_FILTERY) {
+    flags |= IB_animdeinterlace;
+  }
+  if (U.video_flag & USER_VIDEO_HW_DECODE) {
+    flags |= IB_animhwaccel;
+  }
+  return flags;
+}
+
 static void seq_multiview_name(Scene *scene,
                                const int view_id,
                                const char *prefix,
@@ -978,7 +994,7 @@ void BKE_sequence_reload_new_file(Main *bmain, Scene *scene, Sequence *seq, cons
 
             seq_multiview_name(scene, i, prefix, ext, str, FILE_MAX);
             anim = openanim(str,
-                            IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                            seq_anim_ib_flags(seq),
                             seq->streamindex,
                             seq->strip->colorspace_settings.name);
 
@@ -996,7 +1012,7 @@ void BKE_sequence_reload_new_file(Main *bmain, Scene *scene, Sequence *seq, cons
       if (is_multiview_loaded == false) {
         struct anim *anim;
         anim = openanim(path,
-                        IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                        seq_anim_ib_flags(seq),
                         seq->streamindex,
                         seq->strip->colorspace_settings.name);
         if (anim) {
@@ -1704,14 +1720,13 @@ static void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
         if (openfile) {
           sanim->anim = openanim(str,
-                                 IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                 seq_anim_ib_flags(seq),
                                  seq->streamindex,
                                  seq->strip->colorspace_settings.name);
         }
         else {
           sanim->anim = openanim_noload(str,
-                                        IB_rect |
-                                            ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                        seq_anim_ib_flags(seq),
                                         seq->streamindex,
                                         seq->strip->colorspace_settings.name);
         }
@@ -1723,14 +1738,13 @@ static void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
         else {
           if (openfile) {
             sanim->anim = openanim(name,
-                                   IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                   seq_anim_ib_flags(seq),
                                    seq->streamindex,
                                    seq->strip->colorspace_settings.name);
           }
           else {
             sanim->anim = openanim_noload(name,
-                                          IB_rect |
-                                              ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                          seq_anim_ib_flags(seq),
                                           seq->streamindex,
                                           seq->strip->colorspace_settings.name);
           }
@@ -1755,13 +1769,13 @@ static void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
     if (openfile) {
       sanim->anim = openanim(name,
-                             IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                             seq_anim_ib_flags(seq),
                              seq->streamindex,
                              seq->strip->colorspace_settings.name);
     }
     else {
       sanim->anim = openanim_noload(name,
-                                    IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                    seq_anim_ib_flags(seq),
                                     seq->streamindex,
                                     seq->strip->colorspace_settings.name);
     }
@@ -3902,6 +3916,131 @@ static int seq_get_early_out_for_blend_mode(Sequence *seq)
   return early_out;
 }
 
+/* Strips that read data shared with other renders (other scenes, clips, masks, fonts or strips
+ * in other channels) must be rendered by one thread at a time. */
+static bool seq_render_strip_needs_lock(Sequence *seq)
+{
+  if (seq == NULL) {
+    return false;
+  }
+
+  if (ELEM(seq->type,
+           SEQ_TYPE_SCENE,
+           SEQ_TYPE_MOVIECLIP,
+           SEQ_TYPE_MASK,
+           SEQ_TYPE_TEXT,
+           SEQ_TYPE_MULTICAM,
+           SEQ_TYPE_ADJUSTMENT)) {
+    return true;
+  }
+
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_id || seq_render_strip_needs_lock(smd->mask_sequence)) {
+      return true;
+    }
+  }
+
+  LISTBASE_FOREACH (Sequence *, seq_meta, &seq->seqbase) {
+    if (seq_render_strip_needs_lock(seq_meta)) {
+      return true;
+    }
+  }
+
+  return seq_render_strip_needs_lock(seq->seq1) || seq_render_strip_needs_lock(seq->seq2) ||
+         seq_render_strip_needs_lock(seq->seq3);
+}
+
+/* Strip can be rendered while other strips of the stack are rendered: it doesn't read data shared
+ * with other renders, and doesn't render other strips of the stack as effect or mask input. */
+static bool seq_render_strip_is_independent(Sequence **seq_arr, int count, Sequence *seq)
+{
+  if (seq_render_strip_needs_lock(seq) || seq->seq1 || seq->seq2 || seq->seq3) {
+    return false;
+  }
+
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence) {
+      return false;
+    }
+  }
+
+  for (int i = 0; i < count; i++) {
+    if (ELEM(seq, seq_arr[i]->seq1, seq_arr[i]->seq2, seq_arr[i]->seq3)) {
+      return false;
+    }
+    LISTBASE_FOREACH (SequenceModifierData *, smd, &seq_arr[i]->modifiers) {
+      if (smd->mask_sequence == seq) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+typedef struct RenderStripsData {
+  const SeqRenderData *context;
+  SeqRenderState *state;
+  Sequence **seq_arr;
+  const int *render_index;
+  float cfra;
+  ImBuf **r_ibufs;
+  float *r_costs;
+} RenderStripsData;
+
+static void seq_render_strips_cb(void *__restrict userdata,
+                                 const int iter,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RenderStripsData *data = userdata;
+  const int i = data->render_index[iter];
+  clock_t begin = seq_estimate_render_cost_begin();
+
+  data->r_ibufs[i] = seq_render_strip(data->context, data->state, data->seq_arr[i], data->cfra);
+  data->r_costs[i] = seq_estimate_render_cost_end(data->context->scene, begin);
+}
+
+/* Render strips from seq_arr[start] up, which are blended over the result of lower channels,
+ * in parallel. Strips that need to be rendered by one thread at a time are skipped and left
+ * NULL in r_ibufs. */
+static void seq_render_strips_parallel(const SeqRenderData *context,
+                                       SeqRenderState *state,
+                                       Sequence **seq_arr,
+                                       int start,
+                                       int count,
+                                       float cfra,
+                                       ImBuf **r_ibufs,
+                                       float *r_costs)
+{
+  int render_index[MAXSEQ + 1];
+  int render_count = 0;
+
+  for (int i = start; i < count; i++) {
+    if (seq_get_early_out_for_blend_mode(seq_arr[i]) == EARLY_DO_EFFECT &&
+        seq_render_strip_is_independent(seq_arr, count, seq_arr[i])) {
+      render_index[render_count++] = i;
+    }
+  }
+
+  if (render_count < 2) {
+    return;
+  }
+
+  RenderStripsData data = {
+      .context = context,
+      .state = state,
+      .seq_arr = seq_arr,
+      .render_index = render_index,
+      .cfra = cfra,
+      .r_ibufs = r_ibufs,
+      .r_costs = r_costs,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, render_count, &data, seq_render_strips_cb, &settings);
+}
+
 static ImBuf *seq_render_strip_stack_apply_effect(
     const SeqRenderData *context, Sequence *seq, float cfra, ImBuf *ibuf1, ImBuf *ibuf2)
 {
@@ -3999,13 +4138,19 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+
+  /* Strips blended on top don't depend on each other, render them before blending. */
+  ImBuf *ibufs[MAXSEQ + 1] = {NULL};
+  float costs[MAXSEQ + 1] = {0.0f};
+  seq_render_strips_parallel(context, state, seq_arr, i, count, cfra, ibufs, costs);
+
   for (; i < count; i++) {
     begin = seq_estimate_render_cost_begin();
     Sequence *seq = seq_arr[i];
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, cfra);
+      ImBuf *ibuf2 = ibufs[i] ? ibufs[i] : seq_render_strip(context, state, seq, cfra);
 
       out = seq_render_strip_stack_apply_effect(context, seq, cfra, ibuf1, ibuf2);
 
@@ -4013,13 +4158,31 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
       IMB_freeImBuf(ibuf2);
     }
 
-    float cost = seq_estimate_render_cost_end(context->scene, begin);
+    float cost = seq_estimate_render_cost_end(context->scene, begin) + costs[i];
     BKE_sequencer_cache_put(context, seq_arr[i], cfra, SEQ_CACHE_STORE_COMPOSITE, out, cost);
   }
 
   return out;
 }
 
+static bool seq_render_stack_needs_lock(const SeqRenderData *context,
+                                        Sequence **seq_arr,
+                                        int count)
+{
+  /* Prefetch workers render with their own copy of the scene, so stacks of independent strips
+   * can be rendered while other frames are being rendered. */
+  if (!context->is_prefetch_render) {
+    return true;
+  }
+
+  for (int i = 0; i < count; i++) {
+    if (seq_render_strip_needs_lock(seq_arr[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /*
  * returned ImBuf is refed!
  * you have to free after usage!
@@ -4062,7 +4225,10 @@ ImBuf *BKE_sequencer_give_ibuf(const SeqRenderData *context, float cfra, int cha
   float cost = 0;
 
   if (count && !out) {
-    BLI_mutex_lock(&seq_render_mutex);
+    const bool use_lock = seq_render_stack_needs_lock(context, seq_arr, count);
+    if (use_lock) {
+      BLI_mutex_lock(&seq_render_mutex);
+    }
     out = seq_render_strip_stack(context, &state, seqbasep, cfra, chanshown);
     cost = seq_estimate_render_cost_end(context->scene, begin);
 
@@ -4074,7 +4240,9 @@ ImBuf *BKE_sequencer_give_ibuf(const SeqRenderData *context, float cfra, int cha
       BKE_sequencer_cache_put_if_possible(
           context, seq_arr[count - 1], cfra, SEQ_CACHE_STORE_FINAL_OUT, out, cost);
     }
-    BLI_mutex_unlock(&seq_render_mutex);
+    if (use_lock) {
+      BLI_mutex_unlock(&seq_render_mutex);
+    }
   }
 
   BKE_sequencer_prefetch_start(context, cfra, cost);
@@ -69,6 +69,10 @@
 /* Util macros */
 #define OUT_OF_MEMORY() ((void)printf("Shrinkwrap: Out of memory\n"))
 
+/* Every vertex does at least one BVH query, so threading already pays off
+ * on meshes much smaller than #BKE_MESH_OMP_LIMIT. */
+#define SHRINKWRAP_MIN_ITER_PER_THREAD 256
+
 typedef struct ShrinkwrapCalcData {
   ShrinkwrapModifierData *smd;  // shrinkwrap modifier data
 
@@ -419,7 +423,7 @@ static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
   };
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (calc->numVerts > BKE_MESH_OMP_LIMIT);
+  settings.min_iter_per_thread = SHRINKWRAP_MIN_ITER_PER_THREAD;
   settings.userdata_chunk = &nearest;
   settings.userdata_chunk_size = sizeof(nearest);
   BLI_task_parallel_range(
@@ -706,7 +710,7 @@ static void shrinkwrap_calc_normal_projection(ShrinkwrapCalcData *calc)
   };
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (calc->numVerts > BKE_MESH_OMP_LIMIT);
+  settings.min_iter_per_thread = SHRINKWRAP_MIN_ITER_PER_THREAD;
   settings.userdata_chunk = &hit;
   settings.userdata_chunk_size = sizeof(hit);
   BLI_task_parallel_range(
@@ -1389,7 +1393,7 @@ static void shrinkwrap_calc_nearest_surface_point(ShrinkwrapCalcData *calc)
   };
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (calc->numVerts > BKE_MESH_OMP_LIMIT);
+  settings.min_iter_per_thread = SHRINKWRAP_MIN_ITER_PER_THREAD;
   settings.userdata_chunk = &nearest;
   settings.userdata_chunk_size = sizeof(nearest);
   BLI_task_parallel_range(
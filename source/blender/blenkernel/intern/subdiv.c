@@ -27,6 +27,8 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_listbase.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "MEM_guardedalloc.h"
@@ -137,6 +139,80 @@ Subdiv *BKE_subdiv_new_from_mesh(const SubdivSettings *settings, const Mesh *mes
   return subdiv;
 }
 
+/* Global cache of descriptors which are no longer used by their owner.
+ *
+ * Creating topology refiner, stencils and patch tables is the expensive part of the
+ * subdivision surface. Keeping descriptors around after they were released by a modifier
+ * allows to re-use them when runtime data of the modifier gets freed and re-created for the
+ * same topology, which happens on copy-on-write updates and undo. */
+
+/* Maximum number of released descriptors kept in the cache. */
+#define SUBDIV_CACHE_MAX_LEN 8
+
+static ListBase subdiv_cache = {NULL, NULL};
+static int subdiv_cache_len = 0;
+static ThreadMutex subdiv_cache_lock = BLI_MUTEX_INITIALIZER;
+
+/* Take descriptor which matches given settings and topology out of the cache.
+ * Returns NULL if there is no such descriptor. */
+static Subdiv *subdiv_cache_acquire(const SubdivSettings *settings,
+                                    OpenSubdiv_Converter *converter)
+{
+  Subdiv *result = NULL;
+  const int num_faces = converter->getNumFaces(converter);
+  BLI_mutex_lock(&subdiv_cache_lock);
+  LISTBASE_FOREACH (LinkData *, link, &subdiv_cache) {
+    Subdiv *subdiv = link->data;
+    OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
+    if (!BKE_subdiv_settings_equal(&subdiv->settings, settings) ||
+        topology_refiner->getNumFaces(topology_refiner) != num_faces) {
+      continue;
+    }
+    if (openSubdiv_topologyRefinerCompareWithConverter(topology_refiner, converter)) {
+      BLI_freelinkN(&subdiv_cache, link);
+      subdiv_cache_len--;
+      result = subdiv;
+      break;
+    }
+  }
+  BLI_mutex_unlock(&subdiv_cache_lock);
+  return result;
+}
+
+void BKE_subdiv_cache_release(Subdiv *subdiv)
+{
+  if (subdiv->topology_refiner == NULL) {
+    BKE_subdiv_free(subdiv);
+    return;
+  }
+  /* Displacement is attached for every evaluation, no need to keep it. */
+  BKE_subdiv_displacement_detach(subdiv);
+  Subdiv *subdiv_evicted = NULL;
+  BLI_mutex_lock(&subdiv_cache_lock);
+  BLI_addhead(&subdiv_cache, BLI_genericNodeN(subdiv));
+  if (++subdiv_cache_len > SUBDIV_CACHE_MAX_LEN) {
+    LinkData *link = subdiv_cache.last;
+    subdiv_evicted = link->data;
+    BLI_freelinkN(&subdiv_cache, link);
+    subdiv_cache_len--;
+  }
+  BLI_mutex_unlock(&subdiv_cache_lock);
+  if (subdiv_evicted != NULL) {
+    BKE_subdiv_free(subdiv_evicted);
+  }
+}
+
+void BKE_subdiv_cache_free(void)
+{
+  BLI_mutex_lock(&subdiv_cache_lock);
+  LISTBASE_FOREACH (LinkData *, link, &subdiv_cache) {
+    BKE_subdiv_free(link->data);
+  }
+  BLI_freelistN(&subdiv_cache);
+  subdiv_cache_len = 0;
+  BLI_mutex_unlock(&subdiv_cache_lock);
+}
+
 /* Creation with cached-aware semantic. */
 
 Subdiv *BKE_subdiv_update_from_converter(Subdiv *subdiv,
@@ -162,10 +238,19 @@ Subdiv *BKE_subdiv_update_from_converter(Subdiv *subdiv,
   if (can_reuse_subdiv) {
     return subdiv;
   }
-  /* Create new subdiv. */
+  /* Previously released descriptor might match, for example when the topology was changed by
+   * a modifier which got disabled again. */
+  Subdiv *subdiv_cached = NULL;
+  if (converter->getNumVertices(converter) != 0) {
+    subdiv_cached = subdiv_cache_acquire(settings, converter);
+  }
   if (subdiv != NULL) {
-    BKE_subdiv_free(subdiv);
+    BKE_subdiv_cache_release(subdiv);
+  }
+  if (subdiv_cached != NULL) {
+    return subdiv_cached;
   }
+  /* Create new subdiv. */
   return BKE_subdiv_new_from_converter(settings, converter);
 }
 
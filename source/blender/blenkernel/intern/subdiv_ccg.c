@@ -38,6 +38,7 @@
 #include "BKE_subdiv.h"
 #include "BKE_subdiv_eval.h"
 
+#include "opensubdiv_capi_type.h"
 #include "opensubdiv_topology_refiner_capi.h"
 
 /* =============================================================================
@@ -213,14 +214,75 @@ static void subdiv_ccg_eval_grid_element_mask(CCGEvalGridsData *data,
   }
 }
 
-static void subdiv_ccg_eval_grid_element(CCGEvalGridsData *data,
-                                         const int ptex_face_index,
-                                         const float u,
-                                         const float v,
-                                         unsigned char *element)
+/* Scratch storage for the batched evaluation of a single grid. */
+typedef struct CCGEvalGridBuffers {
+  OpenSubdiv_PatchCoord *patch_coords;
+  float (*P)[3];
+  float (*dPdu)[3];
+  float (*dPdv)[3];
+} CCGEvalGridBuffers;
+
+static void subdiv_ccg_eval_grid_buffers_alloc(CCGEvalGridsData *data,
+                                               CCGEvalGridBuffers *buffers)
+{
+  const SubdivCCG *subdiv_ccg = data->subdiv_ccg;
+  const int grid_area = subdiv_ccg->grid_size * subdiv_ccg->grid_size;
+  buffers->patch_coords = MEM_malloc_arrayN(
+      grid_area, sizeof(*buffers->patch_coords), "CCG grid patch coords");
+  buffers->P = NULL;
+  buffers->dPdu = NULL;
+  buffers->dPdv = NULL;
+  /* Displacement needs derivatives for every point, which is done in the element evaluation. */
+  if (data->subdiv->displacement_evaluator != NULL) {
+    return;
+  }
+  buffers->P = MEM_malloc_arrayN(grid_area, sizeof(*buffers->P), "CCG grid P");
+  if (subdiv_ccg->has_normal) {
+    buffers->dPdu = MEM_malloc_arrayN(grid_area, sizeof(*buffers->dPdu), "CCG grid dPdu");
+    buffers->dPdv = MEM_malloc_arrayN(grid_area, sizeof(*buffers->dPdv), "CCG grid dPdv");
+  }
+}
+
+static void subdiv_ccg_eval_grid_buffers_free(CCGEvalGridBuffers *buffers)
+{
+  MEM_freeN(buffers->patch_coords);
+  MEM_SAFE_FREE(buffers->P);
+  MEM_SAFE_FREE(buffers->dPdu);
+  MEM_SAFE_FREE(buffers->dPdv);
+}
+
+/* Evaluate all elements of the grid at the patch coordinates stored in the buffers.
+ * Limit surface is evaluated with a single batched query when there is no displacement. */
+static void subdiv_ccg_eval_grid_elements(CCGEvalGridsData *data,
+                                          CCGEvalGridBuffers *buffers,
+                                          unsigned char *grid)
 {
-  subdiv_ccg_eval_grid_element_limit(data, ptex_face_index, u, v, element);
-  subdiv_ccg_eval_grid_element_mask(data, ptex_face_index, u, v, element);
+  SubdivCCG *subdiv_ccg = data->subdiv_ccg;
+  const int grid_area = subdiv_ccg->grid_size * subdiv_ccg->grid_size;
+  const int element_size = element_size_bytes_get(subdiv_ccg);
+  const OpenSubdiv_PatchCoord *patch_coords = buffers->patch_coords;
+  if (buffers->P != NULL) {
+    BKE_subdiv_eval_limit_points_and_derivatives(
+        data->subdiv, patch_coords, grid_area, buffers->P, buffers->dPdu, buffers->dPdv);
+  }
+  for (int i = 0; i < grid_area; i++) {
+    unsigned char *element = &grid[(size_t)i * element_size];
+    const OpenSubdiv_PatchCoord *patch_coord = &patch_coords[i];
+    if (buffers->P == NULL) {
+      subdiv_ccg_eval_grid_element_limit(
+          data, patch_coord->ptex_face, patch_coord->u, patch_coord->v, element);
+    }
+    else {
+      copy_v3_v3((float *)element, buffers->P[i]);
+      if (subdiv_ccg->has_normal) {
+        float *normal = (float *)(element + subdiv_ccg->normal_offset);
+        cross_v3_v3v3(normal, buffers->dPdu[i], buffers->dPdv[i]);
+        normalize_v3(normal);
+      }
+    }
+    subdiv_ccg_eval_grid_element_mask(
+        data, patch_coord->ptex_face, patch_coord->u, patch_coord->v, element);
+  }
 }
 
 static void subdiv_ccg_eval_regular_grid(CCGEvalGridsData *data, const int face_index)
@@ -229,30 +291,31 @@ static void subdiv_ccg_eval_regular_grid(CCGEvalGridsData *data, const int face_
   const int ptex_face_index = data->face_ptex_offset[face_index];
   const int grid_size = subdiv_ccg->grid_size;
   const float grid_size_1_inv = 1.0f / (float)(grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   SubdivCCGFace *faces = subdiv_ccg->faces;
   SubdivCCGFace **grid_faces = subdiv_ccg->grid_faces;
   const SubdivCCGFace *face = &faces[face_index];
+  CCGEvalGridBuffers buffers;
+  subdiv_ccg_eval_grid_buffers_alloc(data, &buffers);
   for (int corner = 0; corner < face->num_grids; corner++) {
     const int grid_index = face->start_grid_index + corner;
     unsigned char *grid = (unsigned char *)subdiv_ccg->grids[grid_index];
+    OpenSubdiv_PatchCoord *patch_coord = buffers.patch_coords;
     for (int y = 0; y < grid_size; y++) {
       const float grid_v = (float)y * grid_size_1_inv;
-      for (int x = 0; x < grid_size; x++) {
+      for (int x = 0; x < grid_size; x++, patch_coord++) {
         const float grid_u = (float)x * grid_size_1_inv;
-        float u, v;
-        BKE_subdiv_rotate_grid_to_quad(corner, grid_u, grid_v, &u, &v);
-        const size_t grid_element_index = (size_t)y * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
-        subdiv_ccg_eval_grid_element(data, ptex_face_index, u, v, &grid[grid_element_offset]);
+        patch_coord->ptex_face = ptex_face_index;
+        BKE_subdiv_rotate_grid_to_quad(corner, grid_u, grid_v, &patch_coord->u, &patch_coord->v);
       }
     }
+    subdiv_ccg_eval_grid_elements(data, &buffers, grid);
     /* Assign grid's face. */
     grid_faces[grid_index] = &faces[face_index];
     /* Assign material flags. */
     subdiv_ccg->grid_flag_mats[grid_index] = data->material_flags_evaluator->eval_material_flags(
         data->material_flags_evaluator, face_index);
   }
+  subdiv_ccg_eval_grid_buffers_free(&buffers);
 }
 
 static void subdiv_ccg_eval_special_grid(CCGEvalGridsData *data, const int face_index)
@@ -260,29 +323,32 @@ static void subdiv_ccg_eval_special_grid(CCGEvalGridsData *data, const int face_
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   const int grid_size = subdiv_ccg->grid_size;
   const float grid_size_1_inv = 1.0f / (float)(grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   SubdivCCGFace *faces = subdiv_ccg->faces;
   SubdivCCGFace **grid_faces = subdiv_ccg->grid_faces;
   const SubdivCCGFace *face = &faces[face_index];
+  CCGEvalGridBuffers buffers;
+  subdiv_ccg_eval_grid_buffers_alloc(data, &buffers);
   for (int corner = 0; corner < face->num_grids; corner++) {
     const int grid_index = face->start_grid_index + corner;
     const int ptex_face_index = data->face_ptex_offset[face_index] + corner;
     unsigned char *grid = (unsigned char *)subdiv_ccg->grids[grid_index];
+    OpenSubdiv_PatchCoord *patch_coord = buffers.patch_coords;
     for (int y = 0; y < grid_size; y++) {
       const float u = 1.0f - ((float)y * grid_size_1_inv);
-      for (int x = 0; x < grid_size; x++) {
-        const float v = 1.0f - ((float)x * grid_size_1_inv);
-        const size_t grid_element_index = (size_t)y * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
-        subdiv_ccg_eval_grid_element(data, ptex_face_index, u, v, &grid[grid_element_offset]);
+      for (int x = 0; x < grid_size; x++, patch_coord++) {
+        patch_coord->ptex_face = ptex_face_index;
+        patch_coord->u = u;
+        patch_coord->v = 1.0f - ((float)x * grid_size_1_inv);
       }
     }
+    subdiv_ccg_eval_grid_elements(data, &buffers, grid);
     /* Assign grid's face. */
     grid_faces[grid_index] = &faces[face_index];
     /* Assign material flags. */
     subdiv_ccg->grid_flag_mats[grid_index] = data->material_flags_evaluator->eval_material_flags(
         data->material_flags_evaluator, face_index);
   }
+  subdiv_ccg_eval_grid_buffers_free(&buffers);
 }
 
 static void subdiv_ccg_eval_grids_task(void *__restrict userdata_v,
@@ -35,6 +35,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
 #include "opensubdiv_evaluator_capi.h"
 #include "opensubdiv_topology_refiner_capi.h"
 
@@ -266,6 +267,41 @@ void BKE_subdiv_eval_final_point(
   }
 }
 
+/* ============================ Batched queries ============================= */
+
+void BKE_subdiv_eval_limit_points_and_derivatives(Subdiv *subdiv,
+                                                  const OpenSubdiv_PatchCoord *patch_coords,
+                                                  const int num_patch_coords,
+                                                  float (*r_P)[3],
+                                                  float (*r_dPdu)[3],
+                                                  float (*r_dPdv)[3])
+{
+  BLI_assert((r_dPdu == NULL) == (r_dPdv == NULL));
+  subdiv->evaluator->evaluatePatchesLimit(subdiv->evaluator,
+                                          patch_coords,
+                                          num_patch_coords,
+                                          (float *)r_P,
+                                          (float *)r_dPdu,
+                                          (float *)r_dPdv);
+  if (r_dPdu == NULL) {
+    return;
+  }
+  /* Same as for the single point query: step inside of the face for points where derivatives
+   * are degenerate. This is rare, so the single point evaluation is fine here. */
+  for (int i = 0; i < num_patch_coords; i++) {
+    if (is_zero_v3(r_dPdu[i]) || is_zero_v3(r_dPdv[i])) {
+      const OpenSubdiv_PatchCoord *patch_coord = &patch_coords[i];
+      BKE_subdiv_eval_limit_point_and_derivatives(subdiv,
+                                                  patch_coord->ptex_face,
+                                                  patch_coord->u,
+                                                  patch_coord->v,
+                                                  r_P[i],
+                                                  r_dPdu[i],
+                                                  r_dPdv[i]);
+    }
+  }
+}
+
 /* ===================  Patch queries at given resolution =================== */
 
 /* Move buffer forward by a given number of bytes. */
@@ -286,6 +322,43 @@ static void buffer_write_short_value(void **buffer, const short *values_buffer,
   memcpy(*buffer, values_buffer, sizeof(short) * num_values);
 }
 
+/* Evaluate all points of the patch at the given resolution with a single batched query.
+ * Derivatives are only evaluated when r_dPdu and r_dPdv are not NULL.
+ * Returned arrays are to be freed with MEM_freeN(). */
+static void subdiv_eval_patch_resolution(Subdiv *subdiv,
+                                         const int ptex_face_index,
+                                         const int resolution,
+                                         float (**r_P)[3],
+                                         float (**r_dPdu)[3],
+                                         float (**r_dPdv)[3])
+{
+  const int num_points = resolution * resolution;
+  OpenSubdiv_PatchCoord *patch_coords = MEM_malloc_arrayN(
+      num_points, sizeof(*patch_coords), "subdiv patch coords");
+  const float inv_resolution_1 = 1.0f / (float)(resolution - 1);
+  for (int y = 0, i = 0; y < resolution; y++) {
+    const float v = y * inv_resolution_1;
+    for (int x = 0; x < resolution; x++, i++) {
+      patch_coords[i].ptex_face = ptex_face_index;
+      patch_coords[i].u = x * inv_resolution_1;
+      patch_coords[i].v = v;
+    }
+  }
+  float(*P)[3] = MEM_malloc_arrayN(num_points, sizeof(*P), "subdiv patch P");
+  float(*dPdu)[3] = NULL, (*dPdv)[3] = NULL;
+  if (r_dPdu != NULL) {
+    dPdu = MEM_malloc_arrayN(num_points, sizeof(*dPdu), "subdiv patch dPdu");
+    dPdv = MEM_malloc_arrayN(num_points, sizeof(*dPdv), "subdiv patch dPdv");
+  }
+  BKE_subdiv_eval_limit_points_and_derivatives(subdiv, patch_coords, num_points, P, dPdu, dPdv);
+  MEM_freeN(patch_coords);
+  *r_P = P;
+  if (r_dPdu != NULL) {
+    *r_dPdu = dPdu;
+    *r_dPdv = dPdv;
+  }
+}
+
 void BKE_subdiv_eval_limit_patch_resolution_point(Subdiv *subdiv,
                                                   const int ptex_face_index,
                                                   const int resolution,
@@ -293,16 +366,15 @@ void BKE_subdiv_eval_limit_patch_resolution_point(Subdiv *subdiv,
                                                   const int offset,
                                                   const int stride)
 {
+  float(*P)[3];
+  subdiv_eval_patch_resolution(subdiv, ptex_face_index, resolution, &P, NULL, NULL);
   buffer_apply_offset(&buffer, offset);
-  const float inv_resolution_1 = 1.0f / (float)(resolution - 1);
-  for (int y = 0; y < resolution; y++) {
-    const float v = y * inv_resolution_1;
-    for (int x = 0; x < resolution; x++) {
-      const float u = x * inv_resolution_1;
-      BKE_subdiv_eval_limit_point(subdiv, ptex_face_index, u, v, buffer);
-      buffer_apply_offset(&buffer, stride);
-    }
+  const int num_points = resolution * resolution;
+  for (int i = 0; i < num_points; i++) {
+    buffer_write_float_value(&buffer, P[i], 3);
+    buffer_apply_offset(&buffer, stride);
   }
+  MEM_freeN(P);
 }
 
 void BKE_subdiv_eval_limit_patch_resolution_point_and_derivatives(Subdiv *subdiv,
@@ -318,21 +390,23 @@ void BKE_subdiv_eval_limit_patch_resolution_point_and_derivatives(Subdiv *subdiv
                                                                   const int dv_offset,
                                                                   const int dv_stride)
 {
+  float(*P)[3], (*dPdu)[3], (*dPdv)[3];
+  subdiv_eval_patch_resolution(subdiv, ptex_face_index, resolution, &P, &dPdu, &dPdv);
   buffer_apply_offset(&point_buffer, point_offset);
   buffer_apply_offset(&du_buffer, du_offset);
   buffer_apply_offset(&dv_buffer, dv_offset);
-  const float inv_resolution_1 = 1.0f / (float)(resolution - 1);
-  for (int y = 0; y < resolution; y++) {
-    const float v = y * inv_resolution_1;
-    for (int x = 0; x < resolution; x++) {
-      const float u = x * inv_resolution_1;
-      BKE_subdiv_eval_limit_point_and_derivatives(
-          subdiv, ptex_face_index, u, v, point_buffer, du_buffer, dv_buffer);
-      buffer_apply_offset(&point_buffer, point_stride);
-      buffer_apply_offset(&du_buffer, du_stride);
-      buffer_apply_offset(&dv_buffer, dv_stride);
-    }
+  const int num_points = resolution * resolution;
+  for (int i = 0; i < num_points; i++) {
+    buffer_write_float_value(&point_buffer, P[i], 3);
+    buffer_write_float_value(&du_buffer, dPdu[i], 3);
+    buffer_write_float_value(&dv_buffer, dPdv[i], 3);
+    buffer_apply_offset(&point_buffer, point_stride);
+    buffer_apply_offset(&du_buffer, du_stride);
+    buffer_apply_offset(&dv_buffer, dv_stride);
   }
+  MEM_freeN(P);
+  MEM_freeN(dPdu);
+  MEM_freeN(dPdv);
 }
 
 void BKE_subdiv_eval_limit_patch_resolution_point_and_normal(Subdiv *subdiv,
@@ -345,20 +419,23 @@ void BKE_subdiv_eval_limit_patch_resolution_point_and_normal(Subdiv *subdiv,
                                                              const int normal_offset,
                                                              const int normal_stride)
 {
+  float(*P)[3], (*dPdu)[3], (*dPdv)[3];
+  subdiv_eval_patch_resolution(subdiv, ptex_face_index, resolution, &P, &dPdu, &dPdv);
   buffer_apply_offset(&point_buffer, point_offset);
   buffer_apply_offset(&normal_buffer, normal_offset);
-  const float inv_resolution_1 = 1.0f / (float)(resolution - 1);
-  for (int y = 0; y < resolution; y++) {
-    const float v = y * inv_resolution_1;
-    for (int x = 0; x < resolution; x++) {
-      const float u = x * inv_resolution_1;
-      float normal[3];
-      BKE_subdiv_eval_limit_point_and_normal(subdiv, ptex_face_index, u, v, point_buffer, normal);
-      buffer_write_float_value(&normal_buffer, normal, 3);
-      buffer_apply_offset(&point_buffer, point_stride);
-      buffer_apply_offset(&normal_buffer, normal_stride);
-    }
+  const int num_points = resolution * resolution;
+  for (int i = 0; i < num_points; i++) {
+    float normal[3];
+    cross_v3_v3v3(normal, dPdu[i], dPdv[i]);
+    normalize_v3(normal);
+    buffer_write_float_value(&point_buffer, P[i], 3);
+    buffer_write_float_value(&normal_buffer, normal, 3);
+    buffer_apply_offset(&point_buffer, point_stride);
+    buffer_apply_offset(&normal_buffer, normal_stride);
   }
+  MEM_freeN(P);
+  MEM_freeN(dPdu);
+  MEM_freeN(dPdv);
 }
 
 void BKE_subdiv_eval_limit_patch_resolution_point_and_short_normal(Subdiv *subdiv,
@@ -371,19 +448,23 @@ void BKE_subdiv_eval_limit_patch_resolution_point_and_short_normal(Subdiv *subdi
                                                                    const int normal_offset,
                                                                    const int normal_stride)
 {
+  float(*P)[3], (*dPdu)[3], (*dPdv)[3];
+  subdiv_eval_patch_resolution(subdiv, ptex_face_index, resolution, &P, &dPdu, &dPdv);
   buffer_apply_offset(&point_buffer, point_offset);
   buffer_apply_offset(&normal_buffer, normal_offset);
-  const float inv_resolution_1 = 1.0f / (float)(resolution - 1);
-  for (int y = 0; y < resolution; y++) {
-    const float v = y * inv_resolution_1;
-    for (int x = 0; x < resolution; x++) {
-      const float u = x * inv_resolution_1;
-      short normal[3];
-      BKE_subdiv_eval_limit_point_and_short_normal(
-          subdiv, ptex_face_index, u, v, point_buffer, normal);
-      buffer_write_short_value(&normal_buffer, normal, 3);
-      buffer_apply_offset(&point_buffer, point_stride);
-      buffer_apply_offset(&normal_buffer, normal_stride);
-    }
+  const int num_points = resolution * resolution;
+  for (int i = 0; i < num_points; i++) {
+    float normal[3];
+    short normal_short[3];
+    cross_v3_v3v3(normal, dPdu[i], dPdv[i]);
+    normalize_v3(normal);
+    normal_float_to_short_v3(normal_short, normal);
+    buffer_write_float_value(&point_buffer, P[i], 3);
+    buffer_write_short_value(&normal_buffer, normal_short, 3);
+    buffer_apply_offset(&point_buffer, point_stride);
+    buffer_apply_offset(&normal_buffer, normal_stride);
   }
+  MEM_freeN(P);
+  MEM_freeN(dPdu);
+  MEM_freeN(dPdv);
 }
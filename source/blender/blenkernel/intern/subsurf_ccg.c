@@ -2248,10 +2248,12 @@ static void set_ccgdm_all_geometry(CCGDerivedMesh *ccgdm,
     /*interpolate per-vert data*/
     for (s = 0; s < numVerts; s++) {
       for (y = 1; y < gridFaces; y++) {
-        for (x = 1; x < gridFaces; x++) {
-          w2 = w + s * numVerts * g2_wid * g2_wid + (y * g2_wid + x) * numVerts;
-          DM_interp_vert_data(dm, &ccgdm->dm, vertidx, w2, numVerts, vertNum);
+        /* The weights of a row are consecutive, interpolate it at once. */
+        w2 = w + s * numVerts * g2_wid * g2_wid + (y * g2_wid + 1) * numVerts;
+        CustomData_interp_batch(
+            &dm->vertData, &ccgdm->dm.vertData, vertidx, w2, numVerts, vertNum, gridFaces - 1);
 
+        for (x = 1; x < gridFaces; x++) {
           if (vertOrigIndex) {
             *vertOrigIndex = ORIGINDEX_NONE;
             vertOrigIndex++;
@@ -643,6 +643,18 @@ static ImBuf *accesscache_get(TrackingImageAccessor *accessor,
   return IMB_moviecache_get(accessor->cache, &key);
 }
 
+static ImBuf *accessor_frames_lookup(TrackingImageAccessor *accessor, int clip_index, int frame)
+{
+  for (int i = 0; i < MAX_ACCESSOR_FRAMES; i++) {
+    TrackingImageAccessorFrame *accessor_frame = &accessor->frames[i];
+    if (accessor_frame->ibuf != NULL && accessor_frame->clip_index == clip_index &&
+        accessor_frame->frame == frame) {
+      return accessor_frame->ibuf;
+    }
+  }
+  return NULL;
+}
+
 static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
                                              int clip_index,
                                              int frame)
@@ -654,6 +666,17 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
 
   BLI_assert(clip_index < accessor->num_clips);
 
+  /* Most requests come from many tracks asking for regions of the same frames. */
+  BLI_spin_lock(&accessor->cache_lock);
+  ibuf = accessor_frames_lookup(accessor, clip_index, frame);
+  if (ibuf != NULL) {
+    IMB_refImBuf(ibuf);
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+  if (ibuf != NULL) {
+    return ibuf;
+  }
+
   clip = accessor->clips[clip_index];
   scene_frame = BKE_movieclip_remap_clip_to_scene_frame(clip, frame);
   BKE_movieclip_user_set_frame(&user, scene_frame);
@@ -661,6 +684,25 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
   user.render_flag = 0;
   ibuf = BKE_movieclip_get_ibuf(clip, &user);
 
+  if (ibuf != NULL) {
+    ImBuf *ibuf_old = NULL;
+    BLI_spin_lock(&accessor->cache_lock);
+    /* Another thread might have fetched the same frame meanwhile. */
+    if (accessor_frames_lookup(accessor, clip_index, frame) == NULL) {
+      TrackingImageAccessorFrame *accessor_frame = &accessor->frames[accessor->frames_next];
+      accessor->frames_next = (accessor->frames_next + 1) % MAX_ACCESSOR_FRAMES;
+      ibuf_old = accessor_frame->ibuf;
+      accessor_frame->clip_index = clip_index;
+      accessor_frame->frame = frame;
+      accessor_frame->ibuf = ibuf;
+      IMB_refImBuf(ibuf);
+    }
+    BLI_spin_unlock(&accessor->cache_lock);
+    if (ibuf_old != NULL) {
+      IMB_freeImBuf(ibuf_old);
+    }
+  }
+
   return ibuf;
 }
 
@@ -985,6 +1027,11 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
 
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor)
 {
+  for (int i = 0; i < MAX_ACCESSOR_FRAMES; i++) {
+    if (accessor->frames[i].ibuf != NULL) {
+      IMB_freeImBuf(accessor->frames[i].ibuf);
+    }
+  }
   IMB_moviecache_free(accessor->cache);
   libmv_FrameAccessorDestroy(accessor->libmv_accessor);
   BLI_spin_end(&accessor->cache_lock);
@@ -131,8 +131,21 @@ float *tracking_track_get_mask_for_region(int frame_width,
 struct libmv_FrameAccessor;
 
 #define MAX_ACCESSOR_CLIP 64
+/* Number of original frames kept referenced by the image accessor. */
+#define MAX_ACCESSOR_FRAMES 4
+
+typedef struct TrackingImageAccessorFrame {
+  int clip_index;
+  int frame;
+  struct ImBuf *ibuf;
+} TrackingImageAccessorFrame;
+
 typedef struct TrackingImageAccessor {
   struct MovieCache *cache;
+  /* Original frames recently used by tracks, so requests from many tracks for the same frame
+   * don't all go through the (globally locked) movie clip cache. Guarded by cache_lock. */
+  TrackingImageAccessorFrame frames[MAX_ACCESSOR_FRAMES];
+  int frames_next;
   struct MovieClip *clips[MAX_ACCESSOR_CLIP];
   int num_clips;
   struct MovieTrackingTrack **tracks;
@@ -36,6 +36,8 @@
 
 #include "BLI_utildefines.h"
 #include "BLI_math_base.h"
+#include "BLI_memarena.h"
+#include "BLI_utility_mixins.h"
 
 namespace BLI {
 
@@ -100,6 +102,99 @@ class RawAllocator {
   }
 };
 
+/**
+ * Allocates from the #MemArena of the innermost #ArenaAllocatorScope of the current thread.
+ * Deallocation does nothing, all memory is freed at once when the scope ends. This makes
+ * temporary containers cheap to create and destroy, e.g. when many of them are used to
+ * evaluate something:
+ *
+ *   {
+ *     ArenaAllocatorScope scope;
+ *     Vector<int, 4, ArenaAllocator> indices;
+ *     Map<int, float, ArenaAllocator> weights;
+ *     ...
+ *   }
+ *
+ * Containers using this allocator must be destructed before their scope ends. Memory of
+ * containers that grow is only reclaimed with the scope, so this is not a good fit for
+ * long-lived containers that grow a lot.
+ */
+class ArenaAllocator {
+ private:
+  MemArena *m_arena;
+
+ public:
+  ArenaAllocator() : m_arena(active_arena())
+  {
+    BLI_assert(m_arena != nullptr);
+  }
+
+  void *allocate(uint size, const char *UNUSED(name))
+  {
+    return BLI_memarena_alloc(m_arena, size);
+  }
+
+  void *allocate_aligned(uint size, uint alignment, const char *UNUSED(name))
+  {
+    BLI_assert(is_power_of_2_i((int)alignment));
+    /* The arena aligns to 8 bytes by default. */
+    if (alignment <= 8) {
+      return BLI_memarena_alloc(m_arena, size);
+    }
+    void *ptr = BLI_memarena_alloc(m_arena, size + alignment);
+    return (void *)(((uintptr_t)ptr + alignment - 1) & ~((uintptr_t)alignment - 1));
+  }
+
+  void deallocate(void *UNUSED(ptr))
+  {
+  }
+
+  /** The arena used by allocators constructed on this thread, or null outside of a scope. */
+  static MemArena *&active_arena()
+  {
+    static thread_local MemArena *arena = nullptr;
+    return arena;
+  }
+};
+
+/**
+ * Makes a #MemArena available to #ArenaAllocator on the current thread while it exists.
+ * Scopes can be nested, the innermost one is used.
+ */
+class ArenaAllocatorScope : NonCopyable, NonMovable {
+ private:
+  MemArena *m_arena;
+  MemArena *m_previous_arena;
+  bool m_owns_arena;
+
+ public:
+  ArenaAllocatorScope() : ArenaAllocatorScope(BLI_memarena_new(1 << 16, __func__))
+  {
+    m_owns_arena = true;
+  }
+
+  /** Use an existing arena, which is not freed by the scope. */
+  explicit ArenaAllocatorScope(MemArena *arena)
+      : m_arena(arena), m_previous_arena(ArenaAllocator::active_arena()), m_owns_arena(false)
+  {
+    ArenaAllocator::active_arena() = m_arena;
+  }
+
+  ~ArenaAllocatorScope()
+  {
+    BLI_assert(ArenaAllocator::active_arena() == m_arena);
+    ArenaAllocator::active_arena() = m_previous_arena;
+    if (m_owns_arena) {
+      BLI_memarena_free(m_arena);
+    }
+  }
+
+  MemArena *arena()
+  {
+    return m_arena;
+  }
+};
+
 }  // namespace BLI
 
 #endif /* __BLI_ALLOCATOR_H__ */
@@ -0,0 +1,42 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BLI_ARRAY_PARALLEL_H__
+#define __BLI_ARRAY_PARALLEL_H__
+
+/** \file
+ * \ingroup bli
+ * \brief Array algorithms that use multiple threads for large arrays.
+ *
+ * Small arrays are handled on the calling thread, so these can be used unconditionally.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int BLI_parallel_prefix_sum_int(int *data, const int len);
+
+void BLI_parallel_radix_sort_uint(unsigned int *keys, int *values, const int len);
+void BLI_parallel_radix_sort_float(float *keys, int *values, const int len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_ARRAY_PARALLEL_H__ */
@@ -0,0 +1,89 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BLI_CONCURRENT_HASH_H__
+#define __BLI_CONCURRENT_HASH_H__
+
+/** \file
+ * \ingroup bli
+ *
+ * A hash map that can be accessed from multiple threads at once.
+ *
+ * Keys are spread over a fixed number of shards, each one a #GHash protected by its own spin
+ * lock, so threads only contend when they access keys of the same shard. Hash and comparison
+ * callbacks are the same as for #GHash.
+ *
+ * Adding, looking up and removing keys is thread-safe. Creating, clearing and freeing the map
+ * is not, and neither is modifying it during #BLI_concurrent_hash_foreach_parallel.
+ */
+
+#include "BLI_compiler_attrs.h"
+#include "BLI_ghash.h"
+#include "BLI_sys_types.h" /* for bool */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ConcurrentHash ConcurrentHash;
+
+/**
+ * Creates the value of a key that is not in the map yet.
+ * Called with the lock of the key's shard held: it must not access the map, and should be quick.
+ */
+typedef void *(*ConcurrentHashCreateFP)(const void *key, void *userdata);
+typedef void (*ConcurrentHashForeachFP)(void *key, void *val, void *userdata);
+
+ConcurrentHash *BLI_concurrent_hash_new_ex(GHashHashFP hashfp,
+                                           GHashCmpFP cmpfp,
+                                           const char *info,
+                                           const unsigned int nentries_reserve) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT;
+ConcurrentHash *BLI_concurrent_hash_new(GHashHashFP hashfp,
+                                        GHashCmpFP cmpfp,
+                                        const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+ConcurrentHash *BLI_concurrent_hash_ptr_new(const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+ConcurrentHash *BLI_concurrent_hash_int_new(const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+void BLI_concurrent_hash_free(ConcurrentHash *ch,
+                              GHashKeyFreeFP keyfreefp,
+                              GHashValFreeFP valfreefp);
+void BLI_concurrent_hash_clear(ConcurrentHash *ch,
+                               GHashKeyFreeFP keyfreefp,
+                               GHashValFreeFP valfreefp);
+
+bool BLI_concurrent_hash_add(ConcurrentHash *ch, void *key, void *val);
+void *BLI_concurrent_hash_lookup_or_create(ConcurrentHash *ch,
+                                           void *key,
+                                           ConcurrentHashCreateFP createfp,
+                                           void *userdata,
+                                           bool *r_created);
+void *BLI_concurrent_hash_lookup(ConcurrentHash *ch, const void *key) ATTR_WARN_UNUSED_RESULT;
+bool BLI_concurrent_hash_haskey(ConcurrentHash *ch, const void *key) ATTR_WARN_UNUSED_RESULT;
+bool BLI_concurrent_hash_remove(ConcurrentHash *ch,
+                                const void *key,
+                                GHashKeyFreeFP keyfreefp,
+                                GHashValFreeFP valfreefp);
+unsigned int BLI_concurrent_hash_len(ConcurrentHash *ch) ATTR_WARN_UNUSED_RESULT;
+
+void BLI_concurrent_hash_foreach_parallel(ConcurrentHash *ch,
+                                          ConcurrentHashForeachFP func,
+                                          void *userdata);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_CONCURRENT_HASH_H__ */
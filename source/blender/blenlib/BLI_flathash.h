@@ -0,0 +1,129 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BLI_FLATHASH_H__
+#define __BLI_FLATHASH_H__
+
+/** \file
+ * \ingroup bli
+ *
+ * FlatHash is a hash-map with the same interface as #GHash, storing its entries in a flat
+ * array instead of chained buckets.
+ *
+ * Every slot has a control byte, holding either 7 bits of the key's hash or an empty/deleted
+ * marker. Lookups compare a whole group of 16 control bytes at once (using SSE2 when
+ * available), so keys are only compared when their hash bits match. This makes it a lot faster
+ * than #GHash for large maps, at the cost of pointers to values (as returned by
+ * #BLI_flathash_lookup_p) being invalidated when the map grows.
+ *
+ * Iteration order is not stable, and differs from #GHash.
+ */
+
+#include "BLI_compiler_attrs.h"
+#include "BLI_ghash.h"
+#include "BLI_sys_types.h" /* for bool */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FlatHash FlatHash;
+
+typedef struct FlatHashIterator {
+  FlatHash *fh;
+  unsigned int index;
+} FlatHashIterator;
+
+/** \name FlatHash API
+ *
+ * Defined in ``flathash.c``, see the matching #GHash functions for documentation.
+ * \{ */
+
+FlatHash *BLI_flathash_new_ex(GHashHashFP hashfp,
+                              GHashCmpFP cmpfp,
+                              const char *info,
+                              const unsigned int nentries_reserve) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT;
+FlatHash *BLI_flathash_new(GHashHashFP hashfp,
+                           GHashCmpFP cmpfp,
+                           const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+void BLI_flathash_free(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+void BLI_flathash_reserve(FlatHash *fh, const unsigned int nentries_reserve);
+void BLI_flathash_insert(FlatHash *fh, void *key, void *val);
+bool BLI_flathash_reinsert(
+    FlatHash *fh, void *key, void *val, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+void *BLI_flathash_lookup(FlatHash *fh, const void *key) ATTR_WARN_UNUSED_RESULT;
+void *BLI_flathash_lookup_default(FlatHash *fh,
+                                  const void *key,
+                                  void *val_default) ATTR_WARN_UNUSED_RESULT;
+void **BLI_flathash_lookup_p(FlatHash *fh, const void *key) ATTR_WARN_UNUSED_RESULT;
+bool BLI_flathash_ensure_p(FlatHash *fh, void *key, void ***r_val) ATTR_WARN_UNUSED_RESULT;
+bool BLI_flathash_remove(FlatHash *fh,
+                         const void *key,
+                         GHashKeyFreeFP keyfreefp,
+                         GHashValFreeFP valfreefp);
+void BLI_flathash_clear(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+void BLI_flathash_clear_ex(FlatHash *fh,
+                           GHashKeyFreeFP keyfreefp,
+                           GHashValFreeFP valfreefp,
+                           const unsigned int nentries_reserve);
+void *BLI_flathash_popkey(FlatHash *fh,
+                          const void *key,
+                          GHashKeyFreeFP keyfreefp) ATTR_WARN_UNUSED_RESULT;
+bool BLI_flathash_haskey(FlatHash *fh, const void *key) ATTR_WARN_UNUSED_RESULT;
+unsigned int BLI_flathash_len(FlatHash *fh) ATTR_WARN_UNUSED_RESULT;
+
+/** \} */
+
+/** \name FlatHash Iterator
+ *
+ * The map must not be modified while iterating, except for assigning values through
+ * #BLI_flathashIterator_getValue_p.
+ * \{ */
+
+void BLI_flathashIterator_init(FlatHashIterator *fhi, FlatHash *fh);
+void BLI_flathashIterator_step(FlatHashIterator *fhi);
+void *BLI_flathashIterator_getKey(FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+void *BLI_flathashIterator_getValue(FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+void **BLI_flathashIterator_getValue_p(FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+bool BLI_flathashIterator_done(FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+
+#define FLATHASH_ITER(fh_iter_, flathash_) \
+  for (BLI_flathashIterator_init(&fh_iter_, flathash_); \
+       BLI_flathashIterator_done(&fh_iter_) == false; \
+       BLI_flathashIterator_step(&fh_iter_))
+
+/** \} */
+
+/** \name FlatHash Creation Utilities
+ * \{ */
+
+FlatHash *BLI_flathash_ptr_new_ex(const char *info,
+                                  const unsigned int nentries_reserve) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT;
+FlatHash *BLI_flathash_ptr_new(const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+FlatHash *BLI_flathash_int_new_ex(const char *info,
+                                  const unsigned int nentries_reserve) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT;
+FlatHash *BLI_flathash_int_new(const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+
+/** \} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_FLATHASH_H__ */
@@ -63,6 +63,40 @@ void *BLI_mempool_as_arrayN(BLI_mempool *pool,
 void BLI_mempool_set_memory_debug(void);
 #endif
 
+/** Allocation from multiple threads at once, each thread reserving whole chunks of the pool.
+ * Other pool functions must not be used until all threads called #BLI_mempool_threadlocal_end.
+ */
+typedef struct BLI_mempool_threadlocal {
+  BLI_mempool *pool;
+  struct BLI_mempool_chunk *chunk;
+  /** Index of the next element of \a chunk to allocate. */
+  unsigned int chunk_index;
+  unsigned int totused;
+} BLI_mempool_threadlocal;
+
+void BLI_mempool_threadlocal_begin(BLI_mempool *pool, BLI_mempool_threadlocal *tl)
+    ATTR_NONNULL();
+void *BLI_mempool_threadlocal_alloc(BLI_mempool_threadlocal *tl) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
+void *BLI_mempool_threadlocal_calloc(BLI_mempool_threadlocal *tl) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
+void BLI_mempool_threadlocal_end(BLI_mempool_threadlocal *tl) ATTR_NONNULL();
+
+/** Elements allocated at once in the order of the pool, so they can be initialized in parallel
+ * while keeping the iteration order, see #BLI_mempool_range_alloc. */
+typedef struct BLI_mempool_range {
+  BLI_mempool *pool;
+  /** Data of the chunks holding the elements, in order. */
+  void **chunk_data;
+  unsigned int totelem;
+} BLI_mempool_range;
+
+void BLI_mempool_range_alloc(BLI_mempool *pool, unsigned int totelem, BLI_mempool_range *r_range)
+    ATTR_NONNULL();
+void *BLI_mempool_range_elem(const BLI_mempool_range *range, unsigned int index)
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
+void BLI_mempool_range_end(BLI_mempool_range *range) ATTR_NONNULL();
+
 /** iteration stuff.  note: this may easy to produce bugs with */
 /* private structure */
 typedef struct BLI_mempool_iter {
@@ -36,8 +36,10 @@ struct BLI_mempool;
 
 /* Task Scheduler
  *
- * Central scheduler that holds running threads ready to execute tasks. A single
- * queue holds the task from all pools.
+ * Central scheduler that holds running threads ready to execute tasks. Every
+ * worker thread has its own queue of tasks, idle threads steal tasks from the
+ * queues of other threads. Tasks pushed from threads which are not managed by
+ * the scheduler go to a queue shared between all of them.
  *
  * Init/exit must be called before/after any task pools are created/freed, and
  * must be called from the main threads. All other scheduler and pool functions
@@ -30,8 +30,10 @@
  *
  * - Ray-cast:
  *   #BLI_bvhtree_ray_cast, #BVHRayCastData
+ *   #BLI_bvhtree_ray_cast_batch, #BVHRayPacket
  * - Nearest point on surface:
  *   #BLI_bvhtree_find_nearest, #BVHNearestData
+ *   #BLI_bvhtree_find_nearest_batch
  * - Overlapping 2 trees:
  *   #BLI_bvhtree_overlap, #BVHOverlapData_Shared, #BVHOverlapData_Thread
  * - Range Query:
@@ -44,9 +46,11 @@
 
 #include "BLI_utildefines.h"
 #include "BLI_alloca.h"
+#include "BLI_array_parallel.h"
 #include "BLI_stack.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_math.h"
+#include "BLI_math_bits.h"
 #include "BLI_task.h"
 #include "BLI_heap_simple.h"
 
@@ -68,10 +72,22 @@
  */
 #ifdef DEBUG
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 0
+#  define KDOPBVH_THREAD_NODE_THRESHOLD 64
 #else
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
+#  define KDOPBVH_THREAD_NODE_THRESHOLD 65536
 #endif
 
+/* Number of bins used to partition the leafs of large nodes, see #split_leafs_binned. */
+#define KDOPBVH_SPLIT_BINS 256
+/* Number of leafs handled by a single task when binning. */
+#define KDOPBVH_SPLIT_BLOCK_SIZE 4096
+
+/* Number of rays traversed together by #BLI_bvhtree_ray_cast_batch. */
+#define KDOPBVH_RAY_PACKET_LEN 4
+/* Number of queries searched one after the other by #BLI_bvhtree_find_nearest_batch. */
+#define KDOPBVH_NEAREST_BATCH_LEN 256
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -684,6 +700,201 @@ static void split_leafs(BVHNode **leafs_array,
   }
 }
 
+/* Threaded node split.
+ *
+ * The first levels of the tree only have a few branches, so they can't be threaded by
+ * #non_recursive_bvh_div_nodes, while each of those branches has to visit most of the leafs.
+ * Branches with many leafs calculate their bounds and partition their leafs in parallel instead.
+ */
+
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+  BVHNode *node;
+} BVHRefitData;
+
+typedef struct BVHRefitChunk {
+  float bv[13][2];
+} BVHRefitChunk;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int j,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const BVHRefitData *data = userdata;
+  const BVHTree *tree = data->tree;
+  BVHRefitChunk *chunk = tls->userdata_chunk;
+  const float(*__restrict node_bv)[2] = (const float(*)[2])tree->nodes[j]->bv;
+  axis_t axis_iter;
+
+  for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    if (node_bv[axis_iter][0] < chunk->bv[axis_iter][0]) {
+      chunk->bv[axis_iter][0] = node_bv[axis_iter][0];
+    }
+    if (node_bv[axis_iter][1] > chunk->bv[axis_iter][1]) {
+      chunk->bv[axis_iter][1] = node_bv[axis_iter][1];
+    }
+  }
+}
+
+static void refit_kdop_hull_finalize(void *__restrict userdata, void *__restrict userdata_chunk)
+{
+  const BVHRefitData *data = userdata;
+  const BVHTree *tree = data->tree;
+  const BVHRefitChunk *chunk = userdata_chunk;
+  float(*bv)[2] = (float(*)[2])data->node->bv;
+  axis_t axis_iter;
+
+  for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    bv[axis_iter][0] = min_ff(bv[axis_iter][0], chunk->bv[axis_iter][0]);
+    bv[axis_iter][1] = max_ff(bv[axis_iter][1], chunk->bv[axis_iter][1]);
+  }
+}
+
+/**
+ * Threaded version of #refit_kdop_hull.
+ */
+static void refit_kdop_hull_threaded(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  BVHRefitData data = {
+      .tree = tree,
+      .node = node,
+  };
+  BVHRefitChunk chunk;
+  axis_t axis_iter;
+
+  node_minmax_init(tree, node);
+  for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    chunk.bv[axis_iter][0] = FLT_MAX;
+    chunk.bv[axis_iter][1] = -FLT_MAX;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = KDOPBVH_SPLIT_BLOCK_SIZE;
+  settings.userdata_chunk = &chunk;
+  settings.userdata_chunk_size = sizeof(chunk);
+  settings.func_finalize = refit_kdop_hull_finalize;
+  BLI_task_parallel_range(start, end, &data, refit_kdop_hull_task_cb, &settings);
+}
+
+typedef struct BVHSplitBinsData {
+  BVHNode **leafs_array;
+  BVHNode **leafs_binned;
+
+  int begin, end;
+  int split_axis;
+  float bin_min, bin_scale;
+
+  /** Per block leaf count for each bin, then the block's write offset into each bin. */
+  int (*block_bins)[KDOPBVH_SPLIT_BINS];
+} BVHSplitBinsData;
+
+BLI_INLINE int split_bin_index(const BVHSplitBinsData *data, const BVHNode *node)
+{
+  const int bin = (int)((node->bv[data->split_axis] - data->bin_min) * data->bin_scale);
+  return CLAMPIS(bin, 0, KDOPBVH_SPLIT_BINS - 1);
+}
+
+static void split_leafs_count_task_cb(void *__restrict userdata,
+                                      const int block,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHSplitBinsData *data = userdata;
+  int *bins = data->block_bins[block];
+  const int block_begin = data->begin + block * KDOPBVH_SPLIT_BLOCK_SIZE;
+  const int block_end = min_ii(block_begin + KDOPBVH_SPLIT_BLOCK_SIZE, data->end);
+
+  for (int i = block_begin; i < block_end; i++) {
+    bins[split_bin_index(data, data->leafs_array[i])]++;
+  }
+}
+
+static void split_leafs_scatter_task_cb(void *__restrict userdata,
+                                        const int block,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHSplitBinsData *data = userdata;
+  int *bins = data->block_bins[block];
+  const int block_begin = data->begin + block * KDOPBVH_SPLIT_BLOCK_SIZE;
+  const int block_end = min_ii(block_begin + KDOPBVH_SPLIT_BLOCK_SIZE, data->end);
+
+  for (int i = block_begin; i < block_end; i++) {
+    BVHNode *leaf = data->leafs_array[i];
+    data->leafs_binned[bins[split_bin_index(data, leaf)]++] = leaf;
+  }
+}
+
+/**
+ * Same result as #split_leafs, for nodes with many leafs.
+ *
+ * The leafs are first sorted into bins spanning the node bounds along the split axis,
+ * counting and scattering them in parallel. Since the bins are ordered,
+ * only the bins containing a partition boundary still need #partition_nth_element.
+ */
+static void split_leafs_binned(BVHNode **leafs_array,
+                               const int nth[],
+                               const int partitions,
+                               const int split_axis,
+                               const float *bv)
+{
+  const int begin = nth[0];
+  const int end = nth[partitions];
+  const int blocks_num = (end - begin + KDOPBVH_SPLIT_BLOCK_SIZE - 1) / KDOPBVH_SPLIT_BLOCK_SIZE;
+  /* Leafs are sorted on the maximum of the split axis, which is within the node bounds. */
+  const float bin_min = bv[split_axis - 1];
+  const float bin_extent = bv[split_axis] - bin_min;
+  int bin_start[KDOPBVH_SPLIT_BINS + 1];
+  int i, k;
+
+  BVHSplitBinsData data = {
+      .leafs_array = leafs_array,
+      .leafs_binned = MEM_mallocN(sizeof(*leafs_array) * (size_t)(end - begin), __func__),
+      .begin = begin,
+      .end = end,
+      .split_axis = split_axis,
+      .bin_min = bin_min,
+      .bin_scale = (bin_extent > 0.0f) ? (float)KDOPBVH_SPLIT_BINS / bin_extent : 0.0f,
+      .block_bins = MEM_callocN(sizeof(*data.block_bins) * (size_t)blocks_num, __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  BLI_task_parallel_range(0, blocks_num, &data, split_leafs_count_task_cb, &settings);
+
+  /* Turn the counts into write offsets, keeping the order of the leafs within each bin
+   * independent of the threading. */
+  int offset = 0;
+  for (i = 0; i < KDOPBVH_SPLIT_BINS; i++) {
+    bin_start[i] = begin + offset;
+    for (k = 0; k < blocks_num; k++) {
+      const int count = data.block_bins[k][i];
+      data.block_bins[k][i] = offset;
+      offset += count;
+    }
+  }
+  bin_start[KDOPBVH_SPLIT_BINS] = end;
+
+  BLI_task_parallel_range(0, blocks_num, &data, split_leafs_scatter_task_cb, &settings);
+
+  memcpy(&leafs_array[begin], data.leafs_binned, sizeof(*leafs_array) * (size_t)(end - begin));
+
+  MEM_freeN(data.leafs_binned);
+  MEM_freeN(data.block_bins);
+
+  /* Finish each partition boundary inside its bin. */
+  for (i = 1, k = 0; i < partitions; i++) {
+    if (nth[i] >= end) {
+      break;
+    }
+    while (bin_start[k + 1] <= nth[i]) {
+      k++;
+    }
+    partition_nth_element(
+        leafs_array, max_ii(bin_start[k], nth[i - 1]), bin_start[k + 1], nth[i], split_axis);
+  }
+}
+
 typedef struct BVHDivNodesData {
   const BVHTree *tree;
   BVHNode *branches_array;
@@ -714,9 +925,17 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
   int parent_leafs_begin = implicit_leafs_index(data->data, data->depth, parent_level_index);
   int parent_leafs_end = implicit_leafs_index(data->data, data->depth, parent_level_index + 1);
 
+  const bool use_threading = (parent_leafs_end - parent_leafs_begin >
+                              KDOPBVH_THREAD_NODE_THRESHOLD);
+
   /* This calculates the bounding box of this branch
    * and chooses the largest axis as the axis to divide leafs */
-  refit_kdop_hull(data->tree, parent, parent_leafs_begin, parent_leafs_end);
+  if (use_threading) {
+    refit_kdop_hull_threaded(data->tree, parent, parent_leafs_begin, parent_leafs_end);
+  }
+  else {
+    refit_kdop_hull(data->tree, parent, parent_leafs_begin, parent_leafs_end);
+  }
   split_axis = get_largest_axis(parent->bv);
 
   /* Save split axis (this can be used on raytracing to speedup the query time) */
@@ -735,7 +954,12 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
     nth_positions[k] = implicit_leafs_index(data->data, data->depth + 1, child_level_index);
   }
 
-  split_leafs(data->leafs_array, nth_positions, data->tree_type, split_axis);
+  if (use_threading) {
+    split_leafs_binned(data->leafs_array, nth_positions, data->tree_type, split_axis, parent->bv);
+  }
+  else {
+    split_leafs(data->leafs_array, nth_positions, data->tree_type, split_axis);
+  }
 
   /* Setup children and totnode counters
    * Not really needed but currently most of BVH code
@@ -1032,6 +1256,20 @@ bool BLI_bvhtree_update_node(
   return true;
 }
 
+typedef struct BVHUpdateTreeData {
+  BVHTree *tree;
+  /** Branches by implicit tree index (starting at 1). */
+  BVHNode **branches;
+} BVHUpdateTreeData;
+
+static void bvhtree_update_tree_task_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHUpdateTreeData *data = userdata;
+  node_join(data->tree, data->branches[i]);
+}
+
 /* call BLI_bvhtree_update_node() first for every node/point/triangle */
 void BLI_bvhtree_update_tree(BVHTree *tree)
 {
@@ -1039,11 +1277,43 @@ void BLI_bvhtree_update_tree(BVHTree *tree)
    * TRICKY: the way we build the tree all the childs have an index greater than the parent
    * This allows us todo a bottom up update by starting on the bigger numbered branch */
 
-  BVHNode **root = tree->nodes + tree->totleaf;
-  BVHNode **index = tree->nodes + tree->totleaf + tree->totbranch - 1;
+  if (tree->totleaf <= KDOPBVH_THREAD_LEAF_THRESHOLD) {
+    BVHNode **root = tree->nodes + tree->totleaf;
+    BVHNode **index = tree->nodes + tree->totleaf + tree->totbranch - 1;
+
+    for (; index >= root; index--) {
+      node_join(tree, *index);
+    }
+    return;
+  }
+
+  /* The children of all branches on a level are on the next level (or leafs),
+   * so the branches of one level can be joined in parallel, starting with the deepest level. */
+  const int tree_type = tree->tree_type;
+  const int tree_offset = 2 - tree->tree_type;
+  int level_first[33];
+  int levels_num = 0;
+
+  for (int i = 1; i <= tree->totbranch; i = i * tree_type + tree_offset) {
+    level_first[levels_num++] = i;
+  }
+  level_first[levels_num] = tree->totbranch + 1;
+
+  BVHUpdateTreeData data = {
+      .tree = tree,
+      .branches = tree->nodes + tree->totleaf - 1,
+  };
 
-  for (; index >= root; index--) {
-    node_join(tree, *index);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+
+  for (int level = levels_num - 1; level >= 0; level--) {
+    BLI_task_parallel_range(level_first[level],
+                            level_first[level + 1],
+                            &data,
+                            bvhtree_update_tree_task_cb,
+                            &settings);
   }
 }
 /**
@@ -1570,6 +1840,150 @@ int BLI_bvhtree_find_nearest(BVHTree *tree,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name BLI_bvhtree_find_nearest_batch
+ * \{ */
+
+typedef struct BVHNearestBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  /* Query indices in Morton order. */
+  const int *order;
+  uint co_len;
+  BVHTreeNearest *nearest;
+  BVHTree_NearestPointCallback callback;
+  void *userdata;
+  int flag;
+} BVHNearestBatchData;
+
+/**
+ * Interleave the bits of coordinates quantized to 10 bits,
+ * so nearby coordinates are likely to get nearby codes.
+ */
+static uint morton_code_v3(const float co[3], const float min[3], const float scale[3])
+{
+  uint code = 0;
+  for (uint j = 0; j < 3; j++) {
+    uint x = (uint)((co[j] - min[j]) * scale[j]);
+    /* Spread the 10 bits, leaving two zero bits after each. */
+    x = (x | (x << 16)) & 0x030000FFu;
+    x = (x | (x << 8)) & 0x0300F00Fu;
+    x = (x | (x << 4)) & 0x030C30C3u;
+    x = (x | (x << 2)) & 0x09249249u;
+    code |= x << j;
+  }
+  return code;
+}
+
+/**
+ * Sort the coordinates so close ones follow each other.
+ * \return the coordinate indices in sorted order.
+ */
+static int *morton_order_v3(const float (*co)[3], const uint co_len)
+{
+  float min[3], max[3], scale[3];
+  INIT_MINMAX(min, max);
+  for (uint i = 0; i < co_len; i++) {
+    minmax_v3v3_v3(min, max, co[i]);
+  }
+  for (uint j = 0; j < 3; j++) {
+    const float size = max[j] - min[j];
+    scale[j] = (size > 0.0f) ? 1023.0f / size : 0.0f;
+  }
+
+  uint *codes = MEM_mallocN(sizeof(*codes) * co_len, __func__);
+  int *order = MEM_mallocN(sizeof(*order) * co_len, __func__);
+  for (uint i = 0; i < co_len; i++) {
+    codes[i] = morton_code_v3(co[i], min, scale);
+    order[i] = (int)i;
+  }
+  BLI_parallel_radix_sort_uint(codes, order, (int)co_len);
+  MEM_freeN(codes);
+
+  return order;
+}
+
+static void bvhtree_find_nearest_batch_cb(void *__restrict userdata,
+                                          const int batch,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHNearestBatchData *data = userdata;
+  const uint start = (uint)batch * KDOPBVH_NEAREST_BATCH_LEN;
+  const uint end = MIN2(start + KDOPBVH_NEAREST_BATCH_LEN, data->co_len);
+  int index_prev = -1;
+
+  for (uint i = start; i < end; i++) {
+    const int index = data->order[i];
+    const float *co = data->co[index];
+    BVHTreeNearest *nearest = &data->nearest[index];
+
+    /* The previous query is close by, so its result is a good first guess,
+     * after which most of the tree can be skipped. */
+    if (data->callback && index_prev != -1) {
+      data->callback(data->userdata, index_prev, co, nearest);
+    }
+
+    BLI_bvhtree_find_nearest_ex(
+        data->tree, co, nearest, data->callback, data->userdata, data->flag);
+
+    if (nearest->index != -1) {
+      index_prev = nearest->index;
+    }
+  }
+}
+
+/**
+ * Find the nearest element for many coordinates at once, giving the same results as calling
+ * #BLI_bvhtree_find_nearest_ex for each of them (except for which one of several equally near
+ * elements is found).
+ *
+ * Queries are sorted so close coordinates are searched one after the other, which lets each
+ * search start with the result of the previous one (when there is a \a callback),
+ * and run on multiple threads.
+ *
+ * \param nearest: An array of \a co_len, initialized by the caller like for a single search.
+ * \param callback: Called from multiple threads at once, so it must be thread-safe.
+ */
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    const uint co_len,
+                                    BVHTreeNearest *nearest,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    int flag)
+{
+  if (co_len == 0) {
+    return;
+  }
+
+  int *order = morton_order_v3(co, co_len);
+
+  BVHNearestBatchData data = {
+      .tree = tree,
+      .co = co,
+      .order = order,
+      .co_len = co_len,
+      .nearest = nearest,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4;
+  BLI_task_parallel_range(
+      0,
+      (int)((co_len + KDOPBVH_NEAREST_BATCH_LEN - 1) / KDOPBVH_NEAREST_BATCH_LEN),
+      &data,
+      bvhtree_find_nearest_batch_cb,
+      &settings);
+
+  MEM_freeN(order);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name BLI_bvhtree_find_nearest_first
  * \{ */
@@ -1905,6 +2319,208 @@ int BLI_bvhtree_ray_cast(BVHTree *tree,
       tree, co, dir, radius, hit, callback, userdata, BVH_RAYCAST_DEFAULT);
 }
 
+/**
+ * Rays that are traversed together, visiting a node when any of them hits it.
+ * The coordinates used for the box tests are stored per axis, so each test is done for all rays
+ * in one loop.
+ */
+typedef struct BVHRayPacket {
+  BVHRayCastData rays[KDOPBVH_RAY_PACKET_LEN];
+  float origin[3][KDOPBVH_RAY_PACKET_LEN];
+  float idot_axis[3][KDOPBVH_RAY_PACKET_LEN];
+  float hit_dist[KDOPBVH_RAY_PACKET_LEN];
+  uint rays_len;
+  bool use_radius;
+} BVHRayPacket;
+
+/**
+ * Same as #fast_ray_nearest_hit for all rays of the packet,
+ * or #ray_nearest_hit when the rays have a radius.
+ *
+ * \return the mask of the rays in \a mask that hit the node before their current hit.
+ */
+static uint ray_packet_nearest_hit(const BVHRayPacket *packet,
+                                   const BVHNode *node,
+                                   const uint mask,
+                                   float r_dist[KDOPBVH_RAY_PACKET_LEN])
+{
+  const float *bv = node->bv;
+  uint mask_hit = 0;
+
+  if (packet->use_radius) {
+    for (uint i = 0; i < packet->rays_len; i++) {
+      if (mask & (1u << i)) {
+        r_dist[i] = ray_nearest_hit(&packet->rays[i], bv);
+        if (r_dist[i] < packet->hit_dist[i]) {
+          mask_hit |= 1u << i;
+        }
+      }
+    }
+    return mask_hit;
+  }
+
+  float t_near[KDOPBVH_RAY_PACKET_LEN], t_far[KDOPBVH_RAY_PACKET_LEN];
+  for (uint i = 0; i < KDOPBVH_RAY_PACKET_LEN; i++) {
+    t_near[i] = -FLT_MAX;
+    t_far[i] = FLT_MAX;
+  }
+  for (uint axis = 0; axis < 3; axis++, bv += 2) {
+    for (uint i = 0; i < KDOPBVH_RAY_PACKET_LEN; i++) {
+      const float t1 = (bv[0] - packet->origin[axis][i]) * packet->idot_axis[axis][i];
+      const float t2 = (bv[1] - packet->origin[axis][i]) * packet->idot_axis[axis][i];
+      t_near[i] = max_ff(t_near[i], min_ff(t1, t2));
+      t_far[i] = min_ff(t_far[i], max_ff(t1, t2));
+    }
+  }
+  for (uint i = 0; i < packet->rays_len; i++) {
+    if ((mask & (1u << i)) && (t_near[i] <= t_far[i]) && (t_far[i] >= 0.0f) &&
+        (t_near[i] < packet->hit_dist[i])) {
+      r_dist[i] = t_near[i];
+      mask_hit |= 1u << i;
+    }
+  }
+  return mask_hit;
+}
+
+static void dfs_raycast_packet(BVHRayPacket *packet, BVHNode *node, uint mask)
+{
+  float dist[KDOPBVH_RAY_PACKET_LEN];
+  int i;
+
+  mask = ray_packet_nearest_hit(packet, node, mask, dist);
+  if (mask == 0) {
+    return;
+  }
+
+  if (node->totnode == 0) {
+    for (uint ray = 0; ray < packet->rays_len; ray++) {
+      if (mask & (1u << ray)) {
+        BVHRayCastData *data = &packet->rays[ray];
+        if (data->callback) {
+          data->callback(data->userdata, node->index, &data->ray, &data->hit);
+        }
+        else {
+          data->hit.index = node->index;
+          data->hit.dist = dist[ray];
+          madd_v3_v3v3fl(data->hit.co, data->ray.origin, data->ray.direction, dist[ray]);
+        }
+        packet->hit_dist[ray] = data->hit.dist;
+      }
+    }
+  }
+  else {
+    /* pick loop direction to dive into the tree, based on the first ray that hit the node */
+    const BVHRayCastData *data = &packet->rays[bitscan_forward_uint(mask)];
+    if (data->ray_dot_axis[node->main_axis] > 0.0f) {
+      for (i = 0; i != node->totnode; i++) {
+        dfs_raycast_packet(packet, node->children[i], mask);
+      }
+    }
+    else {
+      for (i = node->totnode - 1; i >= 0; i--) {
+        dfs_raycast_packet(packet, node->children[i], mask);
+      }
+    }
+  }
+}
+
+typedef struct BVHRayCastBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  const float (*dir)[3];
+  uint rays_len;
+  float radius;
+  BVHTreeRayHit *hits;
+  BVHTree_RayCastCallback callback;
+  void *userdata;
+  int flag;
+} BVHRayCastBatchData;
+
+static void bvhtree_ray_cast_batch_cb(void *__restrict userdata,
+                                      const int packet_index,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHRayCastBatchData *batch = userdata;
+  BVHNode *root = batch->tree->nodes[batch->tree->totleaf];
+  const uint start = (uint)packet_index * KDOPBVH_RAY_PACKET_LEN;
+  BVHRayPacket packet;
+
+  packet.rays_len = MIN2((uint)KDOPBVH_RAY_PACKET_LEN, batch->rays_len - start);
+  packet.use_radius = (batch->radius != 0.0f);
+
+  for (uint i = 0; i < KDOPBVH_RAY_PACKET_LEN; i++) {
+    /* Unused rays repeat the last ray so the box tests don't need to check for them. */
+    const uint ray = start + MIN2(i, packet.rays_len - 1);
+    BVHRayCastData *data = &packet.rays[i];
+
+    BLI_ASSERT_UNIT_V3(batch->dir[ray]);
+
+    data->tree = batch->tree;
+    data->callback = batch->callback;
+    data->userdata = batch->userdata;
+    copy_v3_v3(data->ray.origin, batch->co[ray]);
+    copy_v3_v3(data->ray.direction, batch->dir[ray]);
+    data->ray.radius = batch->radius;
+    bvhtree_ray_cast_data_precalc(data, batch->flag);
+    memcpy(&data->hit, &batch->hits[ray], sizeof(data->hit));
+
+    for (uint axis = 0; axis < 3; axis++) {
+      packet.origin[axis][i] = data->ray.origin[axis];
+      packet.idot_axis[axis][i] = data->idot_axis[axis];
+    }
+    packet.hit_dist[i] = data->hit.dist;
+  }
+
+  if (root) {
+    dfs_raycast_packet(&packet, root, (1u << packet.rays_len) - 1);
+  }
+
+  for (uint i = 0; i < packet.rays_len; i++) {
+    memcpy(&batch->hits[start + i], &packet.rays[i].hit, sizeof(*batch->hits));
+  }
+}
+
+/**
+ * Cast many rays at once, giving the same results as calling #BLI_bvhtree_ray_cast_ex for each
+ * of them. Rays are traversed in packets, so rays next to each other in the array should be
+ * close to each other and point in similar directions (e.g. one ray per pixel or per vertex),
+ * and the packets run on multiple threads.
+ *
+ * \param hits: An array of \a rays_len, initialized by the caller like for a single ray cast.
+ * \param callback: Called from multiple threads at once, so it must be thread-safe.
+ */
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                const uint rays_len,
+                                float radius,
+                                BVHTreeRayHit *hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                int flag)
+{
+  BVHRayCastBatchData batch = {
+      .tree = tree,
+      .co = co,
+      .dir = dir,
+      .rays_len = rays_len,
+      .radius = radius,
+      .hits = hits,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0,
+                          (int)((rays_len + KDOPBVH_RAY_PACKET_LEN - 1) / KDOPBVH_RAY_PACKET_LEN),
+                          &batch,
+                          bvhtree_ray_cast_batch_cb,
+                          &settings);
+}
+
 float BLI_bvhtree_bb_raycast(const float bv[6],
                              const float light_start[3],
                              const float light_end[3],
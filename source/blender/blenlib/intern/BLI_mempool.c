@@ -27,6 +27,8 @@
  * - Freeing chunks.
  * - Iterating over allocated chunks
  *   (optionally when using the #BLI_MEMPOOL_ALLOW_ITER flag).
+ * - Allocating from multiple threads, each reserving whole chunks
+ *   (see #BLI_mempool_threadlocal_begin and #BLI_mempool_range_alloc).
  */
 
 #include <string.h>
@@ -131,6 +133,8 @@ struct BLI_mempool {
   uint maxchunks;
   /** Number of elements currently in use. */
   uint totused;
+  /** Spin-lock for adding chunks from multiple threads, see #BLI_mempool_threadlocal. */
+  uint chunk_lock;
 #ifdef USE_TOTALLOC
   /** Number of elements allocated in total. */
   uint totalloc;
@@ -315,6 +319,7 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
   pool->totalloc = 0;
 #endif
   pool->totused = 0;
+  pool->chunk_lock = 0;
 
   if (totelem) {
     /* Allocate the actual chunks. */
@@ -765,6 +770,216 @@ void BLI_mempool_destroy(BLI_mempool *pool)
   MEM_freeN(pool);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Threaded Allocation
+ * \{ */
+
+static void mempool_chunk_lock(BLI_mempool *pool)
+{
+  while (atomic_cas_uint32(&pool->chunk_lock, 0, 1) != 0) {
+    /* pass */
+  }
+}
+
+static void mempool_chunk_unlock(BLI_mempool *pool)
+{
+  atomic_cas_uint32(&pool->chunk_lock, 1, 0);
+}
+
+/* Append a chunk without adding its elements to the free list. */
+static void mempool_chunk_append(BLI_mempool *pool, BLI_mempool_chunk *mpchunk)
+{
+  mpchunk->next = NULL;
+  if (pool->chunk_tail) {
+    pool->chunk_tail->next = mpchunk;
+  }
+  else {
+    BLI_assert(pool->chunks == NULL);
+    pool->chunks = mpchunk;
+  }
+  pool->chunk_tail = mpchunk;
+
+#ifdef USE_TOTALLOC
+  pool->totalloc += pool->pchunk;
+#endif
+}
+
+/**
+ * Link the elements of \a mpchunk starting at \a index into the free list of the pool.
+ *
+ * \return The last element of the free list.
+ */
+static BLI_freenode *mempool_chunk_free_link(BLI_mempool *pool,
+                                             BLI_mempool_chunk *mpchunk,
+                                             uint index,
+                                             BLI_freenode *last_tail)
+{
+  const uint esize = pool->esize;
+  BLI_freenode *curnode = POINTER_OFFSET(CHUNK_DATA(mpchunk), (size_t)esize * index);
+
+  if (last_tail) {
+    last_tail->next = curnode;
+  }
+  else {
+    pool->free = curnode;
+  }
+
+  for (uint j = pool->pchunk - index; j--;) {
+    curnode->next = NODE_STEP_NEXT(curnode);
+    if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+      curnode->freeword = FREEWORD;
+    }
+    curnode = curnode->next;
+  }
+  curnode = NODE_STEP_PREV(curnode);
+  curnode->next = NULL;
+
+  return curnode;
+}
+
+/**
+ * Start allocating elements of \a pool from the calling thread.
+ *
+ * Threads allocate from chunks they reserve for themselves, so only getting a new chunk
+ * synchronizes with other threads. The order of the elements allocated by different threads
+ * is undefined, use #BLI_mempool_range_alloc when it matters.
+ */
+void BLI_mempool_threadlocal_begin(BLI_mempool *pool, BLI_mempool_threadlocal *tl)
+{
+  tl->pool = pool;
+  tl->chunk = NULL;
+  tl->chunk_index = 0;
+  tl->totused = 0;
+}
+
+void *BLI_mempool_threadlocal_alloc(BLI_mempool_threadlocal *tl)
+{
+  BLI_mempool *pool = tl->pool;
+
+  if (UNLIKELY(tl->chunk == NULL || tl->chunk_index == pool->pchunk)) {
+    /* Free elements of other chunks would need locking for every allocation. */
+    BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
+    mempool_chunk_lock(pool);
+    mempool_chunk_append(pool, mpchunk);
+    mempool_chunk_unlock(pool);
+    tl->chunk = mpchunk;
+    tl->chunk_index = 0;
+  }
+
+  BLI_freenode *elem = POINTER_OFFSET(CHUNK_DATA(tl->chunk), (size_t)pool->esize * tl->chunk_index);
+  tl->chunk_index++;
+  tl->totused++;
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    elem->freeword = USEDWORD;
+  }
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(pool, elem, pool->esize);
+#endif
+
+  return (void *)elem;
+}
+
+void *BLI_mempool_threadlocal_calloc(BLI_mempool_threadlocal *tl)
+{
+  void *retval = BLI_mempool_threadlocal_alloc(tl);
+  memset(retval, 0, (size_t)tl->pool->esize);
+  return retval;
+}
+
+/**
+ * Give the elements of the chunk last reserved by the calling thread which were not allocated
+ * back to the pool.
+ */
+void BLI_mempool_threadlocal_end(BLI_mempool_threadlocal *tl)
+{
+  BLI_mempool *pool = tl->pool;
+
+  mempool_chunk_lock(pool);
+  if (tl->chunk != NULL && tl->chunk_index != pool->pchunk) {
+    BLI_freenode *free_prev = pool->free;
+    BLI_freenode *last_tail = mempool_chunk_free_link(pool, tl->chunk, tl->chunk_index, NULL);
+    last_tail->next = free_prev;
+  }
+  pool->totused += tl->totused;
+  mempool_chunk_unlock(pool);
+
+  tl->chunk = NULL;
+  tl->totused = 0;
+}
+
+/**
+ * Allocate \a totelem elements at the start of the empty \a pool, in order.
+ *
+ * The elements are returned by #BLI_mempool_range_elem, which can be called from multiple
+ * threads at once, so the elements can be initialized in parallel. All of them must be
+ * retrieved this way before the pool is used otherwise.
+ */
+void BLI_mempool_range_alloc(BLI_mempool *pool, uint totelem, BLI_mempool_range *r_range)
+{
+  BLI_assert(pool->totused == 0);
+
+  const uint pchunk = pool->pchunk;
+  const uint chunks_num = (totelem + pchunk - 1) / pchunk;
+  void **chunk_data = MEM_malloc_arrayN(MAX2(chunks_num, 1u), sizeof(void *), __func__);
+
+  /* Chunks already allocated are empty, use them first. */
+  BLI_mempool_chunk *mpchunk = pool->chunks;
+  BLI_mempool_chunk *mpchunk_last = NULL;
+  for (uint i = 0; i < chunks_num; i++) {
+    if (mpchunk == NULL) {
+      mpchunk = mempool_chunk_alloc(pool);
+      mempool_chunk_append(pool, mpchunk);
+    }
+    chunk_data[i] = CHUNK_DATA(mpchunk);
+    mpchunk_last = mpchunk;
+    mpchunk = mpchunk->next;
+  }
+
+  /* Elements after the range are free. */
+  pool->free = NULL;
+  BLI_freenode *last_tail = NULL;
+  if (mpchunk_last != NULL && (totelem % pchunk) != 0) {
+    last_tail = mempool_chunk_free_link(pool, mpchunk_last, totelem % pchunk, last_tail);
+  }
+  for (; mpchunk; mpchunk = mpchunk->next) {
+    last_tail = mempool_chunk_free_link(pool, mpchunk, 0, last_tail);
+  }
+
+  pool->totused = totelem;
+
+  r_range->pool = pool;
+  r_range->chunk_data = chunk_data;
+  r_range->totelem = totelem;
+}
+
+void *BLI_mempool_range_elem(const BLI_mempool_range *range, uint index)
+{
+  BLI_mempool *pool = range->pool;
+  BLI_assert(index < range->totelem);
+
+  BLI_freenode *elem = POINTER_OFFSET(range->chunk_data[index / pool->pchunk],
+                                      (size_t)pool->esize * (index % pool->pchunk));
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    elem->freeword = USEDWORD;
+  }
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(pool, elem, pool->esize);
+#endif
+
+  return (void *)elem;
+}
+
+void BLI_mempool_range_end(BLI_mempool_range *range)
+{
+  MEM_freeN(range->chunk_data);
+  range->chunk_data = NULL;
+}
+
+/** \} */
+
 #ifndef NDEBUG
 void BLI_mempool_set_memory_debug(void)
 {
@@ -0,0 +1,349 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ * \brief Array algorithms that use multiple threads for large arrays.
+ *
+ * The array is split into a few chunks per thread. Each algorithm first computes something per
+ * chunk in parallel, combines the per-chunk results serially (which is cheap, as there are only
+ * few chunks), and then does a second parallel pass using the combined result.
+ */
+
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "BLI_array_parallel.h" /* own include */
+#include "BLI_task.h"
+#include "BLI_threads.h"
+
+#include "BLI_strict_flags.h"
+
+/* -------------------------------------------------------------------- */
+/** \name Chunks
+ * \{ */
+
+/* Arrays shorter than this are not split, threading would only add overhead. */
+#define CHUNK_MIN_LEN 8192
+#define CHUNKS_PER_THREAD 4
+
+typedef struct ArrayChunks {
+  int len;
+  int chunk_len;
+  int chunk_num;
+} ArrayChunks;
+
+static void array_chunks_init(ArrayChunks *chunks, const int len)
+{
+  const int chunk_num_max = BLI_system_thread_count() * CHUNKS_PER_THREAD;
+  const int chunk_num = CLAMPIS(len / CHUNK_MIN_LEN, 1, chunk_num_max);
+
+  chunks->len = len;
+  chunks->chunk_len = (len + chunk_num - 1) / chunk_num;
+  chunks->chunk_num = (len + chunks->chunk_len - 1) / chunks->chunk_len;
+}
+
+BLI_INLINE void array_chunks_range(const ArrayChunks *chunks,
+                                   const int chunk,
+                                   int *r_start,
+                                   int *r_end)
+{
+  *r_start = chunk * chunks->chunk_len;
+  *r_end = MIN2(*r_start + chunks->chunk_len, chunks->len);
+}
+
+static void array_chunks_parallel(const ArrayChunks *chunks,
+                                  void *userdata,
+                                  TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (chunks->chunk_num > 1);
+  settings.min_iter_per_thread = 1;
+
+  BLI_task_parallel_range(0, chunks->chunk_num, userdata, func, &settings);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Prefix Sum
+ * \{ */
+
+typedef struct PrefixSumData {
+  ArrayChunks chunks;
+  int *data;
+  int *chunk_sums;
+} PrefixSumData;
+
+static void prefix_sum_chunk_total_cb(void *__restrict userdata,
+                                      const int chunk,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PrefixSumData *psd = userdata;
+  int start, end;
+  array_chunks_range(&psd->chunks, chunk, &start, &end);
+
+  int sum = 0;
+  for (int i = start; i < end; i++) {
+    sum += psd->data[i];
+  }
+  psd->chunk_sums[chunk] = sum;
+}
+
+static void prefix_sum_chunk_scan_cb(void *__restrict userdata,
+                                     const int chunk,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PrefixSumData *psd = userdata;
+  int start, end;
+  array_chunks_range(&psd->chunks, chunk, &start, &end);
+
+  int sum = psd->chunk_sums[chunk];
+  for (int i = start; i < end; i++) {
+    const int value = psd->data[i];
+    psd->data[i] = sum;
+    sum += value;
+  }
+}
+
+/**
+ * Exclusive prefix sum in-place: every element is replaced with the sum of all elements before
+ * it. Typically used to turn per-element counts into offsets.
+ *
+ * \return the sum of all elements.
+ */
+int BLI_parallel_prefix_sum_int(int *data, const int len)
+{
+  if (len <= 0) {
+    return 0;
+  }
+
+  PrefixSumData psd;
+  array_chunks_init(&psd.chunks, len);
+  psd.data = data;
+  psd.chunk_sums = MEM_mallocN(sizeof(*psd.chunk_sums) * (size_t)psd.chunks.chunk_num,
+                               __func__);
+
+  array_chunks_parallel(&psd.chunks, &psd, prefix_sum_chunk_total_cb);
+
+  int total = 0;
+  for (int chunk = 0; chunk < psd.chunks.chunk_num; chunk++) {
+    const int sum = psd.chunk_sums[chunk];
+    psd.chunk_sums[chunk] = total;
+    total += sum;
+  }
+
+  array_chunks_parallel(&psd.chunks, &psd, prefix_sum_chunk_scan_cb);
+
+  MEM_freeN(psd.chunk_sums);
+  return total;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Radix Sort
+ * \{ */
+
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_MASK (RADIX_SIZE - 1)
+
+typedef struct RadixSortData {
+  ArrayChunks chunks;
+  const uint *keys_src;
+  const int *values_src;
+  uint *keys_dst;
+  int *values_dst;
+  /* Per chunk: the count of each digit, which is then turned into scatter offsets. */
+  uint (*chunk_histograms)[RADIX_SIZE];
+  uint shift;
+} RadixSortData;
+
+static void radix_sort_count_cb(void *__restrict userdata,
+                                const int chunk,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RadixSortData *rsd = userdata;
+  uint *histogram = rsd->chunk_histograms[chunk];
+  int start, end;
+  array_chunks_range(&rsd->chunks, chunk, &start, &end);
+
+  memset(histogram, 0, sizeof(*rsd->chunk_histograms));
+  for (int i = start; i < end; i++) {
+    histogram[(rsd->keys_src[i] >> rsd->shift) & RADIX_MASK]++;
+  }
+}
+
+static void radix_sort_scatter_cb(void *__restrict userdata,
+                                  const int chunk,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RadixSortData *rsd = userdata;
+  uint *offsets = rsd->chunk_histograms[chunk];
+  int start, end;
+  array_chunks_range(&rsd->chunks, chunk, &start, &end);
+
+  for (int i = start; i < end; i++) {
+    const uint key = rsd->keys_src[i];
+    const uint dst = offsets[(key >> rsd->shift) & RADIX_MASK]++;
+    rsd->keys_dst[dst] = key;
+    if (rsd->values_dst) {
+      rsd->values_dst[dst] = rsd->values_src[i];
+    }
+  }
+}
+
+/**
+ * Turn the per-chunk histograms into the offsets each chunk writes its elements to. Elements
+ * with the same digit stay in chunk order, which keeps the sort stable.
+ *
+ * \return false when all keys have the same digit, so the pass can be skipped.
+ */
+static bool radix_sort_offsets(RadixSortData *rsd)
+{
+  const int chunk_num = rsd->chunks.chunk_num;
+  uint offset = 0;
+
+  for (int digit = 0; digit < RADIX_SIZE; digit++) {
+    uint digit_total = 0;
+    for (int chunk = 0; chunk < chunk_num; chunk++) {
+      const uint count = rsd->chunk_histograms[chunk][digit];
+      rsd->chunk_histograms[chunk][digit] = offset + digit_total;
+      digit_total += count;
+    }
+    if (digit_total == (uint)rsd->chunks.len) {
+      return false;
+    }
+    offset += digit_total;
+  }
+  return true;
+}
+
+/**
+ * Stable sort of \a keys in ascending order, least significant digit first.
+ *
+ * \param values: Optional array that is reordered along with the keys,
+ * e.g. the indices the keys belong to.
+ */
+void BLI_parallel_radix_sort_uint(uint *keys, int *values, const int len)
+{
+  if (len <= 1) {
+    return;
+  }
+
+  RadixSortData rsd;
+  array_chunks_init(&rsd.chunks, len);
+  rsd.chunk_histograms = MEM_mallocN(
+      sizeof(*rsd.chunk_histograms) * (size_t)rsd.chunks.chunk_num, __func__);
+
+  uint *keys_tmp = MEM_mallocN(sizeof(*keys) * (size_t)len, __func__);
+  int *values_tmp = values ? MEM_mallocN(sizeof(*values) * (size_t)len, __func__) : NULL;
+
+  uint *keys_src = keys, *keys_dst = keys_tmp;
+  int *values_src = values, *values_dst = values_tmp;
+
+  for (rsd.shift = 0; rsd.shift < 32; rsd.shift += RADIX_BITS) {
+    rsd.keys_src = keys_src;
+    rsd.values_src = values_src;
+    rsd.keys_dst = keys_dst;
+    rsd.values_dst = values_dst;
+
+    array_chunks_parallel(&rsd.chunks, &rsd, radix_sort_count_cb);
+    if (!radix_sort_offsets(&rsd)) {
+      /* Common for the high digits when sorting indices. */
+      continue;
+    }
+    array_chunks_parallel(&rsd.chunks, &rsd, radix_sort_scatter_cb);
+
+    SWAP(uint *, keys_src, keys_dst);
+    SWAP(int *, values_src, values_dst);
+  }
+
+  if (keys_src != keys) {
+    memcpy(keys, keys_src, sizeof(*keys) * (size_t)len);
+    if (values) {
+      memcpy(values, values_src, sizeof(*values) * (size_t)len);
+    }
+  }
+
+  MEM_freeN(keys_tmp);
+  MEM_SAFE_FREE(values_tmp);
+  MEM_freeN(rsd.chunk_histograms);
+}
+
+typedef struct RadixFloatData {
+  ArrayChunks chunks;
+  uint *keys;
+} RadixFloatData;
+
+/**
+ * Map the bits of floats to unsigned integers with the same order: positive values get their
+ * sign bit set, negative values have all bits flipped, as their magnitude sorts in reverse.
+ */
+static void radix_float_to_uint_cb(void *__restrict userdata,
+                                   const int chunk,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RadixFloatData *rfd = userdata;
+  int start, end;
+  array_chunks_range(&rfd->chunks, chunk, &start, &end);
+
+  for (int i = start; i < end; i++) {
+    const uint bits = rfd->keys[i];
+    rfd->keys[i] = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  }
+}
+
+static void radix_uint_to_float_cb(void *__restrict userdata,
+                                   const int chunk,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RadixFloatData *rfd = userdata;
+  int start, end;
+  array_chunks_range(&rfd->chunks, chunk, &start, &end);
+
+  for (int i = start; i < end; i++) {
+    const uint bits = rfd->keys[i];
+    rfd->keys[i] = (bits & 0x80000000u) ? (bits & 0x7fffffffu) : ~bits;
+  }
+}
+
+/**
+ * Stable sort of \a keys in ascending order, see #BLI_parallel_radix_sort_uint.
+ * Negative zero sorts before positive zero, NaN's sort after infinity (or before negative
+ * infinity when their sign bit is set).
+ */
+void BLI_parallel_radix_sort_float(float *keys, int *values, const int len)
+{
+  if (len <= 1) {
+    return;
+  }
+
+  RadixFloatData rfd;
+  array_chunks_init(&rfd.chunks, len);
+  rfd.keys = (uint *)keys;
+
+  array_chunks_parallel(&rfd.chunks, &rfd, radix_float_to_uint_cb);
+  BLI_parallel_radix_sort_uint(rfd.keys, values, len);
+  array_chunks_parallel(&rfd.chunks, &rfd, radix_uint_to_float_cb);
+}
+
+/** \} */
@@ -104,6 +104,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 
 #include "BLI_strict_flags.h"
 
@@ -160,6 +161,18 @@
 #  define BCHUNK_HASH_LEN 4
 #endif
 
+#ifdef USE_HASH_TABLE_ACCUMULATE
+/* Hash large arrays on multiple threads,
+ * the resulting hashes are identical to the single threaded calculation.
+ */
+#  define USE_HASH_TABLE_THREADED
+#endif
+
+#ifdef USE_HASH_TABLE_THREADED
+/* Number of hashes calculated by a single task. */
+#  define HASH_TABLE_THREADED_BLOCK_LEN 16384
+#endif
+
 /* Calculate the key once and reuse it
  */
 #define USE_HASH_TABLE_KEY_CACHE
@@ -830,6 +843,133 @@ static void hash_accum(hash_key *hash_array, const size_t hash_array_len, size_t
   }
 }
 
+#  ifdef USE_HASH_TABLE_THREADED
+
+typedef struct HashArrayThreadData {
+  const BArrayInfo *info;
+  const uchar *data;
+  hash_key *hash_array;
+  /** Values of #hash_array before the current accumulation step. */
+  const hash_key *hash_array_prev;
+  size_t hash_array_len;
+  size_t hash_offset;
+} HashArrayThreadData;
+
+static void hash_array_block_range(const HashArrayThreadData *data,
+                                   const int block,
+                                   size_t *r_start,
+                                   size_t *r_end)
+{
+  *r_start = (size_t)block * HASH_TABLE_THREADED_BLOCK_LEN;
+  *r_end = MIN2(*r_start + HASH_TABLE_THREADED_BLOCK_LEN, data->hash_array_len);
+}
+
+static void hash_array_from_data_block_cb(void *__restrict userdata,
+                                          const int block,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const HashArrayThreadData *data = userdata;
+  const size_t stride = data->info->chunk_stride;
+  size_t i_start, i_end;
+  hash_array_block_range(data, block, &i_start, &i_end);
+  hash_array_from_data(data->info,
+                       &data->data[i_start * stride],
+                       (i_end - i_start) * stride,
+                       &data->hash_array[i_start]);
+}
+
+static void hash_accum_block_cb(void *__restrict userdata,
+                                const int block,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const HashArrayThreadData *data = userdata;
+  const hash_key *hash_array_prev = data->hash_array_prev;
+  const size_t hash_offset = data->hash_offset;
+  size_t i_start, i_end;
+  hash_array_block_range(data, block, &i_start, &i_end);
+  for (size_t i = i_start; i < i_end; i++) {
+    data->hash_array[i] = hash_array_prev[i] +
+                          (hash_array_prev[i + hash_offset]) * ((hash_array_prev[i] & 0xff) + 1);
+  }
+}
+
+static int hash_array_block_len(const size_t hash_array_len)
+{
+  return (int)((hash_array_len + HASH_TABLE_THREADED_BLOCK_LEN - 1) /
+               HASH_TABLE_THREADED_BLOCK_LEN);
+}
+
+/**
+ * Threaded version of #hash_array_from_data, used for large arrays.
+ */
+static void hash_array_from_data_threaded(const BArrayInfo *info,
+                                          const uchar *data_slice,
+                                          const size_t data_slice_len,
+                                          hash_key *hash_array)
+{
+  const size_t hash_array_len = data_slice_len / info->chunk_stride;
+  if (hash_array_len < 2 * HASH_TABLE_THREADED_BLOCK_LEN) {
+    hash_array_from_data(info, data_slice, data_slice_len, hash_array);
+    return;
+  }
+
+  HashArrayThreadData data = {
+      .info = info,
+      .data = data_slice,
+      .hash_array = hash_array,
+      .hash_array_len = hash_array_len,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(
+      0, hash_array_block_len(hash_array_len), &data, hash_array_from_data_block_cb, &settings);
+}
+
+/**
+ * Threaded version of #hash_accum, used for large arrays.
+ *
+ * Each step only reads the values of the previous step,
+ * these are copied first so blocks can be accumulated independently.
+ */
+static void hash_accum_threaded(hash_key *hash_array,
+                                const size_t hash_array_len,
+                                size_t iter_steps)
+{
+  if (UNLIKELY((iter_steps > hash_array_len))) {
+    iter_steps = hash_array_len;
+  }
+
+  const size_t hash_array_search_len = hash_array_len - iter_steps;
+  if (hash_array_search_len < 2 * HASH_TABLE_THREADED_BLOCK_LEN) {
+    hash_accum(hash_array, hash_array_len, iter_steps);
+    return;
+  }
+
+  hash_key *hash_array_prev = MEM_mallocN(sizeof(*hash_array_prev) * hash_array_len, __func__);
+
+  HashArrayThreadData data = {
+      .hash_array = hash_array,
+      .hash_array_prev = hash_array_prev,
+      .hash_array_len = hash_array_search_len,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  while (iter_steps != 0) {
+    memcpy(hash_array_prev, hash_array, sizeof(*hash_array) * hash_array_len);
+    data.hash_offset = iter_steps;
+    BLI_task_parallel_range(
+        0, hash_array_block_len(hash_array_search_len), &data, hash_accum_block_cb, &settings);
+    iter_steps -= 1;
+  }
+
+  MEM_freeN(hash_array_prev);
+}
+
+#  endif /* USE_HASH_TABLE_THREADED */
+
 /**
  * When we only need a single value, can use a small optimization.
  * we can avoid accumulating the tail of the array a little, each iteration.
@@ -1206,9 +1346,15 @@ static BChunkList *bchunk_list_from_data_merge(const BArrayInfo *info,
     const size_t table_hash_array_len = (data_len - i_prev) / info->chunk_stride;
     hash_key *table_hash_array = MEM_mallocN(sizeof(*table_hash_array) * table_hash_array_len,
                                              __func__);
+#  ifdef USE_HASH_TABLE_THREADED
+    hash_array_from_data_threaded(info, &data[i_prev], data_len - i_prev, table_hash_array);
+
+    hash_accum_threaded(table_hash_array, table_hash_array_len, info->accum_steps);
+#  else
     hash_array_from_data(info, &data[i_prev], data_len - i_prev, table_hash_array);
 
     hash_accum(table_hash_array, table_hash_array_len, info->accum_steps);
+#  endif
 #else
     /* dummy vars */
     uint i_table_start = 0;
@@ -0,0 +1,303 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * A thread-safe hash map made of #GHash shards with striped spin locks.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "BLI_concurrent_hash.h" /* own include */
+#include "BLI_ghash.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+
+/* keep last */
+#include "BLI_strict_flags.h"
+
+/* -------------------------------------------------------------------- */
+/** \name Structs & Constants
+ * \{ */
+
+#define SHARD_BITS 6
+#define SHARD_NUM (1 << SHARD_BITS)
+
+typedef union ConcurrentHashShard {
+  struct {
+    SpinLock lock;
+    GHash *ghash;
+  } data;
+  /* Keep shards on separate cache lines, so threads using different shards don't contend. */
+  char _pad[64];
+} ConcurrentHashShard;
+
+struct ConcurrentHash {
+  ConcurrentHashShard shards[SHARD_NUM];
+  GHashHashFP hashfp;
+};
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Internal Utility API
+ * \{ */
+
+/**
+ * The shard is picked from the high bits of the (scrambled) hash, while #GHash uses the low bits
+ * to pick a bucket, so the keys of a shard still spread over all of its buckets.
+ */
+BLI_INLINE ConcurrentHashShard *concurrent_hash_shard(ConcurrentHash *ch, const void *key)
+{
+  const uint hash = ch->hashfp(key) * 0x9e3779b1u;
+  return &ch->shards[hash >> (32 - SHARD_BITS)];
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Public API
+ * \{ */
+
+/**
+ * Creates a new, empty ConcurrentHash.
+ *
+ * \param nentries_reserve: Optionally reserve the number of members that the hash will hold,
+ * spread evenly over the shards.
+ */
+ConcurrentHash *BLI_concurrent_hash_new_ex(GHashHashFP hashfp,
+                                           GHashCmpFP cmpfp,
+                                           const char *info,
+                                           const unsigned int nentries_reserve)
+{
+  /* Aligned so the shard padding actually maps each shard to its own cache line. */
+  ConcurrentHash *ch = MEM_mallocN_aligned(sizeof(*ch), sizeof(ConcurrentHashShard), info);
+  ch->hashfp = hashfp;
+
+  for (int i = 0; i < SHARD_NUM; i++) {
+    ConcurrentHashShard *shard = &ch->shards[i];
+    BLI_spin_init(&shard->data.lock);
+    shard->data.ghash = BLI_ghash_new_ex(hashfp, cmpfp, info, nentries_reserve / SHARD_NUM);
+  }
+
+  return ch;
+}
+
+/**
+ * Wraps #BLI_concurrent_hash_new_ex with zero entries reserved.
+ */
+ConcurrentHash *BLI_concurrent_hash_new(GHashHashFP hashfp, GHashCmpFP cmpfp, const char *info)
+{
+  return BLI_concurrent_hash_new_ex(hashfp, cmpfp, info, 0);
+}
+
+ConcurrentHash *BLI_concurrent_hash_ptr_new(const char *info)
+{
+  return BLI_concurrent_hash_new(BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, info);
+}
+
+ConcurrentHash *BLI_concurrent_hash_int_new(const char *info)
+{
+  return BLI_concurrent_hash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, info);
+}
+
+/**
+ * Frees the ConcurrentHash and its members. Not thread-safe.
+ */
+void BLI_concurrent_hash_free(ConcurrentHash *ch,
+                              GHashKeyFreeFP keyfreefp,
+                              GHashValFreeFP valfreefp)
+{
+  for (int i = 0; i < SHARD_NUM; i++) {
+    ConcurrentHashShard *shard = &ch->shards[i];
+    BLI_ghash_free(shard->data.ghash, keyfreefp, valfreefp);
+    BLI_spin_end(&shard->data.lock);
+  }
+  MEM_freeN(ch);
+}
+
+/**
+ * Remove all entries. Not thread-safe.
+ */
+void BLI_concurrent_hash_clear(ConcurrentHash *ch,
+                               GHashKeyFreeFP keyfreefp,
+                               GHashValFreeFP valfreefp)
+{
+  for (int i = 0; i < SHARD_NUM; i++) {
+    BLI_ghash_clear(ch->shards[i].data.ghash, keyfreefp, valfreefp);
+  }
+}
+
+/**
+ * Insert \a key with \a val, unless \a key is already in the map.
+ *
+ * \return true if the key was added, false if another value was already there.
+ */
+bool BLI_concurrent_hash_add(ConcurrentHash *ch, void *key, void *val)
+{
+  ConcurrentHashShard *shard = concurrent_hash_shard(ch, key);
+  void **val_p;
+
+  BLI_spin_lock(&shard->data.lock);
+  const bool added = !BLI_ghash_ensure_p(shard->data.ghash, key, &val_p);
+  if (added) {
+    *val_p = val;
+  }
+  BLI_spin_unlock(&shard->data.lock);
+
+  return added;
+}
+
+/**
+ * Get the value of \a key, adding it first with the value returned by \a createfp if it isn't in
+ * the map yet. When multiple threads race to add the same key, \a createfp is only called once
+ * and all of them get the same value.
+ *
+ * \param r_created: Optionally, set to whether this call added the key.
+ */
+void *BLI_concurrent_hash_lookup_or_create(ConcurrentHash *ch,
+                                           void *key,
+                                           ConcurrentHashCreateFP createfp,
+                                           void *userdata,
+                                           bool *r_created)
+{
+  ConcurrentHashShard *shard = concurrent_hash_shard(ch, key);
+  void **val_p;
+
+  BLI_spin_lock(&shard->data.lock);
+  const bool created = !BLI_ghash_ensure_p(shard->data.ghash, key, &val_p);
+  if (created) {
+    *val_p = createfp(key, userdata);
+  }
+  void *val = *val_p;
+  BLI_spin_unlock(&shard->data.lock);
+
+  if (r_created) {
+    *r_created = created;
+  }
+  return val;
+}
+
+/**
+ * \return the value for \a key or NULL.
+ */
+void *BLI_concurrent_hash_lookup(ConcurrentHash *ch, const void *key)
+{
+  ConcurrentHashShard *shard = concurrent_hash_shard(ch, key);
+
+  BLI_spin_lock(&shard->data.lock);
+  void *val = BLI_ghash_lookup(shard->data.ghash, key);
+  BLI_spin_unlock(&shard->data.lock);
+
+  return val;
+}
+
+bool BLI_concurrent_hash_haskey(ConcurrentHash *ch, const void *key)
+{
+  ConcurrentHashShard *shard = concurrent_hash_shard(ch, key);
+
+  BLI_spin_lock(&shard->data.lock);
+  const bool found = BLI_ghash_haskey(shard->data.ghash, key);
+  BLI_spin_unlock(&shard->data.lock);
+
+  return found;
+}
+
+/**
+ * Remove \a key, the free callbacks are called with the shard locked.
+ *
+ * \return true if \a key was removed.
+ */
+bool BLI_concurrent_hash_remove(ConcurrentHash *ch,
+                                const void *key,
+                                GHashKeyFreeFP keyfreefp,
+                                GHashValFreeFP valfreefp)
+{
+  ConcurrentHashShard *shard = concurrent_hash_shard(ch, key);
+
+  BLI_spin_lock(&shard->data.lock);
+  const bool removed = BLI_ghash_remove(shard->data.ghash, key, keyfreefp, valfreefp);
+  BLI_spin_unlock(&shard->data.lock);
+
+  return removed;
+}
+
+/**
+ * \return the number of entries. Only exact when no other thread modifies the map.
+ */
+unsigned int BLI_concurrent_hash_len(ConcurrentHash *ch)
+{
+  uint len = 0;
+  for (int i = 0; i < SHARD_NUM; i++) {
+    ConcurrentHashShard *shard = &ch->shards[i];
+    BLI_spin_lock(&shard->data.lock);
+    len += BLI_ghash_len(shard->data.ghash);
+    BLI_spin_unlock(&shard->data.lock);
+  }
+  return len;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Parallel Iteration
+ * \{ */
+
+typedef struct ConcurrentHashForeachData {
+  ConcurrentHash *ch;
+  ConcurrentHashForeachFP func;
+  void *userdata;
+} ConcurrentHashForeachData;
+
+static void concurrent_hash_foreach_shard_cb(void *__restrict userdata,
+                                             const int index,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ConcurrentHashForeachData *data = userdata;
+  GHashIterator gh_iter;
+
+  GHASH_ITER (gh_iter, data->ch->shards[index].data.ghash) {
+    data->func(BLI_ghashIterator_getKey(&gh_iter),
+               BLI_ghashIterator_getValue(&gh_iter),
+               data->userdata);
+  }
+}
+
+/**
+ * Call \a func for every entry, with each shard handled by one thread.
+ * The map must not be modified until this returns, \a func has to be thread-safe.
+ */
+void BLI_concurrent_hash_foreach_parallel(ConcurrentHash *ch,
+                                          ConcurrentHashForeachFP func,
+                                          void *userdata)
+{
+  ConcurrentHashForeachData data = {
+      .ch = ch,
+      .func = func,
+      .userdata = userdata,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  BLI_task_parallel_range(0, SHARD_NUM, &data, concurrent_hash_foreach_shard_cb, &settings);
+}
+
+/** \} */
@@ -29,14 +29,16 @@
  *  - Literals:
  *      floating point and decimal integer.
  *  - Constants:
- *      pi, True, False
+ *      pi, e, tau, True, False
  *  - Operators:
  *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
  *      min, max, radians, degrees,
  *      abs, fabs, floor, ceil, trunc, int,
  *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      sinh, cosh, tanh, asinh, acosh, atanh,
+ *      exp, expm1, log (with optional base), log10, log2, log1p,
+ *      sqrt, pow, fmod, hypot, copysign, round
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -326,6 +328,11 @@ static double op_degrees(double arg)
   return arg * 180.0 / M_PI;
 }
 
+static double op_log_base(double x, double base)
+{
+  return log(x) / log(base);
+}
+
 static double op_not(double a)
 {
   return a ? 0.0 : 1.0;
@@ -367,7 +374,7 @@ typedef struct BuiltinConstDef {
 } BuiltinConstDef;
 
 static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+    {"pi", M_PI}, {"e", M_E}, {"tau", 2.0 * M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
 
 typedef struct BuiltinOpDef {
   const char *name;
@@ -398,11 +405,26 @@ static BuiltinOpDef builtin_ops[] = {
     {"acos", OPCODE_FUNC1, acos},
     {"atan", OPCODE_FUNC1, atan},
     {"atan2", OPCODE_FUNC2, atan2},
+    {"sinh", OPCODE_FUNC1, sinh},
+    {"cosh", OPCODE_FUNC1, cosh},
+    {"tanh", OPCODE_FUNC1, tanh},
+    {"asinh", OPCODE_FUNC1, asinh},
+    {"acosh", OPCODE_FUNC1, acosh},
+    {"atanh", OPCODE_FUNC1, atanh},
     {"exp", OPCODE_FUNC1, exp},
+    {"expm1", OPCODE_FUNC1, expm1},
     {"log", OPCODE_FUNC1, log},
+    {"log", OPCODE_FUNC2, op_log_base},
+    {"log10", OPCODE_FUNC1, log10},
+    {"log2", OPCODE_FUNC1, log2},
+    {"log1p", OPCODE_FUNC1, log1p},
     {"sqrt", OPCODE_FUNC1, sqrt},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
+    {"hypot", OPCODE_FUNC2, hypot},
+    {"copysign", OPCODE_FUNC2, copysign},
+    /* Python rounds halfway cases to even, like rint() in the default rounding mode. */
+    {"round", OPCODE_FUNC1, rint},
     {NULL, OPCODE_CONST, NULL},
 };
 
@@ -755,6 +777,15 @@ static bool parse_unary(ExprParseState *state)
         if (STREQ(state->tokenbuf, builtin_ops[i].name)) {
           int args = parse_function_args(state);
 
+          /* Some functions have several entries with a different argument count, e.g. log. */
+          for (int j = i; builtin_ops[j].name; j++) {
+            if (STREQ(builtin_ops[j].name, builtin_ops[i].name) &&
+                args == (builtin_ops[j].op == OPCODE_FUNC2 ? 2 : 1)) {
+              i = j;
+              break;
+            }
+          }
+
           return parse_add_func(state, builtin_ops[i].op, args, builtin_ops[i].funcptr);
         }
       }
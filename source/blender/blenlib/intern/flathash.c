@@ -0,0 +1,649 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * An open addressing (pointer -> pointer) hash table with the interface of #GHash.
+ *
+ * The design follows "Swiss tables": each slot has a control byte, which is either
+ * #CTRL_EMPTY, #CTRL_DELETED or the top 7 bits of the hash of the key stored in the slot.
+ * Probing is done a group of #GROUP_WIDTH control bytes at a time, the key comparison function
+ * is only called for slots whose control byte matches.
+ */
+
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_sys_types.h"
+#include "BLI_utildefines.h"
+
+#include "BLI_math_bits.h"
+
+#include "BLI_flathash.h" /* own include */
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+/* keep last */
+#include "BLI_strict_flags.h"
+
+/* -------------------------------------------------------------------- */
+/** \name Structs & Constants
+ * \{ */
+
+#define GROUP_WIDTH 16
+
+/* Full slots store 7 bits of the hash, so they are never negative. */
+#define CTRL_EMPTY ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+
+/* Grow when more than 7/8 of the slots are used. */
+#define CAPACITY_TO_GROWTH(capacity) ((capacity) - (capacity) / 8)
+
+typedef struct FlatHashSlot {
+  void *key;
+  void *val;
+} FlatHashSlot;
+
+struct FlatHash {
+  GHashHashFP hashfp;
+  GHashCmpFP cmpfp;
+
+  /* `capacity + GROUP_WIDTH` control bytes. The last group is a copy of the first one, so a
+   * group can be loaded starting at any slot without having to wrap around. */
+  int8_t *ctrl;
+  FlatHashSlot *slots;
+  /* Always a power of two, and at least #GROUP_WIDTH. */
+  uint capacity;
+  uint nentries;
+  /* Number of empty slots that can still be used before growing. Deleted slots are not
+   * counted, they are only cleaned up when the table is rebuilt. */
+  uint growth_left;
+};
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Internal Utility API
+ * \{ */
+
+/**
+ * The hash functions used with #GHash don't always spread their bits well (pointers for
+ * example), while both the low bits (for the slot) and the high bits (for the control byte)
+ * are used here.
+ */
+BLI_INLINE uint flathash_mix(uint hash)
+{
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+BLI_INLINE int8_t flathash_h2(const uint hash)
+{
+  return (int8_t)(hash >> 25);
+}
+
+/**
+ * Bit-mask of the control bytes in the group starting at \a ctrl that are equal to \a h.
+ */
+BLI_INLINE uint flathash_group_match(const int8_t *ctrl, const int8_t h)
+{
+#ifdef __SSE2__
+  const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+  return (uint)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)h), group));
+#else
+  uint mask = 0;
+  for (uint i = 0; i < GROUP_WIDTH; i++) {
+    if (ctrl[i] == h) {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+/**
+ * Bit-mask of the empty or deleted slots in the group starting at \a ctrl.
+ */
+BLI_INLINE uint flathash_group_match_free(const int8_t *ctrl)
+{
+#ifdef __SSE2__
+  /* Only empty and deleted control bytes have their sign bit set. */
+  const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+  return (uint)_mm_movemask_epi8(group);
+#else
+  uint mask = 0;
+  for (uint i = 0; i < GROUP_WIDTH; i++) {
+    if (ctrl[i] < 0) {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+BLI_INLINE void flathash_set_ctrl(FlatHash *fh, const uint index, const int8_t h)
+{
+  fh->ctrl[index] = h;
+  /* Keep the copy of the first group in sync, this is a no-op for the other groups. */
+  fh->ctrl[((index - GROUP_WIDTH) & (fh->capacity - 1)) + GROUP_WIDTH] = h;
+}
+
+static uint flathash_capacity_for(const uint nentries)
+{
+  uint capacity = GROUP_WIDTH;
+  while (CAPACITY_TO_GROWTH(capacity) < nentries) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+static void flathash_alloc(FlatHash *fh, const uint capacity)
+{
+  fh->capacity = capacity;
+  fh->ctrl = MEM_mallocN((size_t)(capacity + GROUP_WIDTH), "FlatHash.ctrl");
+  fh->slots = MEM_mallocN(sizeof(*fh->slots) * (size_t)capacity, "FlatHash.slots");
+  memset(fh->ctrl, CTRL_EMPTY, (size_t)(capacity + GROUP_WIDTH));
+  fh->growth_left = CAPACITY_TO_GROWTH(capacity) - fh->nentries;
+}
+
+/**
+ * Index of the slot holding \a key, or -1 when there is none.
+ */
+static int flathash_find(const FlatHash *fh, const void *key, const uint hash)
+{
+  const uint mask = fh->capacity - 1;
+  const int8_t h2 = flathash_h2(hash);
+  uint pos = hash & mask;
+  uint step = 0;
+
+  while (true) {
+    const int8_t *group = fh->ctrl + pos;
+    uint match = flathash_group_match(group, h2);
+    while (match) {
+      const uint index = (pos + bitscan_forward_uint(match)) & mask;
+      if (!fh->cmpfp(key, fh->slots[index].key)) {
+        return (int)index;
+      }
+      match &= match - 1;
+    }
+    /* The key would have been stored in the first empty slot of its probe sequence. */
+    if (flathash_group_match(group, CTRL_EMPTY)) {
+      return -1;
+    }
+    /* Triangular probing visits every group when the capacity is a power of two. */
+    step += GROUP_WIDTH;
+    pos = (pos + step) & mask;
+  }
+}
+
+/**
+ * Index of the first empty or deleted slot in the probe sequence of \a hash.
+ * There always is one, as the table never becomes completely full.
+ */
+static uint flathash_find_free(const FlatHash *fh, const uint hash)
+{
+  const uint mask = fh->capacity - 1;
+  uint pos = hash & mask;
+  uint step = 0;
+
+  while (true) {
+    const uint match = flathash_group_match_free(fh->ctrl + pos);
+    if (match) {
+      return (pos + bitscan_forward_uint(match)) & mask;
+    }
+    step += GROUP_WIDTH;
+    pos = (pos + step) & mask;
+  }
+}
+
+static void flathash_resize(FlatHash *fh, const uint capacity)
+{
+  int8_t *ctrl_old = fh->ctrl;
+  FlatHashSlot *slots_old = fh->slots;
+  const uint capacity_old = fh->capacity;
+
+  flathash_alloc(fh, capacity);
+
+  for (uint i = 0; i < capacity_old; i++) {
+    if (ctrl_old[i] >= 0) {
+      const uint hash = flathash_mix(fh->hashfp(slots_old[i].key));
+      const uint index = flathash_find_free(fh, hash);
+      flathash_set_ctrl(fh, index, flathash_h2(hash));
+      fh->slots[index] = slots_old[i];
+    }
+  }
+
+  MEM_freeN(ctrl_old);
+  MEM_freeN(slots_old);
+}
+
+/**
+ * Make sure a new entry can be added without exceeding the maximum load.
+ */
+BLI_INLINE void flathash_ensure_growth(FlatHash *fh)
+{
+  if (UNLIKELY(fh->growth_left == 0)) {
+    /* When most used slots are deleted ones, rebuilding at the same size is enough. */
+    const bool grow = fh->nentries * 2 >= CAPACITY_TO_GROWTH(fh->capacity);
+    flathash_resize(fh, grow ? fh->capacity * 2 : fh->capacity);
+  }
+}
+
+/**
+ * Store a key that is known not to be in the table yet, returns the slot it was stored in.
+ */
+static FlatHashSlot *flathash_insert_new(FlatHash *fh, void *key, const uint hash)
+{
+  flathash_ensure_growth(fh);
+
+  const uint index = flathash_find_free(fh, hash);
+  if (fh->ctrl[index] == CTRL_EMPTY) {
+    fh->growth_left--;
+  }
+  flathash_set_ctrl(fh, index, flathash_h2(hash));
+  fh->nentries++;
+
+  FlatHashSlot *slot = &fh->slots[index];
+  slot->key = key;
+  slot->val = NULL;
+  return slot;
+}
+
+static void flathash_free_entries(FlatHash *fh,
+                                  GHashKeyFreeFP keyfreefp,
+                                  GHashValFreeFP valfreefp)
+{
+  if (keyfreefp == NULL && valfreefp == NULL) {
+    return;
+  }
+  for (uint i = 0; i < fh->capacity; i++) {
+    if (fh->ctrl[i] >= 0) {
+      if (keyfreefp) {
+        keyfreefp(fh->slots[i].key);
+      }
+      if (valfreefp) {
+        valfreefp(fh->slots[i].val);
+      }
+    }
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name FlatHash Public API
+ * \{ */
+
+/**
+ * Creates a new, empty FlatHash.
+ *
+ * \param hashfp: Hash callback.
+ * \param cmpfp: Comparison callback.
+ * \param info: Identifier string for the FlatHash.
+ * \param nentries_reserve: Optionally reserve the number of members that the hash will hold.
+ * Use this to avoid resizing buckets if the size is known or can be closely approximated.
+ * \return  An empty FlatHash.
+ */
+FlatHash *BLI_flathash_new_ex(GHashHashFP hashfp,
+                              GHashCmpFP cmpfp,
+                              const char *info,
+                              const unsigned int nentries_reserve)
+{
+  FlatHash *fh = MEM_mallocN(sizeof(*fh), info);
+
+  fh->hashfp = hashfp;
+  fh->cmpfp = cmpfp;
+  fh->nentries = 0;
+  flathash_alloc(fh, flathash_capacity_for(nentries_reserve));
+
+  return fh;
+}
+
+/**
+ * Wraps #BLI_flathash_new_ex with zero entries reserved.
+ */
+FlatHash *BLI_flathash_new(GHashHashFP hashfp, GHashCmpFP cmpfp, const char *info)
+{
+  return BLI_flathash_new_ex(hashfp, cmpfp, info, 0);
+}
+
+/**
+ * Frees the FlatHash and its members.
+ *
+ * \param fh: The FlatHash to free.
+ * \param keyfreefp: Optional callback to free the key.
+ * \param valfreefp: Optional callback to free the value.
+ */
+void BLI_flathash_free(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  flathash_free_entries(fh, keyfreefp, valfreefp);
+
+  MEM_freeN(fh->ctrl);
+  MEM_freeN(fh->slots);
+  MEM_freeN(fh);
+}
+
+/**
+ * Reserve given amount of entries (resize \a fh accordingly if needed).
+ */
+void BLI_flathash_reserve(FlatHash *fh, const unsigned int nentries_reserve)
+{
+  const uint capacity = flathash_capacity_for(nentries_reserve);
+  if (capacity > fh->capacity) {
+    flathash_resize(fh, capacity);
+  }
+}
+
+/**
+ * Insert a key/value pair into the \a fh.
+ *
+ * \note Duplicates are not checked,
+ * the caller is expected to ensure elements are unique.
+ */
+void BLI_flathash_insert(FlatHash *fh, void *key, void *val)
+{
+  const uint hash = flathash_mix(fh->hashfp(key));
+  BLI_assert(flathash_find(fh, key, hash) == -1);
+
+  FlatHashSlot *slot = flathash_insert_new(fh, key, hash);
+  slot->val = val;
+}
+
+/**
+ * Inserts a new value to a key that may already be in the FlatHash.
+ *
+ * Avoids #BLI_flathash_remove, #BLI_flathash_insert calls (double lookups)
+ *
+ * \returns true if a new key has been added.
+ */
+bool BLI_flathash_reinsert(
+    FlatHash *fh, void *key, void *val, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  const uint hash = flathash_mix(fh->hashfp(key));
+  const int index = flathash_find(fh, key, hash);
+
+  if (index != -1) {
+    FlatHashSlot *slot = &fh->slots[index];
+    if (keyfreefp) {
+      keyfreefp(slot->key);
+    }
+    if (valfreefp) {
+      valfreefp(slot->val);
+    }
+    slot->key = key;
+    slot->val = val;
+    return false;
+  }
+
+  FlatHashSlot *slot = flathash_insert_new(fh, key, hash);
+  slot->val = val;
+  return true;
+}
+
+/**
+ * Lookup the value of \a key in \a fh.
+ *
+ * \param key: The key to lookup.
+ * \returns the value for \a key or NULL.
+ */
+void *BLI_flathash_lookup(FlatHash *fh, const void *key)
+{
+  return BLI_flathash_lookup_default(fh, key, NULL);
+}
+
+/**
+ * A version of #BLI_flathash_lookup which accepts a fallback argument.
+ */
+void *BLI_flathash_lookup_default(FlatHash *fh, const void *key, void *val_default)
+{
+  const int index = flathash_find(fh, key, flathash_mix(fh->hashfp(key)));
+  return (index != -1) ? fh->slots[index].val : val_default;
+}
+
+/**
+ * Lookup a pointer to the value of \a key in \a fh.
+ *
+ * \param key: The key to lookup.
+ * \returns the pointer to value for \a key or NULL.
+ *
+ * \note The pointer is only valid until the next insertion.
+ */
+void **BLI_flathash_lookup_p(FlatHash *fh, const void *key)
+{
+  const int index = flathash_find(fh, key, flathash_mix(fh->hashfp(key)));
+  return (index != -1) ? &fh->slots[index].val : NULL;
+}
+
+/**
+ * Ensure \a key is exists in \a fh.
+ *
+ * This handles the common situation where the caller needs ensure a key is added to \a fh,
+ * constructing a new value in the case the key isn't found.
+ * Otherwise use the existing value.
+ *
+ * \returns true when the value was already there.
+ * \param r_val: The pointer to the value, only valid until the next insertion.
+ */
+bool BLI_flathash_ensure_p(FlatHash *fh, void *key, void ***r_val)
+{
+  const uint hash = flathash_mix(fh->hashfp(key));
+  const int index = flathash_find(fh, key, hash);
+
+  if (index != -1) {
+    *r_val = &fh->slots[index].val;
+    return true;
+  }
+
+  FlatHashSlot *slot = flathash_insert_new(fh, key, hash);
+  *r_val = &slot->val;
+  return false;
+}
+
+/**
+ * Remove \a key from \a fh, or return false if the key wasn't found.
+ *
+ * \param key: The key to remove.
+ * \param keyfreefp: Optional callback to free the key.
+ * \param valfreefp: Optional callback to free the value.
+ * \return true if \a key was removed from \a fh.
+ */
+bool BLI_flathash_remove(FlatHash *fh,
+                         const void *key,
+                         GHashKeyFreeFP keyfreefp,
+                         GHashValFreeFP valfreefp)
+{
+  const int index = flathash_find(fh, key, flathash_mix(fh->hashfp(key)));
+  if (index == -1) {
+    return false;
+  }
+
+  FlatHashSlot *slot = &fh->slots[index];
+  if (keyfreefp) {
+    keyfreefp(slot->key);
+  }
+  if (valfreefp) {
+    valfreefp(slot->val);
+  }
+  flathash_set_ctrl(fh, (uint)index, CTRL_DELETED);
+  fh->nentries--;
+  return true;
+}
+
+/**
+ * Remove \a key from \a fh, returning the value or NULL if the key wasn't found.
+ *
+ * \param key: The key to remove.
+ * \param keyfreefp: Optional callback to free the key.
+ * \return the value of \a key int \a fh or NULL.
+ */
+void *BLI_flathash_popkey(FlatHash *fh, const void *key, GHashKeyFreeFP keyfreefp)
+{
+  const int index = flathash_find(fh, key, flathash_mix(fh->hashfp(key)));
+  if (index == -1) {
+    return NULL;
+  }
+
+  void *val = fh->slots[index].val;
+  if (keyfreefp) {
+    keyfreefp(fh->slots[index].key);
+  }
+  flathash_set_ctrl(fh, (uint)index, CTRL_DELETED);
+  fh->nentries--;
+  return val;
+}
+
+/**
+ * Reset \a fh clearing all entries.
+ *
+ * \param keyfreefp: Optional callback to free the key.
+ * \param valfreefp: Optional callback to free the value.
+ * \param nentries_reserve: Optionally reserve the number of members that the hash will hold.
+ */
+void BLI_flathash_clear_ex(FlatHash *fh,
+                           GHashKeyFreeFP keyfreefp,
+                           GHashValFreeFP valfreefp,
+                           const unsigned int nentries_reserve)
+{
+  flathash_free_entries(fh, keyfreefp, valfreefp);
+
+  fh->nentries = 0;
+  const uint capacity = flathash_capacity_for(nentries_reserve);
+  if (capacity != fh->capacity) {
+    MEM_freeN(fh->ctrl);
+    MEM_freeN(fh->slots);
+    flathash_alloc(fh, capacity);
+  }
+  else {
+    memset(fh->ctrl, CTRL_EMPTY, (size_t)(fh->capacity + GROUP_WIDTH));
+    fh->growth_left = CAPACITY_TO_GROWTH(fh->capacity);
+  }
+}
+
+/**
+ * Wraps #BLI_flathash_clear_ex with zero entries reserved.
+ */
+void BLI_flathash_clear(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  BLI_flathash_clear_ex(fh, keyfreefp, valfreefp, 0);
+}
+
+/**
+ * \return true if the \a key is in \a fh.
+ */
+bool BLI_flathash_haskey(FlatHash *fh, const void *key)
+{
+  return flathash_find(fh, key, flathash_mix(fh->hashfp(key))) != -1;
+}
+
+/**
+ * \return size of the FlatHash.
+ */
+unsigned int BLI_flathash_len(FlatHash *fh)
+{
+  return fh->nentries;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name FlatHash Iterator API
+ * \{ */
+
+static void flathash_iterator_skip_free(FlatHashIterator *fhi)
+{
+  const FlatHash *fh = fhi->fh;
+  while (fhi->index < fh->capacity && fh->ctrl[fhi->index] < 0) {
+    fhi->index++;
+  }
+}
+
+/**
+ * Init an already allocated FlatHashIterator.
+ *
+ * \param fhi: The FlatHashIterator to initialize.
+ * \param fh: The FlatHash to iterate over.
+ */
+void BLI_flathashIterator_init(FlatHashIterator *fhi, FlatHash *fh)
+{
+  fhi->fh = fh;
+  fhi->index = 0;
+  flathash_iterator_skip_free(fhi);
+}
+
+/**
+ * Steps the iterator to the next index.
+ */
+void BLI_flathashIterator_step(FlatHashIterator *fhi)
+{
+  fhi->index++;
+  flathash_iterator_skip_free(fhi);
+}
+
+void *BLI_flathashIterator_getKey(FlatHashIterator *fhi)
+{
+  return fhi->fh->slots[fhi->index].key;
+}
+
+void *BLI_flathashIterator_getValue(FlatHashIterator *fhi)
+{
+  return fhi->fh->slots[fhi->index].val;
+}
+
+void **BLI_flathashIterator_getValue_p(FlatHashIterator *fhi)
+{
+  return &fhi->fh->slots[fhi->index].val;
+}
+
+bool BLI_flathashIterator_done(FlatHashIterator *fhi)
+{
+  return fhi->index >= fhi->fh->capacity;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Convenience Creation Functions
+ * \{ */
+
+FlatHash *BLI_flathash_ptr_new_ex(const char *info, const unsigned int nentries_reserve)
+{
+  return BLI_flathash_new_ex(
+      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, info, nentries_reserve);
+}
+FlatHash *BLI_flathash_ptr_new(const char *info)
+{
+  return BLI_flathash_ptr_new_ex(info, 0);
+}
+
+FlatHash *BLI_flathash_int_new_ex(const char *info, const unsigned int nentries_reserve)
+{
+  return BLI_flathash_new_ex(
+      BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, info, nentries_reserve);
+}
+FlatHash *BLI_flathash_int_new(const char *info)
+{
+  return BLI_flathash_int_new_ex(info, 0);
+}
+
+/** \} */
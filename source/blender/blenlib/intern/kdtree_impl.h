@@ -21,7 +21,9 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h"
+#include "BLI_array_parallel.h"
 #include "BLI_kdtree_impl.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "BLI_strict_flags.h"
 
@@ -40,6 +42,11 @@ typedef struct KDTreeNode {
   float co[KD_DIMS];
   int index;
   uint d; /* range is only (0..KD_DIMS - 1) */
+  /**
+   * When non-zero, the number of nodes in the sub-tree of this node, which are stored contiguously
+   * with this node in the middle. Searches scan these nodes linearly instead of traversing them.
+   */
+  uint leaf_len;
 } KDTreeNode;
 
 struct KDTree {
@@ -56,6 +63,17 @@ struct KDTree {
 #define KD_NEAR_ALLOC_INC 100 /* alloc increment for collecting nearest */
 #define KD_FOUND_ALLOC_INC 50 /* alloc increment for collecting nearest */
 
+/* Sub-trees up to this size are scanned linearly by searches. */
+#define KD_LEAF_LEN 8
+
+/* Build the sub-trees below this depth in parallel, for trees with at least
+ * #KD_BALANCE_PARALLEL_MIN nodes. */
+#define KD_BALANCE_PARALLEL_DEPTH 6
+#define KD_BALANCE_PARALLEL_MIN 10000
+
+/* Number of queries searched one after the other by #BLI_kdtree_3d_find_nearest_batch. */
+#define KD_BATCH_LEN 256
+
 #define KD_NODE_UNSET ((uint)-1)
 
 /**
@@ -139,25 +157,22 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
   copy_vn_vn(node->co, co);
   node->index = index;
   node->d = 0;
+  node->leaf_len = 0;
 
 #ifdef DEBUG
   tree->is_balanced = false;
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+/**
+ * Partition \a nodes around the median on \a axis and initialize the median node.
+ */
+static uint kdtree_balance_median(KDTreeNode *nodes, uint nodes_len, uint axis)
 {
   KDTreeNode *node;
   float co;
   uint left, right, median, i, j;
 
-  if (nodes_len <= 0) {
-    return KD_NODE_UNSET;
-  }
-  else if (nodes_len == 1) {
-    return 0 + ofs;
-  }
-
   /* quicksort style sorting around median */
   left = 0;
   right = nodes_len - 1;
@@ -190,9 +205,30 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
     }
   }
 
-  /* set node and sort subnodes */
   node = &nodes[median];
   node->d = axis;
+  node->leaf_len = (nodes_len <= KD_LEAF_LEN) ? nodes_len : 0;
+
+  return median;
+}
+
+static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (nodes_len == 1) {
+    nodes[0].leaf_len = 1;
+    return 0 + ofs;
+  }
+
+  median = kdtree_balance_median(nodes, nodes_len, axis);
+
+  /* set node and sort subnodes */
+  node = &nodes[median];
   axis = (axis + 1) % KD_DIMS;
   node->left = kdtree_balance(nodes, median, axis, ofs);
   node->right = kdtree_balance(
@@ -201,6 +237,69 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   return median + ofs;
 }
 
+/* A sub-tree built by a task, the result is written to #KDTreeBalanceTask.r_root. */
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  uint *r_root;
+} KDTreeBalanceTask;
+
+typedef struct KDTreeBalanceData {
+  KDTreeBalanceTask tasks[1 << KD_BALANCE_PARALLEL_DEPTH];
+  uint tasks_len;
+} KDTreeBalanceData;
+
+/**
+ * Balance the top levels of the tree, collecting the sub-trees below \a depth as tasks.
+ * The partitioning is the same as #kdtree_balance, so is the resulting tree.
+ */
+static void kdtree_balance_split(KDTreeBalanceData *data,
+                                 KDTreeNode *nodes,
+                                 uint nodes_len,
+                                 uint axis,
+                                 const uint ofs,
+                                 const uint depth,
+                                 uint *r_root)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (depth == 0 || nodes_len <= KD_LEAF_LEN) {
+    KDTreeBalanceTask *task = &data->tasks[data->tasks_len++];
+    task->nodes = nodes;
+    task->nodes_len = nodes_len;
+    task->axis = axis;
+    task->ofs = ofs;
+    task->r_root = r_root;
+    return;
+  }
+
+  median = kdtree_balance_median(nodes, nodes_len, axis);
+
+  node = &nodes[median];
+  axis = (axis + 1) % KD_DIMS;
+  *r_root = median + ofs;
+  kdtree_balance_split(data, nodes, median, axis, ofs, depth - 1, &node->left);
+  kdtree_balance_split(data,
+                       nodes + median + 1,
+                       (nodes_len - (median + 1)),
+                       axis,
+                       (median + 1) + ofs,
+                       depth - 1,
+                       &node->right);
+}
+
+static void kdtree_balance_task_cb(void *__restrict userdata,
+                                   const int index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KDTreeBalanceData *data = userdata;
+  KDTreeBalanceTask *task = &data->tasks[index];
+  *task->r_root = kdtree_balance(task->nodes, task->nodes_len, task->axis, task->ofs);
+}
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -210,13 +309,36 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len < KD_BALANCE_PARALLEL_MIN) {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  }
+  else {
+    KDTreeBalanceData *data = MEM_mallocN(sizeof(*data), __func__);
+    data->tasks_len = 0;
+    kdtree_balance_split(
+        data, tree->nodes, tree->nodes_len, 0, 0, KD_BALANCE_PARALLEL_DEPTH, &tree->root);
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, (int)data->tasks_len, data, kdtree_balance_task_cb, &settings);
+
+    MEM_freeN(data);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
 #endif
 }
 
+/**
+ * The first node of the leaf that \a node is the root of, see #KDTreeNode.leaf_len.
+ */
+BLI_INLINE const KDTreeNode *kdtree_leaf_nodes(const KDTreeNode *node)
+{
+  return node - node->leaf_len / 2;
+}
+
 static uint *realloc_nodes(uint *stack, uint *stack_len_capacity, const bool is_alloc)
 {
   uint *stack_new = MEM_mallocN((*stack_len_capacity + KD_NEAR_ALLOC_INC) * sizeof(uint),
@@ -230,54 +352,50 @@ static uint *realloc_nodes(uint *stack, uint *stack_len_capacity, const bool is_
   return stack_new;
 }
 
+static void kdtree_leaf_find_nearest(const KDTreeNode *node,
+                                     const float co[KD_DIMS],
+                                     const KDTreeNode **r_min_node,
+                                     float *r_min_dist)
+{
+  const KDTreeNode *leaf = kdtree_leaf_nodes(node);
+  for (uint i = 0; i < node->leaf_len; i++) {
+    const float dist = len_squared_vnvn(leaf[i].co, co);
+    if (dist < *r_min_dist) {
+      *r_min_dist = dist;
+      *r_min_node = &leaf[i];
+    }
+  }
+}
+
 /**
- * Find nearest returns index, and -1 if no node is found.
+ * \param min_node: Optional node to start with, when it's close to \a co
+ * most of the tree doesn't need to be visited.
  */
-int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
-                                 const float co[KD_DIMS],
-                                 KDTreeNearest *r_nearest)
+static const KDTreeNode *kdtree_find_nearest(const KDTree *tree,
+                                             const float co[KD_DIMS],
+                                             const KDTreeNode *min_node,
+                                             float *r_min_dist)
 {
   const KDTreeNode *nodes = tree->nodes;
-  const KDTreeNode *root, *min_node;
   uint *stack, stack_default[KD_STACK_INIT];
   float min_dist, cur_dist;
   uint stack_len_capacity, cur = 0;
 
-#ifdef DEBUG
-  BLI_assert(tree->is_balanced == true);
-#endif
-
-  if (UNLIKELY(tree->root == KD_NODE_UNSET)) {
-    return -1;
-  }
-
   stack = stack_default;
   stack_len_capacity = KD_STACK_INIT;
 
-  root = &nodes[tree->root];
-  min_node = root;
-  min_dist = len_squared_vnvn(root->co, co);
+  min_dist = min_node ? len_squared_vnvn(min_node->co, co) : FLT_MAX;
 
-  if (co[root->d] < root->co[root->d]) {
-    if (root->right != KD_NODE_UNSET) {
-      stack[cur++] = root->right;
-    }
-    if (root->left != KD_NODE_UNSET) {
-      stack[cur++] = root->left;
-    }
-  }
-  else {
-    if (root->left != KD_NODE_UNSET) {
-      stack[cur++] = root->left;
-    }
-    if (root->right != KD_NODE_UNSET) {
-      stack[cur++] = root->right;
-    }
-  }
+  stack[cur++] = tree->root;
 
   while (cur--) {
     const KDTreeNode *node = &nodes[stack[cur]];
 
+    if (node->leaf_len) {
+      kdtree_leaf_find_nearest(node, co, &min_node, &min_dist);
+      continue;
+    }
+
     cur_dist = node->co[node->d] - co[node->d];
 
     if (cur_dist < 0.0f) {
@@ -319,19 +437,180 @@ int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
     }
   }
 
+  if (stack != stack_default) {
+    MEM_freeN(stack);
+  }
+
+  *r_min_dist = min_dist;
+  return min_node;
+}
+
+/**
+ * Find nearest returns index, and -1 if no node is found.
+ */
+int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
+                                 const float co[KD_DIMS],
+                                 KDTreeNearest *r_nearest)
+{
+  const KDTreeNode *min_node;
+  float min_dist;
+
+#ifdef DEBUG
+  BLI_assert(tree->is_balanced == true);
+#endif
+
+  if (UNLIKELY(tree->root == KD_NODE_UNSET)) {
+    return -1;
+  }
+
+  min_node = kdtree_find_nearest(tree, co, NULL, &min_dist);
+
   if (r_nearest) {
     r_nearest->index = min_node->index;
     r_nearest->dist = sqrtf(min_dist);
     copy_vn_vn(r_nearest->co, min_node->co);
   }
 
-  if (stack != stack_default) {
-    MEM_freeN(stack);
+  return min_node->index;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name BLI_kdtree_3d_find_nearest_batch
+ * \{ */
+
+/* Bits per axis of the Morton codes used to order queries. */
+#define KD_MORTON_BITS MIN2(32u / KD_DIMS, 16u)
+
+typedef struct KDTreeBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  /* Query indices in Morton order. */
+  const int *order;
+  uint co_len;
+  KDTreeNearest *r_nearest;
+} KDTreeBatchData;
+
+/**
+ * Interleave the bits of the quantized coordinates,
+ * so nearby coordinates are likely to get nearby codes.
+ */
+static uint kdtree_morton_code(const float co[KD_DIMS],
+                               const float min[KD_DIMS],
+                               const float scale[KD_DIMS])
+{
+  uint quantized[KD_DIMS];
+  uint code = 0;
+
+  for (uint j = 0; j < KD_DIMS; j++) {
+    quantized[j] = (uint)((co[j] - min[j]) * scale[j]);
+  }
+  for (uint bit = 0; bit < KD_MORTON_BITS; bit++) {
+    for (uint j = 0; j < KD_DIMS; j++) {
+      code |= ((quantized[j] >> bit) & 1u) << (bit * KD_DIMS + j);
+    }
   }
+  return code;
+}
 
-  return min_node->index;
+static void kdtree_find_nearest_batch_cb(void *__restrict userdata,
+                                         const int batch,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  const uint start = (uint)batch * KD_BATCH_LEN;
+  const uint end = MIN2(start + KD_BATCH_LEN, data->co_len);
+  const KDTreeNode *min_node = NULL;
+
+  for (uint i = start; i < end; i++) {
+    const int index = data->order[i];
+    const float *co = data->co[index];
+    KDTreeNearest *nearest = &data->r_nearest[index];
+    float min_dist;
+
+    /* The previous query is close by, so its nearest node is a good first guess. */
+    min_node = kdtree_find_nearest(data->tree, co, min_node, &min_dist);
+
+    nearest->index = min_node->index;
+    nearest->dist = sqrtf(min_dist);
+    copy_vn_vn(nearest->co, min_node->co);
+  }
+}
+
+/**
+ * Find the nearest node for many coordinates at once, giving the same results as calling
+ * #BLI_kdtree_3d_find_nearest for each of them (except for which one of several equally near
+ * nodes is found).
+ *
+ * Queries are sorted so close coordinates are searched one after the other,
+ * which lets each search start with the result of the previous one, and run on multiple threads.
+ *
+ * \param r_nearest: An array of \a co_len, the index is -1 when the tree is empty.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        KDTreeNearest *r_nearest)
+{
+#ifdef DEBUG
+  BLI_assert(tree->is_balanced == true);
+#endif
+
+  if (UNLIKELY(tree->root == KD_NODE_UNSET)) {
+    for (uint i = 0; i < co_len; i++) {
+      r_nearest[i].index = -1;
+    }
+    return;
+  }
+
+  float min[KD_DIMS], max[KD_DIMS], scale[KD_DIMS];
+  for (uint j = 0; j < KD_DIMS; j++) {
+    min[j] = FLT_MAX;
+    max[j] = -FLT_MAX;
+  }
+  for (uint i = 0; i < co_len; i++) {
+    for (uint j = 0; j < KD_DIMS; j++) {
+      min[j] = min_ff(min[j], co[i][j]);
+      max[j] = max_ff(max[j], co[i][j]);
+    }
+  }
+  for (uint j = 0; j < KD_DIMS; j++) {
+    const float size = max[j] - min[j];
+    scale[j] = (size > 0.0f) ? (float)((1u << KD_MORTON_BITS) - 1) / size : 0.0f;
+  }
+
+  uint *codes = MEM_mallocN(sizeof(*codes) * co_len, __func__);
+  int *order = MEM_mallocN(sizeof(*order) * co_len, __func__);
+  for (uint i = 0; i < co_len; i++) {
+    codes[i] = kdtree_morton_code(co[i], min, scale);
+    order[i] = (int)i;
+  }
+  BLI_parallel_radix_sort_uint(codes, order, (int)co_len);
+  MEM_freeN(codes);
+
+  KDTreeBatchData data = {
+      .tree = tree,
+      .co = co,
+      .order = order,
+      .co_len = co_len,
+      .r_nearest = r_nearest,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4;
+  BLI_task_parallel_range(0,
+                          (int)((co_len + KD_BATCH_LEN - 1) / KD_BATCH_LEN),
+                          &data,
+                          kdtree_find_nearest_batch_cb,
+                          &settings);
+
+  MEM_freeN(order);
 }
 
+#undef KD_MORTON_BITS
+
+/** \} */
+
 /**
  * A version of #BLI_kdtree_3d_find_nearest which runs a callback
  * to filter out values.
@@ -680,6 +959,18 @@ int BLI_kdtree_nd_(range_search_with_len_squared_cb)(
   while (cur--) {
     const KDTreeNode *node = &nodes[stack[cur]];
 
+    if (node->leaf_len) {
+      const KDTreeNode *leaf = kdtree_leaf_nodes(node);
+      for (uint i = 0; i < node->leaf_len; i++) {
+        dist_sq = len_sq_fn(co, leaf[i].co, user_data);
+        if (dist_sq <= range_sq) {
+          nearest_add_in_range(
+              &nearest, nearest_len++, &nearest_len_capacity, leaf[i].index, dist_sq, leaf[i].co);
+        }
+      }
+      continue;
+    }
+
     if (co[node->d] + range < node->co[node->d]) {
       if (node->left != KD_NODE_UNSET) {
         stack[cur++] = node->left;
@@ -769,6 +1060,19 @@ void BLI_kdtree_nd_(range_search_cb)(
   while (cur--) {
     const KDTreeNode *node = &nodes[stack[cur]];
 
+    if (node->leaf_len) {
+      const KDTreeNode *leaf = kdtree_leaf_nodes(node);
+      for (uint i = 0; i < node->leaf_len; i++) {
+        dist_sq = len_squared_vnvn(leaf[i].co, co);
+        if (dist_sq <= range_sq) {
+          if (search_cb(user_data, leaf[i].index, leaf[i].co, dist_sq) == false) {
+            goto finally;
+          }
+        }
+      }
+      continue;
+    }
+
     if (co[node->d] + range < node->co[node->d]) {
       if (node->left != KD_NODE_UNSET) {
         stack[cur++] = node->left;
@@ -201,15 +201,42 @@ struct TaskPool {
 #endif
 };
 
+/* Queue of tasks ready for execution.
+ *
+ * Every worker thread owns one of those queues: tasks pushed from a worker thread go to its own
+ * queue, which the owner pops from the head (most recently pushed tasks first, which are most
+ * likely still in the CPU cache). Idle workers steal from the head of other threads' queues as
+ * well, see #task_queue_pop.
+ *
+ * The queue of thread 0 is shared by the main thread and any thread which is not managed by
+ * the scheduler, so tasks pushed from outside of the worker threads are picked up from there.
+ *
+ * Each queue has its own lock, so threads only contend when they actually touch the same queue,
+ * rather than on every push and pop as with a single global queue.
+ */
+typedef struct TaskQueue {
+  ListBase list;
+  SpinLock lock;
+  /* Number of tasks in the list, modified under the lock but read atomically without it. */
+  uint32_t num;
+} TaskQueue;
+
 struct TaskScheduler {
   pthread_t *threads;
   struct TaskThread *task_threads;
   int num_threads;
   bool background_thread_only;
 
-  ListBase queue;
-  ThreadMutex queue_mutex;
-  ThreadCondition queue_cond;
+  /* Idle worker threads are sleeping on this condition.
+   *
+   * The generation counter is incremented on every push, so a worker which did not find any task
+   * only goes to sleep if nothing was pushed since it started looking for work. Pushing threads
+   * only lock the mutex to wake workers up when some of them are actually sleeping.
+   */
+  ThreadMutex sleep_mutex;
+  ThreadCondition sleep_cond;
+  uint32_t num_sleeping;
+  uint32_t push_generation;
 
   ThreadMutex startup_mutex;
   ThreadCondition startup_cond;
@@ -225,6 +252,7 @@ typedef struct TaskThread {
   TaskScheduler *scheduler;
   int id;
   TaskThreadLocalStorage tls;
+  TaskQueue queue;
 } TaskThread;
 
 /* Helper */
@@ -353,55 +381,163 @@ static void task_pool_num_increase(TaskPool *pool, size_t new)
   BLI_mutex_unlock(&pool->num_mutex);
 }
 
-static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler, Task **task)
+BLI_INLINE void task_queue_init(TaskQueue *queue)
+{
+  BLI_listbase_clear(&queue->list);
+  BLI_spin_init(&queue->lock);
+  queue->num = 0;
+}
+
+BLI_INLINE void task_queue_end(TaskQueue *queue)
 {
-  bool found_task = false;
-  BLI_mutex_lock(&scheduler->queue_mutex);
+  Task *task;
+  /* delete leftover tasks */
+  for (task = queue->list.first; task; task = task->next) {
+    task_data_free(task, 0);
+  }
+  BLI_freelistN(&queue->list);
+  BLI_spin_end(&queue->lock);
+}
 
-  while (!scheduler->queue.first && !scheduler->do_exit) {
-    BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+BLI_INLINE bool task_scheduler_task_matches(TaskScheduler *scheduler, Task *task, TaskPool *pool)
+{
+  if (pool != NULL) {
+    /* Only tasks from the given pool, if we get a task from another pool,
+     * we can get into deadlock. */
+    return task->pool == pool;
   }
+  /* Worker threads can run any task, unless they only exist as a background fallback. */
+  return !scheduler->background_thread_only || task->pool->run_in_background;
+}
 
-  do {
-    Task *current_task;
+/* Pop first suitable task from the queue.
+ *
+ * Both owner and stealing threads take tasks from the head, so the priority order of the queue
+ * is respected. This also means that the chunks of a parallel range which is started from
+ * within a task (and hence pushed as high priority tasks to the local queue of the worker) are
+ * the first ones to be picked up by idle threads, instead of being serialized on the worker
+ * waiting for them.
+ */
+static Task *task_queue_pop(TaskScheduler *scheduler, TaskQueue *queue, TaskPool *pool)
+{
+  /* Lock-less early output: avoid touching the lock of queues which are empty, which is the
+   * common case when stealing. Worst case we miss a task which was just pushed, in which case
+   * the generation counter of the scheduler will make us look again. */
+  if (atomic_fetch_and_add_uint32(&queue->num, 0) == 0) {
+    return NULL;
+  }
 
-    /* Assuming we can only have a void queue in 'exit' case here seems logical
-     * (we should only be here after our worker thread has been woken up from a
-     * condition_wait(), which only happens after a new task was added to the queue),
-     * but it is wrong.
-     * Waiting on condition may wake up the thread even if condition is not signaled
-     * (spurious wake-ups), and some race condition may also empty the queue **after**
-     * condition has been signaled, but **before** awoken thread reaches this point...
-     * See http://stackoverflow.com/questions/8594591
-     *
-     * So we only abort here if do_exit is set.
-     */
-    if (scheduler->do_exit) {
-      BLI_mutex_unlock(&scheduler->queue_mutex);
-      return false;
+  Task *found_task = NULL;
+
+  BLI_spin_lock(&queue->lock);
+  for (Task *task = queue->list.first; task != NULL; task = task->next) {
+    if (task_scheduler_task_matches(scheduler, task, pool)) {
+      BLI_remlink(&queue->list, task);
+      atomic_sub_and_fetch_uint32(&queue->num, 1);
+      found_task = task;
+      break;
     }
+  }
+  BLI_spin_unlock(&queue->lock);
 
-    for (current_task = scheduler->queue.first; current_task != NULL;
-         current_task = current_task->next) {
-      TaskPool *pool = current_task->pool;
+  return found_task;
+}
 
-      if (scheduler->background_thread_only && !pool->run_in_background) {
-        continue;
-      }
+/* Find a task to be executed by the given thread.
+ *
+ * Own queue is checked first, then the queue shared with non-worker threads, and finally tasks
+ * are stolen from other worker threads, starting with the next thread so all threads do not
+ * fight for the same victim. If pool is not NULL, only tasks from that pool are considered.
+ */
+static Task *task_scheduler_find_task(TaskScheduler *scheduler, const int thread_id, TaskPool *pool)
+{
+  TaskThread *task_threads = scheduler->task_threads;
+  const int num_queues = scheduler->num_threads + 1;
+  Task *task;
 
-      *task = current_task;
-      found_task = true;
-      BLI_remlink(&scheduler->queue, *task);
-      break;
+  if (thread_id != 0) {
+    if ((task = task_queue_pop(scheduler, &task_threads[thread_id].queue, pool))) {
+      return task;
     }
-    if (!found_task) {
-      BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+  }
+
+  if ((task = task_queue_pop(scheduler, &task_threads[0].queue, pool))) {
+    return task;
+  }
+
+  for (int i = 1; i < num_queues; i++) {
+    const int victim_id = (thread_id + i) % num_queues;
+    if (victim_id == 0) {
+      continue;
+    }
+    if ((task = task_queue_pop(scheduler, &task_threads[victim_id].queue, pool))) {
+      return task;
     }
-  } while (!found_task);
+  }
 
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+  return NULL;
+}
 
-  return true;
+/* Get queue tasks are to be pushed to from the given thread. */
+BLI_INLINE TaskQueue *task_scheduler_push_queue(TaskScheduler *scheduler, int thread_id)
+{
+  if (thread_id == -1) {
+    TaskThread *thread = pthread_getspecific(scheduler->tls_id_key);
+    thread_id = (thread != NULL) ? thread->id : 0;
+  }
+  BLI_assert(thread_id >= 0 && thread_id <= scheduler->num_threads);
+  return &scheduler->task_threads[thread_id].queue;
+}
+
+static void task_scheduler_wakeup(TaskScheduler *scheduler, const bool wakeup_all)
+{
+  atomic_fetch_and_add_uint32(&scheduler->push_generation, 1);
+
+  /* NOTE: Both counters are accessed with atomic read-modify-write operations, which are full
+   * barriers. So either we see a sleeping thread here, or that thread will see the new
+   * generation before going to sleep. */
+  if (atomic_fetch_and_add_uint32(&scheduler->num_sleeping, 0) == 0) {
+    return;
+  }
+
+  BLI_mutex_lock(&scheduler->sleep_mutex);
+  if (wakeup_all) {
+    BLI_condition_notify_all(&scheduler->sleep_cond);
+  }
+  else {
+    BLI_condition_notify_one(&scheduler->sleep_cond);
+  }
+  BLI_mutex_unlock(&scheduler->sleep_mutex);
+}
+
+static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler,
+                                           const int thread_id,
+                                           Task **task)
+{
+  while (!scheduler->do_exit) {
+    const uint32_t generation = atomic_fetch_and_add_uint32(&scheduler->push_generation, 0);
+
+    *task = task_scheduler_find_task(scheduler, thread_id, NULL);
+    if (*task != NULL) {
+      return true;
+    }
+
+    /* Nothing to do, sleep until new tasks are pushed.
+     *
+     * Waiting on condition may wake up the thread even if condition is not signaled
+     * (spurious wake-ups), see http://stackoverflow.com/questions/8594591
+     * So the generation is checked in a loop. */
+    BLI_mutex_lock(&scheduler->sleep_mutex);
+    atomic_fetch_and_add_uint32(&scheduler->num_sleeping, 1);
+    while (!scheduler->do_exit &&
+           atomic_fetch_and_add_uint32(&scheduler->push_generation, 0) == generation) {
+      BLI_condition_wait(&scheduler->sleep_cond, &scheduler->sleep_mutex);
+    }
+    atomic_sub_and_fetch_uint32(&scheduler->num_sleeping, 1);
+    BLI_mutex_unlock(&scheduler->sleep_mutex);
+  }
+
+  return false;
 }
 
 BLI_INLINE void handle_local_queue(TaskThreadLocalStorage *tls, const int thread_id)
@@ -442,7 +578,7 @@ static void *task_scheduler_thread_run(void *thread_p)
   BLI_mutex_unlock(&scheduler->startup_mutex);
 
   /* keep popping off tasks */
-  while (task_scheduler_thread_wait_pop(scheduler, &task)) {
+  while (task_scheduler_thread_wait_pop(scheduler, thread_id, &task)) {
     TaskPool *pool = task->pool;
 
     /* run task */
@@ -471,9 +607,10 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
    * threads, so we keep track of the number of users. */
   scheduler->do_exit = false;
 
-  BLI_listbase_clear(&scheduler->queue);
-  BLI_mutex_init(&scheduler->queue_mutex);
-  BLI_condition_init(&scheduler->queue_cond);
+  BLI_mutex_init(&scheduler->sleep_mutex);
+  BLI_condition_init(&scheduler->sleep_cond);
+  scheduler->num_sleeping = 0;
+  scheduler->push_generation = 0;
 
   BLI_mutex_init(&scheduler->startup_mutex);
   BLI_condition_init(&scheduler->startup_cond);
@@ -496,8 +633,15 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
   scheduler->task_threads = MEM_mallocN(sizeof(TaskThread) * (num_threads + 1),
                                         "TaskScheduler task threads");
 
-  /* Initialize TLS for main thread. */
-  initialize_task_tls(&scheduler->task_threads[0].tls);
+  /* Initialize TLS and queues of all threads, including main thread, before launching any of
+   * the workers since they might start stealing tasks from each other right away. */
+  for (int i = 0; i < num_threads + 1; i++) {
+    TaskThread *thread = &scheduler->task_threads[i];
+    thread->scheduler = scheduler;
+    thread->id = i;
+    initialize_task_tls(&thread->tls);
+    task_queue_init(&thread->queue);
+  }
 
   pthread_key_create(&scheduler->tls_id_key, NULL);
 
@@ -510,9 +654,6 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
 
     for (i = 0; i < num_threads; i++) {
       TaskThread *thread = &scheduler->task_threads[i + 1];
-      thread->scheduler = scheduler;
-      thread->id = i + 1;
-      initialize_task_tls(&thread->tls);
 
       if (pthread_create(&scheduler->threads[i], NULL, task_scheduler_thread_run, thread) != 0) {
         fprintf(stderr, "TaskScheduler failed to launch thread %d/%d\n", i, num_threads);
@@ -536,13 +677,11 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
 
 void BLI_task_scheduler_free(TaskScheduler *scheduler)
 {
-  Task *task;
-
   /* stop all waiting threads */
-  BLI_mutex_lock(&scheduler->queue_mutex);
+  BLI_mutex_lock(&scheduler->sleep_mutex);
   scheduler->do_exit = true;
-  BLI_condition_notify_all(&scheduler->queue_cond);
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+  BLI_condition_notify_all(&scheduler->sleep_cond);
+  BLI_mutex_unlock(&scheduler->sleep_mutex);
 
   pthread_key_delete(scheduler->tls_id_key);
 
@@ -559,25 +698,20 @@ void BLI_task_scheduler_free(TaskScheduler *scheduler)
     MEM_freeN(scheduler->threads);
   }
 
-  /* Delete task thread data */
+  /* Delete task thread data and leftover tasks. */
   if (scheduler->task_threads) {
     for (int i = 0; i < scheduler->num_threads + 1; i++) {
-      TaskThreadLocalStorage *tls = &scheduler->task_threads[i].tls;
-      free_task_tls(tls);
+      TaskThread *thread = &scheduler->task_threads[i];
+      task_queue_end(&thread->queue);
+      free_task_tls(&thread->tls);
     }
 
     MEM_freeN(scheduler->task_threads);
   }
 
-  /* delete leftover tasks */
-  for (task = scheduler->queue.first; task; task = task->next) {
-    task_data_free(task, 0);
-  }
-  BLI_freelistN(&scheduler->queue);
-
   /* delete mutex/condition */
-  BLI_mutex_end(&scheduler->queue_mutex);
-  BLI_condition_end(&scheduler->queue_cond);
+  BLI_mutex_end(&scheduler->sleep_mutex);
+  BLI_condition_end(&scheduler->sleep_cond);
   BLI_mutex_end(&scheduler->startup_mutex);
   BLI_condition_end(&scheduler->startup_cond);
 
@@ -589,65 +723,85 @@ int BLI_task_scheduler_num_threads(TaskScheduler *scheduler)
   return scheduler->num_threads + 1;
 }
 
-static void task_scheduler_push(TaskScheduler *scheduler, Task *task, TaskPriority priority)
+static void task_scheduler_push(TaskScheduler *scheduler,
+                                Task *task,
+                                TaskPriority priority,
+                                int thread_id)
 {
+  TaskQueue *queue = task_scheduler_push_queue(scheduler, thread_id);
+
   task_pool_num_increase(task->pool, 1);
 
   /* add task to queue */
-  BLI_mutex_lock(&scheduler->queue_mutex);
+  BLI_spin_lock(&queue->lock);
 
   if (priority == TASK_PRIORITY_HIGH) {
-    BLI_addhead(&scheduler->queue, task);
+    BLI_addhead(&queue->list, task);
   }
   else {
-    BLI_addtail(&scheduler->queue, task);
+    BLI_addtail(&queue->list, task);
   }
+  atomic_add_and_fetch_uint32(&queue->num, 1);
+
+  BLI_spin_unlock(&queue->lock);
 
-  BLI_condition_notify_one(&scheduler->queue_cond);
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+  task_scheduler_wakeup(scheduler, false);
 }
 
-static void task_scheduler_push_all(TaskScheduler *scheduler,
-                                    TaskPool *pool,
-                                    Task **tasks,
-                                    int num_tasks)
+static void task_scheduler_push_all(
+    TaskScheduler *scheduler, TaskPool *pool, Task **tasks, int num_tasks, int thread_id)
 {
   if (num_tasks == 0) {
     return;
   }
 
+  TaskQueue *queue = task_scheduler_push_queue(scheduler, thread_id);
+
   task_pool_num_increase(pool, num_tasks);
 
-  BLI_mutex_lock(&scheduler->queue_mutex);
+  BLI_spin_lock(&queue->lock);
 
   for (int i = 0; i < num_tasks; i++) {
-    BLI_addhead(&scheduler->queue, tasks[i]);
+    BLI_addhead(&queue->list, tasks[i]);
   }
+  atomic_add_and_fetch_uint32(&queue->num, (uint32_t)num_tasks);
 
-  BLI_condition_notify_all(&scheduler->queue_cond);
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+  BLI_spin_unlock(&queue->lock);
+
+  task_scheduler_wakeup(scheduler, true);
 }
 
 static void task_scheduler_clear(TaskScheduler *scheduler, TaskPool *pool)
 {
+  ListBase cleared_tasks = {NULL, NULL};
   Task *task, *nexttask;
   size_t done = 0;
 
-  BLI_mutex_lock(&scheduler->queue_mutex);
-
-  /* free all tasks from this pool from the queue */
-  for (task = scheduler->queue.first; task; task = nexttask) {
-    nexttask = task->next;
+  /* Collect all tasks from this pool from all the queues, their data is freed outside of the
+   * queue locks. */
+  for (int i = 0; i < scheduler->num_threads + 1; i++) {
+    TaskQueue *queue = &scheduler->task_threads[i].queue;
 
-    if (task->pool == pool) {
-      task_data_free(task, pool->thread_id);
-      BLI_freelinkN(&scheduler->queue, task);
+    BLI_spin_lock(&queue->lock);
+    for (task = queue->list.first; task; task = nexttask) {
+      nexttask = task->next;
 
-      done++;
+      if (task->pool == pool) {
+        BLI_remlink(&queue->list, task);
+        BLI_addtail(&cleared_tasks, task);
+        atomic_sub_and_fetch_uint32(&queue->num, 1);
+      }
     }
+    BLI_spin_unlock(&queue->lock);
   }
 
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+  /* free all tasks from this pool */
+  for (task = cleared_tasks.first; task; task = nexttask) {
+    nexttask = task->next;
+    task_data_free(task, pool->thread_id);
+    MEM_freeN(task);
+    done++;
+  }
 
   /* notify done */
   task_pool_num_decrease(pool, done);
@@ -849,10 +1003,10 @@ static void task_pool_push(TaskPool *pool,
       return;
     }
   }
-  /* Do push to a global execution pool, slowest possible method,
+  /* Do push to a scheduler's execution queue, slowest possible method,
    * causes quite reasonable amount of threading overhead.
    */
-  task_scheduler_push(pool->scheduler, task, priority);
+  task_scheduler_push(pool->scheduler, task, priority, thread_id);
 }
 
 void BLI_task_pool_push_ex(TaskPool *pool,
@@ -888,13 +1042,16 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
 
   if (atomic_fetch_and_and_uint8((uint8_t *)&pool->is_suspended, 0)) {
     if (pool->num_suspended) {
+      TaskQueue *queue = task_scheduler_push_queue(scheduler, pool->thread_id);
+
       task_pool_num_increase(pool, pool->num_suspended);
-      BLI_mutex_lock(&scheduler->queue_mutex);
+      BLI_spin_lock(&queue->lock);
 
-      BLI_movelisttolist(&scheduler->queue, &pool->suspended_queue);
+      BLI_movelisttolist(&queue->list, &pool->suspended_queue);
+      atomic_add_and_fetch_uint32(&queue->num, (uint32_t)pool->num_suspended);
 
-      BLI_condition_notify_all(&scheduler->queue_cond);
-      BLI_mutex_unlock(&scheduler->queue_mutex);
+      BLI_spin_unlock(&queue->lock);
+      task_scheduler_wakeup(scheduler, true);
 
       pool->num_suspended = 0;
     }
@@ -909,26 +1066,11 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
   BLI_mutex_lock(&pool->num_mutex);
 
   while (pool->num != 0) {
-    Task *task, *work_task = NULL;
-    bool found_task = false;
-
     BLI_mutex_unlock(&pool->num_mutex);
 
-    BLI_mutex_lock(&scheduler->queue_mutex);
-
-    /* find task from this pool. if we get a task from another pool,
-     * we can get into deadlock */
-
-    for (task = scheduler->queue.first; task; task = task->next) {
-      if (task->pool == pool) {
-        work_task = task;
-        found_task = true;
-        BLI_remlink(&scheduler->queue, task);
-        break;
-      }
-    }
-
-    BLI_mutex_unlock(&scheduler->queue_mutex);
+    /* find task from this pool, possibly stealing it from another thread's queue. */
+    Task *work_task = task_scheduler_find_task(scheduler, pool->thread_id, pool);
+    const bool found_task = (work_task != NULL);
 
     /* if found task, do it, otherwise wait until other tasks are done */
     if (found_task) {
@@ -938,7 +1080,7 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
       BLI_assert(!tls->do_delayed_push);
 
       /* delete task */
-      task_free(pool, task, pool->thread_id);
+      task_free(pool, work_task, pool->thread_id);
 
       /* Handle all tasks from local queue. */
       handle_local_queue(tls, pool->thread_id);
@@ -1016,7 +1158,8 @@ void BLI_task_pool_delayed_push_end(TaskPool *pool, int thread_id)
     ASSERT_THREAD_ID(pool->scheduler, thread_id);
     TaskThreadLocalStorage *tls = get_task_tls(pool, thread_id);
     BLI_assert(tls->do_delayed_push);
-    task_scheduler_push_all(pool->scheduler, pool, tls->delayed_queue, tls->num_delayed_queue);
+    task_scheduler_push_all(
+        pool->scheduler, pool, tls->delayed_queue, tls->num_delayed_queue, thread_id);
     tls->do_delayed_push = false;
     tls->num_delayed_queue = 0;
   }
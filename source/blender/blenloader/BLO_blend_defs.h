@@ -73,4 +73,34 @@ enum {
 
 #define BLEN_THUMB_MEMSIZE_FILE(_x, _y) (sizeof(int) * (2 + (size_t)(_x) * (size_t)(_y)))
 
+/**
+ * Compressed files are written as a sequence of independent gzip members (frames),
+ * each holding #BLEND_GZIP_FRAME_SIZE bytes of the uncompressed file (except for the last one).
+ *
+ * Frames are followed by an empty gzip member, whose extra header field (sub-field
+ * #BLEND_GZIP_INDEX_SI1, #BLEND_GZIP_INDEX_SI2) holds the frame index: the offset in the
+ * compressed file of each frame, followed by the footer. All values are little endian:
+ *
+ * - `uint64_t frame_offsets[frames_len]`
+ * - `uint64_t total_size` (uncompressed).
+ * - `uint32_t frame_size`
+ * - `uint32_t frames_len`
+ * - `char magic[4]` (#BLEND_GZIP_INDEX_MAGIC).
+ *
+ * Any gzip reader still reads this as a plain stream, while the index allows to seek
+ * without decompressing everything before, and frames to be (de)compressed in parallel.
+ */
+#define BLEND_GZIP_FRAME_SIZE (1 << 20)
+#define BLEND_GZIP_INDEX_SI1 'B'
+#define BLEND_GZIP_INDEX_SI2 'L'
+#define BLEND_GZIP_INDEX_MAGIC "BLZF"
+#define BLEND_GZIP_INDEX_FOOTER_SIZE (8 + 4 + 4 + 4)
+/** Size of the gzip header up to the extra field sub-field data (ID, CM, FLG, MTIME, XFL, OS,
+ * XLEN, SI1, SI2, LEN). */
+#define BLEND_GZIP_INDEX_HEADER_SIZE (10 + 2 + 4)
+/** Size of the empty deflate stream and gzip trailer (CRC32, ISIZE), after the extra field. */
+#define BLEND_GZIP_INDEX_TRAILER_SIZE (2 + 4 + 4)
+/** Limited by the maximum size of the extra field (which includes the sub-field header). */
+#define BLEND_GZIP_INDEX_FRAMES_MAX ((0xffff - 4 - BLEND_GZIP_INDEX_FOOTER_SIZE) / 8)
+
 #endif /* __BLO_BLEND_DEFS_H__ */
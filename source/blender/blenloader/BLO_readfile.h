@@ -76,8 +76,12 @@ typedef struct WorkspaceConfigFileData {
 } WorkspaceConfigFileData;
 
 struct BlendFileReadParams {
-  uint skip_flags : 2; /* eBLOReadSkip */
+  uint skip_flags : 3; /* eBLOReadSkip */
   uint is_startup : 1;
+
+  /** Undo memfile the current Main was last written to or read from, data-blocks which are
+   * unchanged between it and the memfile being read are kept instead of being re-read. */
+  struct MemFile *undo_reference_memfile;
 };
 
 /* skip reading some data-block types (may want to skip screen data too). */
@@ -85,6 +89,9 @@ typedef enum eBLOReadSkip {
   BLO_READ_SKIP_NONE = 0,
   BLO_READ_SKIP_USERDEF = (1 << 0),
   BLO_READ_SKIP_DATA = (1 << 1),
+  /** Don't read linked data-blocks from library files, placeholders are created instead
+   * (tagged #LIB_TAG_MISSING), the library can be reloaded to read them later. */
+  BLO_READ_SKIP_LINKED_DATA = (1 << 2),
 } eBLOReadSkip;
 #define BLO_READ_SKIP_ALL (BLO_READ_SKIP_USERDEF | BLO_READ_SKIP_DATA)
 
@@ -98,7 +105,7 @@ BlendFileData *BLO_read_from_memory(const void *mem,
 BlendFileData *BLO_read_from_memfile(struct Main *oldmain,
                                      const char *filename,
                                      struct MemFile *memfile,
-                                     eBLOReadSkip skip_flags,
+                                     const struct BlendFileReadParams *params,
                                      struct ReportList *reports);
 
 void BLO_blendfiledata_free(BlendFileData *bfd);
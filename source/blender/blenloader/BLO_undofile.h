@@ -25,6 +25,8 @@
  * \ingroup blenloader
  */
 
+struct GHash;
+struct GSet;
 struct Scene;
 
 typedef struct {
@@ -32,8 +34,12 @@ typedef struct {
   const char *buf;
   /** Size in bytes. */
   unsigned int size;
+  /** Hash of the chunk content, used to find identical chunks in a following step. */
+  unsigned int hash;
   /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
   bool is_identical;
+  /** Session uuid of the ID this chunk belongs to (#MAIN_ID_SESSION_UUID_UNSET if none). */
+  unsigned int id_session_uuid;
 } MemFileChunk;
 
 typedef struct MemFile {
@@ -41,6 +47,21 @@ typedef struct MemFile {
   size_t size;
 } MemFile;
 
+typedef struct MemFileWriteData {
+  MemFile *written_memfile;
+  MemFile *reference_memfile;
+
+  /** Session uuid of the ID being currently written (#MAIN_ID_SESSION_UUID_UNSET if none). */
+  unsigned int current_id_session_uuid;
+  /** Chunk of the reference memfile expected to match the next written one. */
+  MemFileChunk *reference_current_chunk;
+
+  /** Maps an ID session uuid to its first chunk in the reference memfile. */
+  struct GHash *id_session_uuid_mapping;
+  /** All chunks of the reference memfile, looked up by their content. */
+  struct GSet *reference_chunks;
+} MemFileWriteData;
+
 typedef struct MemFileUndoData {
   char filename[1024]; /* FILE_MAX */
   MemFile memfile;
@@ -48,14 +69,17 @@ typedef struct MemFileUndoData {
 } MemFileUndoData;
 
 /* actually only used writefile.c */
-extern void memfile_chunk_add(MemFile *memfile,
-                              const char *buf,
-                              unsigned int size,
-                              MemFileChunk **compchunk_step);
+extern void BLO_memfile_write_init(MemFileWriteData *mem_data,
+                                   MemFile *written_memfile,
+                                   MemFile *reference_memfile);
+extern void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
+extern void memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, unsigned int size);
 
 /* exports */
 extern void BLO_memfile_free(MemFile *memfile);
 extern void BLO_memfile_merge(MemFile *first, MemFile *second);
+extern struct GHash *BLO_memfile_id_chunks_map_new(MemFile *memfile);
+extern bool BLO_memfile_id_chunks_equal(const MemFileChunk *chunk_a, const MemFileChunk *chunk_b);
 
 /* utilities */
 extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
@@ -359,11 +359,13 @@ BlendFileData *BLO_read_from_memory(const void *mem,
  * \param oldmain: old main,
  * from which we will keep libraries and other data-blocks that should not have changed.
  * \param filename: current file, only for retrieving library data.
+ * \param params: when #BlendFileReadParams.undo_reference_memfile is set, local data-blocks
+ * unchanged since that memfile are moved from \a oldmain instead of being read again.
  */
 BlendFileData *BLO_read_from_memfile(Main *oldmain,
                                      const char *filename,
                                      MemFile *memfile,
-                                     eBLOReadSkip skip_flags,
+                                     const struct BlendFileReadParams *params,
                                      ReportList *reports)
 {
   BlendFileData *bfd = NULL;
@@ -373,7 +375,7 @@ BlendFileData *BLO_read_from_memfile(Main *oldmain,
   fd = blo_filedata_from_memfile(memfile, reports);
   if (fd) {
     fd->reports = reports;
-    fd->skip_flags = skip_flags;
+    fd->skip_flags = params->skip_flags;
     BLI_strncpy(fd->relabase, filename, sizeof(fd->relabase));
 
     /* clear ob->proxy_from pointers in old main */
@@ -396,6 +398,11 @@ BlendFileData *BLO_read_from_memfile(Main *oldmain,
     /* make lookups of existing sound data in old main */
     blo_make_sound_pointer_map(fd, oldmain);
 
+    /* make lookups of data-blocks which can be re-used as is from old main */
+    if (params->undo_reference_memfile != NULL) {
+      blo_make_undo_reuse_map(fd, oldmain, params->undo_reference_memfile);
+    }
+
     /* removed packed data from this trick - it's internal data that needs saves */
 
     bfd = blo_read_file_internal(fd, filename);
@@ -34,6 +34,7 @@
 #include "BLI_utildefines.h"
 #ifndef WIN32
 #  include <unistd.h>  // for read close
+#  include <sys/mman.h> // for mmap
 #else
 #  include <io.h>  // for open close read
 #  include "winsock2.h"
@@ -101,6 +102,8 @@
 #include "BLI_threads.h"
 #include "BLI_mempool.h"
 #include "BLI_ghash.h"
+#include "BLI_linklist.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -223,6 +226,17 @@
  */
 #define USE_BHEAD_READ_ON_DEMAND
 
+/**
+ * Map uncompressed files into memory instead of reading them through system calls.
+ * Data of the blocks is then copied (or reconstructed) straight from the mapping,
+ * without any intermediate buffer.
+ *
+ * \note Requires #USE_BHEAD_READ_ON_DEMAND to be of any use.
+ */
+#ifndef WIN32
+#  define USE_MMAP_READ
+#endif
+
 /* use GHash for BHead name-based lookups (speeds up linking) */
 #define USE_GHASH_BHEAD
 
@@ -960,11 +974,38 @@ BHead *blo_bhead_next(FileData *fd, BHead *thisblock)
 }
 
 #ifdef USE_BHEAD_READ_ON_DEMAND
+/**
+ * Get the data of a block which has not been read yet when it is directly accessible in memory
+ * (i.e. from a memory mapped file), NULL otherwise.
+ *
+ * \note This does not change the state of the file-data, so it is safe to call from threads.
+ */
+static const void *blo_bhead_data_mapped(const FileData *fd, const BHead *thisblock)
+{
+#  ifdef USE_MMAP_READ
+  if (fd->mmap_data != NULL) {
+    const BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+    BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+    if ((size_t)new_bhead->file_offset + (size_t)new_bhead->bhead.len <= fd->mmap_size) {
+      return fd->mmap_data + new_bhead->file_offset;
+    }
+  }
+#  else
+  UNUSED_VARS(fd, thisblock);
+#  endif
+  return NULL;
+}
+
 static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
 {
   bool success = true;
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
   BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  const void *data_mapped = blo_bhead_data_mapped(fd, thisblock);
+  if (data_mapped != NULL) {
+    memcpy(buf, data_mapped, new_bhead->bhead.len);
+    return true;
+  }
   off64_t offset_backup = fd->file_offset;
   if (UNLIKELY(fd->seek(fd, new_bhead->file_offset, SEEK_SET) == -1)) {
     success = false;
@@ -1175,6 +1216,288 @@ static int fd_read_gzip_from_file(FileData *filedata, void *buffer, uint size)
   return (readsize);
 }
 
+/* GZip file reading, with random access using the frame index. */
+
+/* Number of decompressed frames kept around (#BLEND_GZIP_FRAME_SIZE each), enough for reading
+ * data on demand shortly after the block headers were read. */
+#define GZIP_FRAME_CACHE_LEN 16
+
+typedef struct GzipFrameCache {
+  /* Index of the frame, -1 for unused entries. */
+  int frame;
+  uint64_t last_use;
+  char *data;
+  size_t data_len;
+  /* Only used while decompressing. */
+  char *comp;
+  size_t comp_len;
+} GzipFrameCache;
+
+typedef struct GzipFrameReader {
+  int filedes;
+  /* Offset of each frame in the compressed file,
+   * with an extra item for the offset of the index (end of the last frame). */
+  uint64_t *frame_offsets;
+  int frames_len;
+  uint32_t frame_size;
+  uint64_t total_size;
+
+  GzipFrameCache cache[GZIP_FRAME_CACHE_LEN];
+  uint64_t use_counter;
+  bool error;
+} GzipFrameReader;
+
+BLI_INLINE uint64_t gzip_frames_decode_uint(const uchar *buf, const int size)
+{
+  uint64_t value = 0;
+  for (int i = 0; i < size; i++) {
+    value |= (uint64_t)buf[i] << (8 * i);
+  }
+  return value;
+}
+
+static bool gzip_frames_read_raw(int filedes, uint64_t offset, void *buf, size_t len)
+{
+  if (lseek(filedes, (off64_t)offset, SEEK_SET) == -1) {
+    return false;
+  }
+  while (len != 0) {
+    const int readsize = read(filedes, buf, (uint)MIN2(len, INT_MAX));
+    if (readsize <= 0) {
+      return false;
+    }
+    buf = POINTER_OFFSET(buf, readsize);
+    len -= (size_t)readsize;
+  }
+  return true;
+}
+
+/**
+ * Read the frame index at the end of the file, written by #zlib_frames_write_index.
+ * \return NULL when there is no (valid) index, files can then only be read sequentially.
+ */
+static GzipFrameReader *gzip_frames_reader_create(int filedes)
+{
+  const off64_t file_size = lseek(filedes, 0, SEEK_END);
+  const uint64_t footer_end = (uint64_t)file_size - BLEND_GZIP_INDEX_TRAILER_SIZE;
+  uchar footer[BLEND_GZIP_INDEX_FOOTER_SIZE];
+  GzipFrameReader *reader = NULL;
+
+  if (file_size < BLEND_GZIP_INDEX_HEADER_SIZE + BLEND_GZIP_INDEX_FOOTER_SIZE +
+                      BLEND_GZIP_INDEX_TRAILER_SIZE ||
+      !gzip_frames_read_raw(filedes, footer_end - sizeof(footer), footer, sizeof(footer)) ||
+      memcmp(footer + 16, BLEND_GZIP_INDEX_MAGIC, 4) != 0) {
+    goto finally;
+  }
+
+  const uint64_t total_size = gzip_frames_decode_uint(footer, 8);
+  const uint32_t frame_size = (uint32_t)gzip_frames_decode_uint(footer + 8, 4);
+  const uint32_t frames_len = (uint32_t)gzip_frames_decode_uint(footer + 12, 4);
+  const size_t data_len = (size_t)frames_len * 8 + BLEND_GZIP_INDEX_FOOTER_SIZE;
+  const size_t index_len = BLEND_GZIP_INDEX_HEADER_SIZE + data_len +
+                           BLEND_GZIP_INDEX_TRAILER_SIZE;
+
+  if (frame_size == 0 || frames_len == 0 || frames_len > BLEND_GZIP_INDEX_FRAMES_MAX ||
+      index_len > (uint64_t)file_size ||
+      (total_size + frame_size - 1) / frame_size != frames_len) {
+    goto finally;
+  }
+
+  uchar *index = MEM_mallocN(index_len, __func__);
+  const uint64_t index_offset = (uint64_t)file_size - index_len;
+  if (gzip_frames_read_raw(filedes, index_offset, index, index_len) &&
+      /* ID1, ID2, CM (deflate), FLG (FEXTRA only). */
+      index[0] == 0x1f && index[1] == 0x8b && index[2] == 8 && index[3] == 4 &&
+      gzip_frames_decode_uint(index + 10, 2) == data_len + 4 &&
+      index[12] == BLEND_GZIP_INDEX_SI1 && index[13] == BLEND_GZIP_INDEX_SI2 &&
+      gzip_frames_decode_uint(index + 14, 2) == data_len) {
+    reader = MEM_callocN(sizeof(*reader), __func__);
+    reader->filedes = filedes;
+    reader->frames_len = (int)frames_len;
+    reader->frame_size = frame_size;
+    reader->total_size = total_size;
+    reader->frame_offsets = MEM_malloc_arrayN(
+        frames_len + 1, sizeof(*reader->frame_offsets), __func__);
+    for (int i = 0; i < (int)frames_len; i++) {
+      reader->frame_offsets[i] = gzip_frames_decode_uint(
+          index + BLEND_GZIP_INDEX_HEADER_SIZE + 8 * i, 8);
+    }
+    reader->frame_offsets[frames_len] = index_offset;
+    for (int i = 0; i < GZIP_FRAME_CACHE_LEN; i++) {
+      reader->cache[i].frame = -1;
+    }
+
+    /* Offsets must be increasing, otherwise consider the index as corrupted. */
+    for (int i = 0; i < (int)frames_len; i++) {
+      if (reader->frame_offsets[i] >= reader->frame_offsets[i + 1]) {
+        MEM_freeN(reader->frame_offsets);
+        MEM_freeN(reader);
+        reader = NULL;
+        break;
+      }
+    }
+  }
+  MEM_freeN(index);
+
+finally:
+  lseek(filedes, 0, SEEK_SET);
+  return reader;
+}
+
+static void gzip_frames_reader_free(GzipFrameReader *reader)
+{
+  for (int i = 0; i < GZIP_FRAME_CACHE_LEN; i++) {
+    MEM_SAFE_FREE(reader->cache[i].data);
+  }
+  MEM_freeN(reader->frame_offsets);
+  MEM_freeN(reader);
+}
+
+static void gzip_frames_decompress_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GzipFrameReader *reader = userdata;
+  GzipFrameCache *cache = reader->cache + i;
+  if (cache->comp == NULL) {
+    return;
+  }
+
+  z_stream strm = {NULL};
+  bool success = false;
+  if (inflateInit2(&strm, 16 + MAX_WBITS) == Z_OK) {
+    strm.next_in = (Bytef *)cache->comp;
+    strm.avail_in = (uInt)cache->comp_len;
+    strm.next_out = (Bytef *)cache->data;
+    strm.avail_out = (uInt)cache->data_len;
+    success = (inflate(&strm, Z_FINISH) == Z_STREAM_END) && (strm.avail_out == 0);
+    inflateEnd(&strm);
+  }
+
+  MEM_freeN(cache->comp);
+  cache->comp = NULL;
+  if (!success) {
+    cache->frame = -1;
+    reader->error = true;
+  }
+}
+
+/**
+ * Get the given frame decompressed. On a cache miss, following frames are decompressed
+ * at the same time (in parallel), since reading is mostly sequential.
+ */
+static GzipFrameCache *gzip_frames_ensure(GzipFrameReader *reader, const int frame)
+{
+  GzipFrameCache *cache = reader->cache;
+
+  for (int i = 0; i < GZIP_FRAME_CACHE_LEN; i++) {
+    if (cache[i].frame == frame) {
+      cache[i].last_use = ++reader->use_counter;
+      return &cache[i];
+    }
+  }
+
+  const int frames_num = min_iii(BLI_system_thread_count(),
+                                 GZIP_FRAME_CACHE_LEN / 2,
+                                 reader->frames_len - frame);
+  for (int frame_iter = frame; frame_iter < frame + frames_num; frame_iter++) {
+    /* Re-use least recently used entry (or an already cached copy of that frame). */
+    GzipFrameCache *entry = NULL;
+    for (int i = 0; i < GZIP_FRAME_CACHE_LEN; i++) {
+      if (cache[i].frame == frame_iter) {
+        entry = NULL;
+        break;
+      }
+      if (cache[i].comp == NULL && (entry == NULL || cache[i].last_use < entry->last_use)) {
+        entry = &cache[i];
+      }
+    }
+    if (entry == NULL) {
+      continue;
+    }
+
+    const uint64_t comp_offset = reader->frame_offsets[frame_iter];
+    const size_t comp_len = (size_t)(reader->frame_offsets[frame_iter + 1] - comp_offset);
+    const size_t data_len = (size_t)MIN2((uint64_t)reader->frame_size,
+                                         reader->total_size -
+                                             (uint64_t)frame_iter * reader->frame_size);
+    if (entry->data == NULL) {
+      entry->data = MEM_mallocN(reader->frame_size, __func__);
+    }
+    entry->frame = frame_iter;
+    entry->data_len = data_len;
+    /* Make sure the requested frame is not re-used by the following ones. */
+    entry->last_use = ++reader->use_counter;
+    entry->comp = MEM_mallocN(comp_len, __func__);
+    entry->comp_len = comp_len;
+    if (!gzip_frames_read_raw(reader->filedes, comp_offset, entry->comp, comp_len)) {
+      MEM_freeN(entry->comp);
+      entry->comp = NULL;
+      entry->frame = -1;
+      reader->error = true;
+    }
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (frames_num > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, GZIP_FRAME_CACHE_LEN, reader, gzip_frames_decompress_cb, &settings);
+
+  for (int i = 0; i < GZIP_FRAME_CACHE_LEN; i++) {
+    if (cache[i].frame == frame) {
+      return &cache[i];
+    }
+  }
+  return NULL;
+}
+
+static int fd_read_gzip_frames(FileData *filedata, void *buffer, uint size)
+{
+  GzipFrameReader *reader = filedata->gzip_frames;
+  uint readsize = 0;
+
+  while (readsize < size && (uint64_t)filedata->file_offset < reader->total_size) {
+    const int frame = (int)((uint64_t)filedata->file_offset / reader->frame_size);
+    const size_t frame_offset = (size_t)((uint64_t)filedata->file_offset % reader->frame_size);
+    GzipFrameCache *cache = gzip_frames_ensure(reader, frame);
+    if (cache == NULL) {
+      return EOF;
+    }
+
+    const size_t len = MIN2((size_t)(size - readsize), cache->data_len - frame_offset);
+    memcpy(POINTER_OFFSET(buffer, readsize), cache->data + frame_offset, len);
+    readsize += (uint)len;
+    filedata->file_offset += (int64_t)len;
+  }
+
+  return (int)readsize;
+}
+
+static off64_t fd_seek_gzip_frames(FileData *filedata, off64_t offset, int whence)
+{
+  const off64_t total_size = (off64_t)filedata->gzip_frames->total_size;
+  off64_t new_offset;
+  if (whence == SEEK_CUR) {
+    new_offset = filedata->file_offset + offset;
+  }
+  else if (whence == SEEK_SET) {
+    new_offset = offset;
+  }
+  else if (whence == SEEK_END) {
+    new_offset = total_size + offset;
+  }
+  else {
+    return -1;
+  }
+
+  if (new_offset < 0 || new_offset > total_size) {
+    return -1;
+  }
+  filedata->file_offset = new_offset;
+  return filedata->file_offset;
+}
+
 /* Memory reading. */
 
 static int fd_read_from_memory(FileData *filedata, void *buffer, uint size)
@@ -1188,6 +1511,68 @@ static int fd_read_from_memory(FileData *filedata, void *buffer, uint size)
   return (readsize);
 }
 
+#ifdef USE_MMAP_READ
+/* Memory mapped file reading. */
+
+static int fd_read_from_mmap(FileData *filedata, void *buffer, uint size)
+{
+  /* don't read more bytes then there are available in the mapping */
+  const size_t available = filedata->mmap_size - (size_t)filedata->file_offset;
+  const int readsize = (int)MIN2((size_t)size, available);
+
+  memcpy(buffer, filedata->mmap_data + filedata->file_offset, readsize);
+  filedata->file_offset += readsize;
+
+  return (readsize);
+}
+
+static off64_t fd_seek_from_mmap(FileData *filedata, off64_t offset, int whence)
+{
+  off64_t new_offset;
+  if (whence == SEEK_CUR) {
+    new_offset = filedata->file_offset + offset;
+  }
+  else if (whence == SEEK_SET) {
+    new_offset = offset;
+  }
+  else if (whence == SEEK_END) {
+    new_offset = (off64_t)filedata->mmap_size + offset;
+  }
+  else {
+    return -1;
+  }
+
+  if (new_offset < 0 || new_offset > (off64_t)filedata->mmap_size) {
+    return -1;
+  }
+  filedata->file_offset = new_offset;
+  return filedata->file_offset;
+}
+
+/**
+ * Map the whole file into memory.
+ *
+ * \note Since the mapping is only valid as long as the file is not truncated by another process,
+ * this is only used for reading, the mapping is released as soon as the file-data is freed.
+ */
+static bool fd_mmap_file(FileData *fd, int file)
+{
+  const size_t size = BLI_file_descriptor_size(file);
+  if (size == (size_t)-1 || size == 0) {
+    return false;
+  }
+  void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  fd->mmap_data = data;
+  fd->mmap_size = size;
+  fd->read = fd_read_from_mmap;
+  fd->seek = fd_seek_from_mmap;
+  return true;
+}
+#endif /* USE_MMAP_READ */
+
 /* MemFile reading. */
 
 static int fd_read_from_memfile(FileData *filedata, void *buffer, uint size)
@@ -1301,6 +1686,7 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   FileDataSeekFn *seek_fn = NULL; /* Optional. */
 
   gzFile gzfile = (gzFile)Z_NULL;
+  GzipFrameReader *gzip_frames = NULL;
 
   char header[7];
 
@@ -1324,6 +1710,17 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
     seek_fn = fd_seek_data_from_file;
   }
 
+  /* Gzip file with frame index. */
+  if ((read_fn == NULL) &&
+      /* Check header magic. */
+      (header[0] == 0x1f && header[1] == 0x8b)) {
+    gzip_frames = gzip_frames_reader_create(file);
+    if (gzip_frames != NULL) {
+      read_fn = fd_read_gzip_frames;
+      seek_fn = fd_seek_gzip_frames;
+    }
+  }
+
   /* Gzip file. */
   errno = 0;
   if ((read_fn == NULL) &&
@@ -1355,10 +1752,18 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   fd->filedes = file;
   fd->gzfiledes = gzfile;
+  fd->gzip_frames = gzip_frames;
 
   fd->read = read_fn;
   fd->seek = seek_fn;
 
+#ifdef USE_MMAP_READ
+  if (read_fn == fd_read_data_from_file) {
+    /* Falls back to regular reading when mapping fails. */
+    fd_mmap_file(fd, file);
+  }
+#endif
+
   return fd;
 }
 
@@ -1419,20 +1824,26 @@ static int fd_read_gzip_from_memory(FileData *filedata, void *buffer, uint size)
   filedata->strm.next_out = (Bytef *)buffer;
   filedata->strm.avail_out = size;
 
-  // Inflate another chunk.
-  err = inflate(&filedata->strm, Z_SYNC_FLUSH);
+  while (filedata->strm.avail_out != 0) {
+    // Inflate another chunk.
+    err = inflate(&filedata->strm, Z_SYNC_FLUSH);
 
-  if (err == Z_STREAM_END) {
-    return 0;
-  }
-  else if (err != Z_OK) {
-    printf("fd_read_gzip_from_memory: zlib error\n");
-    return 0;
+    if (err == Z_STREAM_END) {
+      /* Compressed files are made of multiple gzip members, continue with the next one. */
+      if (filedata->strm.avail_in == 0 || inflateReset(&filedata->strm) != Z_OK) {
+        break;
+      }
+    }
+    else if (err != Z_OK) {
+      printf("fd_read_gzip_from_memory: zlib error\n");
+      return 0;
+    }
   }
 
-  filedata->file_offset += size;
+  const uint readsize = size - filedata->strm.avail_out;
+  filedata->file_offset += readsize;
 
-  return (size);
+  return (int)readsize;
 }
 
 static int fd_read_gzip_from_memory_init(FileData *fd)
@@ -1511,6 +1922,10 @@ void blo_filedata_free(FileData *fd)
       gzclose(fd->gzfiledes);
     }
 
+    if (fd->gzip_frames != NULL) {
+      gzip_frames_reader_free(fd->gzip_frames);
+    }
+
     if (fd->strm.next_in) {
       if (inflateEnd(&fd->strm) != Z_OK) {
         printf("close gzip stream error\n");
@@ -1522,6 +1937,13 @@ void blo_filedata_free(FileData *fd)
       fd->buffer = NULL;
     }
 
+#ifdef USE_MMAP_READ
+    if (fd->mmap_data) {
+      munmap((void *)fd->mmap_data, fd->mmap_size);
+      fd->mmap_data = NULL;
+    }
+#endif
+
     /* Free all BHeadN data blocks */
 #ifndef NDEBUG
     BLI_freelistN(&fd->bhead_list);
@@ -1569,6 +1991,9 @@ void blo_filedata_free(FileData *fd)
     if (fd->bheadmap) {
       MEM_freeN(fd->bheadmap);
     }
+    if (fd->undo_reuse_idmap) {
+      BLI_ghash_free(fd->undo_reuse_idmap, NULL, NULL);
+    }
 
 #ifdef USE_GHASH_BHEAD
     if (fd->bhead_idname_hash) {
@@ -2179,6 +2604,103 @@ void blo_add_library_pointer_map(ListBase *old_mainlist, FileData *fd)
   fd->old_mainlist = old_mainlist;
 }
 
+static bool undo_reuse_id_type_is_supported(const ID *id)
+{
+  /* UI data is handled separately by undo, and libraries are always kept. */
+  if (ELEM(GS(id->name), ID_WM, ID_SCR, ID_WS, ID_LI)) {
+    return false;
+  }
+  /* Rigid body runtime data is shared with the physics world of the scene. */
+  if (GS(id->name) == ID_OB) {
+    const Object *ob = (const Object *)id;
+    return ob->rigidbody_object == NULL && ob->rigidbody_constraint == NULL;
+  }
+  return true;
+}
+
+typedef struct UndoReuseCheckData {
+  GHash *undo_reuse_idmap;
+  bool is_reusable;
+} UndoReuseCheckData;
+
+static int undo_reuse_check_id_link_cb(LibraryIDLinkCallbackData *cb_data)
+{
+  UndoReuseCheckData *data = cb_data->user_data;
+  ID *id = *cb_data->id_pointer;
+  /* Linked data-blocks are kept by undo, other used ones have to be re-used as well, so that the
+   * pointers of the re-used data-block remain valid. */
+  if (id == NULL || ID_IS_LINKED(id) ||
+      BLI_ghash_lookup(data->undo_reuse_idmap, POINTER_FROM_UINT(id->session_uuid)) == id) {
+    return IDWALK_RET_NOP;
+  }
+  data->is_reusable = false;
+  return IDWALK_RET_STOP_ITER;
+}
+
+/**
+ * undo file support: find the data-blocks of old main which can be moved to the new one as is,
+ * instead of being read again from \a fd memfile.
+ *
+ * Those are the data-blocks which were not tagged for update since \a reference_memfile (the
+ * state old main is synced with) was written, which are written identically in both memfiles,
+ * and which only use other re-used or linked data-blocks.
+ */
+void blo_make_undo_reuse_map(FileData *fd, Main *oldmain, MemFile *reference_memfile)
+{
+  GHash *undo_reuse_idmap = BLI_ghash_int_new(__func__);
+  GHash *id_chunks = BLO_memfile_id_chunks_map_new(fd->memfile);
+  GHash *id_chunks_reference = (reference_memfile == fd->memfile) ?
+                                   id_chunks :
+                                   BLO_memfile_id_chunks_map_new(reference_memfile);
+
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (oldmain, id) {
+    if ((id->tag & LIB_TAG_UNDO_CHANGED) || !undo_reuse_id_type_is_supported(id)) {
+      continue;
+    }
+    void *key = POINTER_FROM_UINT(id->session_uuid);
+    const MemFileChunk *chunk = BLI_ghash_lookup(id_chunks, key);
+    const MemFileChunk *chunk_reference = BLI_ghash_lookup(id_chunks_reference, key);
+    if (chunk == NULL || chunk_reference == NULL) {
+      continue;
+    }
+    if (chunk != chunk_reference && !BLO_memfile_id_chunks_equal(chunk, chunk_reference)) {
+      continue;
+    }
+    BLI_ghash_insert(undo_reuse_idmap, key, id);
+  }
+  FOREACH_MAIN_ID_END;
+
+  if (id_chunks_reference != id_chunks) {
+    BLI_ghash_free(id_chunks_reference, NULL, NULL);
+  }
+  BLI_ghash_free(id_chunks, NULL, NULL);
+
+  /* Remove data-blocks using data-blocks which are read again, until none is left. */
+  LinkNode *ids_removed = NULL;
+  do {
+    BLI_linklist_free(ids_removed, NULL);
+    ids_removed = NULL;
+
+    GHASH_FOREACH_BEGIN (ID *, id_iter, undo_reuse_idmap) {
+      UndoReuseCheckData data = {.undo_reuse_idmap = undo_reuse_idmap, .is_reusable = true};
+      BKE_library_foreach_ID_link(
+          oldmain, id_iter, undo_reuse_check_id_link_cb, &data, IDWALK_READONLY);
+      if (!data.is_reusable) {
+        BLI_linklist_prepend(&ids_removed, id_iter);
+      }
+    }
+    GHASH_FOREACH_END();
+
+    for (LinkNode *ln = ids_removed; ln != NULL; ln = ln->next) {
+      BLI_ghash_remove(
+          undo_reuse_idmap, POINTER_FROM_UINT(((ID *)ln->link)->session_uuid), NULL, NULL);
+    }
+  } while (ids_removed != NULL);
+
+  fd->undo_reuse_idmap = undo_reuse_idmap;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -2226,17 +2748,23 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+        const void *data = (bh + 1);
 #ifdef USE_BHEAD_READ_ON_DEMAND
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
-          bh = blo_bhead_read_full(fd, bh);
-          if (UNLIKELY(bh == NULL)) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
-            return NULL;
+          /* Reconstruct straight from the file when it is mapped into memory. */
+          data = blo_bhead_data_mapped(fd, bh);
+          if (data == NULL) {
+            bh = blo_bhead_read_full(fd, bh);
+            if (UNLIKELY(bh == NULL)) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              return NULL;
+            }
+            data = (bh + 1);
           }
         }
 #endif
         temp = DNA_struct_reconstruct(
-            fd->memsdna, fd->filesdna, fd->compflags, bh->SDNAnr, bh->nr, (bh + 1));
+            fd->memsdna, fd->filesdna, fd->compflags, bh->SDNAnr, bh->nr, data);
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -4806,6 +5334,7 @@ static void direct_link_customdata(FileData *fd, CustomData *data, int count)
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+    layer->sharing = NULL;
 
     if (CustomData_verify_versions(data, i)) {
       layer->data = newdataadr(fd, layer->data);
@@ -8958,11 +9487,149 @@ static const char *dataname(short id_code)
   return "Data from Lib Block";
 }
 
+/* Minimum amount of data of a single ID which needs to be converted (DNA reconstruction or
+ * endian switch) for this conversion to be done in parallel. */
+#define READ_DATA_PARALLEL_MIN_SIZE (256 * 1024)
+
+/* Whether reading of this data block involves some DNA conversion, as opposed to a plain copy. */
+static bool read_struct_needs_conversion(FileData *fd, BHead *bh)
+{
+  if (bh->len == 0 || fd->compflags[bh->SDNAnr] == SDNA_CMP_REMOVED) {
+    return false;
+  }
+  if (bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    return true;
+  }
+  return fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL;
+}
+
+typedef struct ReadDataParallelData {
+  FileData *fd;
+  const char *allocname;
+  /* Data blocks to be converted, all with their data already in memory (or memory mapped). */
+  BHead **bheads;
+  void **r_data;
+} ReadDataParallelData;
+
+static void read_data_parallel_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReadDataParallelData *data = userdata;
+  BHead *bh = data->bheads[i];
+  if (bh != NULL) {
+    /* No file access happens here, the data of the bhead is in memory already (or memory
+     * mapped), so this only reads from the (shared, constant) SDNA data of the FileData. */
+    data->r_data[i] = read_struct(data->fd, bh, data->allocname);
+  }
+}
+
+/**
+ * Read all data blocks of an ID, converting those which need it in parallel.
+ *
+ * Reading from the file remains serial, as does filling the datamap (in file order, so that the
+ * result is identical to the serial case). Only the DNA reconstruction and endian switching,
+ * which are pure CPU work on independent blocks, are threaded.
+ *
+ * \return false if parallel reading was not worth it, in which case nothing was read.
+ */
+static bool read_data_into_oldnewmap_parallel(FileData *fd,
+                                              BHead **bheads,
+                                              const int bheads_len,
+                                              const char *allocname)
+{
+  size_t conversion_size = 0;
+  int conversion_len = 0;
+  for (int i = 0; i < bheads_len; i++) {
+    if (read_struct_needs_conversion(fd, bheads[i])) {
+      conversion_size += (size_t)bheads[i]->len;
+      conversion_len++;
+    }
+  }
+  if (conversion_len < 2 || conversion_size < READ_DATA_PARALLEL_MIN_SIZE) {
+    return false;
+  }
+
+  void **r_data = MEM_calloc_arrayN(bheads_len, sizeof(*r_data), __func__);
+  BHead **bheads_convert = MEM_calloc_arrayN(bheads_len, sizeof(*bheads_convert), __func__);
+
+  /* Serial pass: all file access, and data which is merely copied. */
+  for (int i = 0; i < bheads_len; i++) {
+    BHead *bh = bheads[i];
+    if (!read_struct_needs_conversion(fd, bh)) {
+      r_data[i] = read_struct(fd, bh, allocname);
+      continue;
+    }
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    /* Endian switching is done in-place, so it always needs a copy of the data,
+     * otherwise data of memory mapped files can be reconstructed from directly. */
+    if (BHEADN_FROM_BHEAD(bh)->has_data == false &&
+        ((bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) ||
+         (blo_bhead_data_mapped(fd, bh) == NULL))) {
+      bh = blo_bhead_read_full(fd, bh);
+      if (UNLIKELY(bh == NULL)) {
+        fd->flags &= ~FD_FLAGS_FILE_OK;
+        continue;
+      }
+    }
+#endif
+    bheads_convert[i] = bh;
+  }
+
+  ReadDataParallelData data = {
+      .fd = fd,
+      .allocname = allocname,
+      .bheads = bheads_convert,
+      .r_data = r_data,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, bheads_len, &data, read_data_parallel_cb, &settings);
+
+  for (int i = 0; i < bheads_len; i++) {
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    if (bheads_convert[i] != NULL && bheads_convert[i] != bheads[i]) {
+      MEM_freeN(BHEADN_FROM_BHEAD(bheads_convert[i]));
+    }
+#endif
+    if (r_data[i]) {
+      oldnewmap_insert(fd->datamap, bheads[i]->old, r_data[i], 0);
+    }
+  }
+
+  MEM_freeN(bheads_convert);
+  MEM_freeN(r_data);
+
+  return true;
+}
+
 static BHead *read_data_into_oldnewmap(FileData *fd, BHead *bhead, const char *allocname)
 {
-  bhead = blo_bhead_next(fd, bhead);
+  BHead *bhead_first = blo_bhead_next(fd, bhead);
+  int bheads_len = 0;
+
+  /* Gather all data blocks first, file access has to be serial anyway. */
+  for (bhead = bhead_first; bhead && bhead->code == DATA; bhead = blo_bhead_next(fd, bhead)) {
+    bheads_len++;
+  }
+  BHead *bhead_end = bhead;
 
-  while (bhead && bhead->code == DATA) {
+  if (bheads_len > 1) {
+    BHead **bheads = MEM_malloc_arrayN(bheads_len, sizeof(*bheads), __func__);
+    int i = 0;
+    for (bhead = bhead_first; bhead != bhead_end; bhead = blo_bhead_next(fd, bhead)) {
+      bheads[i++] = bhead;
+    }
+    const bool is_done = read_data_into_oldnewmap_parallel(fd, bheads, bheads_len, allocname);
+    MEM_freeN(bheads);
+    if (is_done) {
+      return bhead_end;
+    }
+  }
+
+  for (bhead = bhead_first; bhead != bhead_end; bhead = blo_bhead_next(fd, bhead)) {
     void *data;
 #if 0
 		/* XXX DUMB DEBUGGING OPTION TO GIVE NAMES for guarded malloc errors */
@@ -8978,13 +9645,65 @@ static BHead *read_data_into_oldnewmap(FileData *fd, BHead *bhead, const char *a
     if (data) {
       oldnewmap_insert(fd->datamap, bhead->old, data, 0);
     }
+  }
 
-    bhead = blo_bhead_next(fd, bhead);
+  return bhead_end;
+}
+
+/* Move an unchanged data-block from old main to the new one, see #blo_make_undo_reuse_map. */
+static BHead *read_libblock_undo_reuse(
+    FileData *fd, Main *main, BHead *bhead, const int tag, ID *id_old, ID **r_id)
+{
+  Main *old_main = fd->old_mainlist->first;
+  const short idcode = GS(id_old->name);
+
+  BLI_remlink(which_libbase(old_main, idcode), id_old);
+  BLI_addtail(which_libbase(main, idcode), id_old);
+  /* Data-blocks read again use the address it had when the memfile was written. */
+  oldnewmap_insert(fd->libmap, bhead->old, id_old, bhead->code);
+
+  /* Users are counted again once all data-blocks are linked. */
+  id_old->us = ID_FAKE_USERS(id_old);
+  id_old->tag = tag | LIB_TAG_NEW | LIB_TAG_UNDO_OLD_ID_REUSED;
+
+  if (r_id) {
+    *r_id = id_old;
   }
 
+  /* Skip the direct data. */
+  do {
+    bhead = blo_bhead_next(fd, bhead);
+  } while (bhead != NULL && bhead->code == DATA);
   return bhead;
 }
 
+static int undo_reuse_users_count_cb(LibraryIDLinkCallbackData *cb_data)
+{
+  ID *id = *cb_data->id_pointer;
+  if (id != NULL && (id->tag & LIB_TAG_UNDO_OLD_ID_REUSED)) {
+    if (cb_data->cb_flag & IDWALK_CB_USER) {
+      id_us_plus_no_lib(id);
+    }
+    else if (cb_data->cb_flag & IDWALK_CB_USER_ONE) {
+      id_us_ensure_real(id);
+    }
+  }
+  return IDWALK_RET_NOP;
+}
+
+/* Data-blocks only use re-used ones from other re-used data-blocks, the other users are counted
+ * again when linking the data-blocks which were read. */
+static void undo_reuse_users_count(Main *bmain)
+{
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    if (id->tag & LIB_TAG_UNDO_OLD_ID_REUSED) {
+      BKE_library_foreach_ID_link(bmain, id, undo_reuse_users_count_cb, NULL, IDWALK_READONLY);
+    }
+  }
+  FOREACH_MAIN_ID_END;
+}
+
 static BHead *read_libblock(FileData *fd,
                             Main *main,
                             BHead *bhead,
@@ -9067,6 +9786,15 @@ static BHead *read_libblock(FileData *fd,
   /* read libblock */
   id = read_struct(fd, bhead, "lib block");
 
+  /* In undo case, data-blocks which did not change can be kept from old main. */
+  if (id && fd->undo_reuse_idmap && main->curlib == NULL && bhead->code != ID_LINK_PLACEHOLDER) {
+    ID *id_old = BLI_ghash_lookup(fd->undo_reuse_idmap, POINTER_FROM_UINT(id->session_uuid));
+    if (id_old != NULL && GS(id_old->name) == GS(id->name)) {
+      MEM_freeN(id);
+      return read_libblock_undo_reuse(fd, main, bhead, tag, id_old, r_id);
+    }
+  }
+
   if (id) {
     const short idcode = GS(id->name);
     /* do after read_struct, for dna reconstruct */
@@ -9810,6 +10538,10 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
     lib_link_all(fd, bfd->main);
 
+    if (fd->undo_reuse_idmap != NULL) {
+      undo_reuse_users_count(bfd->main);
+    }
+
     /* Skip in undo case. */
     if (fd->memfile == NULL) {
       /* Note that we can't recompute user-counts at this point in undo case, we play too much with
@@ -11649,7 +12381,7 @@ static int has_linked_ids_to_read(Main *mainvar)
 }
 
 static void read_library_linked_id(
-    ReportList *reports, FileData *fd, Main *mainvar, ID *id, ID **r_id)
+    ReportList *reports, FileData *fd, Main *mainvar, ID *id, const bool is_deferred, ID **r_id)
 {
   BHead *bhead = NULL;
   const bool is_valid = BKE_idcode_is_linkable(GS(id->name)) || ((id->tag & LIB_TAG_EXTERN) == 0);
@@ -11678,13 +12410,15 @@ static void read_library_linked_id(
     read_libblock(fd, mainvar, bhead, id->tag, false, r_id);
   }
   else {
-    blo_reportf_wrap(reports,
-                     RPT_WARNING,
-                     TIP_("LIB: %s: '%s' missing from '%s', parent '%s'"),
-                     BKE_idcode_to_name(GS(id->name)),
-                     id->name + 2,
-                     mainvar->curlib->filepath,
-                     library_parent_filepath(mainvar->curlib));
+    if (!is_deferred) {
+      blo_reportf_wrap(reports,
+                       RPT_WARNING,
+                       TIP_("LIB: %s: '%s' missing from '%s', parent '%s'"),
+                       BKE_idcode_to_name(GS(id->name)),
+                       id->name + 2,
+                       mainvar->curlib->filepath,
+                       library_parent_filepath(mainvar->curlib));
+    }
 
     /* Generate a placeholder for this ID (simplified version of read_libblock actually...). */
     if (r_id) {
@@ -11693,10 +12427,12 @@ static void read_library_linked_id(
   }
 }
 
-static void read_library_linked_ids(FileData *basefd,
-                                    FileData *fd,
-                                    ListBase *mainlist,
-                                    Main *mainvar)
+/**
+ * \param is_deferred: The library file is intentionally not read (see
+ * #BLO_READ_SKIP_LINKED_DATA), placeholders are created silently in that case.
+ */
+static void read_library_linked_ids(
+    FileData *basefd, FileData *fd, ListBase *mainlist, Main *mainvar, const bool is_deferred)
 {
   GHash *loaded_ids = BLI_ghash_str_new(__func__);
 
@@ -11718,7 +12454,7 @@ static void read_library_linked_ids(FileData *basefd,
          * we go back to a single linked data when loading the file. */
         ID **realid = NULL;
         if (!BLI_ghash_ensure_p(loaded_ids, id->name, (void ***)&realid)) {
-          read_library_linked_id(basefd->reports, fd, mainvar, id, realid);
+          read_library_linked_id(basefd->reports, fd, mainvar, id, is_deferred, realid);
         }
 
         /* realid shall never be NULL - unless some source file/lib is broken
@@ -11844,6 +12580,27 @@ static FileData *read_library_file_data(FileData *basefd,
   return fd;
 }
 
+/**
+ * Used instead of #read_library_file_data when reading linked data is skipped,
+ * see #BLO_READ_SKIP_LINKED_DATA.
+ */
+static void read_library_deferred(FileData *basefd, ListBase *mainlist, Main *mainl, Main *mainptr)
+{
+  blo_reportf_wrap(basefd->reports,
+                   RPT_INFO,
+                   TIP_("Deferred reading of library: '%s', parent '%s'"),
+                   mainptr->curlib->filepath,
+                   library_parent_filepath(mainptr->curlib));
+
+  /* Same versioning as for missing libraries, only placeholders are added to this main. */
+  if (mainptr->versionfile == 0) {
+    mainptr->versionfile = mainptr->curlib->versionfile = mainl->versionfile;
+    mainptr->subversionfile = mainptr->curlib->subversionfile = mainl->subversionfile;
+  }
+
+  read_library_linked_ids(basefd, NULL, mainlist, mainptr, true);
+}
+
 static void read_libraries(FileData *basefd, ListBase *mainlist)
 {
   Main *mainl = mainlist->first;
@@ -11867,6 +12624,13 @@ static void read_libraries(FileData *basefd, ListBase *mainlist)
     for (Main *mainptr = mainl->next; mainptr; mainptr = mainptr->next) {
       /* Does this library have any more linked data-blocks we need to read? */
       if (has_linked_ids_to_read(mainptr)) {
+        if (basefd->skip_flags & BLO_READ_SKIP_LINKED_DATA) {
+          /* Keep placeholders instead of reading the library file,
+           * its data-blocks are read when the library is reloaded. */
+          read_library_deferred(basefd, mainlist, mainl, mainptr);
+          continue;
+        }
+
 #if 0
 				printf("Reading linked data-blocks from %s (%s)\n",
 					mainptr->curlib->id.name,
@@ -11882,7 +12646,7 @@ static void read_libraries(FileData *basefd, ListBase *mainlist)
 
         /* Read linked data-locks for each link placeholder, and replace
          * the placeholder with the real data-lock. */
-        read_library_linked_ids(basefd, fd, mainlist, mainptr);
+        read_library_linked_ids(basefd, fd, mainlist, mainptr, false);
 
         /* Test if linked data-locks need to read further linked data-locks
          * and create link placeholders for them. */
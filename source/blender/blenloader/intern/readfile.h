@@ -76,11 +76,16 @@ typedef struct FileData {
 
   /** Variables needed for reading from memory / stream. */
   const char *buffer;
+  /** Variables needed for reading from a memory mapped file, see: #USE_MMAP_READ. */
+  const char *mmap_data;
+  size_t mmap_size;
   /** Variables needed for reading from memfile (undo). */
   struct MemFile *memfile;
 
   /** Variables needed for reading from file. */
   gzFile gzfiledes;
+  /** Compressed files with a frame index, see: #BLEND_GZIP_FRAME_SIZE. */
+  struct GzipFrameReader *gzip_frames;
   /** Gzip stream for memory decompression. */
   z_stream strm;
 
@@ -120,6 +125,8 @@ typedef struct FileData {
   ListBase *mainlist;
   /** Used for undo. */
   ListBase *old_mainlist;
+  /** Used for undo, maps session uuids to the IDs of old main which can be re-used as is. */
+  struct GHash *undo_reuse_idmap;
 
   struct ReportList *reports;
 } FileData;
@@ -149,6 +156,9 @@ void blo_end_sound_pointer_map(FileData *fd, struct Main *oldmain);
 void blo_make_packed_pointer_map(FileData *fd, struct Main *oldmain);
 void blo_end_packed_pointer_map(FileData *fd, struct Main *oldmain);
 void blo_add_library_pointer_map(ListBase *old_mainlist, FileData *fd);
+void blo_make_undo_reuse_map(FileData *fd,
+                             struct Main *oldmain,
+                             struct MemFile *reference_memfile);
 
 void blo_filedata_free(FileData *fd);
 
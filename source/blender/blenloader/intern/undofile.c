@@ -41,10 +41,13 @@
 #include "DNA_listBase.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BLO_undofile.h"
 #include "BLO_readfile.h"
 
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 
 /* keep last */
@@ -70,48 +73,176 @@ void BLO_memfile_free(MemFile *memfile)
 /* result is that 'first' is being freed */
 void BLO_memfile_merge(MemFile *first, MemFile *second)
 {
-  MemFileChunk *fc, *sc;
+  /* Chunks of the second memfile are not necessarily at the same position as the chunk owning
+   * their memory in the first one, so match them by the shared buffer. */
+  GHash *buffer_to_second_chunk = BLI_ghash_ptr_new(__func__);
+  LISTBASE_FOREACH (MemFileChunk *, sc, &second->chunks) {
+    if (sc->is_identical) {
+      void **entry;
+      if (!BLI_ghash_ensure_p(buffer_to_second_chunk, (void *)sc->buf, &entry)) {
+        *entry = sc;
+      }
+    }
+  }
 
-  fc = first->chunks.first;
-  sc = second->chunks.first;
-  while (fc || sc) {
-    if (fc && sc) {
-      if (sc->is_identical) {
+  LISTBASE_FOREACH (MemFileChunk *, fc, &first->chunks) {
+    if (fc->is_identical == false) {
+      MemFileChunk *sc = BLI_ghash_lookup(buffer_to_second_chunk, fc->buf);
+      if (sc != NULL) {
         sc->is_identical = false;
         fc->is_identical = true;
       }
     }
-    if (fc) {
-      fc = fc->next;
+  }
+
+  BLI_ghash_free(buffer_to_second_chunk, NULL, NULL);
+
+  BLO_memfile_free(first);
+}
+
+static uint memfile_chunk_content_hash(const void *chunk_v)
+{
+  const MemFileChunk *chunk = chunk_v;
+  return chunk->hash;
+}
+
+static bool memfile_chunk_content_cmp(const void *chunk_a_v, const void *chunk_b_v)
+{
+  const MemFileChunk *chunk_a = chunk_a_v;
+  const MemFileChunk *chunk_b = chunk_b_v;
+  return (chunk_a->size != chunk_b->size) || (chunk_a->hash != chunk_b->hash) ||
+         (memcmp(chunk_a->buf, chunk_b->buf, chunk_a->size) != 0);
+}
+
+/**
+ * Map the session uuids of all IDs written in \a memfile to the first chunk of their data.
+ */
+GHash *BLO_memfile_id_chunks_map_new(MemFile *memfile)
+{
+  GHash *id_chunks = BLI_ghash_int_new(__func__);
+  uint current_session_uuid = MAIN_ID_SESSION_UUID_UNSET;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (!ELEM(chunk->id_session_uuid, MAIN_ID_SESSION_UUID_UNSET, current_session_uuid)) {
+      current_session_uuid = chunk->id_session_uuid;
+      void **entry;
+      void *key = POINTER_FROM_UINT(current_session_uuid);
+      if (!BLI_ghash_ensure_p(id_chunks, key, &entry)) {
+        *entry = chunk;
+      }
+    }
+  }
+  return id_chunks;
+}
+
+/**
+ * Compare the data written for the same ID in two memfiles,
+ * starting from the first chunk of that ID in each of them.
+ */
+bool BLO_memfile_id_chunks_equal(const MemFileChunk *chunk_a, const MemFileChunk *chunk_b)
+{
+  const uint id_session_uuid = chunk_a->id_session_uuid;
+  for (; chunk_a != NULL && chunk_a->id_session_uuid == id_session_uuid;
+       chunk_a = chunk_a->next, chunk_b = chunk_b->next) {
+    if (chunk_b == NULL || chunk_b->id_session_uuid != id_session_uuid) {
+      return false;
     }
-    if (sc) {
-      sc = sc->next;
+    /* Steps written one after the other share the buffers of identical chunks. */
+    if (chunk_a->buf != chunk_b->buf &&
+        (chunk_a->size != chunk_b->size ||
+         memcmp(chunk_a->buf, chunk_b->buf, chunk_a->size) != 0)) {
+      return false;
     }
   }
+  return chunk_b == NULL || chunk_b->id_session_uuid != id_session_uuid;
+}
 
-  BLO_memfile_free(first);
+void BLO_memfile_write_init(MemFileWriteData *mem_data,
+                            MemFile *written_memfile,
+                            MemFile *reference_memfile)
+{
+  mem_data->written_memfile = written_memfile;
+  mem_data->reference_memfile = reference_memfile;
+  mem_data->current_id_session_uuid = MAIN_ID_SESSION_UUID_UNSET;
+  mem_data->reference_current_chunk = reference_memfile ? reference_memfile->chunks.first : NULL;
+  mem_data->id_session_uuid_mapping = NULL;
+  mem_data->reference_chunks = NULL;
+
+  if (reference_memfile == NULL) {
+    return;
+  }
+
+  mem_data->id_session_uuid_mapping = BLO_memfile_id_chunks_map_new(reference_memfile);
 }
 
-void memfile_chunk_add(MemFile *memfile, const char *buf, uint size, MemFileChunk **compchunk_step)
+/* Only needed once some data did not match by position, created on demand. */
+static GSet *memfile_reference_chunks_ensure(MemFileWriteData *mem_data)
 {
+  if (mem_data->reference_chunks == NULL) {
+    MemFile *reference_memfile = mem_data->reference_memfile;
+    const uint chunks_num = (uint)BLI_listbase_count(&reference_memfile->chunks);
+    mem_data->reference_chunks = BLI_gset_new_ex(
+        memfile_chunk_content_hash, memfile_chunk_content_cmp, __func__, chunks_num);
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &reference_memfile->chunks) {
+      BLI_gset_add(mem_data->reference_chunks, chunk);
+    }
+  }
+  return mem_data->reference_chunks;
+}
+
+void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
+{
+  if (mem_data->id_session_uuid_mapping != NULL) {
+    BLI_ghash_free(mem_data->id_session_uuid_mapping, NULL, NULL);
+  }
+  if (mem_data->reference_chunks != NULL) {
+    BLI_gset_free(mem_data->reference_chunks, NULL);
+  }
+}
+
+void memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, uint size)
+{
+  MemFile *memfile = mem_data->written_memfile;
+  MemFileChunk **compchunk_step = &mem_data->reference_current_chunk;
+
   MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
   curchunk->size = size;
   curchunk->buf = NULL;
+  curchunk->hash = 0;
   curchunk->is_identical = false;
+  curchunk->id_session_uuid = mem_data->current_id_session_uuid;
   BLI_addtail(&memfile->chunks, curchunk);
 
-  /* we compare compchunk with buf */
+  /* we compare compchunk with buf, the chunk at the same position is the most likely match */
   if (*compchunk_step != NULL) {
     MemFileChunk *compchunk = *compchunk_step;
     if (compchunk->size == curchunk->size) {
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
+        curchunk->hash = compchunk->hash;
         curchunk->is_identical = true;
       }
     }
     *compchunk_step = compchunk->next;
   }
 
+  /* Only hash the data which is not identical to the data at the same position, the hash of
+   * identical chunks is known already. */
+  if (curchunk->buf == NULL) {
+    curchunk->hash = BLI_hash_mm2((const uchar *)buf, size, 0);
+
+    /* Data moved when something before it changed size, look for it anywhere in the previous
+     * step. */
+    if (mem_data->reference_memfile != NULL) {
+      const MemFileChunk key = {.buf = buf, .size = size, .hash = curchunk->hash};
+      const MemFileChunk *compchunk = BLI_gset_lookup(memfile_reference_chunks_ensure(mem_data),
+                                                      &key);
+      if (compchunk != NULL) {
+        curchunk->buf = compchunk->buf;
+        curchunk->is_identical = true;
+      }
+    }
+  }
+
   /* not equal... */
   if (curchunk->buf == NULL) {
     char *buf_new = MEM_mallocN(size, "Chunk buffer");
@@ -126,8 +257,11 @@ struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                   struct Scene **r_scene)
 {
   struct Main *bmain_undo = NULL;
-  BlendFileData *bfd = BLO_read_from_memfile(
-      oldmain, BKE_main_blendfile_path(oldmain), memfile, BLO_READ_SKIP_NONE, NULL);
+  BlendFileData *bfd = BLO_read_from_memfile(oldmain,
+                                             BKE_main_blendfile_path(oldmain),
+                                             memfile,
+                                             &(const struct BlendFileReadParams){0},
+                                             NULL);
 
   if (bfd) {
     bmain_undo = bfd->main;
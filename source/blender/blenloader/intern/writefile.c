@@ -144,7 +144,11 @@
 #include "MEM_guardedalloc.h"  // MEM_freeN
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
+#include "BLI_math_base.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "BKE_action.h"
 #include "BKE_blender_version.h"
@@ -157,6 +161,7 @@
 #include "BKE_gpencil_modifier.h"
 #include "BKE_idcode.h"
 #include "BKE_layer.h"
+#include "BKE_lib_id.h"
 #include "BKE_lib_override.h"
 #include "BKE_main.h"
 #include "BKE_modifier.h"
@@ -215,7 +220,7 @@ struct WriteWrap {
   /* internal */
   union {
     int file_handle;
-    gzFile gz_handle;
+    struct ZlibFrameWriter *zlib_frames;
   } _user_data;
 };
 
@@ -246,17 +251,191 @@ static size_t ww_write_none(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
-/* zlib */
-#define FILE_HANDLE(ww) (ww)->_user_data.gz_handle
+/* zlib
+ *
+ * Data is compressed as a sequence of independent gzip members, followed by their index,
+ * see #BLEND_GZIP_FRAME_SIZE for details. A batch of frames is collected before being
+ * compressed in parallel, then written in order. */
+
+typedef struct ZlibFrame {
+  /* Uncompressed data, #BLEND_GZIP_FRAME_SIZE bytes. */
+  char *data;
+  size_t data_len;
+  /* Compressed data (a complete gzip member). */
+  char *comp;
+  size_t comp_len;
+  size_t comp_alloc;
+} ZlibFrame;
+
+typedef struct ZlibFrameWriter {
+  int file_handle;
+  /* Batch of frames compressed at once, one per thread. */
+  ZlibFrame *frames;
+  int frames_len;
+  int frames_used;
+  /* Offsets of all written frames in the file, for the index. */
+  uint64_t *frame_offsets;
+  int frame_offsets_len;
+  int frame_offsets_alloc;
+  /* Compressed and uncompressed sizes written so far. */
+  uint64_t file_size;
+  uint64_t total_size;
+  bool error;
+} ZlibFrameWriter;
+
+#define FILE_HANDLE(ww) (ww)->_user_data.zlib_frames
+
+static bool zlib_frame_compress(ZlibFrame *frame)
+{
+  z_stream strm = {NULL};
+  /* Same compression level as previously used for 'gzopen', favor speed. */
+  if (deflateInit2(&strm, 1, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+
+  const size_t comp_size = deflateBound(&strm, (uLong)frame->data_len);
+  if (frame->comp_alloc < comp_size) {
+    MEM_SAFE_FREE(frame->comp);
+    frame->comp = MEM_mallocN(comp_size, __func__);
+    frame->comp_alloc = comp_size;
+  }
+
+  strm.next_in = (Bytef *)frame->data;
+  strm.avail_in = (uInt)frame->data_len;
+  strm.next_out = (Bytef *)frame->comp;
+  strm.avail_out = (uInt)comp_size;
+
+  const int ret = deflate(&strm, Z_FINISH);
+  frame->comp_len = comp_size - strm.avail_out;
+
+  deflateEnd(&strm);
+
+  return (ret == Z_STREAM_END);
+}
+
+static void zlib_frames_compress_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZlibFrameWriter *writer = userdata;
+  if (!zlib_frame_compress(&writer->frames[i])) {
+    writer->error = true;
+  }
+}
+
+static bool zlib_frames_write_raw(ZlibFrameWriter *writer, const char *buf, size_t buf_len)
+{
+  while (buf_len != 0) {
+    const int written = write(writer->file_handle, buf, (uint)MIN2(buf_len, INT_MAX));
+    if (written <= 0) {
+      writer->error = true;
+      return false;
+    }
+    buf += written;
+    buf_len -= (size_t)written;
+    writer->file_size += (uint64_t)written;
+  }
+  return true;
+}
+
+/* Compress all frames of the current batch, then write them out in order. */
+static void zlib_frames_flush(ZlibFrameWriter *writer)
+{
+  if (writer->frames_used == 0) {
+    return;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (writer->frames_used > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, writer->frames_used, writer, zlib_frames_compress_cb, &settings);
+
+  for (int i = 0; i < writer->frames_used && !writer->error; i++) {
+    ZlibFrame *frame = &writer->frames[i];
+
+    if (writer->frame_offsets_len == writer->frame_offsets_alloc) {
+      writer->frame_offsets_alloc = max_ii(64, writer->frame_offsets_alloc * 2);
+      writer->frame_offsets = MEM_reallocN(writer->frame_offsets,
+                                           sizeof(*writer->frame_offsets) *
+                                               (size_t)writer->frame_offsets_alloc);
+    }
+    writer->frame_offsets[writer->frame_offsets_len++] = writer->file_size;
+
+    zlib_frames_write_raw(writer, frame->comp, frame->comp_len);
+    frame->data_len = 0;
+  }
+
+  writer->frames_used = 0;
+}
+
+BLI_INLINE char *zlib_frames_encode_uint(char *buf, uint64_t value, const int size)
+{
+  for (int i = 0; i < size; i++) {
+    buf[i] = (char)((value >> (8 * i)) & 0xff);
+  }
+  return buf + size;
+}
+
+/* Write the index as an empty gzip member with all the data in its extra field. */
+static void zlib_frames_write_index(ZlibFrameWriter *writer)
+{
+  const int frames_len = writer->frame_offsets_len;
+  if (frames_len > BLEND_GZIP_INDEX_FRAMES_MAX) {
+    /* Still a valid file, it just can not be read with random access. */
+    return;
+  }
+
+  const size_t data_len = (size_t)frames_len * 8 + BLEND_GZIP_INDEX_FOOTER_SIZE;
+  const size_t index_len = BLEND_GZIP_INDEX_HEADER_SIZE + data_len +
+                           BLEND_GZIP_INDEX_TRAILER_SIZE;
+  char *index = MEM_mallocN(index_len, __func__);
+  char *p = index;
+
+  /* ID1, ID2, CM (deflate), FLG (FEXTRA), MTIME, XFL, OS (unknown). */
+  const char header[10] = {0x1f, (char)0x8b, 8, 4, 0, 0, 0, 0, 0, (char)0xff};
+  memcpy(p, header, sizeof(header));
+  p += sizeof(header);
+  p = zlib_frames_encode_uint(p, data_len + 4, 2);
+  *p++ = BLEND_GZIP_INDEX_SI1;
+  *p++ = BLEND_GZIP_INDEX_SI2;
+  p = zlib_frames_encode_uint(p, data_len, 2);
+
+  for (int i = 0; i < frames_len; i++) {
+    p = zlib_frames_encode_uint(p, writer->frame_offsets[i], 8);
+  }
+  p = zlib_frames_encode_uint(p, writer->total_size, 8);
+  p = zlib_frames_encode_uint(p, BLEND_GZIP_FRAME_SIZE, 4);
+  p = zlib_frames_encode_uint(p, (uint64_t)frames_len, 4);
+  memcpy(p, BLEND_GZIP_INDEX_MAGIC, 4);
+  p += 4;
+
+  /* Empty final deflate block, CRC32 and ISIZE of empty data. */
+  const char trailer[BLEND_GZIP_INDEX_TRAILER_SIZE] = {3, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  memcpy(p, trailer, sizeof(trailer));
+  p += sizeof(trailer);
+
+  BLI_assert((size_t)(p - index) == index_len);
+  zlib_frames_write_raw(writer, index, index_len);
+
+  MEM_freeN(index);
+}
 
 static bool ww_open_zlib(WriteWrap *ww, const char *filepath)
 {
-  gzFile file;
+  int file;
 
-  file = BLI_gzopen(filepath, "wb1");
+  file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
 
-  if (file != Z_NULL) {
-    FILE_HANDLE(ww) = file;
+  if (file != -1) {
+    ZlibFrameWriter *writer = MEM_callocN(sizeof(*writer), __func__);
+    writer->file_handle = file;
+    writer->frames_len = BLI_system_thread_count();
+    writer->frames = MEM_calloc_arrayN(writer->frames_len, sizeof(*writer->frames), __func__);
+    for (int i = 0; i < writer->frames_len; i++) {
+      writer->frames[i].data = MEM_mallocN(BLEND_GZIP_FRAME_SIZE, __func__);
+    }
+    FILE_HANDLE(ww) = writer;
     return true;
   }
   else {
@@ -265,11 +444,52 @@ static bool ww_open_zlib(WriteWrap *ww, const char *filepath)
 }
 static bool ww_close_zlib(WriteWrap *ww)
 {
-  return (gzclose(FILE_HANDLE(ww)) == Z_OK);
+  ZlibFrameWriter *writer = FILE_HANDLE(ww);
+
+  if (writer->frames[writer->frames_used].data_len != 0) {
+    writer->frames_used++;
+  }
+  zlib_frames_flush(writer);
+  if (!writer->error) {
+    zlib_frames_write_index(writer);
+  }
+
+  const bool success = (close(writer->file_handle) != -1) && !writer->error;
+
+  for (int i = 0; i < writer->frames_len; i++) {
+    MEM_freeN(writer->frames[i].data);
+    MEM_SAFE_FREE(writer->frames[i].comp);
+  }
+  MEM_freeN(writer->frames);
+  MEM_SAFE_FREE(writer->frame_offsets);
+  MEM_freeN(writer);
+
+  return success;
 }
 static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 {
-  return gzwrite(FILE_HANDLE(ww), buf, buf_len);
+  ZlibFrameWriter *writer = FILE_HANDLE(ww);
+  size_t buf_left = buf_len;
+
+  while (buf_left != 0 && !writer->error) {
+    ZlibFrame *frame = &writer->frames[writer->frames_used];
+    const size_t len = MIN2(buf_left, BLEND_GZIP_FRAME_SIZE - frame->data_len);
+
+    memcpy(frame->data + frame->data_len, buf, len);
+    frame->data_len += len;
+    writer->total_size += len;
+    buf += len;
+    buf_left -= len;
+
+    if (frame->data_len == BLEND_GZIP_FRAME_SIZE) {
+      writer->frames_used++;
+      if (writer->frames_used == writer->frames_len) {
+        zlib_frames_flush(writer);
+      }
+    }
+  }
+
+  return writer->error ? 0 : buf_len;
 }
 #undef FILE_HANDLE
 
@@ -320,12 +540,7 @@ typedef struct {
   bool error;
 
   /** #MemFile writing (used for undo). */
-  struct {
-    MemFile *current;
-    MemFile *compare;
-    /** Use to de-duplicate chunks when writing. */
-    MemFileChunk *compare_chunk;
-  } mem;
+  MemFileWriteData mem;
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
   bool use_memfile;
 
@@ -364,7 +579,7 @@ static void writedata_do_write(WriteData *wd, const void *mem, int memlen)
 
   /* memory based save */
   if (wd->use_memfile) {
-    memfile_chunk_add(wd->mem.current, mem, memlen, &wd->mem.compare_chunk);
+    memfile_chunk_add(&wd->mem, mem, memlen);
   }
   else {
     if (wd->ww->write(wd->ww, mem, memlen) != memlen) {
@@ -465,9 +680,7 @@ static WriteData *mywrite_begin(WriteWrap *ww, MemFile *compare, MemFile *curren
   WriteData *wd = writedata_new(ww);
 
   if (current != NULL) {
-    wd->mem.current = current;
-    wd->mem.compare = compare;
-    wd->mem.compare_chunk = compare ? compare->chunks.first : NULL;
+    BLO_memfile_write_init(&wd->mem, current, compare);
     wd->use_memfile = true;
   }
 
@@ -487,12 +700,51 @@ static bool mywrite_end(WriteData *wd)
     wd->buf_used_len = 0;
   }
 
+  if (wd->use_memfile) {
+    BLO_memfile_write_finalize(&wd->mem);
+  }
+
   const bool err = wd->error;
   writedata_free(wd);
 
   return err;
 }
 
+/**
+ * Start writing of data related to a single ID.
+ *
+ * Only does something when writing an undo step, the ID is then compared to its own chunks of
+ * the previous step, so changes in an ID don't cause unrelated data to be duplicated.
+ */
+static void mywrite_id_begin(WriteData *wd, ID *id)
+{
+  if (wd->use_memfile) {
+    wd->mem.current_id_session_uuid = id->session_uuid;
+
+    /* If current next chunk does not belong to the ID about to be written, try to find the
+     * chunks of that ID from its session uuid. */
+    if (wd->mem.id_session_uuid_mapping != NULL &&
+        (wd->mem.reference_current_chunk == NULL ||
+         wd->mem.reference_current_chunk->id_session_uuid != id->session_uuid)) {
+      MemFileChunk *ref = BLI_ghash_lookup(wd->mem.id_session_uuid_mapping,
+                                           POINTER_FROM_UINT(id->session_uuid));
+      if (ref != NULL) {
+        wd->mem.reference_current_chunk = ref;
+      }
+      /* Otherwise it is a new ID, keep comparing with the current chunk anyway. */
+    }
+  }
+}
+
+static void mywrite_id_end(WriteData *wd, ID *UNUSED(id))
+{
+  if (wd->use_memfile) {
+    /* Every ID has its own chunks, so they can be matched in the next undo step. */
+    mywrite_flush(wd);
+    wd->mem.current_id_session_uuid = MAIN_ID_SESSION_UUID_UNSET;
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -3899,6 +4151,8 @@ static bool write_file_handle(Main *mainvar,
           BKE_lib_override_library_operations_store_start(bmain, override_storage, id);
         }
 
+        mywrite_id_begin(wd, id);
+
         switch ((ID_Type)GS(id->name)) {
           case ID_WM:
             write_windowmanager(wd, (wmWindowManager *)id);
@@ -4015,6 +4269,8 @@ static bool write_file_handle(Main *mainvar,
             break;
         }
 
+        mywrite_id_end(wd, id);
+
         if (do_override) {
           BKE_lib_override_library_operations_store_end(override_storage, id);
         }
@@ -4177,9 +4433,12 @@ bool BLO_write_file(Main *mainvar,
   }
 
   /* actual file writing */
-  const bool err = write_file_handle(mainvar, &ww, NULL, NULL, write_flags, thumb);
+  bool err = write_file_handle(mainvar, &ww, NULL, NULL, write_flags, thumb);
 
-  ww.close(&ww);
+  /* Compressed data may only be written out when closing. */
+  if (ww.close(&ww) == false) {
+    err = true;
+  }
 
   if (UNLIKELY(path_list_backup)) {
     BKE_bpath_list_restore(mainvar, path_list_flag, path_list_backup);
@@ -215,6 +215,7 @@ extern "C" {
 #include "intern/bmesh_log.h"
 #include "intern/bmesh_marking.h"
 #include "intern/bmesh_mesh.h"
+#include "intern/bmesh_mesh_arrays.h"
 #include "intern/bmesh_mesh_conv.h"
 #include "intern/bmesh_mesh_duplicate.h"
 #include "intern/bmesh_mesh_validate.h"
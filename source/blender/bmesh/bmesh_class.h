@@ -250,6 +250,11 @@ typedef struct BMesh {
   struct MLoopNorSpaceArray *lnor_spacearr;
   char spacearr_dirty;
 
+  /* Packed copy of the mesh, see BM_mesh_arrays_ensure().
+   * Topology changes flag it as dirty (BM_VERT | BM_EDGE | BM_FACE | BM_LOOP). */
+  struct BMeshArrays *arrays;
+  char arrays_dirty;
+
   /* should be copy of scene select mode */
   /* stored in BMEditMesh too, this is a bit confusing,
    * make sure they're in sync!
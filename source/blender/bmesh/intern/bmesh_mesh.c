@@ -255,6 +255,8 @@ void BM_mesh_data_free(BMesh *bm)
     MEM_freeN(bm->ftable);
   }
 
+  BM_mesh_arrays_free(bm);
+
   /* destroy flag pool */
   BM_mesh_elem_toolflags_clear(bm);
 
@@ -372,10 +374,48 @@ typedef struct BMVertsCalcNormalsData {
   float (*vnos)[3];
 } BMVertsCalcNormalsData;
 
-static void mesh_verts_calc_normals_accum_cb(void *userdata, MempoolIterData *mp_f)
+/**
+ * A lock-less thread-safe #madd_v3_v3fl.
+ *
+ * It uses the first float of the vector as a sort of cheap spin-lock,
+ * assuming FLT_MAX is a safe 'illegal' value that cannot be set here otherwise.
+ * It also assumes that collisions between threads are highly unlikely,
+ * else performances would be quite bad here.
+ */
+BLI_INLINE void bm_vert_normal_accum_atomic(float v_no[3], const float f_no[3], const float fac)
 {
 #define FLT_EQ_NONAN(_fa, _fb) (*((const uint32_t *)&_fa) == *((const uint32_t *)&_fb))
 
+  float virtual_lock = v_no[0];
+  while (true) {
+    /* This loops until following conditions are met:
+     *   - v_no[0] has same value as virtual_lock (i.e. it did not change since last try).
+     *   - v_no[0] was not FLT_MAX, i.e. it was not locked by another thread.
+     */
+    const float vl = atomic_cas_float(&v_no[0], virtual_lock, FLT_MAX);
+    if (FLT_EQ_NONAN(vl, virtual_lock) && vl != FLT_MAX) {
+      break;
+    }
+    virtual_lock = vl;
+  }
+  BLI_assert(v_no[0] == FLT_MAX);
+  /* Now we own that normal value, and can change it.
+   * But first scalar of the vector must not be changed yet, it's our lock! */
+  virtual_lock += f_no[0] * fac;
+  v_no[1] += f_no[1] * fac;
+  v_no[2] += f_no[2] * fac;
+  /* Second atomic operation to 'release'
+   * our lock on that vector and set its first scalar value. */
+  /* Note that we do not need to loop here, since we 'locked' v_no[0],
+   * nobody should have changed it in the mean time. */
+  virtual_lock = atomic_cas_float(&v_no[0], FLT_MAX, virtual_lock);
+  BLI_assert(virtual_lock == FLT_MAX);
+
+#undef FLT_EQ_NONAN
+}
+
+static void mesh_verts_calc_normals_accum_cb(void *userdata, MempoolIterData *mp_f)
+{
   BMVertsCalcNormalsData *data = userdata;
   BMFace *f = (BMFace *)mp_f;
 
@@ -410,40 +450,9 @@ static void mesh_verts_calc_normals_accum_cb(void *userdata, MempoolIterData *mp
 
     /* accumulate weighted face normal into the vertex's normal */
     float *v_no = data->vnos ? data->vnos[BM_elem_index_get(l_iter->v)] : l_iter->v->no;
-
-    /* This block is a lockless threadsafe madd_v3_v3fl.
-     * It uses the first float of the vector as a sort of cheap spin-lock,
-     * assuming FLT_MAX is a safe 'illegal' value that cannot be set here otherwise.
-     * It also assumes that collisions between threads are highly unlikely,
-     * else performances would be quite bad here. */
-    float virtual_lock = v_no[0];
-    while (true) {
-      /* This loops until following conditions are met:
-       *   - v_no[0] has same value as virtual_lock (i.e. it did not change since last try).
-       *   - v_no[0] was not FLT_MAX, i.e. it was not locked by another thread.
-       */
-      const float vl = atomic_cas_float(&v_no[0], virtual_lock, FLT_MAX);
-      if (FLT_EQ_NONAN(vl, virtual_lock) && vl != FLT_MAX) {
-        break;
-      }
-      virtual_lock = vl;
-    }
-    BLI_assert(v_no[0] == FLT_MAX);
-    /* Now we own that normal value, and can change it.
-     * But first scalar of the vector must not be changed yet, it's our lock! */
-    virtual_lock += f_no[0] * fac;
-    v_no[1] += f_no[1] * fac;
-    v_no[2] += f_no[2] * fac;
-    /* Second atomic operation to 'release'
-     * our lock on that vector and set its first scalar value. */
-    /* Note that we do not need to loop here, since we 'locked' v_no[0],
-     * nobody should have changed it in the mean time. */
-    virtual_lock = atomic_cas_float(&v_no[0], FLT_MAX, virtual_lock);
-    BLI_assert(virtual_lock == FLT_MAX);
+    bm_vert_normal_accum_atomic(v_no, f_no, fac);
 
   } while ((l_iter = l_iter->next) != l_first);
-
-#undef FLT_EQ_NONAN
 }
 
 static void mesh_verts_calc_normals_normalize_cb(void *userdata, MempoolIterData *mp_v)
@@ -484,48 +493,164 @@ static void bm_mesh_verts_calc_normals(BMesh *bm,
                    bm->totvert >= BM_OMP_LIMIT);
 }
 
-static void mesh_faces_calc_normals_cb(void *UNUSED(userdata), MempoolIterData *mp_f)
+/**
+ * Helpers for #BM_mesh_normals_update, using #BMeshArrays.
+ */
+
+typedef struct BMArraysCalcNormalsData {
+  BMesh *bm;
+  const BMeshArrays *arrays;
+
+  float (*edgevec)[3];
+  float (*fnos)[3];
+  float (*vnos)[3];
+} BMArraysCalcNormalsData;
+
+static void mesh_arrays_faces_calc_normals_cb(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  BMFace *f = (BMFace *)mp_f;
+  BMArraysCalcNormalsData *data = userdata;
+  const BMeshArrays *arrays = data->arrays;
+  const float(*vcos)[3] = arrays->vert_co;
+  const int *l_verts = &arrays->loop_verts[arrays->face_loopstart[i]];
+  const int len = arrays->face_loopstart[i + 1] - arrays->face_loopstart[i];
+  float *f_no = data->fnos[i];
+
+  /* Same as #BM_face_calc_normal. */
+  switch (len) {
+    case 4:
+      normal_quad_v3(f_no, vcos[l_verts[0]], vcos[l_verts[1]], vcos[l_verts[2]], vcos[l_verts[3]]);
+      break;
+    case 3:
+      normal_tri_v3(f_no, vcos[l_verts[0]], vcos[l_verts[1]], vcos[l_verts[2]]);
+      break;
+    default: {
+      /* Newell's Method */
+      const float *v_prev = vcos[l_verts[len - 1]];
+      zero_v3(f_no);
+      for (int j = 0; j < len; j++) {
+        const float *v_curr = vcos[l_verts[j]];
+        add_newell_cross_v3_v3v3(f_no, v_prev, v_curr);
+        v_prev = v_curr;
+      }
+      normalize_v3(f_no);
+      break;
+    }
+  }
+
+  copy_v3_v3(data->bm->ftable[i]->no, f_no);
+}
+
+static void mesh_arrays_edges_calc_vectors_cb(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMArraysCalcNormalsData *data = userdata;
+  const BMeshArrays *arrays = data->arrays;
+  const int *e_verts = arrays->edge_verts[i];
 
-  BM_face_normal_update(f);
+  sub_v3_v3v3(data->edgevec[i], arrays->vert_co[e_verts[1]], arrays->vert_co[e_verts[0]]);
+  normalize_v3(data->edgevec[i]);
+}
+
+static void mesh_arrays_verts_calc_normals_accum_cb(void *__restrict userdata,
+                                                    const int i,
+                                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMArraysCalcNormalsData *data = userdata;
+  const BMeshArrays *arrays = data->arrays;
+  const int loopstart = arrays->face_loopstart[i];
+  const int loopend = arrays->face_loopstart[i + 1];
+  const float *f_no = data->fnos[i];
+
+  int l_prev = loopend - 1;
+  for (int l = loopstart; l < loopend; l_prev = l++) {
+    const int e_prev = arrays->loop_edges[l_prev];
+    const int e_curr = arrays->loop_edges[l];
+
+    /* calculate the dot product of the two edges that
+     * meet at the loop's vertex */
+    float dotprod = dot_v3v3(data->edgevec[e_prev], data->edgevec[e_curr]);
+
+    /* edge vectors are calculated from e->v1 to e->v2, so
+     * adjust the dot product if one but not both loops
+     * actually runs from from e->v2 to e->v1 */
+    if ((arrays->edge_verts[e_prev][0] == arrays->loop_verts[l_prev]) ^
+        (arrays->edge_verts[e_curr][0] == arrays->loop_verts[l])) {
+      dotprod = -dotprod;
+    }
+
+    const float fac = saacos(-dotprod);
+
+    if (fac != fac) { /* NAN detection. */
+      /* Degenerated case, nothing to do here, just ignore that vertex. */
+      continue;
+    }
+
+    /* accumulate weighted face normal into the vertex's normal */
+    bm_vert_normal_accum_atomic(data->vnos[arrays->loop_verts[l]], f_no, fac);
+  }
+}
+
+static void mesh_arrays_verts_calc_normals_normalize_cb(
+    void *__restrict userdata, const int i, const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMArraysCalcNormalsData *data = userdata;
+  float *v_no = data->vnos[i];
+
+  if (UNLIKELY(normalize_v3(v_no) == 0.0f)) {
+    normalize_v3_v3(v_no, data->arrays->vert_co[i]);
+  }
+
+  copy_v3_v3(data->bm->vtable[i]->no, v_no);
 }
 
 /**
  * \brief BMesh Compute Normals
  *
  * Updates the normals of a mesh.
+ *
+ * Works on the packed arrays of the mesh (see #BM_mesh_arrays_ensure),
+ * which are kept for further updates as long as the topology doesn't change.
  */
 void BM_mesh_normals_update(BMesh *bm)
 {
-  float(*edgevec)[3] = MEM_mallocN(sizeof(*edgevec) * bm->totedge, __func__);
+  const BMeshArrays *arrays = BM_mesh_arrays_ensure(bm, BM_ARRAYS_VERT_CO);
+
+  BMArraysCalcNormalsData data = {
+      .bm = bm,
+      .arrays = arrays,
+      .edgevec = MEM_malloc_arrayN((size_t)bm->totedge, sizeof(*data.edgevec), __func__),
+      .fnos = MEM_malloc_arrayN((size_t)bm->totface, sizeof(*data.fnos), __func__),
+      .vnos = MEM_calloc_arrayN((size_t)bm->totvert, sizeof(*data.vnos), __func__),
+  };
 
-  /* Parallel mempool iteration does not allow to generate indices inline anymore... */
-  BM_mesh_elem_index_ensure(bm, (BM_EDGE | BM_FACE));
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
 
   /* calculate all face normals */
-  BM_iter_parallel(
-      bm, BM_FACES_OF_MESH, mesh_faces_calc_normals_cb, NULL, bm->totface >= BM_OMP_LIMIT);
-
-  /* Zero out vertex normals */
-  BMIter viter;
-  BMVert *v;
-  int i;
-
-  BM_ITER_MESH_INDEX (v, &viter, bm, BM_VERTS_OF_MESH, i) {
-    BM_elem_index_set(v, i); /* set_inline */
-    zero_v3(v->no);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
+  settings.use_threading = (bm->totface >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(0, bm->totface, &data, mesh_arrays_faces_calc_normals_cb, &settings);
 
   /* Compute normalized direction vectors for each edge.
    * Directions will be used for calculating the weights of the face normals on the vertex normals.
    */
-  bm_mesh_edges_calc_vectors(bm, edgevec, NULL);
+  settings.use_threading = (bm->totedge >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(0, bm->totedge, &data, mesh_arrays_edges_calc_vectors_cb, &settings);
 
   /* Add weighted face normals to vertices, and normalize vert normals. */
-  bm_mesh_verts_calc_normals(bm, (const float(*)[3])edgevec, NULL, NULL, NULL);
-  MEM_freeN(edgevec);
+  settings.use_threading = (bm->totface >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(
+      0, bm->totface, &data, mesh_arrays_verts_calc_normals_accum_cb, &settings);
+
+  settings.use_threading = (bm->totvert >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(
+      0, bm->totvert, &data, mesh_arrays_verts_calc_normals_normalize_cb, &settings);
+
+  MEM_freeN(data.edgevec);
+  MEM_freeN(data.fnos);
+  MEM_freeN(data.vnos);
 }
 
 /**
@@ -2196,6 +2321,7 @@ void BM_mesh_remap(BMesh *bm, const uint *vert_idx, const uint *edge_idx, const
     }
     bm->elem_index_dirty |= BM_VERT;
     bm->elem_table_dirty |= BM_VERT;
+    bm->arrays_dirty |= BM_VERT;
 
     MEM_freeN(verts_copy);
     if (pyptrs) {
@@ -2247,6 +2373,7 @@ void BM_mesh_remap(BMesh *bm, const uint *vert_idx, const uint *edge_idx, const
     }
     bm->elem_index_dirty |= BM_EDGE;
     bm->elem_table_dirty |= BM_EDGE;
+    bm->arrays_dirty |= BM_EDGE;
 
     MEM_freeN(edges_copy);
     if (pyptrs) {
@@ -2295,6 +2422,7 @@ void BM_mesh_remap(BMesh *bm, const uint *vert_idx, const uint *edge_idx, const
 
     bm->elem_index_dirty |= BM_FACE | BM_LOOP;
     bm->elem_table_dirty |= BM_FACE;
+    bm->arrays_dirty |= BM_FACE | BM_LOOP;
 
     MEM_freeN(faces_copy);
     if (pyptrs) {
@@ -0,0 +1,226 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bmesh
+ *
+ * Packed arrays of BMesh topology and element data, see #BMeshArrays.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math_vector.h"
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+
+#include "bmesh.h"
+
+typedef struct BMeshArraysFillData {
+  BMesh *bm;
+  BMeshArrays *arrays;
+  int data_mask;
+  bool use_topology;
+} BMeshArraysFillData;
+
+static void bm_mesh_arrays_verts_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMeshArraysFillData *data = userdata;
+  BMeshArrays *arrays = data->arrays;
+  const BMVert *v = data->bm->vtable[i];
+
+  if (data->data_mask & BM_ARRAYS_VERT_CO) {
+    copy_v3_v3(arrays->vert_co[i], v->co);
+  }
+  if (data->data_mask & BM_ARRAYS_VERT_NO) {
+    copy_v3_v3(arrays->vert_no[i], v->no);
+  }
+  if (data->data_mask & BM_ARRAYS_HFLAG) {
+    arrays->vert_hflag[i] = v->head.hflag;
+  }
+}
+
+static void bm_mesh_arrays_edges_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMeshArraysFillData *data = userdata;
+  BMeshArrays *arrays = data->arrays;
+  const BMEdge *e = data->bm->etable[i];
+
+  if (data->use_topology) {
+    arrays->edge_verts[i][0] = BM_elem_index_get(e->v1);
+    arrays->edge_verts[i][1] = BM_elem_index_get(e->v2);
+  }
+  if (data->data_mask & BM_ARRAYS_HFLAG) {
+    arrays->edge_hflag[i] = e->head.hflag;
+  }
+}
+
+static void bm_mesh_arrays_faces_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMeshArraysFillData *data = userdata;
+  BMeshArrays *arrays = data->arrays;
+  const BMFace *f = data->bm->ftable[i];
+
+  if (data->use_topology) {
+    int j = arrays->face_loopstart[i];
+    BMLoop *l_iter, *l_first;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      arrays->loop_verts[j] = BM_elem_index_get(l_iter->v);
+      arrays->loop_edges[j] = BM_elem_index_get(l_iter->e);
+      arrays->loop_faces[j] = i;
+      j++;
+    } while ((l_iter = l_iter->next) != l_first);
+  }
+  if (data->data_mask & BM_ARRAYS_FACE_NO) {
+    copy_v3_v3(arrays->face_no[i], f->no);
+  }
+  if (data->data_mask & BM_ARRAYS_HFLAG) {
+    arrays->face_hflag[i] = f->head.hflag;
+  }
+}
+
+static void bm_mesh_arrays_free_topology(BMeshArrays *arrays)
+{
+  MEM_SAFE_FREE(arrays->edge_verts);
+  MEM_SAFE_FREE(arrays->face_loopstart);
+  MEM_SAFE_FREE(arrays->loop_verts);
+  MEM_SAFE_FREE(arrays->loop_edges);
+  MEM_SAFE_FREE(arrays->loop_faces);
+}
+
+static void bm_mesh_arrays_free_data(BMeshArrays *arrays)
+{
+  MEM_SAFE_FREE(arrays->vert_co);
+  MEM_SAFE_FREE(arrays->vert_no);
+  MEM_SAFE_FREE(arrays->face_no);
+  MEM_SAFE_FREE(arrays->vert_hflag);
+  MEM_SAFE_FREE(arrays->edge_hflag);
+  MEM_SAFE_FREE(arrays->face_hflag);
+}
+
+/**
+ * Return the packed arrays of \a bm, rebuilding the topology if it changed
+ * and copying the element data in \a data_mask (#eBMeshArraysData).
+ *
+ * The arrays are owned by the BMesh, element data not in \a data_mask
+ * may be left over from previous calls and out of date.
+ */
+BMeshArrays *BM_mesh_arrays_ensure(BMesh *bm, const int data_mask)
+{
+  BMeshArrays *arrays = bm->arrays;
+  bool use_topology = false;
+
+  if (arrays == NULL) {
+    arrays = bm->arrays = MEM_callocN(sizeof(*arrays), __func__);
+    use_topology = true;
+  }
+  else if (bm->arrays_dirty || (arrays->totvert != bm->totvert) ||
+           (arrays->totedge != bm->totedge) || (arrays->totloop != bm->totloop) ||
+           (arrays->totface != bm->totface)) {
+    bm_mesh_arrays_free_topology(arrays);
+    bm_mesh_arrays_free_data(arrays);
+    use_topology = true;
+  }
+
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+
+  if (use_topology) {
+    BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE);
+
+    arrays->totvert = bm->totvert;
+    arrays->totedge = bm->totedge;
+    arrays->totloop = bm->totloop;
+    arrays->totface = bm->totface;
+
+    arrays->edge_verts = MEM_malloc_arrayN(
+        (size_t)bm->totedge, sizeof(*arrays->edge_verts), __func__);
+    arrays->face_loopstart = MEM_malloc_arrayN(
+        (size_t)bm->totface + 1, sizeof(*arrays->face_loopstart), __func__);
+    arrays->loop_verts = MEM_malloc_arrayN(
+        (size_t)bm->totloop, sizeof(*arrays->loop_verts), __func__);
+    arrays->loop_edges = MEM_malloc_arrayN(
+        (size_t)bm->totloop, sizeof(*arrays->loop_edges), __func__);
+    arrays->loop_faces = MEM_malloc_arrayN(
+        (size_t)bm->totloop, sizeof(*arrays->loop_faces), __func__);
+
+    int totloop = 0;
+    for (int i = 0; i < bm->totface; i++) {
+      arrays->face_loopstart[i] = totloop;
+      totloop += bm->ftable[i]->len;
+    }
+    arrays->face_loopstart[bm->totface] = totloop;
+    BLI_assert(totloop == bm->totloop);
+  }
+
+  if ((data_mask & BM_ARRAYS_VERT_CO) && arrays->vert_co == NULL) {
+    arrays->vert_co = MEM_malloc_arrayN((size_t)bm->totvert, sizeof(*arrays->vert_co), __func__);
+  }
+  if ((data_mask & BM_ARRAYS_VERT_NO) && arrays->vert_no == NULL) {
+    arrays->vert_no = MEM_malloc_arrayN((size_t)bm->totvert, sizeof(*arrays->vert_no), __func__);
+  }
+  if ((data_mask & BM_ARRAYS_FACE_NO) && arrays->face_no == NULL) {
+    arrays->face_no = MEM_malloc_arrayN((size_t)bm->totface, sizeof(*arrays->face_no), __func__);
+  }
+  if ((data_mask & BM_ARRAYS_HFLAG) && arrays->vert_hflag == NULL) {
+    arrays->vert_hflag = MEM_malloc_arrayN((size_t)bm->totvert, sizeof(char), __func__);
+    arrays->edge_hflag = MEM_malloc_arrayN((size_t)bm->totedge, sizeof(char), __func__);
+    arrays->face_hflag = MEM_malloc_arrayN((size_t)bm->totface, sizeof(char), __func__);
+  }
+
+  BMeshArraysFillData data = {
+      .bm = bm,
+      .arrays = arrays,
+      .data_mask = data_mask,
+      .use_topology = use_topology,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  if (data_mask & (BM_ARRAYS_VERT_CO | BM_ARRAYS_VERT_NO | BM_ARRAYS_HFLAG)) {
+    settings.use_threading = (bm->totvert >= BM_OMP_LIMIT);
+    BLI_task_parallel_range(0, bm->totvert, &data, bm_mesh_arrays_verts_cb, &settings);
+  }
+  if (use_topology || (data_mask & BM_ARRAYS_HFLAG)) {
+    settings.use_threading = (bm->totedge >= BM_OMP_LIMIT);
+    BLI_task_parallel_range(0, bm->totedge, &data, bm_mesh_arrays_edges_cb, &settings);
+  }
+  if (use_topology || (data_mask & (BM_ARRAYS_FACE_NO | BM_ARRAYS_HFLAG))) {
+    settings.use_threading = (bm->totface >= BM_OMP_LIMIT);
+    BLI_task_parallel_range(0, bm->totface, &data, bm_mesh_arrays_faces_cb, &settings);
+  }
+
+  bm->arrays_dirty = 0;
+
+  return arrays;
+}
+
+void BM_mesh_arrays_free(BMesh *bm)
+{
+  if (bm->arrays == NULL) {
+    return;
+  }
+  bm_mesh_arrays_free_topology(bm->arrays);
+  bm_mesh_arrays_free_data(bm->arrays);
+  MEM_freeN(bm->arrays);
+  bm->arrays = NULL;
+}
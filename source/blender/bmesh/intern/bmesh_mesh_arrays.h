@@ -0,0 +1,62 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BMESH_MESH_ARRAYS_H__
+#define __BMESH_MESH_ARRAYS_H__
+
+/** \file
+ * \ingroup bmesh
+ */
+
+/**
+ * Packed copy of a BMesh, with elements referenced by their index.
+ *
+ * Meant for tools which mostly read the mesh, so they can loop over plain arrays
+ * instead of following pointers between elements.
+ * The topology is kept until #BMesh.arrays_dirty is set by changes to the BMesh,
+ * element data is copied again every time it's requested.
+ */
+typedef struct BMeshArrays {
+  int totvert, totedge, totloop, totface;
+
+  /* Topology. */
+  int (*edge_verts)[2];
+  /** Start of the loops of each face, with an extra item set to `totloop`. */
+  int *face_loopstart;
+  int *loop_verts;
+  int *loop_edges;
+  int *loop_faces;
+
+  /* Element data, see #eBMeshArraysData. */
+  float (*vert_co)[3];
+  float (*vert_no)[3];
+  float (*face_no)[3];
+  char *vert_hflag;
+  char *edge_hflag;
+  char *face_hflag;
+} BMeshArrays;
+
+typedef enum eBMeshArraysData {
+  BM_ARRAYS_VERT_CO = (1 << 0),
+  BM_ARRAYS_VERT_NO = (1 << 1),
+  BM_ARRAYS_FACE_NO = (1 << 2),
+  BM_ARRAYS_HFLAG = (1 << 3),
+} eBMeshArraysData;
+
+BMeshArrays *BM_mesh_arrays_ensure(BMesh *bm, const int data_mask);
+void BM_mesh_arrays_free(BMesh *bm);
+
+#endif /* __BMESH_MESH_ARRAYS_H__ */
@@ -81,6 +81,8 @@
 #include "BLI_listbase.h"
 #include "BLI_alloca.h"
 #include "BLI_math_vector.h"
+#include "BLI_mempool.h"
+#include "BLI_task.h"
 
 #include "BKE_mesh.h"
 #include "BKE_mesh_runtime.h"
@@ -174,6 +176,492 @@ static BMFace *bm_face_create_from_mpoly(
   return BM_face_create(bm, verts, edges, mp->totloop, NULL, BM_CREATE_SKIP_CD);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh -> BMesh Elements
+ *
+ * A new BMesh is filled in parallel: all elements of a type are allocated at once in the order
+ * of the mesh (see #BLI_mempool_range_alloc), so iterating over the BMesh still matches
+ * the mesh indices. Only the disk and radial cycles, which are shared between elements,
+ * are linked from a single thread.
+ * \{ */
+
+typedef struct BMeshFromMeshData {
+  BMesh *bm;
+  const Mesh *me;
+  const struct BMeshFromMeshParams *params;
+
+  const float (*keyco)[3];
+  const float (**shape_key_table)[3];
+  int tot_shape_keys;
+
+  int cd_vert_bweight_offset;
+  int cd_edge_bweight_offset;
+  int cd_edge_crease_offset;
+  int cd_shape_key_offset;
+  int cd_shape_keyindex_offset;
+
+  BMVert **vtable;
+  BMEdge **etable;
+  BMFace **ftable;
+
+  /** Only used for a new BMesh. */
+  size_t toolflag_size;
+  /** Index of the face and its first loop for every polygon, -1 for skipped polygons. */
+  int *poly_face_index;
+  int *poly_loop_offset;
+
+  BLI_mempool_range vert_range, edge_range, loop_range, face_range;
+  BLI_mempool_range vtoolflag_range, etoolflag_range, ftoolflag_range;
+  BLI_mempool_range vdata_range, edata_range, ldata_range, pdata_range;
+} BMeshFromMeshData;
+
+/** Pools for tool-flags and custom-data may not exist, leave the range empty in that case. */
+static void bm_mesh_range_alloc(BLI_mempool *pool, const int totelem, BLI_mempool_range *r_range)
+{
+  if (pool != NULL) {
+    BLI_mempool_range_alloc(pool, (uint)totelem, r_range);
+  }
+  else {
+    memset(r_range, 0, sizeof(*r_range));
+  }
+}
+
+static void bm_mesh_range_end(BLI_mempool_range *range)
+{
+  if (range->pool != NULL) {
+    BLI_mempool_range_end(range);
+  }
+}
+
+BLI_INLINE void *bm_mesh_range_elem(const BLI_mempool_range *range, const int index)
+{
+  return range->pool ? BLI_mempool_range_elem(range, (uint)index) : NULL;
+}
+
+BLI_INLINE BMFlagLayer *bm_mesh_range_toolflags(const BMeshFromMeshData *data,
+                                                const BLI_mempool_range *range,
+                                                const int index)
+{
+  BMFlagLayer *oflags = bm_mesh_range_elem(range, index);
+  if (oflags != NULL) {
+    memset(oflags, 0, data->toolflag_size);
+  }
+  return oflags;
+}
+
+static void bm_vert_attrs_from_mvert(const BMeshFromMeshData *data, BMVert *v, const int i)
+{
+  const MVert *mvert = &data->me->mvert[i];
+
+  /* Transfer flag. */
+  v->head.hflag = BM_vert_flag_from_mflag(mvert->flag & ~SELECT);
+
+  normal_short_to_float_v3(v->no, mvert->no);
+
+  /* Copy Custom Data */
+  CustomData_to_bmesh_block(&data->me->vdata, &data->bm->vdata, i, &v->head.data, true);
+
+  if (data->cd_vert_bweight_offset != -1) {
+    BM_ELEM_CD_SET_FLOAT(v, data->cd_vert_bweight_offset, (float)mvert->bweight / 255.0f);
+  }
+
+  /* Set shape key original index. */
+  if (data->cd_shape_keyindex_offset != -1) {
+    BM_ELEM_CD_SET_INT(v, data->cd_shape_keyindex_offset, i);
+  }
+
+  /* Set shape-key data. */
+  if (data->tot_shape_keys) {
+    float(*co_dst)[3] = BM_ELEM_CD_GET_VOID_P(v, data->cd_shape_key_offset);
+    for (int j = 0; j < data->tot_shape_keys; j++, co_dst++) {
+      copy_v3_v3(*co_dst, data->shape_key_table[j][i]);
+    }
+  }
+}
+
+static void bm_edge_attrs_from_medge(const BMeshFromMeshData *data, BMEdge *e, const int i)
+{
+  const MEdge *medge = &data->me->medge[i];
+
+  /* Transfer flags. */
+  e->head.hflag = BM_edge_flag_from_mflag(medge->flag & ~SELECT);
+
+  /* Copy Custom Data */
+  CustomData_to_bmesh_block(&data->me->edata, &data->bm->edata, i, &e->head.data, true);
+
+  if (data->cd_edge_bweight_offset != -1) {
+    BM_ELEM_CD_SET_FLOAT(e, data->cd_edge_bweight_offset, (float)medge->bweight / 255.0f);
+  }
+  if (data->cd_edge_crease_offset != -1) {
+    BM_ELEM_CD_SET_FLOAT(e, data->cd_edge_crease_offset, (float)medge->crease / 255.0f);
+  }
+}
+
+static void bm_vert_from_mvert_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMeshFromMeshData *data = userdata;
+  BMVert *v = BLI_mempool_range_elem(&data->vert_range, (uint)i);
+
+  v->head.data = bm_mesh_range_elem(&data->vdata_range, i);
+  BM_elem_index_set(v, i); /* set_ok */
+  v->head.htype = BM_VERT;
+  v->head.api_flag = 0;
+
+  if (data->bm->use_toolflags) {
+    ((BMVert_OFlag *)v)->oflags = bm_mesh_range_toolflags(data, &data->vtoolflag_range, i);
+  }
+
+  copy_v3_v3(v->co, data->keyco ? data->keyco[i] : data->me->mvert[i].co);
+  v->e = NULL;
+
+  bm_vert_attrs_from_mvert(data, v, i);
+
+  data->vtable[i] = v;
+}
+
+static void bm_edge_from_medge_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMeshFromMeshData *data = userdata;
+  const MEdge *medge = &data->me->medge[i];
+  BMEdge *e = BLI_mempool_range_elem(&data->edge_range, (uint)i);
+
+  e->head.data = bm_mesh_range_elem(&data->edata_range, i);
+  BM_elem_index_set(e, i); /* set_ok */
+  e->head.htype = BM_EDGE;
+  e->head.api_flag = 0;
+
+  if (data->bm->use_toolflags) {
+    ((BMEdge_OFlag *)e)->oflags = bm_mesh_range_toolflags(data, &data->etoolflag_range, i);
+  }
+
+  e->v1 = data->vtable[medge->v1];
+  e->v2 = data->vtable[medge->v2];
+  e->l = NULL;
+  memset(&e->v1_disk_link, 0, sizeof(BMDiskLink) * 2);
+
+  bm_edge_attrs_from_medge(data, e, i);
+
+  data->etable[i] = e;
+}
+
+static void bm_face_from_mpoly_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMeshFromMeshData *data = userdata;
+  const int face_index = data->poly_face_index[i];
+
+  if (face_index == -1) {
+    data->ftable[i] = NULL;
+    return;
+  }
+
+  BMesh *bm = data->bm;
+  const Mesh *me = data->me;
+  const MPoly *mp = &me->mpoly[i];
+  const MLoop *ml = &me->mloop[mp->loopstart];
+  const int loop_offset = data->poly_loop_offset[i];
+  BMFace *f = BLI_mempool_range_elem(&data->face_range, (uint)face_index);
+
+  f->head.data = bm_mesh_range_elem(&data->pdata_range, face_index);
+  BM_elem_index_set(f, face_index); /* set_ok */
+  f->head.htype = BM_FACE;
+  f->head.api_flag = 0;
+
+  if (bm->use_toolflags) {
+    ((BMFace_OFlag *)f)->oflags = bm_mesh_range_toolflags(
+        data, &data->ftoolflag_range, face_index);
+  }
+
+  BMLoop *l_first = NULL, *l_prev = NULL;
+  for (int j = 0; j < mp->totloop; j++, ml++) {
+    const int loop_index = loop_offset + j;
+    BMLoop *l = BLI_mempool_range_elem(&data->loop_range, (uint)loop_index);
+
+    l->head.data = bm_mesh_range_elem(&data->ldata_range, loop_index);
+    BM_elem_index_set(l, loop_index); /* set_ok */
+    l->head.htype = BM_LOOP;
+    l->head.hflag = 0;
+    l->head.api_flag = 0;
+
+    l->v = data->vtable[ml->v];
+    l->e = data->etable[ml->e];
+    l->f = f;
+    l->radial_next = NULL;
+    l->radial_prev = NULL;
+
+    if (l_prev != NULL) {
+      l_prev->next = l;
+    }
+    else {
+      l_first = l;
+    }
+    l->prev = l_prev;
+    l_prev = l;
+
+    /* Copy Custom Data */
+    CustomData_to_bmesh_block(&me->ldata, &bm->ldata, mp->loopstart + j, &l->head.data, true);
+  }
+  l_first->prev = l_prev;
+  l_prev->next = l_first;
+
+  f->l_first = l_first;
+  f->len = mp->totloop;
+
+  /* Transfer flag. */
+  f->head.hflag = BM_face_flag_from_mflag(mp->flag & ~ME_FACE_SEL);
+  f->mat_nr = mp->mat_nr;
+
+  /* Copy Custom Data */
+  CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
+
+  if (data->params->calc_face_normal) {
+    BM_face_normal_update(f);
+  }
+  else {
+    zero_v3(f->no);
+  }
+
+  data->ftable[i] = f;
+}
+
+/**
+ * Create the elements of a new BMesh from \a data->me, filling the element tables.
+ */
+static void bm_mesh_elems_from_me_new(BMeshFromMeshData *data)
+{
+  BMesh *bm = data->bm;
+  const Mesh *me = data->me;
+  TaskParallelSettings settings;
+  int i;
+
+  BLI_assert(bm->totvert == 0 && bm->totedge == 0 && bm->totloop == 0 && bm->totface == 0);
+
+  data->toolflag_size = sizeof(BMFlagLayer) * (size_t)bm->totflags;
+
+  BLI_parallel_range_settings_defaults(&settings);
+
+  /* Vertices. */
+  bm_mesh_range_alloc(bm->vpool, me->totvert, &data->vert_range);
+  bm_mesh_range_alloc(bm->vtoolflagpool, me->totvert, &data->vtoolflag_range);
+  bm_mesh_range_alloc(bm->vdata.pool, me->totvert, &data->vdata_range);
+
+  settings.use_threading = (me->totvert >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(0, me->totvert, data, bm_vert_from_mvert_cb, &settings);
+  bm->totvert = me->totvert;
+
+  /* Edges. */
+  bm_mesh_range_alloc(bm->epool, me->totedge, &data->edge_range);
+  bm_mesh_range_alloc(bm->etoolflagpool, me->totedge, &data->etoolflag_range);
+  bm_mesh_range_alloc(bm->edata.pool, me->totedge, &data->edata_range);
+
+  settings.use_threading = (me->totedge >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(0, me->totedge, data, bm_edge_from_medge_cb, &settings);
+  bm->totedge = me->totedge;
+
+  /* The disk cycle of a vertex is shared between its edges,
+   * append in order so it matches #BM_edge_create. */
+  for (i = 0; i < me->totedge; i++) {
+    BMEdge *e = data->etable[i];
+    bmesh_disk_edge_append(e, e->v1);
+    bmesh_disk_edge_append(e, e->v2);
+  }
+
+  /* Faces, polygons without loops are skipped as #BM_face_create does not support them. */
+  data->poly_face_index = MEM_malloc_arrayN((size_t)me->totpoly, sizeof(int), __func__);
+  data->poly_loop_offset = MEM_malloc_arrayN((size_t)me->totpoly, sizeof(int), __func__);
+
+  int totface = 0, totloop = 0;
+  for (i = 0; i < me->totpoly; i++) {
+    const int len = me->mpoly[i].totloop;
+    if (UNLIKELY(len <= 0)) {
+      printf(
+          "%s: Warning! Bad face in mesh"
+          " \"%s\" at index %d!, skipping\n",
+          __func__,
+          me->id.name + 2,
+          i);
+      data->poly_face_index[i] = -1;
+      data->poly_loop_offset[i] = -1;
+      continue;
+    }
+    data->poly_face_index[i] = totface++;
+    data->poly_loop_offset[i] = totloop;
+    totloop += len;
+  }
+
+  bm_mesh_range_alloc(bm->fpool, totface, &data->face_range);
+  bm_mesh_range_alloc(bm->ftoolflagpool, totface, &data->ftoolflag_range);
+  bm_mesh_range_alloc(bm->pdata.pool, totface, &data->pdata_range);
+  bm_mesh_range_alloc(bm->lpool, totloop, &data->loop_range);
+  bm_mesh_range_alloc(bm->ldata.pool, totloop, &data->ldata_range);
+
+  settings.use_threading = (me->totpoly >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(0, me->totpoly, data, bm_face_from_mpoly_cb, &settings);
+  bm->totface = totface;
+  bm->totloop = totloop;
+
+  /* The radial cycle of an edge is shared between its faces,
+   * append in order so it matches #BM_face_create. */
+  for (i = 0; i < me->totpoly; i++) {
+    BMFace *f = data->ftable[i];
+    if (f != NULL) {
+      BMLoop *l_iter, *l_first;
+      l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+      do {
+        bmesh_radial_loop_append(l_iter->e, l_iter);
+      } while ((l_iter = l_iter->next) != l_first);
+    }
+  }
+
+  /* Selection is flushed to connected elements, so it can only be set once they're linked.
+   * This is necessary for selection counts to work properly. */
+  for (i = 0; i < me->totvert; i++) {
+    if (me->mvert[i].flag & SELECT) {
+      BM_vert_select_set(bm, data->vtable[i], true);
+    }
+  }
+  for (i = 0; i < me->totedge; i++) {
+    if (me->medge[i].flag & SELECT) {
+      BM_edge_select_set(bm, data->etable[i], true);
+    }
+  }
+  for (i = 0; i < me->totpoly; i++) {
+    if ((me->mpoly[i].flag & ME_FACE_SEL) && data->ftable[i] != NULL) {
+      BM_face_select_set(bm, data->ftable[i], true);
+    }
+  }
+
+  if (me->act_face >= 0 && me->act_face < me->totpoly) {
+    bm->act_face = data->ftable[me->act_face];
+  }
+
+  BLI_mempool_range *ranges[] = {
+      &data->vert_range,
+      &data->edge_range,
+      &data->loop_range,
+      &data->face_range,
+      &data->vtoolflag_range,
+      &data->etoolflag_range,
+      &data->ftoolflag_range,
+      &data->vdata_range,
+      &data->edata_range,
+      &data->ldata_range,
+      &data->pdata_range,
+  };
+  for (i = 0; i < ARRAY_SIZE(ranges); i++) {
+    bm_mesh_range_end(ranges[i]);
+  }
+
+  MEM_freeN(data->poly_face_index);
+  MEM_freeN(data->poly_loop_offset);
+
+  /* Added in order, clear dirty flag. */
+  bm->elem_index_dirty &= ~(BM_VERT | BM_EDGE | BM_LOOP | BM_FACE);
+  bm->elem_table_dirty |= (BM_VERT | BM_EDGE | BM_FACE);
+  bm->arrays_dirty |= (BM_VERT | BM_EDGE | BM_LOOP | BM_FACE);
+}
+
+/**
+ * Add the elements of \a data->me to an existing BMesh, filling the element tables.
+ */
+static void bm_mesh_elems_from_me_merge(BMeshFromMeshData *data)
+{
+  BMesh *bm = data->bm;
+  const Mesh *me = data->me;
+  int i, totloops;
+
+  for (i = 0; i < me->totvert; i++) {
+    const MVert *mvert = &me->mvert[i];
+    BMVert *v = data->vtable[i] = BM_vert_create(
+        bm, data->keyco ? data->keyco[i] : mvert->co, NULL, BM_CREATE_SKIP_CD);
+    BM_elem_index_set(v, i); /* set_ok */
+
+    bm_vert_attrs_from_mvert(data, v, i);
+
+    /* This is necessary for selection counts to work properly. */
+    if (mvert->flag & SELECT) {
+      BM_vert_select_set(bm, v, true);
+    }
+  }
+
+  for (i = 0; i < me->totedge; i++) {
+    const MEdge *medge = &me->medge[i];
+    BMEdge *e = data->etable[i] = BM_edge_create(
+        bm, data->vtable[medge->v1], data->vtable[medge->v2], NULL, BM_CREATE_SKIP_CD);
+    BM_elem_index_set(e, i); /* set_ok */
+
+    bm_edge_attrs_from_medge(data, e, i);
+
+    /* This is necessary for selection counts to work properly. */
+    if (medge->flag & SELECT) {
+      BM_edge_select_set(bm, e, true);
+    }
+  }
+
+  MLoop *mloop = me->mloop;
+  MPoly *mp = me->mpoly;
+  for (i = 0, totloops = 0; i < me->totpoly; i++, mp++) {
+    BMLoop *l_iter;
+    BMLoop *l_first;
+
+    BMFace *f = bm_face_create_from_mpoly(
+        mp, mloop + mp->loopstart, bm, data->vtable, data->etable);
+    if (data->ftable != NULL) {
+      data->ftable[i] = f;
+    }
+
+    if (UNLIKELY(f == NULL)) {
+      printf(
+          "%s: Warning! Bad face in mesh"
+          " \"%s\" at index %d!, skipping\n",
+          __func__,
+          me->id.name + 2,
+          i);
+      continue;
+    }
+
+    /* Don't use 'i' since we may have skipped the face. */
+    BM_elem_index_set(f, bm->totface - 1); /* set_ok */
+
+    /* Transfer flag. */
+    f->head.hflag = BM_face_flag_from_mflag(mp->flag & ~ME_FACE_SEL);
+
+    /* This is necessary for selection counts to work properly. */
+    if (mp->flag & ME_FACE_SEL) {
+      BM_face_select_set(bm, f, true);
+    }
+
+    f->mat_nr = mp->mat_nr;
+    if (i == me->act_face) {
+      bm->act_face = f;
+    }
+
+    int j = mp->loopstart;
+    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    do {
+      /* Don't use 'j' since we may have skipped some faces, hence some loops. */
+      BM_elem_index_set(l_iter, totloops++); /* set_ok */
+
+      /* Save index of corresponding #MLoop. */
+      CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+    } while ((l_iter = l_iter->next) != l_first);
+
+    /* Copy Custom Data */
+    CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
+
+    if (data->params->calc_face_normal) {
+      BM_face_normal_update(f);
+    }
+  }
+}
+
+/** \} */
+
 /**
  * \brief Mesh -> BMesh
  * \param bm: The mesh to write into, while this is typically a newly created BMesh,
@@ -188,16 +676,12 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
 {
   const bool is_new = !(bm->totvert || (bm->vdata.totlayer || bm->edata.totlayer ||
                                         bm->pdata.totlayer || bm->ldata.totlayer));
-  MVert *mvert;
-  MEdge *medge;
-  MLoop *mloop;
-  MPoly *mp;
   KeyBlock *actkey, *block;
-  BMVert *v, **vtable = NULL;
-  BMEdge *e, **etable = NULL;
-  BMFace *f, **ftable = NULL;
+  BMVert **vtable = NULL;
+  BMEdge **etable = NULL;
+  BMFace **ftable = NULL;
   float(*keyco)[3] = NULL;
-  int totloops, i;
+  int i;
   CustomData_MeshMasks mask = CD_MASK_BMESH;
   CustomData_MeshMasks_update(&mask, &params->cd_mask_extra);
 
@@ -303,137 +787,38 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
                                            CustomData_get_offset(&bm->vdata, CD_SHAPE_KEYINDEX) :
                                            -1;
 
-  vtable = MEM_mallocN(sizeof(BMVert **) * me->totvert, __func__);
-
-  for (i = 0, mvert = me->mvert; i < me->totvert; i++, mvert++) {
-    v = vtable[i] = BM_vert_create(bm, keyco ? keyco[i] : mvert->co, NULL, BM_CREATE_SKIP_CD);
-    BM_elem_index_set(v, i); /* set_ok */
-
-    /* Transfer flag. */
-    v->head.hflag = BM_vert_flag_from_mflag(mvert->flag & ~SELECT);
-
-    /* This is necessary for selection counts to work properly. */
-    if (mvert->flag & SELECT) {
-      BM_vert_select_set(bm, v, true);
-    }
-
-    normal_short_to_float_v3(v->no, mvert->no);
-
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
-
-    if (cd_vert_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(v, cd_vert_bweight_offset, (float)mvert->bweight / 255.0f);
-    }
-
-    /* Set shape key original index. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
-    }
-
-    /* Set shape-key data. */
-    if (tot_shape_keys) {
-      float(*co_dst)[3] = BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
-      for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
-        copy_v3_v3(*co_dst, shape_key_table[j][i]);
-      }
-    }
-  }
-  if (is_new) {
-    bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
-  }
+  BMeshFromMeshData data = {
+      .bm = bm,
+      .me = me,
+      .params = params,
+      .keyco = (const float(*)[3])keyco,
+      .shape_key_table = shape_key_table,
+      .tot_shape_keys = tot_shape_keys,
+      .cd_vert_bweight_offset = cd_vert_bweight_offset,
+      .cd_edge_bweight_offset = cd_edge_bweight_offset,
+      .cd_edge_crease_offset = cd_edge_crease_offset,
+      .cd_shape_key_offset = cd_shape_key_offset,
+      .cd_shape_keyindex_offset = cd_shape_keyindex_offset,
+  };
 
+  vtable = MEM_mallocN(sizeof(BMVert **) * me->totvert, __func__);
   etable = MEM_mallocN(sizeof(BMEdge **) * me->totedge, __func__);
+  data.vtable = vtable;
+  data.etable = etable;
 
-  medge = me->medge;
-  for (i = 0; i < me->totedge; i++, medge++) {
-    e = etable[i] = BM_edge_create(
-        bm, vtable[medge->v1], vtable[medge->v2], NULL, BM_CREATE_SKIP_CD);
-    BM_elem_index_set(e, i); /* set_ok */
-
-    /* Transfer flags. */
-    e->head.hflag = BM_edge_flag_from_mflag(medge->flag & ~SELECT);
-
-    /* This is necessary for selection counts to work properly. */
-    if (medge->flag & SELECT) {
-      BM_edge_select_set(bm, e, true);
-    }
-
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
-
-    if (cd_edge_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_bweight_offset, (float)medge->bweight / 255.0f);
-    }
-    if (cd_edge_crease_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_crease_offset, (float)medge->crease / 255.0f);
-    }
-  }
   if (is_new) {
-    bm->elem_index_dirty &= ~BM_EDGE; /* Added in order, clear dirty flag. */
-  }
-
-  /* Only needed for selection. */
-  if (me->mselect && me->totselect != 0) {
+    /* Needed for linking loops, as well as for selection. */
     ftable = MEM_mallocN(sizeof(BMFace **) * me->totpoly, __func__);
+    data.ftable = ftable;
+    bm_mesh_elems_from_me_new(&data);
   }
-
-  mloop = me->mloop;
-  mp = me->mpoly;
-  for (i = 0, totloops = 0; i < me->totpoly; i++, mp++) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
-
-    f = bm_face_create_from_mpoly(mp, mloop + mp->loopstart, bm, vtable, etable);
-    if (ftable != NULL) {
-      ftable[i] = f;
-    }
-
-    if (UNLIKELY(f == NULL)) {
-      printf(
-          "%s: Warning! Bad face in mesh"
-          " \"%s\" at index %d!, skipping\n",
-          __func__,
-          me->id.name + 2,
-          i);
-      continue;
-    }
-
-    /* Don't use 'i' since we may have skipped the face. */
-    BM_elem_index_set(f, bm->totface - 1); /* set_ok */
-
-    /* Transfer flag. */
-    f->head.hflag = BM_face_flag_from_mflag(mp->flag & ~ME_FACE_SEL);
-
-    /* This is necessary for selection counts to work properly. */
-    if (mp->flag & ME_FACE_SEL) {
-      BM_face_select_set(bm, f, true);
-    }
-
-    f->mat_nr = mp->mat_nr;
-    if (i == me->act_face) {
-      bm->act_face = f;
-    }
-
-    int j = mp->loopstart;
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      /* Don't use 'j' since we may have skipped some faces, hence some loops. */
-      BM_elem_index_set(l_iter, totloops++); /* set_ok */
-
-      /* Save index of corresponding #MLoop. */
-      CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
-    } while ((l_iter = l_iter->next) != l_first);
-
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
-
-    if (params->calc_face_normal) {
-      BM_face_normal_update(f);
+  else {
+    /* Only needed for selection. */
+    if (me->mselect && me->totselect != 0) {
+      ftable = MEM_mallocN(sizeof(BMFace **) * me->totpoly, __func__);
     }
-  }
-  if (is_new) {
-    bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* Added in order, clear dirty flag. */
+    data.ftable = ftable;
+    bm_mesh_elems_from_me_merge(&data);
   }
 
   /* -------------------------------------------------------------------- */
@@ -555,16 +940,164 @@ BLI_INLINE void bmesh_quick_edgedraw_flag(MEdge *med, BMEdge *e)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name BMesh -> Mesh Elements
+ *
+ * Elements are written in parallel using the element tables,
+ * each pass only reads indices set by the previous one.
+ * \{ */
+
+typedef struct BMeshToMeshData {
+  BMesh *bm;
+  Mesh *me;
+
+  int cd_vert_bweight_offset;
+  int cd_edge_bweight_offset;
+  int cd_edge_crease_offset;
+} BMeshToMeshData;
+
+static void bm_vert_to_mvert_cb(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMeshToMeshData *data = userdata;
+  BMesh *bm = data->bm;
+  BMVert *v = bm->vtable[i];
+  MVert *mvert = &data->me->mvert[i];
+
+  copy_v3_v3(mvert->co, v->co);
+  normal_float_to_short_v3(mvert->no, v->no);
+
+  mvert->flag = BM_vert_flag_to_mflag(v);
+
+  BM_elem_index_set(v, i); /* set_inline */
+
+  /* Copy over custom-data. */
+  CustomData_from_bmesh_block(&bm->vdata, &data->me->vdata, v->head.data, i);
+
+  if (data->cd_vert_bweight_offset != -1) {
+    mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, data->cd_vert_bweight_offset);
+  }
+
+  BM_CHECK_ELEMENT(v);
+}
+
+static void bm_edge_to_medge_cb(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMeshToMeshData *data = userdata;
+  BMesh *bm = data->bm;
+  BMEdge *e = bm->etable[i];
+  MEdge *med = &data->me->medge[i];
+
+  med->v1 = BM_elem_index_get(e->v1);
+  med->v2 = BM_elem_index_get(e->v2);
+
+  med->flag = BM_edge_flag_to_mflag(e);
+
+  BM_elem_index_set(e, i); /* set_inline */
+
+  /* Copy over custom-data. */
+  CustomData_from_bmesh_block(&bm->edata, &data->me->edata, e->head.data, i);
+
+  bmesh_quick_edgedraw_flag(med, e);
+
+  if (data->cd_edge_crease_offset != -1) {
+    med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, data->cd_edge_crease_offset);
+  }
+  if (data->cd_edge_bweight_offset != -1) {
+    med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, data->cd_edge_bweight_offset);
+  }
+
+  BM_CHECK_ELEMENT(e);
+}
+
+static void bm_face_to_mpoly_cb(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMeshToMeshData *data = userdata;
+  BMesh *bm = data->bm;
+  Mesh *me = data->me;
+  BMFace *f = bm->ftable[i];
+  MPoly *mpoly = &me->mpoly[i];
+  BMLoop *l_iter, *l_first;
+
+  /* The loop start is already set. */
+  mpoly->totloop = f->len;
+  mpoly->mat_nr = f->mat_nr;
+  mpoly->flag = BM_face_flag_to_mflag(f);
+
+  BM_elem_index_set(f, i); /* set_inline */
+
+  int j = mpoly->loopstart;
+  MLoop *mloop = &me->mloop[j];
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    mloop->e = BM_elem_index_get(l_iter->e);
+    mloop->v = BM_elem_index_get(l_iter->v);
+
+    /* Copy over custom-data. */
+    CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+
+    j++;
+    mloop++;
+    BM_CHECK_ELEMENT(l_iter);
+    BM_CHECK_ELEMENT(l_iter->e);
+    BM_CHECK_ELEMENT(l_iter->v);
+  } while ((l_iter = l_iter->next) != l_first);
+
+  /* Copy over custom-data. */
+  CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
+
+  BM_CHECK_ELEMENT(f);
+}
+
+/**
+ * Write the elements of \a data->bm into the arrays of \a data->me,
+ * which must already be allocated.
+ */
+static void bm_mesh_elems_to_me(BMeshToMeshData *data)
+{
+  BMesh *bm = data->bm;
+  Mesh *me = data->me;
+  TaskParallelSettings settings;
+  int i, totloop;
+
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+  BLI_parallel_range_settings_defaults(&settings);
+
+  settings.use_threading = (bm->totvert >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(0, bm->totvert, data, bm_vert_to_mvert_cb, &settings);
+  bm->elem_index_dirty &= ~BM_VERT;
+
+  settings.use_threading = (bm->totedge >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(0, bm->totedge, data, bm_edge_to_medge_cb, &settings);
+  bm->elem_index_dirty &= ~BM_EDGE;
+
+  for (i = 0, totloop = 0; i < bm->totface; i++) {
+    me->mpoly[i].loopstart = totloop;
+    totloop += bm->ftable[i]->len;
+  }
+
+  settings.use_threading = (bm->totface >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(0, bm->totface, data, bm_face_to_mpoly_cb, &settings);
+
+  if (bm->act_face) {
+    me->act_face = BM_elem_index_get(bm->act_face);
+  }
+}
+
+/** \} */
+
 /**
  *
  * \param bmain: May be NULL in case \a calc_object_remap parameter option is not set.
  */
 void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMeshParams *params)
 {
-  MEdge *med;
-  BMVert *v, *eve;
-  BMEdge *e;
-  BMFace *f;
+  BMVert *eve;
   BMIter iter;
   int i, j;
 
@@ -583,7 +1116,8 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
 #if 0
   oldverts = MEM_dupallocN(me->mvert);
 #else
-    oldverts = me->mvert;
+    /* The array might be shared with an evaluated copy, which keeps using it. */
+    oldverts = CustomData_duplicate_referenced_layer(&me->vdata, CD_MVERT, me->totvert);
     me->mvert = NULL;
     CustomData_update_typemap(&me->vdata);
     CustomData_set_layer(&me->vdata, CD_MVERT, NULL);
@@ -631,92 +1165,14 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
   /* This is called again, 'dotess' arg is used there. */
   BKE_mesh_update_customdata_pointers(me, 0);
 
-  i = 0;
-  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-    copy_v3_v3(mvert->co, v->co);
-    normal_float_to_short_v3(mvert->no, v->no);
-
-    mvert->flag = BM_vert_flag_to_mflag(v);
-
-    BM_elem_index_set(v, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
-
-    if (cd_vert_bweight_offset != -1) {
-      mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, cd_vert_bweight_offset);
-    }
-
-    i++;
-    mvert++;
-
-    BM_CHECK_ELEMENT(v);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
-
-  med = medge;
-  i = 0;
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    med->v1 = BM_elem_index_get(e->v1);
-    med->v2 = BM_elem_index_get(e->v2);
-
-    med->flag = BM_edge_flag_to_mflag(e);
-
-    BM_elem_index_set(e, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
-
-    bmesh_quick_edgedraw_flag(med, e);
-
-    if (cd_edge_crease_offset != -1) {
-      med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_crease_offset);
-    }
-    if (cd_edge_bweight_offset != -1) {
-      med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_bweight_offset);
-    }
-
-    i++;
-    med++;
-    BM_CHECK_ELEMENT(e);
-  }
-  bm->elem_index_dirty &= ~BM_EDGE;
-
-  i = 0;
-  j = 0;
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_iter, *l_first;
-    mpoly->loopstart = j;
-    mpoly->totloop = f->len;
-    mpoly->mat_nr = f->mat_nr;
-    mpoly->flag = BM_face_flag_to_mflag(f);
-
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      mloop->e = BM_elem_index_get(l_iter->e);
-      mloop->v = BM_elem_index_get(l_iter->v);
-
-      /* Copy over custom-data. */
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
-
-      j++;
-      mloop++;
-      BM_CHECK_ELEMENT(l_iter);
-      BM_CHECK_ELEMENT(l_iter->e);
-      BM_CHECK_ELEMENT(l_iter->v);
-    } while ((l_iter = l_iter->next) != l_first);
-
-    if (f == bm->act_face) {
-      me->act_face = i;
-    }
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
-
-    i++;
-    mpoly++;
-    BM_CHECK_ELEMENT(f);
-  }
+  BMeshToMeshData data = {
+      .bm = bm,
+      .me = me,
+      .cd_vert_bweight_offset = cd_vert_bweight_offset,
+      .cd_edge_bweight_offset = cd_edge_bweight_offset,
+      .cd_edge_crease_offset = cd_edge_crease_offset,
+  };
+  bm_mesh_elems_to_me(&data);
 
   /* Patch hook indices and vertex parents. */
   if (params->calc_object_remap && (ototvert > 0)) {
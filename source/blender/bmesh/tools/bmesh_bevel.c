@@ -7173,6 +7173,11 @@ void BM_mesh_bevel(BMesh *bm,
   BMLoop *l;
   BevVert *bv;
   BevelParams bp = {NULL};
+  /* Constructed BevVerts in mesh order, so the passes below don't have to visit every vertex
+   * of the mesh and look them up again. */
+  BevVert **bv_array = NULL;
+  BLI_array_declare(bv_array);
+  int i;
 
   bp.offset = offset;
   bp.offset_type = offset_type;
@@ -7249,8 +7254,11 @@ void BM_mesh_bevel(BMesh *bm,
     BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
       if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
         bv = bevel_vert_construct(bm, &bp, v);
-        if (!limit_offset && bv) {
-          build_boundary(&bp, bv, true);
+        if (bv) {
+          BLI_array_append(bv_array, bv);
+          if (!limit_offset) {
+            build_boundary(&bp, bv, true);
+          }
         }
       }
     }
@@ -7260,13 +7268,8 @@ void BM_mesh_bevel(BMesh *bm,
       bevel_limit_offset(&bp, bm);
 
       /* Assign initial new vertex positions. */
-      BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-        if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
-          bv = find_bevvert(&bp, v);
-          if (bv) {
-            build_boundary(&bp, bv, true);
-          }
-        }
+      for (i = 0; i < BLI_array_len(bv_array); i++) {
+        build_boundary(&bp, bv_array[i], true);
       }
     }
 
@@ -7285,13 +7288,8 @@ void BM_mesh_bevel(BMesh *bm,
     }
 
     /* Build the meshes around vertices, now that positions are final. */
-    BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-      if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
-        bv = find_bevvert(&bp, v);
-        if (bv) {
-          build_vmesh(&bp, bm, bv);
-        }
-      }
+    for (i = 0; i < BLI_array_len(bv_array); i++) {
+      build_vmesh(&bp, bm, bv_array[i]);
     }
 
     /* Build polygons for edges. */
@@ -7304,15 +7302,12 @@ void BM_mesh_bevel(BMesh *bm,
     }
 
     /* Extend edge data like sharp edges and precompute normals for harden. */
-    BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-      if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
-        bv = find_bevvert(&bp, v);
-        if (bv) {
-          bevel_extend_edge_data(bv);
-        }
-      }
+    for (i = 0; i < BLI_array_len(bv_array); i++) {
+      bevel_extend_edge_data(bv_array[i]);
     }
 
+    BLI_array_free(bv_array);
+
     /* Rebuild face polygons around affected vertices. */
     BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
       if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
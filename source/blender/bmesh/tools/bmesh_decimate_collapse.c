@@ -32,6 +32,7 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.h"
@@ -237,18 +238,23 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * Calculate the collapse cost of \a e without touching the heap,
+ * so it can be used from multiple threads.
+ *
+ * \return false when the edge can't be collapsed.
+ */
+static bool bm_decim_calc_edge_cost(BMEdge *e,
+                                    const Quadric *vquadrics,
+                                    const float *vweights,
+                                    const float vweight_factor,
+                                    float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f)))) {
-    goto clear;
+    return false;
   }
 
   /* check we can collapse, some edges we better not touch */
@@ -258,7 +264,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -267,11 +273,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* end sanity check */
 
@@ -324,14 +330,28 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
 
-clear:
-  if (eheap_table[BM_elem_index_get(e)]) {
-    BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
+  if (bm_decim_calc_edge_cost(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+  }
+  else {
+    if (eheap_table[BM_elem_index_get(e)]) {
+      BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
+    }
+    eheap_table[BM_elem_index_get(e)] = NULL;
   }
-  eheap_table[BM_elem_index_get(e)] = NULL;
 }
 
 /* use this for degenerate cases - add back to the heap with an invalid cost,
@@ -342,6 +362,30 @@ static void bm_decim_invalid_edge_cost_single(BMEdge *e, Heap *eheap, HeapNode *
   eheap_table[BM_elem_index_get(e)] = BLI_heap_insert(eheap, COST_INVALID, e);
 }
 
+typedef struct EdgeCost {
+  float cost;
+  bool is_valid;
+} EdgeCost;
+
+typedef struct EdgeCostBuildData {
+  BMEdge **etable;
+  const Quadric *vquadrics;
+  const float *vweights;
+  float vweight_factor;
+  EdgeCost *edge_costs;
+} EdgeCostBuildData;
+
+static void bm_decim_build_edge_cost_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  EdgeCostBuildData *data = userdata;
+  EdgeCost *edge_cost = &data->edge_costs[i];
+
+  edge_cost->is_valid = bm_decim_calc_edge_cost(
+      data->etable[i], data->vquadrics, data->vweights, data->vweight_factor, &edge_cost->cost);
+}
+
 static void bm_decim_build_edge_cost(BMesh *bm,
                                      const Quadric *vquadrics,
                                      const float *vweights,
@@ -349,15 +393,36 @@ static void bm_decim_build_edge_cost(BMesh *bm,
                                      Heap *eheap,
                                      HeapNode **eheap_table)
 {
-  BMIter iter;
-  BMEdge *e;
-  uint i;
-
-  BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
-    /* keep sanity check happy */
-    eheap_table[i] = NULL;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+  /* Costs only read the quadrics and geometry, calculate them in parallel,
+   * then fill the heap in edge order so the result matches a serial build. */
+  EdgeCost *edge_costs = MEM_mallocN(sizeof(*edge_costs) * (size_t)bm->totedge, __func__);
+  int i;
+
+  BM_mesh_elem_table_ensure(bm, BM_EDGE);
+
+  EdgeCostBuildData data = {
+      .etable = bm->etable,
+      .vquadrics = vquadrics,
+      .vweights = vweights,
+      .vweight_factor = vweight_factor,
+      .edge_costs = edge_costs,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (bm->totedge >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(0, bm->totedge, &data, bm_decim_build_edge_cost_cb, &settings);
+
+  for (i = 0; i < bm->totedge; i++) {
+    if (edge_costs[i].is_valid) {
+      eheap_table[i] = BLI_heap_insert(eheap, edge_costs[i].cost, bm->etable[i]);
+    }
+    else {
+      eheap_table[i] = NULL;
+    }
   }
+
+  MEM_freeN(edge_costs);
 }
 
 #ifdef USE_SYMMETRY
@@ -46,6 +46,7 @@
 
 #include "BLI_kdopbvh.h"
 #include "BLI_buffer.h"
+#include "BLI_flathash.h"
 
 #include "bmesh.h"
 #include "intern/bmesh_private.h"
@@ -122,9 +123,9 @@ struct ISectEpsilon {
 
 struct ISectState {
   BMesh *bm;
-  GHash *edgetri_cache;    /* int[4]: BMVert */
-  GHash *edge_verts;       /* BMEdge: LinkList(of verts), new and original edges */
-  GHash *face_edges;       /* BMFace-index: LinkList(of edges), only original faces */
+  FlatHash *edgetri_cache; /* int[4]: BMVert */
+  FlatHash *edge_verts;    /* BMEdge: LinkList(of verts), new and original edges */
+  FlatHash *face_edges;    /* BMFace-index: LinkList(of edges), only original faces */
   GSet *wire_edges;        /* BMEdge  (could use tags instead) */
   LinkNode *vert_dissolve; /* BMVert's */
 
@@ -134,21 +135,22 @@ struct ISectState {
 };
 
 /**
- * Store as value in GHash so we can get list-length without counting every time.
- * Also means we don't need to update the GHash value each time.
+ * Store as value in the hash so we can get list-length without counting every time.
+ * Also means we don't need to update the hash value each time.
  */
 struct LinkBase {
   LinkNode *list;
   uint list_len;
 };
 
-static bool ghash_insert_link(GHash *gh, void *key, void *val, bool use_test, MemArena *mem_arena)
+static bool flathash_insert_link(
+    FlatHash *fh, void *key, void *val, bool use_test, MemArena *mem_arena)
 {
   void **ls_base_p;
   struct LinkBase *ls_base;
   LinkNode *ls;
 
-  if (!BLI_ghash_ensure_p(gh, key, &ls_base_p)) {
+  if (!BLI_flathash_ensure_p(fh, key, &ls_base_p)) {
     ls_base = *ls_base_p = BLI_memarena_alloc(mem_arena, sizeof(*ls_base));
     ls_base->list = NULL;
     ls_base->list_len = 0;
@@ -203,7 +205,7 @@ static void edge_verts_add(struct ISectState *s, BMEdge *e, BMVert *v, const boo
 {
   BLI_assert(e->head.htype == BM_EDGE);
   BLI_assert(v->head.htype == BM_VERT);
-  ghash_insert_link(s->edge_verts, (void *)e, v, use_test, s->mem_arena);
+  flathash_insert_link(s->edge_verts, (void *)e, v, use_test, s->mem_arena);
 }
 
 static void face_edges_add(struct ISectState *s, const int f_index, BMEdge *e, const bool use_test)
@@ -213,7 +215,7 @@ static void face_edges_add(struct ISectState *s, const int f_index, BMEdge *e, c
   BLI_assert(BM_edge_in_face(e, s->bm->ftable[f_index]) == false);
   BLI_assert(BM_elem_index_get(s->bm->ftable[f_index]) == f_index);
 
-  ghash_insert_link(s->face_edges, f_index_key, e, use_test, s->mem_arena);
+  flathash_insert_link(s->face_edges, f_index_key, e, use_test, s->mem_arena);
 }
 
 #ifdef USE_NET
@@ -413,7 +415,7 @@ static BMVert *bm_isect_edge_tri(struct ISectState *s,
   for (i = 0; i < ARRAY_SIZE(k_arr); i++) {
     BMVert *iv;
 
-    iv = BLI_ghash_lookup(s->edgetri_cache, k_arr[i]);
+    iv = BLI_flathash_lookup(s->edgetri_cache, k_arr[i]);
 
     if (iv) {
 #ifdef USE_DUMP
@@ -465,7 +467,7 @@ static BMVert *bm_isect_edge_tri(struct ISectState *s,
     {
       int *k = BLI_memarena_alloc(s->mem_arena, sizeof(int[4]));
       memcpy(k, k_arr[*r_side], sizeof(int[4]));
-      BLI_ghash_insert(s->edgetri_cache, k, iv);
+      BLI_flathash_insert(s->edgetri_cache, k, iv);
     }
 
     return iv;
@@ -837,6 +839,60 @@ finally:
 
 #ifdef USE_BVH
 
+struct ISectOverlapData {
+  BMLoop *(*looptris)[3];
+  /** Distance from the plane a triangle must exceed for the pair to be rejected. */
+  float eps_plane;
+};
+
+/**
+ * True when all of \a a lies on one side of the plane of \a b, further than \a eps.
+ * Degenerate triangles have a zero normal so they are never rejected.
+ */
+static bool bm_isect_tri_plane_side_test(BMLoop **a, BMLoop **b, const float eps)
+{
+  float plane[4];
+  float no[3];
+  float side[3];
+
+  normal_tri_v3(no, UNPACK3_EX(, b, ->v->co));
+  plane_from_point_normal_v3(plane, b[0]->v->co, no);
+
+  side[0] = plane_point_side_v3(plane, a[0]->v->co);
+  side[1] = plane_point_side_v3(plane, a[1]->v->co);
+  side[2] = plane_point_side_v3(plane, a[2]->v->co);
+
+  return ((side[0] > eps && side[1] > eps && side[2] > eps) ||
+          (side[0] < -eps && side[1] < -eps && side[2] < -eps));
+}
+
+/**
+ * Filter overlap pairs which #bm_isect_tri_tri can't do anything with,
+ * called from the (threaded) overlap traversal so the serial pass that edits the mesh
+ * only visits pairs which may intersect.
+ *
+ * Only reads the original coordinates which aren't modified until all pairs are known.
+ */
+static bool bm_isect_overlap_cb(void *userdata, int index_a, int index_b, int UNUSED(thread))
+{
+  struct ISectOverlapData *data = userdata;
+  BMLoop **a = data->looptris[index_a];
+  BMLoop **b = data->looptris[index_b];
+
+  /* Matches the early exit in #bm_isect_tri_tri. */
+  if (UNLIKELY(ELEM(a[0]->v, UNPACK3_EX(, b, ->v)) || ELEM(a[1]->v, UNPACK3_EX(, b, ->v)) ||
+               ELEM(a[2]->v, UNPACK3_EX(, b, ->v)))) {
+    return false;
+  }
+
+  if (bm_isect_tri_plane_side_test(a, b, data->eps_plane) ||
+      bm_isect_tri_plane_side_test(b, a, data->eps_plane)) {
+    return false;
+  }
+
+  return true;
+}
+
 struct RaycastData {
   const float **looptris;
   BLI_Buffer *z_buffer;
@@ -983,11 +1039,11 @@ bool BM_mesh_intersect(BMesh *bm,
 
   s.bm = bm;
 
-  s.edgetri_cache = BLI_ghash_new(
+  s.edgetri_cache = BLI_flathash_new(
       BLI_ghashutil_inthash_v4_p, BLI_ghashutil_inthash_v4_cmp, __func__);
 
-  s.edge_verts = BLI_ghash_ptr_new(__func__);
-  s.face_edges = BLI_ghash_int_new(__func__);
+  s.edge_verts = BLI_flathash_ptr_new(__func__);
+  s.face_edges = BLI_flathash_int_new(__func__);
   s.wire_edges = BLI_gset_ptr_new(__func__);
   s.vert_dissolve = NULL;
 
@@ -1090,7 +1146,16 @@ bool BM_mesh_intersect(BMesh *bm,
     flag &= ~BVH_OVERLAP_USE_THREADING;
   }
 #  endif
-  overlap = BLI_bvhtree_overlap_ex(tree_b, tree_a, &tree_overlap_tot, NULL, NULL, 0, flag);
+  {
+    /* All intersection tests in #bm_isect_tri_tri are within the margin,
+     * double it so rounding can't reject a pair which intersects. */
+    struct ISectOverlapData overlap_data = {
+        .looptris = looptris,
+        .eps_plane = s.epsilon.eps_margin * 2.0f,
+    };
+    overlap = BLI_bvhtree_overlap_ex(
+        tree_b, tree_a, &tree_overlap_tot, bm_isect_overlap_cb, &overlap_data, 0, flag);
+  }
 
   if (overlap) {
     uint i;
@@ -1157,11 +1222,11 @@ bool BM_mesh_intersect(BMesh *bm,
 
 #ifdef USE_SPLICE
   {
-    GHashIterator gh_iter;
+    FlatHashIterator fh_iter;
 
-    GHASH_ITER (gh_iter, s.edge_verts) {
-      BMEdge *e = BLI_ghashIterator_getKey(&gh_iter);
-      struct LinkBase *v_ls_base = BLI_ghashIterator_getValue(&gh_iter);
+    FLATHASH_ITER (fh_iter, s.edge_verts) {
+      BMEdge *e = BLI_flathashIterator_getKey(&fh_iter);
+      struct LinkBase *v_ls_base = BLI_flathashIterator_getValue(&fh_iter);
 
       BMVert *v_start;
       BMVert *v_end;
@@ -1342,10 +1407,10 @@ bool BM_mesh_intersect(BMesh *bm,
 
     /* Remove edges! */
     {
-      GHashIterator gh_iter;
+      FlatHashIterator fh_iter;
 
-      GHASH_ITER (gh_iter, s.face_edges) {
-        struct LinkBase *e_ls_base = BLI_ghashIterator_getValue(&gh_iter);
+      FLATHASH_ITER (fh_iter, s.face_edges) {
+        struct LinkBase *e_ls_base = BLI_flathashIterator_getValue(&fh_iter);
         LinkNode **node_prev_p;
         uint i;
 
@@ -1434,17 +1499,17 @@ bool BM_mesh_intersect(BMesh *bm,
   /* now split faces */
 #ifdef USE_NET
   {
-    GHashIterator gh_iter;
+    FlatHashIterator fh_iter;
     BMFace **faces;
 
     MemArena *mem_arena_edgenet = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
 
     faces = bm->ftable;
 
-    GHASH_ITER (gh_iter, s.face_edges) {
-      const int f_index = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
+    FLATHASH_ITER (fh_iter, s.face_edges) {
+      const int f_index = POINTER_AS_INT(BLI_flathashIterator_getKey(&fh_iter));
       BMFace *f;
-      struct LinkBase *e_ls_base = BLI_ghashIterator_getValue(&gh_iter);
+      struct LinkBase *e_ls_base = BLI_flathashIterator_getValue(&fh_iter);
 
       BLI_assert(f_index >= 0 && f_index < totface_orig);
 
@@ -1632,13 +1697,13 @@ bool BM_mesh_intersect(BMesh *bm,
     }
   }
 
-  has_edit_isect = (BLI_ghash_len(s.face_edges) != 0);
+  has_edit_isect = (BLI_flathash_len(s.face_edges) != 0);
 
   /* cleanup */
-  BLI_ghash_free(s.edgetri_cache, NULL, NULL);
+  BLI_flathash_free(s.edgetri_cache, NULL, NULL);
 
-  BLI_ghash_free(s.edge_verts, NULL, NULL);
-  BLI_ghash_free(s.face_edges, NULL, NULL);
+  BLI_flathash_free(s.edge_verts, NULL, NULL);
+  BLI_flathash_free(s.face_edges, NULL, NULL);
   BLI_gset_free(s.wire_edges, NULL);
 
   BLI_memarena_free(s.mem_arena);
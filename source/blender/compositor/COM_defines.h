@@ -109,4 +109,7 @@ typedef enum OrderOfChunks {
 
 #define COM_BLUR_BOKEH_PIXELS 512
 
+/* maximum number of pixels calculated by a single SocketReader.executeRow call */
+#define COM_ROW_SPAN 64
+
 #endif /* __COM_DEFINES_H__ */
@@ -50,6 +50,8 @@ ExecutionGroup::ExecutionGroup()
   this->m_height = 0;
   this->m_width = 0;
   this->m_cachedMaxReadBufferOffset = 0;
+  this->m_fullFrame = false;
+  this->m_rowsPerChunk = 0;
   this->m_numberOfXChunks = 0;
   this->m_numberOfYChunks = 0;
   this->m_numberOfChunks = 0;
@@ -119,6 +121,26 @@ NodeOperation *ExecutionGroup::getOutputOperation() const
       ->m_operations[0];  // the first operation of the group is always the output operation.
 }
 
+bool ExecutionGroup::isExecuted() const
+{
+  if (this->m_chunkExecutionStates == NULL) {
+    return false;
+  }
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    if (this->m_chunkExecutionStates[index] != COM_ES_EXECUTED) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ExecutionGroup::setExecuted()
+{
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    this->m_chunkExecutionStates[index] = COM_ES_EXECUTED;
+  }
+}
+
 void ExecutionGroup::initExecution()
 {
   if (this->m_chunkExecutionStates != NULL) {
@@ -178,6 +200,16 @@ void ExecutionGroup::determineNumberOfChunks()
     this->m_numberOfYChunks = 1;
     this->m_numberOfChunks = 1;
   }
+  else if (this->m_fullFrame) {
+    /* Full width rows, with about as many pixels in a chunk as in a tile. */
+    const int border_width = BLI_rcti_size_x(&this->m_viewerBorder);
+    const int border_height = BLI_rcti_size_y(&this->m_viewerBorder);
+    this->m_rowsPerChunk = max_ii(this->m_chunkSize * this->m_chunkSize / max_ii(border_width, 1),
+                                  1);
+    this->m_numberOfXChunks = 1;
+    this->m_numberOfYChunks = (border_height + this->m_rowsPerChunk - 1) / this->m_rowsPerChunk;
+    this->m_numberOfChunks = this->m_numberOfXChunks * this->m_numberOfYChunks;
+  }
   else {
     const float chunkSizef = this->m_chunkSize;
     const int border_width = BLI_rcti_size_x(&this->m_viewerBorder);
@@ -371,6 +403,42 @@ void ExecutionGroup::execute(ExecutionSystem *graph)
   MEM_freeN(chunkOrder);
 }
 
+void ExecutionGroup::executeFullFrame(ExecutionSystem *graph)
+{
+  const CompositorContext &context = graph->getContext();
+  const bNodeTree *bTree = context.getbNodeTree();
+  if (this->m_width == 0 || this->m_height == 0) {
+    return;
+  }
+  if (bTree->test_break && bTree->test_break(bTree->tbh)) {
+    return;
+  }
+  if (this->m_numberOfChunks == 0) {
+    return;
+  }
+
+  this->m_executionStartTime = PIL_check_seconds_timer();
+
+  this->m_chunksFinished = 0;
+  this->m_bTree = bTree;
+
+  DebugInfo::execution_group_started(this);
+  DebugInfo::graphviz(graph);
+
+  for (unsigned int chunkNumber = 0; chunkNumber < this->m_numberOfChunks; chunkNumber++) {
+    scheduleChunk(chunkNumber);
+  }
+
+  WorkScheduler::finish();
+
+  if (bTree->update_draw) {
+    bTree->update_draw(bTree->udh);
+  }
+
+  DebugInfo::execution_group_finished(this);
+  DebugInfo::graphviz(graph);
+}
+
 MemoryBuffer **ExecutionGroup::getInputBuffersOpenCL(int chunkNumber)
 {
   rcti rect;
@@ -449,6 +517,16 @@ inline void ExecutionGroup::determineChunkRect(rcti *rect,
     BLI_rcti_init(
         rect, this->m_viewerBorder.xmin, border_width, this->m_viewerBorder.ymin, border_height);
   }
+  else if (this->m_fullFrame) {
+    const unsigned int miny = yChunk * this->m_rowsPerChunk + this->m_viewerBorder.ymin;
+    const unsigned int width = min((unsigned int)this->m_viewerBorder.xmax, this->m_width);
+    const unsigned int height = min((unsigned int)this->m_viewerBorder.ymax, this->m_height);
+    BLI_rcti_init(rect,
+                  min((unsigned int)this->m_viewerBorder.xmin, this->m_width),
+                  width,
+                  min(miny, this->m_height),
+                  min(miny + this->m_rowsPerChunk, height));
+  }
   else {
     const unsigned int minx = xChunk * this->m_chunkSize + this->m_viewerBorder.xmin;
     const unsigned int miny = yChunk * this->m_chunkSize + this->m_viewerBorder.ymin;
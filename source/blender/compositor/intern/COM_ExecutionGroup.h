@@ -94,6 +94,17 @@ class ExecutionGroup {
    */
   unsigned int m_chunkSize;
 
+  /**
+   * \brief execute the whole frame at once in bands of full width rows
+   * instead of square chunks.
+   */
+  bool m_fullFrame;
+
+  /**
+   * \brief number of rows in a single chunk in full frame execution
+   */
+  unsigned int m_rowsPerChunk;
+
   /**
    * \brief number of chunks in the x-axis
    */
@@ -329,6 +340,24 @@ class ExecutionGroup {
    */
   NodeOperation *getOutputOperation() const;
 
+  /**
+   * \brief get the operations of this ExecutionGroup, the output operation first
+   */
+  const Operations &getOperations() const
+  {
+    return this->m_operations;
+  }
+
+  /**
+   * \brief have all chunks of this ExecutionGroup been executed
+   */
+  bool isExecuted() const;
+
+  /**
+   * \brief mark all chunks as executed, used when the result was taken from the ResultCache
+   */
+  void setExecuted();
+
   /**
    * \brief compose multiple chunks into a single chunk
    * \return Memorybuffer *consolidated chunk
@@ -396,6 +425,14 @@ class ExecutionGroup {
    */
   void execute(ExecutionSystem *system);
 
+  /**
+   * \brief schedule all chunks of this ExecutionGroup at once
+   * \note all ExecutionGroups this group depends on must have been executed before,
+   * so no areas of interest have to be determined.
+   * \see ExecutionSystem.executeFullFrame
+   */
+  void executeFullFrame(ExecutionSystem *system);
+
   /**
    * \brief this method determines the MemoryProxy's where this execution group depends on.
    * \note After this method determineDependingAreaOfInterest can be called to determine
@@ -422,6 +459,11 @@ class ExecutionGroup {
     this->m_chunkSize = chunksize;
   }
 
+  void setFullFrame(bool fullFrame)
+  {
+    this->m_fullFrame = fullFrame;
+  }
+
   /**
    * \brief get the Render priority of this ExecutionGroup
    * \see ExecutionSystem.execute
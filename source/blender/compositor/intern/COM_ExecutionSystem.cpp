@@ -18,6 +18,11 @@
 
 #include "COM_ExecutionSystem.h"
 
+#include <map>
+#include <set>
+#include <string.h>
+#include <typeinfo>
+
 #include "PIL_time.h"
 #include "BLI_utildefines.h"
 extern "C" {
@@ -30,8 +35,10 @@ extern "C" {
 #include "COM_NodeOperationBuilder.h"
 #include "COM_NodeOperation.h"
 #include "COM_ExecutionGroup.h"
+#include "COM_MemoryBufferPool.h"
 #include "COM_WorkScheduler.h"
 #include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
 #include "COM_Debug.h"
 
 #ifdef WITH_CXX_GUARDEDALLOC
@@ -67,6 +74,12 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
   this->m_context.setViewSettings(viewSettings);
   this->m_context.setDisplaySettings(displaySettings);
 
+  /* Results of a render invalidate everything cached from the previous one. */
+  this->m_cacheLimit = rendering ? 0 : (size_t)editingtree->cache_limit * 1024 * 1024;
+  if (this->m_cacheLimit == 0) {
+    ResultCache::clear();
+  }
+
   {
     NodeOperationBuilder builder(&m_context, editingtree);
     builder.convertToOperations(this);
@@ -147,11 +160,16 @@ void ExecutionSystem::execute()
     }
   }
   unsigned int index;
+  const bool fullFrame = this->m_context.isFullFrameEnabled();
+  MemoryBufferPool bufferPool;
 
   // First allocale all write buffer
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
     if (operation->isWriteBufferOperation()) {
+      if (fullFrame) {
+        ((WriteBufferOperation *)operation)->getMemoryProxy()->setBufferPool(&bufferPool);
+      }
       operation->setbNodeTree(this->m_context.getbNodeTree());
       operation->initExecution();
     }
@@ -175,18 +193,40 @@ void ExecutionSystem::execute()
   for (index = 0; index < this->m_groups.size(); index++) {
     ExecutionGroup *executionGroup = this->m_groups[index];
     executionGroup->setChunksize(this->m_context.getChunksize());
+    executionGroup->setFullFrame(fullFrame);
     executionGroup->initExecution();
   }
 
+  determineCacheKeys();
+  if (!fullFrame) {
+    for (index = 0; index < this->m_groups.size(); index++) {
+      ExecutionGroup *executionGroup = this->m_groups[index];
+      if (hasCachedResult(executionGroup)) {
+        restoreCachedResult(executionGroup);
+      }
+    }
+  }
+
   WorkScheduler::start(this->m_context);
 
-  executeGroups(COM_PRIORITY_HIGH);
-  if (!this->getContext().isFastCalculation()) {
-    executeGroups(COM_PRIORITY_MEDIUM);
-    executeGroups(COM_PRIORITY_LOW);
+  if (fullFrame) {
+    executeFullFrame();
+  }
+  else {
+    executeGroups(COM_PRIORITY_HIGH);
+    if (!this->getContext().isFastCalculation()) {
+      executeGroups(COM_PRIORITY_MEDIUM);
+      executeGroups(COM_PRIORITY_LOW);
+    }
   }
 
   WorkScheduler::finish();
+
+  if (!fullFrame && !editingtree->test_break(editingtree->tbh)) {
+    for (index = 0; index < this->m_groups.size(); index++) {
+      storeCachedResult(this->m_groups[index]);
+    }
+  }
   WorkScheduler::stop();
 
   editingtree->stats_draw(editingtree->sdh, TIP_("Compositing | De-initializing execution"));
@@ -212,6 +252,231 @@ void ExecutionSystem::executeGroups(CompositorPriority priority)
   }
 }
 
+static void full_frame_order_groups(ExecutionGroup *group,
+                                    const std::set<ExecutionGroup *> &cached,
+                                    std::set<ExecutionGroup *> &visited,
+                                    vector<ExecutionGroup *> &order)
+{
+  if (visited.find(group) != visited.end()) {
+    return;
+  }
+  visited.insert(group);
+
+  /* The groups a cached result was computed from don't have to be executed. */
+  vector<MemoryProxy *> memoryProxies;
+  if (cached.find(group) == cached.end()) {
+    group->determineDependingMemoryProxies(&memoryProxies);
+  }
+  for (unsigned int index = 0; index < memoryProxies.size(); index++) {
+    ExecutionGroup *executor = memoryProxies[index]->getExecutor();
+    if (executor) {
+      full_frame_order_groups(executor, cached, visited, order);
+    }
+  }
+
+  order.push_back(group);
+}
+
+void ExecutionSystem::executeFullFrame()
+{
+  const bNodeTree *bTree = this->m_context.getbNodeTree();
+  unsigned int index;
+
+  /* Order the groups so every group is executed after the groups it reads from. */
+  vector<ExecutionGroup *> outputGroups;
+  this->findOutputExecutionGroup(&outputGroups, COM_PRIORITY_HIGH);
+  if (!this->getContext().isFastCalculation()) {
+    this->findOutputExecutionGroup(&outputGroups, COM_PRIORITY_MEDIUM);
+    this->findOutputExecutionGroup(&outputGroups, COM_PRIORITY_LOW);
+  }
+
+  std::set<ExecutionGroup *> cached;
+  for (index = 0; index < this->m_groups.size(); index++) {
+    if (hasCachedResult(this->m_groups[index])) {
+      cached.insert(this->m_groups[index]);
+    }
+  }
+
+  std::set<ExecutionGroup *> visited;
+  vector<ExecutionGroup *> order;
+  for (index = 0; index < outputGroups.size(); index++) {
+    full_frame_order_groups(outputGroups[index], cached, visited, order);
+  }
+
+  /* Find the last group reading each buffer, after which the buffer can be recycled. */
+  std::map<MemoryProxy *, unsigned int> lastUse;
+  vector<vector<MemoryProxy *> > groupInputs(order.size());
+  for (index = 0; index < order.size(); index++) {
+    if (cached.find(order[index]) != cached.end()) {
+      continue;
+    }
+    order[index]->determineDependingMemoryProxies(&groupInputs[index]);
+    for (unsigned int i = 0; i < groupInputs[index].size(); i++) {
+      lastUse[groupInputs[index][i]] = index;
+    }
+  }
+
+  for (index = 0; index < order.size(); index++) {
+    ExecutionGroup *group = order[index];
+
+    NodeOperation *output = group->getOutputOperation();
+    if (output->isWriteBufferOperation()) {
+      MemoryProxy *proxy = ((WriteBufferOperation *)output)->getMemoryProxy();
+      proxy->acquireBuffer();
+      for (unsigned int i = 0; i < this->m_operations.size(); i++) {
+        NodeOperation *operation = this->m_operations[i];
+        if (operation->isReadBufferOperation() &&
+            ((ReadBufferOperation *)operation)->getMemoryProxy() == proxy) {
+          ((ReadBufferOperation *)operation)->updateMemoryBuffer();
+        }
+      }
+    }
+
+    if (cached.find(group) != cached.end()) {
+      restoreCachedResult(group);
+      continue;
+    }
+
+    group->executeFullFrame(this);
+
+    const bool breaked = bTree->test_break && bTree->test_break(bTree->tbh);
+    if (!breaked) {
+      storeCachedResult(group);
+    }
+
+    for (unsigned int i = 0; i < groupInputs[index].size(); i++) {
+      MemoryProxy *proxy = groupInputs[index][i];
+      if (lastUse[proxy] == index) {
+        proxy->free();
+      }
+    }
+
+    if (breaked) {
+      break;
+    }
+  }
+}
+
+ResultCache::Key ExecutionSystem::determineCacheKey(ExecutionGroup *group,
+                                                   ResultCache::Key contextKey)
+{
+  std::map<ExecutionGroup *, ResultCache::Key>::iterator found = this->m_cacheKeys.find(group);
+  if (found != this->m_cacheKeys.end()) {
+    return found->second;
+  }
+
+  const ExecutionGroup::Operations &operations = group->getOperations();
+  std::map<NodeOperation *, int> indices;
+  for (unsigned int index = 0; index < operations.size(); index++) {
+    indices[operations[index]] = index;
+  }
+
+  ResultCache::Key key = contextKey;
+  for (unsigned int index = 0; index < operations.size() && key; index++) {
+    NodeOperation *operation = operations[index];
+    const uint64_t settings = operation->getSettingsHash();
+    if (settings == 0) {
+      key = 0;
+      break;
+    }
+
+    const char *type = typeid(*operation).name();
+    const unsigned int resolution[2] = {operation->getWidth(), operation->getHeight()};
+    key = ResultCache::hashData(key, type, strlen(type));
+    key = ResultCache::hashData(key, &settings, sizeof(settings));
+    key = ResultCache::hashData(key, resolution, sizeof(resolution));
+
+    if (operation->isReadBufferOperation()) {
+      MemoryProxy *proxy = ((ReadBufferOperation *)operation)->getMemoryProxy();
+      ExecutionGroup *executor = proxy->getExecutor();
+      const ResultCache::Key input = executor ? determineCacheKey(executor, contextKey) : 0;
+      if (input == 0) {
+        key = 0;
+        break;
+      }
+      key = ResultCache::hashData(key, &input, sizeof(input));
+    }
+
+    /* Links between operations of the group, by position in the group. */
+    for (unsigned int i = 0; i < operation->getNumberOfInputSockets(); i++) {
+      NodeOperationOutput *link = operation->getInputSocket(i)->getLink();
+      int linked = -1;
+      if (link) {
+        std::map<NodeOperation *, int>::iterator it = indices.find(&link->getOperation());
+        linked = (it != indices.end()) ? it->second : -2;
+      }
+      key = ResultCache::hashData(key, &linked, sizeof(linked));
+    }
+  }
+
+  /* Only results written to a buffer can be cached. */
+  if (group->isOutputExecutionGroup() || !group->getOutputOperation()->isWriteBufferOperation()) {
+    key = 0;
+  }
+
+  this->m_cacheKeys[group] = key;
+  return key;
+}
+
+void ExecutionSystem::determineCacheKeys()
+{
+  this->m_cacheKeys.clear();
+  if (this->m_cacheLimit == 0) {
+    return;
+  }
+
+  ResultCache::Key contextKey = 1;
+  const int quality = this->m_context.getQuality();
+  const int frame = this->m_context.getFramenumber();
+  const bool fastCalculation = this->m_context.isFastCalculation();
+  const char *viewName = this->m_context.getViewName();
+  contextKey = ResultCache::hashData(contextKey, &quality, sizeof(quality));
+  contextKey = ResultCache::hashData(contextKey, &frame, sizeof(frame));
+  contextKey = ResultCache::hashData(contextKey, &fastCalculation, sizeof(fastCalculation));
+  if (viewName) {
+    contextKey = ResultCache::hashData(contextKey, viewName, strlen(viewName));
+  }
+
+  for (unsigned int index = 0; index < this->m_groups.size(); index++) {
+    determineCacheKey(this->m_groups[index], contextKey);
+  }
+}
+
+bool ExecutionSystem::hasCachedResult(ExecutionGroup *group)
+{
+  std::map<ExecutionGroup *, ResultCache::Key>::iterator found = this->m_cacheKeys.find(group);
+  if (found == this->m_cacheKeys.end() || found->second == 0) {
+    return false;
+  }
+
+  WriteBufferOperation *operation = (WriteBufferOperation *)group->getOutputOperation();
+  rcti rect;
+  BLI_rcti_init(&rect, 0, operation->getWidth(), 0, operation->getHeight());
+  return ResultCache::find(found->second, operation->getMemoryProxy()->getDataType(), &rect) !=
+         NULL;
+}
+
+void ExecutionSystem::restoreCachedResult(ExecutionGroup *group)
+{
+  MemoryProxy *proxy = ((WriteBufferOperation *)group->getOutputOperation())->getMemoryProxy();
+  MemoryBuffer *buffer = proxy->getBuffer();
+  buffer->copyContentFrom(
+      ResultCache::find(this->m_cacheKeys[group], proxy->getDataType(), buffer->getRect()));
+  buffer->setCreatedState();
+  group->setExecuted();
+}
+
+void ExecutionSystem::storeCachedResult(ExecutionGroup *group)
+{
+  std::map<ExecutionGroup *, ResultCache::Key>::iterator found = this->m_cacheKeys.find(group);
+  if (found == this->m_cacheKeys.end() || found->second == 0 || !group->isExecuted()) {
+    return;
+  }
+
+  MemoryProxy *proxy = ((WriteBufferOperation *)group->getOutputOperation())->getMemoryProxy();
+  ResultCache::store(found->second, proxy->getBuffer(), this->m_cacheLimit);
+}
+
 void ExecutionSystem::findOutputExecutionGroup(vector<ExecutionGroup *> *result,
                                                CompositorPriority priority) const
 {
@@ -27,6 +27,9 @@ class ExecutionGroup;
 #include "BKE_text.h"
 #include "COM_ExecutionGroup.h"
 #include "COM_NodeOperation.h"
+#include "COM_ResultCache.h"
+
+#include <map>
 
 /**
  * \page execution Execution model
@@ -134,6 +137,16 @@ class ExecutionSystem {
    */
   Groups m_groups;
 
+  /**
+   * \brief ResultCache keys of the groups, 0 for groups that are not cached
+   */
+  std::map<ExecutionGroup *, ResultCache::Key> m_cacheKeys;
+
+  /**
+   * \brief memory limit of the ResultCache in bytes
+   */
+  size_t m_cacheLimit;
+
  private:  // methods
   /**
    * find all execution group with output nodes
@@ -189,6 +202,39 @@ class ExecutionSystem {
  private:
   void executeGroups(CompositorPriority priority);
 
+  /**
+   * \brief execute the groups one after another over the whole frame, in dependency order.
+   * Buffers are taken from the buffer pool right before they are written and returned to it
+   * after their last reader has executed.
+   */
+  void executeFullFrame();
+
+  /**
+   * \brief determine the ResultCache key of the group and the groups it reads from
+   */
+  ResultCache::Key determineCacheKey(ExecutionGroup *group, ResultCache::Key contextKey);
+
+  /**
+   * \brief determine the ResultCache keys of all groups that write to a buffer
+   */
+  void determineCacheKeys();
+
+  /**
+   * \brief is the result of the group available in the ResultCache
+   */
+  bool hasCachedResult(ExecutionGroup *group);
+
+  /**
+   * \brief copy the cached result into the buffer of the group and mark it executed
+   * \note the buffer of the group must be allocated
+   */
+  void restoreCachedResult(ExecutionGroup *group);
+
+  /**
+   * \brief store the result of a completely executed group in the ResultCache
+   */
+  void storeCachedResult(ExecutionGroup *group);
+
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
 
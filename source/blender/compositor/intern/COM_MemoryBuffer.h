@@ -131,6 +131,19 @@ class MemoryBuffer {
     return this->m_num_channels;
   }
 
+  DataType get_data_type()
+  {
+    return this->m_datatype;
+  }
+
+  /**
+   * \brief hand this buffer over to another MemoryProxy, used when recycling buffers
+   */
+  void setMemoryProxy(MemoryProxy *memoryProxy)
+  {
+    this->m_memoryProxy = memoryProxy;
+  }
+
   /**
    * \brief get the data of this MemoryBuffer
    * \note buffer should already be available in memory
@@ -0,0 +1,47 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include "COM_MemoryBufferPool.h"
+
+MemoryBufferPool::~MemoryBufferPool()
+{
+  for (unsigned int index = 0; index < this->m_buffers.size(); index++) {
+    delete this->m_buffers[index];
+  }
+  this->m_buffers.clear();
+}
+
+MemoryBuffer *MemoryBufferPool::acquire(MemoryProxy *memoryProxy, rcti *rect)
+{
+  for (unsigned int index = 0; index < this->m_buffers.size(); index++) {
+    MemoryBuffer *buffer = this->m_buffers[index];
+    if (buffer->get_data_type() == memoryProxy->getDataType() &&
+        BLI_rcti_compare(buffer->getRect(), rect)) {
+      this->m_buffers.erase(this->m_buffers.begin() + index);
+      buffer->setMemoryProxy(memoryProxy);
+      return buffer;
+    }
+  }
+
+  return new MemoryBuffer(memoryProxy, 1, rect);
+}
+
+void MemoryBufferPool::release(MemoryBuffer *buffer)
+{
+  this->m_buffers.push_back(buffer);
+}
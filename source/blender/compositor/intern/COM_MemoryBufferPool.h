@@ -0,0 +1,59 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+class MemoryBufferPool;
+
+#ifndef __COM_MEMORYBUFFERPOOL_H__
+#define __COM_MEMORYBUFFERPOOL_H__
+
+#include <vector>
+
+#include "COM_MemoryBuffer.h"
+
+/**
+ * \brief Keeps MemoryBuffers that are no longer needed around for reuse.
+ *
+ * Used by full frame execution, where the buffer of a MemoryProxy is only taken from the pool
+ * right before it is written and given back as soon as its last reader has executed.
+ * \ingroup Memory
+ */
+class MemoryBufferPool {
+ private:
+  std::vector<MemoryBuffer *> m_buffers;
+
+ public:
+  ~MemoryBufferPool();
+
+  /**
+   * \brief get a buffer for the memory proxy, reusing a released buffer of the same size and
+   * data type if possible.
+   * \note the content of a reused buffer is undefined.
+   */
+  MemoryBuffer *acquire(MemoryProxy *memoryProxy, rcti *rect);
+
+  /**
+   * \brief give a buffer back to the pool, so it can be reused.
+   */
+  void release(MemoryBuffer *buffer);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:MemoryBufferPool")
+#endif
+};
+
+#endif
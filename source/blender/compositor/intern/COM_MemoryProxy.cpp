@@ -17,29 +17,45 @@
  */
 
 #include "COM_MemoryProxy.h"
+#include "COM_MemoryBufferPool.h"
 
 MemoryProxy::MemoryProxy(DataType datatype)
 {
   this->m_writeBufferOperation = NULL;
   this->m_executor = NULL;
+  this->m_buffer = NULL;
+  this->m_bufferPool = NULL;
   this->m_datatype = datatype;
 }
 
 void MemoryProxy::allocate(unsigned int width, unsigned int height)
 {
-  rcti result;
-  result.xmin = 0;
-  result.xmax = width;
-  result.ymin = 0;
-  result.ymax = height;
+  this->m_rect.xmin = 0;
+  this->m_rect.xmax = width;
+  this->m_rect.ymin = 0;
+  this->m_rect.ymax = height;
 
-  this->m_buffer = new MemoryBuffer(this, 1, &result);
+  if (this->m_bufferPool == NULL) {
+    this->m_buffer = new MemoryBuffer(this, 1, &this->m_rect);
+  }
+}
+
+void MemoryProxy::acquireBuffer()
+{
+  if (this->m_buffer == NULL) {
+    this->m_buffer = this->m_bufferPool->acquire(this, &this->m_rect);
+  }
 }
 
 void MemoryProxy::free()
 {
   if (this->m_buffer) {
-    delete this->m_buffer;
+    if (this->m_bufferPool) {
+      this->m_bufferPool->release(this->m_buffer);
+    }
+    else {
+      delete this->m_buffer;
+    }
     this->m_buffer = NULL;
   }
 }
@@ -24,6 +24,7 @@ class MemoryProxy;
 #include "COM_MemoryBuffer.h"
 
 class ExecutionGroup;
+class MemoryBufferPool;
 class WriteBufferOperation;
 
 /**
@@ -64,6 +65,16 @@ class MemoryProxy {
    */
   DataType m_datatype;
 
+  /**
+   * \brief area of the buffer, stored so the buffer can be acquired later
+   */
+  rcti m_rect;
+
+  /**
+   * \brief when set, buffers are taken from and returned to this pool (full frame execution)
+   */
+  MemoryBufferPool *m_bufferPool;
+
  public:
   MemoryProxy(DataType type);
 
@@ -102,13 +113,27 @@ class MemoryProxy {
     return this->m_writeBufferOperation;
   }
 
+  /**
+   * \brief recycle buffers through the given pool instead of allocating them up front
+   */
+  void setBufferPool(MemoryBufferPool *pool)
+  {
+    this->m_bufferPool = pool;
+  }
+
   /**
    * \brief allocate memory of size width x height
+   * \note when a buffer pool is set the memory is only acquired by acquireBuffer
    */
   void allocate(unsigned int width, unsigned int height);
 
   /**
-   * \brief free the allocated memory
+   * \brief take a buffer from the buffer pool, right before the executor writes to it
+   */
+  void acquireBuffer();
+
+  /**
+   * \brief free the allocated memory, or give it back to the buffer pool
    */
   void free();
 
@@ -37,6 +37,8 @@ NodeOperation::NodeOperation()
   this->m_isResolutionSet = false;
   this->m_openCL = false;
   this->m_btree = NULL;
+  /* operations not created from a node have no settings besides their type */
+  this->m_settingsHash = 1;
 }
 
 NodeOperation::~NodeOperation()
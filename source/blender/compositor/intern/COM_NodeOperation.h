@@ -26,6 +26,7 @@
 extern "C" {
 #include "BLI_math_color.h"
 #include "BLI_math_vector.h"
+#include "BLI_sys_types.h"
 #include "BLI_threads.h"
 }
 
@@ -126,6 +127,13 @@ class NodeOperation : public SocketReader {
    */
   bool m_isResolutionSet;
 
+  /**
+   * \brief hash of the settings this operation was created with, 0 when the result can't be
+   * cached between executions.
+   * \see ResultCache
+   */
+  uint64_t m_settingsHash;
+
  public:
   virtual ~NodeOperation();
 
@@ -190,6 +198,15 @@ class NodeOperation : public SocketReader {
   {
     this->m_btree = tree;
   }
+
+  void setSettingsHash(uint64_t hash)
+  {
+    this->m_settingsHash = hash;
+  }
+  uint64_t getSettingsHash() const
+  {
+    return this->m_settingsHash;
+  }
   virtual void initExecution();
 
   /**
@@ -29,6 +29,7 @@ extern "C" {
 
 #include "COM_NodeOperation.h"
 #include "COM_PreviewOperation.h"
+#include "COM_ResultCache.h"
 #include "COM_SetValueOperation.h"
 #include "COM_SetVectorOperation.h"
 #include "COM_SetColorOperation.h"
@@ -127,6 +128,9 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
 
 void NodeOperationBuilder::addOperation(NodeOperation *operation)
 {
+  if (m_current_node) {
+    operation->setSettingsHash(ResultCache::hashNode(m_current_node->getbNode()));
+  }
   m_operations.push_back(operation);
 }
 
@@ -338,6 +342,7 @@ void NodeOperationBuilder::add_input_constant_value(NodeOperationInput *input,
 
       SetValueOperation *op = new SetValueOperation();
       op->setValue(value);
+      op->setSettingsHash(ResultCache::hashData(1, &value, sizeof(value)));
       addOperation(op);
       addLink(op->getOutputSocket(), input);
       break;
@@ -353,6 +358,7 @@ void NodeOperationBuilder::add_input_constant_value(NodeOperationInput *input,
 
       SetColorOperation *op = new SetColorOperation();
       op->setChannels(value);
+      op->setSettingsHash(ResultCache::hashData(1, value, sizeof(value)));
       addOperation(op);
       addLink(op->getOutputSocket(), input);
       break;
@@ -368,6 +374,7 @@ void NodeOperationBuilder::add_input_constant_value(NodeOperationInput *input,
 
       SetVectorOperation *op = new SetVectorOperation();
       op->setVector(value);
+      op->setSettingsHash(ResultCache::hashData(1, value, sizeof(value)));
       addOperation(op);
       addLink(op->getOutputSocket(), input);
       break;
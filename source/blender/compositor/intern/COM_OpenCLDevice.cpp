@@ -54,11 +54,22 @@ bool OpenCLDevice::initialize()
 
 void OpenCLDevice::deinitialize()
 {
+  releaseResidentBuffers();
   if (this->m_queue) {
     clReleaseCommandQueue(this->m_queue);
   }
 }
 
+void OpenCLDevice::releaseResidentBuffers()
+{
+  for (std::map<MemoryProxy *, cl_mem>::iterator it = this->m_residentBuffers.begin();
+       it != this->m_residentBuffers.end();
+       ++it) {
+    clReleaseMemObject(it->second);
+  }
+  this->m_residentBuffers.clear();
+}
+
 void OpenCLDevice::execute(WorkPackage *work)
 {
   const unsigned int chunkNumber = work->getChunkNumber();
@@ -108,6 +119,18 @@ const cl_image_format *OpenCLDevice::determineImageFormat(MemoryBuffer *memoryBu
   return imageFormat;
 }
 
+cl_mem OpenCLDevice::createImage(MemoryBuffer *memoryBuffer, cl_int *error)
+{
+  return clCreateImage2D(this->m_context,
+                         CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                         determineImageFormat(memoryBuffer),
+                         memoryBuffer->getWidth(),
+                         memoryBuffer->getHeight(),
+                         0,
+                         memoryBuffer->getBuffer(),
+                         error);
+}
+
 cl_mem OpenCLDevice::COM_clAttachMemoryBufferToKernelParameter(cl_kernel kernel,
                                                                int parameterIndex,
                                                                int offsetIndex,
@@ -116,26 +139,37 @@ cl_mem OpenCLDevice::COM_clAttachMemoryBufferToKernelParameter(cl_kernel kernel,
                                                                ReadBufferOperation *reader)
 {
   cl_int error;
-
-  MemoryBuffer *result = reader->getInputMemoryBuffer(inputMemoryBuffers);
-
-  const cl_image_format *imageFormat = determineImageFormat(result);
-
-  cl_mem clBuffer = clCreateImage2D(this->m_context,
-                                    CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                                    imageFormat,
-                                    result->getWidth(),
-                                    result->getHeight(),
-                                    0,
-                                    result->getBuffer(),
-                                    &error);
+  MemoryBuffer *result;
+  cl_mem clBuffer;
+
+  MemoryProxy *memoryProxy = reader->getMemoryProxy();
+  ExecutionGroup *executor = memoryProxy->getExecutor();
+  if (executor && executor->isExecuted()) {
+    /* The whole buffer is final, upload it once instead of the area of interest per chunk. */
+    result = memoryProxy->getBuffer();
+    std::map<MemoryProxy *, cl_mem>::iterator found = this->m_residentBuffers.find(memoryProxy);
+    if (found != this->m_residentBuffers.end()) {
+      clBuffer = found->second;
+      error = CL_SUCCESS;
+    }
+    else {
+      clBuffer = createImage(result, &error);
+      if (error == CL_SUCCESS) {
+        this->m_residentBuffers[memoryProxy] = clBuffer;
+      }
+    }
+  }
+  else {
+    result = reader->getInputMemoryBuffer(inputMemoryBuffers);
+    clBuffer = createImage(result, &error);
+    if (error == CL_SUCCESS) {
+      cleanup->push_back(clBuffer);
+    }
+  }
 
   if (error != CL_SUCCESS) {
     printf("CLERROR[%d]: %s\n", error, clewErrorString(error));
   }
-  if (error == CL_SUCCESS) {
-    cleanup->push_back(clBuffer);
-  }
 
   error = clSetKernelArg(kernel, parameterIndex, sizeof(cl_mem), &clBuffer);
   if (error != CL_SUCCESS) {
@@ -26,6 +26,8 @@ class OpenCLDevice;
 #include "COM_WorkScheduler.h"
 #include "COM_ReadBufferOperation.h"
 
+#include <map>
+
 using std::list;
 
 /**
@@ -59,6 +61,14 @@ class OpenCLDevice : public Device {
    */
   cl_int m_vendorID;
 
+  /**
+   * \brief images of completely executed buffers, kept on the device so chunks and operations
+   * reading the same buffer upload it only once per execution.
+   */
+  std::map<MemoryProxy *, cl_mem> m_residentBuffers;
+
+  cl_mem createImage(MemoryBuffer *memoryBuffer, cl_int *error);
+
  public:
   /**
    * \brief constructor with opencl device
@@ -83,6 +93,11 @@ class OpenCLDevice : public Device {
    */
   void deinitialize();
 
+  /**
+   * \brief free the images kept on the device, called when an execution has finished
+   */
+  void releaseResidentBuffers();
+
   /**
    * \brief execute a WorkPackage
    * \param work: the WorkPackage to execute
@@ -0,0 +1,186 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include <list>
+#include <map>
+#include <string.h>
+
+#include "COM_ResultCache.h"
+
+extern "C" {
+#include "BLI_hash_mm2a.h"
+#include "BLI_listbase.h"
+#include "BKE_node.h"
+#include "DNA_color_types.h"
+#include "DNA_image_types.h"
+#include "DNA_node_types.h"
+}
+
+#include "MEM_guardedalloc.h"
+
+typedef std::pair<ResultCache::Key, MemoryBuffer *> CacheEntry;
+typedef std::list<CacheEntry> CacheEntries;
+
+/* Most recently used entries are at the front. */
+static CacheEntries g_entries;
+static std::map<ResultCache::Key, CacheEntries::iterator> g_lookup;
+static size_t g_size = 0;
+
+static size_t buffer_size(MemoryBuffer *buffer)
+{
+  return sizeof(float) * buffer->getWidth() * buffer->getHeight() * buffer->get_num_channels();
+}
+
+ResultCache::Key ResultCache::hashData(Key key, const void *data, size_t size)
+{
+  /* Two 32 bit hashes with different seeds, to make collisions unlikely. */
+  const uint32_t low = BLI_hash_mm2((const unsigned char *)data, size, (uint32_t)key);
+  const uint32_t high = BLI_hash_mm2(
+      (const unsigned char *)data, size, (uint32_t)(key >> 32) ^ 0x9e3779b9);
+  return ((Key)high << 32) | low;
+}
+
+static ResultCache::Key hash_string(ResultCache::Key key, const char *str)
+{
+  return ResultCache::hashData(key, str, strlen(str));
+}
+
+static ResultCache::Key hash_curve_mapping(ResultCache::Key key, const CurveMapping *cumap)
+{
+  /* Hash the points, not the pointers to them, they are edited in place. */
+  CurveMapping copy = *cumap;
+  for (int i = 0; i < CM_TOT; i++) {
+    copy.cm[i].curve = NULL;
+    copy.cm[i].table = NULL;
+    copy.cm[i].premultable = NULL;
+    if (cumap->cm[i].curve) {
+      key = ResultCache::hashData(
+          key, cumap->cm[i].curve, sizeof(CurveMapPoint) * cumap->cm[i].totpoint);
+    }
+  }
+  return ResultCache::hashData(key, &copy, sizeof(copy));
+}
+
+static bool node_id_is_cacheable(const bNode *node)
+{
+  switch (node->type) {
+    case CMP_NODE_IMAGE: {
+      /* Render result and viewer images change on every execution. */
+      const Image *image = (const Image *)node->id;
+      return ELEM(image->type, IMA_TYPE_IMAGE, IMA_TYPE_MULTILAYER);
+    }
+    case CMP_NODE_R_LAYERS:
+    case CMP_NODE_MOVIECLIP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+ResultCache::Key ResultCache::hashNode(const bNode *node)
+{
+  if (node->id && !node_id_is_cacheable(node)) {
+    return 0;
+  }
+
+  Key key = hashData(0, &node->type, sizeof(node->type));
+  key = hashData(key, &node->custom1, sizeof(node->custom1));
+  key = hashData(key, &node->custom2, sizeof(node->custom2));
+  key = hashData(key, &node->custom3, sizeof(node->custom3));
+  key = hashData(key, &node->custom4, sizeof(node->custom4));
+  key = hashData(key, &node->id, sizeof(node->id));
+  const short muted = node->flag & NODE_MUTED;
+  key = hashData(key, &muted, sizeof(muted));
+
+  if (node->storage) {
+    const char *storagename = node->typeinfo->storagename;
+    if (STREQ(storagename, "CurveMapping")) {
+      key = hash_curve_mapping(key, (const CurveMapping *)node->storage);
+    }
+    else {
+      key = hashData(key, node->storage, MEM_allocN_len(node->storage));
+      if (STREQ(storagename, "NodeCryptomatte")) {
+        const NodeCryptomatte *crypto = (const NodeCryptomatte *)node->storage;
+        if (crypto->matte_id) {
+          key = hash_string(key, crypto->matte_id);
+        }
+      }
+    }
+  }
+
+  LISTBASE_FOREACH (const bNodeSocket *, sock, &node->inputs) {
+    if (sock->default_value) {
+      key = hashData(key, sock->default_value, MEM_allocN_len(sock->default_value));
+    }
+    if (sock->link) {
+      key = hash_string(key, sock->link->fromnode->name);
+      key = hash_string(key, sock->link->fromsock->identifier);
+    }
+  }
+
+  /* 0 is reserved for results that can't be cached. */
+  return key ? key : 1;
+}
+
+MemoryBuffer *ResultCache::find(Key key, DataType datatype, rcti *rect)
+{
+  std::map<Key, CacheEntries::iterator>::iterator found = g_lookup.find(key);
+  if (found == g_lookup.end()) {
+    return NULL;
+  }
+
+  MemoryBuffer *buffer = found->second->second;
+  if (buffer->get_data_type() != datatype || !BLI_rcti_compare(buffer->getRect(), rect)) {
+    return NULL;
+  }
+
+  g_entries.splice(g_entries.begin(), g_entries, found->second);
+  return buffer;
+}
+
+void ResultCache::store(Key key, MemoryBuffer *buffer, size_t limit)
+{
+  const size_t size = buffer_size(buffer);
+  if (size > limit || g_lookup.find(key) != g_lookup.end()) {
+    return;
+  }
+
+  while (g_size + size > limit) {
+    MemoryBuffer *oldest = g_entries.back().second;
+    g_size -= buffer_size(oldest);
+    g_lookup.erase(g_entries.back().first);
+    g_entries.pop_back();
+    delete oldest;
+  }
+
+  MemoryBuffer *copy = new MemoryBuffer(buffer->get_data_type(), buffer->getRect());
+  copy->copyContentFrom(buffer);
+  g_entries.push_front(CacheEntry(key, copy));
+  g_lookup[key] = g_entries.begin();
+  g_size += size;
+}
+
+void ResultCache::clear()
+{
+  for (CacheEntries::iterator it = g_entries.begin(); it != g_entries.end(); ++it) {
+    delete it->second;
+  }
+  g_entries.clear();
+  g_lookup.clear();
+  g_size = 0;
+}
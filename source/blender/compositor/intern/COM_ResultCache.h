@@ -0,0 +1,71 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#ifndef __COM_RESULTCACHE_H__
+#define __COM_RESULTCACHE_H__
+
+#include "BLI_sys_types.h"
+
+#include "COM_MemoryBuffer.h"
+
+struct bNode;
+
+/**
+ * \brief Keeps results of execution groups between compositor executions.
+ *
+ * Results are keyed by a hash of everything the group result depends on: the settings of the
+ * nodes the operations were created from, the structure of the group and the keys of the groups
+ * it reads from. A key of 0 means the result can't be cached. Least recently used results are
+ * removed when the memory limit is exceeded.
+ *
+ * \note all access happens while the compositor mutex is held, see COM_execute.
+ * \ingroup Execution
+ */
+class ResultCache {
+ public:
+  typedef uint64_t Key;
+
+  /**
+   * \brief combine data into an existing key
+   */
+  static Key hashData(Key key, const void *data, size_t size);
+
+  /**
+   * \brief hash the settings of a node, its input values and the origin of its input links.
+   * Returns 0 for nodes using data that can change without the node changing, like masks or
+   * textures.
+   */
+  static Key hashNode(const bNode *node);
+
+  /**
+   * \brief find a cached result with the given key, size and data type.
+   */
+  static MemoryBuffer *find(Key key, DataType datatype, rcti *rect);
+
+  /**
+   * \brief store a copy of the buffer, removing older results to stay within the limit.
+   */
+  static void store(Key key, MemoryBuffer *buffer, size_t limit);
+
+  /**
+   * \brief free all cached results.
+   */
+  static void clear();
+};
+
+#endif /* __COM_RESULTCACHE_H__ */
@@ -94,6 +94,23 @@ class SocketReader {
   {
   }
 
+  /**
+   * \brief calculate a span of pixels of a single row
+   * \note this method is called for non-complex, with at most COM_ROW_SPAN pixels.
+   * The default implementation calls executePixelSampled for every pixel, operations on the
+   * hot path override it to avoid the per pixel virtual calls and to use SIMD.
+   * \param output: is a float[width * 4] array to store the result, 4 floats per pixel
+   * \param x: the x-coordinate of the first pixel to calculate in image space
+   * \param y: the y-coordinate of the row to calculate in image space
+   * \param width: the number of pixels to calculate
+   */
+  virtual void executeRow(float *output, int x, int y, int width)
+  {
+    for (int i = 0; i < width; i++) {
+      executePixelSampled(&output[i * 4], x + i, y, COM_PS_NEAREST);
+    }
+  }
+
  public:
   inline void readSampled(float result[4], float x, float y, PixelSampler sampler)
   {
@@ -107,6 +124,10 @@ class SocketReader {
   {
     executePixelFiltered(result, x, y, dx, dy);
   }
+  inline void readRow(float *result, int x, int y, int width)
+  {
+    executeRow(result, x, y, width);
+  }
 
   virtual void *initializeTileData(rcti * /*rect*/)
   {
@@ -175,6 +175,9 @@ void WorkScheduler::stop()
     BLI_threadpool_end(&g_gputhreads);
     BLI_thread_queue_free(g_gpuqueue);
     g_gpuqueue = NULL;
+    for (unsigned int index = 0; index < g_gpudevices.size(); index++) {
+      g_gpudevices[index]->releaseResidentBuffers();
+    }
   }
 #  endif
 #endif
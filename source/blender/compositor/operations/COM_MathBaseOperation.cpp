@@ -72,6 +72,27 @@ void MathBaseOperation::clampIfNeeded(float *color)
   }
 }
 
+void MathBaseOperation::readInputRows(float *value1, float *value2, int x, int y, int width)
+{
+  this->m_inputValue1Operation->readRow(value1, x, y, width);
+  this->m_inputValue2Operation->readRow(value2, x, y, width);
+
+  /* Pack the values, reading ahead of the write index so this can be done in place. */
+  for (int i = 0; i < width; i++) {
+    value1[i] = value1[i * 4];
+    value2[i] = value2[i * 4];
+  }
+}
+
+void MathBaseOperation::clampRowIfNeeded(float *output, int width)
+{
+  if (this->m_useClamp) {
+    for (int i = 0; i < width; i++) {
+      CLAMP(output[i * 4], 0.0f, 1.0f);
+    }
+  }
+}
+
 void MathAddOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
 {
   float inputValue1[4];
@@ -85,6 +106,19 @@ void MathAddOperation::executePixelSampled(float output[4], float x, float y, Pi
   clampIfNeeded(output);
 }
 
+void MathAddOperation::executeRow(float *output, int x, int y, int width)
+{
+  float inputValue1[COM_ROW_SPAN * 4];
+  float inputValue2[COM_ROW_SPAN * 4];
+  this->readInputRows(inputValue1, inputValue2, x, y, width);
+
+  for (int i = 0; i < width; i++) {
+    output[i * 4] = inputValue1[i] + inputValue2[i];
+  }
+
+  clampRowIfNeeded(output, width);
+}
+
 void MathSubtractOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -101,6 +135,19 @@ void MathSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathSubtractOperation::executeRow(float *output, int x, int y, int width)
+{
+  float inputValue1[COM_ROW_SPAN * 4];
+  float inputValue2[COM_ROW_SPAN * 4];
+  this->readInputRows(inputValue1, inputValue2, x, y, width);
+
+  for (int i = 0; i < width; i++) {
+    output[i * 4] = inputValue1[i] - inputValue2[i];
+  }
+
+  clampRowIfNeeded(output, width);
+}
+
 void MathMultiplyOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -117,6 +164,19 @@ void MathMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathMultiplyOperation::executeRow(float *output, int x, int y, int width)
+{
+  float inputValue1[COM_ROW_SPAN * 4];
+  float inputValue2[COM_ROW_SPAN * 4];
+  this->readInputRows(inputValue1, inputValue2, x, y, width);
+
+  for (int i = 0; i < width; i++) {
+    output[i * 4] = inputValue1[i] * inputValue2[i];
+  }
+
+  clampRowIfNeeded(output, width);
+}
+
 void MathDivideOperation::executePixelSampled(float output[4],
                                               float x,
                                               float y,
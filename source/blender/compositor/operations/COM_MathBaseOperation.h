@@ -43,6 +43,16 @@ class MathBaseOperation : public NodeOperation {
 
   void clampIfNeeded(float color[4]);
 
+  /**
+   * Read a row of the first two inputs for executeRow, one float per pixel.
+   */
+  void readInputRows(float *value1, float *value2, int x, int y, int width);
+
+  /**
+   * Clamp a row calculated by executeRow if needed.
+   */
+  void clampRowIfNeeded(float *output, int width);
+
  public:
   /**
    * the inner loop of this program
@@ -76,6 +86,7 @@ class MathAddOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width);
 };
 class MathSubtractOperation : public MathBaseOperation {
  public:
@@ -83,6 +94,7 @@ class MathSubtractOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width);
 };
 class MathMultiplyOperation : public MathBaseOperation {
  public:
@@ -90,6 +102,7 @@ class MathMultiplyOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width);
 };
 class MathDivideOperation : public MathBaseOperation {
  public:
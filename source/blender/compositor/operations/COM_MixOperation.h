@@ -43,6 +43,12 @@ class MixBaseOperation : public NodeOperation {
     }
   }
 
+  /**
+   * Read a row of all inputs for executeRow. The mix factors are stored one float per pixel,
+   * with the alpha of the second color already applied when useValueAlphaMultiply is set.
+   */
+  void readInputRows(float *value, float *color1, float *color2, int x, int y, int width);
+
  public:
   /**
    * Default constructor
@@ -84,12 +90,14 @@ class MixAddOperation : public MixBaseOperation {
  public:
   MixAddOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width);
 };
 
 class MixBlendOperation : public MixBaseOperation {
  public:
   MixBlendOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width);
 };
 
 class MixColorBurnOperation : public MixBaseOperation {
@@ -156,6 +164,7 @@ class MixMultiplyOperation : public MixBaseOperation {
  public:
   MixMultiplyOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width);
 };
 
 class MixOverlayOperation : public MixBaseOperation {
@@ -186,6 +195,7 @@ class MixSubtractOperation : public MixBaseOperation {
  public:
   MixSubtractOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width);
 };
 
 class MixValueOperation : public MixBaseOperation {
@@ -74,6 +74,22 @@ void ReadBufferOperation::executePixelSampled(float output[4],
   }
 }
 
+void ReadBufferOperation::executeRow(float *output, int x, int y, int width)
+{
+  if (m_single_value) {
+    float value[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    m_buffer->read(value, 0, 0);
+    for (int i = 0; i < width; i++) {
+      copy_v4_v4(&output[i * 4], value);
+    }
+  }
+  else {
+    for (int i = 0; i < width; i++) {
+      m_buffer->read(&output[i * 4], x + i, y);
+    }
+  }
+}
+
 void ReadBufferOperation::executePixelExtend(float output[4],
                                              float x,
                                              float y,
@@ -47,6 +47,18 @@ void SetAlphaOperation::executePixelSampled(float output[4],
   output[3] = alphaInput[0];
 }
 
+void SetAlphaOperation::executeRow(float *output, int x, int y, int width)
+{
+  float alphaInput[COM_ROW_SPAN * 4];
+
+  this->m_inputColor->readRow(output, x, y, width);
+  this->m_inputAlpha->readRow(alphaInput, x, y, width);
+
+  for (int i = 0; i < width; i++) {
+    output[i * 4 + 3] = alphaInput[i * 4];
+  }
+}
+
 void SetAlphaOperation::deinitExecution()
 {
   this->m_inputColor = NULL;
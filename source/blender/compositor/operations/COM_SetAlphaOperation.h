@@ -39,6 +39,7 @@ class SetAlphaOperation : public NodeOperation {
    * the inner loop of this program
    */
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width);
 
   void initExecution();
   void deinitExecution();
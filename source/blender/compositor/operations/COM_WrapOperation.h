@@ -31,6 +31,11 @@ class WrapOperation : public ReadBufferOperation {
                                         ReadBufferOperation *readOperation,
                                         rcti *output);
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width)
+  {
+    /* wrapping is done per pixel, skip the row copy of ReadBufferOperation */
+    SocketReader::executeRow(output, x, y, width);
+  }
 
   void setWrapping(int wrapping_type);
   float getWrappedOriginalXPos(float x);
@@ -94,11 +94,22 @@ void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/
     int x;
     int y;
     bool breaked = false;
+    float row[COM_ROW_SPAN * 4];
     for (y = y1; y < y2 && (!breaked); y++) {
       int offset4 = (y * memoryBuffer->getWidth() + x1) * num_channels;
-      for (x = x1; x < x2; x++) {
-        this->m_input->readSampled(&(buffer[offset4]), x, y, COM_PS_NEAREST);
-        offset4 += num_channels;
+      for (x = x1; x < x2; x += COM_ROW_SPAN) {
+        const int width = min(x2 - x, COM_ROW_SPAN);
+        if (num_channels == 4) {
+          this->m_input->readRow(&(buffer[offset4]), x, y, width);
+          offset4 += width * 4;
+        }
+        else {
+          this->m_input->readRow(row, x, y, width);
+          for (int i = 0; i < width; i++) {
+            memcpy(&(buffer[offset4]), &row[i * 4], sizeof(float) * num_channels);
+            offset4 += num_channels;
+          }
+        }
       }
       if (isBraked()) {
         breaked = true;
@@ -63,6 +63,15 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Profiling */
+
+/* Write timing of every evaluated operation of all dependency graphs to the given file, in the
+ * Chrome trace event format. Profiling stops on DEG_profile_end() or on exit. */
+void DEG_profile_begin(const char *filepath);
+bool DEG_profile_is_enabled(void);
+void DEG_profile_end(void);
+
 /* ************************************************ */
 
 /* Compare two dependency graphs. */
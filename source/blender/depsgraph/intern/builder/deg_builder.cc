@@ -34,6 +34,7 @@
 #include "BLI_utildefines.h"
 #include "BLI_ghash.h"
 #include "BLI_stack.h"
+#include "BLI_task.h"
 
 #include "BKE_action.h"
 
@@ -207,6 +208,26 @@ void deg_graph_build_flush_visibility(Depsgraph *graph)
   BLI_stack_free(stack);
 }
 
+void deg_graph_build_finalize_id_node_func(void *__restrict data_v,
+                                           const int i,
+                                           const TaskParallelTLS *__restrict /*tls*/)
+{
+  Depsgraph *graph = (Depsgraph *)data_v;
+  IDNode *id_node = graph->id_nodes[i];
+  /* Only touches components and operations owned by this ID node. */
+  id_node->finalize_build(graph);
+}
+
+void deg_graph_build_finalize_id_nodes(Depsgraph *graph)
+{
+  const int num_id_nodes = graph->id_nodes.size();
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(
+      0, num_id_nodes, graph, deg_graph_build_finalize_id_node_func, &settings);
+}
+
 }  // namespace
 
 void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
@@ -214,12 +235,12 @@ void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
   /* Make sure dependencies of visible ID datablocks are visible. */
   deg_graph_build_flush_visibility(graph);
   deg_graph_remove_unused_noops(graph);
+  deg_graph_build_finalize_id_nodes(graph);
 
   /* Re-tag IDs for update if it was tagged before the relations
    * update tag. */
   for (IDNode *id_node : graph->id_nodes) {
     ID *id_orig = id_node->id_orig;
-    id_node->finalize_build(graph);
     int flag = 0;
     /* Tag rebuild if special evaluation flags changed. */
     if (id_node->eval_flags != id_node->previous_eval_flags) {
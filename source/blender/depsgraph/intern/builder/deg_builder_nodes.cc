@@ -164,6 +164,11 @@ IDNode *DepsgraphNodeBuilder::add_id_node(ID *id)
   uint32_t previous_eval_flags = 0;
   DEGCustomDataMeshMasks previous_customdata_masks;
   IDInfo *id_info = (IDInfo *)BLI_ghash_lookup(id_info_hash_, id);
+  /* Original IDs can be freed and re-allocated at the same address without the dependency graph
+   * being notified (e.g. by undo), never give a copy of another data-block to the new one. */
+  if (id_info != nullptr && id_info->id_orig_session_uuid != id->session_uuid) {
+    id_info = nullptr;
+  }
   if (id_info != nullptr) {
     id_cow = id_info->id_cow;
     previously_visible_components_mask = id_info->previously_visible_components_mask;
@@ -326,6 +331,7 @@ void DepsgraphNodeBuilder::begin_build()
     else {
       id_info->id_cow = nullptr;
     }
+    id_info->id_orig_session_uuid = id_node->id_orig_session_uuid;
     id_info->previously_visible_components_mask = id_node->visible_components_mask;
     id_info->previous_eval_flags = id_node->eval_flags;
     id_info->previous_customdata_masks = id_node->customdata_masks;
@@ -926,12 +932,17 @@ void DepsgraphNodeBuilder::build_driver(ID *id, FCurve *fcurve, int driver_index
    * has not yet been allocated at this point we can't. As a workaround
    * the animation systems allocates an array so we can do a fast lookup
    * with the driver index. */
-  ensure_operation_node(id,
-                        NodeType::PARAMETERS,
-                        OperationCode::DRIVER,
-                        function_bind(BKE_animsys_eval_driver, _1, id_cow, driver_index, fcurve),
-                        fcurve->rna_path ? fcurve->rna_path : "",
-                        fcurve->array_index);
+  OperationNode *driver_node = ensure_operation_node(
+      id,
+      NodeType::PARAMETERS,
+      OperationCode::DRIVER,
+      function_bind(BKE_animsys_eval_driver, _1, id_cow, driver_index, fcurve),
+      fcurve->rna_path ? fcurve->rna_path : "",
+      fcurve->array_index);
+  ChannelDriver *driver = fcurve->driver;
+  if (driver->type == DRIVER_TYPE_PYTHON && !BKE_driver_has_simple_expression(driver)) {
+    driver_node->flag |= DEPSOP_FLAG_NEEDS_PYTHON;
+  }
   build_driver_variables(id, fcurve);
 }
 
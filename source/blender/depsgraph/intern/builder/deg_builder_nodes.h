@@ -225,6 +225,8 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   struct IDInfo {
     /* Copy-on-written pointer of the corresponding ID. */
     ID *id_cow;
+    /* Session UUID of the original ID the copy-on-written one was made from. */
+    uint32_t id_orig_session_uuid;
     /* Mask of visible components from previous state of the
      * dependency graph. */
     IDComponentsMask previously_visible_components_mask;
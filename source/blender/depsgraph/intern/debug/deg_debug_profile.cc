@@ -0,0 +1,220 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/debug/deg_debug_profile.h"
+
+#include <cstdio>
+
+#include "MEM_guardedalloc.h"
+
+#include "PIL_time.h"
+
+#include "BLI_utildefines.h"
+#include "BLI_dynstr.h"
+#include "BLI_fileops.h"
+#include "BLI_threads.h"
+
+#include "DEG_depsgraph_debug.h"
+
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace DEG {
+
+namespace {
+
+struct DepsgraphProfile {
+  FILE *file = nullptr;
+  /* Time at which profiling started, all the event times are relative to it. */
+  double start_time = 0.0;
+  bool is_first_event = true;
+  /* Every dependency graph gets its own "process" in the trace, so the view port and render
+   * graphs are not mixed together. */
+  unordered_map<const Depsgraph *, int> graph_pids;
+  ThreadMutex mutex = BLI_MUTEX_INITIALIZER;
+};
+
+DepsgraphProfile profile;
+
+void profile_escape_append(DynStr *ds, const string &str)
+{
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      BLI_dynstr_appendf(ds, "\\%c", c);
+    }
+    else if ((unsigned char)c < 0x20) {
+      BLI_dynstr_appendf(ds, "\\u%04x", (unsigned char)c);
+    }
+    else {
+      BLI_dynstr_nappend(ds, &c, 1);
+    }
+  }
+}
+
+void profile_event_begin(DynStr *ds)
+{
+  if (profile.is_first_event) {
+    profile.is_first_event = false;
+    BLI_dynstr_append(ds, "\n");
+  }
+  else {
+    BLI_dynstr_append(ds, ",\n");
+  }
+}
+
+int profile_graph_pid_ensure(DynStr *ds, const Depsgraph *graph)
+{
+  unordered_map<const Depsgraph *, int>::const_iterator it = profile.graph_pids.find(graph);
+  if (it != profile.graph_pids.end()) {
+    return it->second;
+  }
+  const int pid = profile.graph_pids.size() + 1;
+  profile.graph_pids[graph] = pid;
+  profile_event_begin(ds);
+  BLI_dynstr_appendf(
+      ds, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"", pid);
+  profile_escape_append(ds, graph->debug.name.empty() ? "Depsgraph" : graph->debug.name);
+  BLI_dynstr_append(ds, "\"}}");
+  return pid;
+}
+
+/* Time in microseconds since the beginning of profiling. */
+double profile_time_us(double time)
+{
+  return (time - profile.start_time) * 1e6;
+}
+
+}  // namespace
+
+bool deg_profile_is_enabled()
+{
+  return profile.file != nullptr;
+}
+
+void deg_profile_write_evaluation(const Depsgraph *graph,
+                                  double evaluation_start_time,
+                                  double evaluation_end_time,
+                                  const ProfileEvent *events,
+                                  int num_events)
+{
+  /* Operations finished evaluation before their children started, so the time an operation was
+   * waiting for is known by the time it is visited. Parents which were not evaluated (up to date
+   * or not visible) did not delay anything, use the evaluation start for them. */
+  unordered_map<const OperationNode *, double> end_times;
+  end_times.reserve(num_events);
+  DynStr *ds = BLI_dynstr_new();
+
+  BLI_mutex_lock(&profile.mutex);
+  if (profile.file == nullptr) {
+    BLI_mutex_unlock(&profile.mutex);
+    BLI_dynstr_free(ds);
+    return;
+  }
+  const int pid = profile_graph_pid_ensure(ds, graph);
+  profile_event_begin(ds);
+  BLI_dynstr_appendf(ds,
+                     "{\"name\":\"Evaluation\",\"cat\":\"depsgraph\",\"ph\":\"X\","
+                     "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":0,"
+                     "\"args\":{\"operations\":%d}}",
+                     profile_time_us(evaluation_start_time),
+                     (evaluation_end_time - evaluation_start_time) * 1e6,
+                     pid,
+                     num_events);
+
+  for (int i = 0; i < num_events; i++) {
+    const ProfileEvent &event = events[i];
+    const OperationNode *node = event.node;
+    double ready_time = evaluation_start_time;
+    for (const Relation *rel : node->inlinks) {
+      if (rel->from->type != NodeType::OPERATION || (rel->flag & RELATION_FLAG_CYCLIC)) {
+        continue;
+      }
+      unordered_map<const OperationNode *, double>::const_iterator it = end_times.find(
+          (const OperationNode *)rel->from);
+      if (it != end_times.end()) {
+        ready_time = max(ready_time, it->second);
+      }
+    }
+    end_times[node] = event.end_time;
+    /* NOOP operations are only needed to know when their children became ready. */
+    if (node->is_noop()) {
+      continue;
+    }
+    profile_event_begin(ds);
+    BLI_dynstr_append(ds, "{\"name\":\"");
+    profile_escape_append(ds, node->full_identifier());
+    BLI_dynstr_appendf(ds,
+                       "\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                       "\"pid\":%d,\"tid\":%d,\"args\":{\"wait_ms\":%.3f}}",
+                       nodeTypeAsString(node->owner->type),
+                       profile_time_us(event.start_time),
+                       (event.end_time - event.start_time) * 1e6,
+                       pid,
+                       event.thread_id,
+                       max(event.start_time - ready_time, 0.0) * 1e3);
+  }
+
+  char *str = BLI_dynstr_get_cstring(ds);
+  fputs(str, profile.file);
+  BLI_mutex_unlock(&profile.mutex);
+
+  MEM_freeN(str);
+  BLI_dynstr_free(ds);
+}
+
+}  // namespace DEG
+
+void DEG_profile_begin(const char *filepath)
+{
+  DEG_profile_end();
+  FILE *file = BLI_fopen(filepath, "w");
+  if (file == nullptr) {
+    fprintf(stderr, "Failed to open depsgraph profile file '%s'\n", filepath);
+    return;
+  }
+  BLI_mutex_lock(&DEG::profile.mutex);
+  fputs("[", file);
+  DEG::profile.file = file;
+  DEG::profile.start_time = PIL_check_seconds_timer();
+  DEG::profile.is_first_event = true;
+  BLI_mutex_unlock(&DEG::profile.mutex);
+}
+
+bool DEG_profile_is_enabled(void)
+{
+  return DEG::deg_profile_is_enabled();
+}
+
+void DEG_profile_end(void)
+{
+  BLI_mutex_lock(&DEG::profile.mutex);
+  if (DEG::profile.file != nullptr) {
+    fputs("\n]\n", DEG::profile.file);
+    fclose(DEG::profile.file);
+    DEG::profile.file = nullptr;
+  }
+  DEG::profile.graph_pids.clear();
+  BLI_mutex_unlock(&DEG::profile.mutex);
+}
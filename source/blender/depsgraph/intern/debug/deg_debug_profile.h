@@ -0,0 +1,55 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Profiler of the depsgraph evaluation, which writes timing of every evaluated operation to a
+ * file in the Chrome trace event format (can be opened in chrome://tracing or Perfetto).
+ */
+
+#pragma once
+
+#include "intern/depsgraph_type.h"
+
+namespace DEG {
+
+struct Depsgraph;
+class OperationNode;
+
+/* Evaluation of a single operation, as recorded during the graph evaluation. */
+struct ProfileEvent {
+  const OperationNode *node;
+  double start_time;
+  double end_time;
+  int thread_id;
+};
+
+/* Cheap check whether events are to be recorded, can be called from any thread. */
+bool deg_profile_is_enabled();
+
+/* Write events of a single graph evaluation to the profile file.
+ * Events are expected to be in the order operations finished their evaluation. */
+void deg_profile_write_evaluation(const Depsgraph *graph,
+                                  double evaluation_start_time,
+                                  double evaluation_end_time,
+                                  const ProfileEvent *events,
+                                  int num_events);
+
+}  // namespace DEG
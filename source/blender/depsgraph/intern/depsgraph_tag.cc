@@ -656,6 +656,8 @@ void graph_id_tag_update(
    * changes). */
   if (update_source == DEG_UPDATE_SOURCE_USER_EDIT) {
     id->recalc |= deg_recalc_flags_effective(graph, flag);
+    /* Global undo only keeps data-blocks which were not modified since the last undo push. */
+    id->tag |= LIB_TAG_UNDO_CHANGED;
   }
   int current_flag = flag;
   while (current_flag != 0) {
@@ -25,6 +25,10 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+
+#include "MEM_guardedalloc.h"
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
@@ -32,6 +36,7 @@
 #include "BLI_task.h"
 #include "BLI_ghash.h"
 #include "BLI_gsqueue.h"
+#include "BLI_threads.h"
 
 #include "BKE_global.h"
 
@@ -43,6 +48,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_profile.h"
 #include "intern/eval/deg_eval_copy_on_write.h"
 #include "intern/eval/deg_eval_flush.h"
 #include "intern/eval/deg_eval_stats.h"
@@ -75,6 +81,37 @@ void schedule_node_to_pool(OperationNode *node, const int thread_id, TaskPool *p
       pool, deg_task_run_func, node, false, TASK_PRIORITY_HIGH, thread_id);
 }
 
+/* Operations which became ready for evaluation at the same time. */
+typedef vector<OperationNode *> ReadyOperations;
+
+void schedule_node_to_ready_operations(OperationNode *node,
+                                       const int /*thread_id*/,
+                                       ReadyOperations *ready_operations)
+{
+  ready_operations->push_back(node);
+}
+
+/* Push operations which became ready at the same time, the ones with the longest
+ * chain of dependent operations (as measured in the previous evaluation) are picked up first.
+ * Otherwise long chains (rig, deform, subdivision of a character) might start late, while cheap
+ * operations are keeping all the threads busy. */
+void schedule_ready_operations_to_pool(ReadyOperations *ready_operations,
+                                       const int thread_id,
+                                       TaskPool *pool)
+{
+  /* Tasks get pushed to the head of the queue, so the last pushed one runs first.
+   * Stable sort keeps the order of the graph for operations without timing yet. */
+  std::stable_sort(ready_operations->begin(),
+                   ready_operations->end(),
+                   [](const OperationNode *a, const OperationNode *b) {
+                     return a->critical_path_time < b->critical_path_time;
+                   });
+  for (OperationNode *node : *ready_operations) {
+    schedule_node_to_pool(node, thread_id, pool);
+  }
+  ready_operations->clear();
+}
+
 /* Denotes which part of dependency graph is being evaluated. */
 enum class EvaluationStage {
   /* Stage 1: Only  Copy-on-Write operations are to be evaluated, prior to anything else.
@@ -97,22 +134,107 @@ struct DepsgraphEvalState {
   bool do_stats;
   EvaluationStage stage;
   bool need_single_thread_pass;
+  /* Operations in the order they finished evaluating, used to estimate critical paths. */
+  OperationNode **evaluated_nodes;
+  int num_evaluated_nodes;
+  /* Timing of evaluated operations, matching evaluated_nodes. Only allocated when profiling. */
+  ProfileEvent *profile_events;
+  /* Operations which need Python. They are evaluated one after another by whichever worker
+   * holds the Python lane, instead of having every worker block on the GIL. */
+  vector<OperationNode *> python_queue;
+  ThreadMutex python_queue_mutex;
+  int python_lane_busy;
 };
 
-void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
+void evaluate_node_finished(DepsgraphEvalState *state,
+                            OperationNode *operation_node,
+                            const int thread_id,
+                            const double start_time,
+                            const double end_time)
+{
+  const int index = atomic_fetch_and_add_int32(&state->num_evaluated_nodes, 1);
+  state->evaluated_nodes[index] = operation_node;
+  if (state->profile_events != nullptr) {
+    ProfileEvent &event = state->profile_events[index];
+    event.node = operation_node;
+    event.start_time = start_time;
+    event.end_time = end_time;
+    /* Nodes scheduled from outside of the pool are handled by the main thread. */
+    event.thread_id = max(thread_id, 0);
+  }
+}
+
+void evaluate_node(DepsgraphEvalState *state, OperationNode *operation_node, const int thread_id)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
 
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
-  if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+  /* Perform operation. Timing is always measured, it is used for the scheduling of the next
+   * evaluation too. */
+  const double start_time = PIL_check_seconds_timer();
+  operation_node->evaluate(depsgraph);
+  const double end_time = PIL_check_seconds_timer();
+  operation_node->stats.current_time += end_time - start_time;
+
+  evaluate_node_finished(state, operation_node, thread_id, start_time, end_time);
+}
+
+void evaluate_node_and_schedule_children(DepsgraphEvalState *state,
+                                         OperationNode *operation_node,
+                                         const int thread_id,
+                                         TaskPool *pool)
+{
+  /* Evaluate node. */
+  evaluate_node(state, operation_node, thread_id);
+
+  /* Schedule children. */
+  ReadyOperations ready_operations;
+  schedule_children(
+      state, operation_node, thread_id, schedule_node_to_ready_operations, &ready_operations);
+  BLI_task_pool_delayed_push_begin(pool, thread_id);
+  schedule_ready_operations_to_pool(&ready_operations, thread_id, pool);
+  BLI_task_pool_delayed_push_end(pool, thread_id);
+}
+
+OperationNode *python_queue_pop(DepsgraphEvalState *state)
+{
+  OperationNode *operation_node = nullptr;
+  BLI_mutex_lock(&state->python_queue_mutex);
+  if (!state->python_queue.empty()) {
+    operation_node = state->python_queue.back();
+    state->python_queue.pop_back();
   }
-  else {
-    operation_node->evaluate(depsgraph);
+  BLI_mutex_unlock(&state->python_queue_mutex);
+  return operation_node;
+}
+
+/* Queue an operation which needs Python, and evaluate queued operations if no other worker is
+ * doing so already. Otherwise the worker returns to the pool right away, instead of waiting for
+ * the GIL while other operations are ready to be evaluated. */
+void evaluate_python_node(DepsgraphEvalState *state,
+                          OperationNode *operation_node,
+                          const int thread_id,
+                          TaskPool *pool)
+{
+  BLI_mutex_lock(&state->python_queue_mutex);
+  state->python_queue.push_back(operation_node);
+  BLI_mutex_unlock(&state->python_queue_mutex);
+
+  while (atomic_cas_int32(&state->python_lane_busy, 0, 1) == 0) {
+    while (OperationNode *node = python_queue_pop(state)) {
+      evaluate_node_and_schedule_children(state, node, thread_id, pool);
+    }
+    atomic_cas_int32(&state->python_lane_busy, 1, 0);
+
+    /* An operation might have been queued after the queue was found empty, but before the lane
+     * was released. Its worker gave up on the lane, so it has to be picked up here. */
+    BLI_mutex_lock(&state->python_queue_mutex);
+    const bool is_queue_empty = state->python_queue.empty();
+    BLI_mutex_unlock(&state->python_queue_mutex);
+    if (is_queue_empty) {
+      break;
+    }
   }
 }
 
@@ -121,14 +243,12 @@ void deg_task_run_func(TaskPool *pool, void *taskdata, int thread_id)
   void *userdata_v = BLI_task_pool_userdata(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
-
-  /* Schedule children. */
-  BLI_task_pool_delayed_push_begin(pool, thread_id);
-  schedule_children(state, operation_node, thread_id, schedule_node_to_pool, pool);
-  BLI_task_pool_delayed_push_end(pool, thread_id);
+  if (operation_node->flag & DEPSOP_FLAG_NEEDS_PYTHON) {
+    evaluate_python_node(state, operation_node, thread_id, pool);
+    return;
+  }
+  evaluate_node_and_schedule_children(state, operation_node, thread_id, pool);
 }
 
 bool check_operation_node_visible(OperationNode *op_node)
@@ -183,13 +303,18 @@ void calculate_pending_parents(Depsgraph *graph)
 
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
-  const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
-    if (do_stats) {
-      node->stats.reset_current();
-    }
+    node->stats.reset_current();
+  }
+  state->evaluated_nodes = (OperationNode **)MEM_malloc_arrayN(
+      graph->operations.size(), sizeof(*state->evaluated_nodes), __func__);
+  state->num_evaluated_nodes = 0;
+  state->profile_events = nullptr;
+  if (deg_profile_is_enabled()) {
+    state->profile_events = (ProfileEvent *)MEM_malloc_arrayN(
+        graph->operations.size(), sizeof(*state->profile_events), __func__);
   }
 }
 
@@ -271,6 +396,8 @@ void schedule_node(DepsgraphEvalState *state,
   if (!is_scheduled) {
     if (node->is_noop()) {
       /* skip NOOP node, schedule children right away */
+      const double time = (state->profile_events != nullptr) ? PIL_check_seconds_timer() : 0.0;
+      evaluate_node_finished(state, node, thread_id, time, time);
       schedule_children(state, node, thread_id, schedule_function, schedule_function_args...);
     }
     else {
@@ -329,7 +456,7 @@ void evaluate_graph_single_threaded(DepsgraphEvalState *state)
     OperationNode *operation_node;
     BLI_gsqueue_pop(evaluation_queue, &operation_node);
 
-    evaluate_node(state, operation_node);
+    evaluate_node(state, operation_node, 0);
     schedule_children(state, operation_node, 0, schedule_node_to_queue, evaluation_queue);
   }
 
@@ -367,6 +494,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   }
 
   graph->debug.begin_graph_evaluation();
+  const double evaluation_start_time = PIL_check_seconds_timer();
 
   graph->is_evaluating = true;
   depsgraph_ensure_view_layer(graph);
@@ -375,6 +503,8 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
   state.need_single_thread_pass = false;
+  state.python_lane_busy = 0;
+  BLI_mutex_init(&state.python_queue_mutex);
   /* Set up task scheduler and pull for threaded evaluation. */
   TaskScheduler *task_scheduler;
   bool need_free_scheduler;
@@ -392,14 +522,18 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   /* Do actual evaluation now. */
 
+  ReadyOperations ready_operations;
+
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph(&state, schedule_node_to_ready_operations, &ready_operations);
+  schedule_ready_operations_to_pool(&ready_operations, -1, task_pool);
   BLI_task_pool_work_wait_and_reset(task_pool);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph(&state, schedule_node_to_ready_operations, &ready_operations);
+  schedule_ready_operations_to_pool(&ready_operations, -1, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
@@ -414,6 +548,17 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  deg_eval_stats_critical_path_update(state.evaluated_nodes, state.num_evaluated_nodes);
+  if (state.profile_events != nullptr) {
+    deg_profile_write_evaluation(graph,
+                                 evaluation_start_time,
+                                 PIL_check_seconds_timer(),
+                                 state.profile_events,
+                                 state.num_evaluated_nodes);
+    MEM_freeN(state.profile_events);
+  }
+  MEM_freeN(state.evaluated_nodes);
+  BLI_mutex_end(&state.python_queue_mutex);
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
   if (need_free_scheduler) {
@@ -287,8 +287,12 @@ bool id_copy_inplace_no_main(const ID *id, ID *newid)
   id_for_copy = nested_id_hack_get_discarded_pointers(&id_hack_storage, id);
 #endif
 
-  bool result = BKE_id_copy_ex(
-      nullptr, (ID *)id_for_copy, &newid, (LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE));
+  /* Geometry arrays are shared with the original until the evaluation modifies them. */
+  bool result = BKE_id_copy_ex(nullptr,
+                               (ID *)id_for_copy,
+                               &newid,
+                               (LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE |
+                                LIB_ID_COPY_CD_SHARE));
 
 #ifdef NESTED_ID_NASTY_WORKAROUND
   if (result) {
@@ -27,6 +27,7 @@
 #include "BLI_ghash.h"
 
 #include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
@@ -56,4 +57,23 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_stats_critical_path_update(OperationNode **evaluated_nodes, int num_evaluated_nodes)
+{
+  /* An operation always finishes after all the operations it depends on, so walking the
+   * evaluated operations backwards visits children before their parents. Children which were not
+   * evaluated this time keep the estimate from the last time they were. */
+  for (int i = num_evaluated_nodes - 1; i >= 0; i--) {
+    OperationNode *op_node = evaluated_nodes[i];
+    double children_time = 0.0;
+    for (Relation *rel : op_node->outlinks) {
+      if (rel->flag & RELATION_FLAG_CYCLIC) {
+        continue;
+      }
+      OperationNode *child = (OperationNode *)rel->to;
+      children_time = max(children_time, child->critical_path_time);
+    }
+    op_node->critical_path_time = op_node->stats.current_time + children_time;
+  }
+}
+
 }  // namespace DEG
@@ -26,8 +26,13 @@
 namespace DEG {
 
 struct Depsgraph;
+struct OperationNode;
 
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Update critical path time of the evaluated operations from their timing.
+ * The operations are expected in the order they finished evaluating. */
+void deg_eval_stats_critical_path_update(OperationNode **evaluated_nodes, int num_evaluated_nodes);
+
 }  // namespace DEG
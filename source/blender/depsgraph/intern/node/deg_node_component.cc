@@ -69,7 +69,14 @@ string ComponentNode::OperationIDKey::identifier() const
 
 bool ComponentNode::OperationIDKey::operator==(const OperationIDKey &other) const
 {
-  return (opcode == other.opcode) && (STREQ(name, other.name)) && (name_tag == other.name_tag);
+  if (opcode != other.opcode || name_tag != other.name_tag) {
+    return false;
+  }
+  /* Most operations are unnamed and share the same literal, so avoid the string comparison. */
+  if (name == other.name) {
+    return true;
+  }
+  return STREQ(name, other.name);
 }
 
 static unsigned int comp_node_hash_key(const void *key_v)
@@ -77,8 +84,12 @@ static unsigned int comp_node_hash_key(const void *key_v)
   const ComponentNode::OperationIDKey *key =
       reinterpret_cast<const ComponentNode::OperationIDKey *>(key_v);
   int opcode_as_int = static_cast<int>(key->opcode);
-  return BLI_ghashutil_combine_hash(BLI_ghashutil_uinthash(opcode_as_int),
-                                    BLI_ghashutil_strhash_p(key->name));
+  const unsigned int opcode_hash = BLI_ghashutil_uinthash(opcode_as_int);
+  /* Unnamed operations are the common case, skip hashing the empty name. */
+  if (key->name[0] == '\0') {
+    return opcode_hash;
+  }
+  return BLI_ghashutil_combine_hash(opcode_hash, BLI_ghashutil_strhash_p(key->name));
 }
 
 static bool comp_node_hash_key_cmp(const void *a, const void *b)
@@ -76,6 +76,10 @@ struct IDNode : public Node {
   ID *id_orig;
   ID *id_cow;
 
+  /* Session UUID of the original ID, stays valid when the original ID is freed (e.g. by undo)
+   * and its memory is re-used by another ID. */
+  uint32_t id_orig_session_uuid;
+
   /* Hash to make it faster to look up components. */
   GHash *components;
 
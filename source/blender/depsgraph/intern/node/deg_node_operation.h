@@ -214,6 +214,9 @@ enum OperationFlag {
    * outgoing relations. This is for NO-OP nodes that are purely used to indicate a
    * relation between components/IDs, and not for connecting to an operation. */
   DEPSOP_FLAG_PINNED = (1 << 3),
+  /* Operation runs Python code (i.e. a driver which is not a simple expression), and so is
+   * serialized on the Python GIL. */
+  DEPSOP_FLAG_NEEDS_PYTHON = (1 << 4),
 
   /* Set of flags which gets flushed along the relations. */
   DEPSOP_FLAG_FLUSH = (DEPSOP_FLAG_USER_MODIFIED),
@@ -257,6 +260,11 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Time needed to evaluate this operation and the longest chain of operations depending on it,
+   * as measured during the previous evaluation of this operation. Operations starting long
+   * dependency chains are scheduled first, see deg_eval_stats_critical_path_update(). */
+  double critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
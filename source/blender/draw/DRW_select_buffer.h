@@ -79,6 +79,10 @@ struct SELECTID_Context {
 
   /* rect is used to check which objects whose indexes need to be drawn. */
   rcti last_rect;
+
+  /** All objects in the region are drawn, so the buffer can be read without drawing it again
+   * as long as the view and the drawn objects don't change. */
+  bool is_region_drawn;
 };
 
 /* draw_select_buffer.c */
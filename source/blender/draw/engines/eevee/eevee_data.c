@@ -32,15 +32,22 @@ void EEVEE_view_layer_data_free(void *storage)
   EEVEE_ViewLayerData *sldata = (EEVEE_ViewLayerData *)storage;
 
   /* Lights */
+  if (sldata->lights) {
+    MEM_SAFE_FREE(sldata->lights->froxel_data);
+  }
   MEM_SAFE_FREE(sldata->lights);
   DRW_UBO_FREE_SAFE(sldata->light_ubo);
   DRW_UBO_FREE_SAFE(sldata->shadow_ubo);
   GPU_FRAMEBUFFER_FREE_SAFE(sldata->shadow_fb);
+  GPU_FRAMEBUFFER_FREE_SAFE(sldata->shadow_static_fb);
   DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+  DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
   DRW_TEXTURE_FREE_SAFE(sldata->shadow_cascade_pool);
+  DRW_TEXTURE_FREE_SAFE(sldata->light_froxel_tx);
   for (int i = 0; i < 2; i++) {
     MEM_SAFE_FREE(sldata->shcasters_buffers[i].bbox);
     MEM_SAFE_FREE(sldata->shcasters_buffers[i].update);
+    MEM_SAFE_FREE(sldata->shcasters_buffers[i].update_static);
   }
 
   if (sldata->fallback_lightcache) {
@@ -94,6 +101,8 @@ static void eevee_object_data_init(DrawData *dd)
 {
   EEVEE_ObjectEngineData *eevee_data = (EEVEE_ObjectEngineData *)dd;
   eevee_data->shadow_caster_id = -1;
+  /* Make sure the first static registration is added to the cached shadows. */
+  eevee_data->shadow_is_dynamic = true;
 }
 
 EEVEE_ObjectEngineData *EEVEE_object_data_get(Object *ob)
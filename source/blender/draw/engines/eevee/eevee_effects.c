@@ -463,6 +463,77 @@ void EEVEE_create_minmax_buffer(EEVEE_Data *vedata, GPUTexture *depth_src, int l
   }
 }
 
+/* Occlusion culling is only valid while accumulating TAA samples of a static view and scene,
+ * where the depth of the first sample matches the following ones. */
+static bool eevee_hiz_culling_valid(EEVEE_EffectsInfo *effects)
+{
+  return !DRW_state_is_image_render() && (effects->enabled_effects & EFFECT_TAA) &&
+         !(effects->enabled_effects & EFFECT_TAA_REPROJECT);
+}
+
+/* Read back a low resolution level of the max-z pyramid. Done when drawing the second TAA
+ * sample, so the GPU has long finished computing the pyramid of the first one. */
+static EEVEE_HiZReadback *eevee_hiz_readback_create(EEVEE_Data *vedata)
+{
+  EEVEE_TextureList *txl = vedata->txl;
+
+  /* Small enough to keep the read-back and the per object test cheap.
+   * Levels past 8 are not computed by #EEVEE_create_minmax_buffer. */
+  int size[3], lod = 0;
+  GPU_texture_get_mipmap_size(txl->maxzbuffer, lod, size);
+  while ((size[0] > 64 || size[1] > 64) && lod < 8) {
+    GPU_texture_get_mipmap_size(txl->maxzbuffer, ++lod, size);
+  }
+
+  float *depth = GPU_texture_read(txl->maxzbuffer, GPU_DATA_FLOAT, lod);
+  size_t depth_size = sizeof(float) * size[0] * size[1];
+
+  EEVEE_HiZReadback *hiz = MEM_mallocN(sizeof(EEVEE_HiZReadback) + depth_size, __func__);
+  hiz->size[0] = size[0];
+  hiz->size[1] = size[1];
+  memcpy(hiz->depth, depth, depth_size);
+  MEM_freeN(depth);
+  return hiz;
+}
+
+/**
+ * Enable occlusion culling of the default view using the depth of the first TAA sample.
+ * Must be called before the main views are drawn and before the max-z pyramid is updated.
+ */
+void EEVEE_hiz_culling_begin(EEVEE_Data *vedata)
+{
+  EEVEE_StorageList *stl = vedata->stl;
+  EEVEE_EffectsInfo *effects = stl->effects;
+
+  if (!eevee_hiz_culling_valid(effects) || effects->taa_current_sample <= 1) {
+    /* Depth of an older sample, not valid anymore. */
+    MEM_SAFE_FREE(stl->hiz_readback);
+    return;
+  }
+
+  if (effects->taa_current_sample == 2) {
+    MEM_SAFE_FREE(stl->hiz_readback);
+    stl->hiz_readback = eevee_hiz_readback_create(vedata);
+  }
+
+  if (stl->hiz_readback) {
+    EEVEE_HiZReadback *hiz = stl->hiz_readback;
+    DRWView *default_view = (DRWView *)DRW_view_default_get();
+    DRW_view_occlusion_set(default_view, hiz->depth, hiz->size[0], hiz->size[1]);
+  }
+}
+
+/**
+ * Disable occlusion culling of the default view for the engines drawn afterwards.
+ */
+void EEVEE_hiz_culling_end(EEVEE_Data *vedata)
+{
+  if (vedata->stl->hiz_readback) {
+    DRWView *default_view = (DRWView *)DRW_view_default_get();
+    DRW_view_occlusion_set(default_view, NULL, 0, 0);
+  }
+}
+
 /**
  * Simple down-sampling algorithm. Reconstruct mip chain up to mip level.
  */
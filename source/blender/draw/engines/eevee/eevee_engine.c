@@ -229,6 +229,8 @@ static void eevee_draw_scene(void *vedata)
     /* Copy previous persmat to UBO data */
     copy_m4_m4(sldata->common_data.prev_persmat, stl->effects->prev_persmat);
 
+    EEVEE_hiz_culling_begin(vedata);
+
     /* Refresh Probes
      * Shadows needs to be updated for correct probes */
     DRW_stats_group_start("Probes Refresh");
@@ -255,6 +257,8 @@ static void eevee_draw_scene(void *vedata)
       EEVEE_temporal_sampling_update_matrices(vedata);
     }
 
+    EEVEE_lights_froxel_update(sldata, stl->effects->taa_view);
+
     /* Set ray type. */
     sldata->common_data.ray_type = EEVEE_RAY_CAMERA;
     sldata->common_data.ray_depth = 0.0f;
@@ -326,6 +330,7 @@ static void eevee_draw_scene(void *vedata)
     DRW_stats_group_end();
 
     DRW_view_set_active(NULL);
+    EEVEE_hiz_culling_end(vedata);
 
     if (DRW_state_is_image_render() && (stl->effects->enabled_effects & EFFECT_SSR) &&
         !stl->effects->ssr_was_valid_double_buffer) {
@@ -74,6 +74,10 @@
   (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_X) * \
       (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_Y)
 
+/* Number of irradiance grid samples rendered in one draw manager pipeline.
+ * Drawing is locked while they render, so keep it low enough for the UI to stay responsive. */
+#define GRID_SAMPLE_BATCH_LEN 16
+
 /* TODO should be replace by a more elegant alternative. */
 extern void DRW_opengl_context_enable(void);
 extern void DRW_opengl_context_disable(void);
@@ -130,6 +134,10 @@ typedef struct EEVEE_LightBake {
   int grid_sample;
   /** Total number of samples for the current grid. */
   int grid_sample_len;
+  /** Number of samples rendered from grid_sample in one pipeline. */
+  int grid_sample_batch_len;
+  /** Cell index and level stride of each sample of the current grid, in rendering order. */
+  int *grid_sample_cells, *grid_sample_strides;
   /** Nth grid in the cache being rendered. */
   int grid_curr;
   /** The current light bounce being evaluated. */
@@ -860,12 +868,14 @@ static void cell_id_to_grid_loc(EEVEE_LightGrid *egrid, int cell_idx, int r_loca
   r_local_cell[0] = cell_idx / (egrid->resolution[2] * egrid->resolution[1]);
 }
 
-static void compute_cell_id(EEVEE_LightGrid *egrid,
-                            LightProbe *probe,
-                            int cell_idx,
-                            int *r_final_idx,
-                            int r_local_cell[3],
-                            int *r_stride)
+/**
+ * Fill the rendering order of the cells of a grid: from the coarsest level to the finest one,
+ * so the grid can be displayed progressively. This used to be searched again for every sample.
+ */
+static void compute_cell_order(EEVEE_LightGrid *egrid,
+                               LightProbe *probe,
+                               int *r_cell_index,
+                               int *r_stride)
 {
   const int cell_count = probe->grid_resolution_x * probe->grid_resolution_y *
                          probe->grid_resolution_z;
@@ -875,32 +885,27 @@ static void compute_cell_id(EEVEE_LightGrid *egrid,
       (float)MAX3(probe->grid_resolution_x, probe->grid_resolution_y, probe->grid_resolution_z)));
 
   int visited_cells = 0;
-  *r_stride = 0;
-  *r_final_idx = 0;
-  r_local_cell[0] = r_local_cell[1] = r_local_cell[2] = 0;
   for (int lvl = max_lvl; lvl >= 0; lvl--) {
-    *r_stride = 1 << lvl;
-    int prev_stride = *r_stride << 1;
+    const int stride = 1 << lvl;
+    const int prev_stride = stride << 1;
     for (int i = 0; i < cell_count; i++) {
-      *r_final_idx = i;
-      cell_id_to_grid_loc(egrid, *r_final_idx, r_local_cell);
-      if (((r_local_cell[0] % *r_stride) == 0) && ((r_local_cell[1] % *r_stride) == 0) &&
-          ((r_local_cell[2] % *r_stride) == 0)) {
-        if (!(((r_local_cell[0] % prev_stride) == 0) && ((r_local_cell[1] % prev_stride) == 0) &&
-              ((r_local_cell[2] % prev_stride) == 0)) ||
+      int local_cell[3];
+      cell_id_to_grid_loc(egrid, i, local_cell);
+      if (((local_cell[0] % stride) == 0) && ((local_cell[1] % stride) == 0) &&
+          ((local_cell[2] % stride) == 0)) {
+        if (!(((local_cell[0] % prev_stride) == 0) && ((local_cell[1] % prev_stride) == 0) &&
+              ((local_cell[2] % prev_stride) == 0)) ||
             ((i == 0) && (lvl == max_lvl))) {
-          if (visited_cells == cell_idx) {
-            return;
-          }
-          else {
-            visited_cells++;
-          }
+          BLI_assert(visited_cells < cell_count);
+          r_cell_index[visited_cells] = i;
+          r_stride[visited_cells] = stride;
+          visited_cells++;
         }
       }
     }
   }
 
-  BLI_assert(0);
+  BLI_assert(visited_cells == cell_count);
 }
 
 static void grid_loc_to_world_loc(EEVEE_LightGrid *egrid, int local_cell[3], float r_pos[3])
@@ -921,10 +926,6 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   LightProbe *prb = *lbake->probe;
   Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
   LightCache *lcache = scene_eval->eevee.light_cache;
-  int grid_loc[3], sample_id, sample_offset, stride;
-  float pos[3];
-  const bool is_last_bounce_sample = ((egrid->offset + lbake->grid_sample) ==
-                                      (lbake->total_irr_samples - 1));
 
   /* No bias for rendering the probe. */
   egrid->level_bias = 1.0f;
@@ -933,15 +934,10 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
 
   /* TODO do this once for the whole bake when we have independent DRWManagers.
-   * Warning: Some of the things above require this. */
+   * Warning: Some of the things above require this.
+   * Until then the cache is shared by all the samples of a batch. */
   eevee_lightbake_cache_create(vedata, lbake);
 
-  /* Compute sample position */
-  compute_cell_id(egrid, prb, lbake->grid_sample, &sample_id, grid_loc, &stride);
-  sample_offset = egrid->offset + sample_id;
-
-  grid_loc_to_world_loc(egrid, grid_loc, pos);
-
   /* Disable specular lighting when rendering probes to avoid feedback loops (looks bad). */
   common_data->spec_toggle = false;
   common_data->prb_num_planar = 0;
@@ -953,45 +949,66 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   }
   DRW_uniformbuffer_update(sldata->common_ubo, &sldata->common_data);
 
-  EEVEE_lightbake_render_scene(sldata, vedata, lbake->rt_fb, pos, prb->clipsta, prb->clipend);
-
-  /* Restore before filtering. */
   SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
 
-  EEVEE_lightbake_filter_diffuse(
-      sldata, vedata, lbake->rt_color, lbake->store_fb, sample_offset, prb->intensity);
+  const int grid_sample_end = lbake->grid_sample + lbake->grid_sample_batch_len;
+  for (int grid_sample = lbake->grid_sample; grid_sample < grid_sample_end; grid_sample++) {
+    int grid_loc[3], sample_id, sample_offset, stride;
+    float pos[3];
+    const bool is_last_bounce_sample = ((egrid->offset + grid_sample) ==
+                                        (lbake->total_irr_samples - 1));
 
-  if (lbake->bounce_curr == 0) {
-    /* We only need to filter the visibility for the first bounce. */
-    EEVEE_lightbake_filter_visibility(sldata,
-                                      vedata,
-                                      lbake->rt_depth,
-                                      lbake->store_fb,
-                                      sample_offset,
-                                      prb->clipsta,
-                                      prb->clipend,
-                                      egrid->visibility_range,
-                                      prb->vis_blur,
-                                      lbake->vis_res);
-  }
+    /* Compute sample position */
+    sample_id = lbake->grid_sample_cells[grid_sample];
+    stride = lbake->grid_sample_strides[grid_sample];
+    cell_id_to_grid_loc(egrid, sample_id, grid_loc);
+    sample_offset = egrid->offset + sample_id;
 
-  /* Update level for progressive update. */
-  if (is_last_bounce_sample) {
-    egrid->level_bias = 1.0f;
-  }
-  else if (lbake->bounce_curr == 0) {
-    egrid->level_bias = (float)(stride << 1);
-  }
+    grid_loc_to_world_loc(egrid, grid_loc, pos);
 
-  /* Only run this for the last sample of a bounce. */
-  if (is_last_bounce_sample) {
-    eevee_lightbake_copy_irradiance(lbake, lcache);
-  }
+    SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
 
-  /* If it is the last sample grid sample (and last bounce). */
-  if ((lbake->bounce_curr == lbake->bounce_len - 1) && (lbake->grid_curr == lbake->grid_len - 1) &&
-      (lbake->grid_sample == lbake->grid_sample_len - 1)) {
-    lcache->flag &= ~LIGHTCACHE_UPDATE_GRID;
+    EEVEE_lightbake_render_scene(sldata, vedata, lbake->rt_fb, pos, prb->clipsta, prb->clipend);
+
+    /* Restore before filtering. */
+    SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
+    EEVEE_lightbake_filter_diffuse(
+        sldata, vedata, lbake->rt_color, lbake->store_fb, sample_offset, prb->intensity);
+
+    if (lbake->bounce_curr == 0) {
+      /* We only need to filter the visibility for the first bounce. */
+      EEVEE_lightbake_filter_visibility(sldata,
+                                        vedata,
+                                        lbake->rt_depth,
+                                        lbake->store_fb,
+                                        sample_offset,
+                                        prb->clipsta,
+                                        prb->clipend,
+                                        egrid->visibility_range,
+                                        prb->vis_blur,
+                                        lbake->vis_res);
+    }
+
+    /* Update level for progressive update. */
+    if (is_last_bounce_sample) {
+      egrid->level_bias = 1.0f;
+    }
+    else if (lbake->bounce_curr == 0) {
+      egrid->level_bias = (float)(stride << 1);
+    }
+
+    /* Only run this for the last sample of a bounce. */
+    if (is_last_bounce_sample) {
+      eevee_lightbake_copy_irradiance(lbake, lcache);
+    }
+
+    /* If it is the last sample grid sample (and last bounce). */
+    if ((lbake->bounce_curr == lbake->bounce_len - 1) &&
+        (lbake->grid_curr == lbake->grid_len - 1) &&
+        (grid_sample == lbake->grid_sample_len - 1)) {
+      lcache->flag &= ~LIGHTCACHE_UPDATE_GRID;
+    }
   }
 }
 
@@ -1150,7 +1167,8 @@ void EEVEE_lightbake_update(void *custom_data)
 }
 
 static bool lightbake_do_sample(EEVEE_LightBake *lbake,
-                                void (*render_callback)(void *ved, void *user_data))
+                                void (*render_callback)(void *ved, void *user_data),
+                                const int sample_len)
 {
   if (G.is_break == true || *lbake->stop) {
     return false;
@@ -1161,7 +1179,7 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   /* TODO: make DRW manager instanciable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
+  lbake->done += sample_len;
   *lbake->progress = lbake->done / (float)lbake->total;
   *lbake->do_update = 1;
   eevee_lightbake_context_disable(lbake);
@@ -1208,7 +1226,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
   /* Render world irradiance and reflection first */
   if (lcache->flag & LIGHTCACHE_UPDATE_WORLD) {
     lbake->probe = NULL;
-    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample);
+    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample, 1);
   }
 
   /* Render irradiance grids */
@@ -1222,10 +1240,22 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
         LightProbe *prb = *lbake->probe;
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
+        lbake->grid_sample_cells = MEM_mallocN(sizeof(int) * lbake->grid_sample_len, __func__);
+        lbake->grid_sample_strides = MEM_mallocN(sizeof(int) * lbake->grid_sample_len, __func__);
+        compute_cell_order(lbake->grid, prb, lbake->grid_sample_cells, lbake->grid_sample_strides);
+
         for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
-             ++lbake->grid_sample) {
-          lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
+             lbake->grid_sample += lbake->grid_sample_batch_len) {
+          lbake->grid_sample_batch_len = min_ii(GRID_SAMPLE_BATCH_LEN,
+                                                lbake->grid_sample_len - lbake->grid_sample);
+          if (!lightbake_do_sample(
+                  lbake, eevee_lightbake_render_grid_sample, lbake->grid_sample_batch_len)) {
+            break;
+          }
         }
+
+        MEM_SAFE_FREE(lbake->grid_sample_cells);
+        MEM_SAFE_FREE(lbake->grid_sample_strides);
       }
     }
   }
@@ -1237,7 +1267,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample, 1);
     }
   }
 
@@ -215,4 +215,153 @@ void EEVEE_lights_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *UNUSED(v
   sldata->common_data.la_num_light = linfo->num_light;
 
   DRW_uniformbuffer_update(sldata->light_ubo, &linfo->light_data);
+
+  /* Light culling grid. Content is filled by EEVEE_lights_froxel_update() before drawing the
+   * main view. Until then, culling is disabled. */
+  const float *viewport_size = DRW_viewport_size_get();
+  const int froxel_res[3] = {
+      ((int)viewport_size[0] + LIGHT_FROXEL_TILE_SIZE - 1) / LIGHT_FROXEL_TILE_SIZE,
+      ((int)viewport_size[1] + LIGHT_FROXEL_TILE_SIZE - 1) / LIGHT_FROXEL_TILE_SIZE,
+      LIGHT_FROXEL_SLICES,
+  };
+
+  if (memcmp(froxel_res, linfo->froxel_res, sizeof(froxel_res)) != 0) {
+    copy_v3_v3_int(linfo->froxel_res, froxel_res);
+    MEM_SAFE_FREE(linfo->froxel_data);
+    DRW_TEXTURE_FREE_SAFE(sldata->light_froxel_tx);
+  }
+
+  if (linfo->froxel_data == NULL) {
+    linfo->froxel_data = MEM_mallocN(sizeof(uint) * LIGHT_FROXEL_WORDS * froxel_res[0] *
+                                         froxel_res[1] * froxel_res[2],
+                                     __func__);
+  }
+
+  if (sldata->light_froxel_tx == NULL) {
+    sldata->light_froxel_tx = DRW_texture_create_3d(
+        froxel_res[0] * LIGHT_FROXEL_WORDS, froxel_res[1], froxel_res[2], GPU_R32UI, 0, NULL);
+  }
+
+  sldata->common_data.la_froxel_z_scale = 0.0f;
+  sldata->common_data.la_froxel_z_bias = 0.0f;
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Light Culling
+ *
+ * The main view is divided in screen tiles and depth slices (froxels). Each froxel stores a
+ * bitmask of the lights whose influence sphere touches it, so that surface shading can skip the
+ * lights that cannot affect a pixel.
+ * \{ */
+
+static int light_froxel_slice_get(const EEVEE_CommonUniformBuffer *common_data,
+                                  bool is_persp,
+                                  float depth)
+{
+  float z = is_persp ? log2f(max_ff(depth, 1e-8f)) : depth;
+  int slice = (int)(z * common_data->la_froxel_z_scale + common_data->la_froxel_z_bias);
+  return clamp_i(slice, 0, LIGHT_FROXEL_SLICES - 1);
+}
+
+static void light_froxel_enable(EEVEE_LightsInfo *linfo,
+                                int light_id,
+                                const int min[3],
+                                const int max[3])
+{
+  const uint bit = 1u << (light_id % 32);
+  const int word = light_id / 32;
+  for (int z = min[2]; z <= max[2]; z++) {
+    for (int y = min[1]; y <= max[1]; y++) {
+      uint *row = linfo->froxel_data +
+                  ((z * linfo->froxel_res[1] + y) * linfo->froxel_res[0]) * LIGHT_FROXEL_WORDS;
+      for (int x = min[0]; x <= max[0]; x++) {
+        row[x * LIGHT_FROXEL_WORDS + word] |= bit;
+      }
+    }
+  }
+}
+
+/* Fill the light culling froxels for the given view. Only surfaces drawn with the camera ray
+ * type use them, probes and planar reflections still iterate over all the lights. */
+void EEVEE_lights_froxel_update(EEVEE_ViewLayerData *sldata, const DRWView *view)
+{
+  EEVEE_LightsInfo *linfo = sldata->lights;
+  EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
+  const int *res = linfo->froxel_res;
+  const float *viewport_size = DRW_viewport_size_get();
+
+  float viewmat[4][4], winmat[4][4];
+  DRW_view_viewmat_get(view, viewmat, false);
+  DRW_view_winmat_get(view, winmat, false);
+  const bool is_persp = DRW_view_is_persp_get(view);
+  const float near = DRW_view_near_distance_get(view);
+  const float far = DRW_view_far_distance_get(view);
+
+  /* Exponential slices in perspective, linear in orthographic. */
+  if (is_persp) {
+    common_data->la_froxel_z_scale = LIGHT_FROXEL_SLICES / log2f(far / near);
+    common_data->la_froxel_z_bias = -log2f(near) * common_data->la_froxel_z_scale;
+  }
+  else {
+    common_data->la_froxel_z_scale = LIGHT_FROXEL_SLICES / (far - near);
+    common_data->la_froxel_z_bias = -near * common_data->la_froxel_z_scale;
+  }
+
+  memset(linfo->froxel_data, 0, sizeof(uint) * LIGHT_FROXEL_WORDS * res[0] * res[1] * res[2]);
+
+  for (int i = 0; i < linfo->num_light; i++) {
+    const EEVEE_Light *evli = &linfo->light_data[i];
+    int min[3] = {0, 0, 0};
+    int max[3] = {res[0] - 1, res[1] - 1, res[2] - 1};
+
+    if (evli->light_type != LA_SUN) {
+      const float radius = sqrtf(1.0f / evli->invsqrdist);
+      float center[3];
+      mul_v3_m4v3(center, viewmat, evli->position);
+
+      /* View space depth range. */
+      const float depth_min = -center[2] - radius;
+      const float depth_max = -center[2] + radius;
+      if (depth_max < near || depth_min > far) {
+        continue;
+      }
+      min[2] = light_froxel_slice_get(common_data, is_persp, max_ff(depth_min, near));
+      max[2] = light_froxel_slice_get(common_data, is_persp, min_ff(depth_max, far));
+
+      /* Screen space bounds of the influence box. Bounds crossing the camera plane cover the
+       * whole screen. */
+      if (!is_persp || depth_min > near) {
+        float rect_min[2] = {FLT_MAX, FLT_MAX}, rect_max[2] = {-FLT_MAX, -FLT_MAX};
+        for (int j = 0; j < 8; j++) {
+          float co[4] = {
+              center[0] + ((j & 1) ? radius : -radius),
+              center[1] + ((j & 2) ? radius : -radius),
+              center[2] + ((j & 4) ? radius : -radius),
+              1.0f,
+          };
+          mul_m4_v4(winmat, co);
+          mul_v2_fl(co, 1.0f / co[3]);
+          minmax_v2v2_v2(rect_min, rect_max, co);
+        }
+        for (int a = 0; a < 2; a++) {
+          /* Pad by one pixel to account for the anti-aliasing jitter. */
+          float px_min = (rect_min[a] * 0.5f + 0.5f) * viewport_size[a] - 1.0f;
+          float px_max = (rect_max[a] * 0.5f + 0.5f) * viewport_size[a] + 1.0f;
+          if (px_max < 0.0f || px_min >= viewport_size[a]) {
+            min[a] = 1;
+            max[a] = 0;
+            break;
+          }
+          min[a] = max_ii(0, (int)px_min / LIGHT_FROXEL_TILE_SIZE);
+          max[a] = min_ii(res[a] - 1, (int)px_max / LIGHT_FROXEL_TILE_SIZE);
+        }
+      }
+    }
+
+    light_froxel_enable(linfo, i, min, max);
+  }
+
+  GPU_texture_update(sldata->light_froxel_tx, GPU_DATA_UNSIGNED_INT, linfo->froxel_data);
+}
+
+/** \} */
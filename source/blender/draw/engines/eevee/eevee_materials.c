@@ -431,6 +431,7 @@ static void add_standard_uniforms(DRWShadingGroup *shgrp,
     DRW_shgroup_uniform_texture(shgrp, "utilTex", e_data.util_tex);
     DRW_shgroup_uniform_texture_ref(shgrp, "shadowCubeTexture", &sldata->shadow_cube_pool);
     DRW_shgroup_uniform_texture_ref(shgrp, "shadowCascadeTexture", &sldata->shadow_cascade_pool);
+    DRW_shgroup_uniform_texture_ref(shgrp, "lightFroxelTexture", &sldata->light_froxel_tx);
     DRW_shgroup_uniform_texture_ref(shgrp, "maxzBuffer", &vedata->txl->maxzbuffer);
   }
   if ((use_diffuse || use_glossy) && !use_ssrefraction) {
@@ -1844,7 +1845,8 @@ static void eevee_hair_cache_populate(EEVEE_Data *vedata,
   }
 
   /* Shadows */
-  DRW_shgroup_hair_create(ob, psys, md, psl->shadow_pass, e_data.default_hair_prepass_sh);
+  DRW_shgroup_hair_create(
+      ob, psys, md, EEVEE_shadows_caster_pass_get(psl, ob), e_data.default_hair_prepass_sh);
   *cast_shadow = true;
 }
 
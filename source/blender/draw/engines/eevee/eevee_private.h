@@ -41,6 +41,10 @@ extern struct DrawEngineType draw_engine_eevee_type;
 #define MAX_GRID 64   /* TODO : find size by dividing UBO max size by grid data size */
 #define MAX_PLANAR 16 /* TODO : find size by dividing UBO max size by grid data size */
 #define MAX_LIGHT 128 /* TODO : find size by dividing UBO max size by light data size */
+/* Light culling grid: screen tiles and depth slices, each storing a bitmask of MAX_LIGHT. */
+#define LIGHT_FROXEL_TILE_SIZE 64
+#define LIGHT_FROXEL_SLICES 16
+#define LIGHT_FROXEL_WORDS (MAX_LIGHT / 32)
 #define MAX_CASCADE_NUM 4
 #define MAX_SHADOW 128 /* TODO : Make this depends on GL_MAX_ARRAY_TEXTURE_LAYERS */
 #define MAX_SHADOW_CASCADE 8
@@ -71,6 +75,9 @@ extern struct DrawEngineType draw_engine_eevee_type;
   "#define MAX_GRID " STRINGIFY(MAX_GRID) "\n" \
   "#define MAX_PLANAR " STRINGIFY(MAX_PLANAR) "\n" \
   "#define MAX_LIGHT " STRINGIFY(MAX_LIGHT) "\n" \
+  "#define LIGHT_FROXEL_TILE_SIZE " STRINGIFY(LIGHT_FROXEL_TILE_SIZE) "\n" \
+  "#define LIGHT_FROXEL_SLICES " STRINGIFY(LIGHT_FROXEL_SLICES) "\n" \
+  "#define LIGHT_FROXEL_WORDS " STRINGIFY(LIGHT_FROXEL_WORDS) "\n" \
   "#define MAX_SHADOW " STRINGIFY(MAX_SHADOW) "\n" \
   "#define MAX_SHADOW_CUBE " STRINGIFY(MAX_SHADOW_CUBE) "\n" \
   "#define MAX_SHADOW_CASCADE " STRINGIFY(MAX_SHADOW_CASCADE) "\n" \
@@ -216,6 +223,7 @@ typedef struct EEVEE_BoundBox {
 typedef struct EEVEE_PassList {
   /* Shadows */
   struct DRWPass *shadow_pass;
+  struct DRWPass *shadow_dynamic_pass;
   struct DRWPass *shadow_accum_pass;
 
   /* Probes */
@@ -380,6 +388,13 @@ typedef struct EEVEE_TextureList {
   struct GPUTexture *depth_double_buffer;
 } EEVEE_TextureList;
 
+/* Low resolution level of the max-z pyramid of the first TAA sample.
+ * Used for occlusion culling of the following samples. */
+typedef struct EEVEE_HiZReadback {
+  int size[2];
+  float depth[0];
+} EEVEE_HiZReadback;
+
 typedef struct EEVEE_StorageList {
   /* Effects */
   struct EEVEE_EffectsInfo *effects;
@@ -390,6 +405,8 @@ typedef struct EEVEE_StorageList {
   EEVEE_LightProbe *lookdev_cube_data;
   EEVEE_LightGrid *lookdev_grid_data;
   LightCacheTexture *lookdev_cube_mips;
+
+  struct EEVEE_HiZReadback *hiz_readback;
 } EEVEE_StorageList;
 
 /* ************ RENDERPASS UBO ************* */
@@ -461,6 +478,8 @@ BLI_STATIC_ASSERT(sizeof(EEVEE_Shadow) * MAX_SHADOW +
 typedef struct EEVEE_ShadowCasterBuffer {
   struct EEVEE_BoundBox *bbox;
   BLI_bitmap *update;
+  /* Casters that invalidate the cached static shadow cubes. */
+  BLI_bitmap *update_static;
   uint alloc_count;
   uint count;
 } EEVEE_ShadowCasterBuffer;
@@ -485,8 +504,14 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  BLI_bitmap sh_cube_static_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  /* Dynamic casters are drawn on top of a copy of the cached static shadow cubes. */
+  bool use_static_cache;
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds  */
+  /* Light culling froxels, LIGHT_FROXEL_WORDS per froxel. */
+  uint *froxel_data;
+  int froxel_res[3];
   /* List of bbox and update bitmap. Double buffered. */
   struct EEVEE_ShadowCasterBuffer *shcaster_frontbuffer, *shcaster_backbuffer;
   /* AABB of all shadow casters combined. */
@@ -716,8 +741,9 @@ typedef struct EEVEE_CommonUniformBuffer {
   float ray_depth;         /* float */
   float alpha_hash_offset; /* float */
   float alpha_hash_scale;  /* float */
-  float pad7;              /* float */
-  float pad8;              /* float */
+  /* Light culling */
+  float la_froxel_z_scale; /* float */
+  float la_froxel_z_bias;  /* float */
 } EEVEE_CommonUniformBuffer;
 
 BLI_STATIC_ASSERT_ALIGN(EEVEE_CommonUniformBuffer, 16)
@@ -738,10 +764,15 @@ typedef struct EEVEE_ViewLayerData {
   struct GPUUniformBuffer *shadow_samples_ubo;
 
   struct GPUFrameBuffer *shadow_fb;
+  struct GPUFrameBuffer *shadow_static_fb;
 
   struct GPUTexture *shadow_cube_pool;
+  /* Depth of the static shadow casters only, same layout as shadow_cube_pool. */
+  struct GPUTexture *shadow_cube_static_pool;
   struct GPUTexture *shadow_cascade_pool;
 
+  struct GPUTexture *light_froxel_tx;
+
   struct EEVEE_ShadowCasterBuffer shcasters_buffers[2];
 
   /* Probes */
@@ -787,6 +818,8 @@ typedef struct EEVEE_ObjectEngineData {
   bool ob_vis, ob_vis_dirty;
 
   bool need_update;
+  /* Was drawn in the dynamic shadow pass during the previous redraw. */
+  bool shadow_is_dynamic;
   uint shadow_caster_id;
 } EEVEE_ObjectEngineData;
 
@@ -806,6 +839,7 @@ typedef struct EEVEE_Data {
 
 typedef struct EEVEE_PrivateData {
   struct DRWShadingGroup *shadow_shgrp;
+  struct DRWShadingGroup *shadow_dynamic_shgrp;
   struct DRWShadingGroup *shadow_accum_shgrp;
   struct DRWShadingGroup *depth_shgrp;
   struct DRWShadingGroup *depth_shgrp_cull;
@@ -932,11 +966,13 @@ void eevee_light_matrix_get(const EEVEE_Light *evli, float r_mat[4][4]);
 void EEVEE_lights_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_lights_cache_add(EEVEE_ViewLayerData *sldata, struct Object *ob);
 void EEVEE_lights_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
+void EEVEE_lights_froxel_update(EEVEE_ViewLayerData *sldata, const DRWView *view);
 
 /* eevee_shadows.c */
 void eevee_contact_shadow_setup(const Light *la, EEVEE_Shadow *evsh);
 void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata);
 void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
+struct DRWPass *EEVEE_shadows_caster_pass_get(EEVEE_PassList *psl, struct Object *ob);
 void EEVEE_shadows_caster_add(EEVEE_ViewLayerData *sldata,
                               EEVEE_StorageList *stl,
                               struct GPUBatch *geom,
@@ -1174,6 +1210,8 @@ void EEVEE_effects_init(EEVEE_ViewLayerData *sldata,
 void EEVEE_effects_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_effects_draw_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_create_minmax_buffer(EEVEE_Data *vedata, struct GPUTexture *depth_src, int layer);
+void EEVEE_hiz_culling_begin(EEVEE_Data *vedata);
+void EEVEE_hiz_culling_end(EEVEE_Data *vedata);
 void EEVEE_downsample_buffer(EEVEE_Data *vedata, struct GPUTexture *texture_src, int level);
 void EEVEE_downsample_cube_buffer(EEVEE_Data *vedata, struct GPUTexture *texture_src, int level);
 void EEVEE_draw_effects(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
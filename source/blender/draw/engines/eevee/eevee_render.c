@@ -563,6 +563,7 @@ void EEVEE_render_draw(EEVEE_Data *vedata, RenderEngine *engine, RenderLayer *rl
 
     /* Set matrices. */
     DRW_view_set_active(stl->effects->taa_view);
+    EEVEE_lights_froxel_update(sldata, stl->effects->taa_view);
 
     /* Set ray type. */
     sldata->common_data.ray_type = EEVEE_RAY_CAMERA;
@@ -93,6 +93,8 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
       sldata->shcasters_buffers[i].bbox = MEM_callocN(
           sizeof(EEVEE_BoundBox) * SH_CASTER_ALLOC_CHUNK, __func__);
       sldata->shcasters_buffers[i].update = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK, __func__);
+      sldata->shcasters_buffers[i].update_static = BLI_BITMAP_NEW(SH_CASTER_ALLOC_CHUNK,
+                                                                  __func__);
       sldata->shcasters_buffers[i].alloc_count = SH_CASTER_ALLOC_CHUNK;
       sldata->shcasters_buffers[i].count = 0;
     }
@@ -115,6 +117,7 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
       (linfo->shadow_high_bitdepth != sh_high_bitdepth)) {
     BLI_assert((sh_cube_size > 0) && (sh_cube_size <= 4096));
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
     CLAMP(sh_cube_size, 1, 4096);
   }
 
@@ -146,8 +149,10 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 
   /* Shadow Casters: Reset flags. */
   BLI_bitmap_set_all(backbuffer->update, true, backbuffer->alloc_count);
+  BLI_bitmap_set_all(backbuffer->update_static, true, backbuffer->alloc_count);
   /* Is this one needed? */
   BLI_bitmap_set_all(frontbuffer->update, false, frontbuffer->alloc_count);
+  BLI_bitmap_set_all(frontbuffer->update_static, false, frontbuffer->alloc_count);
 
   INIT_MINMAX(linfo->shcaster_aabb.min, linfo->shcaster_aabb.max);
 
@@ -156,7 +161,32 @@ void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     DRW_PASS_CREATE(psl->shadow_pass, state);
 
     stl->g_data->shadow_shgrp = DRW_shgroup_create(e_data.shadow_sh, psl->shadow_pass);
+
+    DRW_PASS_CREATE(psl->shadow_dynamic_pass, state);
+
+    stl->g_data->shadow_dynamic_shgrp = DRW_shgroup_create(e_data.shadow_sh,
+                                                           psl->shadow_dynamic_pass);
+  }
+}
+
+/* Casters updated during this redraw are drawn in a separate pass. This lets the shadow cubes
+ * keep a cache of the static casters depth and only re-render the moving ones on top of it. */
+static bool shadow_caster_is_dynamic(Object *ob)
+{
+  if (DRW_state_is_image_render()) {
+    return false;
+  }
+  if (ob->base_flag & BASE_FROM_DUPLI) {
+    /* Duplis have no persistent engine data, consider them as always moving. */
+    return true;
   }
+  EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob);
+  return oedata->need_update;
+}
+
+DRWPass *EEVEE_shadows_caster_pass_get(EEVEE_PassList *psl, Object *ob)
+{
+  return shadow_caster_is_dynamic(ob) ? psl->shadow_dynamic_pass : psl->shadow_pass;
 }
 
 /* Add a shadow caster to the shadowpasses */
@@ -165,7 +195,9 @@ void EEVEE_shadows_caster_add(EEVEE_ViewLayerData *UNUSED(sldata),
                               struct GPUBatch *geom,
                               Object *ob)
 {
-  DRW_shgroup_call(stl->g_data->shadow_shgrp, geom, ob);
+  DRWShadingGroup *grp = shadow_caster_is_dynamic(ob) ? stl->g_data->shadow_dynamic_shgrp :
+                                                        stl->g_data->shadow_shgrp;
+  DRW_shgroup_call(grp, geom, ob);
 }
 
 void EEVEE_shadows_caster_material_add(EEVEE_ViewLayerData *sldata,
@@ -176,7 +208,8 @@ void EEVEE_shadows_caster_material_add(EEVEE_ViewLayerData *sldata,
                                        const float *alpha_threshold)
 {
   /* TODO / PERF : reuse the same shading group for objects with the same material */
-  DRWShadingGroup *grp = DRW_shgroup_material_create(gpumat, psl->shadow_pass);
+  DRWShadingGroup *grp = DRW_shgroup_material_create(gpumat,
+                                                     EEVEE_shadows_caster_pass_get(psl, ob));
 
   if (grp == NULL) {
     return;
@@ -215,6 +248,7 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->update_static, frontbuffer->alloc_count);
   }
 
   if (ob->base_flag & BASE_FROM_DUPLI) {
@@ -224,13 +258,21 @@ void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, Object *ob)
   }
   else {
     EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob);
+    const bool was_dynamic = oedata->shadow_is_dynamic;
     int past_id = oedata->shadow_caster_id;
     oedata->shadow_caster_id = id;
     /* Update flags in backbuffer. */
     if (past_id > -1 && past_id < backbuffer->count) {
       BLI_BITMAP_SET(backbuffer->update, past_id, oedata->need_update);
+      /* A static caster that started moving must be removed from the cached shadows. */
+      BLI_BITMAP_SET(backbuffer->update_static, past_id, !was_dynamic && oedata->need_update);
     }
     update = oedata->need_update;
+    /* A caster that stopped moving must be added to the cached shadows. */
+    if (was_dynamic && !update && !DRW_state_is_image_render()) {
+      BLI_BITMAP_ENABLE(frontbuffer->update_static, id);
+    }
+    oedata->shadow_is_dynamic = shadow_caster_is_dynamic(ob);
     oedata->need_update = false;
   }
 
@@ -276,9 +318,29 @@ static bool sphere_bbox_intersect(const BoundSphere *bs, const EEVEE_BoundBox *b
   return x && y && z;
 }
 
+/* Tag the shadow cubes inside the caster bounds for update. */
+static void shadow_cubes_tag_update(EEVEE_LightsInfo *linfo,
+                                    const EEVEE_BoundBox *bbox,
+                                    const bool update_static)
+{
+  for (int j = 0; j < linfo->cube_len; j++) {
+    if (BLI_BITMAP_TEST(linfo->sh_cube_update, j) &&
+        (!update_static || BLI_BITMAP_TEST(linfo->sh_cube_static_update, j))) {
+      continue;
+    }
+    if (sphere_bbox_intersect(&linfo->shadow_bounds[j], bbox)) {
+      BLI_BITMAP_ENABLE(linfo->sh_cube_update, j);
+      if (update_static) {
+        BLI_BITMAP_ENABLE(linfo->sh_cube_static_update, j);
+      }
+    }
+  }
+}
+
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 {
   EEVEE_StorageList *stl = vedata->stl;
+  EEVEE_PassList *psl = vedata->psl;
   EEVEE_EffectsInfo *effects = stl->effects;
   EEVEE_LightsInfo *linfo = sldata->lights;
   EEVEE_ShadowCasterBuffer *backbuffer = linfo->shcaster_backbuffer;
@@ -290,11 +352,18 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   /* Free textures if number mismatch. */
   if (linfo->num_cube_layer != linfo->cache_num_cube_layer) {
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
     linfo->cache_num_cube_layer = linfo->num_cube_layer;
     /* Update all lights. */
     BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_LIGHT);
   }
 
+  /* Only keep the static shadow cache around while some casters are moving. */
+  linfo->use_static_cache = !DRW_pass_is_empty(psl->shadow_dynamic_pass);
+  if (!linfo->use_static_cache) {
+    DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_static_pool);
+  }
+
   if (linfo->num_cascade_layer != linfo->cache_num_cascade_layer) {
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cascade_pool);
     linfo->cache_num_cascade_layer = linfo->num_cascade_layer;
@@ -311,6 +380,18 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
                                                            NULL);
   }
 
+  if (!sldata->shadow_cube_static_pool && linfo->use_static_cache) {
+    sldata->shadow_cube_static_pool = DRW_texture_create_2d_array(
+        GPU_texture_width(sldata->shadow_cube_pool),
+        GPU_texture_height(sldata->shadow_cube_pool),
+        GPU_texture_layers(sldata->shadow_cube_pool),
+        shadow_pool_format,
+        0,
+        NULL);
+    /* Cache content is undefined. */
+    BLI_bitmap_set_all(&linfo->sh_cube_static_update[0], true, MAX_SHADOW_CUBE);
+  }
+
   if (!sldata->shadow_cascade_pool) {
     sldata->shadow_cascade_pool = DRW_texture_create_2d_array(linfo->shadow_cascade_size,
                                                               linfo->shadow_cascade_size,
@@ -324,43 +405,37 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     sldata->shadow_fb = GPU_framebuffer_create();
   }
 
+  if (sldata->shadow_static_fb == NULL) {
+    sldata->shadow_static_fb = GPU_framebuffer_create();
+  }
+
   /* Gather all light own update bits. to avoid costly intersection check.  */
   for (int j = 0; j < linfo->cube_len; j++) {
     const EEVEE_Light *evli = linfo->light_data + linfo->shadow_cube_light_indices[j];
     /* Setup shadow cube in UBO and tag for update if necessary. */
     if (EEVEE_shadows_cube_setup(linfo, evli, effects->taa_current_sample - 1)) {
       BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+      BLI_BITMAP_ENABLE(&linfo->sh_cube_static_update[0], j);
     }
   }
 
   /* TODO(fclem) This part can be slow, optimize it. */
   EEVEE_BoundBox *bbox = backbuffer->bbox;
-  BoundSphere *bsphere = linfo->shadow_bounds;
   /* Search for deleted shadow casters or if shcaster WAS in shadow radius. */
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadowcaster has been deleted or updated. */
-    if (BLI_BITMAP_TEST(backbuffer->update, i)) {
-      for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
-      }
+    const bool update_static = BLI_BITMAP_TEST(backbuffer->update_static, i);
+    if (update_static || BLI_BITMAP_TEST(backbuffer->update, i)) {
+      shadow_cubes_tag_update(linfo, &bbox[i], update_static);
     }
   }
   /* Search for updates in current shadow casters. */
   bbox = frontbuffer->bbox;
   for (int i = 0; i < frontbuffer->count; i++) {
     /* If the shadowcaster has been updated. */
-    if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
-      for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
-      }
+    const bool update_static = BLI_BITMAP_TEST(frontbuffer->update_static, i);
+    if (update_static || BLI_BITMAP_TEST(frontbuffer->update, i)) {
+      shadow_cubes_tag_update(linfo, &bbox[i], update_static);
     }
   }
 
@@ -374,6 +449,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     frontbuffer->bbox = MEM_reallocN(frontbuffer->bbox,
                                      sizeof(EEVEE_BoundBox) * frontbuffer->alloc_count);
     BLI_BITMAP_RESIZE(frontbuffer->update, frontbuffer->alloc_count);
+    BLI_BITMAP_RESIZE(frontbuffer->update_static, frontbuffer->alloc_count);
   }
 }
 
@@ -221,8 +221,11 @@ void EEVEE_volumes_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   uint ht_primes[3] = {3, 7, 2};
   uint current_sample = 0;
 
-  /* If TAA is in use do not use the history buffer. */
-  bool do_taa = ((effects->enabled_effects & EFFECT_TAA) != 0);
+  /* If TAA is in use do not use the history buffer.
+   * Exception: while TAA reprojects the previous frames during navigation, it restarts at the
+   * first sample each redraw. Reproject the volumetric history instead so it still converges. */
+  const bool do_taa_reproject = ((effects->enabled_effects & EFFECT_TAA_REPROJECT) != 0);
+  bool do_taa = ((effects->enabled_effects & EFFECT_TAA) != 0) && !do_taa_reproject;
 
   if (draw_ctx->evil_C != NULL) {
     struct wmWindowManager *wm = CTX_wm_manager(draw_ctx->evil_C);
@@ -234,6 +237,13 @@ void EEVEE_volumes_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     current_sample = effects->taa_current_sample - 1;
     effects->volume_current_sample = -1;
   }
+  else if (do_taa_reproject) {
+    /* TAA sample count stays at the first sample, advance the volume jitter on its own
+     * so that the reprojected history keeps receiving new samples. */
+    const uint max_sample = (ht_primes[0] * ht_primes[1] * ht_primes[2]);
+    current_sample = effects->volume_current_sample = (effects->volume_current_sample + 1) %
+                                                      max_sample;
+  }
   else if (DRW_state_is_image_render()) {
     const uint max_sample = (ht_primes[0] * ht_primes[1] * ht_primes[2]);
     current_sample = effects->volume_current_sample = (effects->volume_current_sample + 1) %
@@ -45,8 +45,9 @@ layout(std140) uniform common_block
   float rayDepth;
   float alphaHashOffset;
   float alphaHashScale;
-  float pad7;
-  float pad8;
+  /* Light culling */
+  float laFroxelZScale;
+  float laFroxelZBias;
 };
 
 /* rayType (keep in sync with ray_type) */
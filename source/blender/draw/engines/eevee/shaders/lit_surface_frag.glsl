@@ -4,6 +4,29 @@
 
 uniform float refractionDepth;
 
+/* Bitmask of the lights affecting each froxel. See EEVEE_lights_froxel_update. */
+uniform usampler3D lightFroxelTexture;
+
+/* Return the culling froxel of a fragment or -1 if lights are not culled for this ray type. */
+ivec3 light_froxel_get(vec2 frag_co, float view_z)
+{
+  if (rayType != EEVEE_RAY_CAMERA || laFroxelZScale == 0.0) {
+    return ivec3(-1);
+  }
+  float z = (ProjectionMatrix[3][3] == 0.0) ? log2(max(-view_z, 1e-8)) : -view_z;
+  int slice = clamp(int(z * laFroxelZScale + laFroxelZBias), 0, LIGHT_FROXEL_SLICES - 1);
+  return ivec3(ivec2(frag_co) / LIGHT_FROXEL_TILE_SIZE, slice);
+}
+
+uint light_froxel_word_get(ivec3 froxel, int word)
+{
+  if (froxel.x < 0) {
+    return 0xFFFFFFFFu;
+  }
+  ivec3 texel = ivec3(froxel.x * LIGHT_FROXEL_WORDS + word, froxel.yz);
+  return texelFetch(lightFroxelTexture, texel, 0).r;
+}
+
 #  ifndef UTIL_TEX
 #    define UTIL_TEX
 uniform sampler2DArray utilTex;
@@ -236,7 +259,18 @@ void CLOSURE_NAME(vec3 N
 
   vec3 true_normal = normalize(cross(dFdx(viewPosition), dFdy(viewPosition)));
 
+  ivec3 froxel = light_froxel_get(gl_FragCoord.xy, viewPosition.z);
+  uint froxel_lights = 0u;
+
   for (int i = 0; i < MAX_LIGHT && i < laNumLight; i++) {
+    if ((i % 32) == 0) {
+      froxel_lights = light_froxel_word_get(froxel, i / 32);
+    }
+    /* Skip lights that cannot reach this froxel. */
+    if ((froxel_lights & (1u << uint(i % 32))) == 0u) {
+      continue;
+    }
+
     LightData ld = lights_data[i];
 
     vec4 l_vector; /* Non-Normalized Light Vector with length in last component. */
@@ -270,22 +270,33 @@ static void select_deferred_shaders(WORKBENCH_PrivateData *wpd, eGPUShaderConfig
 {
   wpd->prepass_sh = ensure_deferred_prepass_shader(
       wpd, false, false, false, WORKBENCH_COLOR_OVERRIDE_OFF, sh_cfg);
-  wpd->prepass_hair_sh = ensure_deferred_prepass_shader(
-      wpd, false, true, false, WORKBENCH_COLOR_OVERRIDE_OFF, sh_cfg);
-  wpd->prepass_uniform_sh = ensure_deferred_prepass_shader(
-      wpd, true, false, false, WORKBENCH_COLOR_OVERRIDE_OFF, sh_cfg);
-  wpd->prepass_uniform_hair_sh = ensure_deferred_prepass_shader(
-      wpd, true, true, false, WORKBENCH_COLOR_OVERRIDE_OFF, sh_cfg);
-  wpd->prepass_textured_sh = ensure_deferred_prepass_shader(
-      wpd, false, false, false, WORKBENCH_COLOR_OVERRIDE_TEXTURE, sh_cfg);
-  wpd->prepass_textured_array_sh = ensure_deferred_prepass_shader(
-      wpd, false, false, true, WORKBENCH_COLOR_OVERRIDE_TEXTURE, sh_cfg);
-  wpd->prepass_vertex_sh = ensure_deferred_prepass_shader(
-      wpd, false, false, false, WORKBENCH_COLOR_OVERRIDE_VERTEX, sh_cfg);
+  /* The other prepass variants are only needed by some objects,
+   * they are compiled on first use, see #deferred_prepass_shader_get. */
+  wpd->prepass_hair_sh = NULL;
+  wpd->prepass_uniform_sh = NULL;
+  wpd->prepass_uniform_hair_sh = NULL;
+  wpd->prepass_textured_sh = NULL;
+  wpd->prepass_textured_array_sh = NULL;
+  wpd->prepass_vertex_sh = NULL;
   wpd->composite_sh = ensure_deferred_composite_shader(wpd);
   wpd->background_sh = ensure_background_shader(wpd);
 }
 
+static GPUShader *deferred_prepass_shader_get(WORKBENCH_PrivateData *wpd,
+                                              GPUShader **r_shader,
+                                              bool is_uniform_color,
+                                              bool is_hair,
+                                              bool is_tiled,
+                                              const WORKBENCH_ColorOverride color_override)
+{
+  if (*r_shader == NULL) {
+    const DRWContextState *draw_ctx = DRW_context_state_get();
+    *r_shader = ensure_deferred_prepass_shader(
+        wpd, is_uniform_color, is_hair, is_tiled, color_override, draw_ctx->sh_cfg);
+  }
+  return *r_shader;
+}
+
 /* Using Hammersley distribution */
 static float *create_disk_samples(int num_samples, int num_iterations)
 {
@@ -866,14 +877,32 @@ static WORKBENCH_MaterialData *get_or_create_material_data(WORKBENCH_Data *vedat
   if (material == NULL) {
     material = MEM_mallocN(sizeof(WORKBENCH_MaterialData), __func__);
     /* select the correct prepass shader */
-    GPUShader *shader = (wpd->shading.color_type == color_type) ? wpd->prepass_sh :
-                                                                  wpd->prepass_uniform_sh;
+    GPUShader *shader;
     const bool is_tiled = (ima && ima->source == IMA_SRC_TILED);
     if (color_type == V3D_SHADING_TEXTURE_COLOR) {
-      shader = is_tiled ? wpd->prepass_textured_array_sh : wpd->prepass_textured_sh;
+      shader = is_tiled ? deferred_prepass_shader_get(wpd,
+                                                      &wpd->prepass_textured_array_sh,
+                                                      false,
+                                                      false,
+                                                      true,
+                                                      WORKBENCH_COLOR_OVERRIDE_TEXTURE) :
+                          deferred_prepass_shader_get(wpd,
+                                                      &wpd->prepass_textured_sh,
+                                                      false,
+                                                      false,
+                                                      false,
+                                                      WORKBENCH_COLOR_OVERRIDE_TEXTURE);
     }
-    if (color_type == V3D_SHADING_VERTEX_COLOR) {
-      shader = wpd->prepass_vertex_sh;
+    else if (color_type == V3D_SHADING_VERTEX_COLOR) {
+      shader = deferred_prepass_shader_get(
+          wpd, &wpd->prepass_vertex_sh, false, false, false, WORKBENCH_COLOR_OVERRIDE_VERTEX);
+    }
+    else if (wpd->shading.color_type == color_type) {
+      shader = wpd->prepass_sh;
+    }
+    else {
+      shader = deferred_prepass_shader_get(
+          wpd, &wpd->prepass_uniform_sh, true, false, false, WORKBENCH_COLOR_OVERRIDE_OFF);
     }
     material->shgrp = DRW_shgroup_create(
         shader, (ob->dtx & OB_DRAWXRAY) ? psl->ghost_prepass_pass : psl->prepass_pass);
@@ -914,8 +943,18 @@ static void workbench_cache_populate_particles(WORKBENCH_Data *vedata, Object *o
           vedata, ob, mat, image, iuser, color_type, interp);
 
       struct GPUShader *shader = (wpd->shading.color_type == color_type) ?
-                                     wpd->prepass_hair_sh :
-                                     wpd->prepass_uniform_hair_sh;
+                                     deferred_prepass_shader_get(wpd,
+                                                                 &wpd->prepass_hair_sh,
+                                                                 false,
+                                                                 true,
+                                                                 false,
+                                                                 WORKBENCH_COLOR_OVERRIDE_OFF) :
+                                     deferred_prepass_shader_get(wpd,
+                                                                 &wpd->prepass_uniform_hair_sh,
+                                                                 true,
+                                                                 true,
+                                                                 false,
+                                                                 WORKBENCH_COLOR_OVERRIDE_OFF);
       DRWShadingGroup *shgrp = DRW_shgroup_hair_create(
           ob,
           psys,
@@ -1101,6 +1140,9 @@ void workbench_deferred_solid_cache_populate(WORKBENCH_Data *vedata, Object *ob)
         if (color_type == V3D_SHADING_VERTEX_COLOR) {
           geom = DRW_cache_mesh_surface_vertpaint_get(ob);
         }
+        else if (ob->type == OB_MESH) {
+          geom = DRW_cache_mesh_surface_lod_get(ob);
+        }
         else {
           geom = DRW_cache_object_surface_get(ob);
         }
@@ -2771,6 +2771,55 @@ GPUBatch *DRW_cache_mesh_surface_get(Object *ob)
   return DRW_mesh_batch_cache_get_surface(ob->data);
 }
 
+/* Meshes with a bounding sphere smaller than this on screen use the simplified surface. */
+#define MESH_LOD_SCREEN_RADIUS 32.0f
+
+/* Radius of the bounding sphere of the object in pixels, FLT_MAX if the camera is inside. */
+static float drw_object_screen_radius_get(Object *ob)
+{
+  BoundBox *bbox = BKE_object_boundbox_get(ob);
+  if (bbox == NULL) {
+    return FLT_MAX;
+  }
+
+  float center[4], corner[3];
+  mid_v3_v3v3(center, bbox->vec[0], bbox->vec[6]);
+  mul_v3_m4v3(corner, ob->obmat, bbox->vec[0]);
+  mul_m4_v3(ob->obmat, center);
+  const float radius = len_v3v3(center, corner);
+
+  float persmat[4][4], winmat[4][4];
+  DRW_view_persmat_get(NULL, persmat, false);
+  DRW_view_winmat_get(NULL, winmat, false);
+
+  center[3] = 1.0f;
+  mul_m4_v4(persmat, center);
+  /* Always 1 for orthographic views. */
+  const float w = center[3];
+  if (w <= radius) {
+    return FLT_MAX;
+  }
+  return radius * fabsf(winmat[1][1]) * 0.5f * DRW_viewport_size_get()[1] / w;
+}
+
+/**
+ * Return the simplified surface when the mesh only covers a few pixels in the viewport,
+ * the full surface otherwise.
+ */
+GPUBatch *DRW_cache_mesh_surface_lod_get(Object *ob)
+{
+  BLI_assert(ob->type == OB_MESH);
+  /* Selection, depth picking and final renders need the exact surface. */
+  if (!DRW_state_is_image_render() && !DRW_state_is_select() && !DRW_state_is_depth() &&
+      (drw_object_screen_radius_get(ob) < MESH_LOD_SCREEN_RADIUS)) {
+    GPUBatch *geom = DRW_mesh_batch_cache_get_surface_lod(ob->data);
+    if (geom != NULL) {
+      return geom;
+    }
+  }
+  return DRW_mesh_batch_cache_get_surface(ob->data);
+}
+
 GPUBatch *DRW_cache_mesh_surface_edges_get(Object *ob)
 {
   BLI_assert(ob->type == OB_MESH);
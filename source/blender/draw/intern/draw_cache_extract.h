@@ -116,6 +116,7 @@ typedef struct MeshBufferCache {
   struct {
     /* Indices to vloops. */
     GPUIndexBuf *tris;        /* Ordered per material. */
+    GPUIndexBuf *tris_lod;    /* Simplified `tris`, not ordered per material. */
     GPUIndexBuf *lines;       /* Loose edges last. */
     GPUIndexBuf *lines_loose; /* sub buffer of `lines` only containing the loose edges. */
     GPUIndexBuf *points;
@@ -160,8 +161,14 @@ typedef enum DRWBatchFlag {
   MBC_WIRE_LOOPS_UVS = (1 << 25),
   MBC_SURF_PER_MAT = (1 << 26),
   MBC_SKIN_ROOTS = (1 << 27),
+  MBC_SURFACE_LOD = (1 << 28),
 } DRWBatchFlag;
 
+/* Resolution of the vertex clustering grid used to simplify `ibo.tris_lod`. */
+#define MESH_LOD_GRID_RES 32
+/* Meshes with fewer triangles are not worth simplifying. */
+#define MESH_LOD_MIN_TRI_LEN 50000
+
 #define MBC_EDITUV \
   (MBC_EDITUV_FACES_STRETCH_AREA | MBC_EDITUV_FACES_STRETCH_ANGLE | MBC_EDITUV_FACES | \
    MBC_EDITUV_EDGES | MBC_EDITUV_VERTS | MBC_EDITUV_FACEDOTS | MBC_WIRE_LOOPS_UVS)
@@ -180,6 +187,7 @@ typedef struct MeshBatchCache {
     /* Surfaces / Render */
     GPUBatch *surface;
     GPUBatch *surface_weights;
+    GPUBatch *surface_lod;
     /* Edit mode */
     GPUBatch *edit_triangles;
     GPUBatch *edit_vertices;
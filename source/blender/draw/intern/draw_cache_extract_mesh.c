@@ -561,6 +561,139 @@ static const MeshExtract extract_tris = {
 
 /** \} */
 
+/* ---------------------------------------------------------------------- */
+/** \name Extract Simplified Triangles Indices
+ *
+ * Vertex clustering: positions are snapped to a regular grid over the mesh bounds, each grid
+ * cell is represented by the first loop found inside it, and triangles whose corners end up in
+ * less than three different cells are removed. Only reuses the loops of the full mesh so the
+ * same vertex buffers can be used.
+ * \{ */
+
+typedef struct MeshExtract_TriLod_Data {
+  GPUIndexBufBuilder elb;
+  float min[3];
+  float cell_scale[3];
+  /** First loop found in each cell, -1 if none. */
+  int *cell_loop;
+} MeshExtract_TriLod_Data;
+
+static void *extract_tris_lod_init(const MeshRenderData *mr, void *UNUSED(ibo))
+{
+  MeshExtract_TriLod_Data *data = MEM_callocN(sizeof(*data), __func__);
+
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter;
+    BMVert *eve;
+    BM_ITER_MESH (eve, &iter, mr->bm, BM_VERTS_OF_MESH) {
+      minmax_v3v3_v3(min, max, eve->co);
+    }
+  }
+  else {
+    for (int v = 0; v < mr->vert_len; v++) {
+      minmax_v3v3_v3(min, max, mr->mvert[v].co);
+    }
+  }
+
+  copy_v3_v3(data->min, min);
+  for (int i = 0; i < 3; i++) {
+    float size = max[i] - min[i];
+    data->cell_scale[i] = (size > 0.0f) ? MESH_LOD_GRID_RES / size : 0.0f;
+  }
+
+  const int cell_len = MESH_LOD_GRID_RES * MESH_LOD_GRID_RES * MESH_LOD_GRID_RES;
+  data->cell_loop = MEM_mallocN(sizeof(int) * cell_len, __func__);
+  copy_vn_i(data->cell_loop, cell_len, -1);
+
+  GPU_indexbuf_init(&data->elb, GPU_PRIM_TRIS, mr->tri_len, mr->loop_len);
+  return data;
+}
+
+/* Return the loop representing the cell containing \a co. */
+BLI_INLINE int extract_tris_lod_cell_loop(MeshExtract_TriLod_Data *data,
+                                          const float co[3],
+                                          int loop)
+{
+  int cell = 0;
+  for (int i = 0; i < 3; i++) {
+    int coord = (int)((co[i] - data->min[i]) * data->cell_scale[i]);
+    CLAMP(coord, 0, MESH_LOD_GRID_RES - 1);
+    cell = cell * MESH_LOD_GRID_RES + coord;
+  }
+  if (data->cell_loop[cell] == -1) {
+    data->cell_loop[cell] = loop;
+  }
+  return data->cell_loop[cell];
+}
+
+static void extract_tris_lod_add(MeshExtract_TriLod_Data *data, int l0, int l1, int l2)
+{
+  /* Collapsed triangle. */
+  if (ELEM(l0, l1, l2) || l1 == l2) {
+    return;
+  }
+  GPU_indexbuf_add_tri_verts(&data->elb, l0, l1, l2);
+}
+
+static void extract_tris_lod_looptri_bmesh(const MeshRenderData *UNUSED(mr),
+                                           int UNUSED(t),
+                                           BMLoop **elt,
+                                           void *_data)
+{
+  if (!BM_elem_flag_test(elt[0]->f, BM_ELEM_HIDDEN)) {
+    MeshExtract_TriLod_Data *data = _data;
+    int l[3];
+    for (int i = 0; i < 3; i++) {
+      l[i] = extract_tris_lod_cell_loop(data, elt[i]->v->co, BM_elem_index_get(elt[i]));
+    }
+    extract_tris_lod_add(data, l[0], l[1], l[2]);
+  }
+}
+
+static void extract_tris_lod_looptri_mesh(const MeshRenderData *mr,
+                                          int UNUSED(t),
+                                          const MLoopTri *mlt,
+                                          void *_data)
+{
+  const MPoly *mpoly = &mr->mpoly[mlt->poly];
+  if (!(mr->use_hide && (mpoly->flag & ME_HIDE))) {
+    MeshExtract_TriLod_Data *data = _data;
+    int l[3];
+    for (int i = 0; i < 3; i++) {
+      const MVert *mv = &mr->mvert[mr->mloop[mlt->tri[i]].v];
+      l[i] = extract_tris_lod_cell_loop(data, mv->co, mlt->tri[i]);
+    }
+    extract_tris_lod_add(data, l[0], l[1], l[2]);
+  }
+}
+
+static void extract_tris_lod_finish(const MeshRenderData *UNUSED(mr), void *ibo, void *_data)
+{
+  MeshExtract_TriLod_Data *data = _data;
+  GPU_indexbuf_build_in_place(&data->elb, ibo);
+  MEM_freeN(data->cell_loop);
+  MEM_freeN(data);
+}
+
+static const MeshExtract extract_tris_lod = {
+    extract_tris_lod_init,
+    extract_tris_lod_looptri_bmesh,
+    extract_tris_lod_looptri_mesh,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    extract_tris_lod_finish,
+    0,
+    false,
+};
+
+/** \} */
+
 /* ---------------------------------------------------------------------- */
 /** \name Extract Edges Indices
  * \{ */
@@ -4604,6 +4737,7 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   TEST_ASSIGN(VBO, vbo, skin_roots);
 
   TEST_ASSIGN(IBO, ibo, tris);
+  TEST_ASSIGN(IBO, ibo, tris_lod);
   TEST_ASSIGN(IBO, ibo, lines);
   TEST_ASSIGN(IBO, ibo, points);
   TEST_ASSIGN(IBO, ibo, fdots);
@@ -4673,6 +4807,7 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   EXTRACT(vbo, skin_roots);
 
   EXTRACT(ibo, tris);
+  EXTRACT(ibo, tris_lod);
   EXTRACT(ibo, lines);
   EXTRACT(ibo, points);
   EXTRACT(ibo, fdots);
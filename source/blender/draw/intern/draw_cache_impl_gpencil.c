@@ -36,8 +36,9 @@
 
 #include "DEG_depsgraph_query.h"
 
-#include "BLI_polyfill_2d.h"
 #include "BLI_hash.h"
+#include "BLI_polyfill_2d.h"
+#include "BLI_task.h"
 
 #include "draw_cache.h"
 #include "draw_cache_impl.h"
@@ -233,6 +234,9 @@ typedef struct gpIterData {
   GPUIndexBufBuilder ibo;
   int vert_len;
   int tri_len;
+  /** Visible strokes, gathered to fill the buffers in parallel. */
+  bGPDstroke **strokes;
+  int stroke_len;
 } gpIterData;
 
 static GPUVertBuf *gpencil_dummy_buffer_get(void)
@@ -330,22 +334,35 @@ static void gpencil_buffer_add_stroke(gpStrokeVert *verts,
   gpencil_buffer_add_point(verts, cols, gps, &pts[adj_idx], v++, true);
 }
 
+/* Write the fill triangles at the stroke's own offset so strokes can be added in any order. */
 static void gpencil_buffer_add_fill(GPUIndexBufBuilder *ibo, const bGPDstroke *gps)
 {
   int tri_len = gps->tot_triangles;
   int v = gps->runtime.stroke_start;
+  uint *data = &ibo->data[gps->runtime.fill_start * 3];
   for (int i = 0; i < tri_len; i++) {
     uint *tri = gps->triangles[i].verts;
-    GPU_indexbuf_add_tri_verts(ibo, v + tri[0], v + tri[1], v + tri[2]);
+    data[i * 3 + 0] = v + tri[0];
+    data[i * 3 + 1] = v + tri[1];
+    data[i * 3 + 2] = v + tri[2];
   }
 }
 
-static void gpencil_stroke_iter_cb(bGPDlayer *UNUSED(gpl),
-                                   bGPDframe *UNUSED(gpf),
-                                   bGPDstroke *gps,
-                                   void *thunk)
+static void gpencil_stroke_gather_cb(bGPDlayer *UNUSED(gpl),
+                                     bGPDframe *UNUSED(gpf),
+                                     bGPDstroke *gps,
+                                     void *thunk)
 {
   gpIterData *iter = (gpIterData *)thunk;
+  iter->strokes[iter->stroke_len++] = gps;
+}
+
+static void gpencil_stroke_fill_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  gpIterData *iter = (gpIterData *)userdata;
+  bGPDstroke *gps = iter->strokes[i];
   gpencil_buffer_add_stroke(iter->verts, iter->cols, gps);
   if (gps->tot_triangles > 0) {
     gpencil_buffer_add_fill(&iter->ibo, gps);
@@ -364,6 +381,7 @@ static void gp_object_verts_count_cb(bGPDlayer *UNUSED(gpl),
   gps->runtime.fill_start = iter->tri_len;
   iter->vert_len += gps->totpoints + 2 + gpencil_stroke_is_cyclic(gps);
   iter->tri_len += gps->tot_triangles;
+  iter->stroke_len++;
 }
 
 static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfra)
@@ -388,6 +406,7 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
         .ibo = {0},
         .vert_len = 1, /* Start at 1 for the gl_InstanceID trick to work (see vert shader). */
         .tri_len = 0,
+        .stroke_len = 0,
     };
     BKE_gpencil_visible_stroke_iter(ob, NULL, gp_object_verts_count_cb, &iter, do_onion, cfra);
 
@@ -404,8 +423,18 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
     /* Create IBO. */
     GPU_indexbuf_init(&iter.ibo, GPU_PRIM_TRIS, iter.tri_len, iter.vert_len);
 
-    /* Fill buffers with data. */
-    BKE_gpencil_visible_stroke_iter(ob, NULL, gpencil_stroke_iter_cb, &iter, do_onion, cfra);
+    /* Fill buffers with data. Each stroke has its own range of vertices and triangles
+     * computed by the counting pass, so they can be written in parallel. */
+    iter.strokes = MEM_mallocN(sizeof(*iter.strokes) * max_ii(1, iter.stroke_len), __func__);
+    iter.stroke_len = 0;
+    BKE_gpencil_visible_stroke_iter(ob, NULL, gpencil_stroke_gather_cb, &iter, do_onion, cfra);
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 64;
+    BLI_task_parallel_range(0, iter.stroke_len, &iter, gpencil_stroke_fill_cb, &settings);
+    iter.ibo.index_len = iter.tri_len * 3;
+    MEM_freeN(iter.strokes);
 
     /* Mark last 2 verts as invalid. */
     for (int i = 0; i < 2; i++) {
@@ -426,6 +426,8 @@ static void mesh_batch_cache_discard_shaded_tri(MeshBatchCache *cache)
     GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.orco);
   }
   mesh_batch_cache_discard_shaded_batches(cache);
+  GPU_BATCH_DISCARD_SAFE(cache->batch.surface_lod);
+  cache->batch_ready &= ~MBC_SURFACE_LOD;
   mesh_cd_layers_type_clear(&cache->cd_used);
 
   MEM_SAFE_FREE(cache->surface_per_mat);
@@ -493,6 +495,45 @@ static void mesh_batch_cache_discard_uvedit_select(MeshBatchCache *cache)
   cache->batch_ready &= ~MBC_EDITUV;
 }
 
+/**
+ * Only vertex coordinates changed (e.g. during transform in edit-mode).
+ * Discard the buffers that depend on positions and keep the ones that only depend on topology,
+ * selection or custom-data, so the next extraction only has to rebuild what actually changed.
+ */
+static void mesh_batch_cache_discard_deform(MeshBatchCache *cache)
+{
+  FOREACH_MESH_BUFFER_CACHE(cache, mbufcache)
+  {
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.pos_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.lnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.orco);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.skin_roots);
+    /* N-gon tessellation depends on the vertex positions. */
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.tris);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.tris_lod);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.lines_adjacency);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.edituv_tris);
+  }
+  /* Batches are cheap to rebuild, only the buffers are worth keeping. */
+  for (int i = 0; i < sizeof(cache->batch) / sizeof(void *); i++) {
+    GPUBatch **batch = (GPUBatch **)&cache->batch;
+    GPU_BATCH_DISCARD_SAFE(batch[i]);
+  }
+  mesh_batch_cache_discard_shaded_batches(cache);
+
+  cache->tot_area = 0.0f;
+  cache->tot_uv_area = 0.0f;
+
+  cache->batch_ready = 0;
+}
+
 void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
 {
   MeshBatchCache *cache = me->runtime.batch_cache;
@@ -532,6 +573,7 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
         GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.lnor);
       }
       GPU_BATCH_DISCARD_SAFE(cache->batch.surface);
+      GPU_BATCH_DISCARD_SAFE(cache->batch.surface_lod);
       GPU_BATCH_DISCARD_SAFE(cache->batch.wire_loops);
       GPU_BATCH_DISCARD_SAFE(cache->batch.wire_edges);
       if (cache->surface_per_mat) {
@@ -539,11 +581,15 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
           GPU_BATCH_DISCARD_SAFE(cache->surface_per_mat[i]);
         }
       }
-      cache->batch_ready &= ~(MBC_SURFACE | MBC_WIRE_EDGES | MBC_WIRE_LOOPS | MBC_SURF_PER_MAT);
+      cache->batch_ready &= ~(MBC_SURFACE | MBC_SURFACE_LOD | MBC_WIRE_EDGES | MBC_WIRE_LOOPS |
+                              MBC_SURF_PER_MAT);
       break;
     case BKE_MESH_BATCH_DIRTY_ALL:
       cache->is_dirty = true;
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      mesh_batch_cache_discard_deform(cache);
+      break;
     case BKE_MESH_BATCH_DIRTY_SHADING:
       mesh_batch_cache_discard_shaded_tri(cache);
       mesh_batch_cache_discard_uvedit(cache);
@@ -659,6 +705,21 @@ GPUBatch *DRW_mesh_batch_cache_get_surface(Mesh *me)
   return DRW_batch_request(&cache->batch.surface);
 }
 
+/**
+ * Simplified version of the surface for meshes covering few pixels on screen.
+ * Return NULL for meshes too small to benefit from it, and in edit-mode.
+ */
+GPUBatch *DRW_mesh_batch_cache_get_surface_lod(Mesh *me)
+{
+  if ((me->edit_mesh != NULL) ||
+      (poly_to_tri_count(me->totpoly, me->totloop) < MESH_LOD_MIN_TRI_LEN)) {
+    return NULL;
+  }
+  MeshBatchCache *cache = mesh_batch_cache_get(me);
+  mesh_batch_cache_add_request(cache, MBC_SURFACE_LOD);
+  return DRW_batch_request(&cache->batch.surface_lod);
+}
+
 GPUBatch *DRW_mesh_batch_cache_get_loose_edges(Mesh *me)
 {
   MeshBatchCache *cache = mesh_batch_cache_get(me);
@@ -1154,6 +1215,11 @@ void DRW_mesh_batch_cache_create_requested(
       DRW_vbo_request(cache->batch.surface, &mbufcache->vbo.vcol);
     }
   }
+  if (DRW_batch_requested(cache->batch.surface_lod, GPU_PRIM_TRIS)) {
+    DRW_ibo_request(cache->batch.surface_lod, &mbufcache->ibo.tris_lod);
+    DRW_vbo_request(cache->batch.surface_lod, &mbufcache->vbo.lnor);
+    DRW_vbo_request(cache->batch.surface_lod, &mbufcache->vbo.pos_nor);
+  }
   if (DRW_batch_requested(cache->batch.all_verts, GPU_PRIM_POINTS)) {
     DRW_vbo_request(cache->batch.all_verts, &mbufcache->vbo.pos_nor);
   }
@@ -385,6 +385,9 @@ struct DRWView {
   /** Custom visibility function. */
   DRWCallVisibilityFn *visibility_fn;
   void *user_data;
+  /** Occlusion culling, see #DRW_view_occlusion_set. NULL if disabled. */
+  const float *occlusion_depth;
+  int occlusion_size[2];
 };
 
 /* ------------ Data Chunks --------------- */
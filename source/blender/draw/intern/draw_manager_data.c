@@ -1619,6 +1619,7 @@ DRWView *DRW_view_create(const float viewmat[4][4],
   view->clip_planes_len = 0;
   view->visibility_fn = visibility_fn;
   view->parent = NULL;
+  view->occlusion_depth = NULL;
 
   copy_v4_fl4(view->storage.viewcamtexcofac, 1.0f, 1.0f, 0.0f, 0.0f);
 
@@ -1767,6 +1768,21 @@ void DRW_view_camtexco_set(DRWView *view, float texco[4])
   copy_v4_v4(view->storage.viewcamtexcofac, texco);
 }
 
+/**
+ * Enable occlusion culling for \a view using a buffer of maximum window space depth,
+ * usually a low resolution level of a depth pyramid.
+ * The buffer must have been rendered using the same view matrices and scene state,
+ * and must stay valid while the view is drawn. Pass NULL to disable.
+ */
+void DRW_view_occlusion_set(DRWView *view, const float *depth, int width, int height)
+{
+  BLI_assert(view->parent == NULL);
+  view->occlusion_depth = depth;
+  view->occlusion_size[0] = width;
+  view->occlusion_size[1] = height;
+  view->is_dirty = true;
+}
+
 /* Return world space frustum corners. */
 void DRW_view_frustum_corners_get(const DRWView *view, BoundBox *corners)
 {
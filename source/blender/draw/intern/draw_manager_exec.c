@@ -25,6 +25,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -586,6 +587,59 @@ bool DRW_culling_min_max_test(const DRWView *view, float obmat[4][4], float min[
   return true;
 }
 
+/* Conservative test of a sphere against the view occlusion depth buffer.
+ * Return true if the sphere may be visible. */
+static bool draw_culling_occlusion_test(const DRWView *view, const BoundSphere *bsphere)
+{
+  const float(*persmat)[4] = view->storage.persmat;
+  float rect_min[2] = {FLT_MAX, FLT_MAX};
+  float rect_max[2] = {-FLT_MAX, -FLT_MAX};
+  float depth_min = FLT_MAX;
+
+  /* The projection of the bounding box of the sphere contains the projection of the sphere,
+   * and its nearest corner is at least as close as the sphere. */
+  for (int i = 0; i < 8; i++) {
+    float co[4] = {
+        bsphere->center[0] + ((i & 1) ? bsphere->radius : -bsphere->radius),
+        bsphere->center[1] + ((i & 2) ? bsphere->radius : -bsphere->radius),
+        bsphere->center[2] + ((i & 4) ? bsphere->radius : -bsphere->radius),
+        1.0f,
+    };
+    mul_m4_v4(persmat, co);
+    if (co[3] <= 0.0f) {
+      /* Crosses the camera plane. */
+      return true;
+    }
+    mul_v3_fl(co, 1.0f / co[3]);
+    minmax_v2v2_v2(rect_min, rect_max, co);
+    depth_min = min_ff(depth_min, co[2] * 0.5f + 0.5f);
+  }
+
+  if (depth_min <= 0.0f) {
+    return true;
+  }
+
+  const int width = view->occlusion_size[0];
+  const int height = view->occlusion_size[1];
+  /* Grow the rectangle by one texel to account for the sub-pixel jitter of the view
+   * and the texels lost when downsampling odd sized levels. */
+  const int xmin = max_ii(0, (int)floorf((rect_min[0] * 0.5f + 0.5f) * width) - 1);
+  const int ymin = max_ii(0, (int)floorf((rect_min[1] * 0.5f + 0.5f) * height) - 1);
+  const int xmax = min_ii(width - 1, (int)floorf((rect_max[0] * 0.5f + 0.5f) * width) + 1);
+  const int ymax = min_ii(height - 1, (int)floorf((rect_max[1] * 0.5f + 0.5f) * height) + 1);
+
+  for (int y = ymin; y <= ymax; y++) {
+    const float *depth = view->occlusion_depth + y * width;
+    for (int x = xmin; x <= xmax; x++) {
+      if (depth[x] >= depth_min) {
+        return true;
+      }
+    }
+  }
+  /* Fully behind the depth buffer, or outside the view. */
+  return false;
+}
+
 void DRW_culling_frustum_corners_get(const DRWView *view, BoundBox *corners)
 {
   view = view ? view : DST.view_default;
@@ -598,47 +652,88 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float) * 6 * 4);
 }
 
+static void draw_compute_culling_state(DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+
+    if (!culled && view->occlusion_depth) {
+      culled = !draw_culling_occlusion_test(view, &cull->bsphere);
+    }
+
+#ifdef DRW_DEBUG_CULLING
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
+      }
+      else {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
+#endif
+
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
+    }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+typedef struct DRWCullingTaskData {
+  DRWView *view;
+  /* Number of culling states in the last resource chunk. */
+  int last_chunk_len;
+  int chunk_len;
+} DRWCullingTaskData;
+
+static void draw_compute_culling_chunk_cb(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DRWCullingTaskData *data = userdata;
+  const int len = (chunk == data->chunk_len - 1) ? data->last_chunk_len : DRW_RESOURCE_CHUNK_LEN;
+
+  for (int i = 0; i < len; i++) {
+    DRWCullingState *cull = BLI_memblock_elem_get(DST.vmempool->cullstates, chunk, i);
+    draw_compute_culling_state(data->view, cull);
+  }
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
 
-  /* TODO(fclem) multithread this. */
   /* TODO(fclem) compute all dirty views at once. */
   if (!view->is_dirty) {
     return;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
-    }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+  /* Culling states are allocated alongside resource handles,
+   * one chunk of the memblock per resource chunk. */
+  const int chunk = DRW_handle_chunk_get(&DST.resource_handle);
+  const int elem = DRW_handle_id_get(&DST.resource_handle);
+
+  DRWCullingTaskData data = {
+      .view = view,
+      .last_chunk_len = (elem == 0) ? DRW_RESOURCE_CHUNK_LEN : elem,
+      .chunk_len = 1 + chunk - ((elem == 0) ? 1 : 0),
+  };
 
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Visibility callbacks may write to engine data, keep them on this thread. */
+  settings.use_threading = (view->visibility_fn == NULL);
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
-      }
+  settings.use_threading = false;
 #endif
-
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
-
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
-    }
-  }
+  BLI_task_parallel_range(0, data.chunk_len, &data, draw_compute_culling_chunk_cb, &settings);
 
   view->is_dirty = false;
 }
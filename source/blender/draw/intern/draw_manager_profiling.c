@@ -119,8 +119,9 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
         glGenQueries(1, timer->query);
       }
 
-      glFinish();
-      /* Issue query for the next frame */
+      /* Issue query for the next frame. Time elapsed queries only measure the GPU work done
+       * between begin and end, so there is no need to stall the CPU waiting for the GPU here,
+       * which would make every profiled pass wait for all previous work. */
       glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
       DTP.is_querying = true;
     }
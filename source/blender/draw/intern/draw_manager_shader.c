@@ -24,7 +24,9 @@
 #include "DNA_world_types.h"
 #include "DNA_material_types.h"
 
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_string_utils.h"
 #include "BLI_threads.h"
 
@@ -33,6 +35,7 @@
 
 #include "DEG_depsgraph_query.h"
 
+#include "GPU_glew.h"
 #include "GPU_shader.h"
 #include "GPU_material.h"
 
@@ -62,15 +65,30 @@ typedef struct DRWDeferredShader {
   GPUMaterial *mat;
 } DRWDeferredShader;
 
-typedef struct DRWShaderCompiler {
-  ListBase queue;          /* DRWDeferredShader */
-  ListBase queue_conclude; /* DRWDeferredShader */
-  SpinLock list_lock;
+/* Compilation threads, each one with its own GL context. */
+#define DRW_SHADER_COMPILER_WORKERS_MAX 4
+
+typedef struct DRWShaderCompilerWorker {
+  struct DRWShaderCompiler *comp;
 
   DRWDeferredShader *mat_compiling;
   ThreadMutex compilation_lock;
 
   void *gl_context;
+
+  /* From the job, also used by the additional threads. */
+  short *stop, *do_update;
+  float *progress;
+} DRWShaderCompilerWorker;
+
+typedef struct DRWShaderCompiler {
+  ListBase queue;          /* DRWDeferredShader */
+  ListBase queue_conclude; /* DRWDeferredShader */
+  GHash *queue_map;        /* GPUMaterial -> DRWDeferredShader in queue. */
+  SpinLock list_lock;
+
+  DRWShaderCompilerWorker workers[DRW_SHADER_COMPILER_WORKERS_MAX];
+  int workers_len;
   bool own_context;
 
   int shaders_done; /* To compute progress. */
@@ -90,20 +108,28 @@ static void drw_deferred_shader_queue_free(ListBase *queue)
   }
 }
 
-static void drw_deferred_shader_compilation_exec(void *custom_data,
-                                                 short *stop,
-                                                 short *do_update,
-                                                 float *progress)
+/**
+ * Number of compilation threads (and GL contexts) to use. Only drivers advertising parallel
+ * shader compilation are trusted to compile efficiently from several contexts at once.
+ */
+static int drw_deferred_shader_workers_len(void)
 {
-  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
-  void *gl_context = comp->gl_context;
+  if (!GLEW_ARB_parallel_shader_compile) {
+    return 1;
+  }
+  return max_ii(1, min_ii(BLI_system_thread_count() / 2, DRW_SHADER_COMPILER_WORKERS_MAX));
+}
 
-  WM_opengl_context_activate(gl_context);
+static void drw_deferred_shader_worker_exec(DRWShaderCompilerWorker *worker)
+{
+  DRWShaderCompiler *comp = worker->comp;
+
+  WM_opengl_context_activate(worker->gl_context);
 
   while (true) {
     BLI_spin_lock(&comp->list_lock);
 
-    if (*stop != 0) {
+    if (*worker->stop != 0) {
       /* We don't want user to be able to cancel the compilation
        * but wm can kill the task if we are closing blender. */
       BLI_spin_unlock(&comp->list_lock);
@@ -111,41 +137,80 @@ static void drw_deferred_shader_compilation_exec(void *custom_data,
     }
 
     /* Pop tail because it will be less likely to lock the main thread
-     * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()). */
-    comp->mat_compiling = BLI_poptail(&comp->queue);
-    if (comp->mat_compiling == NULL) {
+     * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()).
+     * This is also where materials requested by the last redraw are moved,
+     * see #drw_deferred_shader_prioritize(). */
+    worker->mat_compiling = BLI_poptail(&comp->queue);
+    if (worker->mat_compiling == NULL) {
       /* No more Shader to compile. */
       BLI_spin_unlock(&comp->list_lock);
       break;
     }
+    BLI_ghash_remove(comp->queue_map, worker->mat_compiling->mat, NULL, NULL);
 
     comp->shaders_done++;
-    int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
 
-    BLI_mutex_lock(&comp->compilation_lock);
+    BLI_mutex_lock(&worker->compilation_lock);
     BLI_spin_unlock(&comp->list_lock);
 
     /* Do the compilation. */
-    GPU_material_compile(comp->mat_compiling->mat);
-
-    *progress = (float)comp->shaders_done / (float)total;
-    *do_update = true;
+    GPU_material_compile(worker->mat_compiling->mat);
 
     GPU_flush();
-    BLI_mutex_unlock(&comp->compilation_lock);
+    BLI_mutex_unlock(&worker->compilation_lock);
 
     BLI_spin_lock(&comp->list_lock);
-    if (GPU_material_status(comp->mat_compiling->mat) == GPU_MAT_QUEUED) {
-      BLI_addtail(&comp->queue_conclude, comp->mat_compiling);
+    int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
+    *worker->progress = (float)comp->shaders_done / (float)total;
+    *worker->do_update = true;
+
+    if (GPU_material_status(worker->mat_compiling->mat) == GPU_MAT_QUEUED) {
+      BLI_addtail(&comp->queue_conclude, worker->mat_compiling);
     }
     else {
-      drw_deferred_shader_free(comp->mat_compiling);
+      drw_deferred_shader_free(worker->mat_compiling);
     }
-    comp->mat_compiling = NULL;
+    worker->mat_compiling = NULL;
     BLI_spin_unlock(&comp->list_lock);
   }
 
-  WM_opengl_context_release(gl_context);
+  WM_opengl_context_release(worker->gl_context);
+}
+
+static void *drw_deferred_shader_worker_thread(void *worker_v)
+{
+  drw_deferred_shader_worker_exec(worker_v);
+  return NULL;
+}
+
+static void drw_deferred_shader_compilation_exec(void *custom_data,
+                                                 short *stop,
+                                                 short *do_update,
+                                                 float *progress)
+{
+  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
+
+  for (int i = 0; i < comp->workers_len; i++) {
+    DRWShaderCompilerWorker *worker = &comp->workers[i];
+    worker->stop = stop;
+    worker->do_update = do_update;
+    worker->progress = progress;
+  }
+
+  /* The job thread is the first worker, others get their own thread. */
+  ListBase threads = {NULL, NULL};
+  if (comp->workers_len > 1) {
+    BLI_threadpool_init(&threads, drw_deferred_shader_worker_thread, comp->workers_len - 1);
+    for (int i = 1; i < comp->workers_len; i++) {
+      BLI_threadpool_insert(&threads, &comp->workers[i]);
+    }
+  }
+
+  drw_deferred_shader_worker_exec(&comp->workers[0]);
+
+  if (comp->workers_len > 1) {
+    BLI_threadpool_end(&threads);
+  }
 }
 
 static void drw_deferred_shader_compilation_free(void *custom_data)
@@ -153,6 +218,9 @@ static void drw_deferred_shader_compilation_free(void *custom_data)
   DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
 
   drw_deferred_shader_queue_free(&comp->queue);
+  if (comp->queue_map) {
+    BLI_ghash_free(comp->queue_map, NULL, NULL);
+  }
 
   if (!BLI_listbase_is_empty(&comp->queue_conclude)) {
     /* Compile the shaders in the context they will be deleted. */
@@ -166,16 +234,36 @@ static void drw_deferred_shader_compilation_free(void *custom_data)
   }
 
   BLI_spin_end(&comp->list_lock);
-  BLI_mutex_end(&comp->compilation_lock);
 
-  if (comp->own_context) {
-    /* Only destroy if the job owns the context. */
-    WM_opengl_context_dispose(comp->gl_context);
+  for (int i = 0; i < comp->workers_len; i++) {
+    DRWShaderCompilerWorker *worker = &comp->workers[i];
+    BLI_mutex_end(&worker->compilation_lock);
+
+    if (comp->own_context) {
+      /* Only destroy if the job owns the context. */
+      WM_opengl_context_dispose(worker->gl_context);
+    }
   }
 
   MEM_freeN(comp);
 }
 
+/**
+ * Get the compiler of the running job, NULL if there is none.
+ */
+static DRWShaderCompiler *drw_deferred_shader_compiler_get(wmWindowManager *wm,
+                                                           wmWindow *win,
+                                                           Scene *scene)
+{
+  if (WM_jobs_test(wm, scene, WM_JOB_TYPE_SHADER_COMPILATION) == false) {
+    /* No job running, do not create a new one by calling WM_jobs_get. */
+    return NULL;
+  }
+  wmJob *wm_job = WM_jobs_get(
+      wm, win, scene, "Shaders Compilation", WM_JOB_PROGRESS, WM_JOB_TYPE_SHADER_COMPILATION);
+  return (DRWShaderCompiler *)WM_jobs_customdata_get(wm_job);
+}
+
 static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 {
   /* Do not defer the compilation if we are rendering for image.
@@ -209,29 +297,46 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 
   DRWShaderCompiler *comp = MEM_callocN(sizeof(DRWShaderCompiler), "DRWShaderCompiler");
   BLI_spin_init(&comp->list_lock);
-  BLI_mutex_init(&comp->compilation_lock);
 
   if (old_comp) {
     BLI_spin_lock(&old_comp->list_lock);
     BLI_movelisttolist(&comp->queue, &old_comp->queue);
+    /* The map goes with the queue, the old job has nothing left to pop. */
+    comp->queue_map = old_comp->queue_map;
+    old_comp->queue_map = NULL;
     BLI_spin_unlock(&old_comp->list_lock);
-    /* Do not recreate context, just pass ownership. */
-    if (old_comp->gl_context) {
-      comp->gl_context = old_comp->gl_context;
+    /* Do not recreate contexts, just pass ownership. */
+    if (old_comp->workers_len != 0) {
+      comp->workers_len = old_comp->workers_len;
+      for (int i = 0; i < comp->workers_len; i++) {
+        comp->workers[i].gl_context = old_comp->workers[i].gl_context;
+      }
       old_comp->own_context = false;
       comp->own_context = true;
     }
   }
 
+  if (comp->queue_map == NULL) {
+    comp->queue_map = BLI_ghash_ptr_new(__func__);
+  }
   BLI_addtail(&comp->queue, dsh);
+  BLI_ghash_insert(comp->queue_map, mat, dsh);
 
-  /* Create only one context. */
-  if (comp->gl_context == NULL) {
-    comp->gl_context = WM_opengl_context_create();
+  /* Create contexts only once. */
+  if (comp->workers_len == 0) {
+    comp->workers_len = drw_deferred_shader_workers_len();
+    for (int i = 0; i < comp->workers_len; i++) {
+      comp->workers[i].gl_context = WM_opengl_context_create();
+    }
     WM_opengl_context_activate(DST.gl_context);
     comp->own_context = true;
   }
 
+  for (int i = 0; i < comp->workers_len; i++) {
+    comp->workers[i].comp = comp;
+    BLI_mutex_init(&comp->workers[i].compilation_lock);
+  }
+
   WM_jobs_customdata_set(wm_job, comp, drw_deferred_shader_compilation_free);
   WM_jobs_timer(wm_job, 0.1, NC_MATERIAL | ND_SHADING_DRAW, 0);
   WM_jobs_delay_start(wm_job, 0.1);
@@ -239,6 +344,35 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
   WM_jobs_start(wm, wm_job);
 }
 
+/**
+ * A material still waiting for compilation was requested again while drawing.
+ * Move it to the end of the queue, so it is compiled before materials which
+ * are not drawn anymore (e.g. hidden objects or another scene).
+ */
+static void drw_deferred_shader_prioritize(GPUMaterial *mat)
+{
+  if (DST.draw_ctx.evil_C == NULL) {
+    return;
+  }
+
+  wmWindowManager *wm = CTX_wm_manager(DST.draw_ctx.evil_C);
+  wmWindow *win = CTX_wm_window(DST.draw_ctx.evil_C);
+  Scene *scene = (Scene *)DEG_get_original_id(&DST.draw_ctx.scene->id);
+
+  DRWShaderCompiler *comp = drw_deferred_shader_compiler_get(wm, win, scene);
+  if (comp == NULL) {
+    return;
+  }
+
+  BLI_spin_lock(&comp->list_lock);
+  DRWDeferredShader *dsh = comp->queue_map ? BLI_ghash_lookup(comp->queue_map, mat) : NULL;
+  if (dsh && dsh != comp->queue.last) {
+    BLI_remlink(&comp->queue, dsh);
+    BLI_addtail(&comp->queue, dsh);
+  }
+  BLI_spin_unlock(&comp->list_lock);
+}
+
 void DRW_deferred_shader_remove(GPUMaterial *mat)
 {
   Scene *scene = GPU_material_scene(mat);
@@ -249,23 +383,24 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
       continue;
     }
     for (wmWindow *win = wm->windows.first; win; win = win->next) {
-      wmJob *wm_job = WM_jobs_get(
-          wm, win, scene, "Shaders Compilation", WM_JOB_PROGRESS, WM_JOB_TYPE_SHADER_COMPILATION);
-
-      DRWShaderCompiler *comp = (DRWShaderCompiler *)WM_jobs_customdata_get(wm_job);
+      DRWShaderCompiler *comp = drw_deferred_shader_compiler_get(wm, win, scene);
       if (comp != NULL) {
         BLI_spin_lock(&comp->list_lock);
-        DRWDeferredShader *dsh;
-        dsh = (DRWDeferredShader *)BLI_findptr(
-            &comp->queue, mat, offsetof(DRWDeferredShader, mat));
+        DRWDeferredShader *dsh = NULL;
+        if (comp->queue_map) {
+          dsh = BLI_ghash_popkey(comp->queue_map, mat, NULL);
+        }
         if (dsh) {
           BLI_remlink(&comp->queue, dsh);
         }
 
         /* Wait for compilation to finish */
-        if ((comp->mat_compiling != NULL) && (comp->mat_compiling->mat == mat)) {
-          BLI_mutex_lock(&comp->compilation_lock);
-          BLI_mutex_unlock(&comp->compilation_lock);
+        for (int i = 0; i < comp->workers_len; i++) {
+          DRWShaderCompilerWorker *worker = &comp->workers[i];
+          if ((worker->mat_compiling != NULL) && (worker->mat_compiling->mat == mat)) {
+            BLI_mutex_lock(&worker->compilation_lock);
+            BLI_mutex_unlock(&worker->compilation_lock);
+          }
         }
 
         BLI_spin_unlock(&comp->list_lock);
@@ -367,6 +502,9 @@ GPUMaterial *DRW_shader_find_from_world(World *wo,
       return NULL;
     }
   }
+  else if (mat != NULL && GPU_material_status(mat) == GPU_MAT_QUEUED) {
+    drw_deferred_shader_prioritize(mat);
+  }
   return mat;
 }
 
@@ -383,6 +521,9 @@ GPUMaterial *DRW_shader_find_from_material(Material *ma,
       return NULL;
     }
   }
+  else if (mat != NULL && GPU_material_status(mat) == GPU_MAT_QUEUED) {
+    drw_deferred_shader_prioritize(mat);
+  }
   return mat;
 }
 
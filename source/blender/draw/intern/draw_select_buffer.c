@@ -26,9 +26,11 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_bitmap_draw_2d.h"
+#include "BLI_math.h"
 #include "BLI_rect.h"
 
 #include "DNA_screen_types.h"
+#include "DNA_view3d_types.h"
 
 #include "GPU_select.h"
 
@@ -46,6 +48,40 @@
 /** \name Buffer of select ID's
  * \{ */
 
+/**
+ * Check if the buffer drawn for the whole region is still valid, so reading another block of
+ * pixels doesn't need to draw the selection ID's again (circle select reads on every step).
+ */
+static bool drw_select_buffer_is_valid(const ARegion *region)
+{
+  struct SELECTID_Context *select_ctx = DRW_select_engine_context_get();
+
+  if (!select_ctx->is_region_drawn) {
+    return false;
+  }
+
+  GPUTexture *texture_u32 = DRW_engine_select_texture_get();
+  if ((texture_u32 == NULL) || (region->winx != GPU_texture_width(texture_u32)) ||
+      (region->winy != GPU_texture_height(texture_u32))) {
+    return false;
+  }
+
+  const RegionView3D *rv3d = region->regiondata;
+  if (!compare_m4m4(select_ctx->persmat, rv3d->persmat, FLT_EPSILON)) {
+    return false;
+  }
+
+  Object **ob = &select_ctx->objects_drawn[0];
+  for (uint i = select_ctx->objects_drawn_len; i--; ob++) {
+    DrawData *data = DRW_drawdata_get(&(*ob)->id, &draw_engine_select_type);
+    if (data && (data->recalc & (ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY)) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /* Main function to read a block of pixels from the select frame buffer. */
 uint *DRW_select_buffer_read(struct Depsgraph *depsgraph,
                              struct ARegion *region,
@@ -72,7 +108,13 @@ uint *DRW_select_buffer_read(struct Depsgraph *depsgraph,
 
     DRW_opengl_context_enable();
     /* Update the drawing. */
-    DRW_draw_select_id(depsgraph, region, v3d, rect);
+    if (!drw_select_buffer_is_valid(region)) {
+      /* Draw every object in the region again (not only the ones in \a rect),
+       * so following reads of any part of the region can skip drawing. */
+      memset(select_ctx->persmat, 0, sizeof(select_ctx->persmat));
+      DRW_draw_select_id(depsgraph, region, v3d, &r);
+      select_ctx->is_region_drawn = true;
+    }
 
     if (select_ctx->index_drawn_len > 1) {
       BLI_assert(region->winx == GPU_texture_width(DRW_engine_select_texture_get()) &&
@@ -547,5 +589,6 @@ void DRW_select_buffer_context_create(Base **bases, const uint bases_len, short
   select_ctx->objects_len = bases_len;
   select_ctx->select_mode = select_mode;
   memset(select_ctx->persmat, 0, sizeof(select_ctx->persmat));
+  select_ctx->is_region_drawn = false;
 }
 /** \} */
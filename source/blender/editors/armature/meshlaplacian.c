@@ -31,6 +31,8 @@
 #include "BLI_memarena.h"
 #include "BLI_string.h"
 #include "BLI_alloca.h"
+#include "BLI_linklist.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -909,6 +911,8 @@ typedef struct MeshDeformBind {
 
   /* grids */
   MemArena *memarena;
+  /** Arenas owning the #MDefBoundIsect, one for each thread that added intersections. */
+  LinkNode *isect_memarenas;
   MDefBoundIsect *(*boundisect)[6];
   int *semibound;
   int *tag;
@@ -999,44 +1003,59 @@ static void harmonic_ray_callback(void *userdata,
   }
 }
 
-static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
-                                                     const float co1[3],
-                                                     const float co2[3])
+/**
+ * Cast a ray along the segment \a co1, \a co2, doesn't allocate so it can be used from threads.
+ * \return the looptri index of the closest intersection or -1.
+ */
+static int meshdeform_ray_tree_cast(MeshDeformBind *mdb,
+                                    const float co1[3],
+                                    const float co2[3],
+                                    MeshDeformIsect *r_isect_mdef)
 {
   BVHTreeRayHit hit;
-  MeshDeformIsect isect_mdef;
   struct MeshRayCallbackData data = {
       mdb,
-      &isect_mdef,
+      r_isect_mdef,
   };
   float end[3], vec_normal[3];
 
   /* happens binding when a cage has no faces */
   if (UNLIKELY(mdb->bvhtree == NULL)) {
-    return NULL;
+    return -1;
   }
 
   /* setup isec */
-  memset(&isect_mdef, 0, sizeof(isect_mdef));
-  isect_mdef.lambda = 1e10f;
+  memset(r_isect_mdef, 0, sizeof(*r_isect_mdef));
+  r_isect_mdef->lambda = 1e10f;
 
-  copy_v3_v3(isect_mdef.start, co1);
+  copy_v3_v3(r_isect_mdef->start, co1);
   copy_v3_v3(end, co2);
-  sub_v3_v3v3(isect_mdef.vec, end, isect_mdef.start);
-  isect_mdef.vec_length = normalize_v3_v3(vec_normal, isect_mdef.vec);
+  sub_v3_v3v3(r_isect_mdef->vec, end, r_isect_mdef->start);
+  r_isect_mdef->vec_length = normalize_v3_v3(vec_normal, r_isect_mdef->vec);
 
   hit.index = -1;
   hit.dist = BVH_RAYCAST_DIST_MAX;
-  if (BLI_bvhtree_ray_cast_ex(mdb->bvhtree,
-                              isect_mdef.start,
-                              vec_normal,
-                              0.0,
-                              &hit,
-                              harmonic_ray_callback,
-                              &data,
-                              BVH_RAYCAST_WATERTIGHT) != -1) {
+  return BLI_bvhtree_ray_cast_ex(mdb->bvhtree,
+                                 r_isect_mdef->start,
+                                 vec_normal,
+                                 0.0,
+                                 &hit,
+                                 harmonic_ray_callback,
+                                 &data,
+                                 BVH_RAYCAST_WATERTIGHT);
+}
+
+static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
+                                                     MemArena *memarena,
+                                                     const float co1[3],
+                                                     const float co2[3])
+{
+  MeshDeformIsect isect_mdef;
+  const int index = meshdeform_ray_tree_cast(mdb, co1, co2, &isect_mdef);
+
+  if (index != -1) {
     const MLoop *mloop = mdb->cagemesh_cache.mloop;
-    const MLoopTri *lt = &mdb->cagemesh_cache.looptri[hit.index];
+    const MLoopTri *lt = &mdb->cagemesh_cache.looptri[index];
     const MPoly *mp = &mdb->cagemesh_cache.mpoly[lt->poly];
     const float(*cagecos)[3] = mdb->cagecos;
     const float len = isect_mdef.lambda;
@@ -1046,7 +1065,7 @@ static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
     int i;
 
     /* create MDefBoundIsect, and extra for 'poly_weights[]' */
-    isect = BLI_memarena_alloc(mdb->memarena, sizeof(*isect) + (sizeof(float) * mp->totloop));
+    isect = BLI_memarena_alloc(memarena, sizeof(*isect) + (sizeof(float) * mp->totloop));
 
     /* compute intersection coordinate */
     madd_v3_v3v3fl(isect->co, co1, isect_mdef.vec, len);
@@ -1070,9 +1089,9 @@ static MDefBoundIsect *meshdeform_ray_tree_intersect(MeshDeformBind *mdb,
   return NULL;
 }
 
-static int meshdeform_inside_cage(MeshDeformBind *mdb, float *co)
+static int meshdeform_inside_cage(MeshDeformBind *mdb, const float co[3])
 {
-  MDefBoundIsect *isect;
+  MeshDeformIsect isect_mdef;
   float outside[3], start[3], dir[3];
   int i;
 
@@ -1085,8 +1104,8 @@ static int meshdeform_inside_cage(MeshDeformBind *mdb, float *co)
     sub_v3_v3v3(dir, outside, start);
     normalize_v3(dir);
 
-    isect = meshdeform_ray_tree_intersect(mdb, start, outside);
-    if (isect && !isect->facing) {
+    if (meshdeform_ray_tree_cast(mdb, start, outside, &isect_mdef) != -1 &&
+        !isect_mdef.isect) {
       return 1;
     }
   }
@@ -1129,7 +1148,8 @@ BLI_INLINE void meshdeform_cell_center(
   center[2] = mdb->min[2] + z * mdb->width[2] + mdb->halfwidth[2];
 }
 
-static void meshdeform_add_intersections(MeshDeformBind *mdb, int x, int y, int z)
+static void meshdeform_add_intersections(
+    MeshDeformBind *mdb, MemArena *memarena, int x, int y, int z)
 {
   MDefBoundIsect *isect;
   float center[3], ncenter[3];
@@ -1146,7 +1166,7 @@ static void meshdeform_add_intersections(MeshDeformBind *mdb, int x, int y, int
 
     meshdeform_cell_center(mdb, x, y, z, i, ncenter);
 
-    isect = meshdeform_ray_tree_intersect(mdb, center, ncenter);
+    isect = meshdeform_ray_tree_intersect(mdb, memarena, center, ncenter);
     if (isect) {
       mdb->boundisect[a][i - 1] = isect;
       mdb->tag[a] = MESHDEFORM_TAG_BOUNDARY;
@@ -1154,6 +1174,48 @@ static void meshdeform_add_intersections(MeshDeformBind *mdb, int x, int y, int
   }
 }
 
+typedef struct MeshDeformIsectTLS {
+  MemArena *memarena;
+} MeshDeformIsectTLS;
+
+static void meshdeform_add_intersections_task(void *__restrict userdata,
+                                              const int z,
+                                              const TaskParallelTLS *__restrict tls)
+{
+  MeshDeformBind *mdb = userdata;
+  MeshDeformIsectTLS *isect_tls = tls->userdata_chunk;
+
+  if (isect_tls->memarena == NULL) {
+    isect_tls->memarena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+  }
+
+  /* Each cell only writes its own tag and intersections. */
+  for (int y = 0; y < mdb->size; y++) {
+    for (int x = 0; x < mdb->size; x++) {
+      meshdeform_add_intersections(mdb, isect_tls->memarena, x, y, z);
+    }
+  }
+}
+
+static void meshdeform_add_intersections_finalize(void *__restrict userdata,
+                                                  void *__restrict userdata_chunk)
+{
+  MeshDeformBind *mdb = userdata;
+  MeshDeformIsectTLS *isect_tls = userdata_chunk;
+
+  if (isect_tls->memarena != NULL) {
+    BLI_linklist_prepend(&mdb->isect_memarenas, isect_tls->memarena);
+  }
+}
+
+static void meshdeform_inside_cage_task(void *__restrict userdata,
+                                        const int a,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshDeformBind *mdb = userdata;
+  mdb->inside[a] = meshdeform_inside_cage(mdb, mdb->vertexcos[a]);
+}
+
 static void meshdeform_bind_floodfill(MeshDeformBind *mdb)
 {
   int *stack, *tag = mdb->tag;
@@ -1453,10 +1515,33 @@ static void meshdeform_matrix_add_exterior_phi(
   }
 }
 
+typedef struct MeshDeformWeightsData {
+  MeshDeformBind *mdb;
+  int cagevert;
+} MeshDeformWeightsData;
+
+static void meshdeform_static_weights_task(void *__restrict userdata,
+                                           const int b,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MeshDeformWeightsData *data = userdata;
+  MeshDeformBind *mdb = data->mdb;
+  float vec[3], gridvec[3];
+
+  if (mdb->inside[b]) {
+    copy_v3_v3(vec, mdb->vertexcos[b]);
+    gridvec[0] = (vec[0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
+    gridvec[1] = (vec[1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
+    gridvec[2] = (vec[2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
+
+    mdb->weights[b * mdb->totcagevert + data->cagevert] = meshdeform_interp_w(
+        mdb, gridvec, vec, data->cagevert);
+  }
+}
+
 static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind *mdb)
 {
   LinearSolver *context;
-  float vec[3], gridvec[3];
   int a, b, x, y, z, totvar;
   char message[256];
 
@@ -1522,16 +1607,12 @@ static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind
 
       if (mdb->weights) {
         /* static bind : compute weights for each vertex */
-        for (b = 0; b < mdb->totvert; b++) {
-          if (mdb->inside[b]) {
-            copy_v3_v3(vec, mdb->vertexcos[b]);
-            gridvec[0] = (vec[0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
-            gridvec[1] = (vec[1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
-            gridvec[2] = (vec[2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
-
-            mdb->weights[b * mdb->totcagevert + a] = meshdeform_interp_w(mdb, gridvec, vec, a);
-          }
-        }
+        MeshDeformWeightsData data = {.mdb = mdb, .cagevert = a};
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.min_iter_per_thread = 1024;
+        BLI_task_parallel_range(
+            0, mdb->totvert, &data, meshdeform_static_weights_task, &settings);
       }
       else {
         MDefBindInfluence *inf;
@@ -1585,8 +1666,8 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   MDefBindInfluence *inf;
   MDefInfluence *mdinf;
   MDefCell *cell;
-  float center[3], vec[3], maxwidth, totweight;
-  int a, b, x, y, z, totinside, offset;
+  float center[3], maxwidth, totweight;
+  int a, b, x, y, z, offset;
 
   /* compute bounding box of the cage mesh */
   INIT_MINMAX(mdb->min, mdb->max);
@@ -1614,7 +1695,7 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   }
 
   mdb->memarena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "harmonic coords arena");
-  BLI_memarena_use_calloc(mdb->memarena);
+  mdb->isect_memarenas = NULL;
 
   /* initialize data from 'cagedm' for reuse */
   {
@@ -1650,31 +1731,27 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
 
   progress_bar(0, "Setting up mesh deform system");
 
-  totinside = 0;
-  for (a = 0; a < mdb->totvert; a++) {
-    copy_v3_v3(vec, mdb->vertexcos[a]);
-    mdb->inside[a] = meshdeform_inside_cage(mdb, vec);
-    if (mdb->inside[a]) {
-      totinside++;
-    }
+  {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 256;
+    BLI_task_parallel_range(0, mdb->totvert, mdb, meshdeform_inside_cage_task, &settings);
   }
 
-  /* free temporary MDefBoundIsects */
-  BLI_memarena_free(mdb->memarena);
-  mdb->memarena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "harmonic coords arena");
-
   /* start with all cells untyped */
   for (a = 0; a < mdb->size3; a++) {
     mdb->tag[a] = MESHDEFORM_TAG_UNTYPED;
   }
 
   /* detect intersections and tag boundary cells */
-  for (z = 0; z < mdb->size; z++) {
-    for (y = 0; y < mdb->size; y++) {
-      for (x = 0; x < mdb->size; x++) {
-        meshdeform_add_intersections(mdb, x, y, z);
-      }
-    }
+  {
+    MeshDeformIsectTLS isect_tls = {NULL};
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.userdata_chunk = &isect_tls;
+    settings.userdata_chunk_size = sizeof(isect_tls);
+    settings.func_finalize = meshdeform_add_intersections_finalize;
+    BLI_task_parallel_range(0, mdb->size, mdb, meshdeform_add_intersections_task, &settings);
   }
 
   /* compute exterior and interior tags */
@@ -1744,6 +1821,7 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   MEM_freeN(mdb->boundisect);
   MEM_freeN(mdb->semibound);
   BLI_memarena_free(mdb->memarena);
+  BLI_linklist_free(mdb->isect_memarenas, (LinkNodeFreeFP)BLI_memarena_free);
   free_bvhtree_from_mesh(&mdb->bvhdata);
 }
 
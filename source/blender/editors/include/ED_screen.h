@@ -78,6 +78,7 @@ void ED_region_tag_redraw(struct ARegion *region);
 void ED_region_tag_redraw_partial(struct ARegion *region, const struct rcti *rct, bool rebuild);
 void ED_region_tag_redraw_cursor(struct ARegion *region);
 void ED_region_tag_redraw_no_rebuild(struct ARegion *region);
+void ED_region_tag_redraw_no_layout(struct ARegion *region);
 void ED_region_tag_refresh_ui(struct ARegion *region);
 void ED_region_tag_redraw_editor_overlays(struct ARegion *region);
 
@@ -88,6 +88,11 @@ SnapObjectContext *ED_transform_snap_object_context_create_view3d(struct Main *b
                                                                   const struct View3D *v3d);
 void ED_transform_snap_object_context_destroy(SnapObjectContext *sctx);
 
+void ED_transform_snap_object_context_prebuild(SnapObjectContext *sctx,
+                                               struct Depsgraph *depsgraph,
+                                               const unsigned short snap_to,
+                                               const struct SnapObjectParams *params);
+
 /* callbacks to filter how snap works */
 void ED_transform_snap_object_context_set_editmesh_callbacks(
     SnapObjectContext *sctx,
@@ -3319,6 +3319,19 @@ void UI_blocklist_free_inactive(const bContext *C, ListBase *lb)
   }
 }
 
+/**
+ * Draw the blocks kept from the previous redraw again, instead of building new ones.
+ * Only valid as long as the layout didn't change, see #RGN_DRAW_NO_LAYOUT.
+ */
+void UI_blocklist_reuse(ListBase *lb)
+{
+  for (uiBlock *block = lb->first; block; block = block->next) {
+    if (!block->handle) {
+      block->active = 1;
+    }
+  }
+}
+
 void UI_block_region_set(uiBlock *block, ARegion *region)
 {
   ListBase *lb = &region->uiblocks;
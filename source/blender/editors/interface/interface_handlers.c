@@ -306,6 +306,8 @@ typedef struct uiHandleButtonData {
   bool cancel, escapecancel;
   bool applied, applied_interactive;
   bool changed_cursor;
+  /* Last state change only affected the highlight, see #button_activate_state_is_highlight. */
+  bool highlight_only;
   wmTimer *flashtimer;
 
   /* edited value */
@@ -7787,6 +7789,28 @@ static bool button_modal_state(uiHandleButtonState state)
               BUTTON_STATE_MENU_OPEN);
 }
 
+/**
+ * Entering or leaving the highlight state (mouse hovering) only changes how the button draws,
+ * the region can then be redrawn without rebuilding its layout. Popups always rebuild.
+ */
+static bool button_activate_state_is_highlight(uiBut *but,
+                                               uiHandleButtonData *data,
+                                               uiHandleButtonState state)
+{
+  if ((but->block->flag & UI_BLOCK_LOOP) || but->block->handle ||
+      (data->region->regiontype == RGN_TYPE_TEMPORARY)) {
+    return false;
+  }
+
+  if ((data->state == BUTTON_STATE_INIT) && (state == BUTTON_STATE_HIGHLIGHT)) {
+    return true;
+  }
+  if ((data->state == BUTTON_STATE_HIGHLIGHT) && (state == BUTTON_STATE_EXIT) && data->cancel) {
+    return true;
+  }
+  return false;
+}
+
 static void button_activate_state(bContext *C, uiBut *but, uiHandleButtonState state)
 {
   uiHandleButtonData *data;
@@ -7796,6 +7820,8 @@ static void button_activate_state(bContext *C, uiBut *but, uiHandleButtonState s
     return;
   }
 
+  data->highlight_only = button_activate_state_is_highlight(but, data, state);
+
   /* highlight has timers for tooltips and auto open */
   if (state == BUTTON_STATE_HIGHLIGHT) {
     but->flag &= ~UI_SELECT;
@@ -7953,7 +7979,12 @@ static void button_activate_state(bContext *C, uiBut *but, uiHandleButtonState s
   }
 
   /* redraw */
-  ED_region_tag_redraw(data->region);
+  if (data->highlight_only) {
+    ED_region_tag_redraw_no_layout(data->region);
+  }
+  else {
+    ED_region_tag_redraw(data->region);
+  }
 }
 
 static void button_activate_init(bContext *C,
@@ -8164,7 +8195,12 @@ static void button_activate_exit(
   }
 
   /* redraw and refresh (for popups) */
-  ED_region_tag_redraw(data->region);
+  if (data->highlight_only && !onfree) {
+    ED_region_tag_redraw_no_layout(data->region);
+  }
+  else {
+    ED_region_tag_redraw(data->region);
+  }
   ED_region_tag_refresh_ui(data->region);
 
   /* clean up button */
@@ -27,5 +27,6 @@
 struct wmOperatorType;
 
 void WM_OT_usd_export(struct wmOperatorType *ot);
+void WM_OT_usd_import(struct wmOperatorType *ot);
 
 #endif /* __IO_USD_H__ */
@@ -60,16 +60,13 @@
 
 #  include "BLI_array_store.h"
 #  include "BLI_array_store_utils.h"
+#  include "BLI_task.h"
 /* check on best size later... */
 #  define ARRAY_CHUNK_SIZE 256
 
 #  define USE_ARRAY_STORE_THREAD
 #endif
 
-#ifdef USE_ARRAY_STORE_THREAD
-#  include "BLI_task.h"
-#endif
-
 /** We only need this locally. */
 static CLG_LogRef LOG = {"ed.undo.mesh"};
 
@@ -133,9 +130,86 @@ static struct {
 
 } um_arraystore = {{NULL}};
 
+/**
+ * Arrays waiting to be added to the array store.
+ *
+ * Adding a state is the expensive part of compacting (every array is hashed),
+ * so the arrays are gathered first and then added with one task per #BArrayStore,
+ * stores don't share any data so arrays of different strides can be added in parallel.
+ */
+typedef struct UMArrayStoreAdd {
+  BArrayStore *bs;
+  /** Owned, freed once the state has been added. */
+  void *data;
+  size_t data_len;
+  const BArrayState *state_reference;
+  BArrayState **r_state;
+} UMArrayStoreAdd;
+
+typedef struct UMArrayStoreAddQueue {
+  UMArrayStoreAdd *items;
+  int items_len;
+  /** Unique stores in #items. */
+  BArrayStore **stores;
+  int stores_len;
+} UMArrayStoreAddQueue;
+
+static void um_arraystore_add_queue_push(UMArrayStoreAddQueue *queue,
+                                         BArrayStore *bs,
+                                         void *data,
+                                         const size_t data_len,
+                                         const BArrayState *state_reference,
+                                         BArrayState **r_state)
+{
+  UMArrayStoreAdd *item = &queue->items[queue->items_len++];
+  item->bs = bs;
+  item->data = data;
+  item->data_len = data_len;
+  item->state_reference = state_reference;
+  item->r_state = r_state;
+
+  for (int i = 0; i < queue->stores_len; i++) {
+    if (queue->stores[i] == bs) {
+      return;
+    }
+  }
+  queue->stores[queue->stores_len++] = bs;
+}
+
+static void um_arraystore_add_queue_store_cb(void *__restrict userdata,
+                                             const int store_index,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const UMArrayStoreAddQueue *queue = userdata;
+  BArrayStore *bs = queue->stores[store_index];
+  for (int i = 0; i < queue->items_len; i++) {
+    const UMArrayStoreAdd *item = &queue->items[i];
+    if (item->bs == bs) {
+      *item->r_state = BLI_array_store_state_add(
+          bs, item->data, item->data_len, item->state_reference);
+    }
+  }
+}
+
+static void um_arraystore_add_queue_run(UMArrayStoreAddQueue *queue)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, queue->stores_len, queue, um_arraystore_add_queue_store_cb, &settings);
+
+  for (int i = 0; i < queue->items_len; i++) {
+    if (queue->items[i].data) {
+      MEM_freeN(queue->items[i].data);
+    }
+  }
+}
+
 static void um_arraystore_cd_compact(struct CustomData *cdata,
                                      const size_t data_len,
                                      bool create,
+                                     UMArrayStoreAddQueue *queue,
                                      const BArrayCustomData *bcd_reference,
                                      BArrayCustomData **r_bcd_first)
 {
@@ -206,8 +280,10 @@ static void um_arraystore_cd_compact(struct CustomData *cdata,
                                           i < bcd_reference_current->states_len) ?
                                              bcd_reference_current->states[i] :
                                              NULL;
-          bcd->states[i] = BLI_array_store_state_add(
-              bs, layer->data, (size_t)data_len * stride, state_reference);
+          um_arraystore_add_queue_push(
+              queue, bs, layer->data, (size_t)data_len * stride, state_reference, &bcd->states[i]);
+          /* The queue frees the data once it's added. */
+          layer->data = NULL;
         }
         else {
           bcd->states[i] = NULL;
@@ -285,14 +361,38 @@ static void um_arraystore_compact_ex(UndoMesh *um, const UndoMesh *um_ref, bool
 {
   Mesh *me = &um->me;
 
-  um_arraystore_cd_compact(
-      &me->vdata, me->totvert, create, um_ref ? um_ref->store.vdata : NULL, &um->store.vdata);
-  um_arraystore_cd_compact(
-      &me->edata, me->totedge, create, um_ref ? um_ref->store.edata : NULL, &um->store.edata);
-  um_arraystore_cd_compact(
-      &me->ldata, me->totloop, create, um_ref ? um_ref->store.ldata : NULL, &um->store.ldata);
-  um_arraystore_cd_compact(
-      &me->pdata, me->totpoly, create, um_ref ? um_ref->store.pdata : NULL, &um->store.pdata);
+  UMArrayStoreAddQueue queue = {NULL};
+  if (create) {
+    const int items_len_max = me->vdata.totlayer + me->edata.totlayer + me->ldata.totlayer +
+                              me->pdata.totlayer + (me->key ? me->key->totkey : 0) + 1;
+    queue.items = MEM_mallocN(sizeof(*queue.items) * items_len_max, __func__);
+    queue.stores = MEM_mallocN(sizeof(*queue.stores) * items_len_max, __func__);
+  }
+
+  um_arraystore_cd_compact(&me->vdata,
+                           me->totvert,
+                           create,
+                           &queue,
+                           um_ref ? um_ref->store.vdata : NULL,
+                           &um->store.vdata);
+  um_arraystore_cd_compact(&me->edata,
+                           me->totedge,
+                           create,
+                           &queue,
+                           um_ref ? um_ref->store.edata : NULL,
+                           &um->store.edata);
+  um_arraystore_cd_compact(&me->ldata,
+                           me->totloop,
+                           create,
+                           &queue,
+                           um_ref ? um_ref->store.ldata : NULL,
+                           &um->store.ldata);
+  um_arraystore_cd_compact(&me->pdata,
+                           me->totpoly,
+                           create,
+                           &queue,
+                           um_ref ? um_ref->store.pdata : NULL,
+                           &um->store.pdata);
 
   if (me->key && me->key->totkey) {
     const size_t stride = me->key->elemsize;
@@ -308,8 +408,13 @@ static void um_arraystore_compact_ex(UndoMesh *um, const UndoMesh *um_ref, bool
         BArrayState *state_reference = (um_ref && um_ref->me.key && (i < um_ref->me.key->totkey)) ?
                                            um_ref->store.keyblocks[i] :
                                            NULL;
-        um->store.keyblocks[i] = BLI_array_store_state_add(
-            bs, keyblock->data, (size_t)keyblock->totelem * stride, state_reference);
+        um_arraystore_add_queue_push(&queue,
+                                     bs,
+                                     keyblock->data,
+                                     (size_t)keyblock->totelem * stride,
+                                     state_reference,
+                                     &um->store.keyblocks[i]);
+        keyblock->data = NULL;
       }
 
       if (keyblock->data) {
@@ -326,16 +431,26 @@ static void um_arraystore_compact_ex(UndoMesh *um, const UndoMesh *um_ref, bool
       const size_t stride = sizeof(*me->mselect);
       BArrayStore *bs = BLI_array_store_at_size_ensure(
           &um_arraystore.bs_stride, stride, ARRAY_CHUNK_SIZE);
-      um->store.mselect = BLI_array_store_state_add(
-          bs, me->mselect, (size_t)me->totselect * stride, state_reference);
+      um_arraystore_add_queue_push(&queue,
+                                   bs,
+                                   me->mselect,
+                                   (size_t)me->totselect * stride,
+                                   state_reference,
+                                   &um->store.mselect);
+    }
+    else {
+      MEM_freeN(me->mselect);
     }
 
     /* keep me->totselect for validation */
-    MEM_freeN(me->mselect);
     me->mselect = NULL;
   }
 
   if (create) {
+    um_arraystore_add_queue_run(&queue);
+    MEM_freeN(queue.items);
+    MEM_freeN(queue.stores);
+
     um_arraystore.users += 1;
   }
 
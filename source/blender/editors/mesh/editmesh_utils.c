@@ -1432,6 +1432,8 @@ void EDBM_update_generic(Mesh *mesh, const bool do_tessellation, const bool is_d
   BMEditMesh *em = mesh->edit_mesh;
   /* Order of calling isn't important. */
   DEG_id_tag_update(&mesh->id, ID_RECALC_GEOMETRY);
+  /* Operators may change anything, not only vertex coordinates. */
+  em->is_deform_update = false;
   WM_main_add_notifier(NC_GEOM | ND_DATA, &mesh->id);
 
   if (do_tessellation) {
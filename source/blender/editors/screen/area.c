@@ -479,6 +479,19 @@ static bool area_is_pseudo_minimized(const ScrArea *area)
   return (area->winx < 3) || (area->winy < 3);
 }
 
+/**
+ * Check if the UI blocks of the previous redraw can be drawn again as they are.
+ * Reactivates them when that's the case.
+ */
+static bool region_layout_reuse(ARegion *region)
+{
+  if ((region->do_draw & RGN_DRAW_NO_LAYOUT) && region->uiblocks.first) {
+    UI_blocklist_reuse(&region->uiblocks);
+    return true;
+  }
+  return false;
+}
+
 /* only exported for WM */
 void ED_region_do_layout(bContext *C, ARegion *region)
 {
@@ -494,6 +507,10 @@ void ED_region_do_layout(bContext *C, ARegion *region)
     return;
   }
 
+  if (region_layout_reuse(region)) {
+    return;
+  }
+
   region->do_draw |= RGN_DRAWING;
 
   UI_SetTheme(sa ? sa->spacetype : 0, at->regionid);
@@ -633,7 +650,8 @@ void ED_region_tag_redraw(ARegion *region)
    * but python scripts can cause this to happen indirectly */
   if (region && !(region->do_draw & RGN_DRAWING)) {
     /* zero region means full region redraw */
-    region->do_draw &= ~(RGN_DRAW_PARTIAL | RGN_DRAW_NO_REBUILD | RGN_DRAW_EDITOR_OVERLAYS);
+    region->do_draw &= ~(RGN_DRAW_PARTIAL | RGN_DRAW_NO_REBUILD | RGN_DRAW_EDITOR_OVERLAYS |
+                         RGN_DRAW_NO_LAYOUT);
     region->do_draw |= RGN_DRAW;
     memset(&region->drawrct, 0, sizeof(region->drawrct));
   }
@@ -648,6 +666,10 @@ void ED_region_tag_redraw_cursor(ARegion *region)
 
 void ED_region_tag_redraw_no_rebuild(ARegion *region)
 {
+  if (region) {
+    /* UI layouts don't support this, rebuild them. */
+    region->do_draw &= ~RGN_DRAW_NO_LAYOUT;
+  }
   if (region && !(region->do_draw & (RGN_DRAWING | RGN_DRAW))) {
     region->do_draw &= ~(RGN_DRAW_PARTIAL | RGN_DRAW_EDITOR_OVERLAYS);
     region->do_draw |= RGN_DRAW_NO_REBUILD;
@@ -655,6 +677,24 @@ void ED_region_tag_redraw_no_rebuild(ARegion *region)
   }
 }
 
+/**
+ * Redraw the region from the UI blocks built for the previous redraw, skipping the layout
+ * (and the Python draw callbacks of panels and headers). Only for changes of button state
+ * that don't affect the layout, any other redraw tag falls back to a full rebuild.
+ */
+void ED_region_tag_redraw_no_layout(ARegion *region)
+{
+  if (region && !(region->do_draw & RGN_DRAWING)) {
+    if (region->do_draw == 0) {
+      region->do_draw |= RGN_DRAW | RGN_DRAW_NO_LAYOUT;
+      memset(&region->drawrct, 0, sizeof(region->drawrct));
+    }
+    else if ((region->do_draw & RGN_DRAW) == 0) {
+      ED_region_tag_redraw(region);
+    }
+  }
+}
+
 void ED_region_tag_refresh_ui(ARegion *region)
 {
   if (region) {
@@ -681,6 +721,8 @@ void ED_region_tag_redraw_editor_overlays(struct ARegion *region)
 void ED_region_tag_redraw_partial(ARegion *region, const rcti *rct, bool rebuild)
 {
   if (region && !(region->do_draw & RGN_DRAWING)) {
+    region->do_draw &= ~RGN_DRAW_NO_LAYOUT;
+
     if (region->do_draw & RGN_DRAW_PARTIAL) {
       /* Partial redraw already set, expand region. */
       BLI_rcti_union(&region->drawrct, rct);
@@ -2710,15 +2752,19 @@ void ED_region_panels_ex(
     const bContext *C, ARegion *region, const char *contexts[], int contextnr, const bool vertical)
 {
   /* TODO: remove? */
-  ED_region_panels_layout_ex(
-      C, region, &region->type->paneltypes, contexts, contextnr, vertical, NULL);
+  if (!region_layout_reuse(region)) {
+    ED_region_panels_layout_ex(
+        C, region, &region->type->paneltypes, contexts, contextnr, vertical, NULL);
+  }
   ED_region_panels_draw(C, region);
 }
 
 void ED_region_panels(const bContext *C, ARegion *region)
 {
   /* TODO: remove? */
-  ED_region_panels_layout(C, region);
+  if (!region_layout_reuse(region)) {
+    ED_region_panels_layout(C, region);
+  }
   ED_region_panels_draw(C, region);
 }
 
@@ -2839,7 +2885,9 @@ void ED_region_header_draw(const bContext *C, ARegion *region)
 void ED_region_header(const bContext *C, ARegion *region)
 {
   /* TODO: remove? */
-  ED_region_header_layout(C, region);
+  if (!region_layout_reuse(region)) {
+    ED_region_header_layout(C, region);
+  }
   ED_region_header_draw(C, region);
 }
 
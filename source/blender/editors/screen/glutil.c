@@ -743,11 +743,18 @@ void ED_draw_imbuf_ctx(
 int ED_draw_imbuf_method(ImBuf *ibuf)
 {
   if (U.image_draw_method == IMAGE_DRAW_METHOD_AUTO) {
-    /* Use faster GLSL when CPU to GPU transfer is unlikely to be a bottleneck,
-     * otherwise do color management on CPU side. */
+    /* Float buffers always use GLSL: running the OCIO processor on the CPU for every
+     * exposure, gamma or look change costs far more than uploading the visible tiles,
+     * and it keeps large render results out of the display buffer cache.
+     *
+     * For byte buffers use faster GLSL when CPU to GPU transfer is unlikely to be a
+     * bottleneck, otherwise do color management on CPU side. */
+    if (ibuf->rect_float) {
+      return IMAGE_DRAW_METHOD_GLSL;
+    }
+
     const size_t threshold = 2048 * 2048 * 4 * sizeof(float);
-    const size_t data_size = (ibuf->rect_float) ? sizeof(float) : sizeof(uchar);
-    const size_t size = ibuf->x * ibuf->y * ibuf->channels * data_size;
+    const size_t size = ibuf->x * ibuf->y * ibuf->channels * sizeof(uchar);
 
     return (size > threshold) ? IMAGE_DRAW_METHOD_2DTEXTURE : IMAGE_DRAW_METHOD_GLSL;
   }
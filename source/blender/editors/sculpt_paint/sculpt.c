@@ -5883,6 +5883,9 @@ static void do_brush_action_task_cb(void *__restrict userdata,
   if (data->brush->sculpt_tool == SCULPT_TOOL_MASK) {
     BKE_pbvh_node_mark_update_mask(data->nodes[n]);
   }
+  else if (data->brush->sculpt_tool == SCULPT_TOOL_DRAW_FACE_SETS && !ss->cache->alt_smooth) {
+    BKE_pbvh_node_mark_update_color(data->nodes[n]);
+  }
   else {
     BKE_pbvh_node_mark_update(data->nodes[n]);
   }
@@ -9990,7 +9993,7 @@ static void sculpt_expand_task_cb(void *__restrict userdata,
       if (final_mask == 1.0f) {
         SCULPT_vertex_face_set_set(ss, vd.index, ss->filter_cache->new_face_set);
       }
-      BKE_pbvh_node_mark_redraw(node);
+      BKE_pbvh_node_mark_update_color(node);
     }
     else {
 
@@ -10238,7 +10241,7 @@ static int sculpt_mask_expand_invoke(bContext *C, wmOperator *op, const wmEvent
   if (create_face_set) {
     SCULPT_undo_push_node(ob, ss->filter_cache->nodes[0], SCULPT_UNDO_FACE_SETS);
     for (int i = 0; i < ss->filter_cache->totnode; i++) {
-      BKE_pbvh_node_mark_redraw(ss->filter_cache->nodes[i]);
+      BKE_pbvh_node_mark_update_color(ss->filter_cache->nodes[i]);
     }
   }
   else {
@@ -10855,7 +10858,7 @@ static int sculpt_face_set_create_invoke(bContext *C, wmOperator *op, const wmEv
   }
 
   for (int i = 0; i < totnode; i++) {
-    BKE_pbvh_node_mark_redraw(nodes[i]);
+    BKE_pbvh_node_mark_update_color(nodes[i]);
   }
 
   MEM_SAFE_FREE(nodes);
@@ -11091,7 +11094,7 @@ static int sculpt_face_sets_randomize_colors_invoke(bContext *C,
 
   BKE_pbvh_search_gather(pbvh, NULL, NULL, &nodes, &totnode);
   for (int i = 0; i < totnode; i++) {
-    BKE_pbvh_node_mark_redraw(nodes[i]);
+    BKE_pbvh_node_mark_update_color(nodes[i]);
   }
 
   MEM_SAFE_FREE(nodes);
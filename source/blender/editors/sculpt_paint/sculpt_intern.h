@@ -284,6 +284,16 @@ typedef enum {
   SCULPT_UNDO_FACE_SETS,
 } SculptUndoType;
 
+/* Compressed copy of a per-vertex array of an undo node, while the node is stored in the
+ * undo stack. */
+typedef struct SculptUndoPackedArray {
+  void *data;
+  /* Size of the compressed data. */
+  size_t size;
+  /* Size of the original array, in bytes. */
+  size_t raw_size;
+} SculptUndoPackedArray;
+
 typedef struct SculptUndoNode {
   struct SculptUndoNode *next, *prev;
 
@@ -298,6 +308,10 @@ typedef struct SculptUndoNode {
   float *mask;
   int totvert;
 
+  /* Compressed `co` and `mask`, only valid outside of push and restore. */
+  SculptUndoPackedArray co_packed;
+  SculptUndoPackedArray mask_packed;
+
   /* non-multires */
   int maxvert; /* to verify if totvert it still the same */
   int *index;  /* to restore into right location */
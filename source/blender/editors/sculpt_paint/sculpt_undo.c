@@ -66,8 +66,13 @@
 #include "bmesh.h"
 #include "sculpt_intern.h"
 
+#include "zlib.h"
+
 typedef struct UndoSculpt {
   ListBase nodes;
+  /* PBVHNode -> SculptUndoNode lookup of the nodes above, only used while the step is pushed.
+   * Every brush symmetry pass pushes its nodes again, this avoids searching the list each time. */
+  GHash *node_map;
 
   size_t undo_size;
 } UndoSculpt;
@@ -698,6 +703,131 @@ static void sculpt_undo_restore_list(bContext *C, Depsgraph *depsgraph, ListBase
   MEM_SAFE_FREE(undo_modified_grids);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Compressed Node Storage
+ *
+ * Coordinates and masks of nodes stored in the undo stack are kept compressed, and are only
+ * expanded while the step is being restored.
+ * \{ */
+
+/* Arrays smaller than this are not worth compressing. */
+#define SCULPT_UNDO_PACK_MIN_SIZE 4096
+
+/* Compress array of 4 byte values. Bytes are shuffled first, so the same byte of every value is
+ * stored contiguously: exponents and high mantissa bits of nearby coordinates are very similar
+ * and compress a lot better this way. Returns false when compression does not save memory. */
+static bool sculpt_undo_array_pack(const void *array, SculptUndoPackedArray *r_packed)
+{
+  const size_t raw_size = MEM_allocN_len(array);
+  const size_t len = raw_size / 4;
+  if (raw_size < SCULPT_UNDO_PACK_MIN_SIZE) {
+    return false;
+  }
+  const unsigned char *src = array;
+  unsigned char *shuffled = MEM_mallocN(raw_size, __func__);
+  for (size_t i = 0; i < len; i++) {
+    for (int b = 0; b < 4; b++) {
+      shuffled[b * len + i] = src[i * 4 + b];
+    }
+  }
+  uLongf size = compressBound(raw_size);
+  void *data = MEM_mallocN(size, "SculptUndoPackedArray.data");
+  const bool ok = (compress2(data, &size, shuffled, raw_size, Z_BEST_SPEED) == Z_OK);
+  MEM_freeN(shuffled);
+  if (!ok || size >= raw_size) {
+    MEM_freeN(data);
+    return false;
+  }
+  r_packed->data = MEM_reallocN(data, size);
+  r_packed->size = size;
+  r_packed->raw_size = raw_size;
+  return true;
+}
+
+static void *sculpt_undo_array_unpack(SculptUndoPackedArray *packed, const char *name)
+{
+  const size_t raw_size = packed->raw_size;
+  const size_t len = raw_size / 4;
+  unsigned char *shuffled = MEM_mallocN(raw_size, __func__);
+  uLongf size = raw_size;
+  const int result = uncompress(shuffled, &size, packed->data, packed->size);
+  BLI_assert(result == Z_OK && size == raw_size);
+  UNUSED_VARS_NDEBUG(result);
+  unsigned char *array = MEM_mapallocN(raw_size, name);
+  for (size_t i = 0; i < len; i++) {
+    for (int b = 0; b < 4; b++) {
+      array[i * 4 + b] = shuffled[b * len + i];
+    }
+  }
+  MEM_freeN(shuffled);
+  MEM_freeN(packed->data);
+  memset(packed, 0, sizeof(*packed));
+  return array;
+}
+
+static void sculpt_undo_node_pack(SculptUndoNode *unode)
+{
+  if (unode->co && sculpt_undo_array_pack(unode->co, &unode->co_packed)) {
+    MEM_freeN(unode->co);
+    unode->co = NULL;
+  }
+  if (unode->mask && sculpt_undo_array_pack(unode->mask, &unode->mask_packed)) {
+    MEM_freeN(unode->mask);
+    unode->mask = NULL;
+  }
+}
+
+static void sculpt_undo_node_unpack(SculptUndoNode *unode)
+{
+  if (unode->co_packed.data) {
+    unode->co = sculpt_undo_array_unpack(&unode->co_packed, "SculptUndoNode.co");
+  }
+  if (unode->mask_packed.data) {
+    unode->mask = sculpt_undo_array_unpack(&unode->mask_packed, "SculptUndoNode.mask");
+  }
+}
+
+typedef struct SculptUndoPackData {
+  SculptUndoNode **nodes;
+  bool pack;
+} SculptUndoPackData;
+
+static void sculpt_undo_nodes_pack_cb(void *__restrict userdata,
+                                      const int n,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SculptUndoPackData *data = userdata;
+  if (data->pack) {
+    sculpt_undo_node_pack(data->nodes[n]);
+  }
+  else {
+    sculpt_undo_node_unpack(data->nodes[n]);
+  }
+}
+
+/* Compress or expand all nodes of the list, every node is handled by its own task. */
+static void sculpt_undo_nodes_pack(ListBase *lb, const bool pack)
+{
+  const int totnode = BLI_listbase_count(lb);
+  if (totnode == 0) {
+    return;
+  }
+  SculptUndoPackData data = {
+      .nodes = MEM_malloc_arrayN(totnode, sizeof(SculptUndoNode *), __func__),
+      .pack = pack,
+  };
+  int n = 0;
+  LISTBASE_FOREACH (SculptUndoNode *, unode, lb) {
+    data.nodes[n++] = unode;
+  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, totnode, &data, sculpt_undo_nodes_pack_cb, &settings);
+  MEM_freeN(data.nodes);
+}
+
+/** \} */
+
 static void sculpt_undo_free_list(ListBase *lb)
 {
   SculptUndoNode *unode = lb->first;
@@ -706,6 +836,12 @@ static void sculpt_undo_free_list(ListBase *lb)
     if (unode->co) {
       MEM_freeN(unode->co);
     }
+    if (unode->co_packed.data) {
+      MEM_freeN(unode->co_packed.data);
+    }
+    if (unode->mask_packed.data) {
+      MEM_freeN(unode->mask_packed.data);
+    }
     if (unode->no) {
       MEM_freeN(unode->no);
     }
@@ -791,9 +927,31 @@ SculptUndoNode *SCULPT_undo_get_node(PBVHNode *node)
     return NULL;
   }
 
+  if (usculpt->node_map) {
+    return BLI_ghash_lookup(usculpt->node_map, node);
+  }
+
   return BLI_findptr(&usculpt->nodes, node, offsetof(SculptUndoNode, node));
 }
 
+static void sculpt_undo_node_map_free(UndoSculpt *usculpt)
+{
+  if (usculpt->node_map) {
+    BLI_ghash_free(usculpt->node_map, NULL, NULL);
+    usculpt->node_map = NULL;
+  }
+}
+
+/* Undo nodes without a PBVH node (geometry, dyntopo) are not looked up, they stay out of the
+ * map. Like the list search, the first undo node pushed for a PBVH node is the one found. */
+static void sculpt_undo_node_map_add(UndoSculpt *usculpt, SculptUndoNode *unode)
+{
+  void **val_p;
+  if (unode->node && !BLI_ghash_ensure_p(usculpt->node_map, unode->node, &val_p)) {
+    *val_p = unode;
+  }
+}
+
 static void sculpt_undo_alloc_and_store_hidden(PBVH *pbvh, SculptUndoNode *unode)
 {
   PBVHNode *node = unode->node;
@@ -874,6 +1032,17 @@ static SculptUndoNode *sculpt_undo_alloc_node(Object *ob, PBVHNode *node, Sculpt
 
   BLI_addtail(&usculpt->nodes, unode);
 
+  if (usculpt->node_map == NULL) {
+    /* Include nodes pushed before the map was created. */
+    usculpt->node_map = BLI_ghash_ptr_new(__func__);
+    LISTBASE_FOREACH (SculptUndoNode *, unode_iter, &usculpt->nodes) {
+      sculpt_undo_node_map_add(usculpt, unode_iter);
+    }
+  }
+  else {
+    sculpt_undo_node_map_add(usculpt, unode);
+  }
+
   if (maxgrid) {
     /* Multires. */
     unode->maxgrid = maxgrid;
@@ -1207,6 +1376,8 @@ void SCULPT_undo_push_end(void)
     }
   }
 
+  sculpt_undo_node_map_free(usculpt);
+
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = G_MAIN->wm.first;
   if (wm->op_undo_depth == 0) {
@@ -1231,6 +1402,7 @@ static void sculpt_undosys_step_encode_init(struct bContext *UNUSED(C), UndoStep
   SculptUndoStep *us = (SculptUndoStep *)us_p;
   /* Dummy, memory is cleared anyway. */
   BLI_listbase_clear(&us->data.nodes);
+  us->data.node_map = NULL;
 }
 
 static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
@@ -1240,6 +1412,14 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
   /* Dummy, encoding is done along the way by adding tiles
    * to the current 'SculptUndoStep' added by encode_init. */
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+
+  /* Nodes are not modified anymore, compress them for storage in the undo stack. */
+  sculpt_undo_nodes_pack(&us->data.nodes, true);
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &us->data.nodes) {
+    const size_t saved_size = (unode->co_packed.raw_size - unode->co_packed.size) +
+                              (unode->mask_packed.raw_size - unode->mask_packed.size);
+    us->data.undo_size -= MIN2(saved_size, us->data.undo_size);
+  }
   us->step.data_size = us->data.undo_size;
 
   SculptUndoNode *unode = us->data.nodes.last;
@@ -1260,7 +1440,9 @@ static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == true);
+  sculpt_undo_nodes_pack(&us->data.nodes, false);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_nodes_pack(&us->data.nodes, true);
   us->step.is_applied = false;
 }
 
@@ -1269,7 +1451,9 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == false);
+  sculpt_undo_nodes_pack(&us->data.nodes, false);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_nodes_pack(&us->data.nodes, true);
   us->step.is_applied = true;
 }
 
@@ -1358,6 +1542,7 @@ static void sculpt_undosys_step_decode(
 static void sculpt_undosys_step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+  sculpt_undo_node_map_free(&us->data);
   sculpt_undo_free_list(&us->data.nodes);
 }
 
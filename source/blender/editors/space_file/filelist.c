@@ -2521,7 +2521,44 @@ static int filelist_readjob_list_dir(const char *root,
   return nbr_entries;
 }
 
-static int filelist_readjob_list_lib(const char *root, ListBase *entries, const bool skip_currpar)
+/**
+ * Last .blend file opened by the listing job. When listing recursively, the ID groups of a
+ * library are listed right after the library itself, keeping the handle open avoids scanning
+ * the whole file (and decompressing it) again for each group.
+ */
+typedef struct FileListLibHandle {
+  struct BlendHandle *libfiledata;
+  char filepath[FILE_MAX_LIBEXTRA];
+} FileListLibHandle;
+
+static struct BlendHandle *filelist_readjob_lib_handle_get(FileListLibHandle *lib_handle,
+                                                           const char *filepath)
+{
+  if (lib_handle->libfiledata && BLI_path_cmp(lib_handle->filepath, filepath) == 0) {
+    return lib_handle->libfiledata;
+  }
+
+  if (lib_handle->libfiledata) {
+    BLO_blendhandle_close(lib_handle->libfiledata);
+  }
+  lib_handle->libfiledata = BLO_blendhandle_from_file(filepath, NULL);
+  BLI_strncpy(lib_handle->filepath, filepath, sizeof(lib_handle->filepath));
+
+  return lib_handle->libfiledata;
+}
+
+static void filelist_readjob_lib_handle_free(FileListLibHandle *lib_handle)
+{
+  if (lib_handle->libfiledata) {
+    BLO_blendhandle_close(lib_handle->libfiledata);
+    lib_handle->libfiledata = NULL;
+  }
+}
+
+static int filelist_readjob_list_lib(const char *root,
+                                     ListBase *entries,
+                                     FileListLibHandle *lib_handle,
+                                     const bool skip_currpar)
 {
   FileListInternEntry *entry;
   LinkNode *ln, *names;
@@ -2538,7 +2575,7 @@ static int filelist_readjob_list_lib(const char *root, ListBase *entries, const
   }
 
   /* there we go */
-  libfiledata = BLO_blendhandle_from_file(dir, NULL);
+  libfiledata = filelist_readjob_lib_handle_get(lib_handle, dir);
   if (libfiledata == NULL) {
     return nbr_entries;
   }
@@ -2554,8 +2591,6 @@ static int filelist_readjob_list_lib(const char *root, ListBase *entries, const
     nnames = BLI_linklist_count(names);
   }
 
-  BLO_blendhandle_close(libfiledata);
-
   if (!skip_currpar) {
     entry = MEM_callocN(sizeof(*entry), __func__);
     entry->relpath = BLI_strdup(FILENAME_PARENT);
@@ -2767,6 +2802,7 @@ static void filelist_readjob_do(const bool do_lib,
                                 ThreadMutex *lock)
 {
   ListBase entries = {0};
+  FileListLibHandle lib_handle = {NULL};
   BLI_Stack *todo_dirs;
   TodoDir *td_dir;
   char dir[FILE_MAX_LIBEXTRA];
@@ -2816,7 +2852,7 @@ static void filelist_readjob_do(const bool do_lib,
     BLI_path_rel(rel_subdir, root);
 
     if (do_lib) {
-      nbr_entries = filelist_readjob_list_lib(subdir, &entries, skip_currpar);
+      nbr_entries = filelist_readjob_list_lib(subdir, &entries, &lib_handle, skip_currpar);
     }
     if (!nbr_entries) {
       is_lib = false;
@@ -2887,6 +2923,8 @@ static void filelist_readjob_do(const bool do_lib,
     BLI_stack_discard(todo_dirs);
   }
   BLI_stack_free(todo_dirs);
+
+  filelist_readjob_lib_handle_free(&lib_handle);
 }
 
 static void filelist_readjob_dir(FileList *filelist,
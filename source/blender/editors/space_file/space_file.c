@@ -774,9 +774,11 @@ void ED_spacetype_file(void)
 
 void ED_file_init(void)
 {
-  ED_file_read_bookmarks();
-
+  /* Bookmarks and system volumes are only shown by the file browser,
+   * skip reading them in background mode since querying mounted (network) volumes
+   * can stall startup. They can still be read on request, see #WM_OT_read_history. */
   if (G.background == false) {
+    ED_file_read_bookmarks();
     filelist_init_icons();
   }
 
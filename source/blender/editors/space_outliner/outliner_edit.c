@@ -1277,6 +1277,11 @@ static TreeElement *outliner_show_active_get_element(bContext *C,
         te = outliner_find_editbone(&te_obact->subtree, ebone);
       }
     }
+
+    /* Bones aren't built while the object is in a collapsed collection. */
+    if (te == NULL) {
+      te = te_obact;
+    }
   }
 
   return te;
@@ -1329,7 +1334,8 @@ static int outliner_show_active_exec(bContext *C, wmOperator *UNUSED(op))
     return OPERATOR_CANCELLED;
   }
 
-  ED_region_tag_redraw_no_rebuild(region);
+  /* Rebuild, contents of the objects that were opened up are not in the tree yet. */
+  ED_region_tag_redraw(region);
 
   return OPERATOR_FINISHED;
 }
@@ -521,6 +521,24 @@ static void outliner_add_object_contents(SpaceOutliner *soops,
 }
 
 // can be inlined if necessary
+/**
+ * Check if the element is hidden behind a collapsed collection (or other non object element).
+ * Collapsed objects aren't taken into account, filtering can move child objects out of them.
+ */
+static bool outliner_element_in_collapsed_tree(SpaceOutliner *soops, TreeElement *te)
+{
+  for (TreeElement *te_parent = te->parent; te_parent; te_parent = te_parent->parent) {
+    TreeStoreElem *tselem = TREESTORE(te_parent);
+    if ((tselem->type == 0) && (te_parent->idcode == ID_OB)) {
+      continue;
+    }
+    if (!TSELEM_OPEN(tselem, soops)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static void outliner_add_id_contents(SpaceOutliner *soops,
                                      TreeElement *te,
                                      TreeStoreElem *tselem,
@@ -542,7 +560,12 @@ static void outliner_add_id_contents(SpaceOutliner *soops,
       break;
     }
     case ID_OB: {
-      outliner_add_object_contents(soops, te, tselem, (Object *)id);
+      /* Objects in collapsed collections can't be seen, only build their contents (modifiers,
+       * materials, bones...) once expanding the collection triggers a rebuild. This keeps
+       * rebuilding cheap with many objects. */
+      if (!outliner_element_in_collapsed_tree(soops, te)) {
+        outliner_add_object_contents(soops, te, tselem, (Object *)id);
+      }
       break;
     }
     case ID_ME: {
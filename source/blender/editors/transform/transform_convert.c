@@ -1816,6 +1816,9 @@ static void special_aftertrans_update__mesh(bContext *UNUSED(C), TransInfo *t)
       char hflag;
       bool has_face_sel = (bm->totfacesel != 0);
 
+      /* Auto-merge changes topology, don't let the draw cache keep any buffers. */
+      em->is_deform_update = false;
+
       if (tc->mirror.use_mirror_any) {
         TransDataMirror *tdm;
         int i;
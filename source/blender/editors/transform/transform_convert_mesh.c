@@ -32,6 +32,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_linklist_stack.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_crazyspace.h"
@@ -70,29 +71,40 @@ struct TransIslandData {
  *
  * \{ */
 
-static bool bmesh_test_dist_add(BMVert *v,
-                                BMVert *v_other,
-                                float *dists,
-                                const float *dists_prev,
-                                /* optionally track original index */
-                                int *index,
-                                const int *index_prev,
-                                const float mtx[3][3])
+/* Below this many elements threading only adds overhead. */
+#define TRANS_MESH_PARALLEL_MIN_LEN 1024
+
+typedef struct ConnectivityDistanceData {
+  const float (*mtx)[3];
+  /** Vertices to relax, the neighbors of the previous front. */
+  BMVert **verts;
+  float *dists;
+  const float *dists_prev;
+  /* optionally track original index */
+  int *index;
+  const int *index_prev;
+  /** Set for each vertex in #verts which distance was lowered. */
+  bool *changed;
+} ConnectivityDistanceData;
+
+static bool bmesh_test_dist_pull(BMVert *v,
+                                 BMVert *v_other,
+                                 const ConnectivityDistanceData *data,
+                                 float *r_dist,
+                                 int *r_index)
 {
-  if ((BM_elem_flag_test(v_other, BM_ELEM_SELECT) == 0) &&
-      (BM_elem_flag_test(v_other, BM_ELEM_HIDDEN) == 0)) {
-    const int i = BM_elem_index_get(v);
-    const int i_other = BM_elem_index_get(v_other);
+  const int i_other = BM_elem_index_get(v_other);
+  const float dist_prev = data->dists_prev[i_other];
+  if (dist_prev != FLT_MAX) {
     float vec[3];
-    float dist_other;
     sub_v3_v3v3(vec, v->co, v_other->co);
-    mul_m3_v3(mtx, vec);
+    mul_m3_v3(data->mtx, vec);
 
-    dist_other = dists_prev[i] + len_v3(vec);
-    if (dist_other < dists[i_other]) {
-      dists[i_other] = dist_other;
-      if (index != NULL) {
-        index[i_other] = index_prev[i];
+    const float dist_other = dist_prev + len_v3(vec);
+    if (dist_other < *r_dist) {
+      *r_dist = dist_other;
+      if (data->index != NULL) {
+        *r_index = data->index_prev[i_other];
       }
       return true;
     }
@@ -101,23 +113,121 @@ static bool bmesh_test_dist_add(BMVert *v,
   return false;
 }
 
+/**
+ * Lower the distance of a single vertex using the distances of its neighbors.
+ * Only the vertex itself is written to, so all vertices of the front can be relaxed in parallel.
+ */
+static void editmesh_connectivity_distance_relax_cb(void *__restrict userdata,
+                                                    const int iter,
+                                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ConnectivityDistanceData *data = userdata;
+  BMVert *v = data->verts[iter];
+  const int i = BM_elem_index_get(v);
+  float dist = data->dists[i];
+  int index = (data->index != NULL) ? data->index[i] : -1;
+  bool changed = false;
+
+  BMEdge *e_iter, *e_first;
+  e_iter = e_first = v->e;
+
+  /* would normally use BM_EDGES_OF_VERT, but this runs so often,
+   * its faster to iterate on the data directly */
+  do {
+    if (BM_elem_flag_test(e_iter, BM_ELEM_HIDDEN) == 0) {
+
+      /* edge distance */
+      changed |= bmesh_test_dist_pull(v, BM_edge_other_vert(e_iter, v), data, &dist, &index);
+
+      /* face distance */
+      if (e_iter->l) {
+        BMLoop *l_iter_radial, *l_first_radial;
+        /**
+         * imaginary edge diagonally across quad.
+         * \note This takes advantage of the rules of winding that we
+         * know 2 or more of a verts edges wont reference the same face twice.
+         * Also, if the edge is hidden, the face will be hidden too.
+         */
+        l_iter_radial = l_first_radial = e_iter->l;
+
+        do {
+          if ((l_iter_radial->v == v) && (l_iter_radial->f->len == 4) &&
+              (BM_elem_flag_test(l_iter_radial->f, BM_ELEM_HIDDEN) == 0)) {
+            changed |= bmesh_test_dist_pull(
+                v, l_iter_radial->next->next->v, data, &dist, &index);
+          }
+        } while ((l_iter_radial = l_iter_radial->radial_next) != l_first_radial);
+      }
+    }
+  } while ((e_iter = BM_DISK_EDGE_NEXT(e_iter, v)) != e_first);
+
+  if (changed) {
+    data->dists[i] = dist;
+    if (data->index != NULL) {
+      data->index[i] = index;
+    }
+  }
+  data->changed[iter] = changed;
+}
+
+/**
+ * Add the unselected, visible neighbors of \a v to \a verts (once, using #BM_ELEM_TAG).
+ */
+static int editmesh_connectivity_neighbors_add(BMVert *v, BMVert **verts, int verts_len)
+{
+  if (v->e == NULL) {
+    return verts_len;
+  }
+
+  BMEdge *e_iter, *e_first;
+  e_iter = e_first = v->e;
+  do {
+    if (BM_elem_flag_test(e_iter, BM_ELEM_HIDDEN) == 0) {
+      BMVert *v_other = BM_edge_other_vert(e_iter, v);
+      if (!BM_elem_flag_test(v_other, BM_ELEM_SELECT | BM_ELEM_HIDDEN | BM_ELEM_TAG)) {
+        BM_elem_flag_enable(v_other, BM_ELEM_TAG);
+        verts[verts_len++] = v_other;
+      }
+
+      if (e_iter->l) {
+        BMLoop *l_iter_radial, *l_first_radial;
+        l_iter_radial = l_first_radial = e_iter->l;
+        do {
+          if ((l_iter_radial->v == v) && (l_iter_radial->f->len == 4) &&
+              (BM_elem_flag_test(l_iter_radial->f, BM_ELEM_HIDDEN) == 0)) {
+            v_other = l_iter_radial->next->next->v;
+            if (!BM_elem_flag_test(v_other, BM_ELEM_SELECT | BM_ELEM_HIDDEN | BM_ELEM_TAG)) {
+              BM_elem_flag_enable(v_other, BM_ELEM_TAG);
+              verts[verts_len++] = v_other;
+            }
+          }
+        } while ((l_iter_radial = l_iter_radial->radial_next) != l_first_radial);
+      }
+    }
+  } while ((e_iter = BM_DISK_EDGE_NEXT(e_iter, v)) != e_first);
+
+  return verts_len;
+}
+
 /**
  * \param mtx: Measure distance in this space.
  * \param dists: Store the closest connected distance to selected vertices.
  * \param index: Optionally store the original index we're measuring the distance to (can be NULL).
+ *
+ * Distances are relaxed front by front, starting at the selection. The vertices next to the
+ * front only read the distances of the previous front, so each front is relaxed in parallel.
  */
 static void editmesh_set_connectivity_distance(BMesh *bm,
                                                const float mtx[3][3],
                                                float *dists,
                                                int *index)
 {
-  BLI_LINKSTACK_DECLARE(queue, BMVert *);
-
-  /* any BM_ELEM_TAG'd vertex is in 'queue_next', so we don't add in twice */
-  BLI_LINKSTACK_DECLARE(queue_next, BMVert *);
-
-  BLI_LINKSTACK_INIT(queue);
-  BLI_LINKSTACK_INIT(queue_next);
+  /* Vertices which distance changed in the last pass. */
+  BMVert **front = MEM_mallocN(sizeof(*front) * bm->totvert, __func__);
+  int front_len = 0;
+  /* Their neighbors, any BM_ELEM_TAG'd vertex is in 'verts', so we don't add in twice. */
+  BMVert **verts = MEM_mallocN(sizeof(*verts) * bm->totvert, __func__);
+  bool *changed = MEM_mallocN(sizeof(*changed) * bm->totvert, __func__);
 
   {
     BMIter viter;
@@ -131,16 +241,13 @@ static void editmesh_set_connectivity_distance(BMesh *bm,
 
       if (BM_elem_flag_test(v, BM_ELEM_SELECT) == 0 || BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
         dist = FLT_MAX;
-        if (index != NULL) {
-          index[i] = i;
-        }
       }
       else {
-        BLI_LINKSTACK_PUSH(queue, v);
+        front[front_len++] = v;
         dist = 0.0f;
-        if (index != NULL) {
-          index[i] = i;
-        }
+      }
+      if (index != NULL) {
+        index[i] = i;
       }
 
       dists[i] = dist;
@@ -152,94 +259,54 @@ static void editmesh_set_connectivity_distance(BMesh *bm,
   float *dists_prev = MEM_dupallocN(dists);
   int *index_prev = MEM_dupallocN(index); /* may be NULL */
 
-  do {
-    BMVert *v;
-    LinkNode *lnk;
-
-    /* this is correct but slow to do each iteration,
-     * instead sync the dist's while clearing BM_ELEM_TAG (below) */
-#if 0
-    memcpy(dists_prev, dists, sizeof(float) * bm->totvert);
-#endif
+  ConnectivityDistanceData data = {
+      .mtx = mtx,
+      .verts = verts,
+      .dists = dists,
+      .dists_prev = dists_prev,
+      .index = index,
+      .index_prev = index_prev,
+      .changed = changed,
+  };
 
-    while ((v = BLI_LINKSTACK_POP(queue))) {
-      BLI_assert(dists[BM_elem_index_get(v)] != FLT_MAX);
-
-      /* connected edge-verts */
-      if (v->e != NULL) {
-        BMEdge *e_iter, *e_first;
-
-        e_iter = e_first = v->e;
-
-        /* would normally use BM_EDGES_OF_VERT, but this runs so often,
-         * its faster to iterate on the data directly */
-        do {
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
 
-          if (BM_elem_flag_test(e_iter, BM_ELEM_HIDDEN) == 0) {
-
-            /* edge distance */
-            {
-              BMVert *v_other = BM_edge_other_vert(e_iter, v);
-              if (bmesh_test_dist_add(v, v_other, dists, dists_prev, index, index_prev, mtx)) {
-                if (BM_elem_flag_test(v_other, BM_ELEM_TAG) == 0) {
-                  BM_elem_flag_enable(v_other, BM_ELEM_TAG);
-                  BLI_LINKSTACK_PUSH(queue_next, v_other);
-                }
-              }
-            }
-
-            /* face distance */
-            if (e_iter->l) {
-              BMLoop *l_iter_radial, *l_first_radial;
-              /**
-               * imaginary edge diagonally across quad.
-               * \note This takes advantage of the rules of winding that we
-               * know 2 or more of a verts edges wont reference the same face twice.
-               * Also, if the edge is hidden, the face will be hidden too.
-               */
-              l_iter_radial = l_first_radial = e_iter->l;
-
-              do {
-                if ((l_iter_radial->v == v) && (l_iter_radial->f->len == 4) &&
-                    (BM_elem_flag_test(l_iter_radial->f, BM_ELEM_HIDDEN) == 0)) {
-                  BMVert *v_other = l_iter_radial->next->next->v;
-                  if (bmesh_test_dist_add(v, v_other, dists, dists_prev, index, index_prev, mtx)) {
-                    if (BM_elem_flag_test(v_other, BM_ELEM_TAG) == 0) {
-                      BM_elem_flag_enable(v_other, BM_ELEM_TAG);
-                      BLI_LINKSTACK_PUSH(queue_next, v_other);
-                    }
-                  }
-                }
-              } while ((l_iter_radial = l_iter_radial->radial_next) != l_first_radial);
-            }
-          }
-        } while ((e_iter = BM_DISK_EDGE_NEXT(e_iter, v)) != e_first);
-      }
+  while (front_len != 0) {
+    int verts_len = 0;
+    for (int i = 0; i < front_len; i++) {
+      BLI_assert(dists[BM_elem_index_get(front[i])] != FLT_MAX);
+      verts_len = editmesh_connectivity_neighbors_add(front[i], verts, verts_len);
     }
 
-    /* clear for the next loop */
-    for (lnk = queue_next; lnk; lnk = lnk->next) {
-      BMVert *v_link = lnk->link;
-      const int i = BM_elem_index_get(v_link);
+    settings.use_threading = (verts_len >= TRANS_MESH_PARALLEL_MIN_LEN);
+    BLI_task_parallel_range(
+        0, verts_len, &data, editmesh_connectivity_distance_relax_cb, &settings);
 
+    /* clear for the next loop */
+    front_len = 0;
+    for (int i = 0; i < verts_len; i++) {
+      BMVert *v_link = verts[i];
       BM_elem_flag_disable(v_link, BM_ELEM_TAG);
 
-      /* keep in sync, avoid having to do full memcpy each iteration */
-      dists_prev[i] = dists[i];
-      if (index != NULL) {
-        index_prev[i] = index[i];
+      if (changed[i]) {
+        const int v_index = BM_elem_index_get(v_link);
+        /* keep in sync, avoid having to do full memcpy each iteration */
+        dists_prev[v_index] = dists[v_index];
+        if (index != NULL) {
+          index_prev[v_index] = index[v_index];
+        }
+        front[front_len++] = v_link;
       }
     }
 
-    BLI_LINKSTACK_SWAP(queue, queue_next);
-
-    /* none should be tagged now since 'queue_next' is empty */
+    /* none should be tagged now since 'verts' is cleared */
     BLI_assert(BM_iter_mesh_count_flag(BM_VERTS_OF_MESH, bm, BM_ELEM_TAG, true) == 0);
+  }
 
-  } while (BLI_LINKSTACK_SIZE(queue));
-
-  BLI_LINKSTACK_FREE(queue);
-  BLI_LINKSTACK_FREE(queue_next);
+  MEM_freeN(front);
+  MEM_freeN(verts);
+  MEM_freeN(changed);
 
   MEM_freeN(dists_prev);
   if (index_prev != NULL) {
@@ -637,11 +704,118 @@ static void VertsToTransData(TransInfo *t,
   }
 }
 
+typedef struct TransEditVertsData {
+  TransInfo *t;
+  TransDataContainer *tc;
+  BMEditMesh *em;
+  /** The vertices to create transform data for, in order. */
+  BMVert **verts;
+  int prop_mode;
+  int cd_vert_bweight_offset;
+  bool is_snap_rotate;
+  struct TransIslandData *island_info;
+  const int *island_vert_map;
+  const float *dists;
+  const int *dists_index;
+  /* CrazySpace */
+  const float (*quats)[4];
+  const float (*defmats)[3][3];
+  const float (*mtx)[3];
+  const float (*smtx)[3];
+} TransEditVertsData;
+
+static void trans_edit_verts_fill_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const TransEditVertsData *data = userdata;
+  TransInfo *t = data->t;
+  TransDataContainer *tc = data->tc;
+  BMVert *eve = data->verts[i];
+  TransData *tob = &tc->data[i];
+  TransDataExtension *tx = tc->data_ext ? &tc->data_ext[i] : NULL;
+  const int prop_mode = data->prop_mode;
+  const int a = BM_elem_index_get(eve);
+
+  struct TransIslandData *v_island = NULL;
+  float *bweight = (data->cd_vert_bweight_offset != -1) ?
+                       BM_ELEM_CD_GET_VOID_P(eve, data->cd_vert_bweight_offset) :
+                       NULL;
+
+  if (data->island_info) {
+    const int connected_index = (data->dists_index && data->dists_index[a] != -1) ?
+                                    data->dists_index[a] :
+                                    a;
+    v_island = (data->island_vert_map[connected_index] != -1) ?
+                   &data->island_info[data->island_vert_map[connected_index]] :
+                   NULL;
+  }
+
+  /* Do not use the island center in case we are using islands
+   * only to get axis for snap/rotate to normal... */
+  VertsToTransData(t, tob, tx, data->em, eve, bweight, v_island, data->is_snap_rotate);
+
+  /* selected */
+  if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+    tob->flag |= TD_SELECTED;
+  }
+
+  if (prop_mode) {
+    if (prop_mode & T_PROP_CONNECTED) {
+      tob->dist = data->dists[a];
+    }
+    else {
+      tob->flag |= TD_NOTCONNECTED;
+      tob->dist = FLT_MAX;
+    }
+  }
+
+  /* CrazySpace */
+  const bool use_quats = data->quats && BM_elem_flag_test(eve, BM_ELEM_TAG);
+  if (use_quats || data->defmats) {
+    float mat[3][3], qmat[3][3], imat[3][3];
+
+    /* Use both or either quat and defmat correction. */
+    if (use_quats) {
+      quat_to_mat3(qmat, data->quats[a]);
+
+      if (data->defmats) {
+        mul_m3_series(mat, data->defmats[a], qmat, data->mtx);
+      }
+      else {
+        mul_m3_m3m3(mat, data->mtx, qmat);
+      }
+    }
+    else {
+      mul_m3_m3m3(mat, data->mtx, data->defmats[a]);
+    }
+
+    invert_m3_m3(imat, mat);
+
+    copy_m3_m3(tob->smtx, imat);
+    copy_m3_m3(tob->mtx, mat);
+  }
+  else {
+    copy_m3_m3(tob->smtx, data->smtx);
+    copy_m3_m3(tob->mtx, data->mtx);
+  }
+
+  if (tc->mirror.use_mirror_any) {
+    if (tc->mirror.axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_X;
+    }
+    if (tc->mirror.axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Y;
+    }
+    if (tc->mirror.axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Z;
+    }
+  }
+}
+
 void createTransEditVerts(TransInfo *t)
 {
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    TransData *tob = NULL;
-    TransDataExtension *tx = NULL;
     BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
     Mesh *me = tc->obedit->data;
     BMesh *bm = em->bm;
@@ -732,14 +906,13 @@ void createTransEditVerts(TransInfo *t)
     BLI_assert(data_len != 0);
 
     tc->data_len = data_len;
-    tc->data = tob = MEM_callocN(data_len * sizeof(TransData), "TransObData(Mesh EditMode)");
+    tc->data = MEM_callocN(data_len * sizeof(TransData), "TransObData(Mesh EditMode)");
     if (ELEM(t->mode, TFM_SKIN_RESIZE, TFM_SHRINKFATTEN)) {
       /* warning, this is overkill, we only need 2 extra floats,
        * but this stores loads of extra stuff, for TFM_SHRINKFATTEN its even more overkill
        * since we may not use the 'alt' transform mode to maintain shell thickness,
        * but with generic transform code its hard to lazy init vars */
-      tx = tc->data_ext = MEM_callocN(tc->data_len * sizeof(TransDataExtension),
-                                      "TransObData ext");
+      tc->data_ext = MEM_callocN(tc->data_len * sizeof(TransDataExtension), "TransObData ext");
     }
 
     copy_m3_m4(mtx, tc->obedit->obmat);
@@ -801,7 +974,11 @@ void createTransEditVerts(TransInfo *t)
       }
     }
 
+    /* Gather the vertices first, so the transform data can be filled in parallel. */
+    BMVert **verts = MEM_mallocN(sizeof(*verts) * data_len, __func__);
+    int verts_len = 0;
     BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, a) {
+      BM_elem_index_set(eve, a); /* set_inline */
       if (BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
         continue;
       }
@@ -809,85 +986,37 @@ void createTransEditVerts(TransInfo *t)
         continue;
       }
       if (prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-        struct TransIslandData *v_island = NULL;
-        float *bweight = (cd_vert_bweight_offset != -1) ?
-                             BM_ELEM_CD_GET_VOID_P(eve, cd_vert_bweight_offset) :
-                             NULL;
-
-        if (island_info) {
-          const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
-          v_island = (island_vert_map[connected_index] != -1) ?
-                         &island_info[island_vert_map[connected_index]] :
-                         NULL;
-        }
-
-        /* Do not use the island center in case we are using islands
-         * only to get axis for snap/rotate to normal... */
-        VertsToTransData(t, tob, tx, em, eve, bweight, v_island, is_snap_rotate);
-        if (tx) {
-          tx++;
-        }
-
-        /* selected */
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          tob->flag |= TD_SELECTED;
-        }
-
-        if (prop_mode) {
-          if (prop_mode & T_PROP_CONNECTED) {
-            tob->dist = dists[a];
-          }
-          else {
-            tob->flag |= TD_NOTCONNECTED;
-            tob->dist = FLT_MAX;
-          }
-        }
-
-        /* CrazySpace */
-        const bool use_quats = quats && BM_elem_flag_test(eve, BM_ELEM_TAG);
-        if (use_quats || defmats) {
-          float mat[3][3], qmat[3][3], imat[3][3];
-
-          /* Use both or either quat and defmat correction. */
-          if (use_quats) {
-            quat_to_mat3(qmat, quats[BM_elem_index_get(eve)]);
-
-            if (defmats) {
-              mul_m3_series(mat, defmats[a], qmat, mtx);
-            }
-            else {
-              mul_m3_m3m3(mat, mtx, qmat);
-            }
-          }
-          else {
-            mul_m3_m3m3(mat, mtx, defmats[a]);
-          }
-
-          invert_m3_m3(imat, mat);
-
-          copy_m3_m3(tob->smtx, imat);
-          copy_m3_m3(tob->mtx, mat);
-        }
-        else {
-          copy_m3_m3(tob->smtx, smtx);
-          copy_m3_m3(tob->mtx, mtx);
-        }
-
-        if (tc->mirror.use_mirror_any) {
-          if (tc->mirror.axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_X;
-          }
-          if (tc->mirror.axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Y;
-          }
-          if (tc->mirror.axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Z;
-          }
-        }
-
-        tob++;
+        verts[verts_len++] = eve;
       }
     }
+    bm->elem_index_dirty &= ~BM_VERT;
+    BLI_assert(verts_len == data_len);
+
+    TransEditVertsData data = {
+        .t = t,
+        .tc = tc,
+        .em = em,
+        .verts = verts,
+        .prop_mode = prop_mode,
+        .cd_vert_bweight_offset = cd_vert_bweight_offset,
+        .is_snap_rotate = is_snap_rotate,
+        .island_info = island_info,
+        .island_vert_map = island_vert_map,
+        .dists = dists,
+        .dists_index = dists_index,
+        .quats = quats,
+        .defmats = defmats,
+        .mtx = mtx,
+        .smtx = smtx,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (verts_len >= TRANS_MESH_PARALLEL_MIN_LEN);
+    settings.min_iter_per_thread = TRANS_MESH_PARALLEL_MIN_LEN / 2;
+    BLI_task_parallel_range(0, verts_len, &data, trans_edit_verts_fill_cb, &settings);
+
+    MEM_freeN(verts);
 
     if (island_info) {
       MEM_freeN(island_info);
@@ -852,9 +852,13 @@ static void recalcData_objects(TransInfo *t)
         projectVertSlideData(t, false);
       }
 
+      /* Correcting UV's modifies face-corner data too. */
+      const bool is_deform_update = (t->settings->uvcalc_flag & UVCALC_TRANSFORM_CORRECT) == 0;
+
       FOREACH_TRANS_DATA_CONTAINER (t, tc) {
         DEG_id_tag_update(tc->obedit->data, 0); /* sets recalc flags */
         BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
+        em->is_deform_update = is_deform_update;
         EDBM_mesh_normals_update(em);
         BKE_editmesh_looptri_calc(em);
       }
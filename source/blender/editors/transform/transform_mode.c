@@ -32,6 +32,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BKE_constraint.h"
 #include "BKE_context.h"
@@ -487,6 +488,69 @@ static void constraintSizeLim(TransInfo *t, TransData *td)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/* Transform (Element Iteration) */
+
+/** \name Transform Element Iteration
+ * \{ */
+
+/* Below this many elements threading only adds overhead. */
+#define TRANSDATA_PARALLEL_MIN_LEN 1024
+
+typedef struct TransDataForeachData {
+  TransInfo *t;
+  TransDataContainer *tc;
+  TransDataElemFunc func;
+  void *userdata;
+} TransDataForeachData;
+
+static void transdata_foreach_cb(void *__restrict userdata,
+                                 const int i,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TransDataForeachData *data = userdata;
+  TransData *td = &data->tc->data[i];
+  if (td->flag & TD_SKIP) {
+    return;
+  }
+  data->func(data->t, data->tc, td, data->userdata);
+}
+
+/**
+ * Call \a func for each element of \a tc the transform acts on: up to the first #TD_NOACTION
+ * element, skipping #TD_SKIP elements.
+ *
+ * Large edit-mode selections are split over multiple threads, so \a func may only write to the
+ * element it is called for. Other data (objects, bones...) can have constraints and is always
+ * handled on the calling thread.
+ */
+void transdata_container_foreach(TransInfo *t,
+                                 TransDataContainer *tc,
+                                 TransDataElemFunc func,
+                                 void *userdata)
+{
+  /* The data is sorted by proportional distance, so elements without action are at the end. */
+  int data_len = 0;
+  while (data_len < tc->data_len && (tc->data[data_len].flag & TD_NOACTION) == 0) {
+    data_len++;
+  }
+
+  TransDataForeachData data = {
+      .t = t,
+      .tc = tc,
+      .func = func,
+      .userdata = userdata,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (t->flag & T_POINTS) && (data_len >= TRANSDATA_PARALLEL_MIN_LEN);
+  settings.min_iter_per_thread = TRANSDATA_PARALLEL_MIN_LEN / 2;
+  BLI_task_parallel_range(0, data_len, &data, transdata_foreach_cb, &settings);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /* Transform (Rotation Utils) */
 
@@ -39,7 +39,16 @@ typedef struct TransDataGenericSlideVert {
   float co_orig_3d[3];
 } TransDataGenericSlideVert;
 
+typedef void (*TransDataElemFunc)(struct TransInfo *t,
+                                  struct TransDataContainer *tc,
+                                  struct TransData *td,
+                                  void *userdata);
+
 /* transform_mode.c */
+void transdata_container_foreach(TransInfo *t,
+                                 TransDataContainer *tc,
+                                 TransDataElemFunc func,
+                                 void *userdata);
 bool transdata_check_local_center(TransInfo *t, short around);
 void protectedTransBits(short protectflag, float vec[3]);
 void constraintTransLim(TransInfo *t, TransData *td);
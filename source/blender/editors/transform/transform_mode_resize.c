@@ -44,6 +44,14 @@
 /** \name Transform Resize
  * \{ */
 
+static void resize_element_apply(TransInfo *t,
+                                 TransDataContainer *tc,
+                                 TransData *td,
+                                 void *userdata)
+{
+  ElementResize(t, tc, td, userdata);
+}
+
 static void applyResize(TransInfo *t, const int UNUSED(mval[2]))
 {
   float mat[3][3];
@@ -91,18 +99,7 @@ static void applyResize(TransInfo *t, const int UNUSED(mval[2]))
   copy_m3_m3(t->mat, mat);  // used in gizmo
 
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    TransData *td = tc->data;
-    for (i = 0; i < tc->data_len; i++, td++) {
-      if (td->flag & TD_NOACTION) {
-        break;
-      }
-
-      if (td->flag & TD_SKIP) {
-        continue;
-      }
-
-      ElementResize(t, tc, td, mat);
-    }
+    transdata_container_foreach(t, tc, resize_element_apply, mat);
   }
 
   /* evil hack - redo resize if cliping needed */
@@ -214,105 +214,110 @@ static void headerTranslation(TransInfo *t, const float vec[3], char str[UI_MAX_
   }
 }
 
-static void applyTranslationValue(TransInfo *t, const float vec[3])
+typedef struct TranslationData {
+  const float *vec;
+  bool apply_snap_align_rotation;
+  float pivot[3];
+} TranslationData;
+
+static void translation_element_apply(TransInfo *t,
+                                      TransDataContainer *tc,
+                                      TransData *td,
+                                      void *userdata)
 {
-  const bool apply_snap_align_rotation = usingSnappingNormal(
-      t);  // && (t->tsnap.status & POINT_INIT);
+  const TranslationData *data = userdata;
   float tvec[3];
 
-  /* The ideal would be "apply_snap_align_rotation" only when a snap point is found
-   * so, maybe inside this function is not the best place to apply this rotation.
-   * but you need "handle snapping rotation before doing the translation" (really?) */
-  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+  float rotate_offset[3] = {0};
+  bool use_rotate_offset = false;
 
-    float pivot[3];
-    if (apply_snap_align_rotation) {
-      copy_v3_v3(pivot, t->tsnap.snapTarget);
-      /* The pivot has to be in local-space (see T49494) */
-      if (tc->use_local_mat) {
-        mul_m4_v3(tc->imat, pivot);
-      }
-    }
+  /* handle snapping rotation before doing the translation */
+  if (data->apply_snap_align_rotation) {
+    float mat[3][3];
 
-    TransData *td = tc->data;
-    for (int i = 0; i < tc->data_len; i++, td++) {
-      if (td->flag & TD_NOACTION) {
-        break;
-      }
+    if (validSnappingNormal(t)) {
+      const float *original_normal;
 
-      if (td->flag & TD_SKIP) {
-        continue;
+      /* In pose mode, we want to align normals with Y axis of bones... */
+      if (t->flag & T_POSE) {
+        original_normal = td->axismtx[1];
+      }
+      else {
+        original_normal = td->axismtx[2];
       }
 
-      float rotate_offset[3] = {0};
-      bool use_rotate_offset = false;
-
-      /* handle snapping rotation before doing the translation */
-      if (apply_snap_align_rotation) {
-        float mat[3][3];
+      rotation_between_vecs_to_mat3(mat, original_normal, t->tsnap.snapNormal);
+    }
+    else {
+      unit_m3(mat);
+    }
 
-        if (validSnappingNormal(t)) {
-          const float *original_normal;
+    ElementRotation_ex(t, tc, td, mat, data->pivot);
 
-          /* In pose mode, we want to align normals with Y axis of bones... */
-          if (t->flag & T_POSE) {
-            original_normal = td->axismtx[1];
-          }
-          else {
-            original_normal = td->axismtx[2];
-          }
+    if (td->loc) {
+      use_rotate_offset = true;
+      sub_v3_v3v3(rotate_offset, td->loc, td->iloc);
+    }
+  }
 
-          rotation_between_vecs_to_mat3(mat, original_normal, t->tsnap.snapNormal);
-        }
-        else {
-          unit_m3(mat);
-        }
+  if (t->con.applyVec) {
+    float pvec[3];
+    t->con.applyVec(t, tc, td, data->vec, tvec, pvec);
+  }
+  else {
+    copy_v3_v3(tvec, data->vec);
+  }
 
-        ElementRotation_ex(t, tc, td, mat, pivot);
+  mul_m3_v3(td->smtx, tvec);
 
-        if (td->loc) {
-          use_rotate_offset = true;
-          sub_v3_v3v3(rotate_offset, td->loc, td->iloc);
-        }
-      }
+  if (use_rotate_offset) {
+    add_v3_v3(tvec, rotate_offset);
+  }
 
-      if (t->con.applyVec) {
-        float pvec[3];
-        t->con.applyVec(t, tc, td, vec, tvec, pvec);
-      }
-      else {
-        copy_v3_v3(tvec, vec);
-      }
+  if (t->options & CTX_GPENCIL_STROKES) {
+    /* grease pencil multiframe falloff */
+    bGPDstroke *gps = (bGPDstroke *)td->extra;
+    if (gps != NULL) {
+      mul_v3_fl(tvec, td->factor * gps->runtime.multi_frame_falloff);
+    }
+    else {
+      mul_v3_fl(tvec, td->factor);
+    }
+  }
+  else {
+    /* proportional editing falloff */
+    mul_v3_fl(tvec, td->factor);
+  }
 
-      mul_m3_v3(td->smtx, tvec);
+  protectedTransBits(td->protectflag, tvec);
 
-      if (use_rotate_offset) {
-        add_v3_v3(tvec, rotate_offset);
-      }
+  if (td->loc) {
+    add_v3_v3v3(td->loc, td->iloc, tvec);
+  }
 
-      if (t->options & CTX_GPENCIL_STROKES) {
-        /* grease pencil multiframe falloff */
-        bGPDstroke *gps = (bGPDstroke *)td->extra;
-        if (gps != NULL) {
-          mul_v3_fl(tvec, td->factor * gps->runtime.multi_frame_falloff);
-        }
-        else {
-          mul_v3_fl(tvec, td->factor);
-        }
-      }
-      else {
-        /* proportional editing falloff */
-        mul_v3_fl(tvec, td->factor);
-      }
+  constraintTransLim(t, td);
+}
 
-      protectedTransBits(td->protectflag, tvec);
+static void applyTranslationValue(TransInfo *t, const float vec[3])
+{
+  TranslationData data = {
+      .vec = vec,
+      .apply_snap_align_rotation = usingSnappingNormal(t), /* && (t->tsnap.status & POINT_INIT) */
+  };
 
-      if (td->loc) {
-        add_v3_v3v3(td->loc, td->iloc, tvec);
+  /* The ideal would be "apply_snap_align_rotation" only when a snap point is found
+   * so, maybe inside this function is not the best place to apply this rotation.
+   * but you need "handle snapping rotation before doing the translation" (really?) */
+  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    if (data.apply_snap_align_rotation) {
+      copy_v3_v3(data.pivot, t->tsnap.snapTarget);
+      /* The pivot has to be in local-space (see T49494) */
+      if (tc->use_local_mat) {
+        mul_m4_v3(tc->imat, data.pivot);
       }
-
-      constraintTransLim(t, td);
     }
+
+    transdata_container_foreach(t, tc, translation_element_apply, &data);
   }
 }
 
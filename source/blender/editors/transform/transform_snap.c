@@ -695,6 +695,18 @@ static void initSnappingMode(TransInfo *t)
           bm_edge_is_snap_target,
           bm_face_is_snap_target,
           POINTER_FROM_UINT((BM_ELEM_SELECT | BM_ELEM_HIDDEN)));
+
+      if (activeSnap(t) && t->tsnap.applySnap != NULL) {
+        /* Build the trees of all snap targets at once, instead of one by one while snapping. */
+        ED_transform_snap_object_context_prebuild(
+            t->tsnap.object_context,
+            t->depsgraph,
+            t->tsnap.mode,
+            &(const struct SnapObjectParams){
+                .snap_select = t->tsnap.modeSelect,
+                .use_object_edit_cage = (t->flag & T_EDIT) != 0,
+            });
+      }
     }
   }
 }
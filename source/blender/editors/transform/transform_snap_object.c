@@ -27,6 +27,7 @@
 #include "BLI_memarena.h"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -2898,6 +2899,117 @@ void ED_transform_snap_object_context_destroy(SnapObjectContext *sctx)
   MEM_freeN(sctx);
 }
 
+typedef struct SnapPrebuildData {
+  /* To skip meshes outside the view. */
+  const float (*persmat)[4];
+  bool use_loose_edges;
+  bool use_loose_verts;
+  TaskPool *task_pool;
+  /* Meshes already pushed, instances and duplis share the same mesh. */
+  GSet *mesh_set;
+} SnapPrebuildData;
+
+static void snap_prebuild_mesh_task(TaskPool *__restrict pool,
+                                    void *taskdata,
+                                    int UNUSED(threadid))
+{
+  SnapPrebuildData *spd = BLI_task_pool_userdata(pool);
+  Mesh *me = taskdata;
+  BVHTreeFromMesh treedata;
+
+  /* Only the trees that end up in the mesh cache remain, see #snapMesh for the types used. */
+  BKE_bvhtree_from_mesh_get(&treedata, me, BVHTREE_FROM_LOOPTRI, 4);
+  free_bvhtree_from_mesh(&treedata);
+  if (spd->use_loose_edges) {
+    BKE_bvhtree_from_mesh_get(&treedata, me, BVHTREE_FROM_LOOSEEDGES, 2);
+    free_bvhtree_from_mesh(&treedata);
+  }
+  if (spd->use_loose_verts) {
+    BKE_bvhtree_from_mesh_get(&treedata, me, BVHTREE_FROM_LOOSEVERTS, 2);
+    free_bvhtree_from_mesh(&treedata);
+  }
+}
+
+static void snap_prebuild_obj_cb(SnapObjectContext *UNUSED(sctx),
+                                 bool use_obedit,
+                                 bool UNUSED(use_backface_culling),
+                                 Object *ob,
+                                 float obmat[4][4],
+                                 void *data)
+{
+  SnapPrebuildData *spd = data;
+
+  if (ob->type != OB_MESH) {
+    return;
+  }
+
+  Mesh *me = ob->data;
+  if (BKE_object_is_in_editmode(ob)) {
+    BMEditMesh *em = BKE_editmesh_from_object(ob);
+    if (use_obedit || em->mesh_eval_final == NULL) {
+      /* Edit-mesh trees depend on the filter callbacks, they are built when snapping. */
+      return;
+    }
+    me = em->mesh_eval_final;
+  }
+  else if (ob->dt == OB_BOUNDBOX) {
+    return;
+  }
+
+  if (me->totedge == 0 || BLI_gset_haskey(spd->mesh_set, me)) {
+    return;
+  }
+
+  BoundBox *bb = BKE_mesh_boundbox_get(ob);
+  if (bb) {
+    float lpmat[4][4], planes[4][4];
+    mul_m4_m4m4(lpmat, (float(*)[4])spd->persmat, obmat);
+    planes_from_projmat(lpmat, planes[0], planes[1], planes[2], planes[3], NULL, NULL);
+    if (isect_aabb_planes_v3(planes, 4, bb->vec[0], bb->vec[6]) ==
+        ISECT_AABB_PLANE_BEHIND_ANY) {
+      return;
+    }
+  }
+
+  BLI_gset_insert(spd->mesh_set, me);
+  BLI_task_pool_push(spd->task_pool, snap_prebuild_mesh_task, me, false, TASK_PRIORITY_HIGH);
+}
+
+/**
+ * Build the BVH trees of all meshes in view that can be snapped to, using multiple threads.
+ *
+ * Without this the trees are built one after the other on the first snap query, which is what
+ * makes the start of snapping slow in large scenes. The trees are stored in the mesh runtime
+ * cache, so this only does work for meshes that don't have their trees yet.
+ */
+void ED_transform_snap_object_context_prebuild(SnapObjectContext *sctx,
+                                               Depsgraph *depsgraph,
+                                               const unsigned short snap_to,
+                                               const struct SnapObjectParams *params)
+{
+  const unsigned short snap_to_geom = snap_to & (SCE_SNAP_MODE_VERTEX | SCE_SNAP_MODE_EDGE |
+                                                 SCE_SNAP_MODE_FACE | SCE_SNAP_MODE_EDGE_MIDPOINT |
+                                                 SCE_SNAP_MODE_EDGE_PERPENDICULAR);
+  if (!sctx->use_v3d || sctx->v3d_data.region == NULL || snap_to_geom == 0) {
+    return;
+  }
+
+  const RegionView3D *rv3d = sctx->v3d_data.region->regiondata;
+
+  SnapPrebuildData spd;
+  spd.persmat = rv3d->persmat;
+  spd.use_loose_edges = (snap_to_geom & ~SCE_SNAP_MODE_FACE) != 0;
+  spd.use_loose_verts = (snap_to_geom & SCE_SNAP_MODE_VERTEX) != 0;
+  spd.mesh_set = BLI_gset_ptr_new(__func__);
+  spd.task_pool = BLI_task_pool_create(BLI_task_scheduler_get(), &spd);
+
+  iter_snap_objects(sctx, depsgraph, params, snap_prebuild_obj_cb, &spd);
+
+  BLI_task_pool_work_and_wait(spd.task_pool);
+  BLI_task_pool_free(spd.task_pool);
+  BLI_gset_free(spd.mesh_set, NULL);
+}
+
 void ED_transform_snap_object_context_set_editmesh_callbacks(
     SnapObjectContext *sctx,
     bool (*test_vert_fn)(BMVert *, void *user_data),
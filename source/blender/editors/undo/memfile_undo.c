@@ -94,7 +94,11 @@ static void memfile_undosys_step_decode(
   ED_editors_exit(bmain, false);
 
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
-  BKE_memfile_undo_decode(us->data, C);
+  /* The last memfile step read or written is the state the current Main is synced with,
+   * data-blocks which did not change since then can be kept as they are. */
+  UndoStack *ustack = ED_undo_stack_get();
+  MemFileUndoStep *us_reference = (MemFileUndoStep *)ustack->step_active_memfile;
+  BKE_memfile_undo_decode(us->data, us_reference ? us_reference->data : NULL, C);
 
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
     if (BKE_UNDOSYS_TYPE_IS_MEMFILE_SKIP(us_iter->type)) {
@@ -91,7 +91,9 @@ void ViewMap::Clean()
 
 ViewShape *ViewMap::viewShape(unsigned id)
 {
-  int index = _shapeIdToIndex[id];
+  // Look up without inserting, this is called concurrently during visibility computation.
+  id_to_index_map::const_iterator it = _shapeIdToIndex.find(id);
+  int index = (it != _shapeIdToIndex.end()) ? it->second : 0;
   return _VShapes[index];
 }
 
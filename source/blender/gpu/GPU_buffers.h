@@ -73,6 +73,10 @@ enum {
   GPU_PBVH_BUFFERS_SHOW_MASK = (1 << 1),
   GPU_PBVH_BUFFERS_SHOW_VCOL = (1 << 2),
   GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS = (1 << 3),
+  /* Vertex buffers to fill, mesh buffers keep the other ones as they are. */
+  GPU_PBVH_BUFFERS_UPDATE_COORDS = (1 << 4),
+  GPU_PBVH_BUFFERS_UPDATE_MASK = (1 << 5),
+  GPU_PBVH_BUFFERS_UPDATE_COLOR = (1 << 6),
 };
 
 void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
@@ -807,6 +807,9 @@ struct GPUDrawList {
   uint cmd_len;     /* Number of used command for the next call. */
   uint buffer_size; /* in bytes, size of indirect command buffer. */
   GLuint buffer_id; /* Draw Indirect Buffer id */
+  /* Commands are always recorded in host memory and only uploaded to the indirect buffer when
+   * they are submitted using multi-draw indirect. This avoids mapping the buffer for lists that
+   * end up using the fallback, and reading back from write-only mapped memory. */
   union {
     GPUDrawCommand *commands;
     GPUDrawCommandIndexed *commands_indexed;
@@ -823,9 +826,7 @@ GPUDrawList *GPU_draw_list_create(int length)
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER, list->buffer_id);
     glBufferData(GL_DRAW_INDIRECT_BUFFER, list->buffer_size, NULL, GL_DYNAMIC_DRAW);
   }
-  else {
-    list->commands = MEM_mallocN(list->buffer_size, "GPUDrawList data");
-  }
+  list->commands = MEM_mallocN(list->buffer_size, "GPUDrawList data");
   return list;
 }
 
@@ -834,9 +835,7 @@ void GPU_draw_list_discard(GPUDrawList *list)
   if (list->buffer_id) {
     GPU_buf_free(list->buffer_id);
   }
-  else {
-    MEM_SAFE_FREE(list->commands);
-  }
+  MEM_SAFE_FREE(list->commands);
   MEM_freeN(list);
 }
 
@@ -846,23 +845,6 @@ void GPU_draw_list_init(GPUDrawList *list, GPUBatch *batch)
   list->batch = batch;
   list->base_index = batch->elem ? BASE_INDEX(batch->elem) : UINT_MAX;
   list->cmd_len = 0;
-
-  if (USE_MULTI_DRAW_INDIRECT) {
-    if (list->commands == NULL) {
-      glBindBuffer(GL_DRAW_INDIRECT_BUFFER, list->buffer_id);
-      if (list->cmd_offset >= list->buffer_size) {
-        /* Orphan buffer data and start fresh. */
-        glBufferData(GL_DRAW_INDIRECT_BUFFER, list->buffer_size, NULL, GL_DYNAMIC_DRAW);
-        list->cmd_offset = 0;
-      }
-      GLenum flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
-      list->commands = glMapBufferRange(
-          GL_DRAW_INDIRECT_BUFFER, list->cmd_offset, list->buffer_size - list->cmd_offset, flags);
-    }
-  }
-  else {
-    list->cmd_offset = 0;
-  }
 }
 
 void GPU_draw_list_command_add(
@@ -891,9 +873,9 @@ void GPU_draw_list_command_add(
   }
 
   list->cmd_len++;
-  uint offset = list->cmd_offset + list->cmd_len * sizeof(GPUDrawCommandIndexed);
+  uint bytes_used = list->cmd_len * sizeof(GPUDrawCommandIndexed);
 
-  if (offset == list->buffer_size) {
+  if (bytes_used == list->buffer_size) {
     GPU_draw_list_submit(list);
     GPU_draw_list_init(list, list->batch);
   }
@@ -912,25 +894,29 @@ void GPU_draw_list_submit(GPUDrawList *list)
   /* TODO could assert that VAO is bound. */
 
   /* TODO We loose a bit of memory here if we only draw arrays. Fix that. */
-  uintptr_t offset = list->cmd_offset;
   uint cmd_len = list->cmd_len;
   size_t bytes_used = cmd_len * sizeof(GPUDrawCommandIndexed);
   list->cmd_len = 0; /* Avoid reuse. */
 
   /* Only do multi-draw indirect if doing more than 2 drawcall.
-   * This avoids the overhead of buffer mapping if scene is
-   * not very instance friendly.
-   * BUT we also need to take into account the case where only
-   * a few instances are needed to finish filling a call buffer. */
-  const bool do_mdi = (cmd_len > 2) || (list->cmd_offset + bytes_used == list->buffer_size);
+   * This avoids the overhead of the buffer upload if scene is
+   * not very instance friendly. */
+  const bool do_mdi = (cmd_len > 2);
 
   if (USE_MULTI_DRAW_INDIRECT && do_mdi) {
     GLenum prim = batch->gl_prim_type;
 
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER, list->buffer_id);
-    glFlushMappedBufferRange(GL_DRAW_INDIRECT_BUFFER, 0, bytes_used);
+    if (list->cmd_offset + bytes_used > list->buffer_size) {
+      /* Orphan buffer data and start fresh. */
+      glBufferData(GL_DRAW_INDIRECT_BUFFER, list->buffer_size, NULL, GL_DYNAMIC_DRAW);
+      list->cmd_offset = 0;
+    }
+    uintptr_t offset = list->cmd_offset;
+    GLenum flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+    void *data = glMapBufferRange(GL_DRAW_INDIRECT_BUFFER, offset, bytes_used, flags);
+    memcpy(data, list->commands, bytes_used);
     glUnmapBuffer(GL_DRAW_INDIRECT_BUFFER);
-    list->commands = NULL; /* Unmapped */
     list->cmd_offset += bytes_used;
 
     if (batch->elem) {
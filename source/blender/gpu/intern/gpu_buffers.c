@@ -57,7 +57,11 @@
 struct GPU_PBVH_Buffers {
   GPUIndexBuf *index_buf, *index_buf_fast;
   GPUIndexBuf *index_lines_buf, *index_lines_buf_fast;
+  /* Coordinates and normals, masks, and colors (vertex colors and face sets) are kept in
+   * separate vertex buffers so they can be updated independently. */
   GPUVertBuf *vert_buf;
+  GPUVertBuf *vert_buf_mask;
+  GPUVertBuf *vert_buf_color;
 
   GPUBatch *lines;
   GPUBatch *lines_fast;
@@ -96,7 +100,7 @@ struct GPU_PBVH_Buffers {
 };
 
 static struct {
-  GPUVertFormat format;
+  GPUVertFormat format, format_mask, format_color;
   uint pos, nor, msk, col, fset;
 } g_vbo_id = {{0}};
 
@@ -116,11 +120,11 @@ void gpu_pbvh_init()
         &g_vbo_id.format, "nor", GPU_COMP_I16, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
     /* TODO: Do not allocate these `.msk` and `.col` when they are not used. */
     g_vbo_id.msk = GPU_vertformat_attr_add(
-        &g_vbo_id.format, "msk", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
+        &g_vbo_id.format_mask, "msk", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
     g_vbo_id.col = GPU_vertformat_attr_add(
-        &g_vbo_id.format, "ac", GPU_COMP_U16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
+        &g_vbo_id.format_color, "ac", GPU_COMP_U16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
     g_vbo_id.fset = GPU_vertformat_attr_add(
-        &g_vbo_id.format, "fset", GPU_COMP_U8, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+        &g_vbo_id.format_color, "fset", GPU_COMP_U8, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
   }
 }
 
@@ -131,54 +135,72 @@ void gpu_pbvh_exit()
 
 /* Allocates a non-initialized buffer to be sent to GPU.
  * Return is false it indicates that the memory map failed. */
-static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
+static bool gpu_pbvh_vert_buf_alloc(GPUVertBuf **vert_buf, GPUVertFormat *format, uint vert_len)
 {
   /* Keep so we can test #GPU_USAGE_DYNAMIC buffer use.
    * Not that format initialization match in both blocks.
    * Do this to keep braces balanced - otherwise indentation breaks. */
 #if 0
-  if (buffers->vert_buf == NULL) {
+  if (*vert_buf == NULL) {
     /* Initialize vertex buffer (match 'VertexBufferFormat'). */
-    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_DYNAMIC);
-    GPU_vertbuf_data_alloc(buffers->vert_buf, vert_len);
+    *vert_buf = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_DYNAMIC);
+    GPU_vertbuf_data_alloc(*vert_buf, vert_len);
   }
-  else if (vert_len != buffers->vert_buf->vertex_len) {
-    GPU_vertbuf_data_resize(buffers->vert_buf, vert_len);
+  else if (vert_len != (*vert_buf)->vertex_len) {
+    GPU_vertbuf_data_resize(*vert_buf, vert_len);
   }
 #else
-  if (buffers->vert_buf == NULL) {
+  if (*vert_buf == NULL) {
     /* Initialize vertex buffer (match 'VertexBufferFormat'). */
-    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_STATIC);
+    *vert_buf = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_STATIC);
   }
-  GPU_vertbuf_data_alloc(buffers->vert_buf, vert_len);
+  GPU_vertbuf_data_alloc(*vert_buf, vert_len);
 #endif
 
-  return buffers->vert_buf->data != NULL;
+  return (*vert_buf)->data != NULL;
+}
+
+/* Allocates all vertex buffers of the node, see #gpu_pbvh_vert_buf_alloc. */
+static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
+{
+  return (gpu_pbvh_vert_buf_alloc(&buffers->vert_buf, &g_vbo_id.format, vert_len) &&
+          gpu_pbvh_vert_buf_alloc(&buffers->vert_buf_mask, &g_vbo_id.format_mask, vert_len) &&
+          gpu_pbvh_vert_buf_alloc(&buffers->vert_buf_color, &g_vbo_id.format_color, vert_len));
+}
+
+static GPUBatch *gpu_pbvh_batch_create(GPU_PBVH_Buffers *buffers,
+                                       GPUPrimType prim,
+                                       GPUIndexBuf *index_buf)
+{
+  GPUBatch *batch = GPU_batch_create(prim, buffers->vert_buf, index_buf);
+  GPU_batch_vertbuf_add(batch, buffers->vert_buf_mask);
+  GPU_batch_vertbuf_add(batch, buffers->vert_buf_color);
+  return batch;
 }
 
 static void gpu_pbvh_batch_init(GPU_PBVH_Buffers *buffers, GPUPrimType prim)
 {
   if (buffers->triangles == NULL) {
-    buffers->triangles = GPU_batch_create(prim,
-                                          buffers->vert_buf,
-                                          /* can be NULL if buffer is empty */
-                                          buffers->index_buf);
+    buffers->triangles = gpu_pbvh_batch_create(buffers,
+                                               prim,
+                                               /* can be NULL if buffer is empty */
+                                               buffers->index_buf);
   }
 
   if ((buffers->triangles_fast == NULL) && buffers->index_buf_fast) {
-    buffers->triangles_fast = GPU_batch_create(prim, buffers->vert_buf, buffers->index_buf_fast);
+    buffers->triangles_fast = gpu_pbvh_batch_create(buffers, prim, buffers->index_buf_fast);
   }
 
   if (buffers->lines == NULL) {
-    buffers->lines = GPU_batch_create(GPU_PRIM_LINES,
-                                      buffers->vert_buf,
-                                      /* can be NULL if buffer is empty */
-                                      buffers->index_lines_buf);
+    buffers->lines = gpu_pbvh_batch_create(buffers,
+                                           GPU_PRIM_LINES,
+                                           /* can be NULL if buffer is empty */
+                                           buffers->index_lines_buf);
   }
 
   if ((buffers->lines_fast == NULL) && buffers->index_lines_buf_fast) {
-    buffers->lines_fast = GPU_batch_create(
-        GPU_PRIM_LINES, buffers->vert_buf, buffers->index_lines_buf_fast);
+    buffers->lines_fast = gpu_pbvh_batch_create(
+        buffers, GPU_PRIM_LINES, buffers->index_lines_buf_fast);
   }
 }
 
@@ -204,7 +226,10 @@ static void face_set_overlay_color_get(const int face_set, const int seed, uchar
   rgba_float_to_uchar(r_color, rgba);
 }
 
-/* Threaded - do not call any functions that use OpenGL calls! */
+/* Threaded - do not call any functions that use OpenGL calls!
+ *
+ * Only the vertex buffers selected by the `GPU_PBVH_BUFFERS_UPDATE_*` flags are filled, the other
+ * ones keep what was uploaded before. */
 void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
                                   const MVert *mvert,
                                   const int *vert_indices,
@@ -221,40 +246,60 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
   const bool show_vcol = vcol && (update_flags & GPU_PBVH_BUFFERS_SHOW_VCOL) != 0;
   const bool show_face_sets = sculpt_face_sets &&
                               (update_flags & GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS) != 0;
+  const int totelem = (buffers->smooth ? totvert : (buffers->tot_tri * 3));
+
+  /* Buffers which were never filled (or changed size) need all their attributes. */
+  const bool update_all = (buffers->vert_buf == NULL ||
+                           buffers->vert_buf->vertex_len != (uint)totelem);
+  const bool update_coords = update_all || (update_flags & GPU_PBVH_BUFFERS_UPDATE_COORDS);
+  const bool update_mask = update_all || (update_flags & GPU_PBVH_BUFFERS_UPDATE_MASK);
+  const bool update_color = update_all || (update_flags & GPU_PBVH_BUFFERS_UPDATE_COLOR);
   bool empty_mask = true;
 
-  {
-    int totelem = (buffers->smooth ? totvert : (buffers->tot_tri * 3));
-
-    /* Build VBO */
-    if (gpu_pbvh_vert_buf_data_set(buffers, totelem)) {
-      GPUVertBufRaw pos_step = {0};
-      GPUVertBufRaw nor_step = {0};
-      GPUVertBufRaw msk_step = {0};
-      GPUVertBufRaw col_step = {0};
-      GPUVertBufRaw fset_step = {0};
-
+  /* Build VBO */
+  if ((!update_coords ||
+       gpu_pbvh_vert_buf_alloc(&buffers->vert_buf, &g_vbo_id.format, totelem)) &&
+      (!update_mask ||
+       gpu_pbvh_vert_buf_alloc(&buffers->vert_buf_mask, &g_vbo_id.format_mask, totelem)) &&
+      (!update_color ||
+       gpu_pbvh_vert_buf_alloc(&buffers->vert_buf_color, &g_vbo_id.format_color, totelem))) {
+    GPUVertBufRaw pos_step = {0};
+    GPUVertBufRaw nor_step = {0};
+    GPUVertBufRaw msk_step = {0};
+    GPUVertBufRaw col_step = {0};
+    GPUVertBufRaw fset_step = {0};
+
+    if (update_coords) {
       GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.pos, &pos_step);
       GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.nor, &nor_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.msk, &msk_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.fset, &fset_step);
+    }
+    if (update_mask) {
+      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf_mask, g_vbo_id.msk, &msk_step);
+    }
+    if (update_color) {
+      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf_color, g_vbo_id.fset, &fset_step);
       if (show_vcol) {
-        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.col, &col_step);
+        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf_color, g_vbo_id.col, &col_step);
       }
+    }
 
-      /* Vertex data is shared if smooth-shaded, but separate
-       * copies are made for flat shading because normals
-       * shouldn't be shared. */
-      if (buffers->smooth) {
+    /* Vertex data is shared if smooth-shaded, but separate
+     * copies are made for flat shading because normals
+     * shouldn't be shared. */
+    if (buffers->smooth) {
+      if (update_coords) {
         for (uint i = 0; i < totvert; i++) {
-          const int vidx = vert_indices[i];
-          const MVert *v = &mvert[vidx];
+          const MVert *v = &mvert[vert_indices[i]];
           copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), v->co);
           copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), v->no);
+        }
+      }
 
+      if (update_mask) {
+        for (uint i = 0; i < totvert; i++) {
           float mask;
           if (show_mask) {
-            mask = vmask[vidx];
+            mask = vmask[vert_indices[i]];
           }
           else {
             mask = 0.0f;
@@ -262,7 +307,9 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
           *(float *)GPU_vertbuf_raw_step(&msk_step) = mask;
           empty_mask = empty_mask && (mask == 0.0f);
         }
+      }
 
+      if (update_color) {
         /* Face Sets. */
         uchar face_set_color[4] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
         for (uint i = 0; i < buffers->face_indices_len; i++) {
@@ -277,7 +324,7 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
           }
           for (int j = 0; j < 3; j++) {
             const int vidx = face_vert_indices[i][j];
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vidx, &face_set_color);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.fset, vidx, &face_set_color);
           }
         }
 
@@ -293,62 +340,67 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
               scol[1] = unit_float_to_ushort_clamp(BLI_color_from_srgb_table[mcol->g]);
               scol[2] = unit_float_to_ushort_clamp(BLI_color_from_srgb_table[mcol->b]);
               scol[3] = unit_float_to_ushort_clamp(mcol->a * (1.0f / 255.0f));
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vidx, scol);
+              GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.col, vidx, scol);
             }
           }
         }
       }
-      else {
-        /* calculate normal for each polygon only once */
-        uint mpoly_prev = UINT_MAX;
-        short no[3] = {0, 0, 0};
-
-        for (uint i = 0; i < buffers->face_indices_len; i++) {
-          const MLoopTri *lt = &buffers->looptri[buffers->face_indices[i]];
-          const uint vtri[3] = {
-              buffers->mloop[lt->tri[0]].v,
-              buffers->mloop[lt->tri[1]].v,
-              buffers->mloop[lt->tri[2]].v,
-          };
-
-          if (paint_is_face_hidden(lt, mvert, buffers->mloop)) {
-            continue;
-          }
+    }
+    else {
+      /* calculate normal for each polygon only once */
+      uint mpoly_prev = UINT_MAX;
+      short no[3] = {0, 0, 0};
+
+      for (uint i = 0; i < buffers->face_indices_len; i++) {
+        const MLoopTri *lt = &buffers->looptri[buffers->face_indices[i]];
+        const uint vtri[3] = {
+            buffers->mloop[lt->tri[0]].v,
+            buffers->mloop[lt->tri[1]].v,
+            buffers->mloop[lt->tri[2]].v,
+        };
+
+        if (paint_is_face_hidden(lt, mvert, buffers->mloop)) {
+          continue;
+        }
 
-          if (sculpt_face_sets[lt->poly] <= 0) {
-            continue;
-          }
+        if (sculpt_face_sets[lt->poly] <= 0) {
+          continue;
+        }
 
-          /* Face normal and mask */
-          if (lt->poly != mpoly_prev) {
-            const MPoly *mp = &buffers->mpoly[lt->poly];
-            float fno[3];
-            BKE_mesh_calc_poly_normal(mp, &buffers->mloop[mp->loopstart], mvert, fno);
-            normal_float_to_short_v3(no, fno);
-            mpoly_prev = lt->poly;
-          }
+        /* Face normal and mask */
+        if (update_coords && lt->poly != mpoly_prev) {
+          const MPoly *mp = &buffers->mpoly[lt->poly];
+          float fno[3];
+          BKE_mesh_calc_poly_normal(mp, &buffers->mloop[mp->loopstart], mvert, fno);
+          normal_float_to_short_v3(no, fno);
+          mpoly_prev = lt->poly;
+        }
 
-          uchar face_set_color[4] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
-          if (show_face_sets) {
-            const int fset = abs(sculpt_face_sets[lt->poly]);
-            /* Skip for the default color Face Set to render it white. */
-            if (fset != face_sets_color_default) {
-              face_set_overlay_color_get(fset, face_sets_color_seed, face_set_color);
-            }
+        uchar face_set_color[4] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
+        if (update_color && show_face_sets) {
+          const int fset = abs(sculpt_face_sets[lt->poly]);
+          /* Skip for the default color Face Set to render it white. */
+          if (fset != face_sets_color_default) {
+            face_set_overlay_color_get(fset, face_sets_color_seed, face_set_color);
           }
+        }
 
-          float fmask = 0.0f;
-          if (show_mask) {
-            fmask = (vmask[vtri[0]] + vmask[vtri[1]] + vmask[vtri[2]]) / 3.0f;
-          }
+        float fmask = 0.0f;
+        if (update_mask && show_mask) {
+          fmask = (vmask[vtri[0]] + vmask[vtri[1]] + vmask[vtri[2]]) / 3.0f;
+        }
 
-          for (uint j = 0; j < 3; j++) {
+        for (uint j = 0; j < 3; j++) {
+          if (update_coords) {
             const MVert *v = &mvert[vtri[j]];
-
             copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), v->co);
             copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), no);
+          }
+          if (update_mask) {
             *(float *)GPU_vertbuf_raw_step(&msk_step) = fmask;
             empty_mask = empty_mask && (fmask == 0.0f);
+          }
+          if (update_color) {
             /* Face Sets. */
             memcpy(GPU_vertbuf_raw_step(&fset_step), face_set_color, sizeof(uchar) * 3);
 
@@ -365,9 +417,9 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
           }
         }
       }
-
-      gpu_pbvh_batch_init(buffers, GPU_PRIM_TRIS);
     }
+
+    gpu_pbvh_batch_init(buffers, GPU_PRIM_TRIS);
   }
 
   /* Get material index from the first face of this buffer. */
@@ -375,7 +427,9 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
   const MPoly *mp = &buffers->mpoly[lt->poly];
   buffers->material_index = mp->mat_nr;
 
-  buffers->show_mask = !empty_mask;
+  if (update_mask) {
+    buffers->show_mask = !empty_mask;
+  }
   buffers->mvert = mvert;
 }
 
@@ -729,17 +783,17 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
 
             if (has_mask && show_mask) {
               float fmask = *CCG_elem_mask(key, elem);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index, &fmask);
+              GPU_vertbuf_attr_set(buffers->vert_buf_mask, g_vbo_id.msk, vbo_index, &fmask);
               empty_mask = empty_mask && (fmask == 0.0f);
             }
 
             if (show_vcol) {
               ushort vcol[4] = {USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX};
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index, &vcol);
+              GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.col, vbo_index, &vcol);
             }
 
             uchar fsets[3] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index, &fsets);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.fset, vbo_index, &fsets);
 
             vbo_index += 1;
           }
@@ -781,24 +835,24 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
               float fsets = (*CCG_elem_mask(key, elems[0]) + *CCG_elem_mask(key, elems[1]) +
                              *CCG_elem_mask(key, elems[2]) + *CCG_elem_mask(key, elems[3])) *
                             0.25f;
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 0, &fsets);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 1, &fsets);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 2, &fsets);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 3, &fsets);
+              GPU_vertbuf_attr_set(buffers->vert_buf_mask, g_vbo_id.msk, vbo_index + 0, &fsets);
+              GPU_vertbuf_attr_set(buffers->vert_buf_mask, g_vbo_id.msk, vbo_index + 1, &fsets);
+              GPU_vertbuf_attr_set(buffers->vert_buf_mask, g_vbo_id.msk, vbo_index + 2, &fsets);
+              GPU_vertbuf_attr_set(buffers->vert_buf_mask, g_vbo_id.msk, vbo_index + 3, &fsets);
               empty_mask = empty_mask && (fsets == 0.0f);
             }
 
             ushort vcol[4] = {USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX};
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index + 0, &vcol);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index + 1, &vcol);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index + 2, &vcol);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.col, vbo_index + 3, &vcol);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.col, vbo_index + 0, &vcol);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.col, vbo_index + 1, &vcol);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.col, vbo_index + 2, &vcol);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.col, vbo_index + 3, &vcol);
 
             uchar fsets[3] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index + 0, &fsets);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index + 1, &fsets);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index + 2, &fsets);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.fset, vbo_index + 3, &fsets);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.fset, vbo_index + 0, &fsets);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.fset, vbo_index + 1, &fsets);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.fset, vbo_index + 2, &fsets);
+            GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.fset, vbo_index + 3, &fsets);
 
             vbo_index += 4;
           }
@@ -845,7 +899,7 @@ GPU_PBVH_Buffers *GPU_pbvh_grid_buffers_build(int totgrid, BLI_bitmap **grid_hid
 
 /* Output a BMVert into a VertexBufferFormat array at v_index. */
 static void gpu_bmesh_vert_to_buffer_copy(BMVert *v,
-                                          GPUVertBuf *vert_buf,
+                                          GPU_PBVH_Buffers *buffers,
                                           int v_index,
                                           const float fno[3],
                                           const float *fmask,
@@ -858,26 +912,26 @@ static void gpu_bmesh_vert_to_buffer_copy(BMVert *v,
   BLI_assert(!BM_elem_flag_test(v, BM_ELEM_HIDDEN));
 
   /* Set coord, normal, and mask */
-  GPU_vertbuf_attr_set(vert_buf, g_vbo_id.pos, v_index, v->co);
+  GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.pos, v_index, v->co);
 
   short no_short[3];
   normal_float_to_short_v3(no_short, fno ? fno : v->no);
-  GPU_vertbuf_attr_set(vert_buf, g_vbo_id.nor, v_index, no_short);
+  GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, v_index, no_short);
 
   if (show_mask) {
     float effective_mask = fmask ? *fmask : BM_ELEM_CD_GET_FLOAT(v, cd_vert_mask_offset);
-    GPU_vertbuf_attr_set(vert_buf, g_vbo_id.msk, v_index, &effective_mask);
+    GPU_vertbuf_attr_set(buffers->vert_buf_mask, g_vbo_id.msk, v_index, &effective_mask);
     *empty_mask = *empty_mask && (effective_mask == 0.0f);
   }
 
   if (show_vcol) {
     ushort vcol[4] = {USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX};
-    GPU_vertbuf_attr_set(vert_buf, g_vbo_id.col, v_index, &vcol);
+    GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.col, v_index, &vcol);
   }
 
   /* Add default face sets color to avoid artifacts. */
   uchar face_set[3] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
-  GPU_vertbuf_attr_set(vert_buf, g_vbo_id.fset, v_index, &face_set);
+  GPU_vertbuf_attr_set(buffers->vert_buf_color, g_vbo_id.fset, v_index, &face_set);
 }
 
 /* Return the total number of vertices that don't have BM_ELEM_HIDDEN set */
@@ -1007,7 +1061,7 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
             *idx_p = POINTER_FROM_UINT(v_index);
 
             gpu_bmesh_vert_to_buffer_copy(v[i],
-                                          buffers->vert_buf,
+                                          buffers,
                                           v_index,
                                           NULL,
                                           NULL,
@@ -1074,7 +1128,7 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
 
         for (i = 0; i < 3; i++) {
           gpu_bmesh_vert_to_buffer_copy(v[i],
-                                        buffers->vert_buf,
+                                        buffers,
                                         v_index++,
                                         f->no,
                                         &fmask,
@@ -1144,12 +1198,17 @@ void GPU_pbvh_buffers_update_flush(GPU_PBVH_Buffers *buffers)
     GPU_BATCH_DISCARD_SAFE(buffers->triangles);
     GPU_INDEXBUF_DISCARD_SAFE(buffers->index_buf);
     GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf);
+    GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf_mask);
+    GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf_color);
     buffers->clear_bmesh_on_flush = false;
   }
 
-  /* Force flushing to the GPU. */
-  if (buffers->vert_buf && buffers->vert_buf->data) {
-    GPU_vertbuf_use(buffers->vert_buf);
+  /* Force flushing to the GPU, only the buffers that were filled have data. */
+  GPUVertBuf *vert_bufs[3] = {buffers->vert_buf, buffers->vert_buf_mask, buffers->vert_buf_color};
+  for (int i = 0; i < ARRAY_SIZE(vert_bufs); i++) {
+    if (vert_bufs[i] && vert_bufs[i]->data) {
+      GPU_vertbuf_use(vert_bufs[i]);
+    }
   }
 }
 
@@ -1165,6 +1224,8 @@ void GPU_pbvh_buffers_free(GPU_PBVH_Buffers *buffers)
     GPU_INDEXBUF_DISCARD_SAFE(buffers->index_buf_fast);
     GPU_INDEXBUF_DISCARD_SAFE(buffers->index_buf);
     GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf);
+    GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf_mask);
+    GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf_color);
 
     MEM_freeN(buffers);
   }
@@ -33,11 +33,14 @@
 #include "BLI_link_utils.h"
 #include "BLI_utildefines.h"
 #include "BLI_dynstr.h"
+#include "BLI_fileops_types.h"
 #include "BLI_ghash.h"
 #include "BLI_threads.h"
 
 #include "PIL_time.h"
 
+#include "BKE_appdir.h"
+#include "BKE_global.h"
 #include "BKE_material.h"
 
 #include "GPU_extensions.h"
@@ -68,6 +71,8 @@ extern char datatoc_common_view_lib_glsl[];
 
 /* Only use one linklist that contains the GPUPasses grouped by hash. */
 static GPUPass *pass_cache = NULL;
+/* Maps a hash to the first pass of its group in #pass_cache. */
+static GHash *pass_cache_table = NULL;
 static SpinLock pass_cache_spin;
 
 static uint32_t gpu_pass_hash(const char *frag_gen, const char *defs, ListBase *attributes)
@@ -90,26 +95,21 @@ static uint32_t gpu_pass_hash(const char *frag_gen, const char *defs, ListBase *
 static GPUPass *gpu_pass_cache_lookup(uint32_t hash)
 {
   BLI_spin_lock(&pass_cache_spin);
-  /* Could be optimized with a Lookup table. */
-  for (GPUPass *pass = pass_cache; pass; pass = pass->next) {
-    if (pass->hash == hash) {
-      BLI_spin_unlock(&pass_cache_spin);
-      return pass;
-    }
-  }
+  GPUPass *pass = BLI_ghash_lookup(pass_cache_table, POINTER_FROM_UINT(hash));
   BLI_spin_unlock(&pass_cache_spin);
-  return NULL;
+  return pass;
 }
 
-/* Check all possible passes with the same hash. */
-static GPUPass *gpu_pass_cache_resolve_collision(GPUPass *pass,
-                                                 const char *vert,
-                                                 const char *geom,
-                                                 const char *frag,
-                                                 const char *defs,
-                                                 uint32_t hash)
+static void gpu_pass_free(GPUPass *pass);
+
+/* Check all possible passes with the same hash. Expects pass_cache_spin to be locked. */
+static GPUPass *gpu_pass_cache_resolve_collision_ex(GPUPass *pass,
+                                                    const char *vert,
+                                                    const char *geom,
+                                                    const char *frag,
+                                                    const char *defs,
+                                                    uint32_t hash)
 {
-  BLI_spin_lock(&pass_cache_spin);
   /* Collision, need to strcmp the whole shader. */
   for (; pass && (pass->hash == hash); pass = pass->next) {
     if ((defs != NULL) && (strcmp(pass->defines, defs) != 0)) { /* Pass */
@@ -117,14 +117,25 @@ static GPUPass *gpu_pass_cache_resolve_collision(GPUPass *pass,
     else if ((geom != NULL) && (strcmp(pass->geometrycode, geom) != 0)) { /* Pass */
     }
     else if ((strcmp(pass->fragmentcode, frag) == 0) && (strcmp(pass->vertexcode, vert) == 0)) {
-      BLI_spin_unlock(&pass_cache_spin);
       return pass;
     }
   }
-  BLI_spin_unlock(&pass_cache_spin);
   return NULL;
 }
 
+static GPUPass *gpu_pass_cache_resolve_collision(GPUPass *pass,
+                                                 const char *vert,
+                                                 const char *geom,
+                                                 const char *frag,
+                                                 const char *defs,
+                                                 uint32_t hash)
+{
+  BLI_spin_lock(&pass_cache_spin);
+  pass = gpu_pass_cache_resolve_collision_ex(pass, vert, geom, frag, defs, hash);
+  BLI_spin_unlock(&pass_cache_spin);
+  return pass;
+}
+
 /* GLSL code generation */
 
 static void codegen_convert_datatype(DynStr *ds, int from, int to, const char *tmp, int id)
@@ -1110,8 +1121,32 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
     pass->geometrycode = geometrycode;
     pass->defines = (defines) ? BLI_strdup(defines) : NULL;
     pass->compiled = false;
+    BLI_mutex_init(&pass->compile_lock);
 
     BLI_spin_lock(&pass_cache_spin);
+    /* Another thread may have added the same pass since the lookup above, check again. */
+    pass_hash = BLI_ghash_lookup(pass_cache_table, POINTER_FROM_UINT(hash));
+    GPUPass *pass_existing = NULL;
+    if (pass_hash != NULL) {
+      pass_existing = gpu_pass_cache_resolve_collision_ex(
+          pass_hash, vertexcode, geometrycode, fragmentcode, defines, hash);
+    }
+
+    if (pass_existing != NULL) {
+      BLI_spin_unlock(&pass_cache_spin);
+
+      pass->refcount = 0;
+      gpu_pass_free(pass);
+
+      pass = pass_existing;
+      if (!gpu_pass_is_valid(pass)) {
+        /* Shader has already been created but failed to compile. */
+        return NULL;
+      }
+      pass->refcount += 1;
+      return pass;
+    }
+
     if (pass_hash != NULL) {
       /* Add after the first pass having the same hash. */
       pass->next = pass_hash->next;
@@ -1120,6 +1155,7 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
     else {
       /* No other pass have same hash, just prepend to the list. */
       BLI_LINKS_PREPEND(pass_cache, pass);
+      BLI_ghash_insert(pass_cache_table, POINTER_FROM_UINT(hash), pass);
     }
     BLI_spin_unlock(&pass_cache_spin);
   }
@@ -1211,11 +1247,281 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
   return (total_samplers_len <= GPU_max_textures());
 }
 
-bool GPU_pass_compile(GPUPass *pass, const char *shname)
+/* -------------------------------------------------------------------- */
+/** \name Shader Binary Cache
+ *
+ * Program binaries of compiled passes are stored on disk, so the same materials don't need
+ * to be compiled again in later sessions. Binaries are only valid for the driver which created
+ * them, so the driver identification is part of the key, together with all GLSL code.
+ * \{ */
+
+#define GPU_BINARY_CACHE_DIRNAME "blender_shader_cache"
+#define GPU_BINARY_CACHE_MAGIC "BLSB"
+#define GPU_BINARY_CACHE_VERSION 1
+#define GPU_BINARY_CACHE_EXT ".bin"
+/* Disk space used by the cache, least recently written files are removed above it. */
+#define GPU_BINARY_CACHE_SIZE_LIMIT ((size_t)256 * 1024 * 1024)
+
+typedef struct GPUBinaryCacheHeader {
+  char magic[4];
+  uint32_t version;
+  /* Total length of the GLSL code, as an extra check against hash collisions. */
+  uint32_t source_len;
+  uint32_t binary_format;
+  int32_t binary_len;
+} GPUBinaryCacheHeader;
+
+typedef struct GPUBinaryCacheFile {
+  struct GPUBinaryCacheFile *next, *prev;
+  char path[FILE_MAX];
+  size_t size;
+  int64_t mtime;
+} GPUBinaryCacheFile;
+
+/* Hash of the driver identification strings, set on init. */
+static uint32_t binary_cache_driver_hash = 0;
+/* Size of the cache directory, measured on init and increased by writes.
+ * Protected by pass_cache_spin. */
+static size_t binary_cache_size_used = 0;
+
+static void gpu_binary_cache_dirpath(char *r_dirpath)
+{
+  BLI_join_dirfile(r_dirpath, FILE_MAX, BKE_tempdir_base(), GPU_BINARY_CACHE_DIRNAME);
+}
+
+static int gpu_binary_cache_file_cmp(const void *a_, const void *b_)
+{
+  const GPUBinaryCacheFile *a = a_;
+  const GPUBinaryCacheFile *b = b_;
+
+  return (a->mtime > b->mtime) - (a->mtime < b->mtime);
+}
+
+/**
+ * Remove the least recently written files until the cache fits the size limit, also removes
+ * temporary files left by interrupted writes. Only called on init and exit, when no pass is
+ * being compiled.
+ */
+static void gpu_binary_cache_enforce_limits(void)
+{
+  char dirpath[FILE_MAX];
+  gpu_binary_cache_dirpath(dirpath);
+
+  binary_cache_size_used = 0;
+  if (!BLI_is_dir(dirpath)) {
+    return;
+  }
+
+  ListBase files = {NULL, NULL};
+  struct direntry *filelist;
+  const uint filelist_len = BLI_filelist_dir_contents(dirpath, &filelist);
+  for (uint i = 0; i < filelist_len; i++) {
+    struct direntry *file = &filelist[i];
+    if (FILENAME_IS_CURRPAR(file->relname) || S_ISDIR(file->type)) {
+      continue;
+    }
+    if (!BLI_path_extension_check(file->relname, GPU_BINARY_CACHE_EXT)) {
+      BLI_delete(file->path, false, false);
+      continue;
+    }
+    GPUBinaryCacheFile *cache_file = MEM_callocN(sizeof(*cache_file), __func__);
+    BLI_strncpy(cache_file->path, file->path, sizeof(cache_file->path));
+    cache_file->size = (size_t)file->s.st_size;
+    cache_file->mtime = (int64_t)file->s.st_mtime;
+    BLI_addtail(&files, cache_file);
+    binary_cache_size_used += cache_file->size;
+  }
+  BLI_filelist_free(filelist, filelist_len);
+
+  BLI_listbase_sort(&files, gpu_binary_cache_file_cmp);
+  LISTBASE_FOREACH (GPUBinaryCacheFile *, cache_file, &files) {
+    if (binary_cache_size_used <= GPU_BINARY_CACHE_SIZE_LIMIT) {
+      break;
+    }
+    if (BLI_delete(cache_file->path, false, false) == 0) {
+      binary_cache_size_used -= cache_file->size;
+    }
+  }
+  BLI_freelistN(&files);
+}
+
+static void gpu_binary_cache_init(void)
+{
+  const char *driver_strings[] = {(const char *)glGetString(GL_VENDOR),
+                                  (const char *)glGetString(GL_RENDERER),
+                                  (const char *)glGetString(GL_VERSION)};
+  BLI_HashMurmur2A hm2a;
+  BLI_hash_mm2a_init(&hm2a, 0);
+  for (int i = 0; i < ARRAY_SIZE(driver_strings); i++) {
+    if (driver_strings[i]) {
+      BLI_hash_mm2a_add(&hm2a, (const uchar *)driver_strings[i], strlen(driver_strings[i]));
+    }
+  }
+  binary_cache_driver_hash = BLI_hash_mm2a_end(&hm2a);
+
+  gpu_binary_cache_enforce_limits();
+}
+
+static uint32_t gpu_binary_cache_hash(GPUPass *pass, uint32_t seed, uint32_t *r_source_len)
+{
+  const char *sources[] = {
+      pass->vertexcode, pass->geometrycode, pass->fragmentcode, pass->defines};
+  BLI_HashMurmur2A hm2a;
+  uint32_t source_len = 0;
+  BLI_hash_mm2a_init(&hm2a, seed);
+  BLI_hash_mm2a_add_int(&hm2a, (int)binary_cache_driver_hash);
+  for (int i = 0; i < ARRAY_SIZE(sources); i++) {
+    /* Separate the sources, so moving code from one to the next changes the hash. */
+    BLI_hash_mm2a_add_int(&hm2a, i);
+    if (sources[i]) {
+      const size_t len = strlen(sources[i]);
+      BLI_hash_mm2a_add(&hm2a, (const uchar *)sources[i], len);
+      source_len += (uint32_t)len;
+    }
+  }
+  if (r_source_len) {
+    *r_source_len = source_len;
+  }
+  return BLI_hash_mm2a_end(&hm2a);
+}
+
+/**
+ * \return false when the cache can't be used.
+ */
+static bool gpu_binary_cache_filepath(GPUPass *pass, char *r_filepath, uint32_t *r_source_len)
+{
+  if (!GLEW_ARB_get_program_binary) {
+    return false;
+  }
+
+  char dirpath[FILE_MAX];
+  gpu_binary_cache_dirpath(dirpath);
+  if (!BLI_is_dir(dirpath) && !BLI_dir_create_recursive(dirpath)) {
+    return false;
+  }
+
+  /* Two hashes with different seeds, making collisions very unlikely. */
+  char filename[32];
+  BLI_snprintf(filename,
+               sizeof(filename),
+               "%08x%08x" GPU_BINARY_CACHE_EXT,
+               gpu_binary_cache_hash(pass, 0, r_source_len),
+               gpu_binary_cache_hash(pass, 1, NULL));
+  BLI_join_dirfile(r_filepath, FILE_MAX, dirpath, filename);
+  return true;
+}
+
+/**
+ * Read the binary into `pass->binary`.
+ */
+static bool gpu_binary_cache_read(GPUPass *pass, const char *filepath, uint32_t source_len)
+{
+  FILE *file = BLI_fopen(filepath, "rb");
+  if (file == NULL) {
+    return false;
+  }
+
+  bool success = false;
+  GPUBinaryCacheHeader header;
+  if (fread(&header, sizeof(header), 1, file) == 1 &&
+      memcmp(header.magic, GPU_BINARY_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+      header.version == GPU_BINARY_CACHE_VERSION && header.source_len == source_len &&
+      header.binary_len > 0) {
+    char *binary = MEM_mallocN((size_t)header.binary_len, __func__);
+    if (fread(binary, (size_t)header.binary_len, 1, file) == 1) {
+      pass->binary.content = binary;
+      pass->binary.format = header.binary_format;
+      pass->binary.len = header.binary_len;
+      success = true;
+    }
+    else {
+      MEM_freeN(binary);
+    }
+  }
+  fclose(file);
+
+  if (G.debug & G_DEBUG_GPU_SHADERS) {
+    printf("GPUShader: %s binary cache '%s'\n", success ? "using" : "invalid", filepath);
+  }
+  return success;
+}
+
+static void gpu_binary_cache_write(const char *filepath,
+                                   uint32_t source_len,
+                                   const char *binary,
+                                   uint binary_format,
+                                   int binary_len)
+{
+  if (binary_len <= 0) {
+    return;
+  }
+
+  /* Don't grow the cache past its limit during the session, it is trimmed on exit. */
+  const size_t file_size = sizeof(GPUBinaryCacheHeader) + (size_t)binary_len;
+  BLI_spin_lock(&pass_cache_spin);
+  const bool is_full = (binary_cache_size_used + file_size > GPU_BINARY_CACHE_SIZE_LIMIT);
+  if (!is_full) {
+    binary_cache_size_used += file_size;
+  }
+  BLI_spin_unlock(&pass_cache_spin);
+  if (is_full) {
+    return;
+  }
+
+  /* Write to a temporary file first, so an incomplete file is never read. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s@", filepath);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == NULL) {
+    return;
+  }
+
+  GPUBinaryCacheHeader header = {
+      .version = GPU_BINARY_CACHE_VERSION,
+      .source_len = source_len,
+      .binary_format = binary_format,
+      .binary_len = binary_len,
+  };
+  memcpy(header.magic, GPU_BINARY_CACHE_MAGIC, sizeof(header.magic));
+
+  const bool success = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+                       (fwrite(binary, (size_t)binary_len, 1, file) == 1);
+  if ((fclose(file) != 0) || !success || (BLI_rename(filepath_tmp, filepath) != 0)) {
+    BLI_delete(filepath_tmp, false, false);
+  }
+}
+
+/** \} */
+
+static bool gpu_pass_compile_locked(GPUPass *pass, const char *shname)
 {
   bool success = true;
   if (!pass->compiled) {
-    GPUShader *shader = GPU_shader_create(
+    const bool use_local_shaders = !BLI_thread_is_main() && GPU_context_local_shaders_workaround();
+    char cache_filepath[FILE_MAX];
+    uint32_t source_len;
+    const bool use_binary_cache = gpu_binary_cache_filepath(pass, cache_filepath, &source_len);
+    GPUShader *shader = NULL;
+
+    /* Only validated shaders are stored in the cache. */
+    if (use_binary_cache && gpu_binary_cache_read(pass, cache_filepath, source_len)) {
+      if (use_local_shaders) {
+        /* Loaded on the main thread, as after compiling. */
+        pass->compiled = true;
+        return success;
+      }
+      shader = GPU_shader_load_from_binary(
+          pass->binary.content, pass->binary.format, pass->binary.len, shname);
+      MEM_SAFE_FREE(pass->binary.content);
+      if (shader != NULL) {
+        pass->shader = shader;
+        pass->compiled = true;
+        return success;
+      }
+      /* Rejected by the driver, compile again (and overwrite the cache). */
+    }
+
+    shader = GPU_shader_create(
         pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
 
     /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
@@ -1228,11 +1534,25 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
         shader = NULL;
       }
     }
-    else if (!BLI_thread_is_main() && GPU_context_local_shaders_workaround()) {
+    else if (use_local_shaders) {
       pass->binary.content = GPU_shader_get_binary(
           shader, &pass->binary.format, &pass->binary.len);
       GPU_shader_free(shader);
       shader = NULL;
+      if (use_binary_cache) {
+        gpu_binary_cache_write(cache_filepath,
+                               source_len,
+                               pass->binary.content,
+                               pass->binary.format,
+                               pass->binary.len);
+      }
+    }
+    else if (use_binary_cache) {
+      uint binary_format;
+      int binary_len;
+      char *binary = GPU_shader_get_binary(shader, &binary_format, &binary_len);
+      gpu_binary_cache_write(cache_filepath, source_len, binary, binary_format, binary_len);
+      MEM_freeN(binary);
     }
 
     pass->shader = shader;
@@ -1247,6 +1567,14 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
   return success;
 }
 
+bool GPU_pass_compile(GPUPass *pass, const char *shname)
+{
+  BLI_mutex_lock(&pass->compile_lock);
+  const bool success = gpu_pass_compile_locked(pass, shname);
+  BLI_mutex_unlock(&pass->compile_lock);
+  return success;
+}
+
 void GPU_pass_release(GPUPass *pass)
 {
   BLI_assert(pass->refcount > 0);
@@ -1266,6 +1594,7 @@ static void gpu_pass_free(GPUPass *pass)
   if (pass->binary.content) {
     MEM_freeN(pass->binary.content);
   }
+  BLI_mutex_end(&pass->compile_lock);
   MEM_freeN(pass);
 }
 
@@ -1288,6 +1617,16 @@ void GPU_pass_cache_garbage_collect(void)
     if (pass->refcount == 0) {
       /* Remove from list */
       *prev_pass = next;
+      /* Let the lookup table point to the next pass of the group, if any. */
+      void **table_pass_p = BLI_ghash_lookup_p(pass_cache_table, POINTER_FROM_UINT(pass->hash));
+      if (table_pass_p && (*table_pass_p == pass)) {
+        if (next && (next->hash == pass->hash)) {
+          *table_pass_p = next;
+        }
+        else {
+          BLI_ghash_remove(pass_cache_table, POINTER_FROM_UINT(pass->hash), NULL, NULL);
+        }
+      }
       gpu_pass_free(pass);
     }
     else {
@@ -1300,6 +1639,7 @@ void GPU_pass_cache_garbage_collect(void)
 void GPU_pass_cache_init(void)
 {
   BLI_spin_init(&pass_cache_spin);
+  pass_cache_table = BLI_ghash_int_new(__func__);
 }
 
 void GPU_pass_cache_free(void)
@@ -1310,6 +1650,8 @@ void GPU_pass_cache_free(void)
     gpu_pass_free(pass_cache);
     pass_cache = next;
   }
+  BLI_ghash_free(pass_cache_table, NULL, NULL);
+  pass_cache_table = NULL;
   BLI_spin_unlock(&pass_cache_spin);
 
   BLI_spin_end(&pass_cache_spin);
@@ -1319,10 +1661,12 @@ void GPU_pass_cache_free(void)
 
 void gpu_codegen_init(void)
 {
+  gpu_binary_cache_init();
 }
 
 void gpu_codegen_exit(void)
 {
+  gpu_binary_cache_enforce_limits();
   BKE_material_defaults_free_gpu();
   GPU_shader_free_builtin_shaders();
 }
@@ -26,6 +26,8 @@
 #ifndef __GPU_CODEGEN_H__
 #define __GPU_CODEGEN_H__
 
+#include "BLI_threads.h"
+
 struct GPUMaterial;
 struct GPUNodeGraph;
 struct GPUOutput;
@@ -49,6 +51,8 @@ typedef struct GPUPass {
     int len;
   } binary;
   bool compiled; /* Did we already tried to compile the attached GPUShader. */
+  /* Passes are shared by materials which can be compiled from different threads. */
+  ThreadMutex compile_lock;
 } GPUPass;
 
 /* Pass */
@@ -258,12 +258,76 @@ static int compare_packtile(const void *a, const void *b)
   return tile_a->pack_score < tile_b->pack_score;
 }
 
+/* Video memory currently available in bytes, zero when the driver can't tell. */
+static size_t gpu_texture_free_memory_get(void)
+{
+  int totalmem = 0, freemem = 0;
+
+  if (GLEW_NVX_gpu_memory_info || GLEW_ATI_meminfo) {
+    GPU_mem_stats_get(&totalmem, &freemem);
+  }
+
+  return (size_t)max_ii(freemem, 0) * 1024;
+}
+
+/**
+ * Tile sets can easily exceed video memory when uploaded at full resolution. Find the power of
+ * two that the tile resolution has to be divided by to make the tile array use at most half of the
+ * free video memory, so large sets degrade in resolution instead of failing to allocate or
+ * swapping. Returns 1 when everything fits or the driver doesn't report its memory.
+ */
+static int gpu_texture_tile_array_scale_get(ListBase *boxes, size_t pixel_size)
+{
+  const size_t free_mem = gpu_texture_free_memory_get();
+  if (free_mem == 0) {
+    return 1;
+  }
+
+  size_t area = 0;
+  int max_size = 0;
+  LISTBASE_FOREACH (PackTile *, packtile, boxes) {
+    area += (size_t)packtile->boxpack.w * (size_t)packtile->boxpack.h;
+    max_size = max_iii(max_size, packtile->boxpack.w, packtile->boxpack.h);
+  }
+
+  /* Mipmaps add another third. */
+  size_t mem = area * pixel_size;
+  mem += GPU_get_mipmap() ? mem / 3 : 0;
+
+  int scale = 1;
+  while (mem > free_mem / 2 && max_size / scale > 64) {
+    scale *= 2;
+    mem /= 4;
+  }
+
+  return scale;
+}
+
 static uint gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
 {
   int arraywidth = 0, arrayheight = 0;
 
   ListBase boxes = {NULL};
 
+  GLenum data_type, internal_format;
+  size_t pixel_size;
+  if (main_ibuf->rect_float) {
+    data_type = GL_FLOAT;
+    internal_format = (!(main_ibuf->flags & IB_halffloat) && (ima->flag & IMA_HIGH_BITDEPTH)) ?
+                          GL_RGBA32F :
+                          GL_RGBA16F;
+    pixel_size = (internal_format == GL_RGBA32F) ? 16 : 8;
+  }
+  else {
+    data_type = GL_UNSIGNED_BYTE;
+    internal_format = GL_RGBA8;
+    if (!IMB_colormanagement_space_is_data(main_ibuf->rect_colorspace) &&
+        !IMB_colormanagement_space_is_scene_linear(main_ibuf->rect_colorspace)) {
+      internal_format = GL_SRGB8_ALPHA8;
+    }
+    pixel_size = 4;
+  }
+
   LISTBASE_FOREACH (ImageTile *, tile, &ima->tiles) {
     ImageUser iuser;
     BKE_imageuser_default(&iuser);
@@ -281,19 +345,26 @@ static uint gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
         packtile->boxpack.w = smaller_power_of_2_limit(packtile->boxpack.w);
         packtile->boxpack.h = smaller_power_of_2_limit(packtile->boxpack.h);
       }
-      arraywidth = max_ii(arraywidth, packtile->boxpack.w);
-      arrayheight = max_ii(arrayheight, packtile->boxpack.h);
-
-      /* We sort the tiles by decreasing size, with an additional penalty term
-       * for high aspect ratios. This improves packing efficiency. */
-      float w = packtile->boxpack.w, h = packtile->boxpack.h;
-      packtile->pack_score = max_ff(w, h) / min_ff(w, h) * w * h;
 
       BKE_image_release_ibuf(ima, ibuf, NULL);
       BLI_addtail(&boxes, packtile);
     }
   }
 
+  const int scale = gpu_texture_tile_array_scale_get(&boxes, pixel_size);
+
+  LISTBASE_FOREACH (PackTile *, packtile, &boxes) {
+    packtile->boxpack.w = max_ii(packtile->boxpack.w / scale, 1);
+    packtile->boxpack.h = max_ii(packtile->boxpack.h / scale, 1);
+    arraywidth = max_ii(arraywidth, packtile->boxpack.w);
+    arrayheight = max_ii(arrayheight, packtile->boxpack.h);
+
+    /* We sort the tiles by decreasing size, with an additional penalty term
+     * for high aspect ratios. This improves packing efficiency. */
+    float w = packtile->boxpack.w, h = packtile->boxpack.h;
+    packtile->pack_score = max_ff(w, h) / min_ff(w, h) * w * h;
+  }
+
   BLI_assert(arraywidth > 0 && arrayheight > 0);
 
   BLI_listbase_sort(&boxes, compare_packtile);
@@ -325,22 +396,6 @@ static uint gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
   glGenTextures(1, (GLuint *)&bindcode);
   glBindTexture(GL_TEXTURE_2D_ARRAY, bindcode);
 
-  GLenum data_type, internal_format;
-  if (main_ibuf->rect_float) {
-    data_type = GL_FLOAT;
-    internal_format = (!(main_ibuf->flags & IB_halffloat) && (ima->flag & IMA_HIGH_BITDEPTH)) ?
-                          GL_RGBA32F :
-                          GL_RGBA16F;
-  }
-  else {
-    data_type = GL_UNSIGNED_BYTE;
-    internal_format = GL_RGBA8;
-    if (!IMB_colormanagement_space_is_data(main_ibuf->rect_colorspace) &&
-        !IMB_colormanagement_space_is_scene_linear(main_ibuf->rect_colorspace)) {
-      internal_format = GL_SRGB8_ALPHA8;
-    }
-  }
-
   glTexImage3D(GL_TEXTURE_2D_ARRAY,
                0,
                internal_format,
@@ -41,6 +41,9 @@
 extern void GPU_matrix_bind(const GPUShaderInterface *);
 extern bool GPU_matrix_dirty_get(void);
 
+/* Number of fenced regions the persistently mapped buffer is split into. */
+#define IMM_PERSISTENT_CHUNK_LEN 4
+
 typedef struct {
   /* TODO: organize this struct by frequency of change (run-time) */
 
@@ -66,6 +69,13 @@ typedef struct {
   GLuint vbo_id;
   GLuint vao_id;
 
+  /* Persistently mapped storage of vbo_id, NULL when ARB_buffer_storage is not used. */
+  GLubyte *persistent_data;
+  /* Fences protecting each chunk of the persistent buffer from being overwritten
+   * while the GPU may still read from it. */
+  GLsync chunk_fence[IMM_PERSISTENT_CHUNK_LEN];
+  uint chunk_active;
+
   GLuint bound_program;
   const GPUShaderInterface *shader_interface;
   GPUAttrBinding attr_binding;
@@ -79,6 +89,98 @@ static uint imm_buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
 static bool initialized = false;
 static Immediate imm;
 
+/* -------------------------------------------------------------------- */
+/** \name Persistent Buffer
+ *
+ * With ARB_buffer_storage the vertex buffer is mapped once and used as a ring buffer,
+ * instead of mapping and unmapping a range for every #immBegin / #immEnd pair.
+ * Overwriting data the GPU may still read is prevented with a fence per chunk.
+ * \{ */
+
+static bool imm_use_persistent_buffer(void)
+{
+  return GLEW_ARB_buffer_storage;
+}
+
+static void imm_persistent_fences_free(void)
+{
+  for (int i = 0; i < IMM_PERSISTENT_CHUNK_LEN; i++) {
+    if (imm.chunk_fence[i]) {
+      glDeleteSync(imm.chunk_fence[i]);
+      imm.chunk_fence[i] = NULL;
+    }
+  }
+  imm.chunk_active = 0;
+}
+
+/* Expects imm.vbo_id to be bound. */
+static void imm_persistent_buffer_create(void)
+{
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  glBufferStorage(GL_ARRAY_BUFFER, imm_buffer_size, NULL, flags);
+  imm.persistent_data = glMapBufferRange(GL_ARRAY_BUFFER, 0, imm_buffer_size, flags);
+
+#if TRUST_NO_ONE
+  assert(imm.persistent_data != NULL);
+#endif
+}
+
+/* Buffer storage is immutable, a new buffer is needed to change its size. */
+static void imm_persistent_buffer_resize(void)
+{
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  GPU_buf_free(imm.vbo_id);
+  imm_persistent_fences_free();
+
+  imm.vbo_id = GPU_buf_alloc();
+  glBindBuffer(GL_ARRAY_BUFFER, imm.vbo_id);
+  imm_persistent_buffer_create();
+}
+
+static uint imm_persistent_chunk_get(uint offset)
+{
+  const uint chunk_size = imm_buffer_size / IMM_PERSISTENT_CHUNK_LEN;
+  return MIN2(offset / chunk_size, IMM_PERSISTENT_CHUNK_LEN - 1);
+}
+
+/**
+ * Called before writing to the range starting at \a offset: fence the chunks the previous
+ * draw calls were reading from when leaving them, and wait for the GPU to be done with
+ * the chunks about to be overwritten.
+ */
+static void imm_persistent_chunks_sync(uint offset, uint bytes_needed)
+{
+  const uint chunk_first = imm_persistent_chunk_get(offset);
+  const uint chunk_last = imm_persistent_chunk_get(offset + MAX2(bytes_needed, 1) - 1);
+
+  /* Fence every chunk from the active one up to the first one written now,
+   * wrapping around at the end of the buffer. */
+  for (uint chunk = imm.chunk_active; chunk != chunk_first;
+       chunk = (chunk + 1) % IMM_PERSISTENT_CHUNK_LEN) {
+    if (imm.chunk_fence[chunk] == NULL) {
+      imm.chunk_fence[chunk] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+  }
+  imm.chunk_active = chunk_first;
+
+  for (uint chunk = chunk_first; chunk <= chunk_last; chunk++) {
+    GLsync fence = imm.chunk_fence[chunk];
+    if (fence == NULL) {
+      continue;
+    }
+    const GLuint64 timeout = 1000000000; /* One second, in nanoseconds. */
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout) == GL_TIMEOUT_EXPIRED) {
+      /* pass */
+    }
+    glDeleteSync(fence);
+    imm.chunk_fence[chunk] = NULL;
+  }
+}
+
+/** \} */
+
 void immInit(void)
 {
 #if TRUST_NO_ONE
@@ -88,7 +190,12 @@ void immInit(void)
 
   imm.vbo_id = GPU_buf_alloc();
   glBindBuffer(GL_ARRAY_BUFFER, imm.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, imm_buffer_size, NULL, GL_DYNAMIC_DRAW);
+  if (imm_use_persistent_buffer()) {
+    imm_persistent_buffer_create();
+  }
+  else {
+    glBufferData(GL_ARRAY_BUFFER, imm_buffer_size, NULL, GL_DYNAMIC_DRAW);
+  }
 
   imm.prim_type = GPU_PRIM_NONE;
   imm.strict_vertex_len = true;
@@ -122,6 +229,13 @@ void immDeactivate(void)
 
 void immDestroy(void)
 {
+  if (imm.persistent_data) {
+    glBindBuffer(GL_ARRAY_BUFFER, imm.vbo_id);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    imm.persistent_data = NULL;
+    imm_persistent_fences_free();
+  }
   GPU_buf_free(imm.vbo_id);
   initialized = false;
 }
@@ -241,24 +355,43 @@ void immBegin(GPUPrimType prim_type, uint vertex_len)
   /* Might waste a little space, but it's safe. */
   const uint pre_padding = padding(imm.buffer_offset, imm.vertex_format.stride);
 
-  if (!recreate_buffer && ((bytes_needed + pre_padding) <= available_bytes)) {
-    imm.buffer_offset += pre_padding;
+  if (imm.persistent_data) {
+    if (recreate_buffer) {
+      imm_persistent_buffer_resize();
+      imm.buffer_offset = 0;
+    }
+    else if ((bytes_needed + pre_padding) <= available_bytes) {
+      imm.buffer_offset += pre_padding;
+    }
+    else {
+      /* Wrap around, #imm_persistent_chunks_sync makes sure the GPU is done with it. */
+      imm.buffer_offset = 0;
+    }
+
+    imm_persistent_chunks_sync(imm.buffer_offset, bytes_needed);
+    imm.buffer_data = imm.persistent_data + imm.buffer_offset;
   }
   else {
-    /* orphan this buffer & start with a fresh one */
-    /* this method works on all platforms, old & new */
-    glBufferData(GL_ARRAY_BUFFER, imm_buffer_size, NULL, GL_DYNAMIC_DRAW);
+    if (!recreate_buffer && ((bytes_needed + pre_padding) <= available_bytes)) {
+      imm.buffer_offset += pre_padding;
+    }
+    else {
+      /* orphan this buffer & start with a fresh one */
+      /* this method works on all platforms, old & new */
+      glBufferData(GL_ARRAY_BUFFER, imm_buffer_size, NULL, GL_DYNAMIC_DRAW);
 
-    imm.buffer_offset = 0;
-  }
+      imm.buffer_offset = 0;
+    }
 
-  /*  printf("mapping %u to %u\n", imm.buffer_offset, imm.buffer_offset + bytes_needed - 1); */
+    /*  printf("mapping %u to %u\n", imm.buffer_offset, imm.buffer_offset + bytes_needed - 1); */
 
-  imm.buffer_data = glMapBufferRange(GL_ARRAY_BUFFER,
-                                     imm.buffer_offset,
-                                     bytes_needed,
-                                     GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
-                                         (imm.strict_vertex_len ? 0 : GL_MAP_FLUSH_EXPLICIT_BIT));
+    imm.buffer_data = glMapBufferRange(
+        GL_ARRAY_BUFFER,
+        imm.buffer_offset,
+        bytes_needed,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+            (imm.strict_vertex_len ? 0 : GL_MAP_FLUSH_EXPLICIT_BIT));
+  }
 
 #if TRUST_NO_ONE
   assert(imm.buffer_data != NULL);
@@ -388,7 +521,9 @@ void immEnd(void)
       /* unused buffer bytes are available to the next immBegin */
     }
     /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
-    glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    if (imm.persistent_data == NULL) {
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    }
   }
 
   if (imm.batch) {
@@ -401,7 +536,9 @@ void immEnd(void)
     imm.batch = NULL; /* don't free, batch belongs to caller */
   }
   else {
-    glUnmapBuffer(GL_ARRAY_BUFFER);
+    if (imm.persistent_data == NULL) {
+      glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
 
     if (imm.vertex_len > 0) {
       immDrawSetup();
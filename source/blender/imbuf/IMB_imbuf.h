@@ -95,6 +95,13 @@ struct Stereo3dFormat;
 void IMB_init(void);
 void IMB_exit(void);
 
+/**
+ * Resize thread pools of image libraries to the current system thread count.
+ *
+ * \attention Defined in module.c
+ */
+void IMB_threads_update(void);
+
 /**
  *
  * \attention Defined in readimage.c
@@ -117,6 +124,17 @@ struct ImBuf *IMB_testiffname(const char *filepath, int flags);
  */
 struct ImBuf *IMB_loadiffname(const char *filepath, int flags, char colorspace[IM_MAX_SPACE]);
 
+/**
+ *
+ * \attention Defined in readimage.c
+ */
+struct ImBuf *IMB_thumb_load_image(const char *filepath,
+                                   size_t max_thumb_size,
+                                   int flags,
+                                   char colorspace[IM_MAX_SPACE],
+                                   size_t *r_width,
+                                   size_t *r_height);
+
 /**
  *
  * \attention Defined in allocimbuf.c
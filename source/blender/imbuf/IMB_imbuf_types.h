@@ -170,6 +170,10 @@ typedef enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** decode movies on the GPU when a hardware decoder is available */
+  IB_animhwaccel = 1 << 19,
+  /** build a keyframe index in the background to seek movies without timecode index */
+  IB_animseekindex = 1 << 20,
 } eImBufFlags;
 
 /** \} */
@@ -131,6 +131,14 @@ struct anim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   struct SwsContext *img_convert_ctx;
+  /** Pixel format #img_convert_ctx converts from. */
+  enum AVPixelFormat img_convert_pix_fmt;
+  /** Hardware decoding device, NULL when decoding in software. */
+  AVBufferRef *hw_device_ctx;
+  /** Pixel format of frames decoded by #hw_device_ctx. */
+  enum AVPixelFormat hw_pix_fmt;
+  /** Frame downloaded from the decoding device. */
+  AVFrame *pFrameDownloaded;
   int videoStream;
 
   struct ImBuf *last_frame;
@@ -147,6 +155,11 @@ struct anim {
   struct anim *proxy_anim[IMB_PROXY_MAX_SLOT];
   struct anim_index *curr_idx[IMB_TC_MAX_SLOT];
 
+  /** Keyframe index used for seeking when no timecode index is used, see #IB_animseekindex. */
+  struct anim_index *keyframe_idx;
+  struct KeyframeIndexJob *keyframe_idx_job;
+  int keyframe_idx_tried;
+
   char colorspace[64];
   char suffix[64]; /* MAX_NAME - multiview */
 
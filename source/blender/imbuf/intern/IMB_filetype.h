@@ -41,6 +41,18 @@ typedef struct ImFileType {
                         int flags,
                         char colorspace[IM_MAX_SPACE]);
   struct ImBuf *(*load_filepath)(const char *name, int flags, char colorspace[IM_MAX_SPACE]);
+  /**
+   * Optional, load a reduced resolution image for thumbnails, see #IMB_thumb_load_image.
+   * The longest side should be at least \a max_thumb_size when the image is that large.
+   * \a r_width and \a r_height are set to the full resolution image size.
+   */
+  struct ImBuf *(*load_thumbnail)(const unsigned char *mem,
+                                  size_t size,
+                                  int flags,
+                                  size_t max_thumb_size,
+                                  char colorspace[IM_MAX_SPACE],
+                                  size_t *r_width,
+                                  size_t *r_height);
   int (*save)(struct ImBuf *ibuf, const char *name, int flags);
   void (*load_tile)(struct ImBuf *ibuf,
                     const unsigned char *mem,
@@ -108,6 +120,13 @@ struct ImBuf *imb_load_jpeg(const unsigned char *buffer,
                             size_t size,
                             int flags,
                             char colorspace[IM_MAX_SPACE]);
+struct ImBuf *imb_thumbnail_jpeg(const unsigned char *buffer,
+                                 size_t size,
+                                 int flags,
+                                 size_t max_thumb_size,
+                                 char colorspace[IM_MAX_SPACE],
+                                 size_t *r_width,
+                                 size_t *r_height);
 
 /* bmp */
 int imb_is_a_bmp(const unsigned char *buf);
@@ -99,6 +99,7 @@ unsigned long long IMB_indexer_get_seek_pos(struct anim_index *idx, int frameno_
 unsigned long long IMB_indexer_get_seek_pos_dts(struct anim_index *idx, int frameno_index);
 
 int IMB_indexer_get_frame_index(struct anim_index *idx, int frameno);
+int IMB_indexer_get_frame_index_for_pts(struct anim_index *idx, long long pts);
 unsigned long long IMB_indexer_get_pts(struct anim_index *idx, int frame_index);
 int IMB_indexer_get_duration(struct anim_index *idx);
 
@@ -110,6 +111,7 @@ void IMB_free_indices(struct anim *anim);
 
 struct anim *IMB_anim_open_proxy(struct anim *anim, IMB_Proxy_Size preview_size);
 struct anim_index *IMB_anim_open_index(struct anim *anim, IMB_Timecode_Type tc);
+struct anim_index *IMB_anim_open_keyframe_index(struct anim *anim);
 
 int IMB_proxy_size_to_array_index(IMB_Proxy_Size pr_size);
 int IMB_timecode_to_array_index(IMB_Timecode_Type tc);
@@ -491,6 +491,154 @@ BLI_INLINE bool need_aligned_ffmpeg_buffer(struct anim *anim)
   return (anim->x & 31) != 0;
 }
 
+/* Create the context converting decoded frames of the given pixel format to RGBA. */
+static struct SwsContext *ffmpeg_sws_context_create(struct anim *anim,
+                                                    enum AVPixelFormat pix_fmt)
+{
+  struct SwsContext *sws_ctx;
+#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+#  endif
+
+  sws_ctx = sws_getContext(anim->x,
+                           anim->y,
+                           pix_fmt,
+                           anim->x,
+                           anim->y,
+                           AV_PIX_FMT_RGBA,
+                           SWS_FAST_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
+                           NULL,
+                           NULL,
+                           NULL);
+
+  if (!sws_ctx) {
+    return NULL;
+  }
+
+#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(sws_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(sws_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+#  endif
+
+  return sws_ctx;
+}
+
+#  ifdef FFMPEG_HAVE_HW_DECODE
+
+/* Device types tried for hardware decoding, the first one that can be created is used. */
+static const enum AVHWDeviceType ffmpeg_hw_device_types[] = {
+    AV_HWDEVICE_TYPE_CUDA, /* NVDEC */
+    AV_HWDEVICE_TYPE_VAAPI,
+    AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+    AV_HWDEVICE_TYPE_D3D11VA,
+    AV_HWDEVICE_TYPE_DXVA2,
+};
+
+static enum AVPixelFormat ffmpeg_hw_get_format(AVCodecContext *pCodecCtx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  struct anim *anim = pCodecCtx->opaque;
+
+  for (const enum AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+
+  /* The device can't decode this stream (profile, bit depth...), decode in software. */
+  return avcodec_default_get_format(pCodecCtx, pix_fmts);
+}
+
+/* Attach a hardware decoding device to the codec context, must be called before opening it.
+ * Returns false when no device supported by the codec is available on this system. */
+static bool ffmpeg_hw_decode_init(struct anim *anim, AVCodecContext *pCodecCtx, AVCodec *pCodec)
+{
+  for (int i = 0; i < ARRAY_SIZE(ffmpeg_hw_device_types); i++) {
+    const AVCodecHWConfig *config;
+
+    for (int j = 0; (config = avcodec_get_hw_config(pCodec, j)) != NULL; j++) {
+      if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) &&
+          config->device_type == ffmpeg_hw_device_types[i]) {
+        break;
+      }
+    }
+
+    if (config == NULL ||
+        av_hwdevice_ctx_create(&anim->hw_device_ctx, config->device_type, NULL, NULL, 0) < 0) {
+      continue;
+    }
+
+    anim->hw_pix_fmt = config->pix_fmt;
+    pCodecCtx->hw_device_ctx = av_buffer_ref(anim->hw_device_ctx);
+    pCodecCtx->opaque = anim;
+    pCodecCtx->get_format = ffmpeg_hw_get_format;
+    return true;
+  }
+
+  return false;
+}
+
+/* Copy the frame decoded on the device to system memory so it can be converted by swscale.
+ * Only frames that get displayed are downloaded, frames skipped while seeking are not. */
+static AVFrame *ffmpeg_hw_decode_download(struct anim *anim)
+{
+  AVFrame *frame;
+
+  if (anim->pFrameDownloaded == NULL) {
+    anim->pFrameDownloaded = av_frame_alloc();
+  }
+  frame = anim->pFrameDownloaded;
+  av_frame_unref(frame);
+
+  if (av_hwframe_transfer_data(frame, anim->pFrame, 0) < 0) {
+    fprintf(stderr, "ffmpeg_fetchibuf: could not download frame from hardware decoder\n");
+    return NULL;
+  }
+
+  /* The format of downloaded frames is only known once the first frame is decoded. */
+  if (frame->format != anim->img_convert_pix_fmt) {
+    struct SwsContext *sws_ctx = ffmpeg_sws_context_create(anim, frame->format);
+    if (!sws_ctx) {
+      fprintf(stderr, "Can't transform color space??? Bailing out...\n");
+      return NULL;
+    }
+    sws_freeContext(anim->img_convert_ctx);
+    anim->img_convert_ctx = sws_ctx;
+    anim->img_convert_pix_fmt = frame->format;
+  }
+
+  return frame;
+}
+
+#  endif /* FFMPEG_HAVE_HW_DECODE */
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -504,13 +652,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-#  endif
-
   if (anim == NULL) {
     return (-1);
   }
@@ -559,13 +700,22 @@ static int startffmpeg(struct anim *anim)
 
   pCodecCtx->workaround_bugs = 1;
 
+#  ifdef FFMPEG_HAVE_HW_DECODE
+  /* Deinterlacing works on frames in the codec pixel format, keep those in software. */
+  if ((anim->ib_flags & IB_animhwaccel) && !(anim->ib_flags & IB_animdeinterlace)) {
+    ffmpeg_hw_decode_init(anim, pCodecCtx, pCodec);
+  }
+#  endif
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
     avformat_close_input(&pFormatCtx);
+    av_buffer_unref(&anim->hw_device_ctx);
     return -1;
   }
   if (pCodecCtx->pix_fmt == AV_PIX_FMT_NONE) {
     avcodec_close(anim->pCodecCtx);
     avformat_close_input(&pFormatCtx);
+    av_buffer_unref(&anim->hw_device_ctx);
     return -1;
   }
 
@@ -641,6 +791,7 @@ static int startffmpeg(struct anim *anim)
       fprintf(stderr, "Could not allocate frame data.\n");
       avcodec_close(anim->pCodecCtx);
       avformat_close_input(&anim->pFormatCtx);
+      av_buffer_unref(&anim->hw_device_ctx);
       av_frame_free(&anim->pFrameRGB);
       av_frame_free(&anim->pFrameDeinterlaced);
       av_frame_free(&anim->pFrame);
@@ -653,6 +804,7 @@ static int startffmpeg(struct anim *anim)
     fprintf(stderr, "ffmpeg has changed alloc scheme ... ARGHHH!\n");
     avcodec_close(anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
+    av_buffer_unref(&anim->hw_device_ctx);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
@@ -678,21 +830,14 @@ static int startffmpeg(struct anim *anim)
     anim->preseek = 0;
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_FAST_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
+  anim->img_convert_ctx = ffmpeg_sws_context_create(anim, anim->pCodecCtx->pix_fmt);
+  anim->img_convert_pix_fmt = anim->pCodecCtx->pix_fmt;
 
   if (!anim->img_convert_ctx) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
     avcodec_close(anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
+    av_buffer_unref(&anim->hw_device_ctx);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
@@ -700,35 +845,6 @@ static int startffmpeg(struct anim *anim)
     return -1;
   }
 
-#  ifdef FFMPEG_SWSCALE_COLOR_SPACE_SUPPORT
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-#  endif
-
   return (0);
 }
 
@@ -748,6 +864,15 @@ static void ffmpeg_postprocess(struct anim *anim)
     return;
   }
 
+#  ifdef FFMPEG_HAVE_HW_DECODE
+  if (anim->hw_device_ctx && input->format == anim->hw_pix_fmt) {
+    input = ffmpeg_hw_decode_download(anim);
+    if (input == NULL) {
+      return;
+    }
+  }
+#  endif
+
   /* This means the data wasn't read properly,
    * this check stops crashing */
   if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 && input->data[3] == 0) {
@@ -1041,6 +1166,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
   double pts_time_base;
   long long st_time;
   struct anim_index *tc_index = 0;
+  struct anim_index *keyframe_index = NULL;
   AVStream *v_st;
   int new_frame_index = 0; /* To quiet gcc barking... */
   int old_frame_index = 0; /* To quiet gcc barking... */
@@ -1055,6 +1181,11 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
     tc_index = IMB_anim_open_index(anim, tc);
   }
 
+  /* Opening the movie decodes its first frame, the keyframe index is only needed after that. */
+  if (!tc_index && (anim->ib_flags & IB_animseekindex) && anim->curposition != -1) {
+    keyframe_index = IMB_anim_open_keyframe_index(anim);
+  }
+
   v_st = anim->pFormatCtx->streams[anim->videoStream];
 
   frame_rate = av_q2d(av_guess_frame_rate(anim->pFormatCtx, v_st, NULL));
@@ -1095,7 +1226,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
     return anim->last_frame;
   }
 
-  if (position > anim->curposition + 1 && anim->preseek && !tc_index &&
+  if (position > anim->curposition + 1 && anim->preseek && !tc_index && !keyframe_index &&
       position - (anim->curposition + 1) < anim->preseek) {
     av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: within preseek interval (no index)\n");
 
@@ -1109,15 +1240,32 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
 
     ffmpeg_decode_video_frame_scan(anim, pts_to_search);
   }
+  else if (keyframe_index && position > anim->curposition + 1 &&
+           IMB_indexer_get_frame_index_for_pts(keyframe_index, anim->last_pts) ==
+               IMB_indexer_get_frame_index_for_pts(keyframe_index, pts_to_search)) {
+    av_log(anim->pFormatCtx,
+           AV_LOG_DEBUG,
+           "FETCH: no keyframe in between "
+           "(keyframe index tells us)\n");
+
+    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+  }
   else if (position != anim->curposition + 1) {
+    struct anim_index *seek_index = tc_index;
+    int seek_frame_index = new_frame_index;
     long long pos;
     int ret;
 
-    if (tc_index) {
+    if (!tc_index && keyframe_index) {
+      seek_index = keyframe_index;
+      seek_frame_index = IMB_indexer_get_frame_index_for_pts(keyframe_index, pts_to_search);
+    }
+
+    if (seek_index) {
       unsigned long long dts;
 
-      pos = IMB_indexer_get_seek_pos(tc_index, new_frame_index);
-      dts = IMB_indexer_get_seek_pos_dts(tc_index, new_frame_index);
+      pos = IMB_indexer_get_seek_pos(seek_index, seek_frame_index);
+      dts = IMB_indexer_get_seek_pos_dts(seek_index, seek_frame_index);
 
       av_log(anim->pFormatCtx, AV_LOG_DEBUG, "TC INDEX seek pos = %lld\n", pos);
       av_log(anim->pFormatCtx, AV_LOG_DEBUG, "TC INDEX seek dts = %llu\n", dts);
@@ -1234,6 +1382,8 @@ static void free_anim_ffmpeg(struct anim *anim)
     }
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameDownloaded);
+    av_buffer_unref(&anim->hw_device_ctx);
 
     sws_freeContext(anim->img_convert_ctx);
     IMB_freeImBuf(anim->last_frame);
@@ -2212,50 +2212,44 @@ void IMB_colormanagement_colorspace_to_scene_linear(float *buffer,
   }
 }
 
-void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
-                                               const int offset_x,
-                                               const int offset_y,
-                                               const int width,
-                                               const int height,
-                                               const struct ImBuf *ibuf,
-                                               const bool compress_as_srgb,
-                                               const bool store_premultiplied)
-{
-  /* Convert byte buffer for texture storage on the GPU. These have builtin
-   * support for converting sRGB to linear, which allows us to store textures
-   * without precision or performance loss at minimal memory usage. */
-  BLI_assert(ibuf->rect && ibuf->rect_float == NULL);
-
-  OCIO_ConstProcessorRcPtr *processor = NULL;
-  if (compress_as_srgb && ibuf->rect_colorspace &&
-      !IMB_colormanagement_space_is_srgb(ibuf->rect_colorspace)) {
-    processor = colorspace_to_scene_linear_processor(ibuf->rect_colorspace);
-  }
+typedef struct ImbufToTextureThreadData {
+  const ImBuf *ibuf;
+  void *out_buffer;
+  int offset_x, offset_y;
+  int width;
+  OCIO_ConstProcessorRcPtr *processor;
+  bool use_premultiply;
+  bool use_unpremultiply;
+} ImbufToTextureThreadData;
 
-  /* TODO(brecht): make this multi-threaded, or at least process in batches. */
+static void imbuf_to_byte_texture_thread_do(void *data_v, int start_scanline, int num_scanlines)
+{
+  ImbufToTextureThreadData *data = (ImbufToTextureThreadData *)data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
   const unsigned char *in_buffer = (unsigned char *)ibuf->rect;
-  const bool use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied;
+  unsigned char *out_buffer = (unsigned char *)data->out_buffer;
 
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
+  for (int y = start_scanline; y < start_scanline + num_scanlines; y++) {
+    const size_t in_offset = (size_t)(data->offset_y + y) * ibuf->x + data->offset_x;
+    const size_t out_offset = (size_t)y * width;
     const unsigned char *in = in_buffer + in_offset * 4;
     unsigned char *out = out_buffer + out_offset * 4;
 
-    if (processor) {
+    if (data->processor) {
       /* Convert to scene linear, to sRGB and premultiply. */
       for (int x = 0; x < width; x++, in += 4, out += 4) {
         float pixel[4];
         rgba_uchar_to_float(pixel, in);
-        OCIO_processorApplyRGB(processor, pixel);
+        OCIO_processorApplyRGB(data->processor, pixel);
         linearrgb_to_srgb_v3_v3(pixel, pixel);
-        if (use_premultiply) {
+        if (data->use_premultiply) {
           mul_v3_fl(pixel, pixel[3]);
         }
         rgba_float_to_uchar(out, pixel);
       }
     }
-    else if (use_premultiply) {
+    else if (data->use_premultiply) {
       /* Premultiply only. */
       for (int x = 0; x < width; x++, in += 4, out += 4) {
         out[0] = (in[0] * in[3]) >> 8;
@@ -2266,34 +2260,64 @@ void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
     }
     else {
       /* Copy only. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = in[0];
-        out[1] = in[1];
-        out[2] = in[2];
-        out[3] = in[3];
-      }
+      memcpy(out, in, sizeof(unsigned char) * 4 * width);
     }
   }
 }
 
-void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
-                                                const int offset_x,
-                                                const int offset_y,
-                                                const int width,
-                                                const int height,
-                                                const struct ImBuf *ibuf,
-                                                const bool store_premultiplied)
+void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
+                                               const int offset_x,
+                                               const int offset_y,
+                                               const int width,
+                                               const int height,
+                                               const struct ImBuf *ibuf,
+                                               const bool compress_as_srgb,
+                                               const bool store_premultiplied)
 {
-  /* Float texture are stored in scene linear color space, with premultiplied
-   * alpha depending on the image alpha mode. */
+  /* Convert byte buffer for texture storage on the GPU. These have builtin
+   * support for converting sRGB to linear, which allows us to store textures
+   * without precision or performance loss at minimal memory usage. */
+  BLI_assert(ibuf->rect && ibuf->rect_float == NULL);
+
+  OCIO_ConstProcessorRcPtr *processor = NULL;
+  if (compress_as_srgb && ibuf->rect_colorspace &&
+      !IMB_colormanagement_space_is_srgb(ibuf->rect_colorspace)) {
+    processor = colorspace_to_scene_linear_processor(ibuf->rect_colorspace);
+  }
+
+  ImbufToTextureThreadData data = {
+      .ibuf = ibuf,
+      .out_buffer = out_buffer,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .processor = processor,
+      .use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied,
+  };
+
+  /* Full images are converted when creating textures, partial updates from
+   * painting are usually small enough to not be worth threading. */
+  if ((size_t)width * height > 64 * 64) {
+    IMB_processor_apply_threaded_scanlines(height, imbuf_to_byte_texture_thread_do, &data);
+  }
+  else {
+    imbuf_to_byte_texture_thread_do(&data, 0, height);
+  }
+}
+
+static void imbuf_to_float_texture_thread_do(void *data_v, int start_scanline, int num_scanlines)
+{
+  ImbufToTextureThreadData *data = (ImbufToTextureThreadData *)data_v;
+  const ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
   const float *in_buffer = ibuf->rect_float;
   const int in_channels = ibuf->channels;
-  const bool use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied;
+  float *out_buffer = (float *)data->out_buffer;
 
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
-    const float *in = in_buffer + in_offset * 4;
+  for (int y = start_scanline; y < start_scanline + num_scanlines; y++) {
+    const size_t in_offset = (size_t)(data->offset_y + y) * ibuf->x + data->offset_x;
+    const size_t out_offset = (size_t)y * width;
+    const float *in = in_buffer + in_offset * in_channels;
     float *out = out_buffer + out_offset * 4;
 
     if (in_channels == 1) {
@@ -2316,7 +2340,7 @@ void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
     }
     else if (in_channels == 4) {
       /* Copy or convert RGBA. */
-      if (use_unpremultiply) {
+      if (data->use_unpremultiply) {
         for (int x = 0; x < width; x++, in += 4, out += 4) {
           premul_to_straight_v4_v4(out, in);
         }
@@ -2328,6 +2352,33 @@ void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
   }
 }
 
+void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
+                                                const int offset_x,
+                                                const int offset_y,
+                                                const int width,
+                                                const int height,
+                                                const struct ImBuf *ibuf,
+                                                const bool store_premultiplied)
+{
+  /* Float texture are stored in scene linear color space, with premultiplied
+   * alpha depending on the image alpha mode. */
+  ImbufToTextureThreadData data = {
+      .ibuf = ibuf,
+      .out_buffer = out_buffer,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied,
+  };
+
+  if ((size_t)width * height > 64 * 64) {
+    IMB_processor_apply_threaded_scanlines(height, imbuf_to_float_texture_thread_do, &data);
+  }
+  else {
+    imbuf_to_float_texture_thread_do(&data, 0, height);
+  }
+}
+
 /* Conversion between color picking role. Typically we would expect such a
  * requirements:
  * - It is approximately perceptually linear, so that the HSV numbers and
@@ -58,6 +58,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_load_jpeg,
      NULL,
+     imb_thumbnail_jpeg,
      imb_savejpeg,
      NULL,
      0,
@@ -70,6 +71,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_loadpng,
      NULL,
+     NULL,
      imb_savepng,
      NULL,
      0,
@@ -82,6 +84,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_bmp_decode,
      NULL,
+     NULL,
      imb_savebmp,
      NULL,
      0,
@@ -94,6 +97,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_loadtarga,
      NULL,
+     NULL,
      imb_savetarga,
      NULL,
      0,
@@ -106,6 +110,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_iris,
      imb_loadiris,
      NULL,
+     NULL,
      imb_saveiris,
      NULL,
      0,
@@ -119,6 +124,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_load_dpx,
      NULL,
+     NULL,
      imb_save_dpx,
      NULL,
      IM_FTYPE_FLOAT,
@@ -131,6 +137,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_load_cineon,
      NULL,
+     NULL,
      imb_save_cineon,
      NULL,
      IM_FTYPE_FLOAT,
@@ -145,6 +152,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_loadtiff,
      NULL,
+     NULL,
      imb_savetiff,
      imb_loadtiletiff,
      0,
@@ -159,6 +167,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_loadhdr,
      NULL,
+     NULL,
      imb_savehdr,
      NULL,
      IM_FTYPE_FLOAT,
@@ -173,6 +182,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_load_openexr,
      NULL,
+     NULL,
      imb_save_openexr,
      NULL,
      IM_FTYPE_FLOAT,
@@ -187,6 +197,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_ftype_default,
      imb_load_jp2,
      NULL,
+     NULL,
      imb_save_jp2,
      NULL,
      IM_FTYPE_FLOAT,
@@ -203,6 +214,7 @@ const ImFileType IMB_FILE_TYPES[] = {
      NULL,
      NULL,
      NULL,
+     NULL,
      0,
      IMB_FTYPE_DDS,
      COLOR_ROLE_DEFAULT_BYTE},
@@ -217,11 +229,12 @@ const ImFileType IMB_FILE_TYPES[] = {
      imb_load_photoshop,
      NULL,
      NULL,
+     NULL,
      IM_FTYPE_FLOAT,
      IMB_FTYPE_PSD,
      COLOR_ROLE_DEFAULT_FLOAT},
 #endif
-    {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0},
+    {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0},
 };
 
 const ImFileType *IMB_FILE_TYPES_LAST =
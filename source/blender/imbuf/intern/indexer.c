@@ -30,6 +30,8 @@
 #include "BLI_string.h"
 #include "BLI_fileops.h"
 #include "BLI_ghash.h"
+#include "BLI_math_base.h"
+#include "BLI_threads.h"
 
 #include "IMB_indexer.h"
 #include "IMB_anim.h"
@@ -270,6 +272,35 @@ int IMB_indexer_get_frame_index(struct anim_index *idx, int frameno)
   }
 }
 
+/* Index of the last entry presented at or before pts, entries have to be sorted by pts. */
+int IMB_indexer_get_frame_index_for_pts(struct anim_index *idx, long long pts)
+{
+  int len = idx->num_entries;
+  int half;
+  int middle;
+  int first = 0;
+
+  /* bsearch (upper bound) the right index */
+
+  while (len > 0) {
+    half = len >> 1;
+    middle = first;
+
+    middle += half;
+
+    if ((long long)idx->entries[middle].pts <= pts) {
+      first = middle;
+      first++;
+      len = len - half - 1;
+    }
+    else {
+      len = half;
+    }
+  }
+
+  return max_ii(first - 1, 0);
+}
+
 unsigned long long IMB_indexer_get_pts(struct anim_index *idx, int frame_index)
 {
   if (frame_index < 0) {
@@ -428,6 +459,25 @@ static void get_tc_filename(struct anim *anim, IMB_Timecode_Type tc, char *fname
   BLI_join_dirfile(fname, FILE_MAXFILE + FILE_MAXDIR, index_dir, index_name);
 }
 
+static void get_keyframe_index_filename(struct anim *anim, char *fname)
+{
+  char index_dir[FILE_MAXDIR];
+  char stream_suffix[20];
+  char index_name[256];
+
+  stream_suffix[0] = 0;
+
+  if (anim->streamindex > 0) {
+    BLI_snprintf(stream_suffix, 20, "_st%d", anim->streamindex);
+  }
+
+  BLI_snprintf(index_name, 256, "keyframes%s%s.blen_tc", stream_suffix, anim->suffix);
+
+  get_index_dir(anim, index_dir, sizeof(index_dir));
+
+  BLI_join_dirfile(fname, FILE_MAXFILE + FILE_MAXDIR, index_dir, index_name);
+}
+
 /* ----------------------------------------------------------------------
  * - common rebuilder structures
  * ---------------------------------------------------------------------- */
@@ -968,6 +1018,203 @@ static int index_rebuild_ffmpeg(FFmpegIndexBuilderContext *context,
   return 1;
 }
 
+/* ----------------------------------------------------------------------
+ * - keyframe index
+ *
+ * Lightweight index of the keyframes of a movie, used for seeking when no
+ * timecode index is used. It only reads packet headers (nothing is decoded),
+ * is built in the background the first time a movie is used, and is stored
+ * next to the timecode indices so that later sessions reuse it.
+ * ---------------------------------------------------------------------- */
+
+typedef struct KeyframeIndexJob {
+  ListBase threads;
+  ThreadMutex mutex;
+
+  char anim_name[1024];
+  char fname[FILE_MAX];
+  int streamindex;
+
+  bool stop;
+  bool done;
+} KeyframeIndexJob;
+
+/* Index files being built, so several anims of the same movie only build it once. */
+static GSet *keyframe_index_building = NULL;
+static ThreadMutex keyframe_index_building_lock = BLI_MUTEX_INITIALIZER;
+
+static bool keyframe_index_job_is_stopped(KeyframeIndexJob *job)
+{
+  bool stop;
+
+  BLI_mutex_lock(&job->mutex);
+  stop = job->stop;
+  BLI_mutex_unlock(&job->mutex);
+
+  return stop;
+}
+
+static int keyframe_index_entry_cmp(const void *a_v, const void *b_v)
+{
+  const anim_index_entry *a = a_v;
+  const anim_index_entry *b = b_v;
+
+  if (a->pts < b->pts) {
+    return -1;
+  }
+  return (a->pts > b->pts);
+}
+
+static void keyframe_index_build(KeyframeIndexJob *job)
+{
+  AVFormatContext *format_ctx = NULL;
+  AVPacket packet;
+  anim_index_entry *entries;
+  anim_index_builder *builder;
+  int entries_len = 256;
+  int num_entries = 0;
+  int video_stream = -1;
+  int streamcount = job->streamindex;
+  bool stop = false;
+  int i;
+
+  if (avformat_open_input(&format_ctx, job->anim_name, NULL, NULL) != 0) {
+    return;
+  }
+
+  if (avformat_find_stream_info(format_ctx, NULL) < 0) {
+    avformat_close_input(&format_ctx);
+    return;
+  }
+
+  for (i = 0; i < format_ctx->nb_streams; i++) {
+    if (format_ctx->streams[i]->codec->codec_type == AVMEDIA_TYPE_VIDEO) {
+      if (streamcount > 0) {
+        streamcount--;
+        continue;
+      }
+      video_stream = i;
+      break;
+    }
+  }
+
+  if (video_stream == -1) {
+    avformat_close_input(&format_ctx);
+    return;
+  }
+
+  entries = MEM_mallocN(sizeof(*entries) * entries_len, "keyframe index entries");
+  memset(&packet, 0, sizeof(AVPacket));
+
+  while (av_read_frame(format_ctx, &packet) >= 0) {
+    if (packet.stream_index == video_stream && (packet.flags & AV_PKT_FLAG_KEY) &&
+        packet.pts != AV_NOPTS_VALUE) {
+      if (num_entries == entries_len) {
+        entries_len *= 2;
+        entries = MEM_reallocN(entries, sizeof(*entries) * entries_len);
+      }
+      entries[num_entries].seek_pos = packet.pos;
+      entries[num_entries].seek_pos_dts = packet.dts;
+      entries[num_entries].pts = packet.pts;
+      num_entries++;
+    }
+    av_free_packet(&packet);
+
+    if (keyframe_index_job_is_stopped(job)) {
+      stop = true;
+      break;
+    }
+  }
+
+  avformat_close_input(&format_ctx);
+
+  if (!stop && num_entries > 0) {
+    /* Packets are read in decoding order, seeking looks keyframes up by presentation time. */
+    qsort(entries, num_entries, sizeof(*entries), keyframe_index_entry_cmp);
+
+    builder = IMB_index_builder_create(job->fname);
+    if (builder) {
+      for (i = 0; i < num_entries; i++) {
+        IMB_index_builder_add_entry(
+            builder, i, entries[i].seek_pos, entries[i].seek_pos_dts, entries[i].pts);
+      }
+      IMB_index_builder_finish(builder, false);
+    }
+  }
+
+  MEM_freeN(entries);
+}
+
+static void *keyframe_index_job_run(void *job_v)
+{
+  KeyframeIndexJob *job = job_v;
+
+  keyframe_index_build(job);
+
+  BLI_mutex_lock(&job->mutex);
+  job->done = true;
+  BLI_mutex_unlock(&job->mutex);
+
+  return NULL;
+}
+
+/* Returns false when another anim is already building the index. */
+static bool keyframe_index_job_start(struct anim *anim, const char *fname)
+{
+  KeyframeIndexJob *job;
+  bool started = false;
+
+  BLI_mutex_lock(&keyframe_index_building_lock);
+
+  if (keyframe_index_building == NULL) {
+    keyframe_index_building = BLI_gset_str_new(__func__);
+  }
+
+  if (!BLI_gset_haskey(keyframe_index_building, fname)) {
+    job = MEM_callocN(sizeof(KeyframeIndexJob), "keyframe index job");
+    BLI_mutex_init(&job->mutex);
+    BLI_strncpy(job->anim_name, anim->name, sizeof(job->anim_name));
+    BLI_strncpy(job->fname, fname, sizeof(job->fname));
+    job->streamindex = anim->streamindex;
+
+    BLI_gset_insert(keyframe_index_building, job->fname);
+
+    BLI_threadpool_init(&job->threads, keyframe_index_job_run, 1);
+    BLI_threadpool_insert(&job->threads, job);
+
+    anim->keyframe_idx_job = job;
+    started = true;
+  }
+
+  BLI_mutex_unlock(&keyframe_index_building_lock);
+
+  return started;
+}
+
+static void keyframe_index_job_end(struct anim *anim)
+{
+  KeyframeIndexJob *job = anim->keyframe_idx_job;
+
+  BLI_mutex_lock(&job->mutex);
+  job->stop = true;
+  BLI_mutex_unlock(&job->mutex);
+
+  BLI_threadpool_end(&job->threads);
+
+  BLI_mutex_lock(&keyframe_index_building_lock);
+  BLI_gset_remove(keyframe_index_building, job->fname, NULL);
+  if (BLI_gset_len(keyframe_index_building) == 0) {
+    BLI_gset_free(keyframe_index_building, NULL);
+    keyframe_index_building = NULL;
+  }
+  BLI_mutex_unlock(&keyframe_index_building_lock);
+
+  BLI_mutex_end(&job->mutex);
+  MEM_freeN(job);
+
+  anim->keyframe_idx_job = NULL;
+}
+
 #endif
 
 /* ----------------------------------------------------------------------
@@ -1278,8 +1525,20 @@ void IMB_free_indices(struct anim *anim)
     }
   }
 
+#ifdef WITH_FFMPEG
+  if (anim->keyframe_idx_job) {
+    keyframe_index_job_end(anim);
+  }
+#endif
+
+  if (anim->keyframe_idx) {
+    IMB_indexer_close(anim->keyframe_idx);
+    anim->keyframe_idx = NULL;
+  }
+
   anim->proxies_tried = 0;
   anim->indices_tried = 0;
+  anim->keyframe_idx_tried = 0;
 }
 
 void IMB_anim_set_index_dir(struct anim *anim, const char *dir)
@@ -1337,6 +1596,52 @@ struct anim_index *IMB_anim_open_index(struct anim *anim, IMB_Timecode_Type tc)
   return anim->curr_idx[i];
 }
 
+/* Returns NULL while the keyframe index is being built. */
+struct anim_index *IMB_anim_open_keyframe_index(struct anim *anim)
+{
+#ifdef WITH_FFMPEG
+  char fname[FILE_MAX];
+
+  if (anim->keyframe_idx) {
+    return anim->keyframe_idx;
+  }
+
+  if (anim->keyframe_idx_job) {
+    bool done;
+
+    BLI_mutex_lock(&anim->keyframe_idx_job->mutex);
+    done = anim->keyframe_idx_job->done;
+    BLI_mutex_unlock(&anim->keyframe_idx_job->mutex);
+
+    if (!done) {
+      return NULL;
+    }
+    keyframe_index_job_end(anim);
+  }
+  else if (anim->keyframe_idx_tried) {
+    return NULL;
+  }
+
+  get_keyframe_index_filename(anim, fname);
+
+  anim->keyframe_idx = IMB_indexer_open(fname);
+
+  if (anim->keyframe_idx == NULL && !anim->keyframe_idx_tried && anim->curtype == ANIM_FFMPEG) {
+    /* When another anim of the same movie builds the index, look for it again later. */
+    if (!keyframe_index_job_start(anim, fname)) {
+      return NULL;
+    }
+  }
+
+  anim->keyframe_idx_tried = true;
+
+  return anim->keyframe_idx;
+#else
+  UNUSED_VARS(anim);
+  return NULL;
+#endif
+}
+
 int IMB_anim_index_get_frame_index(struct anim *anim, IMB_Timecode_Type tc, int position)
 {
   struct anim_index *idx = IMB_anim_open_index(anim, tc);
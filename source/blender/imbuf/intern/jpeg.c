@@ -30,6 +30,7 @@
 #include "BLI_utildefines.h"
 #include "BLI_string.h"
 #include "BLI_fileops.h"
+#include "BLI_math_base.h"
 
 #include "BKE_idprop.h"
 
@@ -52,7 +53,11 @@ static void skip_input_data(j_decompress_ptr cinfo, long num_bytes);
 static void term_source(j_decompress_ptr cinfo);
 static void memory_source(j_decompress_ptr cinfo, const unsigned char *buffer, size_t size);
 static boolean handle_app1(j_decompress_ptr cinfo);
-static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int flags);
+static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo,
+                                   int flags,
+                                   int max_size,
+                                   size_t *r_width,
+                                   size_t *r_height);
 
 static const uchar jpeg_default_quality = 75;
 static uchar ibuf_quality;
@@ -258,7 +263,16 @@ static boolean handle_app1(j_decompress_ptr cinfo)
   return true;
 }
 
-static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int flags)
+/**
+ * \param max_size: When non-zero, let the DCT scale the image down by up to 1/8 while the
+ * longest side stays at least this large.
+ * \param r_width, r_height: Optionally return the size of the full resolution image.
+ */
+static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo,
+                                   int flags,
+                                   int max_size,
+                                   size_t *r_width,
+                                   size_t *r_height)
 {
   JSAMPARRAY row_pointer;
   JSAMPLE *buffer = NULL;
@@ -280,12 +294,34 @@ static ImBuf *ibJpegImageFromCinfo(struct jpeg_decompress_struct *cinfo, int fla
     y = cinfo->image_height;
     depth = cinfo->num_components;
 
+    if (r_width) {
+      *r_width = (size_t)x;
+    }
+    if (r_height) {
+      *r_height = (size_t)y;
+    }
+
     if (cinfo->jpeg_color_space == JCS_YCCK) {
       cinfo->out_color_space = JCS_CMYK;
     }
 
+    if (max_size > 0) {
+      const int size = max_ii(x, y);
+      int scale = 8;
+
+      while (scale > 1 && size / scale < max_size) {
+        scale /= 2;
+      }
+      cinfo->scale_num = 1;
+      cinfo->scale_denom = scale;
+    }
+
     jpeg_start_decompress(cinfo);
 
+    /* Differs from the image size when decoding at reduced resolution. */
+    x = cinfo->output_width;
+    y = cinfo->output_height;
+
     if (flags & IB_test) {
       jpeg_abort_decompress(cinfo);
       ibuf = IMB_allocImBuf(x, y, 8 * depth, 0);
@@ -450,7 +486,41 @@ ImBuf *imb_load_jpeg(const unsigned char *buffer,
   jpeg_create_decompress(cinfo);
   memory_source(cinfo, buffer, size);
 
-  ibuf = ibJpegImageFromCinfo(cinfo, flags);
+  ibuf = ibJpegImageFromCinfo(cinfo, flags, 0, NULL, NULL);
+
+  return (ibuf);
+}
+
+ImBuf *imb_thumbnail_jpeg(const unsigned char *buffer,
+                          size_t size,
+                          int flags,
+                          size_t max_thumb_size,
+                          char colorspace[IM_MAX_SPACE],
+                          size_t *r_width,
+                          size_t *r_height)
+{
+  struct jpeg_decompress_struct _cinfo, *cinfo = &_cinfo;
+  struct my_error_mgr jerr;
+  ImBuf *ibuf;
+
+  if (!imb_is_a_jpeg(buffer)) {
+    return NULL;
+  }
+
+  colorspace_set_default_role(colorspace, IM_MAX_SPACE, COLOR_ROLE_DEFAULT_BYTE);
+
+  cinfo->err = jpeg_std_error(&jerr.pub);
+  jerr.pub.error_exit = jpeg_error;
+
+  if (setjmp(jerr.setjmp_buffer)) {
+    jpeg_destroy_decompress(cinfo);
+    return NULL;
+  }
+
+  jpeg_create_decompress(cinfo);
+  memory_source(cinfo, buffer, size);
+
+  ibuf = ibJpegImageFromCinfo(cinfo, flags, (int)max_thumb_size, r_width, r_height);
 
   return (ibuf);
 }
@@ -27,6 +27,10 @@
 #include "IMB_filetype.h"
 #include "IMB_colormanagement_intern.h"
 
+#ifdef WITH_OPENEXR
+#  include "openexr/openexr_api.h"
+#endif
+
 void IMB_init(void)
 {
   imb_refcounter_lock_init();
@@ -36,6 +40,13 @@ void IMB_init(void)
   colormanagement_init();
 }
 
+void IMB_threads_update(void)
+{
+#ifdef WITH_OPENEXR
+  imb_threads_update_openexr();
+#endif
+}
+
 void IMB_exit(void)
 {
   imb_tile_cache_exit();
@@ -645,8 +645,6 @@ typedef struct ExrHandle {
 
   ListBase channels; /* flattened out, ExrChannel */
   ListBase layers;   /* hierarchical, pointing in end to ExrChannel */
-
-  int num_half_channels; /* used during filr save, allows faster temporary buffers allocation */
 } ExrHandle;
 
 /* flattened out channel */
@@ -832,10 +830,6 @@ void IMB_exr_add_channel(void *handle,
   echan->rect = rect;
   echan->use_half_float = use_half_float;
 
-  if (echan->use_half_float) {
-    data->num_half_channels++;
-  }
-
   exr_printf("added channel %s\n", echan->name);
   BLI_addtail(&data->channels, echan);
 }
@@ -934,13 +928,12 @@ void IMB_exrtile_begin_write(
 
   /* assign channels  */
   for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
-    /* Tiles are expected to be saved with full float currently. */
-    BLI_assert(echan->use_half_float == 0);
-
     echan->m->internal_name = echan->m->name;
     echan->m->part_number = echan->view_id;
 
-    headers[echan->view_id].channels().insert(echan->m->internal_name, Channel(Imf::FLOAT));
+    /* Tiles are always passed as full float, OpenEXR converts them when stored as half. */
+    headers[echan->view_id].channels().insert(
+        echan->m->internal_name, Channel(echan->use_half_float ? Imf::HALF : Imf::FLOAT));
     exr_printf("%d %-6s %-22s \"%s\"\n",
                echan->m->part_number,
                echan->m->view.c_str(),
@@ -1103,38 +1096,16 @@ void IMB_exr_write_channels(void *handle)
   ExrChannel *echan;
 
   if (data->channels.first) {
-    const size_t num_pixels = ((size_t)data->width) * data->height;
-    half *rect_half = NULL, *current_rect_half = NULL;
-
-    /* We allocate teporary storage for half pixels for all the channels at once. */
-    if (data->num_half_channels != 0) {
-      rect_half = (half *)MEM_mallocN(sizeof(half) * data->num_half_channels * num_pixels,
-                                      __func__);
-      current_rect_half = rect_half;
-    }
-
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
-      /* Writing starts from last scanline, stride negative. */
-      if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = rect[i * echan->xstride];
-        }
-        half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
-        frameBuffer.insert(
-            echan->name,
-            Slice(Imf::HALF, (char *)rect_to_write, sizeof(half), -data->width * sizeof(half)));
-        current_rect_half += num_pixels;
-      }
-      else {
-        float *rect = echan->rect + echan->xstride * (data->height - 1L) * data->width;
-        frameBuffer.insert(echan->name,
-                           Slice(Imf::FLOAT,
-                                 (char *)rect,
-                                 echan->xstride * sizeof(float),
-                                 -echan->ystride * sizeof(float)));
-      }
+      /* Writing starts from last scanline, stride negative.
+       * Half float channels are passed as float too, OpenEXR converts them to the half
+       * channel type of the file along with compression, using its own thread pool. */
+      float *rect = echan->rect + echan->xstride * (data->height - 1L) * data->width;
+      frameBuffer.insert(echan->name,
+                         Slice(Imf::FLOAT,
+                               (char *)rect,
+                               echan->xstride * sizeof(float),
+                               -echan->ystride * sizeof(float)));
     }
 
     data->ofile->setFrameBuffer(frameBuffer);
@@ -1144,10 +1115,6 @@ void IMB_exr_write_channels(void *handle)
     catch (const std::exception &exc) {
       std::cerr << "OpenEXR-writePixels: ERROR: " << exc.what() << std::endl;
     }
-    /* Free temporary buffers. */
-    if (rect_half != NULL) {
-      MEM_freeN(rect_half);
-    }
   }
   else {
     printf("Error: attempt to save MultiLayer without layers.\n");
@@ -2080,6 +2047,17 @@ void imb_initopenexr(void)
   setGlobalThreadCount(num_threads);
 }
 
+/* Follow the system thread count when it changed after initialization,
+ * e.g. by the `--threads` command line argument. */
+void imb_threads_update_openexr(void)
+{
+  const int num_threads = BLI_system_thread_count();
+
+  if (globalThreadCount() != num_threads) {
+    setGlobalThreadCount(num_threads);
+  }
+}
+
 void imb_exitopenexr(void)
 {
   /* Tells OpenEXR to free thread pool, also ensures there is no running
@@ -32,6 +32,7 @@ extern "C" {
 
 void imb_initopenexr(void);
 void imb_exitopenexr(void);
+void imb_threads_update_openexr(void);
 
 int imb_is_a_openexr(const unsigned char *mem);
 
@@ -22,7 +22,10 @@
  * \ingroup imbuf
  */
 
+#include <string.h>
+
 #include "BLI_utildefines.h"
+#include "BLI_math_base.h"
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
 #include "MEM_guardedalloc.h"
@@ -35,6 +38,10 @@
 
 #include "BLI_sys_types.h"  // for intptr_t support
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 static void imb_half_x_no_alloc(struct ImBuf *ibuf2, struct ImBuf *ibuf1)
 {
   uchar *p1, *_p1, *dest;
@@ -906,645 +913,634 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
-static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+/* ******** separable box / linear scaling ******** */
+
+/* Scaling along one axis is done in parallel, rows for the X axis and blocks of columns for the Y
+ * axis. All color channels of a pixel are processed at once, using SSE2 when available. */
+
+#define SCALE_COLUMN_BLOCK 64
+
+#ifdef __SSE2__
+typedef __m128 scale_v4;
+
+MINLINE scale_v4 scale_v4_set1(const float f)
 {
-  const int do_rect = (ibuf->rect != NULL);
-  const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
+  return _mm_set1_ps(f);
+}
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
+MINLINE scale_v4 scale_v4_add(const scale_v4 a, const scale_v4 b)
+{
+  return _mm_add_ps(a, b);
+}
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+MINLINE scale_v4 scale_v4_sub(const scale_v4 a, const scale_v4 b)
+{
+  return _mm_sub_ps(a, b);
+}
 
-  if (!do_rect && !do_float) {
-    return (ibuf);
-  }
+MINLINE scale_v4 scale_v4_mul(const scale_v4 a, const scale_v4 b)
+{
+  return _mm_mul_ps(a, b);
+}
 
-  if (do_rect) {
-    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(uchar) * 4, "scaledownx");
-    if (_newrect == NULL) {
-      return (ibuf);
-    }
-  }
-  if (do_float) {
-    _newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaledownxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return (ibuf);
-    }
-  }
+MINLINE scale_v4 scale_v4_div(const scale_v4 a, const scale_v4 b)
+{
+  return _mm_div_ps(a, b);
+}
 
-  add = (ibuf->x - 0.01) / newx;
+MINLINE scale_v4 scale_v4_negate(const scale_v4 a)
+{
+  return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+}
 
-  if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
-  }
-  if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
-  }
+MINLINE scale_v4 scale_v4_load_float(const float *p)
+{
+  return _mm_loadu_ps(p);
+}
 
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
+MINLINE void scale_v4_store_float(float *p, const scale_v4 a)
+{
+  _mm_storeu_ps(p, a);
+}
 
-    for (x = newx; x > 0; x--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
+MINLINE scale_v4 scale_v4_load_uchar(const uchar *p)
+{
+  const __m128i zero = _mm_setzero_si128();
+  int packed;
+  __m128i v;
+
+  memcpy(&packed, p, sizeof(packed));
+  v = _mm_cvtsi32_si128(packed);
+  v = _mm_unpacklo_epi8(v, zero);
+  v = _mm_unpacklo_epi16(v, zero);
+  return _mm_cvtepi32_ps(v);
+}
 
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
-        }
-      }
+/* Truncates like a cast, values are expected to be in the [0, 256) range. */
+MINLINE void scale_v4_store_uchar(uchar *p, const scale_v4 a)
+{
+  __m128i v = _mm_cvttps_epi32(a);
+  int packed;
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
-
-        newrect[0] = ((nval[0] + sample * val[0]) / add + 0.5f);
-        newrect[1] = ((nval[1] + sample * val[1]) / add + 0.5f);
-        newrect[2] = ((nval[2] + sample * val[2]) / add + 0.5f);
-        newrect[3] = ((nval[3] + sample * val[3]) / add + 0.5f);
-
-        newrect += 4;
-      }
-      if (do_float) {
+  v = _mm_packs_epi32(v, v);
+  v = _mm_packus_epi16(v, v);
+  packed = _mm_cvtsi128_si32(v);
+  memcpy(p, &packed, sizeof(packed));
+}
+#else
+typedef struct scale_v4 {
+  float v[4];
+} scale_v4;
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
+MINLINE scale_v4 scale_v4_set1(const float f)
+{
+  scale_v4 r = {{f, f, f, f}};
+  return r;
+}
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+MINLINE scale_v4 scale_v4_add(const scale_v4 a, const scale_v4 b)
+{
+  scale_v4 r = {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+  return r;
+}
 
-        newrectf += 4;
-      }
+MINLINE scale_v4 scale_v4_sub(const scale_v4 a, const scale_v4 b)
+{
+  scale_v4 r = {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+  return r;
+}
+
+MINLINE scale_v4 scale_v4_mul(const scale_v4 a, const scale_v4 b)
+{
+  scale_v4 r = {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+  return r;
+}
+
+MINLINE scale_v4 scale_v4_div(const scale_v4 a, const scale_v4 b)
+{
+  scale_v4 r = {{a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3]}};
+  return r;
+}
+
+MINLINE scale_v4 scale_v4_negate(const scale_v4 a)
+{
+  scale_v4 r = {{-a.v[0], -a.v[1], -a.v[2], -a.v[3]}};
+  return r;
+}
+
+MINLINE scale_v4 scale_v4_load_float(const float *p)
+{
+  scale_v4 r = {{p[0], p[1], p[2], p[3]}};
+  return r;
+}
+
+MINLINE void scale_v4_store_float(float *p, const scale_v4 a)
+{
+  p[0] = a.v[0];
+  p[1] = a.v[1];
+  p[2] = a.v[2];
+  p[3] = a.v[3];
+}
+
+MINLINE scale_v4 scale_v4_load_uchar(const uchar *p)
+{
+  scale_v4 r = {{p[0], p[1], p[2], p[3]}};
+  return r;
+}
+
+MINLINE void scale_v4_store_uchar(uchar *p, const scale_v4 a)
+{
+  p[0] = a.v[0];
+  p[1] = a.v[1];
+  p[2] = a.v[2];
+  p[3] = a.v[3];
+}
+#endif /* __SSE2__ */
+
+typedef struct ScaleAxisData {
+  /* Source buffers and size. */
+  const uchar *rect;
+  const float *rectf;
+  int x, y;
+
+  /* Destination buffers, scaled to newlen along the axis. */
+  uchar *newrect;
+  float *newrectf;
+  int newlen;
+
+  /* Source pixels per destination pixel. */
+  float add;
+} ScaleAxisData;
+
+/* Box filter one row, returns the end of the source row. */
+static const uchar *scaledownx_row_uchar(const uchar *rect, uchar *newrect, int newx, float add)
+{
+  const scale_v4 add_v4 = scale_v4_set1(add);
+  const scale_v4 half = scale_v4_set1(0.5f);
+  scale_v4 val = scale_v4_set1(0.0f), nval;
+  float sample = 0.0f;
+
+  for (int x = newx; x > 0; x--) {
+    nval = scale_v4_mul(scale_v4_negate(val), scale_v4_set1(sample));
 
+    sample += add;
+
+    while (sample >= 1.0f) {
       sample -= 1.0f;
+      nval = scale_v4_add(nval, scale_v4_load_uchar(rect));
+      rect += 4;
     }
-  }
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug [#26502] */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug [#26502] */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = _newrectf;
+    val = scale_v4_load_uchar(rect);
+    rect += 4;
+
+    nval = scale_v4_add(nval, scale_v4_mul(scale_v4_set1(sample), val));
+    scale_v4_store_uchar(newrect, scale_v4_add(scale_v4_div(nval, add_v4), half));
+    newrect += 4;
+
+    sample -= 1.0f;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
-  ibuf->x = newx;
-  return (ibuf);
+  return rect;
 }
 
-static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+static const float *scaledownx_row_float(const float *rectf, float *newrectf, int newx, float add)
 {
-  const int do_rect = (ibuf->rect != NULL);
-  const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
+  const scale_v4 add_v4 = scale_v4_set1(add);
+  scale_v4 val = scale_v4_set1(0.0f), nval;
+  float sample = 0.0f;
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
+  for (int x = newx; x > 0; x--) {
+    nval = scale_v4_mul(scale_v4_negate(val), scale_v4_set1(sample));
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+    sample += add;
 
-  if (!do_rect && !do_float) {
-    return (ibuf);
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
+      nval = scale_v4_add(nval, scale_v4_load_float(rectf));
+      rectf += 4;
+    }
+
+    val = scale_v4_load_float(rectf);
+    rectf += 4;
+
+    nval = scale_v4_add(nval, scale_v4_mul(scale_v4_set1(sample), val));
+    scale_v4_store_float(newrectf, scale_v4_div(nval, add_v4));
+    newrectf += 4;
+
+    sample -= 1.0f;
   }
 
-  if (do_rect) {
-    _newrect = MEM_mallocN(newy * ibuf->x * sizeof(uchar) * 4, "scaledowny");
-    if (_newrect == NULL) {
-      return (ibuf);
+  return rectf;
+}
+
+static void scaledownx_thread(void *data_v, int start_line, int num_lines)
+{
+  const ScaleAxisData *data = data_v;
+
+  for (int y = start_line; y < start_line + num_lines; y++) {
+    if (data->rect) {
+      const uchar *rect = data->rect + (size_t)y * data->x * 4;
+      const uchar *rect_end = scaledownx_row_uchar(
+          rect, data->newrect + (size_t)y * data->newlen * 4, data->newlen, data->add);
+      BLI_assert(rect_end - rect == data->x * 4); /* see bug [#26502] */
+      UNUSED_VARS_NDEBUG(rect_end);
     }
-  }
-  if (do_float) {
-    _newrectf = MEM_mallocN(newy * ibuf->x * sizeof(float) * 4, "scaledownyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return (ibuf);
+    if (data->rectf) {
+      const float *rectf = data->rectf + (size_t)y * data->x * 4;
+      const float *rectf_end = scaledownx_row_float(
+          rectf, data->newrectf + (size_t)y * data->newlen * 4, data->newlen, data->add);
+      BLI_assert(rectf_end - rectf == data->x * 4); /* see bug [#26502] */
+      UNUSED_VARS_NDEBUG(rectf_end);
     }
   }
+}
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
+/* Box filter a block of columns, the stride of source and destination rows is skipx. */
+static const uchar *scaledowny_block_uchar(
+    const uchar *rect, uchar *newrect, int tot, size_t skipx, int newy, float add)
+{
+  const scale_v4 add_v4 = scale_v4_set1(add);
+  const scale_v4 half = scale_v4_set1(0.5f);
+  scale_v4 val[SCALE_COLUMN_BLOCK], nval[SCALE_COLUMN_BLOCK];
+  float sample = 0.0f;
+  int i;
 
-  for (x = skipx - 4; x >= 0; x -= 4) {
-    if (do_rect) {
-      rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
-    }
-    if (do_float) {
-      rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
+  for (i = 0; i < tot; i++) {
+    val[i] = scale_v4_set1(0.0f);
+  }
+
+  for (int y = newy; y > 0; y--) {
+    for (i = 0; i < tot; i++) {
+      nval[i] = scale_v4_mul(scale_v4_negate(val[i]), scale_v4_set1(sample));
     }
 
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
+    sample += add;
 
-    for (y = newy; y > 0; y--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
+      for (i = 0; i < tot; i++) {
+        nval[i] = scale_v4_add(nval[i], scale_v4_load_uchar(rect + 4 * i));
       }
+      rect += skipx;
+    }
 
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
-        }
-      }
+    for (i = 0; i < tot; i++) {
+      val[i] = scale_v4_load_uchar(rect + 4 * i);
+      nval[i] = scale_v4_add(nval[i], scale_v4_mul(scale_v4_set1(sample), val[i]));
+      scale_v4_store_uchar(newrect + 4 * i, scale_v4_add(scale_v4_div(nval[i], add_v4), half));
+    }
+    rect += skipx;
+    newrect += skipx;
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
-
-        newrect[0] = ((nval[0] + sample * val[0]) / add + 0.5f);
-        newrect[1] = ((nval[1] + sample * val[1]) / add + 0.5f);
-        newrect[2] = ((nval[2] + sample * val[2]) / add + 0.5f);
-        newrect[3] = ((nval[3] + sample * val[3]) / add + 0.5f);
-
-        newrect += skipx;
-      }
-      if (do_float) {
+    sample -= 1.0f;
+  }
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
+  return rect;
+}
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+static const float *scaledowny_block_float(
+    const float *rectf, float *newrectf, int tot, size_t skipx, int newy, float add)
+{
+  const scale_v4 add_v4 = scale_v4_set1(add);
+  scale_v4 val[SCALE_COLUMN_BLOCK], nval[SCALE_COLUMN_BLOCK];
+  float sample = 0.0f;
+  int i;
 
-        newrectf += skipx;
-      }
+  for (i = 0; i < tot; i++) {
+    val[i] = scale_v4_set1(0.0f);
+  }
 
+  for (int y = newy; y > 0; y--) {
+    for (i = 0; i < tot; i++) {
+      nval[i] = scale_v4_mul(scale_v4_negate(val[i]), scale_v4_set1(sample));
+    }
+
+    sample += add;
+
+    while (sample >= 1.0f) {
       sample -= 1.0f;
+      for (i = 0; i < tot; i++) {
+        nval[i] = scale_v4_add(nval[i], scale_v4_load_float(rectf + 4 * i));
+      }
+      rectf += skipx;
     }
-  }
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug [#26502] */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug [#26502] */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+    for (i = 0; i < tot; i++) {
+      val[i] = scale_v4_load_float(rectf + 4 * i);
+      nval[i] = scale_v4_add(nval[i], scale_v4_mul(scale_v4_set1(sample), val[i]));
+      scale_v4_store_float(newrectf + 4 * i, scale_v4_div(nval[i], add_v4));
+    }
+    rectf += skipx;
+    newrectf += skipx;
+
+    sample -= 1.0f;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
-  ibuf->y = newy;
-  return (ibuf);
+  return rectf;
 }
 
-static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
+static void scaledowny_thread(void *data_v, int start_column, int num_columns)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
-  float sample, add;
-  float val_a, nval_a, diff_a;
-  float val_b, nval_b, diff_b;
-  float val_g, nval_g, diff_g;
-  float val_r, nval_r, diff_r;
-  float val_af, nval_af, diff_af;
-  float val_bf, nval_bf, diff_bf;
-  float val_gf, nval_gf, diff_gf;
-  float val_rf, nval_rf, diff_rf;
-  int x, y;
-  bool do_rect = false, do_float = false;
+  const ScaleAxisData *data = data_v;
+  const size_t skipx = 4 * (size_t)data->x;
+
+  for (int x = start_column; x < start_column + num_columns; x += SCALE_COLUMN_BLOCK) {
+    const int tot = min_ii(SCALE_COLUMN_BLOCK, start_column + num_columns - x);
+
+    if (data->rect) {
+      const uchar *rect = data->rect + 4 * x;
+      const uchar *rect_end = scaledowny_block_uchar(
+          rect, data->newrect + 4 * x, tot, skipx, data->newlen, data->add);
+      BLI_assert(rect_end - rect == skipx * data->y); /* see bug [#26502] */
+      UNUSED_VARS_NDEBUG(rect_end);
+    }
+    if (data->rectf) {
+      const float *rectf = data->rectf + 4 * x;
+      const float *rectf_end = scaledowny_block_float(
+          rectf, data->newrectf + 4 * x, tot, skipx, data->newlen, data->add);
+      BLI_assert(rectf_end - rectf == skipx * data->y); /* see bug [#26502] */
+      UNUSED_VARS_NDEBUG(rectf_end);
+    }
+  }
+}
 
-  val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-  val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-  val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-  val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-  if (ibuf == NULL) {
-    return (NULL);
+/* Linear interpolation of one row. */
+static void scaleupx_row_uchar(const uchar *rect, uchar *newrect, int newx, float add)
+{
+  const scale_v4 half = scale_v4_set1(0.5f);
+  scale_v4 val, nval, diff;
+  float sample = 0.0f;
+
+  val = scale_v4_load_uchar(rect);
+  nval = scale_v4_load_uchar(rect + 4);
+  diff = scale_v4_sub(nval, val);
+  val = scale_v4_add(val, half);
+  rect += 8;
+
+  for (int x = newx; x > 0; x--) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
+
+      val = nval;
+      nval = scale_v4_load_uchar(rect);
+      diff = scale_v4_sub(nval, val);
+      val = scale_v4_add(val, half);
+      rect += 4;
+    }
+    scale_v4_store_uchar(newrect, scale_v4_add(val, scale_v4_mul(scale_v4_set1(sample), diff)));
+    newrect += 4;
+
+    sample += add;
   }
-  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
-    return (ibuf);
+}
+
+static void scaleupx_row_float(const float *rectf, float *newrectf, int newx, float add)
+{
+  scale_v4 val, nval, diff;
+  float sample = 0.0f;
+
+  val = scale_v4_load_float(rectf);
+  nval = scale_v4_load_float(rectf + 4);
+  diff = scale_v4_sub(nval, val);
+  rectf += 8;
+
+  for (int x = newx; x > 0; x--) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
+
+      val = nval;
+      nval = scale_v4_load_float(rectf);
+      diff = scale_v4_sub(nval, val);
+      rectf += 4;
+    }
+    scale_v4_store_float(newrectf, scale_v4_add(val, scale_v4_mul(scale_v4_set1(sample), diff)));
+    newrectf += 4;
+
+    sample += add;
   }
+}
 
-  if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(int), "scaleupx");
-    if (_newrect == NULL) {
-      return (ibuf);
+static void scaleupx_thread(void *data_v, int start_line, int num_lines)
+{
+  const ScaleAxisData *data = data_v;
+
+  for (int y = start_line; y < start_line + num_lines; y++) {
+    if (data->rect) {
+      scaleupx_row_uchar(data->rect + (size_t)y * data->x * 4,
+                         data->newrect + (size_t)y * data->newlen * 4,
+                         data->newlen,
+                         data->add);
+    }
+    if (data->rectf) {
+      scaleupx_row_float(data->rectf + (size_t)y * data->x * 4,
+                         data->newrectf + (size_t)y * data->newlen * 4,
+                         data->newlen,
+                         data->add);
     }
   }
-  if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaleupxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+}
+
+/* Linear interpolation of a block of columns, the stride of source and destination rows is
+ * skipx. */
+static void scaleupy_block_uchar(
+    const uchar *rect, uchar *newrect, int tot, size_t skipx, int newy, float add)
+{
+  const scale_v4 half = scale_v4_set1(0.5f);
+  scale_v4 val[SCALE_COLUMN_BLOCK], nval[SCALE_COLUMN_BLOCK], diff[SCALE_COLUMN_BLOCK];
+  float sample = 0.0f;
+  int i;
+
+  for (i = 0; i < tot; i++) {
+    val[i] = scale_v4_load_uchar(rect + 4 * i);
+    nval[i] = scale_v4_load_uchar(rect + skipx + 4 * i);
+    diff[i] = scale_v4_sub(nval[i], val[i]);
+    val[i] = scale_v4_add(val[i], half);
+  }
+  rect += 2 * skipx;
+
+  for (int y = newy; y > 0; y--) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
+
+      for (i = 0; i < tot; i++) {
+        val[i] = nval[i];
+        nval[i] = scale_v4_load_uchar(rect + 4 * i);
+        diff[i] = scale_v4_sub(nval[i], val[i]);
+        val[i] = scale_v4_add(val[i], half);
       }
-      return (ibuf);
+      rect += skipx;
     }
-  }
+    for (i = 0; i < tot; i++) {
+      scale_v4_store_uchar(newrect + 4 * i,
+                           scale_v4_add(val[i], scale_v4_mul(scale_v4_set1(sample), diff[i])));
+    }
+    newrect += skipx;
 
-  add = (ibuf->x - 1.001) / (newx - 1.0);
+    sample += add;
+  }
+}
 
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
+static void scaleupy_block_float(
+    const float *rectf, float *newrectf, int tot, size_t skipx, int newy, float add)
+{
+  scale_v4 val[SCALE_COLUMN_BLOCK], nval[SCALE_COLUMN_BLOCK], diff[SCALE_COLUMN_BLOCK];
+  float sample = 0.0f;
+  int i;
 
-  for (y = ibuf->y; y > 0; y--) {
+  for (i = 0; i < tot; i++) {
+    val[i] = scale_v4_load_float(rectf + 4 * i);
+    nval[i] = scale_v4_load_float(rectf + skipx + 4 * i);
+    diff[i] = scale_v4_sub(nval[i], val[i]);
+  }
+  rectf += 2 * skipx;
 
-    sample = 0;
+  for (int y = newy; y > 0; y--) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
 
-    if (do_rect) {
-      val_a = rect[0];
-      nval_a = rect[4];
-      diff_a = nval_a - val_a;
-      val_a += 0.5f;
-
-      val_b = rect[1];
-      nval_b = rect[5];
-      diff_b = nval_b - val_b;
-      val_b += 0.5f;
-
-      val_g = rect[2];
-      nval_g = rect[6];
-      diff_g = nval_g - val_g;
-      val_g += 0.5f;
-
-      val_r = rect[3];
-      nval_r = rect[7];
-      diff_r = nval_r - val_r;
-      val_r += 0.5f;
-
-      rect += 8;
+      for (i = 0; i < tot; i++) {
+        val[i] = nval[i];
+        nval[i] = scale_v4_load_float(rectf + 4 * i);
+        diff[i] = scale_v4_sub(nval[i], val[i]);
+      }
+      rectf += skipx;
     }
-    if (do_float) {
-      val_af = rectf[0];
-      nval_af = rectf[4];
-      diff_af = nval_af - val_af;
+    for (i = 0; i < tot; i++) {
+      scale_v4_store_float(newrectf + 4 * i,
+                           scale_v4_add(val[i], scale_v4_mul(scale_v4_set1(sample), diff[i])));
+    }
+    newrectf += skipx;
 
-      val_bf = rectf[1];
-      nval_bf = rectf[5];
-      diff_bf = nval_bf - val_bf;
+    sample += add;
+  }
+}
 
-      val_gf = rectf[2];
-      nval_gf = rectf[6];
-      diff_gf = nval_gf - val_gf;
+static void scaleupy_thread(void *data_v, int start_column, int num_columns)
+{
+  const ScaleAxisData *data = data_v;
+  const size_t skipx = 4 * (size_t)data->x;
 
-      val_rf = rectf[3];
-      nval_rf = rectf[7];
-      diff_rf = nval_rf - val_rf;
+  for (int x = start_column; x < start_column + num_columns; x += SCALE_COLUMN_BLOCK) {
+    const int tot = min_ii(SCALE_COLUMN_BLOCK, start_column + num_columns - x);
 
-      rectf += 8;
+    if (data->rect) {
+      scaleupy_block_uchar(
+          data->rect + 4 * x, data->newrect + 4 * x, tot, skipx, data->newlen, data->add);
     }
-    for (x = newx; x > 0; x--) {
-      if (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          val_a = nval_a;
-          nval_a = rect[0];
-          diff_a = nval_a - val_a;
-          val_a += 0.5f;
-
-          val_b = nval_b;
-          nval_b = rect[1];
-          diff_b = nval_b - val_b;
-          val_b += 0.5f;
-
-          val_g = nval_g;
-          nval_g = rect[2];
-          diff_g = nval_g - val_g;
-          val_g += 0.5f;
-
-          val_r = nval_r;
-          nval_r = rect[3];
-          diff_r = nval_r - val_r;
-          val_r += 0.5f;
-          rect += 4;
-        }
-        if (do_float) {
-          val_af = nval_af;
-          nval_af = rectf[0];
-          diff_af = nval_af - val_af;
-
-          val_bf = nval_bf;
-          nval_bf = rectf[1];
-          diff_bf = nval_bf - val_bf;
-
-          val_gf = nval_gf;
-          nval_gf = rectf[2];
-          diff_gf = nval_gf - val_gf;
-
-          val_rf = nval_rf;
-          nval_rf = rectf[3];
-          diff_rf = nval_rf - val_rf;
-          rectf += 4;
-        }
-      }
-      if (do_rect) {
-        newrect[0] = val_a + sample * diff_a;
-        newrect[1] = val_b + sample * diff_b;
-        newrect[2] = val_g + sample * diff_g;
-        newrect[3] = val_r + sample * diff_r;
-        newrect += 4;
-      }
-      if (do_float) {
-        newrectf[0] = val_af + sample * diff_af;
-        newrectf[1] = val_bf + sample * diff_bf;
-        newrectf[2] = val_gf + sample * diff_gf;
-        newrectf[3] = val_rf + sample * diff_rf;
-        newrectf += 4;
+    if (data->rectf) {
+      scaleupy_block_float(
+          data->rectf + 4 * x, data->newrectf + 4 * x, tot, skipx, data->newlen, data->add);
+    }
+  }
+}
+
+/* Allocate the destination buffers of a scaling pass, returns false on failure. */
+static bool scale_axis_data_init(ScaleAxisData *data, ImBuf *ibuf, int newx, int newy)
+{
+  memset(data, 0, sizeof(*data));
+
+  data->rect = (const uchar *)ibuf->rect;
+  data->rectf = ibuf->rect_float;
+  data->x = ibuf->x;
+  data->y = ibuf->y;
+
+  if (data->rect) {
+    data->newrect = MEM_mallocN((size_t)newx * newy * sizeof(uchar) * 4, "scale axis");
+    if (data->newrect == NULL) {
+      return false;
+    }
+  }
+  if (data->rectf) {
+    data->newrectf = MEM_mallocN((size_t)newx * newy * sizeof(float) * 4, "scale axis f");
+    if (data->newrectf == NULL) {
+      if (data->newrect) {
+        MEM_freeN(data->newrect);
       }
-      sample += add;
+      return false;
     }
   }
+  return true;
+}
 
-  if (do_rect) {
+static void scale_axis_data_apply(ScaleAxisData *data, ImBuf *ibuf, int newx, int newy)
+{
+  if (data->newrect) {
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
+    ibuf->rect = (unsigned int *)data->newrect;
   }
-  if (do_float) {
+  if (data->newrectf) {
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+    ibuf->rect_float = data->newrectf;
   }
 
   ibuf->x = newx;
-  return (ibuf);
+  ibuf->y = newy;
 }
 
-static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
+static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
-  float sample, add;
-  float val_a, nval_a, diff_a;
-  float val_b, nval_b, diff_b;
-  float val_g, nval_g, diff_g;
-  float val_r, nval_r, diff_r;
-  float val_af, nval_af, diff_af;
-  float val_bf, nval_bf, diff_bf;
-  float val_gf, nval_gf, diff_gf;
-  float val_rf, nval_rf, diff_rf;
-  int x, y, skipx;
-  bool do_rect = false, do_float = false;
-
-  val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-  val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-  val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-  val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-  if (ibuf == NULL) {
-    return (NULL);
-  }
-  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
+  ScaleAxisData data;
+
+  if (!scale_axis_data_init(&data, ibuf, newx, ibuf->y)) {
     return (ibuf);
   }
+  data.newlen = newx;
+  data.add = (ibuf->x - 0.01) / newx;
 
-  if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(ibuf->x * newy * sizeof(int), "scaleupy");
-    if (_newrect == NULL) {
-      return (ibuf);
-    }
-  }
-  if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(ibuf->x * newy * sizeof(float) * 4, "scaleupyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return (ibuf);
-    }
-  }
+  IMB_processor_apply_threaded_scanlines(ibuf->y, scaledownx_thread, &data);
 
-  add = (ibuf->y - 1.001) / (newy - 1.0);
-  skipx = 4 * ibuf->x;
+  scale_axis_data_apply(&data, ibuf, newx, ibuf->y);
+  return (ibuf);
+}
 
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
+static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+{
+  ScaleAxisData data;
 
-  for (x = ibuf->x; x > 0; x--) {
+  if (!scale_axis_data_init(&data, ibuf, ibuf->x, newy)) {
+    return (ibuf);
+  }
+  data.newlen = newy;
+  data.add = (ibuf->y - 0.01) / newy;
 
-    sample = 0;
-    if (do_rect) {
-      rect = ((uchar *)ibuf->rect) + 4 * (x - 1);
-      newrect = _newrect + 4 * (x - 1);
-
-      val_a = rect[0];
-      nval_a = rect[skipx];
-      diff_a = nval_a - val_a;
-      val_a += 0.5f;
-
-      val_b = rect[1];
-      nval_b = rect[skipx + 1];
-      diff_b = nval_b - val_b;
-      val_b += 0.5f;
-
-      val_g = rect[2];
-      nval_g = rect[skipx + 2];
-      diff_g = nval_g - val_g;
-      val_g += 0.5f;
-
-      val_r = rect[3];
-      nval_r = rect[skipx + 3];
-      diff_r = nval_r - val_r;
-      val_r += 0.5f;
-
-      rect += 2 * skipx;
-    }
-    if (do_float) {
-      rectf = ibuf->rect_float + 4 * (x - 1);
-      newrectf = _newrectf + 4 * (x - 1);
+  IMB_processor_apply_threaded_scanlines(ibuf->x, scaledowny_thread, &data);
 
-      val_af = rectf[0];
-      nval_af = rectf[skipx];
-      diff_af = nval_af - val_af;
+  scale_axis_data_apply(&data, ibuf, ibuf->x, newy);
+  return (ibuf);
+}
 
-      val_bf = rectf[1];
-      nval_bf = rectf[skipx + 1];
-      diff_bf = nval_bf - val_bf;
+static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
+{
+  ScaleAxisData data;
 
-      val_gf = rectf[2];
-      nval_gf = rectf[skipx + 2];
-      diff_gf = nval_gf - val_gf;
+  if (!scale_axis_data_init(&data, ibuf, newx, ibuf->y)) {
+    return (ibuf);
+  }
+  data.newlen = newx;
+  data.add = (ibuf->x - 1.001) / (newx - 1.0);
 
-      val_rf = rectf[3];
-      nval_rf = rectf[skipx + 3];
-      diff_rf = nval_rf - val_rf;
+  IMB_processor_apply_threaded_scanlines(ibuf->y, scaleupx_thread, &data);
 
-      rectf += 2 * skipx;
-    }
+  scale_axis_data_apply(&data, ibuf, newx, ibuf->y);
+  return (ibuf);
+}
 
-    for (y = newy; y > 0; y--) {
-      if (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          val_a = nval_a;
-          nval_a = rect[0];
-          diff_a = nval_a - val_a;
-          val_a += 0.5f;
-
-          val_b = nval_b;
-          nval_b = rect[1];
-          diff_b = nval_b - val_b;
-          val_b += 0.5f;
-
-          val_g = nval_g;
-          nval_g = rect[2];
-          diff_g = nval_g - val_g;
-          val_g += 0.5f;
-
-          val_r = nval_r;
-          nval_r = rect[3];
-          diff_r = nval_r - val_r;
-          val_r += 0.5f;
-          rect += skipx;
-        }
-        if (do_float) {
-          val_af = nval_af;
-          nval_af = rectf[0];
-          diff_af = nval_af - val_af;
-
-          val_bf = nval_bf;
-          nval_bf = rectf[1];
-          diff_bf = nval_bf - val_bf;
-
-          val_gf = nval_gf;
-          nval_gf = rectf[2];
-          diff_gf = nval_gf - val_gf;
-
-          val_rf = nval_rf;
-          nval_rf = rectf[3];
-          diff_rf = nval_rf - val_rf;
-          rectf += skipx;
-        }
-      }
-      if (do_rect) {
-        newrect[0] = val_a + sample * diff_a;
-        newrect[1] = val_b + sample * diff_b;
-        newrect[2] = val_g + sample * diff_g;
-        newrect[3] = val_r + sample * diff_r;
-        newrect += skipx;
-      }
-      if (do_float) {
-        newrectf[0] = val_af + sample * diff_af;
-        newrectf[1] = val_bf + sample * diff_bf;
-        newrectf[2] = val_gf + sample * diff_gf;
-        newrectf[3] = val_rf + sample * diff_rf;
-        newrectf += skipx;
-      }
-      sample += add;
-    }
-  }
+static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
+{
+  ScaleAxisData data;
 
-  if (do_rect) {
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+  if (!scale_axis_data_init(&data, ibuf, ibuf->x, newy)) {
+    return (ibuf);
   }
+  data.newlen = newy;
+  data.add = (ibuf->y - 1.001) / (newy - 1.0);
 
-  ibuf->y = newy;
+  IMB_processor_apply_threaded_scanlines(ibuf->x, scaleupy_thread, &data);
+
+  scale_axis_data_apply(&data, ibuf, ibuf->x, newy);
   return (ibuf);
 }
 
@@ -1659,34 +1655,61 @@ struct imbufRGBA {
   float r, g, b, a;
 };
 
+typedef struct ScaleFastData {
+  const unsigned int *rect;
+  const struct imbufRGBA *rectf;
+  int x;
+
+  unsigned int *newrect;
+  struct imbufRGBA *newrectf;
+  int newx;
+
+  /* 16.16 fixed point steps in the source buffer. */
+  size_t stepx, stepy;
+} ScaleFastData;
+
+static void scalefast_thread(void *data_v, int start_line, int num_lines)
+{
+  const ScaleFastData *data = data_v;
+
+  for (int y = start_line; y < start_line + num_lines; y++) {
+    const size_t ofsy = 32768 + y * data->stepy;
+    size_t ofsx;
+    int x;
+
+    if (data->rect) {
+      const unsigned int *rect = data->rect + (ofsy >> 16) * data->x;
+      unsigned int *newrect = data->newrect + (size_t)y * data->newx;
+      ofsx = 32768;
+
+      for (x = data->newx; x > 0; x--, ofsx += data->stepx) {
+        *newrect++ = rect[ofsx >> 16];
+      }
+    }
+
+    if (data->rectf) {
+      const struct imbufRGBA *rectf = data->rectf + (ofsy >> 16) * data->x;
+      struct imbufRGBA *newrectf = data->newrectf + (size_t)y * data->newx;
+      ofsx = 32768;
+
+      for (x = data->newx; x > 0; x--, ofsx += data->stepx) {
+        *newrectf++ = rectf[ofsx >> 16];
+      }
+    }
+  }
+}
+
 /**
  * Return true if \a ibuf is modified.
  */
 bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy)
 {
-  unsigned int *rect, *_newrect, *newrect;
-  struct imbufRGBA *rectf, *_newrectf, *newrectf;
-  int x, y;
-  bool do_float = false, do_rect = false;
-  size_t ofsx, ofsy, stepx, stepy;
-
-  rect = NULL;
-  _newrect = NULL;
-  newrect = NULL;
-  rectf = NULL;
-  _newrectf = NULL;
-  newrectf = NULL;
+  ScaleFastData data = {NULL};
 
   if (ibuf == NULL) {
     return false;
   }
-  if (ibuf->rect) {
-    do_rect = true;
-  }
-  if (ibuf->rect_float) {
-    do_float = true;
-  }
-  if (do_rect == false && do_float == false) {
+  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
     return false;
   }
 
@@ -1694,61 +1717,42 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
     return false;
   }
 
-  if (do_rect) {
-    _newrect = MEM_mallocN(newx * newy * sizeof(int), "scalefastimbuf");
-    if (_newrect == NULL) {
+  if (ibuf->rect) {
+    data.rect = ibuf->rect;
+    data.newrect = MEM_mallocN(newx * newy * sizeof(int), "scalefastimbuf");
+    if (data.newrect == NULL) {
       return false;
     }
-    newrect = _newrect;
   }
 
-  if (do_float) {
-    _newrectf = MEM_mallocN(newx * newy * sizeof(float) * 4, "scalefastimbuf f");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+  if (ibuf->rect_float) {
+    data.rectf = (struct imbufRGBA *)ibuf->rect_float;
+    data.newrectf = MEM_mallocN(newx * newy * sizeof(float) * 4, "scalefastimbuf f");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
       }
       return false;
     }
-    newrectf = _newrectf;
   }
 
-  stepx = (65536.0 * (ibuf->x - 1.0) / (newx - 1.0)) + 0.5;
-  stepy = (65536.0 * (ibuf->y - 1.0) / (newy - 1.0)) + 0.5;
-  ofsy = 32768;
-
-  for (y = newy; y > 0; y--, ofsy += stepy) {
-    if (do_rect) {
-      rect = ibuf->rect;
-      rect += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrect++ = rect[ofsx >> 16];
-      }
-    }
+  data.x = ibuf->x;
+  data.newx = newx;
+  data.stepx = (65536.0 * (ibuf->x - 1.0) / (newx - 1.0)) + 0.5;
+  data.stepy = (65536.0 * (ibuf->y - 1.0) / (newy - 1.0)) + 0.5;
 
-    if (do_float) {
-      rectf = (struct imbufRGBA *)ibuf->rect_float;
-      rectf += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrectf++ = rectf[ofsx >> 16];
-      }
-    }
-  }
+  IMB_processor_apply_threaded_scanlines(newy, scalefast_thread, &data);
 
-  if (do_rect) {
+  if (data.newrect) {
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
-    ibuf->rect = _newrect;
+    ibuf->rect = data.newrect;
   }
 
-  if (do_float) {
+  if (data.newrectf) {
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+    ibuf->rect_float = (float *)data.newrectf;
   }
 
   scalefast_Z_ImBuf(ibuf, newx, newy);
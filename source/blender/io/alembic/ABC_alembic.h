@@ -129,6 +129,15 @@ bool ABC_mesh_topology_changed(struct CacheReader *reader,
                                const float time,
                                const char **err_str);
 
+/* Reads the bounds of the cached geometry, without reading the geometry itself.
+ * Returns false when the archive doesn't store bounds for the object. */
+bool ABC_read_bounds(struct CacheReader *reader,
+                     struct Object *ob,
+                     const float time,
+                     float r_min[3],
+                     float r_max[3],
+                     const char **err_str);
+
 void CacheReader_incref(struct CacheReader *reader);
 void CacheReader_free(struct CacheReader *reader);
 
@@ -45,6 +45,7 @@ extern "C" {
 #include "DNA_fluid_types.h"
 
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #ifdef WIN32
 /* needed for MSCV because of snprintf from BLI_string */
@@ -340,6 +341,8 @@ void AbcExporter::operator()(short *do_update, float *progress, bool *was_cancel
     setCurrentFrame(m_bmain, frame);
 
     if (shape_frames.count(frame) != 0) {
+      prepareShapes();
+
       for (int i = 0, e = m_shapes.size(); i != e; i++) {
         m_shapes[i]->write();
       }
@@ -366,6 +369,34 @@ void AbcExporter::operator()(short *do_update, float *progress, bool *was_cancel
   }
 }
 
+static void prepare_shape_writer_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  std::vector<AbcObjectWriter *> &writers = *static_cast<std::vector<AbcObjectWriter *> *>(
+      userdata);
+  writers[i]->prepare();
+}
+
+/* Convert the data of all shapes for the current frame in parallel,
+ * only writing it to the archive remains serial. */
+void AbcExporter::prepareShapes()
+{
+  std::vector<AbcObjectWriter *> writers;
+
+  for (int i = 0, e = m_shapes.size(); i != e; i++) {
+    if (m_shapes[i]->prepare_begin()) {
+      writers.push_back(m_shapes[i]);
+    }
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  settings.use_threading = (writers.size() > 1);
+  BLI_task_parallel_range(0, writers.size(), &writers, prepare_shape_writer_cb, &settings);
+}
+
 void AbcExporter::createTransformWritersHierarchy()
 {
   for (Base *base = static_cast<Base *>(m_settings.view_layer->object_bases.first); base;
@@ -108,6 +108,7 @@ class AbcExporter {
                          bool time_relative,
                          std::vector<double> &samples);
   void getFrameSet(unsigned int nr_of_samples, std::set<double> &frames);
+  void prepareShapes();
 
  private:
   Alembic::Abc::TimeSamplingPtr createTimeSampling(double step);
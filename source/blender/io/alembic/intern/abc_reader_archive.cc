@@ -28,6 +28,8 @@ extern "C" {
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
 }
 
 #ifdef WIN32
@@ -39,7 +41,15 @@ extern "C" {
 using Alembic::Abc::ErrorHandler;
 using Alembic::Abc::Exception;
 using Alembic::Abc::IArchive;
+using Alembic::Abc::index_t;
+using Alembic::Abc::IP3fArrayProperty;
+using Alembic::Abc::ISampleSelector;
 using Alembic::Abc::kWrapExisting;
+using Alembic::Abc::P3fArraySamplePtr;
+
+/* Limits of the read-ahead cache of each archive. */
+#define SAMPLE_CACHE_MAX_BYTES (256 * 1024 * 1024)
+#define SAMPLE_CACHE_MAX_SAMPLES 1024
 
 static IArchive open_archive(const std::string &filename,
                              const std::vector<std::istream *> &input_streams,
@@ -99,6 +109,7 @@ static IArchive open_archive(const std::string &filename,
 }
 
 ArchiveReader::ArchiveReader(struct Main *bmain, const char *filename)
+    : m_sample_cache_bytes(0), m_prefetch_pool(NULL)
 {
   char abs_filename[FILE_MAX];
   BLI_strncpy(abs_filename, filename, FILE_MAX);
@@ -108,20 +119,42 @@ ArchiveReader::ArchiveReader(struct Main *bmain, const char *filename)
   UTF16_ENCODE(abs_filename);
   std::wstring wstr(abs_filename_16);
   m_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
+  m_prefetch_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
   UTF16_UN_ENCODE(abs_filename);
 #else
   m_infile.open(abs_filename, std::ios::in | std::ios::binary);
+  m_prefetch_infile.open(abs_filename, std::ios::in | std::ios::binary);
 #endif
 
   m_streams.push_back(&m_infile);
+  if (m_prefetch_infile.is_open()) {
+    m_streams.push_back(&m_prefetch_infile);
+  }
 
   m_archive = open_archive(abs_filename, m_streams, m_is_hdf5);
 
   /* We can't open an HDF5 file from a stream, so close it. */
   if (m_is_hdf5) {
     m_infile.close();
+    m_prefetch_infile.close();
     m_streams.clear();
   }
+
+  BLI_mutex_init(&m_sample_cache_mutex);
+
+  /* Only Ogawa archives with a stream to spare can be read while evaluation reads too. */
+  if (m_archive.valid() && !m_is_hdf5 && m_streams.size() > 1) {
+    m_prefetch_pool = BLI_task_pool_create_background(BLI_task_scheduler_get(), this);
+  }
+}
+
+ArchiveReader::~ArchiveReader()
+{
+  /* Wait for reads in progress before the archive and its streams go away. */
+  if (m_prefetch_pool) {
+    BLI_task_pool_free(m_prefetch_pool);
+  }
+  BLI_mutex_end(&m_sample_cache_mutex);
 }
 
 bool ArchiveReader::is_hdf5() const
@@ -138,3 +171,123 @@ Alembic::Abc::IObject ArchiveReader::getTop()
 {
   return m_archive.getTop();
 }
+
+bool ArchiveReader::cached_positions(const std::string &object_path,
+                                     index_t index,
+                                     P3fArraySamplePtr &r_positions)
+{
+  if (m_prefetch_pool == NULL) {
+    return false;
+  }
+
+  BLI_mutex_lock(&m_sample_cache_mutex);
+  std::map<SampleKey, P3fArraySamplePtr>::const_iterator it = m_sample_cache.find(
+      SampleKey(object_path, index));
+  const bool found = (it != m_sample_cache.end() && it->second);
+  if (found) {
+    r_positions = it->second;
+  }
+  BLI_mutex_unlock(&m_sample_cache_mutex);
+
+  return found;
+}
+
+struct PrefetchTask {
+  std::pair<std::string, index_t> key;
+  IP3fArrayProperty property;
+};
+
+void ArchiveReader::prefetch_positions(const std::string &object_path,
+                                       const IP3fArrayProperty &property,
+                                       index_t index)
+{
+  if (m_prefetch_pool == NULL) {
+    return;
+  }
+
+  SampleKey key(object_path, index);
+
+  BLI_mutex_lock(&m_sample_cache_mutex);
+  if (m_sample_cache.find(key) != m_sample_cache.end()) {
+    /* Already read or being read. */
+    BLI_mutex_unlock(&m_sample_cache_mutex);
+    return;
+  }
+  m_sample_cache[key] = P3fArraySamplePtr();
+  m_sample_cache_order.push_back(key);
+  sample_cache_evict();
+  BLI_mutex_unlock(&m_sample_cache_mutex);
+
+  PrefetchTask *task = new PrefetchTask;
+  task->key = key;
+  task->property = property;
+
+  BLI_task_pool_push_ex(
+      m_prefetch_pool, prefetch_task_run, task, true, prefetch_task_free, TASK_PRIORITY_LOW);
+}
+
+void ArchiveReader::prefetch_task_run(TaskPool *__restrict pool,
+                                      void *taskdata,
+                                      int UNUSED(threadid))
+{
+  ArchiveReader *archive = static_cast<ArchiveReader *>(BLI_task_pool_userdata(pool));
+  PrefetchTask *task = static_cast<PrefetchTask *>(taskdata);
+
+  P3fArraySamplePtr positions;
+  try {
+    task->property.get(positions, ISampleSelector(task->key.second));
+  }
+  catch (const Exception &) {
+    /* Errors are reported when evaluation reads the sample itself. */
+    positions.reset();
+  }
+
+  archive->sample_cache_store(task->key, positions);
+}
+
+void ArchiveReader::prefetch_task_free(TaskPool *__restrict UNUSED(pool),
+                                       void *taskdata,
+                                       int UNUSED(threadid))
+{
+  delete static_cast<PrefetchTask *>(taskdata);
+}
+
+void ArchiveReader::sample_cache_store(const SampleKey &key, const P3fArraySamplePtr &positions)
+{
+  BLI_mutex_lock(&m_sample_cache_mutex);
+
+  std::map<SampleKey, P3fArraySamplePtr>::iterator it = m_sample_cache.find(key);
+  if (it != m_sample_cache.end() && !it->second) {
+    if (positions) {
+      it->second = positions;
+      m_sample_cache_bytes += positions->size() * sizeof(Imath::V3f);
+      sample_cache_evict();
+    }
+    else {
+      /* Forget about failed reads, so they can be requested again. */
+      m_sample_cache.erase(it);
+    }
+  }
+  /* Otherwise the entry was evicted while it was being read, drop the result. */
+
+  BLI_mutex_unlock(&m_sample_cache_mutex);
+}
+
+/* Must be called with the sample cache mutex locked. */
+void ArchiveReader::sample_cache_evict()
+{
+  while (!m_sample_cache_order.empty() && (m_sample_cache_bytes > SAMPLE_CACHE_MAX_BYTES ||
+                                           m_sample_cache.size() > SAMPLE_CACHE_MAX_SAMPLES)) {
+    std::map<SampleKey, P3fArraySamplePtr>::iterator it = m_sample_cache.find(
+        m_sample_cache_order.front());
+    m_sample_cache_order.pop_front();
+
+    if (it == m_sample_cache.end()) {
+      continue;
+    }
+    if (it->second) {
+      m_sample_cache_bytes -= it->second->size() * sizeof(Imath::V3f);
+    }
+    m_sample_cache.erase(it);
+  }
+}
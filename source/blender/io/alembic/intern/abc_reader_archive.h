@@ -32,10 +32,17 @@
 
 #include <Alembic/AbcCoreOgawa/All.h>
 
+#include <deque>
 #include <fstream>
+#include <map>
+
+extern "C" {
+#include "BLI_threads.h"
+}
 
 struct Main;
 struct Scene;
+struct TaskPool;
 
 /* Wrappers around input and output archives. The goal is to be able to use
  * streams so that unicode paths work on Windows (T49112), and to make sure that
@@ -45,11 +52,27 @@ struct Scene;
 class ArchiveReader {
   Alembic::Abc::IArchive m_archive;
   std::ifstream m_infile;
+  /* Second stream on the same file, so that reading ahead doesn't block the reads done
+   * during evaluation. */
+  std::ifstream m_prefetch_infile;
   std::vector<std::istream *> m_streams;
   bool m_is_hdf5;
 
+  /* Position samples read ahead of playback, shared by all cache readers of this archive.
+   * An empty sample pointer marks a read that is still in progress. Entries are evicted in
+   * the order they were requested once the cache grows beyond its limits. */
+  typedef std::pair<std::string, Alembic::Abc::index_t> SampleKey;
+  std::map<SampleKey, Alembic::Abc::P3fArraySamplePtr> m_sample_cache;
+  std::deque<SampleKey> m_sample_cache_order;
+  size_t m_sample_cache_bytes;
+  ThreadMutex m_sample_cache_mutex;
+
+  /* NULL when the archive can't be read from multiple threads. */
+  TaskPool *m_prefetch_pool;
+
  public:
   ArchiveReader(struct Main *bmain, const char *filename);
+  ~ArchiveReader();
 
   bool valid() const;
 
@@ -62,6 +85,31 @@ class ArchiveReader {
   bool is_hdf5() const;
 
   Alembic::Abc::IObject getTop();
+
+  /**
+   * Get the positions of the given sample if they were read ahead.
+   * Returns false when they are not available (yet), in which case the caller should read the
+   * sample itself.
+   */
+  bool cached_positions(const std::string &object_path,
+                        Alembic::Abc::index_t index,
+                        Alembic::Abc::P3fArraySamplePtr &r_positions);
+
+  /**
+   * Read the given positions sample in the background, so that it is available from
+   * cached_positions() by the time playback reaches it.
+   */
+  void prefetch_positions(const std::string &object_path,
+                          const Alembic::Abc::IP3fArrayProperty &property,
+                          Alembic::Abc::index_t index);
+
+ private:
+  void sample_cache_store(const SampleKey &key,
+                          const Alembic::Abc::P3fArraySamplePtr &positions);
+  void sample_cache_evict();
+
+  static void prefetch_task_run(TaskPool *__restrict pool, void *taskdata, int threadid);
+  static void prefetch_task_free(TaskPool *__restrict pool, void *taskdata, int threadid);
 };
 
 #endif /* __ABC_READER_ARCHIVE_H__ */
@@ -19,6 +19,7 @@
  */
 
 #include "abc_reader_mesh.h"
+#include "abc_reader_archive.h"
 #include "abc_reader_transform.h"
 #include "abc_util.h"
 
@@ -62,6 +63,9 @@ using Alembic::AbcGeom::V2fArraySamplePtr;
 
 /* NOTE: Alembic's polygon winding order is clockwise, to match with Renderman. */
 
+/* Number of position samples to read ahead of the current one while streaming. */
+#define PREFETCH_SAMPLES 2
+
 /* Some helpers for mesh generation */
 namespace utils {
 
@@ -202,10 +206,16 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   unsigned int rev_loop_index = 0;
   unsigned int uv_index = 0;
 
+  /* When streaming a deforming mesh, the mesh usually has this topology already. */
+  bool topology_changed = (config.mesh->totedge == 0);
+
   for (int i = 0; i < face_counts->size(); i++) {
     const int face_size = (*face_counts)[i];
 
     MPoly &poly = mpolys[i];
+    if (poly.loopstart != (int)loop_index || poly.totloop != face_size) {
+      topology_changed = true;
+    }
     poly.loopstart = loop_index;
     poly.totloop = face_size;
 
@@ -218,7 +228,11 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
 
     for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
       MLoop &loop = mloops[rev_loop_index];
-      loop.v = (*face_indices)[loop_index];
+      const unsigned int vert_index = (*face_indices)[loop_index];
+      if (loop.v != vert_index) {
+        loop.v = vert_index;
+        topology_changed = true;
+      }
 
       if (do_uvs) {
         MLoopUV &loopuv = mloopuvs[rev_loop_index];
@@ -236,7 +250,11 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
     }
   }
 
-  BKE_mesh_calc_edges(config.mesh, false, false);
+  /* Rebuilding edges is the most expensive part of reading polygons. The edges of a mesh that
+   * already had this topology are still valid. */
+  if (topology_changed) {
+    BKE_mesh_calc_edges(config.mesh, false, false);
+  }
 }
 
 static void process_no_normals(CDStreamConfig &config)
@@ -392,27 +410,15 @@ static void get_weight_and_index(CDStreamConfig &config,
   config.ceil_index = i1;
 }
 
+/* The topology and positions in abc_mesh_data are read by the caller, see
+ * AbcMeshReader::read_sample_data(). */
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
                              const ISampleSelector &selector,
-                             CDStreamConfig &config)
+                             CDStreamConfig &config,
+                             AbcMeshData &abc_mesh_data)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
-  AbcMeshData abc_mesh_data;
-  abc_mesh_data.face_counts = sample.getFaceCounts();
-  abc_mesh_data.face_indices = sample.getFaceIndices();
-  abc_mesh_data.positions = sample.getPositions();
-
-  get_weight_and_index(config, schema.getTimeSampling(), schema.getNumSamples());
-
-  if (config.weight != 0.0f) {
-    Alembic::AbcGeom::IPolyMeshSchema::Sample ceil_sample;
-    schema.get(ceil_sample, Alembic::Abc::ISampleSelector(config.ceil_index));
-    abc_mesh_data.ceil_positions = ceil_sample.getPositions();
-  }
-
   if ((settings->read_flag & MOD_MESHSEQ_READ_UV) != 0) {
     read_uvs_params(config, abc_mesh_data, schema.getUVsParam(), selector);
   }
@@ -431,6 +437,31 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   }
 }
 
+template<typename Schema>
+static bool read_self_bounds(const std::string &iobject_full_name,
+                             Schema &schema,
+                             const ISampleSelector &sample_sel,
+                             Imath::Box3d &r_bounds)
+{
+  Alembic::Abc::IBox3dProperty bounds_prop = schema.getSelfBoundsProperty();
+  if (!bounds_prop.valid()) {
+    return false;
+  }
+
+  try {
+    r_bounds = bounds_prop.getValue(sample_sel);
+  }
+  catch (Alembic::Util::Exception &ex) {
+    printf("Alembic: error reading bounds for '%s' at time %f: %s\n",
+           iobject_full_name.c_str(),
+           sample_sel.getRequestedTime(),
+           ex.what());
+    return false;
+  }
+
+  return !r_bounds.isEmpty();
+}
+
 CDStreamConfig get_config(Mesh *mesh)
 {
   CDStreamConfig config;
@@ -458,6 +489,8 @@ AbcMeshReader::AbcMeshReader(const IObject &object, ImportSettings &settings)
 
   IPolyMesh ipoly_mesh(m_iobject, kWrapExisting);
   m_schema = ipoly_mesh.getSchema();
+  m_is_homogeneous = m_schema.valid() &&
+                     m_schema.getTopologyVariance() != Alembic::AbcGeom::kHeterogenousTopology;
 
   get_min_max_time(m_iobject, m_schema, m_min_time, m_max_time);
 }
@@ -514,11 +547,54 @@ bool AbcMeshReader::accepts_object_type(
   return true;
 }
 
+P3fArraySamplePtr AbcMeshReader::read_positions(Alembic::AbcGeom::index_t index)
+{
+  Alembic::AbcGeom::IP3fArrayProperty positions_prop = m_schema.getPositionsProperty();
+  const std::string &object_path = m_iobject.getFullName();
+
+  P3fArraySamplePtr positions;
+  if (m_archive == NULL || !m_archive->cached_positions(object_path, index, positions)) {
+    positions_prop.get(positions, ISampleSelector(index));
+  }
+
+  if (m_archive != NULL && !m_schema.isConstant()) {
+    const Alembic::AbcGeom::index_t num_samples = m_schema.getNumSamples();
+    for (Alembic::AbcGeom::index_t i = index + 1; i <= index + PREFETCH_SAMPLES && i < num_samples;
+         i++) {
+      m_archive->prefetch_positions(object_path, positions_prop, i);
+    }
+  }
+
+  return positions;
+}
+
+void AbcMeshReader::read_sample_data(const ISampleSelector &sample_sel, AbcMeshData &r_data)
+{
+  /* The topology doesn't change over time, so only the positions have to be read. */
+  if (m_is_homogeneous && m_face_counts) {
+    r_data.face_counts = m_face_counts;
+    r_data.face_indices = m_face_indices;
+    r_data.positions = read_positions(
+        sample_sel.getIndex(m_schema.getTimeSampling(), m_schema.getNumSamples()));
+    return;
+  }
+
+  const IPolyMeshSchema::Sample sample = m_schema.getValue(sample_sel);
+  r_data.face_counts = sample.getFaceCounts();
+  r_data.face_indices = sample.getFaceIndices();
+  r_data.positions = sample.getPositions();
+
+  if (m_is_homogeneous) {
+    m_face_counts = r_data.face_counts;
+    m_face_indices = r_data.face_indices;
+  }
+}
+
 bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector &sample_sel)
 {
-  IPolyMeshSchema::Sample sample;
+  AbcMeshData abc_mesh_data;
   try {
-    sample = m_schema.getValue(sample_sel);
+    read_sample_data(sample_sel, abc_mesh_data);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -530,13 +606,14 @@ bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector
     return false;
   }
 
-  const P3fArraySamplePtr &positions = sample.getPositions();
-  const Alembic::Abc::Int32ArraySamplePtr &face_indices = sample.getFaceIndices();
-  const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
+  return topology_changed(existing_mesh, abc_mesh_data);
+}
 
-  return positions->size() != existing_mesh->totvert ||
-         face_counts->size() != existing_mesh->totpoly ||
-         face_indices->size() != existing_mesh->totloop;
+bool AbcMeshReader::topology_changed(const Mesh *existing_mesh, const AbcMeshData &abc_mesh_data)
+{
+  return abc_mesh_data.positions->size() != existing_mesh->totvert ||
+         abc_mesh_data.face_counts->size() != existing_mesh->totpoly ||
+         abc_mesh_data.face_indices->size() != existing_mesh->totloop;
 }
 
 Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
@@ -544,9 +621,9 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
                                int read_flag,
                                const char **err_str)
 {
-  IPolyMeshSchema::Sample sample;
+  AbcMeshData abc_mesh_data;
   try {
-    sample = m_schema.getValue(sample_sel);
+    read_sample_data(sample_sel, abc_mesh_data);
   }
   catch (Alembic::Util::Exception &ex) {
     if (err_str != nullptr) {
@@ -560,9 +637,9 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
     return existing_mesh;
   }
 
-  const P3fArraySamplePtr &positions = sample.getPositions();
-  const Alembic::Abc::Int32ArraySamplePtr &face_indices = sample.getFaceIndices();
-  const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
+  const P3fArraySamplePtr &positions = abc_mesh_data.positions;
+  const Alembic::Abc::Int32ArraySamplePtr &face_indices = abc_mesh_data.face_indices;
+  const Alembic::Abc::Int32ArraySamplePtr &face_counts = abc_mesh_data.face_counts;
 
   Mesh *new_mesh = NULL;
 
@@ -570,7 +647,7 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   ImportSettings settings;
   settings.read_flag |= read_flag;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  if (topology_changed(existing_mesh, abc_mesh_data)) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
 
@@ -595,7 +672,24 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   CDStreamConfig config = get_config(new_mesh ? new_mesh : existing_mesh);
   config.time = sample_sel.getRequestedTime();
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  get_weight_and_index(config, m_schema.getTimeSampling(), m_schema.getNumSamples());
+  if (config.weight != 0.0f) {
+    try {
+      abc_mesh_data.ceil_positions = read_positions(config.ceil_index);
+    }
+    catch (Alembic::Util::Exception &ex) {
+      printf("Alembic: error reading mesh sample for '%s/%s' at index %d: %s\n",
+             m_iobject.getFullName().c_str(),
+             m_schema.getName().c_str(),
+             (int)config.ceil_index,
+             ex.what());
+      /* Fall back to not interpolating. */
+      config.weight = 0.0f;
+    }
+  }
+
+  read_mesh_sample(
+      m_iobject.getFullName(), &settings, m_schema, sample_sel, config, abc_mesh_data);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -613,6 +707,11 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   return existing_mesh;
 }
 
+bool AbcMeshReader::read_bounds(const ISampleSelector &sample_sel, Imath::Box3d &r_bounds)
+{
+  return read_self_bounds(m_iobject.getFullName(), m_schema, sample_sel, r_bounds);
+}
+
 void AbcMeshReader::assign_facesets_to_mpoly(const ISampleSelector &sample_sel,
                                              MPoly *mpoly,
                                              int totpoly,
@@ -887,3 +986,8 @@ Mesh *AbcSubDReader::read_mesh(Mesh *existing_mesh,
 
   return config.mesh;
 }
+
+bool AbcSubDReader::read_bounds(const ISampleSelector &sample_sel, Imath::Box3d &r_bounds)
+{
+  return read_self_bounds(m_iobject.getFullName(), m_schema, sample_sel, r_bounds);
+}
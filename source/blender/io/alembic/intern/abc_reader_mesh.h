@@ -24,6 +24,7 @@
 #include "abc_customdata.h"
 #include "abc_reader_object.h"
 
+struct AbcMeshData;
 struct Mesh;
 
 class AbcMeshReader : public AbcObjectReader {
@@ -31,6 +32,12 @@ class AbcMeshReader : public AbcObjectReader {
 
   CDStreamConfig m_mesh_data;
 
+  /* When the topology doesn't change over time, the face counts and indices of the first sample
+   * read are kept, and later samples only read positions. */
+  bool m_is_homogeneous;
+  Alembic::AbcGeom::Int32ArraySamplePtr m_face_counts;
+  Alembic::AbcGeom::Int32ArraySamplePtr m_face_indices;
+
  public:
   AbcMeshReader(const Alembic::Abc::IObject &object, ImportSettings &settings);
 
@@ -46,8 +53,15 @@ class AbcMeshReader : public AbcObjectReader {
                          const char **err_str) override;
   bool topology_changed(Mesh *existing_mesh,
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
+  bool read_bounds(const Alembic::Abc::ISampleSelector &sample_sel,
+                   Imath::Box3d &r_bounds) override;
 
  private:
+  bool topology_changed(const Mesh *existing_mesh, const AbcMeshData &abc_mesh_data);
+
+  void read_sample_data(const Alembic::Abc::ISampleSelector &sample_sel, AbcMeshData &r_data);
+  Alembic::AbcGeom::P3fArraySamplePtr read_positions(Alembic::AbcGeom::index_t index);
+
   void readFaceSetsSample(Main *bmain,
                           Mesh *mesh,
                           const Alembic::AbcGeom::ISampleSelector &sample_sel);
@@ -75,6 +89,7 @@ class AbcSubDReader : public AbcObjectReader {
                          const Alembic::Abc::ISampleSelector &sample_sel,
                          int read_flag,
                          const char **err_str);
+  bool read_bounds(const Alembic::Abc::ISampleSelector &sample_sel, Imath::Box3d &r_bounds);
 };
 
 void read_mverts(MVert *mverts,
@@ -49,6 +49,7 @@ AbcObjectReader::AbcObjectReader(const IObject &object, ImportSettings &settings
       m_object(NULL),
       m_iobject(object),
       m_settings(&settings),
+      m_archive(NULL),
       m_min_time(std::numeric_limits<chrono_t>::max()),
       m_max_time(std::numeric_limits<chrono_t>::min()),
       m_refcount(0),
@@ -118,6 +119,11 @@ void AbcObjectReader::object(Object *ob)
   m_object = ob;
 }
 
+void AbcObjectReader::archive(ArchiveReader *archive)
+{
+  m_archive = archive;
+}
+
 static Imath::M44d blend_matrices(const Imath::M44d &m0, const Imath::M44d &m1, const float weight)
 {
   float mat0[4][4], mat1[4][4], ret[4][4];
@@ -186,6 +192,12 @@ bool AbcObjectReader::topology_changed(Mesh * /*existing_mesh*/,
   return false;
 }
 
+bool AbcObjectReader::read_bounds(const Alembic::Abc::ISampleSelector & /*sample_sel*/,
+                                  Imath::Box3d & /*r_bounds*/)
+{
+  return false;
+}
+
 void AbcObjectReader::setupObjectTransform(const float time)
 {
   bool is_constant = false;
@@ -28,6 +28,8 @@ extern "C" {
 #include "DNA_ID.h"
 }
 
+class ArchiveReader;
+
 struct CacheFile;
 struct Main;
 struct Mesh;
@@ -87,6 +89,10 @@ class AbcObjectReader {
 
   ImportSettings *m_settings;
 
+  /* Archive this reader streams from when used by a cache modifier or constraint, NULL when
+   * importing. Gives access to samples read ahead of playback. */
+  ArchiveReader *m_archive;
+
   chrono_t m_min_time;
   chrono_t m_max_time;
 
@@ -117,6 +123,8 @@ class AbcObjectReader {
   Object *object() const;
   void object(Object *ob);
 
+  void archive(ArchiveReader *archive);
+
   const std::string &name() const
   {
     return m_name;
@@ -148,6 +156,10 @@ class AbcObjectReader {
   virtual bool topology_changed(Mesh *existing_mesh,
                                 const Alembic::Abc::ISampleSelector &sample_sel);
 
+  /** Reads the bounds of the geometry, returns false when the object has none. */
+  virtual bool read_bounds(const Alembic::Abc::ISampleSelector &sample_sel,
+                           Imath::Box3d &r_bounds);
+
   /** Reads the object matrix and sets up an object transform if animated. */
   void setupObjectTransform(const float time);
 
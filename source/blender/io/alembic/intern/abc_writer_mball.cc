@@ -85,6 +85,12 @@ Mesh *AbcMBallWriter::getEvaluatedMesh(Scene * /*scene_eval*/, Object *ob_eval,
   return tmpmesh;
 }
 
+bool AbcMBallWriter::prepare_begin()
+{
+  /* The converted mesh is added to (and freed from) Main, which can't be done in parallel. */
+  return false;
+}
+
 void AbcMBallWriter::freeEvaluatedMesh(struct Mesh *mesh)
 {
   BKE_id_free(m_bmain, mesh);
@@ -45,6 +45,8 @@ class AbcMBallWriter : public AbcGenericMeshWriter {
 
   static bool isBasisBall(Scene *scene, Object *ob);
 
+  bool prepare_begin() override;
+
  protected:
   Mesh *getEvaluatedMesh(Scene *scene_eval, Object *ob_eval, bool &r_needsfree) override;
   void freeEvaluatedMesh(struct Mesh *mesh) override;
@@ -216,6 +216,9 @@ AbcGenericMeshWriter::AbcGenericMeshWriter(Object *ob,
   m_is_animated = isAnimated();
   m_subsurf_mod = NULL;
   m_is_subd = false;
+  m_prepared_mesh = NULL;
+  m_prepared_mesh_needsfree = false;
+  m_has_flat_shaded_poly = false;
 
   /* If the object is static, use the default static time sampling. */
   if (!m_is_animated) {
@@ -249,6 +252,9 @@ AbcGenericMeshWriter::AbcGenericMeshWriter(Object *ob,
 
 AbcGenericMeshWriter::~AbcGenericMeshWriter()
 {
+  if (m_prepared_mesh && m_prepared_mesh_needsfree) {
+    freeEvaluatedMesh(m_prepared_mesh);
+  }
   if (m_subsurf_mod) {
     m_subsurf_mod->mode &= ~eModifierMode_DisableTemporary;
   }
@@ -282,6 +288,25 @@ void AbcGenericMeshWriter::setIsAnimated(bool is_animated)
   m_is_animated = is_animated;
 }
 
+bool AbcGenericMeshWriter::prepare_begin()
+{
+  /* The first frame also writes face sets, UVs and other data to the archive,
+   * static meshes are only written once. */
+  if (m_first_frame || !m_is_animated) {
+    return false;
+  }
+
+  /* Fetching the evaluated mesh may evaluate it, which isn't safe to do in parallel. */
+  m_prepared_mesh = getExportMesh(m_prepared_mesh_needsfree);
+  return true;
+}
+
+void AbcGenericMeshWriter::prepare()
+{
+  m_prepared_mesh = finalizeExportMesh(m_prepared_mesh, m_prepared_mesh_needsfree);
+  convertMesh(m_prepared_mesh);
+}
+
 void AbcGenericMeshWriter::do_write()
 {
   /* We have already stored a sample for this object. */
@@ -290,7 +315,18 @@ void AbcGenericMeshWriter::do_write()
   }
 
   bool needsfree;
-  struct Mesh *mesh = getFinalMesh(needsfree);
+  struct Mesh *mesh;
+
+  if (m_prepared_mesh) {
+    /* Already converted by prepare(). */
+    mesh = m_prepared_mesh;
+    needsfree = m_prepared_mesh_needsfree;
+    m_prepared_mesh = NULL;
+  }
+  else {
+    mesh = getFinalMesh(needsfree);
+    convertMesh(mesh);
+  }
 
   try {
     if (m_settings.use_subdiv_schema && m_subdiv_schema.valid()) {
@@ -317,22 +353,29 @@ void AbcGenericMeshWriter::freeEvaluatedMesh(struct Mesh *mesh)
   BKE_id_free(NULL, mesh);
 }
 
-void AbcGenericMeshWriter::writeMesh(struct Mesh *mesh)
+void AbcGenericMeshWriter::convertMesh(struct Mesh *mesh)
 {
-  std::vector<Imath::V3f> points, normals;
-  std::vector<int32_t> poly_verts, loop_counts;
-  std::vector<Imath::V3f> velocities;
-  bool has_flat_shaded_poly = false;
+  get_vertices(mesh, m_points);
+  get_topology(mesh, m_poly_verts, m_loop_counts, m_has_flat_shaded_poly);
 
-  get_vertices(mesh, points);
-  get_topology(mesh, poly_verts, loop_counts, has_flat_shaded_poly);
+  if (m_settings.use_subdiv_schema && m_subdiv_schema.valid()) {
+    get_creases(mesh, m_crease_indices, m_crease_lengths, m_crease_sharpness);
+  }
+  else if (m_is_liquid) {
+    getVelocities(mesh, m_velocities);
+  }
+}
+
+void AbcGenericMeshWriter::writeMesh(struct Mesh *mesh)
+{
+  std::vector<Imath::V3f> normals;
 
   if (m_first_frame && m_settings.export_face_sets) {
     writeFaceSets(mesh, m_mesh_schema);
   }
 
   m_mesh_sample = OPolyMeshSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
+      V3fArraySample(m_points), Int32ArraySample(m_poly_verts), Int32ArraySample(m_loop_counts));
 
   UVSample sample;
   if (m_first_frame && m_settings.export_uvs) {
@@ -353,7 +396,9 @@ void AbcGenericMeshWriter::writeMesh(struct Mesh *mesh)
   }
 
   if (m_settings.export_normals) {
-    get_loop_normals(mesh, normals, has_flat_shaded_poly);
+    /* Computed here rather than in convertMesh(): the split normals are stored in the mesh,
+     * which may share its data with other evaluated objects. */
+    get_loop_normals(mesh, normals, m_has_flat_shaded_poly);
 
     ON3fGeomParam::Sample normals_sample;
     if (!normals.empty()) {
@@ -365,8 +410,7 @@ void AbcGenericMeshWriter::writeMesh(struct Mesh *mesh)
   }
 
   if (m_is_liquid) {
-    getVelocities(mesh, velocities);
-    m_mesh_sample.setVelocities(V3fArraySample(velocities));
+    m_mesh_sample.setVelocities(V3fArraySample(m_velocities));
   }
 
   m_mesh_sample.setSelfBounds(bounds());
@@ -378,22 +422,12 @@ void AbcGenericMeshWriter::writeMesh(struct Mesh *mesh)
 
 void AbcGenericMeshWriter::writeSubD(struct Mesh *mesh)
 {
-  std::vector<float> crease_sharpness;
-  std::vector<Imath::V3f> points;
-  std::vector<int32_t> poly_verts, loop_counts;
-  std::vector<int32_t> crease_indices, crease_lengths;
-  bool has_flat_poly = false;
-
-  get_vertices(mesh, points);
-  get_topology(mesh, poly_verts, loop_counts, has_flat_poly);
-  get_creases(mesh, crease_indices, crease_lengths, crease_sharpness);
-
   if (m_first_frame && m_settings.export_face_sets) {
     writeFaceSets(mesh, m_subdiv_schema);
   }
 
   m_subdiv_sample = OSubDSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
+      V3fArraySample(m_points), Int32ArraySample(m_poly_verts), Int32ArraySample(m_loop_counts));
 
   UVSample sample;
   if (m_first_frame && m_settings.export_uvs) {
@@ -413,10 +447,10 @@ void AbcGenericMeshWriter::writeSubD(struct Mesh *mesh)
         m_subdiv_schema.getArbGeomParams(), m_custom_data_config, &mesh->ldata, CD_MLOOPUV);
   }
 
-  if (!crease_indices.empty()) {
-    m_subdiv_sample.setCreaseIndices(Int32ArraySample(crease_indices));
-    m_subdiv_sample.setCreaseLengths(Int32ArraySample(crease_lengths));
-    m_subdiv_sample.setCreaseSharpnesses(FloatArraySample(crease_sharpness));
+  if (!m_crease_indices.empty()) {
+    m_subdiv_sample.setCreaseIndices(Int32ArraySample(m_crease_indices));
+    m_subdiv_sample.setCreaseLengths(Int32ArraySample(m_crease_lengths));
+    m_subdiv_sample.setCreaseSharpnesses(FloatArraySample(m_crease_sharpness));
   }
 
   m_subdiv_sample.setSelfBounds(bounds());
@@ -440,6 +474,13 @@ template<typename Schema> void AbcGenericMeshWriter::writeFaceSets(struct Mesh *
 }
 
 Mesh *AbcGenericMeshWriter::getFinalMesh(bool &r_needsfree)
+{
+  struct Mesh *mesh = getExportMesh(r_needsfree);
+  return finalizeExportMesh(mesh, r_needsfree);
+}
+
+/* Get the evaluated mesh to export. */
+Mesh *AbcGenericMeshWriter::getExportMesh(bool &r_needsfree)
 {
   /* We don't want subdivided mesh data */
   if (m_subsurf_mod) {
@@ -456,6 +497,13 @@ Mesh *AbcGenericMeshWriter::getFinalMesh(bool &r_needsfree)
     m_subsurf_mod->mode &= ~eModifierMode_DisableTemporary;
   }
 
+  return mesh;
+}
+
+/* Apply export options to the mesh, only using data of the mesh itself
+ * (so this can run in parallel for different objects). */
+Mesh *AbcGenericMeshWriter::finalizeExportMesh(struct Mesh *mesh, bool &r_needsfree)
+{
   if (m_settings.triangulate) {
     const bool tag_only = false;
     const int quad_method = m_settings.quad_method;
@@ -46,6 +46,18 @@ class AbcGenericMeshWriter : public AbcObjectWriter {
   bool m_is_liquid;
   bool m_is_subd;
 
+  /* Mesh fetched by #prepare_begin() for the next #do_write(). */
+  struct Mesh *m_prepared_mesh;
+  bool m_prepared_mesh_needsfree;
+
+  /* Mesh data converted for the next sample, see #convertMesh(). */
+  std::vector<Imath::V3f> m_points;
+  std::vector<Imath::V3f> m_velocities;
+  std::vector<int32_t> m_poly_verts, m_loop_counts;
+  std::vector<int32_t> m_crease_indices, m_crease_lengths;
+  std::vector<float> m_crease_sharpness;
+  bool m_has_flat_shaded_poly;
+
  public:
   AbcGenericMeshWriter(Object *ob,
                        AbcTransformWriter *parent,
@@ -55,6 +67,9 @@ class AbcGenericMeshWriter : public AbcObjectWriter {
   ~AbcGenericMeshWriter();
   void setIsAnimated(bool is_animated);
 
+  virtual bool prepare_begin() override;
+  virtual void prepare() override;
+
  protected:
   virtual void do_write();
   virtual bool isAnimated() const;
@@ -62,6 +77,10 @@ class AbcGenericMeshWriter : public AbcObjectWriter {
   virtual void freeEvaluatedMesh(struct Mesh *mesh);
 
   Mesh *getFinalMesh(bool &r_needsfree);
+  Mesh *getExportMesh(bool &r_needsfree);
+  Mesh *finalizeExportMesh(struct Mesh *mesh, bool &r_needsfree);
+
+  void convertMesh(struct Mesh *mesh);
 
   void writeMesh(struct Mesh *mesh);
   void writeSubD(struct Mesh *mesh);
@@ -72,6 +72,15 @@ Imath::Box3d AbcObjectWriter::bounds()
   return this->m_bounds;
 }
 
+bool AbcObjectWriter::prepare_begin()
+{
+  return false;
+}
+
+void AbcObjectWriter::prepare()
+{
+}
+
 void AbcObjectWriter::write()
 {
   do_write();
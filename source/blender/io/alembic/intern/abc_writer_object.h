@@ -62,6 +62,18 @@ class AbcObjectWriter {
 
   virtual Imath::Box3d bounds();
 
+  /**
+   * Optionally fetch the data for the next #write() call ahead of time. Returns true when
+   * #prepare() has to be called to convert it. Called from the main thread for all writers,
+   * then #prepare() runs for them in parallel, before #write() is called for each in order.
+   */
+  virtual bool prepare_begin();
+  /**
+   * Convert the data fetched by #prepare_begin() into samples. Runs in parallel with other
+   * writers, so it must not access the archive.
+   */
+  virtual void prepare();
+
   void write();
 
  private:
@@ -78,6 +78,13 @@ void AbcPointsWriter::do_write()
 
   m_psys->lattice_deform_data = psys_create_lattice_deform_data(&sim);
 
+  points.reserve(m_psys->totpart);
+  velocities.reserve(m_psys->totpart);
+  widths.reserve(m_psys->totpart);
+  ids.reserve(m_psys->totpart);
+
+  const float ctime = DEG_get_ctime(m_settings.depsgraph);
+
   uint64_t index = 0;
   for (int p = 0; p < m_psys->totpart; p++) {
     float pos[3], vel[3];
@@ -86,7 +93,7 @@ void AbcPointsWriter::do_write()
       continue;
     }
 
-    state.time = DEG_get_ctime(m_settings.depsgraph);
+    state.time = ctime;
 
     if (psys_get_particle_state(&sim, p, &state, 0) == 0) {
       continue;
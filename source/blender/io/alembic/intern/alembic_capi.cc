@@ -1018,6 +1018,37 @@ bool ABC_mesh_topology_changed(
   return abc_reader->topology_changed(existing_mesh, sample_sel);
 }
 
+bool ABC_read_bounds(CacheReader *reader,
+                     Object *ob,
+                     const float time,
+                     float r_min[3],
+                     float r_max[3],
+                     const char **err_str)
+{
+  AbcObjectReader *abc_reader = get_abc_reader(reader, ob, err_str);
+  if (abc_reader == NULL) {
+    return false;
+  }
+
+  ISampleSelector sample_sel = sample_selector_for_time(time);
+  Imath::Box3d bounds;
+  if (!abc_reader->read_bounds(sample_sel, bounds)) {
+    return false;
+  }
+
+  /* Converting from Y-up flips an axis, so the corners have to be sorted again. */
+  const Imath::V3f bounds_min(bounds.min);
+  const Imath::V3f bounds_max(bounds.max);
+  float corner[3];
+  INIT_MINMAX(r_min, r_max);
+  copy_zup_from_yup(corner, bounds_min.getValue());
+  minmax_v3v3_v3(r_min, r_max, corner);
+  copy_zup_from_yup(corner, bounds_max.getValue());
+  minmax_v3v3_v3(r_min, r_max, corner);
+
+  return true;
+}
+
 /* ************************************************************************** */
 
 void CacheReader_free(CacheReader *reader)
@@ -1065,6 +1096,7 @@ CacheReader *CacheReader_open_alembic_object(AbcArchiveHandle *handle,
     return NULL;
   }
   abc_reader->object(object);
+  abc_reader->archive(archive);
   abc_reader->incref();
 
   return reinterpret_cast<CacheReader *>(abc_reader);
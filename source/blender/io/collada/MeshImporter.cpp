@@ -633,6 +633,78 @@ void MeshImporter::read_lines(COLLADAFW::Mesh *mesh, Mesh *me)
   }
 }
 
+struct MeshImporter::PolygonsFillData {
+  MeshImporter *importer;
+  COLLADAFW::MeshVertexData *normals;
+  UVDataWrapper *uvs;
+  VCOLDataWrapper *vcol;
+
+  // Where the first polygon and loop of the primitive go.
+  MPoly *mpoly;
+  MLoop *mloop;
+  int loop_index;
+
+  unsigned int *position_indices;
+  unsigned int *normal_indices;  // NULL when the primitive has no usable normals.
+  // Start of each polygon's loops, relative to the first loop of the primitive.
+  const unsigned int *loop_starts;
+
+  std::vector<MLoopUV *> uv_layers;
+  std::vector<COLLADAFW::IndexList *> uv_index_lists;
+  std::vector<MLoopCol *> vcol_layers;
+  std::vector<COLLADAFW::IndexList *> vcol_index_lists;
+
+  int invalid_loop_holes;
+};
+
+void MeshImporter::read_polygons_cb(void *__restrict userdata,
+                                    const int index,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  PolygonsFillData *data = (PolygonsFillData *)userdata;
+  MeshImporter *importer = data->importer;
+
+  const unsigned int start_index = data->loop_starts[index];
+  const int vcount = data->loop_starts[index + 1] - start_index;
+  const int loop_index = data->loop_index + start_index;
+  MPoly *mpoly = data->mpoly + index;
+
+  bool broken_loop = importer->set_poly_indices(
+      mpoly, data->mloop + start_index, loop_index, data->position_indices + start_index, vcount);
+  if (broken_loop) {
+    (*(int *)tls->userdata_chunk)++;
+  }
+
+  for (size_t i = 0; i < data->uv_layers.size(); i++) {
+    importer->set_face_uv(data->uv_layers[i] + loop_index,
+                          *data->uvs,
+                          start_index,
+                          *data->uv_index_lists[i],
+                          vcount);
+  }
+
+  if (data->normal_indices) {
+    if (!importer->is_flat_face(data->normal_indices + start_index, *data->normals, vcount)) {
+      mpoly->flag |= ME_SMOOTH;
+    }
+  }
+
+  for (size_t i = 0; i < data->vcol_layers.size(); i++) {
+    importer->set_vcol(data->vcol_layers[i] + loop_index,
+                       *data->vcol,
+                       start_index,
+                       *data->vcol_index_lists[i],
+                       vcount);
+  }
+}
+
+void MeshImporter::read_polygons_finalize(void *__restrict userdata,
+                                          void *__restrict userdata_chunk)
+{
+  PolygonsFillData *data = (PolygonsFillData *)userdata;
+  data->invalid_loop_holes += *(int *)userdata_chunk;
+}
+
 // =======================================================================
 // Read all faces from TRIANGLES, TRIANGLE_FANS, POLYLIST, POLYGON
 // Important: This function MUST be called before read_lines()
@@ -721,91 +793,96 @@ void MeshImporter::read_polys(COLLADAFW::Mesh *collada_mesh, Mesh *me)
         collada_meshtype == COLLADAFW::MeshPrimitive::POLYGONS ||
         collada_meshtype == COLLADAFW::MeshPrimitive::TRIANGLES) {
       COLLADAFW::Polygons *mpvc = (COLLADAFW::Polygons *)mp;
-      unsigned int start_index = 0;
-
-      COLLADAFW::IndexListArray &index_list_array_uvcoord = mp->getUVCoordIndicesArray();
-      COLLADAFW::IndexListArray &index_list_array_vcolor = mp->getColorIndicesArray();
 
-      int invalid_loop_holes = 0;
+      // First pass: find where the loops of each polygon start, so that the
+      // polygons can be filled in parallel in the second pass.
+      std::vector<unsigned int> loop_starts;
+      loop_starts.reserve(prim_totpoly + 1);
+      unsigned int prim_totloop = 0;
       for (unsigned int j = 0; j < prim_totpoly; j++) {
-
-        // Vertices in polygon:
         int vcount = get_vertex_count(mpvc, j);
         if (vcount < 0) {
           continue;  // TODO: add support for holes
         }
-
-        bool broken_loop = set_poly_indices(mpoly, mloop, loop_index, position_indices, vcount);
-        if (broken_loop) {
-          invalid_loop_holes += 1;
+        loop_starts.push_back(prim_totloop);
+        prim_totloop += vcount;
+      }
+      loop_starts.push_back(prim_totloop);
+      const int prim_filled_totpoly = (int)loop_starts.size() - 1;
+
+      PolygonsFillData data;
+      data.importer = this;
+      data.normals = &nor;
+      data.uvs = &uvs;
+      data.vcol = &vcol;
+      data.mpoly = mpoly;
+      data.mloop = mloop;
+      data.loop_index = loop_index;
+      data.position_indices = position_indices;
+      data.normal_indices = mp_has_normals ? normal_indices : NULL;
+      data.loop_starts = loop_starts.data();
+      data.invalid_loop_holes = 0;
+
+      // Look up the layers once per primitive instead of once per polygon.
+      COLLADAFW::IndexListArray &index_list_array_uvcoord = mp->getUVCoordIndicesArray();
+      for (unsigned int uvset_index = 0; uvset_index < index_list_array_uvcoord.getCount();
+           uvset_index++) {
+        COLLADAFW::IndexList &index_list = *index_list_array_uvcoord[uvset_index];
+        MLoopUV *mloopuv = (MLoopUV *)CustomData_get_layer_named(
+            &me->ldata, CD_MLOOPUV, index_list.getName().c_str());
+        if (mloopuv == NULL) {
+          fprintf(stderr,
+                  "Collada import: Mesh [%s] : Unknown reference to TEXCOORD [#%s].\n",
+                  me->id.name,
+                  index_list.getName().c_str());
+        }
+        else {
+          data.uv_layers.push_back(mloopuv);
+          data.uv_index_lists.push_back(&index_list);
         }
+      }
+
+      if (mp->hasColorIndices()) {
+        int vcolor_count = mp->getColorIndicesArray().getCount();
 
-        for (unsigned int uvset_index = 0; uvset_index < index_list_array_uvcoord.getCount();
-             uvset_index++) {
-          // get mtface by face index and uv set index
-          COLLADAFW::IndexList &index_list = *index_list_array_uvcoord[uvset_index];
-          MLoopUV *mloopuv = (MLoopUV *)CustomData_get_layer_named(
-              &me->ldata, CD_MLOOPUV, index_list.getName().c_str());
-          if (mloopuv == NULL) {
+        for (unsigned int vcolor_index = 0; vcolor_index < vcolor_count; vcolor_index++) {
+          COLLADAFW::IndexList &color_index_list = *mp->getColorIndices(vcolor_index);
+          COLLADAFW::String colname = extract_vcolname(color_index_list.getName());
+          MLoopCol *mloopcol = (MLoopCol *)CustomData_get_layer_named(
+              &me->ldata, CD_MLOOPCOL, colname.c_str());
+          if (mloopcol == NULL) {
             fprintf(stderr,
-                    "Collada import: Mesh [%s] : Unknown reference to TEXCOORD [#%s].\n",
+                    "Collada import: Mesh [%s] : Unknown reference to VCOLOR [#%s].\n",
                     me->id.name,
-                    index_list.getName().c_str());
+                    color_index_list.getName().c_str());
           }
           else {
-            set_face_uv(mloopuv + loop_index,
-                        uvs,
-                        start_index,
-                        *index_list_array_uvcoord[uvset_index],
-                        vcount);
-          }
-        }
-
-        if (mp_has_normals) {
-          if (!is_flat_face(normal_indices, nor, vcount)) {
-            mpoly->flag |= ME_SMOOTH;
+            data.vcol_layers.push_back(mloopcol);
+            data.vcol_index_lists.push_back(&color_index_list);
           }
         }
-
-        if (mp->hasColorIndices()) {
-          int vcolor_count = index_list_array_vcolor.getCount();
-
-          for (unsigned int vcolor_index = 0; vcolor_index < vcolor_count; vcolor_index++) {
-
-            COLLADAFW::IndexList &color_index_list = *mp->getColorIndices(vcolor_index);
-            COLLADAFW::String colname = extract_vcolname(color_index_list.getName());
-            MLoopCol *mloopcol = (MLoopCol *)CustomData_get_layer_named(
-                &me->ldata, CD_MLOOPCOL, colname.c_str());
-            if (mloopcol == NULL) {
-              fprintf(stderr,
-                      "Collada import: Mesh [%s] : Unknown reference to VCOLOR [#%s].\n",
-                      me->id.name,
-                      color_index_list.getName().c_str());
-            }
-            else {
-              set_vcol(mloopcol + loop_index, vcol, start_index, color_index_list, vcount);
-            }
-          }
-        }
-
-        mpoly++;
-        mloop += vcount;
-        loop_index += vcount;
-        start_index += vcount;
-        prim.totpoly++;
-
-        if (mp_has_normals) {
-          normal_indices += vcount;
-        }
-
-        position_indices += vcount;
       }
 
-      if (invalid_loop_holes > 0) {
+      // Each thread counts the holes it finds, read_polygons_finalize() sums them up.
+      int chunk_invalid_loop_holes = 0;
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 1024;
+      settings.userdata_chunk = &chunk_invalid_loop_holes;
+      settings.userdata_chunk_size = sizeof(chunk_invalid_loop_holes);
+      settings.func_finalize = read_polygons_finalize;
+      BLI_task_parallel_range(0, prim_filled_totpoly, &data, read_polygons_cb, &settings);
+
+      mpoly += prim_filled_totpoly;
+      mloop += prim_totloop;
+      loop_index += prim_totloop;
+      prim.totpoly += prim_filled_totpoly;
+
+      if (data.invalid_loop_holes > 0) {
         fprintf(stderr,
                 "Collada import: Mesh [%s] : contains %d unsupported loops (holes).\n",
                 me->id.name,
-                invalid_loop_holes);
+                data.invalid_loop_holes);
       }
     }
 
@@ -1144,7 +1221,12 @@ Object *MeshImporter::create_mesh_object(
   Mesh *new_mesh = uid_mesh_map[*geom_uid];
 
   BKE_mesh_assign_object(m_bmain, ob, new_mesh);
-  BKE_mesh_calc_normals(new_mesh);
+
+  // Geometry instanced by several nodes is shared, only set it up for the first one.
+  const bool is_first_instance = validated_meshes.insert(new_mesh).second;
+  if (is_first_instance) {
+    BKE_mesh_calc_normals(new_mesh);
+  }
 
   /* Because BKE_mesh_assign_object would have already decreased it... */
   id_us_plus(&old_mesh->id);
@@ -1165,7 +1247,9 @@ Object *MeshImporter::create_mesh_object(
   }
 
   // clean up the mesh
-  BKE_mesh_validate((Mesh *)ob->data, false, false);
+  if (is_first_instance) {
+    BKE_mesh_validate(new_mesh, false, false);
+  }
 
   return ob;
 }
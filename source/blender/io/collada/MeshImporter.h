@@ -22,6 +22,7 @@
 #define __MESHIMPORTER_H__
 
 #include <map>
+#include <set>
 #include <vector>
 
 #include "COLLADAFWIndexList.h"
@@ -40,6 +41,7 @@
 
 extern "C" {
 #include "BLI_edgehash.h"
+#include "BLI_task.h"
 #include "DNA_material_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -90,6 +92,7 @@ class MeshImporter : public MeshImporterBase {
   std::map<COLLADAFW::UniqueId, Mesh *> uid_mesh_map;     /* geometry unique id-to-mesh map */
   std::map<COLLADAFW::UniqueId, Object *> uid_object_map; /* geom uid-to-object */
   std::vector<Object *> imported_objects;                 /* list of imported objects */
+  std::set<Mesh *> validated_meshes;                      /* meshes set up by an instance */
 
   /* this structure is used to assign material indices to polygons
    * it holds a portion of Mesh faces and corresponds to a DAE primitive list
@@ -139,6 +142,13 @@ class MeshImporter : public MeshImporterBase {
 
   void allocate_poly_data(COLLADAFW::Mesh *collada_mesh, Mesh *me);
 
+  /* State shared by the threads filling the polygons of one primitive. */
+  struct PolygonsFillData;
+  static void read_polygons_cb(void *__restrict userdata,
+                               const int index,
+                               const TaskParallelTLS *__restrict tls);
+  static void read_polygons_finalize(void *__restrict userdata, void *__restrict userdata_chunk);
+
   /* TODO: import uv set names */
   void read_polys(COLLADAFW::Mesh *mesh, Mesh *me);
   void read_lines(COLLADAFW::Mesh *mesh, Mesh *me);
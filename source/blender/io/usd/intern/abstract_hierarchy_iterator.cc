@@ -30,6 +30,7 @@ extern "C" {
 #include "BLI_assert.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_task.h"
 
 #include "DNA_ID.h"
 #include "DNA_layer_types.h"
@@ -76,6 +77,10 @@ AbstractHierarchyWriter::~AbstractHierarchyWriter()
 {
 }
 
+void AbstractHierarchyWriter::prepare(const HierarchyContext & /*context*/)
+{
+}
+
 AbstractHierarchyIterator::AbstractHierarchyIterator(Depsgraph *depsgraph)
     : depsgraph_(depsgraph), writers_()
 {
@@ -93,6 +98,7 @@ void AbstractHierarchyIterator::iterate_and_write()
   determine_export_paths(HierarchyContext::root());
   determine_duplication_references(HierarchyContext::root(), "");
   make_writers(HierarchyContext::root());
+  write_pending();
   export_graph_clear();
 }
 
@@ -464,7 +470,7 @@ void AbstractHierarchyIterator::make_writers(const HierarchyContext *parent_cont
     /* XXX This can lead to too many XForms being written. For example, a camera writer can refuse
      * to write an orthographic camera. By the time that this is known, the XForm has already been
      * written. */
-    transform_writer->write(*context);
+    queue_write(transform_writer, *context);
 
     if (!context->weak_export) {
       make_writers_particle_systems(context);
@@ -503,7 +509,7 @@ void AbstractHierarchyIterator::make_writer_object_data(const HierarchyContext *
     return;
   }
 
-  data_writer->write(data_context);
+  queue_write(data_writer, data_context);
 }
 
 void AbstractHierarchyIterator::make_writers_particle_systems(
@@ -532,11 +538,42 @@ void AbstractHierarchyIterator::make_writers_particle_systems(
     }
 
     if (writer != nullptr) {
-      writer->write(hair_context);
+      queue_write(writer, hair_context);
     }
   }
 }
 
+void AbstractHierarchyIterator::queue_write(AbstractHierarchyWriter *writer,
+                                            const HierarchyContext &context)
+{
+  pending_writes_.push_back(std::make_pair(writer, context));
+}
+
+static void prepare_write_cb(void *__restrict userdata,
+                             const int index,
+                             const TaskParallelTLS *__restrict /*tls*/)
+{
+  AbstractHierarchyIterator::PendingWrite &pending_write =
+      (*static_cast<std::vector<AbstractHierarchyIterator::PendingWrite> *>(userdata))[index];
+  pending_write.first->prepare(pending_write.second);
+}
+
+void AbstractHierarchyIterator::write_pending()
+{
+  /* Converting data is independent per writer, but writing to the file is not. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (pending_writes_.size() > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, (int)pending_writes_.size(), &pending_writes_, prepare_write_cb, &settings);
+
+  for (PendingWrite &pending_write : pending_writes_) {
+    pending_write.first->write(pending_write.second);
+  }
+  pending_writes_.clear();
+}
+
 std::string AbstractHierarchyIterator::get_object_name(const Object *object) const
 {
   return get_id_name(&object->id);
@@ -37,8 +37,9 @@
 #define __ABSTRACT_HIERARCHY_ITERATOR_H__
 
 #include <map>
-#include <string>
 #include <set>
+#include <string>
+#include <vector>
 
 struct Base;
 struct Depsgraph;
@@ -112,6 +113,11 @@ class AbstractHierarchyWriter {
  public:
   virtual ~AbstractHierarchyWriter();
   virtual void write(HierarchyContext &context) = 0;
+
+  /* Convert data for the upcoming write() call. This is called for all writers of a frame in
+   * parallel, before their write() functions are called one after the other. As such, it must not
+   * touch the exported file nor any state shared with other writers. */
+  virtual void prepare(const HierarchyContext &context);
   // TODO(Sybren): add function like absent() that's called when a writer was previously created,
   // but wasn't used while exporting the current frame (for example, a particle-instanced mesh of
   // which the particle is no longer alive).
@@ -139,12 +145,16 @@ class AbstractHierarchyIterator {
   /* Mapping from ID to its export path. This is used for instancing; given an
    * instanced datablock, the export path of the original can be looked up. */
   typedef std::map<ID *, std::string> ExportPathMap;
+  /* A writer and the context to call it with. Writes are collected while traversing the export
+   * graph, so that the writers can prepare their data in parallel before writing. */
+  typedef std::pair<AbstractHierarchyWriter *, HierarchyContext> PendingWrite;
 
  protected:
   ExportGraph export_graph_;
   ExportPathMap duplisource_export_path_;
   Depsgraph *depsgraph_;
   WriterMap writers_;
+  std::vector<PendingWrite> pending_writes_;
 
  public:
   explicit AbstractHierarchyIterator(Depsgraph *depsgraph);
@@ -195,6 +205,9 @@ class AbstractHierarchyIterator {
   void make_writer_object_data(const HierarchyContext *context);
   void make_writers_particle_systems(const HierarchyContext *context);
 
+  void queue_write(AbstractHierarchyWriter *writer, const HierarchyContext &context);
+  void write_pending();
+
   /* Convenience wrappers around get_id_name(). */
   std::string get_object_name(const Object *object) const;
   std::string get_object_data_name(const Object *object) const;
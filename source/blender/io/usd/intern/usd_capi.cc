@@ -19,6 +19,7 @@
 
 #include "usd.h"
 #include "usd_hierarchy_iterator.h"
+#include "usd_reader_stage.h"
 
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/stage.h>
@@ -31,11 +32,16 @@ extern "C" {
 #include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_query.h"
 
+#include "DNA_collection_types.h"
+#include "DNA_layer_types.h"
+#include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
 #include "BKE_blender_version.h"
+#include "BKE_collection.h"
 #include "BKE_context.h"
 #include "BKE_global.h"
+#include "BKE_layer.h"
 #include "BKE_scene.h"
 
 #include "BLI_fileops.h"
@@ -170,6 +176,123 @@ static void export_endjob(void *customdata)
   WM_set_locked_interface(data->wm, false);
 }
 
+struct ImportJobData {
+  Main *bmain;
+  Scene *scene;
+  ViewLayer *view_layer;
+  wmWindowManager *wm;
+
+  char filename[FILE_MAX];
+  USDImportParams params;
+
+  USDStageReader *reader;
+
+  short *stop;
+  short *do_update;
+  float *progress;
+
+  bool was_canceled;
+  bool import_ok;
+};
+
+static void import_startjob(void *customdata, short *stop, short *do_update, float *progress)
+{
+  ImportJobData *data = static_cast<ImportJobData *>(customdata);
+
+  data->stop = stop;
+  data->do_update = do_update;
+  data->progress = progress;
+  data->was_canceled = false;
+
+  WM_set_locked_interface(data->wm, true);
+  G.is_break = false;
+
+  *progress = 0.0f;
+  *do_update = true;
+
+  /* Unloaded payloads are never composed, which is what keeps opening large stages cheap. */
+  pxr::UsdStageRefPtr usd_stage = pxr::UsdStage::Open(
+      data->filename,
+      data->params.load_payloads ? pxr::UsdStage::LoadAll : pxr::UsdStage::LoadNone);
+  if (!usd_stage) {
+    WM_reportf(RPT_ERROR, "USD Import: unable to open stage to read %s", data->filename);
+    return;
+  }
+
+  data->reader = new USDStageReader(usd_stage, data->params);
+  data->reader->collect_prims();
+
+  *progress = 0.1f;
+  *do_update = true;
+
+  if (G.is_break || (stop != nullptr && *stop)) {
+    data->was_canceled = true;
+    return;
+  }
+
+  /* Reading the prims is the bulk of the work, creating objects from them is cheap. */
+  data->reader->read_prims();
+
+  const int invalid_meshes_count = data->reader->invalid_meshes_count();
+  if (invalid_meshes_count != 0) {
+    WM_reportf(RPT_WARNING,
+               "USD Import: %d invalid mesh(es) in %s were imported empty, see the console",
+               invalid_meshes_count,
+               data->filename);
+  }
+
+  *progress = 0.8f;
+  *do_update = true;
+
+  if (G.is_break || (stop != nullptr && *stop)) {
+    data->was_canceled = true;
+    return;
+  }
+
+  data->reader->create_objects(data->bmain);
+  data->import_ok = true;
+
+  *progress = 1.0f;
+  *do_update = true;
+}
+
+static void import_endjob(void *customdata)
+{
+  ImportJobData *data = static_cast<ImportJobData *>(customdata);
+
+  if (data->import_ok) {
+    ViewLayer *view_layer = data->view_layer;
+    LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
+
+    BKE_view_layer_base_deselect_all(view_layer);
+
+    for (const USDPrimImport &prim_import : data->reader->prims()) {
+      Object *ob = prim_import.object;
+      BKE_collection_object_add(data->bmain, lc->collection, ob);
+
+      Base *base = BKE_view_layer_base_find(view_layer, ob);
+      BKE_view_layer_base_select_and_set_active(view_layer, base);
+
+      DEG_id_tag_update_ex(
+          data->bmain, &ob->id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_BASE_FLAGS);
+    }
+
+    DEG_id_tag_update(&lc->collection->id, ID_RECALC_COPY_ON_WRITE);
+    DEG_id_tag_update(&data->scene->id, ID_RECALC_BASE_FLAGS);
+    DEG_relations_tag_update(data->bmain);
+  }
+
+  WM_set_locked_interface(data->wm, false);
+  WM_main_add_notifier(NC_SCENE | ND_OB_ACTIVE, data->scene);
+}
+
+static void import_freejob(void *customdata)
+{
+  ImportJobData *data = static_cast<ImportJobData *>(customdata);
+  delete data->reader;
+  MEM_freeN(data);
+}
+
 }  // namespace USD
 
 bool USD_export(bContext *C,
@@ -218,6 +341,53 @@ bool USD_export(bContext *C,
   return export_ok;
 }
 
+bool USD_import(bContext *C,
+                const char *filepath,
+                const USDImportParams *params,
+                bool as_background_job)
+{
+  Scene *scene = CTX_data_scene(C);
+
+  USD::ImportJobData *job = static_cast<USD::ImportJobData *>(
+      MEM_mallocN(sizeof(USD::ImportJobData), "ImportJobData"));
+
+  job->bmain = CTX_data_main(C);
+  job->scene = scene;
+  job->view_layer = CTX_data_view_layer(C);
+  job->wm = CTX_wm_manager(C);
+  job->reader = NULL;
+  job->was_canceled = false;
+  job->import_ok = false;
+  BLI_strncpy(job->filename, filepath, sizeof(job->filename));
+  job->params = *params;
+
+  bool import_ok = false;
+  if (as_background_job) {
+    wmJob *wm_job = WM_jobs_get(
+        job->wm, CTX_wm_window(C), scene, "USD Import", WM_JOB_PROGRESS, WM_JOB_TYPE_ALEMBIC);
+
+    /* setup job */
+    WM_jobs_customdata_set(wm_job, job, USD::import_freejob);
+    WM_jobs_timer(wm_job, 0.1, NC_SCENE, NC_SCENE);
+    WM_jobs_callbacks(wm_job, USD::import_startjob, NULL, NULL, USD::import_endjob);
+
+    WM_jobs_start(CTX_wm_manager(C), wm_job);
+  }
+  else {
+    /* Fake a job context, so that we don't need NULL pointer checks while importing. */
+    short stop = 0, do_update = 0;
+    float progress = 0.f;
+
+    USD::import_startjob(job, &stop, &do_update, &progress);
+    USD::import_endjob(job);
+    import_ok = job->import_ok;
+
+    USD::import_freejob(job);
+  }
+
+  return import_ok;
+}
+
 int USD_get_version(void)
 {
   /* USD 19.11 defines:
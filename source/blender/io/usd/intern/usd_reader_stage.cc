@@ -0,0 +1,345 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+#include "usd_reader_stage.h"
+
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/metrics.h>
+#include <pxr/usd/usdGeom/modelAPI.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xformable.h>
+
+#include <map>
+
+extern "C" {
+#include "BKE_customdata.h"
+#include "BKE_idprop.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLI_math_base.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
+#include "BLI_task.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+}
+
+#include "CLG_log.h"
+
+static CLG_LogRef LOG = {"io.usd"};
+
+namespace USD {
+
+USDStageReader::USDStageReader(pxr::UsdStageRefPtr stage, const USDImportParams &params)
+    : stage_(stage), params_(params)
+{
+  scale_m4_fl(root_matrix_, params_.scale * (float)pxr::UsdGeomGetStageMetersPerUnit(stage_));
+  if (pxr::UsdGeomGetStageUpAxis(stage_) == pxr::UsdGeomTokens->y) {
+    rotate_m4(root_matrix_, 'X', (float)M_PI_2);
+  }
+}
+
+USDStageReader::~USDStageReader()
+{
+  /* Geometry that never made it into Main, for example because the import was cancelled. */
+  for (USDPrimImport &prim_import : prims_) {
+    if (prim_import.mesh != NULL) {
+      BKE_id_free(NULL, prim_import.mesh);
+    }
+  }
+}
+
+const std::vector<USDPrimImport> &USDStageReader::prims() const
+{
+  return prims_;
+}
+
+int USDStageReader::invalid_meshes_count() const
+{
+  int count = 0;
+  for (const USDPrimImport &prim_import : prims_) {
+    if (prim_import.type == USDPrimImport::MESH && prim_import.mesh == NULL) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void USDStageReader::collect_prims()
+{
+  std::map<pxr::SdfPath, int> path_to_index;
+
+  /* Unlike the default predicate, this also visits prims whose payload is not loaded. */
+  pxr::UsdPrimRange range = stage_->Traverse(pxr::UsdPrimIsActive && pxr::UsdPrimIsDefined &&
+                                             !pxr::UsdPrimIsAbstract);
+
+  for (pxr::UsdPrimRange::iterator iter = range.begin(); iter != range.end(); ++iter) {
+    pxr::UsdPrim prim = *iter;
+
+    if (!prim.IsA<pxr::UsdGeomImageable>()) {
+      /* Materials, shaders and other prims that don't have a place in the scene. */
+      iter.PruneChildren();
+      continue;
+    }
+
+    USDPrimImport prim_import;
+    prim_import.prim = prim;
+    prim_import.mesh = NULL;
+    prim_import.object = NULL;
+    unit_m4(prim_import.local_matrix);
+
+    std::map<pxr::SdfPath, int>::const_iterator parent = path_to_index.find(
+        prim.GetParent().GetPath());
+    prim_import.parent_index = (parent == path_to_index.end()) ? -1 : parent->second;
+
+    if (!prim.IsLoaded()) {
+      /* The payload isn't composed, so there are no children to visit. */
+      prim_import.type = USDPrimImport::UNLOADED_PAYLOAD;
+      iter.PruneChildren();
+    }
+    else if (prim.IsA<pxr::UsdGeomMesh>()) {
+      /* Geometry subsets are not imported. */
+      prim_import.type = USDPrimImport::MESH;
+      iter.PruneChildren();
+    }
+    else {
+      prim_import.type = USDPrimImport::EMPTY;
+    }
+
+    path_to_index[prim.GetPath()] = (int)prims_.size();
+    prims_.push_back(prim_import);
+  }
+}
+
+struct ReadPrimsData {
+  const USDStageReader *reader;
+  std::vector<USDPrimImport> *prims;
+};
+
+static void read_prim_cb(void *__restrict userdata,
+                         const int index,
+                         const TaskParallelTLS *__restrict /*tls*/)
+{
+  ReadPrimsData *data = static_cast<ReadPrimsData *>(userdata);
+  data->reader->read_prim((*data->prims)[index]);
+}
+
+void USDStageReader::read_prims()
+{
+  /* Reading from a USD stage is thread-safe, and each prim is converted independently. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (prims_.size() > 1);
+  settings.min_iter_per_thread = 1;
+
+  ReadPrimsData data = {this, &prims_};
+  BLI_task_parallel_range(0, (int)prims_.size(), &data, read_prim_cb, &settings);
+}
+
+void USDStageReader::read_prim(USDPrimImport &prim_import) const
+{
+  if (prim_import.prim.IsA<pxr::UsdGeomXformable>()) {
+    pxr::UsdGeomXformable xformable(prim_import.prim);
+    pxr::GfMatrix4d matrix;
+    bool resets_xform_stack;
+
+    /* USD and Blender store matrices with the same memory layout. */
+    if (xformable.GetLocalTransformation(
+            &matrix, &resets_xform_stack, pxr::UsdTimeCode::EarliestTime())) {
+      for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+          prim_import.local_matrix[i][j] = (float)matrix[i][j];
+        }
+      }
+    }
+  }
+
+  if (prim_import.parent_index == -1) {
+    mul_m4_m4m4(prim_import.local_matrix, root_matrix_, prim_import.local_matrix);
+  }
+
+  switch (prim_import.type) {
+    case USDPrimImport::MESH:
+      read_mesh(prim_import);
+      break;
+    case USDPrimImport::UNLOADED_PAYLOAD:
+      read_payload_bounds(prim_import);
+      break;
+    case USDPrimImport::EMPTY:
+      break;
+  }
+}
+
+void USDStageReader::read_mesh(USDPrimImport &prim_import) const
+{
+  const pxr::UsdTimeCode time = pxr::UsdTimeCode::EarliestTime();
+  pxr::UsdGeomMesh mesh_prim(prim_import.prim);
+
+  pxr::VtVec3fArray points;
+  pxr::VtIntArray face_counts;
+  pxr::VtIntArray face_indices;
+  mesh_prim.GetPointsAttr().Get(&points, time);
+  mesh_prim.GetFaceVertexCountsAttr().Get(&face_counts, time);
+  mesh_prim.GetFaceVertexIndicesAttr().Get(&face_indices, time);
+
+  const int totvert = (int)points.size();
+  const int totpoly = (int)face_counts.size();
+
+  /* Check the topology before building anything from it. Meshes that fail are counted and
+   * reported by the import job, see #USDStageReader::invalid_meshes_count(). */
+  const std::string prim_path = prim_import.prim.GetPath().GetString();
+  size_t totloop = 0;
+  for (const int count : face_counts) {
+    if (count < 3) {
+      CLOG_WARN(&LOG, "mesh %s has faces with less than three vertices", prim_path.c_str());
+      return;
+    }
+    totloop += count;
+  }
+  if (totloop != face_indices.size()) {
+    CLOG_WARN(&LOG,
+              "mesh %s has face vertex counts that don't match its indices",
+              prim_path.c_str());
+    return;
+  }
+  for (const int index : face_indices) {
+    if (index < 0 || index >= totvert) {
+      CLOG_WARN(&LOG, "mesh %s has out of range vertex indices", prim_path.c_str());
+      return;
+    }
+  }
+
+  pxr::TfToken orientation;
+  mesh_prim.GetOrientationAttr().Get(&orientation);
+  const bool flip_faces = (orientation == pxr::UsdGeomTokens->leftHanded);
+
+  pxr::TfToken subdivision_scheme;
+  mesh_prim.GetSubdivisionSchemeAttr().Get(&subdivision_scheme);
+  const char poly_flag = (subdivision_scheme == pxr::UsdGeomTokens->none) ? 0 : ME_SMOOTH;
+
+  Mesh *mesh = BKE_mesh_new_nomain(totvert, 0, 0, (int)totloop, totpoly);
+
+  for (int i = 0; i < totvert; i++) {
+    copy_v3_v3(mesh->mvert[i].co, points[i].data());
+  }
+
+  int loopstart = 0;
+  for (int i = 0; i < totpoly; i++) {
+    const int count = face_counts[i];
+    MPoly &poly = mesh->mpoly[i];
+    poly.loopstart = loopstart;
+    poly.totloop = count;
+    poly.flag = poly_flag;
+
+    for (int j = 0; j < count; j++) {
+      const int index = flip_faces ? (count - 1 - j) : j;
+      mesh->mloop[loopstart + j].v = face_indices[loopstart + index];
+    }
+    loopstart += count;
+  }
+
+  BKE_mesh_calc_edges(mesh, false, false);
+  BKE_mesh_calc_normals(mesh);
+
+  prim_import.mesh = mesh;
+}
+
+void USDStageReader::read_payload_bounds(USDPrimImport &prim_import) const
+{
+  /* The extents hint should be authored next to the payload arc, so that it is available
+   * without loading the payload. The first pair of extents is for the default purpose. */
+  pxr::VtVec3fArray extents;
+  pxr::UsdGeomModelAPI model(prim_import.prim);
+  float min[3] = {-0.5f, -0.5f, -0.5f};
+  float max[3] = {0.5f, 0.5f, 0.5f};
+  if (model.GetExtentsHint(&extents, pxr::UsdTimeCode::EarliestTime()) && extents.size() >= 2) {
+    copy_v3_v3(min, extents[0].data());
+    copy_v3_v3(max, extents[1].data());
+  }
+
+  static const int faces[6][4] = {
+      {0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+
+  Mesh *mesh = BKE_mesh_new_nomain(8, 0, 0, 24, 6);
+
+  for (int i = 0; i < 8; i++) {
+    mesh->mvert[i].co[0] = (i & 1) ? max[0] : min[0];
+    mesh->mvert[i].co[1] = (i & 2) ? max[1] : min[1];
+    mesh->mvert[i].co[2] = (i & 4) ? max[2] : min[2];
+  }
+  for (int i = 0; i < 6; i++) {
+    mesh->mpoly[i].loopstart = i * 4;
+    mesh->mpoly[i].totloop = 4;
+    for (int j = 0; j < 4; j++) {
+      mesh->mloop[i * 4 + j].v = faces[i][j];
+    }
+  }
+
+  BKE_mesh_calc_edges(mesh, false, false);
+  BKE_mesh_calc_normals(mesh);
+
+  prim_import.mesh = mesh;
+}
+
+void USDStageReader::create_objects(Main *bmain)
+{
+  for (USDPrimImport &prim_import : prims_) {
+    const std::string name = prim_import.prim.GetName().GetString();
+    Object *ob;
+
+    if (prim_import.type == USDPrimImport::EMPTY) {
+      ob = BKE_object_add_only_object(bmain, OB_EMPTY, name.c_str());
+    }
+    else {
+      Mesh *mesh = BKE_mesh_add(bmain, name.c_str());
+      ob = BKE_object_add_only_object(bmain, OB_MESH, name.c_str());
+      ob->data = mesh;
+
+      if (prim_import.mesh != NULL) {
+        BKE_mesh_nomain_to_mesh(prim_import.mesh, mesh, ob, &CD_MASK_MESH, true);
+        prim_import.mesh = NULL;
+      }
+    }
+
+    if (prim_import.type == USDPrimImport::UNLOADED_PAYLOAD) {
+      /* Only a stand-in for the asset, re-import with payloads loaded to get the real thing. */
+      ob->dt = OB_BOUNDBOX;
+      ob->restrictflag |= OB_RESTRICT_RENDER;
+
+      IDProperty *props = IDP_GetProperties(&ob->id, true);
+      IDP_AddToGroup(props,
+                     IDP_NewString(prim_import.prim.GetPath().GetText(), "usd_prim_path", 0));
+    }
+
+    BKE_object_apply_mat4(ob, prim_import.local_matrix, false, false);
+    prim_import.object = ob;
+  }
+
+  for (USDPrimImport &prim_import : prims_) {
+    if (prim_import.parent_index != -1) {
+      prim_import.object->parent = prims_[prim_import.parent_index].object;
+    }
+  }
+}
+
+}  // namespace USD
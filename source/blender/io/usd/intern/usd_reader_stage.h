@@ -0,0 +1,97 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+#ifndef __USD_READER_STAGE_H__
+#define __USD_READER_STAGE_H__
+
+#include "usd.h"
+
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <vector>
+
+struct Main;
+struct Mesh;
+struct Object;
+
+namespace USD {
+
+/* Everything needed to create one Blender object from a USD prim. The prim data is read into
+ * this struct from worker threads; the Blender object is created afterwards from a single
+ * thread, as adding data-blocks to Main is not thread-safe. */
+struct USDPrimImport {
+  enum Type {
+    /* Xform, Scope and any prim type that isn't converted; becomes an Empty. */
+    EMPTY,
+    MESH,
+    /* A prim whose payload was not loaded; becomes a box showing its extents hint. */
+    UNLOADED_PAYLOAD,
+  };
+
+  pxr::UsdPrim prim;
+  Type type;
+  /* Index of the parent's USDPrimImport, or -1 for prims at the root of the stage. */
+  int parent_index;
+
+  float local_matrix[4][4];
+  /* Geometry that isn't in Main yet, NULL for empties and for meshes that failed to read. */
+  Mesh *mesh;
+
+  Object *object;
+};
+
+class USDStageReader {
+ private:
+  pxr::UsdStageRefPtr stage_;
+  USDImportParams params_;
+  std::vector<USDPrimImport> prims_;
+
+  /* Converts the stage's up-axis and unit scale to Blender's, applied to prims at the root. */
+  float root_matrix_[4][4];
+
+ public:
+  USDStageReader(pxr::UsdStageRefPtr stage, const USDImportParams &params);
+  ~USDStageReader();
+
+  /* Traverse the stage and collect the prims to prim_import. Payloads that were not loaded when
+   * opening the stage are collected as well, but their (unavailable) children are not. */
+  void collect_prims();
+
+  /* Read transforms and geometry of all collected prims, in parallel. */
+  void read_prims();
+
+  /* Create the Blender objects and set up their parenting. */
+  void create_objects(Main *bmain);
+
+  /* Read a single prim. Only reads from the stage, so it can be called from any thread. */
+  void read_prim(USDPrimImport &prim_import) const;
+
+  const std::vector<USDPrimImport> &prims() const;
+
+  /* Number of meshes that could not be read, call after read_prims(). */
+  int invalid_meshes_count() const;
+
+ private:
+  void read_mesh(USDPrimImport &prim_import) const;
+  void read_payload_bounds(USDPrimImport &prim_import) const;
+};
+
+}  // namespace USD
+
+#endif /* __USD_READER_STAGE_H__ */
@@ -85,6 +85,20 @@ void USDAbstractWriter::write(HierarchyContext &context)
   frame_has_been_written_ = true;
 }
 
+void USDAbstractWriter::prepare(const HierarchyContext &context)
+{
+  if (frame_has_been_written_ && !is_animated_) {
+    /* write() will skip this frame, so there is nothing to prepare. */
+    return;
+  }
+
+  do_prepare(context);
+}
+
+void USDAbstractWriter::do_prepare(const HierarchyContext & /*context*/)
+{
+}
+
 bool USDAbstractWriter::check_is_animated(const HierarchyContext &context) const
 {
   const Object *object = context.object;
@@ -52,6 +52,7 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
   virtual ~USDAbstractWriter();
 
   virtual void write(HierarchyContext &context) override;
+  virtual void prepare(const HierarchyContext &context) override;
 
   /* Returns true if the data to be written is actually supported. This would, for example, allow a
    * hypothetical camera writer accept a perspective camera but reject an orthogonal one.
@@ -66,6 +67,8 @@ class USDAbstractWriter : public AbstractHierarchyWriter {
 
  protected:
   virtual void do_write(HierarchyContext &context) = 0;
+  /* Only called for frames that do_write() will be called for. */
+  virtual void do_prepare(const HierarchyContext &context);
   virtual bool check_is_animated(const HierarchyContext &context) const;
   pxr::UsdTimeCode get_export_time_code() const;
 
@@ -47,8 +47,39 @@ extern "C" {
 
 namespace USD {
 
-USDGenericMeshWriter::USDGenericMeshWriter(const USDExporterContext &ctx) : USDAbstractWriter(ctx)
+struct USDMeshData {
+  pxr::VtArray<pxr::GfVec3f> points;
+  pxr::VtIntArray face_vertex_counts;
+  pxr::VtIntArray face_indices;
+  std::map<short, pxr::VtIntArray> face_groups;
+
+  /* The length of this array specifies the number of creases on the surface. Each element gives
+   * the number of (must be adjacent) vertices in each crease, whose indices are linearly laid out
+   * in the 'creaseIndices' attribute. Since each crease must be at least one edge long, each
+   * element of this array should be greater than one. */
+  pxr::VtIntArray crease_lengths;
+  /* The indices of all vertices forming creased edges. The size of this array must be equal to the
+   * sum of all elements of the 'creaseLengths' attribute. */
+  pxr::VtIntArray crease_vertex_indices;
+  /* The per-crease or per-edge sharpness for all creases (Usd.Mesh.SHARPNESS_INFINITE for a
+   * perfectly sharp crease). Since 'creaseLengths' encodes the number of vertices in each crease,
+   * the number of elements in this array will be either len(creaseLengths) or the sum over all X
+   * of (creaseLengths[X] - 1). Note that while the RI spec allows each crease to have either a
+   * single sharpness or a value per-edge, USD will encode either a single sharpness per crease on
+   * a mesh, or sharpnesses for all edges making up the creases on a mesh. */
+  pxr::VtFloatArray crease_sharpnesses;
+};
+
+USDGenericMeshWriter::USDGenericMeshWriter(const USDExporterContext &ctx)
+    : USDAbstractWriter(ctx), prepared_mesh_(nullptr), prepared_mesh_needsfree_(false)
+{
+}
+
+USDGenericMeshWriter::~USDGenericMeshWriter()
 {
+  if (prepared_mesh_ != nullptr && prepared_mesh_needsfree_) {
+    free_export_mesh(prepared_mesh_);
+  }
 }
 
 bool USDGenericMeshWriter::is_supported(const HierarchyContext *context) const
@@ -76,11 +107,37 @@ bool USDGenericMeshWriter::is_supported(const HierarchyContext *context) const
   return (visibility & OB_VISIBLE_SELF) != 0;
 }
 
+void USDGenericMeshWriter::do_prepare(const HierarchyContext &context)
+{
+  if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
+    /* Instances only reference the original, there is no geometry to convert. */
+    return;
+  }
+
+  prepared_mesh_needsfree_ = false;
+  prepared_mesh_ = get_export_mesh(context.object, prepared_mesh_needsfree_);
+  if (prepared_mesh_ == nullptr) {
+    return;
+  }
+
+  prepared_data_.reset(new USDMeshData());
+  get_geometry_data(prepared_mesh_, *prepared_data_);
+}
+
 void USDGenericMeshWriter::do_write(HierarchyContext &context)
 {
   Object *object_eval = context.object;
   bool needsfree = false;
-  Mesh *mesh = get_export_mesh(object_eval, needsfree);
+  Mesh *mesh;
+
+  if (prepared_mesh_ != nullptr) {
+    mesh = prepared_mesh_;
+    needsfree = prepared_mesh_needsfree_;
+    prepared_mesh_ = nullptr;
+  }
+  else {
+    mesh = get_export_mesh(object_eval, needsfree);
+  }
 
   if (mesh == NULL) {
     return;
@@ -106,28 +163,6 @@ void USDGenericMeshWriter::free_export_mesh(Mesh *mesh)
   BKE_id_free(NULL, mesh);
 }
 
-struct USDMeshData {
-  pxr::VtArray<pxr::GfVec3f> points;
-  pxr::VtIntArray face_vertex_counts;
-  pxr::VtIntArray face_indices;
-  std::map<short, pxr::VtIntArray> face_groups;
-
-  /* The length of this array specifies the number of creases on the surface. Each element gives
-   * the number of (must be adjacent) vertices in each crease, whose indices are linearly laid out
-   * in the 'creaseIndices' attribute. Since each crease must be at least one edge long, each
-   * element of this array should be greater than one. */
-  pxr::VtIntArray crease_lengths;
-  /* The indices of all vertices forming creased edges. The size of this array must be equal to the
-   * sum of all elements of the 'creaseLengths' attribute. */
-  pxr::VtIntArray crease_vertex_indices;
-  /* The per-crease or per-edge sharpness for all creases (Usd.Mesh.SHARPNESS_INFINITE for a
-   * perfectly sharp crease). Since 'creaseLengths' encodes the number of vertices in each crease,
-   * the number of elements in this array will be either len(creaseLengths) or the sum over all X
-   * of (creaseLengths[X] - 1). Note that while the RI spec allows each crease to have either a
-   * single sharpness or a value per-edge, USD will encode either a single sharpness per crease on
-   * a mesh, or sharpnesses for all edges making up the creases on a mesh. */
-  pxr::VtFloatArray crease_sharpnesses;
-};
 
 void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
 {
@@ -170,8 +205,6 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   const pxr::SdfPath &usd_path = usd_export_context_.usd_path;
 
   pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
-  USDMeshData usd_mesh_data;
-  get_geometry_data(mesh, usd_mesh_data);
 
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     // This object data is instanced, just reference the original instead of writing a copy.
@@ -195,11 +228,21 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
     of its own subtree. It does work when we override the material with exactly the same path,
     though.*/
     if (usd_export_context_.export_params.export_materials) {
-      assign_materials(context, usd_mesh, usd_mesh_data.face_groups);
+      MaterialFaceGroups face_groups;
+      get_face_groups(mesh, face_groups);
+      assign_materials(context, usd_mesh, face_groups);
     }
     return;
   }
 
+  /* Use the geometry converted by do_prepare() when available. */
+  std::unique_ptr<USDMeshData> usd_mesh_data_ptr = std::move(prepared_data_);
+  if (!usd_mesh_data_ptr) {
+    usd_mesh_data_ptr.reset(new USDMeshData());
+    get_geometry_data(mesh, *usd_mesh_data_ptr);
+  }
+  const USDMeshData &usd_mesh_data = *usd_mesh_data_ptr;
+
   pxr::UsdAttribute attr_points = usd_mesh.CreatePointsAttr(pxr::VtValue(), true);
   pxr::UsdAttribute attr_face_vertex_counts = usd_mesh.CreateFaceVertexCountsAttr(pxr::VtValue(),
                                                                                   true);
@@ -272,10 +315,6 @@ static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 
 static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
-   * assignments. */
-  bool construct_face_groups = mesh->totcol > 1;
-
   usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
   usd_mesh_data.face_indices.reserve(mesh->totloop);
 
@@ -287,10 +326,6 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
     for (int j = 0; j < mpoly->totloop; ++j, ++loop) {
       usd_mesh_data.face_indices.push_back(loop->v);
     }
-
-    if (construct_face_groups) {
-      usd_mesh_data.face_groups[mpoly->mat_nr].push_back(i);
-    }
   }
 }
 
@@ -319,11 +354,26 @@ static void get_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
   }
 }
 
+void USDGenericMeshWriter::get_face_groups(const Mesh *mesh, MaterialFaceGroups &r_face_groups)
+{
+  /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
+   * assignments. */
+  if (mesh->totcol < 2) {
+    return;
+  }
+
+  const MPoly *mpoly = mesh->mpoly;
+  for (int i = 0; i < mesh->totpoly; ++i, ++mpoly) {
+    r_face_groups[mpoly->mat_nr].push_back(i);
+  }
+}
+
 void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
   get_vertices(mesh, usd_mesh_data);
   get_loops_polys(mesh, usd_mesh_data);
   get_creases(mesh, usd_mesh_data);
+  get_face_groups(mesh, usd_mesh_data.face_groups);
 }
 
 void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
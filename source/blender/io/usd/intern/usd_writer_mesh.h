@@ -23,17 +23,27 @@
 
 #include <pxr/usd/usdGeom/mesh.h>
 
+#include <memory>
+
 namespace USD {
 
 struct USDMeshData;
 
 /* Writer for USD geometry. Does not assume the object is a mesh object. */
 class USDGenericMeshWriter : public USDAbstractWriter {
+ private:
+  /* Mesh and geometry converted by do_prepare(), consumed by the next do_write(). */
+  Mesh *prepared_mesh_;
+  bool prepared_mesh_needsfree_;
+  std::unique_ptr<USDMeshData> prepared_data_;
+
  public:
   USDGenericMeshWriter(const USDExporterContext &ctx);
+  virtual ~USDGenericMeshWriter();
 
  protected:
   virtual bool is_supported(const HierarchyContext *context) const override;
+  virtual void do_prepare(const HierarchyContext &context) override;
   virtual void do_write(HierarchyContext &context) override;
 
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) = 0;
@@ -45,6 +55,7 @@ class USDGenericMeshWriter : public USDAbstractWriter {
 
   void write_mesh(HierarchyContext &context, Mesh *mesh);
   void get_geometry_data(const Mesh *mesh, struct USDMeshData &usd_mesh_data);
+  static void get_face_groups(const Mesh *mesh, MaterialFaceGroups &r_face_groups);
   void assign_materials(const HierarchyContext &context,
                         pxr::UsdGeomMesh usd_mesh,
                         const MaterialFaceGroups &usd_face_groups);
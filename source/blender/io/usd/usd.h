@@ -40,6 +40,12 @@ struct USDExportParams {
   enum eEvaluationMode evaluation_mode;
 };
 
+struct USDImportParams {
+  float scale;
+  /* When false, payloads are left unloaded and shown as bounding boxes. */
+  bool load_payloads;
+};
+
 /* The USD_export takes a as_background_job parameter, and returns a boolean.
  *
  * When as_background_job=true, returns false immediately after scheduling
@@ -54,6 +60,12 @@ bool USD_export(struct bContext *C,
                 const struct USDExportParams *params,
                 bool as_background_job);
 
+/* Same as USD_export, but importing the stage at the given path into the active collection. */
+bool USD_import(struct bContext *C,
+                const char *filepath,
+                const struct USDImportParams *params,
+                bool as_background_job);
+
 int USD_get_version(void);
 
 #ifdef __cplusplus
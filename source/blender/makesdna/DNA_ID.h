@@ -547,6 +547,13 @@ enum {
   /* Datablock was not allocated by standard system (BKE_libblock_alloc), do not free its memory
    * (usual type-specific freeing is called though). */
   LIB_TAG_NOT_ALLOCATED = 1 << 18,
+
+  /* RESET_AFTER_USE Data-block was tagged for update since the last global undo push, so it may
+   * differ from its state stored in the undo memfile. */
+  LIB_TAG_UNDO_CHANGED = 1 << 19,
+  /* RESET_AFTER_USE Data-block was kept from the old Main when reading an undo memfile, since it
+   * did not change between the current and the restored undo steps. */
+  LIB_TAG_UNDO_OLD_ID_REUSED = 1 << 20,
 };
 
 /* Tag given ID for an update in all the dependency graphs. */
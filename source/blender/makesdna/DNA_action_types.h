@@ -201,6 +201,15 @@ typedef struct bPoseChannel_Runtime {
   /* Delta from rest to pose in matrix and DualQuat form. */
   struct Mat4 *bbone_deform_mats;
   struct DualQuat *bbone_dual_quats;
+
+  /* Pose and rest matrices the deformation matrices were last computed from, and the resulting
+   * deformation matrix. Allows to skip recomputing them for bones which didn't move. */
+  float deform_cache_pose_mat[4][4];
+  float deform_cache_arm_mat[4][4];
+  float deform_cache_chan_mat[4][4];
+  /* 0: cache is invalid, 1: matrices are valid, 2: dual quaternion is valid as well. */
+  int deform_cache_valid;
+  char _pad[4];
 } bPoseChannel_Runtime;
 
 /* ************************************************ */
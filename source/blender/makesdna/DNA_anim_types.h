@@ -591,7 +591,9 @@ typedef struct FCurve {
   /* value cache + settings */
   /** Value stored from last time curve was evaluated (not threadsafe, debug display only!). */
   float curval;
-  char _pad2[4];
+  /** Keyframe ending the segment found by the last evaluation (not threadsafe, only used as a
+   * hint that is validated before use, so playback can skip the keyframe search). */
+  int segment_hint;
   /** User-editable settings for this curve. */
   short flag;
   /** Value-extending mode for this curve (does not cover). */
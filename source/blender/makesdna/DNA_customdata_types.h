@@ -54,6 +54,11 @@ typedef struct CustomDataLayer {
   char name[64];
   /** Layer data. */
   void *data;
+  /**
+   * Run-time only: users counter of the data when it is shared between several layers,
+   * for example between an original and a copied-on-write mesh. Shared data is read-only.
+   */
+  struct CustomDataSharing *sharing;
 } CustomDataLayer;
 
 #define MAX_CUSTOMDATA_LAYER_NAME 64
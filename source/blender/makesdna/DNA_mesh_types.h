@@ -88,7 +88,8 @@ typedef struct Mesh_Runtime {
   void *batch_cache;
 
   struct SubdivCCG *subdiv_ccg;
-  void *_pad1;
+  /** Adjacency maps and islands, see #BKE_mesh_runtime_topology_map_ensure. */
+  struct MeshTopologyCache *topology_cache;
   int subdiv_ccg_tot_level;
   char _pad2[4];
 
@@ -112,7 +113,11 @@ typedef struct Mesh_Runtime {
    * In the future we may leave the mesh-data empty
    * since its not needed if we can use edit-mesh data. */
   char is_original;
-  char _pad[6];
+  /**
+   * The batch cache was moved over from the previous evaluated mesh and only the vertex
+   * coordinates changed, cleared once the batch cache has been tagged dirty. */
+  char is_deform_update;
+  char _pad[5];
 } Mesh_Runtime;
 
 typedef struct Mesh {
@@ -1975,13 +1975,20 @@ typedef struct MeshSeqCacheModifierData {
   char object_path[1024];
 
   char read_flag;
-  char _pad[7];
+  char flag;
+  char _pad[6];
 
   /* Runtime. */
   struct CacheReader *reader;
   char reader_object_path[1024];
 } MeshSeqCacheModifierData;
 
+/* MeshSeqCacheModifierData.flag */
+enum {
+  /** Only read the bounds of the cached geometry outside of final renders. */
+  MOD_MESHSEQ_VIEWPORT_BOUNDS = (1 << 0),
+};
+
 /* MeshSeqCacheModifierData.read_flag */
 enum {
   MOD_MESHSEQ_READ_VERT = (1 << 0),
@@ -443,7 +443,8 @@ typedef struct bNodeTree {
   short is_updating;
   /** Generic temporary flag for recursion check (DFS/BFS). */
   short done;
-  char _pad2[4];
+  /** Memory limit in megabytes for caching compositor results between executions. */
+  int cache_limit;
 
   /** Specific node type this tree is used for. */
   int nodetype DNA_DEPRECATED;
@@ -512,6 +513,7 @@ typedef struct bNodeTree {
 
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
+#define NTREE_COM_FULL_FRAME (1 << 6) /* execute whole frames instead of tiles */
 
 /* ntree->update */
 typedef enum eNodeTreeUpdate {
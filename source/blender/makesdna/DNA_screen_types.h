@@ -681,6 +681,9 @@ enum {
 
   /* Only editor overlays (currently gizmos only!) should be redrawn. */
   RGN_DRAW_EDITOR_OVERLAYS = 32,
+  /* Only the state of buttons changed (e.g. highlight on mouse hover), redraw the existing
+   * UI blocks without rebuilding the layout. */
+  RGN_DRAW_NO_LAYOUT = 64,
 };
 
 #endif /* __DNA_SCREEN_TYPES_H__ */
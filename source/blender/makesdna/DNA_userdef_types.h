@@ -871,6 +871,15 @@ typedef struct UserDef {
 
   UserDef_Experimental experimental;
 
+  /** Root of the sequencer disk cache, 1024 = FILE_MAX. */
+  char sequencer_disk_cache_dir[1024];
+  /** Sequencer disk cache size limit in gigabytes. */
+  int sequencer_disk_cache_size_limit;
+  /** #eUserpref_SeqDiskCacheCompression. */
+  short sequencer_disk_cache_compression;
+  /** #eUserpref_VideoFlag. */
+  short video_flag;
+
   /** Runtime data (keep last). */
   UserDef_Runtime runtime;
 } UserDef;
@@ -1282,6 +1291,18 @@ typedef enum eUserpref_EmulateMMBMod {
   USER_EMU_MMB_MOD_OSKEY = 1,
 } eUserpref_EmulateMMBMod;
 
+/** #UserDef.sequencer_disk_cache_compression */
+typedef enum eUserpref_SeqDiskCacheCompression {
+  USER_SEQ_DISK_CACHE_COMPRESSION_NONE = 0,
+  USER_SEQ_DISK_CACHE_COMPRESSION_LOW = 1,
+  USER_SEQ_DISK_CACHE_COMPRESSION_HIGH = 2,
+} eUserpref_SeqDiskCacheCompression;
+
+/** #UserDef.video_flag */
+typedef enum eUserpref_VideoFlag {
+  USER_VIDEO_HW_DECODE = (1 << 0),
+} eUserpref_VideoFlag;
+
 #ifdef __cplusplus
 }
 #endif
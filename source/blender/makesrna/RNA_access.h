@@ -919,6 +919,10 @@ bool RNA_property_comparable(PointerRNA *ptr, PropertyRNA *prop);
 bool RNA_property_path_from_ID_check(PointerRNA *ptr, PropertyRNA *prop); /* slow, use with care */
 
 void RNA_property_update(struct bContext *C, PointerRNA *ptr, PropertyRNA *prop);
+void RNA_property_update_batch(struct bContext *C,
+                               PointerRNA *ptrs,
+                               PropertyRNA **props,
+                               const int len);
 void RNA_property_update_main(struct Main *bmain,
                               struct Scene *scene,
                               PointerRNA *ptr,
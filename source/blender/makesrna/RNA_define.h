@@ -54,6 +54,8 @@ void RNA_define_fallback_property_update(int noteflag, const char *updatefunc);
 void RNA_init(void);
 void RNA_exit(void);
 
+unsigned int RNA_define_generation(void);
+
 /* Struct */
 
 StructRNA *RNA_def_struct_ptr(BlenderRNA *brna, const char *identifier, StructRNA *srnafrom);
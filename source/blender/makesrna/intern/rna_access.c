@@ -2213,8 +2213,16 @@ bool RNA_property_path_from_ID_check(PointerRNA *ptr, PropertyRNA *prop)
   return ret;
 }
 
-static void rna_property_update(
-    bContext *C, Main *bmain, Scene *scene, PointerRNA *ptr, PropertyRNA *prop)
+/**
+ * \param use_owner_notifiers: Send notifiers referencing the owner ID,
+ * when false they're sent without reference, so they can be shared by many updated IDs.
+ */
+static void rna_property_update_ex(bContext *C,
+                                   Main *bmain,
+                                   Scene *scene,
+                                   PointerRNA *ptr,
+                                   PropertyRNA *prop,
+                                   const bool use_owner_notifiers)
 {
   const bool is_rna = (prop->magic == RNA_MAGIC);
   prop = rna_ensure_property(prop);
@@ -2242,7 +2250,7 @@ static void rna_property_update(
     /* TODO(campbell): Should eventually be replaced entirely by message bus (below)
      * for now keep since COW, bugs are hard to track when we have other missing updates. */
     if (prop->noteflag) {
-      WM_main_add_notifier(prop->noteflag, ptr->owner_id);
+      WM_main_add_notifier(prop->noteflag, use_owner_notifiers ? ptr->owner_id : NULL);
     }
 #endif
 
@@ -2290,6 +2298,12 @@ static void rna_property_update(
   }
 }
 
+static void rna_property_update(
+    bContext *C, Main *bmain, Scene *scene, PointerRNA *ptr, PropertyRNA *prop)
+{
+  rna_property_update_ex(C, bmain, scene, ptr, prop, true);
+}
+
 /* must keep in sync with 'rna_property_update'
  * note, its possible this returns a false positive in the case of PROP_CONTEXT_UPDATE
  * but this isn't likely to be a performance problem. */
@@ -2308,6 +2322,23 @@ void RNA_property_update_main(Main *bmain, Scene *scene, PointerRNA *ptr, Proper
   rna_property_update(NULL, bmain, scene, ptr, prop);
 }
 
+/**
+ * Same as calling #RNA_property_update for each of the \a ptrs & \a props pairs,
+ * but notifiers are shared by all of them instead of referencing each owner ID.
+ * This avoids a quadratic cost for queuing notifiers when many IDs are edited at once.
+ */
+void RNA_property_update_batch(bContext *C, PointerRNA *ptrs, PropertyRNA **props, const int len)
+{
+  Main *bmain = CTX_data_main(C);
+  Scene *scene = CTX_data_scene(C);
+
+  for (int i = 0; i < len; i++) {
+    if (RNA_property_update_check(props[i])) {
+      rna_property_update_ex(C, bmain, scene, &ptrs[i], props[i], false);
+    }
+  }
+}
+
 /* RNA Updates Cache ------------------------ */
 /* Overview of RNA Update cache system:
  *
@@ -4529,6 +4560,17 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        /* Items are tightly packed, copy them all at once. */
+        if (out.stride == size) {
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
@@ -63,6 +63,19 @@ static CLG_LogRef LOG = {"rna.define"};
 
 BlenderDefRNA DefRNA = {NULL, {NULL, NULL}, {NULL, NULL}, NULL, 0, 0, 0, 1, 1};
 
+/* Incremented whenever structs or properties are added or removed, see RNA_define_generation. */
+static unsigned int rna_define_generation = 0;
+
+/**
+ * Counter which changes whenever struct or property definitions are added or removed
+ * (at runtime this happens when registering classes and defining properties from Python).
+ * Lookups cached outside of RNA are invalid once it changes.
+ */
+unsigned int RNA_define_generation(void)
+{
+  return rna_define_generation;
+}
+
 #ifndef RNA_RUNTIME
 static struct {
   GHash *struct_map_static_from_alias;
@@ -782,6 +795,8 @@ void RNA_struct_free(BlenderRNA *brna, StructRNA *srna)
   PropertyRNA *prop, *nextprop;
   PropertyRNA *parm, *nextparm;
 
+  rna_define_generation++;
+
 #  if 0
   if (srna->flag & STRUCT_RUNTIME) {
     if (RNA_struct_py_type_get(srna)) {
@@ -1265,6 +1280,8 @@ PropertyRNA *RNA_def_property(StructOrFunctionRNA *cont_,
   PropertyDefRNA *dprop = NULL;
   PropertyRNA *prop;
 
+  rna_define_generation++;
+
   if (DefRNA.preprocess) {
     char error[512];
 
@@ -4626,6 +4643,8 @@ static void rna_def_property_free(StructOrFunctionRNA *cont_, PropertyRNA *prop)
 {
   ContainerRNA *cont = cont_;
 
+  rna_define_generation++;
+
   if (prop->flag_internal & PROP_INTERN_RUNTIME) {
     if (cont->prophash) {
       BLI_ghash_remove(cont->prophash, prop->identifier, NULL, NULL);
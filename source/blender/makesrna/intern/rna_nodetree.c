@@ -9437,6 +9437,22 @@ static void rna_def_composite_nodetree(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Viewer Border", "Use boundaries for viewer nodes and composite backdrop");
   RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_NodeTree_update");
+
+  prop = RNA_def_property(srna, "use_full_frame", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_FULL_FRAME);
+  RNA_def_property_ui_text(prop,
+                           "Full Frame",
+                           "Execute each operation over the whole image instead of in tiles, "
+                           "recycling intermediate buffers once they are no longer needed");
+
+  prop = RNA_def_property(srna, "cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "cache_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 16384, 128, -1);
+  RNA_def_property_ui_text(prop,
+                           "Cache Limit",
+                           "Memory in megabytes used to keep intermediate results between "
+                           "executions, so unchanged branches are not recomputed (0 to disable)");
 }
 
 static void rna_def_shader_nodetree(BlenderRNA *brna)
@@ -6001,6 +6001,16 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
       "(saves memory, required for Full Sample)");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
 
+  prop = RNA_def_property(srna, "use_save_buffers_half_float", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "scemode", R_EXR_TILE_HALF);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Half Float Buffers",
+                           "Store color passes in the saved buffers as half float, halving their "
+                           "size on disk. Compositing then uses the reduced precision, and values "
+                           "above 65504 become infinite");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
   prop = RNA_def_property(srna, "use_full_sample", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "scemode", R_FULL_SAMPLE);
   RNA_def_property_ui_text(prop,
@@ -6401,7 +6411,10 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
   prop = RNA_def_property(srna, "use_persistent_data", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "mode", R_PERSISTENT_DATA);
   RNA_def_property_ui_text(
-      prop, "Persistent Data", "Keep render data around for faster re-renders");
+      prop,
+      "Persistent Data",
+      "Keep render data around for faster re-renders and animation renders, at the cost of "
+      "increased memory usage");
   RNA_def_property_update(prop, 0, "rna_Scene_use_persistent_data_update");
 
   /* Freestyle line thickness options */
@@ -171,19 +171,24 @@ static const EnumPropertyItem rna_enum_userdef_viewport_aa_items[] = {
 
 #ifdef RNA_RUNTIME
 
+#  include "BLI_listbase.h"
 #  include "BLI_math_vector.h"
 
+#  include "DNA_movieclip_types.h"
 #  include "DNA_object_types.h"
 #  include "DNA_screen_types.h"
+#  include "DNA_sequence_types.h"
 
 #  include "BKE_blender.h"
 #  include "BKE_global.h"
 #  include "BKE_idprop.h"
 #  include "BKE_main.h"
 #  include "BKE_mesh_runtime.h"
+#  include "BKE_movieclip.h"
 #  include "BKE_pbvh.h"
 #  include "BKE_paint.h"
 #  include "BKE_screen.h"
+#  include "BKE_sequencer.h"
 
 #  include "DEG_depsgraph.h"
 
@@ -536,6 +541,24 @@ static void rna_Userdef_memcache_update(Main *UNUSED(bmain),
   USERDEF_TAG_DIRTY;
 }
 
+/* Reopen movies so they are decoded with the new setting. */
+static void rna_Userdef_video_decode_update(Main *bmain,
+                                            Scene *UNUSED(scene),
+                                            PointerRNA *UNUSED(ptr))
+{
+  LISTBASE_FOREACH (Scene *, scene, &bmain->scenes) {
+    if (scene->ed) {
+      BKE_sequencer_free_imbuf(scene, &scene->ed->seqbase, false);
+    }
+  }
+  LISTBASE_FOREACH (MovieClip *, clip, &bmain->movieclips) {
+    BKE_movieclip_reload(bmain, clip);
+  }
+  WM_main_add_notifier(NC_SCENE | ND_SEQUENCER, NULL);
+  WM_main_add_notifier(NC_MOVIECLIP | NA_EDITED, NULL);
+  USERDEF_TAG_DIRTY;
+}
+
 static void rna_UserDef_weight_color_update(Main *bmain, Scene *scene, PointerRNA *ptr)
 {
   Object *ob;
@@ -5082,12 +5105,19 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       {0, NULL, 0, NULL, NULL},
   };
 
+  static const EnumPropertyItem seq_disk_cache_compression_levels[] = {
+      {USER_SEQ_DISK_CACHE_COMPRESSION_NONE, "NONE", 0, "None", "Store frames uncompressed"},
+      {USER_SEQ_DISK_CACHE_COMPRESSION_LOW, "LOW", 0, "Low", "Fastest compression"},
+      {USER_SEQ_DISK_CACHE_COMPRESSION_HIGH, "HIGH", 0, "High", "Smaller files, slower to write"},
+      {0, NULL, 0, NULL, NULL},
+  };
+
   static const EnumPropertyItem image_draw_methods[] = {
       {IMAGE_DRAW_METHOD_AUTO,
        "AUTO",
        0,
        "Automatic",
-       "Automatically choose method based on GPU and image"},
+       "Automatically choose method based on GPU and image, float images always use GLSL"},
       {IMAGE_DRAW_METHOD_2DTEXTURE,
        "2DTEXTURE",
        0,
@@ -5143,6 +5173,28 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Memory Cache Limit", "Memory cache limit (in megabytes)");
   RNA_def_property_update(prop, 0, "rna_Userdef_memcache_update");
 
+  prop = RNA_def_property(srna, "sequencer_disk_cache_size_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "sequencer_disk_cache_size_limit");
+  RNA_def_property_range(prop, 1, INT_MAX);
+  RNA_def_property_ui_text(
+      prop, "Disk Cache Limit", "Sequencer disk cache size limit (in gigabytes)");
+
+  prop = RNA_def_property(srna, "sequencer_disk_cache_compression", PROP_ENUM, PROP_NONE);
+  RNA_def_property_enum_sdna(prop, NULL, "sequencer_disk_cache_compression");
+  RNA_def_property_enum_items(prop, seq_disk_cache_compression_levels);
+  RNA_def_property_ui_text(prop,
+                           "Disk Cache Compression",
+                           "Compression of frames stored in the sequencer disk cache, "
+                           "higher levels save space at the cost of speed");
+
+  prop = RNA_def_property(srna, "use_hardware_video_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "video_flag", USER_VIDEO_HW_DECODE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Video Decoding",
+                           "Decode movies on the GPU when a hardware decoder is available "
+                           "(NVDEC, VA-API, VideoToolbox or Direct3D)");
+  RNA_def_property_update(prop, 0, "rna_Userdef_video_decode_update");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, NULL, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -5855,6 +5907,12 @@ static void rna_def_userdef_filepaths(BlenderRNA *brna)
   RNA_def_property_string_sdna(prop, NULL, "render_cachedir");
   RNA_def_property_ui_text(prop, "Render Cache Path", "Where to cache raw render results");
 
+  prop = RNA_def_property(srna, "sequencer_disk_cache_directory", PROP_STRING, PROP_DIRPATH);
+  RNA_def_property_string_sdna(prop, NULL, "sequencer_disk_cache_dir");
+  RNA_def_property_ui_text(prop,
+                           "Sequencer Disk Cache Path",
+                           "Where to store final sequencer frames evicted from the memory cache");
+
   prop = RNA_def_property(srna, "image_editor", PROP_STRING, PROP_FILEPATH);
   RNA_def_property_string_sdna(prop, NULL, "image_editor");
   RNA_def_property_ui_text(prop, "Image Editor", "Path to an image editor");
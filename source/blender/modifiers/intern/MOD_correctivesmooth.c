@@ -26,6 +26,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_scene_types.h"
 #include "DNA_meshdata_types.h"
@@ -36,6 +37,8 @@
 
 #include "BKE_deform.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
+#include "BKE_mesh_runtime.h"
 #include "BKE_editmesh.h"
 #include "BKE_lib_id.h"
 
@@ -169,11 +172,102 @@ static void mesh_get_boundaries(Mesh *mesh, float *smooth_weights)
   MEM_freeN(boundaries);
 }
 
+/* -------------------------------------------------------------------- */
+/* Smoothing Iteration Data
+ *
+ * Each iteration gathers the edge deltas per vertex (using a vertex-edge map, so vertices
+ * can be handled in parallel), then applies them once all vertices have been gathered.
+ * Edges are visited in the same order as a serial loop over all edges would,
+ * so the result doesn't depend on threading.
+ */
+
+struct SmoothingData_Simple {
+  float delta[3];
+};
+
+struct SmoothingData_Weighted {
+  float delta[3];
+  float edge_length_sum;
+};
+
+typedef struct SmoothIterData {
+  const MEdge *edges;
+  const MeshElemMap *vert_edges;
+  float (*vertexCos)[3];
+  const float *smooth_weights;
+  /** #SmoothingData_Simple or #SmoothingData_Weighted, depending on the smoothing type. */
+  void *smooth_data;
+  /** Per vertex factor (simple) or edge count (length weight). */
+  const float *vertex_edge_factor;
+  float lambda;
+} SmoothIterData;
+
+static void smooth_iter_data_init(SmoothIterData *data,
+                                  Mesh *mesh,
+                                  float (*vertexCos)[3],
+                                  uint numVerts,
+                                  const float *smooth_weights,
+                                  void *smooth_data)
+{
+  BLI_assert((int)numVerts == mesh->totvert);
+  UNUSED_VARS_NDEBUG(numVerts);
+
+  data->edges = mesh->medge;
+  /* Cached on the mesh, shared with other modifiers and later evaluations. */
+  data->vert_edges = BKE_mesh_runtime_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_VERT_EDGE);
+  data->vertexCos = vertexCos;
+  data->smooth_weights = smooth_weights;
+  data->smooth_data = smooth_data;
+}
+
+static void smooth_iter_settings_init(TaskParallelSettings *settings)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->min_iter_per_thread = 1024;
+}
+
 /* -------------------------------------------------------------------- */
 /* Simple Weighted Smoothing
  *
  * (average of surrounding verts)
  */
+
+static void smooth_iter__simple_gather_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothIterData *data = userdata;
+  const MeshElemMap *vert_edges = &data->vert_edges[i];
+  struct SmoothingData_Simple *sd = &((struct SmoothingData_Simple *)data->smooth_data)[i];
+  float(*vertexCos)[3] = data->vertexCos;
+
+  zero_v3(sd->delta);
+  for (int j = 0; j < vert_edges->count; j++) {
+    const MEdge *e = &data->edges[vert_edges->indices[j]];
+    float edge_dir[3];
+
+    sub_v3_v3v3(edge_dir, vertexCos[e->v2], vertexCos[e->v1]);
+
+    if (e->v1 == (uint)i) {
+      add_v3_v3(sd->delta, edge_dir);
+    }
+    else {
+      sub_v3_v3(sd->delta, edge_dir);
+    }
+  }
+}
+
+static void smooth_iter__simple_apply_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothIterData *data = userdata;
+  const struct SmoothingData_Simple *sd =
+      &((const struct SmoothingData_Simple *)data->smooth_data)[i];
+
+  madd_v3_v3fl(data->vertexCos[i], sd->delta, data->vertex_edge_factor[i]);
+}
+
 static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
                                 Mesh *mesh,
                                 float (*vertexCos)[3],
@@ -188,9 +282,8 @@ static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
   const MEdge *edges = mesh->medge;
   float *vertex_edge_count_div;
 
-  struct SmoothingData_Simple {
-    float delta[3];
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
+  struct SmoothingData_Simple *smooth_data = MEM_malloc_arrayN(
+      numVerts, sizeof(*smooth_data), __func__);
 
   vertex_edge_count_div = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
 
@@ -217,30 +310,25 @@ static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
     }
   }
 
+  SmoothIterData data;
+  smooth_iter_data_init(&data,
+                        mesh,
+                        vertexCos,
+                        numVerts,
+                        smooth_weights,
+                        smooth_data);
+  data.vertex_edge_factor = vertex_edge_count_div;
+  data.lambda = lambda;
+
+  TaskParallelSettings settings;
+  smooth_iter_settings_init(&settings);
+
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
   while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Simple *sd_v1;
-      struct SmoothingData_Simple *sd_v2;
-      float edge_dir[3];
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
-
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-    }
-
-    for (i = 0; i < numVerts; i++) {
-      struct SmoothingData_Simple *sd = &smooth_data[i];
-      madd_v3_v3fl(vertexCos[i], sd->delta, vertex_edge_count_div[i]);
-      /* zero for the next iteration (saves memset on entire array) */
-      memset(sd, 0, sizeof(*sd));
-    }
+    BLI_task_parallel_range(0, (int)numVerts, &data, smooth_iter__simple_gather_cb, &settings);
+    BLI_task_parallel_range(0, (int)numVerts, &data, smooth_iter__simple_apply_cb, &settings);
   }
 
   MEM_freeN(vertex_edge_count_div);
@@ -250,6 +338,64 @@ static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
 /* -------------------------------------------------------------------- */
 /* Edge-Length Weighted Smoothing
  */
+
+static void smooth_iter__length_weight_gather_cb(void *__restrict userdata,
+                                                 const int i,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const SmoothIterData *data = userdata;
+  const MeshElemMap *vert_edges = &data->vert_edges[i];
+  struct SmoothingData_Weighted *sd = &((struct SmoothingData_Weighted *)data->smooth_data)[i];
+  float(*vertexCos)[3] = data->vertexCos;
+
+  zero_v3(sd->delta);
+  sd->edge_length_sum = 0.0f;
+  for (int j = 0; j < vert_edges->count; j++) {
+    const MEdge *e = &data->edges[vert_edges->indices[j]];
+    float edge_dir[3];
+    float edge_dist;
+
+    sub_v3_v3v3(edge_dir, vertexCos[e->v2], vertexCos[e->v1]);
+    edge_dist = len_v3(edge_dir);
+
+    /* weight by distance */
+    mul_v3_fl(edge_dir, edge_dist);
+
+    if (e->v1 == (uint)i) {
+      add_v3_v3(sd->delta, edge_dir);
+    }
+    else {
+      sub_v3_v3(sd->delta, edge_dir);
+    }
+
+    sd->edge_length_sum += edge_dist;
+  }
+}
+
+static void smooth_iter__length_weight_apply_cb(void *__restrict userdata,
+                                                const int i,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const float eps = FLT_EPSILON * 10.0f;
+  const SmoothIterData *data = userdata;
+  const struct SmoothingData_Weighted *sd =
+      &((const struct SmoothingData_Weighted *)data->smooth_data)[i];
+
+  /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
+   * (mean average). */
+  const float div = sd->edge_length_sum * data->vertex_edge_factor[i];
+  if (div > eps) {
+    if (data->smooth_weights == NULL) {
+      /* first calculate the new location and interpolate, in one step */
+      madd_v3_v3fl(data->vertexCos[i], sd->delta, data->lambda / div);
+    }
+    else {
+      const float lambda_w = data->lambda * data->smooth_weights[i];
+      madd_v3_v3fl(data->vertexCos[i], sd->delta, lambda_w / div);
+    }
+  }
+}
+
 static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
                                        Mesh *mesh,
                                        float (*vertexCos)[3],
@@ -257,7 +403,6 @@ static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
                                        const float *smooth_weights,
                                        uint iterations)
 {
-  const float eps = FLT_EPSILON * 10.0f;
   const uint numEdges = (uint)mesh->totedge;
   /* note: the way this smoothing method works, its approx half as strong as the simple-smooth,
    * and 2.0 rarely spikes, double the value for consistent behavior. */
@@ -266,10 +411,8 @@ static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
   float *vertex_edge_count;
   uint i;
 
-  struct SmoothingData_Weighted {
-    float delta[3];
-    float edge_length_sum;
-  } *smooth_data = MEM_calloc_arrayN(numVerts, sizeof(*smooth_data), __func__);
+  struct SmoothingData_Weighted *smooth_data = MEM_malloc_arrayN(
+      numVerts, sizeof(*smooth_data), __func__);
 
   /* calculate as floats to avoid int->float conversion in #smooth_iter */
   vertex_edge_count = MEM_calloc_arrayN(numVerts, sizeof(float), __func__);
@@ -278,66 +421,27 @@ static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
     vertex_edge_count[edges[i].v2] += 1.0f;
   }
 
+  SmoothIterData data;
+  smooth_iter_data_init(&data,
+                        mesh,
+                        vertexCos,
+                        numVerts,
+                        smooth_weights,
+                        smooth_data);
+  data.vertex_edge_factor = vertex_edge_count;
+  data.lambda = lambda;
+
+  TaskParallelSettings settings;
+  smooth_iter_settings_init(&settings);
+
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
   while (iterations--) {
-    for (i = 0; i < numEdges; i++) {
-      struct SmoothingData_Weighted *sd_v1;
-      struct SmoothingData_Weighted *sd_v2;
-      float edge_dir[3];
-      float edge_dist;
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i].v2], vertexCos[edges[i].v1]);
-      edge_dist = len_v3(edge_dir);
-
-      /* weight by distance */
-      mul_v3_fl(edge_dir, edge_dist);
-
-      sd_v1 = &smooth_data[edges[i].v1];
-      sd_v2 = &smooth_data[edges[i].v2];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-
-      sd_v1->edge_length_sum += edge_dist;
-      sd_v2->edge_length_sum += edge_dist;
-    }
-
-    if (smooth_weights == NULL) {
-      /* fast-path */
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
-         * (mean average). */
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-#if 0
-          /* first calculate the new location */
-          mul_v3_fl(sd->delta, 1.0f / div);
-          /* then interpolate */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda);
-#else
-          /* do this in one step */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda / div);
-#endif
-        }
-        /* zero for the next iteration (saves memset on entire array) */
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
-    else {
-      for (i = 0; i < numVerts; i++) {
-        struct SmoothingData_Weighted *sd = &smooth_data[i];
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-          const float lambda_w = lambda * smooth_weights[i];
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda_w / div);
-        }
-
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
+    BLI_task_parallel_range(
+        0, (int)numVerts, &data, smooth_iter__length_weight_gather_cb, &settings);
+    BLI_task_parallel_range(
+        0, (int)numVerts, &data, smooth_iter__length_weight_apply_cb, &settings);
   }
 
   MEM_freeN(vertex_edge_count);
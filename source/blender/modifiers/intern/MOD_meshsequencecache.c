@@ -43,6 +43,9 @@
 #  include "ABC_alembic.h"
 #  include "BKE_global.h"
 #  include "BKE_lib_id.h"
+#  include "BKE_mesh.h"
+#  include "BKE_object.h"
+#  include "BLI_math_vector.h"
 #endif
 
 static void initData(ModifierData *md)
@@ -90,6 +93,40 @@ static bool isDisabled(const struct Scene *UNUSED(scene),
   return (mcmd->cache_file == NULL) || (mcmd->object_path[0] == '\0');
 }
 
+#ifdef WITH_ALEMBIC
+/* Box standing in for the cached geometry, so that the geometry itself is only read when
+ * rendering. */
+static Mesh *generate_bounds_mesh(Mesh *mesh, const float min[3], const float max[3])
+{
+  /* Quads of #BoundBox corners, facing outwards. */
+  static const int quads[6][4] = {
+      {0, 1, 2, 3}, {4, 7, 6, 5}, {0, 4, 5, 1}, {3, 2, 6, 7}, {0, 3, 7, 4}, {1, 5, 6, 2}};
+  BoundBox bb;
+  BKE_boundbox_init_from_minmax(&bb, min, max);
+
+  Mesh *result = BKE_mesh_new_nomain_from_template(mesh, 8, 0, 0, 24, 6);
+
+  for (int i = 0; i < 8; i++) {
+    copy_v3_v3(result->mvert[i].co, bb.vec[i]);
+  }
+
+  for (int i = 0; i < 6; i++) {
+    MPoly *mp = &result->mpoly[i];
+    mp->loopstart = i * 4;
+    mp->totloop = 4;
+
+    for (int j = 0; j < 4; j++) {
+      result->mloop[i * 4 + j].v = quads[i][j];
+    }
+  }
+
+  BKE_mesh_calc_edges(result, false, false);
+  result->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
+
+  return result;
+}
+#endif
+
 static Mesh *applyModifier(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mesh)
 {
 #ifdef WITH_ALEMBIC
@@ -114,6 +151,24 @@ static Mesh *applyModifier(ModifierData *md, const ModifierEvalContext *ctx, Mes
     }
   }
 
+  /* Outside of final renders, only read the bounds of the cached geometry. */
+  if ((mcmd->flag & MOD_MESHSEQ_VIEWPORT_BOUNDS) && (ctx->flag & MOD_APPLY_RENDER) == 0 &&
+      ctx->object->type == OB_MESH) {
+    float min[3], max[3];
+
+    if (ctx->flag & MOD_APPLY_ORCO) {
+      return mesh;
+    }
+    if (ABC_read_bounds(mcmd->reader, ctx->object, time, min, max, &err_str)) {
+      return generate_bounds_mesh(mesh, min, max);
+    }
+    if (err_str) {
+      modifier_setError(md, "%s", err_str);
+      return mesh;
+    }
+    /* Without bounds in the archive, fall back to reading the geometry. */
+  }
+
   /* If this invocation is for the ORCO mesh, and the mesh in Alembic hasn't changed topology, we
    * must return the mesh as-is instead of deforming it. */
   if (ctx->flag & MOD_APPLY_ORCO &&
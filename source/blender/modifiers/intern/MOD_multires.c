@@ -76,7 +76,7 @@ static void freeRuntimeData(void *runtime_data_v)
   }
   MultiresRuntimeData *runtime_data = (MultiresRuntimeData *)runtime_data_v;
   if (runtime_data->subdiv != NULL) {
-    BKE_subdiv_free(runtime_data->subdiv);
+    BKE_subdiv_cache_release(runtime_data->subdiv);
   }
   MEM_freeN(runtime_data);
 }
@@ -371,6 +371,21 @@ static void weld_assert_poly_len(const WeldPoly *wp, const WeldLoop *wloop)
 /** \name Weld Vert API
  * \{ */
 
+/**
+ * Find the destination (root) of the group \a v belongs to, compressing the path on the way.
+ */
+static uint weld_vert_dest_find(uint *vert_dest_map, uint v)
+{
+  uint v_dst = vert_dest_map[v];
+  while (v_dst != v) {
+    const uint v_dst_next = vert_dest_map[v_dst];
+    vert_dest_map[v] = v_dst_next;
+    v = v_dst;
+    v_dst = v_dst_next;
+  }
+  return v_dst;
+}
+
 static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
                                           const BVHTreeOverlap *overlap,
                                           const uint overlap_len,
@@ -384,6 +399,8 @@ static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
     *v_dest_iter = OUT_OF_CONTEXT;
   }
 
+  /* The destination map doubles as a union-find forest while the pairs are added,
+   * the root of each group is its destination vertex. */
   uint vert_kill_len = 0;
   const BVHTreeOverlap *overlap_iter = &overlap[0];
   for (uint i = 0; i < overlap_len; i++, overlap_iter++) {
@@ -399,39 +416,44 @@ static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
         vb_dst = indexA;
         r_vert_dest_map[indexB] = vb_dst;
       }
+      else {
+        vb_dst = weld_vert_dest_find(r_vert_dest_map, indexB);
+      }
       r_vert_dest_map[indexA] = vb_dst;
       vert_kill_len++;
     }
     else if (vb_dst == OUT_OF_CONTEXT) {
-      r_vert_dest_map[indexB] = va_dst;
+      r_vert_dest_map[indexB] = weld_vert_dest_find(r_vert_dest_map, indexA);
       vert_kill_len++;
     }
-    else if (va_dst != vb_dst) {
-      uint v_new, v_old;
-      if (va_dst < vb_dst) {
-        v_new = va_dst;
-        v_old = vb_dst;
-      }
-      else {
-        v_new = vb_dst;
-        v_old = va_dst;
-      }
-      BLI_assert(r_vert_dest_map[v_old] == v_old);
-      BLI_assert(r_vert_dest_map[v_new] == v_new);
-      vert_kill_len++;
-
-      const BVHTreeOverlap *overlap_iter_b = &overlap[0];
-      for (uint j = i + 1; j--; overlap_iter_b++) {
-        indexA = overlap_iter_b->indexA;
-        indexB = overlap_iter_b->indexB;
-        va_dst = r_vert_dest_map[indexA];
-        vb_dst = r_vert_dest_map[indexB];
-        if (ELEM(v_old, vb_dst, va_dst)) {
-          r_vert_dest_map[indexA] = v_new;
-          r_vert_dest_map[indexB] = v_new;
+    else {
+      va_dst = weld_vert_dest_find(r_vert_dest_map, indexA);
+      vb_dst = weld_vert_dest_find(r_vert_dest_map, indexB);
+      if (va_dst != vb_dst) {
+        /* Merge the groups, the lowest destination is kept. */
+        uint v_new, v_old;
+        if (va_dst < vb_dst) {
+          v_new = va_dst;
+          v_old = vb_dst;
+        }
+        else {
+          v_new = vb_dst;
+          v_old = va_dst;
         }
+        BLI_assert(r_vert_dest_map[v_old] == v_old);
+        BLI_assert(r_vert_dest_map[v_new] == v_new);
+        vert_kill_len++;
+
+        r_vert_dest_map[v_old] = v_new;
       }
-      BLI_assert(r_vert_dest_map[v_old] == v_new);
+    }
+  }
+
+  /* Flatten, so every vertex in context points to the destination of its group. */
+  v_dest_iter = &r_vert_dest_map[0];
+  for (uint i = 0; i < mvert_len; i++, v_dest_iter++) {
+    if (*v_dest_iter != OUT_OF_CONTEXT) {
+      *v_dest_iter = weld_vert_dest_find(r_vert_dest_map, i);
     }
   }
 
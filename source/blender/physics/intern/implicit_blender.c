@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -638,6 +639,116 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/* Per-vertex lists of the blocks of a big matrix, so a multiplication can be done
+ * one output vertex at a time (and in parallel) instead of scattering over all blocks. */
+typedef struct BlockVertexMap {
+  /* Blocks with `r == v`, all blocks. */
+  unsigned int *row_offs, *row_blocks;
+  /* Blocks with `c == v`, off-diagonal (spring) blocks only. */
+  unsigned int *col_offs, *col_blocks;
+} BlockVertexMap;
+
+static void block_vertex_map_fill(unsigned int *offs,
+                                  unsigned int *blocks,
+                                  const fmatrix3x3 *matrix,
+                                  unsigned int block_start,
+                                  const bool use_row)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int block_end = matrix[0].vcount + matrix[0].scount;
+
+  memset(offs, 0, sizeof(*offs) * (vcount + 1));
+  for (unsigned int i = block_start; i < block_end; i++) {
+    offs[(use_row ? matrix[i].r : matrix[i].c) + 1]++;
+  }
+  for (unsigned int v = 0; v < vcount; v++) {
+    offs[v + 1] += offs[v];
+  }
+  /* Blocks are added in ascending order, this keeps the summation order of the serial loop. */
+  for (unsigned int i = block_start; i < block_end; i++) {
+    const unsigned int v = use_row ? matrix[i].r : matrix[i].c;
+    blocks[offs[v]++] = i;
+  }
+  /* Shift the offsets back to the start of each list. */
+  memmove(offs + 1, offs, sizeof(*offs) * vcount);
+  offs[0] = 0;
+}
+
+static void create_block_vertex_map(BlockVertexMap *map, const fmatrix3x3 *matrix)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int scount = matrix[0].scount;
+
+  map->row_offs = MEM_mallocN(sizeof(*map->row_offs) * (vcount + 1), "cloth_block_row_offs");
+  map->row_blocks = MEM_mallocN(sizeof(*map->row_blocks) * (vcount + scount),
+                                "cloth_block_row_blocks");
+  map->col_offs = MEM_mallocN(sizeof(*map->col_offs) * (vcount + 1), "cloth_block_col_offs");
+  map->col_blocks = MEM_mallocN(sizeof(*map->col_blocks) * max_ii((int)scount, 1),
+                                "cloth_block_col_blocks");
+
+  block_vertex_map_fill(map->row_offs, map->row_blocks, matrix, 0, true);
+  block_vertex_map_fill(map->col_offs, map->col_blocks, matrix, vcount, false);
+}
+
+static void free_block_vertex_map(BlockVertexMap *map)
+{
+  MEM_freeN(map->row_offs);
+  MEM_freeN(map->row_blocks);
+  MEM_freeN(map->col_offs);
+  MEM_freeN(map->col_blocks);
+}
+
+typedef struct MulBlockVertexData {
+  float (*to)[3];
+  fmatrix3x3 *from;
+  lfVector *fLongVector;
+  const BlockVertexMap *map;
+} MulBlockVertexData;
+
+static void mul_bfmatrix_lfvector_mapped_cb(void *__restrict userdata,
+                                            const int v,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MulBlockVertexData *data = userdata;
+  const BlockVertexMap *map = data->map;
+  fmatrix3x3 *from = data->from;
+  lfVector *fLongVector = data->fLongVector;
+  float to[3] = {0.0f, 0.0f, 0.0f};
+  float temp[3] = {0.0f, 0.0f, 0.0f};
+
+  /* Lower triangle, multiplied with the transposed submatrices. */
+  for (unsigned int j = map->col_offs[v]; j < map->col_offs[v + 1]; j++) {
+    const unsigned int i = map->col_blocks[j];
+    muladd_fmatrixT_fvector(to, from[i].m, fLongVector[from[i].r]);
+  }
+  for (unsigned int j = map->row_offs[v]; j < map->row_offs[v + 1]; j++) {
+    const unsigned int i = map->row_blocks[j];
+    muladd_fmatrix_fvector(temp, from[i].m, fLongVector[from[i].c]);
+  }
+
+  add_v3_v3v3(data->to[v], to, temp);
+}
+
+/* Same as #mul_bfmatrix_lfvector, using a #BlockVertexMap created for the matrix layout.
+ * The result is identical, it's only computed per vertex. */
+static void mul_bfmatrix_lfvector_mapped(float (*to)[3],
+                                         fmatrix3x3 *from,
+                                         lfVector *fLongVector,
+                                         const BlockVertexMap *map)
+{
+  MulBlockVertexData data = {
+      .to = to,
+      .from = from,
+      .fLongVector = fLongVector,
+      .map = map,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(
+      0, (int)from[0].vcount, &data, mul_bfmatrix_lfvector_mapped_cb, &settings);
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix*/
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
@@ -840,6 +951,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const BlockVertexMap *lA_map,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -867,7 +979,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_mapped(AdV, lA, ldV, lA_map);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -890,7 +1002,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector_mapped(q, lA, c, lA_map);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1150,7 +1262,11 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* A and dFdX share the same block layout. */
+  BlockVertexMap map;
+  create_block_vertex_map(&map, data->A);
+
+  mul_bfmatrix_lfvector_mapped(dFdXmV, data->dFdX, data->V, &map);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1159,7 +1275,7 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &map, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -1171,6 +1287,7 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
   // advance velocities
   add_lfvector_lfvector(data->Vnew, data->V, data->dV, numverts);
 
+  free_block_vertex_map(&map);
   del_lfvector(dFdXmV);
 
   return result->status == BPH_SOLVER_SUCCESS;
@@ -80,6 +80,12 @@
 #define USE_MATHUTILS
 #define USE_STRING_COERCE
 
+/**
+ * Cache property lookups by attribute name for #pyrna_struct_getattro & #pyrna_struct_setattro,
+ * since scripts typically access the same few attributes of the same types over and over.
+ */
+#define USE_PYRNA_STRUCT_PROP_CACHE
+
 BPy_StructRNA *bpy_context_module = NULL; /* for fast access */
 
 static PyObject *pyrna_struct_Subtype(PointerRNA *ptr);
@@ -1670,8 +1676,12 @@ static PyObject *pyrna_func_to_py(const PointerRNA *ptr, FunctionRNA *func)
   return (PyObject *)pyfunc;
 }
 
-static int pyrna_py_to_prop(
-    PointerRNA *ptr, PropertyRNA *prop, void *data, PyObject *value, const char *error_prefix)
+static int pyrna_py_to_prop_ex(PointerRNA *ptr,
+                               PropertyRNA *prop,
+                               void *data,
+                               PyObject *value,
+                               const char *error_prefix,
+                               const bool do_update)
 {
   /* XXX hard limits should be checked here. */
   const int type = RNA_property_type(prop);
@@ -2201,13 +2211,31 @@ static int pyrna_py_to_prop(
   }
 
   /* Run RNA property functions. */
-  if (RNA_property_update_check(prop)) {
+  if (do_update && RNA_property_update_check(prop)) {
     RNA_property_update(BPy_GetContext(), ptr, prop);
   }
 
   return 0;
 }
 
+static int pyrna_py_to_prop(
+    PointerRNA *ptr, PropertyRNA *prop, void *data, PyObject *value, const char *error_prefix)
+{
+  return pyrna_py_to_prop_ex(ptr, prop, data, value, error_prefix, true);
+}
+
+/**
+ * Assign \a value to \a prop without running its update,
+ * for callers which update many properties at once (see #RNA_property_update_batch).
+ */
+int pyrna_py_to_prop_no_update(PointerRNA *ptr,
+                               PropertyRNA *prop,
+                               PyObject *value,
+                               const char *error_prefix)
+{
+  return pyrna_py_to_prop_ex(ptr, prop, NULL, value, error_prefix, false);
+}
+
 static PyObject *pyrna_prop_array_to_py_index(BPy_PropertyArrayRNA *self, int index)
 {
   PYRNA_PROP_CHECK_OBJ((BPy_PropertyRNA *)self);
@@ -4230,6 +4258,79 @@ static PyObject *pyrna_struct_dir(BPy_StructRNA *self)
   return ret;
 }
 
+#ifdef USE_PYRNA_STRUCT_PROP_CACHE
+
+/* Must be a power of two. */
+#  define PYRNA_STRUCT_PROP_CACHE_SIZE 512
+
+typedef struct PyRNAStructPropCacheItem {
+  StructRNA *type;
+  /** Owned reference, so the address can't be reused by another string while cached. */
+  PyObject *pyname;
+  /** NULL when the name isn't a property of the type. */
+  PropertyRNA *prop;
+} PyRNAStructPropCacheItem;
+
+static struct {
+  PyRNAStructPropCacheItem items[PYRNA_STRUCT_PROP_CACHE_SIZE];
+  /** Value of #RNA_define_generation the items were looked up with. */
+  unsigned int generation;
+} pyrna_struct_prop_cache = {{{NULL}}};
+
+static void pyrna_struct_prop_cache_clear(void)
+{
+  for (int i = 0; i < PYRNA_STRUCT_PROP_CACHE_SIZE; i++) {
+    PyRNAStructPropCacheItem *item = &pyrna_struct_prop_cache.items[i];
+    Py_CLEAR(item->pyname);
+    item->type = NULL;
+    item->prop = NULL;
+  }
+}
+
+/**
+ * Same as #RNA_struct_find_property, for the (typically interned) attribute name \a pyname.
+ * Items are matched by string object, so the lookup is only a pointer comparison.
+ */
+static PropertyRNA *pyrna_struct_find_property_cached(PointerRNA *ptr,
+                                                      PyObject *pyname,
+                                                      const char *name)
+{
+  /* ID property paths are looked up in the data, not the type. */
+  if (name[0] == '[') {
+    return RNA_struct_find_property(ptr, name);
+  }
+
+  /* Registering classes or properties may have changed or freed cached types. */
+  const unsigned int generation = RNA_define_generation();
+  if (pyrna_struct_prop_cache.generation != generation) {
+    pyrna_struct_prop_cache_clear();
+    pyrna_struct_prop_cache.generation = generation;
+  }
+
+  const uintptr_t hash = (((uintptr_t)ptr->type) >> 4) ^ (((uintptr_t)pyname) >> 4);
+  PyRNAStructPropCacheItem *item =
+      &pyrna_struct_prop_cache.items[hash & (PYRNA_STRUCT_PROP_CACHE_SIZE - 1)];
+
+  if (item->type == ptr->type && item->pyname == pyname) {
+    return item->prop;
+  }
+
+  PropertyRNA *prop = RNA_struct_find_property(ptr, name);
+
+  Py_INCREF(pyname);
+  Py_XDECREF(item->pyname);
+  item->type = ptr->type;
+  item->pyname = pyname;
+  item->prop = prop;
+
+  return prop;
+}
+
+#else
+#  define pyrna_struct_find_property_cached(ptr, pyname, name) \
+    RNA_struct_find_property(ptr, name)
+#endif /* USE_PYRNA_STRUCT_PROP_CACHE */
+
 /* ---------------getattr-------------------------------------------- */
 static PyObject *pyrna_struct_getattro(BPy_StructRNA *self, PyObject *pyname)
 {
@@ -4257,7 +4358,7 @@ static PyObject *pyrna_struct_getattro(BPy_StructRNA *self, PyObject *pyname)
       ret = PyObject_GenericGetAttr((PyObject *)self, pyname);
     }
   }
-  else if ((prop = RNA_struct_find_property(&self->ptr, name))) {
+  else if ((prop = pyrna_struct_find_property_cached(&self->ptr, pyname, name))) {
     ret = pyrna_prop_to_py(&self->ptr, prop);
   }
   /* RNA function only if callback is declared (no optional functions). */
@@ -4475,7 +4576,8 @@ static int pyrna_struct_setattro(BPy_StructRNA *self, PyObject *pyname, PyObject
     PyErr_SetString(PyExc_AttributeError, "bpy_struct: __setattr__ must be a string");
     return -1;
   }
-  else if (name[0] != '_' && (prop = RNA_struct_find_property(&self->ptr, name))) {
+  else if (name[0] != '_' &&
+           (prop = pyrna_struct_find_property_cached(&self->ptr, pyname, name))) {
     if (!RNA_property_editable_flag(&self->ptr, prop)) {
       PyErr_Format(PyExc_AttributeError,
                    "bpy_struct: attribute \"%.200s\" from \"%.200s\" is read-only",
@@ -5240,6 +5342,30 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * Get a C-contiguous buffer from \a seq, so its memory can be read or written directly.
+ * Multi-dimensional buffers (a NumPy array shaped `(len(verts), 3)` for example)
+ * are accessed as a flat array of all their items.
+ *
+ * \return false when \a seq doesn't support the buffer protocol or isn't contiguous,
+ * in which case it's accessed as a sequence instead.
+ */
+static bool foreach_get_buffer(PyObject *seq, Py_buffer *buf)
+{
+  if (!PyObject_CheckBuffer(seq)) {
+    return false;
+  }
+  if (PyObject_GetBuffer(seq, buf, PyBUF_ND | PyBUF_FORMAT) == -1) {
+    PyErr_Clear();
+    return false;
+  }
+  if (buf->itemsize <= 0) {
+    PyBuffer_Release(buf);
+    return false;
+  }
+  return true;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5265,17 +5391,15 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 
   if (set) { /* Get the array from python. */
     buffer_is_compat = false;
-    if (PyObject_CheckBuffer(seq)) {
-      Py_buffer buf;
-      PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT);
-
+    Py_buffer buf;
+    if (foreach_get_buffer(seq, &buf)) {
       /* Check if the buffer matches. */
 
       buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
       if (buffer_is_compat) {
         ok = RNA_property_collection_raw_set(
-            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, buf.len / buf.itemsize);
       }
 
       PyBuffer_Release(&buf);
@@ -5321,17 +5445,15 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
   }
   else {
     buffer_is_compat = false;
-    if (PyObject_CheckBuffer(seq)) {
-      Py_buffer buf;
-      PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT);
-
+    Py_buffer buf;
+    if (foreach_get_buffer(seq, &buf)) {
       /* Check if the buffer matches, TODO - signed/unsigned types. */
 
       buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
       if (buffer_is_compat) {
         ok = RNA_property_collection_raw_get(
-            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, buf.len / buf.itemsize);
       }
 
       PyBuffer_Release(&buf);
@@ -8522,6 +8644,10 @@ void pyrna_free_types(void)
   PointerRNA ptr;
   PropertyRNA *prop;
 
+#ifdef USE_PYRNA_STRUCT_PROP_CACHE
+  pyrna_struct_prop_cache_clear();
+#endif
+
   /* Avoid doing this lookup for every getattr. */
   RNA_blender_rna_pointer_create(&ptr);
   prop = RNA_struct_find_property(&ptr, "structs");
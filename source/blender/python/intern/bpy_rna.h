@@ -201,6 +201,10 @@ int pyrna_pydict_to_props(PointerRNA *ptr,
                           const bool all_args,
                           const char *error_prefix);
 PyObject *pyrna_prop_to_py(PointerRNA *ptr, PropertyRNA *prop);
+int pyrna_py_to_prop_no_update(PointerRNA *ptr,
+                               PropertyRNA *prop,
+                               PyObject *value,
+                               const char *error_prefix);
 
 uint *pyrna_set_to_enum_bitmap(const struct EnumPropertyItem *items,
                                PyObject *value,
@@ -348,6 +348,104 @@ error:
   return ret;
 }
 
+PyDoc_STRVAR(bpy_batch_set_doc,
+             ".. method:: batch_set(ids, attribute, value)\n"
+             "\n"
+             "   Set the same property of several IDs at once.\n"
+             "\n"
+             "   Note that this function is quicker than setting the property of each ID "
+             "individually,\n"
+             "   since updates are run once all values are set, sharing notifiers between IDs.\n"
+             "\n"
+             "   :arg ids: Iterables of IDs (types can be mixed, as long as they all have "
+             "the property).\n"
+             "   :type ids: sequence\n"
+             "   :arg attribute: Name of the property, "
+             "custom properties can be set using ``'[\"name\"]'``.\n"
+             "   :type attribute: string\n"
+             "   :arg value: Value assigned to the property of every ID.\n");
+static PyObject *bpy_batch_set(PyObject *UNUSED(self), PyObject *args, PyObject *kwds)
+{
+  PyObject *ids;
+  const char *attr;
+  PyObject *value;
+
+  static const char *_keywords[] = {"ids", "attribute", "value", NULL};
+  static _PyArg_Parser _parser = {"OsO:batch_set", _keywords, 0};
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &ids, &attr, &value)) {
+    return NULL;
+  }
+
+  if (!pyrna_write_check()) {
+    PyErr_SetString(PyExc_AttributeError,
+                    "batch_set: writing to ID classes in this context is not allowed");
+    return NULL;
+  }
+
+  PyObject *ids_fast = PySequence_Fast(ids, "batch_set");
+  if (ids_fast == NULL) {
+    return NULL;
+  }
+
+  PyObject **ids_array = PySequence_Fast_ITEMS(ids_fast);
+  const Py_ssize_t ids_len = PySequence_Fast_GET_SIZE(ids_fast);
+
+  PointerRNA *ptrs = MEM_malloc_arrayN(ids_len, sizeof(*ptrs), __func__);
+  PropertyRNA **props = MEM_malloc_arrayN(ids_len, sizeof(*props), __func__);
+  int set_len = 0;
+  bool ok = true;
+
+  for (Py_ssize_t i = 0; i < ids_len; i++) {
+    ID *id;
+    if (!pyrna_id_FromPyObject(ids_array[i], &id)) {
+      PyErr_Format(
+          PyExc_TypeError, "Expected an ID type, not %.200s", Py_TYPE(ids_array[i])->tp_name);
+      ok = false;
+      break;
+    }
+
+    PointerRNA *ptr = &ptrs[set_len];
+    RNA_id_pointer_create(id, ptr);
+
+    PropertyRNA *prop = RNA_struct_find_property(ptr, attr);
+    if (prop == NULL) {
+      PyErr_Format(PyExc_AttributeError,
+                   "batch_set: \"%.200s\" has no attribute \"%.200s\"",
+                   id->name + 2,
+                   attr);
+      ok = false;
+      break;
+    }
+    if (!RNA_property_editable_flag(ptr, prop)) {
+      PyErr_Format(PyExc_AttributeError,
+                   "batch_set: attribute \"%.200s\" from \"%.200s\" is read-only",
+                   attr,
+                   id->name + 2);
+      ok = false;
+      break;
+    }
+
+    /* Updates run below, once all values are set. */
+    if (pyrna_py_to_prop_no_update(ptr, prop, value, "batch_set:") == -1) {
+      ok = false;
+      break;
+    }
+    props[set_len++] = prop;
+  }
+  Py_DECREF(ids_fast);
+
+  /* Also update IDs which were set before an error. */
+  RNA_property_update_batch(BPy_GetContext(), ptrs, props, set_len);
+
+  MEM_freeN(ptrs);
+  MEM_freeN(props);
+
+  if (!ok) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR(bpy_orphans_purge_doc,
              ".. method:: orphans_purge()\n"
              "\n"
@@ -402,6 +500,15 @@ int BPY_rna_id_collection_module(PyObject *mod_par)
   PyModule_AddObject(
       mod_par, "_rna_id_collection_batch_remove", PyCFunction_New(&batch_remove, NULL));
 
+  static PyMethodDef batch_set = {
+      "batch_set",
+      (PyCFunction)bpy_batch_set,
+      METH_VARARGS | METH_KEYWORDS,
+      bpy_batch_set_doc,
+  };
+
+  PyModule_AddObject(mod_par, "_rna_id_collection_batch_set", PyCFunction_New(&batch_set, NULL));
+
   static PyMethodDef orphans_purge = {
       "orphans_purge",
       (PyCFunction)bpy_orphans_purge,
@@ -140,6 +140,8 @@ typedef struct RenderResult {
 
   /* optional saved endresult on disk */
   int do_exr_tile;
+  /* store color passes of the saved endresult as half float */
+  int do_exr_tile_half;
 
   /* for render results in Image, verify validity for sequences */
   int framenr;
@@ -65,7 +65,9 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_alloca.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -327,8 +329,8 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
   int hit_mesh = -1;
   float hit_distance = FLT_MAX;
 
-  BVHTreeRayHit *hits;
-  hits = MEM_mallocN(sizeof(BVHTreeRayHit) * tot_highpoly, "Bake Highpoly to Lowpoly: BVH Rays");
+  /* Called per pixel from multiple threads, avoid heap allocation. */
+  BVHTreeRayHit *hits = BLI_array_alloca(hits, tot_highpoly);
 
   for (i = 0; i < tot_highpoly; i++) {
     float co_high[3], dir_high[3];
@@ -431,7 +433,6 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
     pixel_array[pixel_id].object_id = -1;
   }
 
-  MEM_freeN(hits);
   return hit_mesh != -1;
 }
 
@@ -512,6 +513,101 @@ static TriTessFace *mesh_calc_tri_tessface(Mesh *me, bool tangent, Mesh *me_eval
   return triangles;
 }
 
+typedef struct BakeHighPolyRaycastData {
+  BakePixel *pixel_array_from;
+  BakePixel *pixel_array_to;
+  BakeHighPolyData *highpoly;
+  int tot_highpoly;
+  bool is_custom_cage;
+  bool is_cage;
+  float cage_extrusion;
+  float (*mat_low)[4];
+  float (*imat_low)[4];
+  float (*mat_cage)[4];
+  TriTessFace *tris_low;
+  TriTessFace *tris_cage;
+  TriTessFace **tris_high;
+  BVHTreeFromMesh *treeData;
+} BakeHighPolyRaycastData;
+
+static void bake_highpoly_raycast_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BakeHighPolyRaycastData *data = userdata;
+  BakePixel *pixel_array_from = data->pixel_array_from;
+  BakePixel *pixel_array_to = data->pixel_array_to;
+  float co[3];
+  float dir[3];
+  TriTessFace *tri_low;
+
+  const int primitive_id = pixel_array_from[i].primitive_id;
+
+  if (primitive_id == -1) {
+    pixel_array_to[i].primitive_id = -1;
+    return;
+  }
+
+  const float u = pixel_array_from[i].uv[0];
+  const float v = pixel_array_from[i].uv[1];
+
+  /* calculate from low poly mesh cage */
+  if (data->is_custom_cage) {
+    calc_point_from_barycentric_cage(data->tris_low,
+                                     data->tris_cage,
+                                     data->mat_low,
+                                     data->mat_cage,
+                                     primitive_id,
+                                     u,
+                                     v,
+                                     co,
+                                     dir);
+    tri_low = &data->tris_cage[primitive_id];
+  }
+  else if (data->is_cage) {
+    calc_point_from_barycentric_extrusion(data->tris_cage,
+                                          data->mat_low,
+                                          data->imat_low,
+                                          primitive_id,
+                                          u,
+                                          v,
+                                          data->cage_extrusion,
+                                          co,
+                                          dir,
+                                          true);
+    tri_low = &data->tris_cage[primitive_id];
+  }
+  else {
+    calc_point_from_barycentric_extrusion(data->tris_low,
+                                          data->mat_low,
+                                          data->imat_low,
+                                          primitive_id,
+                                          u,
+                                          v,
+                                          data->cage_extrusion,
+                                          co,
+                                          dir,
+                                          false);
+    tri_low = &data->tris_low[primitive_id];
+  }
+
+  /* cast ray */
+  if (!cast_ray_highpoly(data->treeData,
+                         tri_low,
+                         data->tris_high,
+                         pixel_array_from,
+                         pixel_array_to,
+                         data->mat_low,
+                         data->highpoly,
+                         co,
+                         dir,
+                         i,
+                         data->tot_highpoly)) {
+    /* if it fails mask out the original pixel array */
+    pixel_array_from[i].primitive_id = -1;
+  }
+}
+
 bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
                                           BakePixel pixel_array_from[],
                                           BakePixel pixel_array_to[],
@@ -525,8 +621,6 @@ bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
                                           struct Mesh *me_cage)
 {
   size_t i;
-  int primitive_id;
-  float u, v;
   float imat_low[4][4];
   bool is_cage = me_cage != NULL;
   bool result = true;
@@ -580,53 +674,28 @@ bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
     }
   }
 
-  for (i = 0; i < num_pixels; i++) {
-    float co[3];
-    float dir[3];
-    TriTessFace *tri_low;
-
-    primitive_id = pixel_array_from[i].primitive_id;
-
-    if (primitive_id == -1) {
-      pixel_array_to[i].primitive_id = -1;
-      continue;
-    }
-
-    u = pixel_array_from[i].uv[0];
-    v = pixel_array_from[i].uv[1];
-
-    /* calculate from low poly mesh cage */
-    if (is_custom_cage) {
-      calc_point_from_barycentric_cage(
-          tris_low, tris_cage, mat_low, mat_cage, primitive_id, u, v, co, dir);
-      tri_low = &tris_cage[primitive_id];
-    }
-    else if (is_cage) {
-      calc_point_from_barycentric_extrusion(
-          tris_cage, mat_low, imat_low, primitive_id, u, v, cage_extrusion, co, dir, true);
-      tri_low = &tris_cage[primitive_id];
-    }
-    else {
-      calc_point_from_barycentric_extrusion(
-          tris_low, mat_low, imat_low, primitive_id, u, v, cage_extrusion, co, dir, false);
-      tri_low = &tris_low[primitive_id];
-    }
-
-    /* cast ray */
-    if (!cast_ray_highpoly(treeData,
-                           tri_low,
-                           tris_high,
-                           pixel_array_from,
-                           pixel_array_to,
-                           mat_low,
-                           highpoly,
-                           co,
-                           dir,
-                           i,
-                           tot_highpoly)) {
-      /* if it fails mask out the original pixel array */
-      pixel_array_from[i].primitive_id = -1;
-    }
+  {
+    BakeHighPolyRaycastData data = {
+        .pixel_array_from = pixel_array_from,
+        .pixel_array_to = pixel_array_to,
+        .highpoly = highpoly,
+        .tot_highpoly = tot_highpoly,
+        .is_custom_cage = is_custom_cage,
+        .is_cage = is_cage,
+        .cage_extrusion = cage_extrusion,
+        .mat_low = mat_low,
+        .imat_low = imat_low,
+        .mat_cage = mat_cage,
+        .tris_low = tris_low,
+        .tris_cage = tris_cage,
+        .tris_high = tris_high,
+        .treeData = treeData,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, (int)num_pixels, &data, bake_highpoly_raycast_cb, &settings);
   }
 
   /* garbage collection */
@@ -162,6 +162,11 @@ void RE_engine_free(RenderEngine *engine)
     BLI_threaded_malloc_end();
   }
 
+  if (engine->depsgraph) {
+    /* Kept from the last render for persistent data. */
+    DEG_graph_free(engine->depsgraph);
+  }
+
   BLI_mutex_end(&engine->update_render_passes_mutex);
 
   MEM_freeN(engine);
@@ -504,13 +509,39 @@ RenderData *RE_engine_get_render_data(Render *re)
 }
 
 /* Depsgraph */
+
+/* With persistent data the depsgraph is kept between renders, so that the engine can
+ * query which data-blocks changed since the previous frame and only update those. */
+static bool engine_keep_depsgraph(RenderEngine *engine)
+{
+  const Render *re = engine->re;
+  return (re->r.mode & R_PERSISTENT_DATA) && !(re->r.scemode & R_BUTS_PREVIEW);
+}
+
+static void engine_depsgraph_free(RenderEngine *engine)
+{
+  DEG_graph_free(engine->depsgraph);
+
+  engine->depsgraph = NULL;
+}
+
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
   Main *bmain = engine->re->main;
   Scene *scene = engine->re->scene;
 
-  engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_debug_name_set(engine->depsgraph, "RENDER");
+  if (engine->depsgraph) {
+    /* Reuse the depsgraph of the previous render only for the same scene and view layer. */
+    if (DEG_get_input_scene(engine->depsgraph) != scene ||
+        DEG_get_input_view_layer(engine->depsgraph) != view_layer) {
+      engine_depsgraph_free(engine);
+    }
+  }
+
+  if (!engine->depsgraph) {
+    engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+    DEG_debug_name_set(engine->depsgraph, "RENDER");
+  }
 
   if (engine->re->r.scemode & R_BUTS_PREVIEW) {
     Depsgraph *depsgraph = engine->depsgraph;
@@ -520,15 +551,25 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
     DEG_ids_clear_recalc(bmain, depsgraph);
   }
   else {
-    BKE_scene_graph_update_for_newframe(engine->depsgraph, bmain);
+    /* When the depsgraph is kept, recalc flags are left for the engine to see what
+     * changed and cleared once the render is done. */
+    BKE_scene_graph_update_for_newframe_ex(
+        engine->depsgraph, bmain, !engine_keep_depsgraph(engine));
   }
 }
 
-static void engine_depsgraph_free(RenderEngine *engine)
+static void engine_depsgraph_exit(RenderEngine *engine)
 {
-  DEG_graph_free(engine->depsgraph);
+  if (engine->depsgraph == NULL) {
+    return;
+  }
 
-  engine->depsgraph = NULL;
+  if (engine_keep_depsgraph(engine)) {
+    DEG_ids_clear_recalc(engine->re->main, engine->depsgraph);
+  }
+  else {
+    engine_depsgraph_free(engine);
+  }
 }
 
 void RE_engine_frame_set(RenderEngine *engine, int frame, float subframe)
@@ -610,6 +651,10 @@ bool RE_bake_engine(Render *re,
   engine->tile_y = re->r.tiley;
 
   if (type->bake) {
+    /* Baking uses its own depsgraph, drop one kept from a previous render. */
+    if (engine->depsgraph) {
+      engine_depsgraph_free(engine);
+    }
     engine->depsgraph = depsgraph;
 
     /* update is only called so we create the engine.session */
@@ -787,7 +832,7 @@ int RE_engine_render(Render *re, int do_all)
         DRW_render_gpencil(engine, engine->depsgraph);
       }
 
-      engine_depsgraph_free(engine);
+      engine_depsgraph_exit(engine);
 
       if (RE_engine_test_break(engine)) {
         break;
@@ -882,6 +927,10 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
   if (DRW_render_check_grease_pencil(engine->depsgraph)) {
     return;
   }
+  /* The depsgraph is reused for the next render with persistent data. */
+  if (engine_keep_depsgraph(engine)) {
+    return;
+  }
   DEG_graph_free(engine->depsgraph);
   engine->depsgraph = NULL;
 }
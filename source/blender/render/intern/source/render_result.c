@@ -213,6 +213,14 @@ static void set_pass_full_name(
 
 /********************************** New **************************************/
 
+/* We only store RGBA passes as half float, for
+ * others precision loss can be problematic. */
+static bool render_pass_use_half_float(const char *chan_id)
+{
+  return (STREQ(chan_id, "RGB") || STREQ(chan_id, "RGBA") || STREQ(chan_id, "R") ||
+          STREQ(chan_id, "G") || STREQ(chan_id, "B") || STREQ(chan_id, "A"));
+}
+
 static RenderPass *render_layer_add_pass(RenderResult *rr,
                                          RenderLayer *rl,
                                          int channels,
@@ -235,6 +243,7 @@ static RenderPass *render_layer_add_pass(RenderResult *rr,
   set_pass_full_name(rpass->fullname, rpass->name, -1, rpass->view, rpass->chan_id);
 
   if (rl->exrhandle) {
+    const bool pass_half_float = rr->do_exr_tile_half && render_pass_use_half_float(chan_id);
     int a;
     for (a = 0; a < channels; a++) {
       char passname[EXR_PASS_MAXNAME];
@@ -245,7 +254,7 @@ static RenderPass *render_layer_add_pass(RenderResult *rr,
                           0,
                           0,
                           NULL,
-                          false);
+                          pass_half_float);
     }
   }
 
@@ -326,6 +335,7 @@ RenderResult *render_result_new(Render *re,
 
   if (savebuffers) {
     rr->do_exr_tile = true;
+    rr->do_exr_tile_half = (re->r.scemode & R_EXR_TILE_HALF) != 0;
   }
 
   render_result_views_new(rr, &re->r);
@@ -1004,12 +1014,7 @@ bool RE_WriteRenderResult(ReportList *reports,
         }
       }
 
-      /* We only store RGBA passes as half float, for
-       * others precision loss can be problematic. */
-      bool pass_half_float = half_float &&
-                             (STREQ(rp->chan_id, "RGB") || STREQ(rp->chan_id, "RGBA") ||
-                              STREQ(rp->chan_id, "R") || STREQ(rp->chan_id, "G") ||
-                              STREQ(rp->chan_id, "B") || STREQ(rp->chan_id, "A"));
+      bool pass_half_float = half_float && render_pass_use_half_float(rp->chan_id);
 
       for (int a = 0; a < rp->channels; a++) {
         /* Save Combined as RGBA if single layer save. */
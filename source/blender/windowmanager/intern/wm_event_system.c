@@ -3205,7 +3205,10 @@ void wm_event_do_handlers(bContext *C)
       /* builtin tweak, if action is break it removes tweak */
       wm_tweakevent_test(C, event, action);
 
-      if ((action & WM_HANDLER_BREAK) == 0) {
+      /* In-between mouse moves are only meant for modal operators that want every sample
+       * (painting, gestures), don't run the area and region handlers for each of them.
+       * With high rate tablets these can outnumber all other events by far. */
+      if ((action & WM_HANDLER_BREAK) == 0 && event->type != INBETWEEN_MOUSEMOVE) {
         ARegion *region;
 
         /* Note: setting subwin active should be done here, after modal handlers have been done */
@@ -640,7 +640,8 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
          * Further it's just confusing if a user loads a file and various preferences change. */
         &(const struct BlendFileReadParams){
             .is_startup = false,
-            .skip_flags = BLO_READ_SKIP_USERDEF,
+            .skip_flags = BLO_READ_SKIP_USERDEF |
+                          ((G.fileflags & G_FILE_NO_LIBRARIES) ? BLO_READ_SKIP_LINKED_DATA : 0),
         },
         reports);
 
@@ -2235,6 +2236,9 @@ static int wm_open_mainfile__open(bContext *C, wmOperator *op)
     G.fileflags |= G_FILE_NO_UI;
   }
 
+  SET_FLAG_FROM_TEST(
+      G.fileflags, !RNA_boolean_get(op->ptr, "load_libraries"), G_FILE_NO_LIBRARIES);
+
   if (RNA_boolean_get(op->ptr, "use_scripts")) {
     G.f |= G_FLAG_SCRIPT_AUTOEXEC;
   }
@@ -2324,6 +2328,7 @@ static void wm_open_mainfile_ui(bContext *UNUSED(C), wmOperator *op)
   const char *autoexec_text;
 
   uiItemR(layout, op->ptr, "load_ui", 0, NULL, ICON_NONE);
+  uiItemR(layout, op->ptr, "load_libraries", 0, NULL, ICON_NONE);
 
   col = uiLayoutColumn(layout, false);
   if (file_info->is_untrusted) {
@@ -2360,6 +2365,12 @@ void WM_OT_open_mainfile(wmOperatorType *ot)
 
   RNA_def_boolean(
       ot->srna, "load_ui", true, "Load UI", "Load user interface setup in the .blend file");
+  RNA_def_boolean(ot->srna,
+                  "load_libraries",
+                  true,
+                  "Load Libraries",
+                  "Read linked data from library files, when disabled linked data is kept as "
+                  "placeholders until its library is reloaded");
   RNA_def_boolean(ot->srna,
                   "use_scripts",
                   true,
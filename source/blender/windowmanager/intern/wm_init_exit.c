@@ -72,6 +72,7 @@
 #include "BKE_appdir.h"
 #include "BKE_sequencer.h" /* free seq clipboard */
 #include "BKE_studiolight.h"
+#include "BKE_subdiv.h"
 #include "BKE_material.h" /* BKE_material_copybuf_clear */
 #include "BKE_tracking.h" /* free tracking clipboard */
 #include "BKE_mask.h"     /* free mask clipboard */
@@ -352,7 +353,11 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   // glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
-  wm_history_file_read();
+  /* The recent files list is only used by the interface,
+   * and is never written back in background mode. */
+  if (!G.background) {
+    wm_history_file_read();
+  }
 
   /* allow a path of "", this is what happens when making a new file */
 #if 0
@@ -580,6 +585,7 @@ void WM_exit_ex(bContext *C, const bool do_python)
   }
 
   BKE_blender_free(); /* blender.c, does entire library and spacetypes */
+  BKE_subdiv_cache_free();
                       //  BKE_material_copybuf_free();
   ANIM_fcurves_copybuf_free();
   ANIM_drivers_copybuf_free();
@@ -392,6 +392,9 @@ int main(int argc,
 
   BLI_argsParse(ba, 1, NULL, NULL);
 
+  /* Image libraries were initialized before `--threads` was parsed. */
+  IMB_threads_update();
+
   main_signal_setup();
 
 #else
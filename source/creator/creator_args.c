@@ -598,6 +598,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-no-threads");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-time");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-pretty");
+  BLI_argsPrintArgDoc(ba, "--debug-depsgraph-profile");
   BLI_argsPrintArgDoc(ba, "--debug-gpu");
   BLI_argsPrintArgDoc(ba, "--debug-gpumem");
   BLI_argsPrintArgDoc(ba, "--debug-gpu-shaders");
@@ -617,6 +618,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_argsPrintArgDoc(ba, "--factory-startup");
   BLI_argsPrintArgDoc(ba, "--enable-library-override");
   BLI_argsPrintArgDoc(ba, "--enable-event-simulate");
+  BLI_argsPrintArgDoc(ba, "--memory-backend");
   printf("\n");
   BLI_argsPrintArgDoc(ba, "--env-system-datafiles");
   BLI_argsPrintArgDoc(ba, "--env-system-scripts");
@@ -979,6 +981,24 @@ static int arg_handle_debug_mode_generic_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_debug_depsgraph_profile_set_doc[] =
+    "<filename>\n"
+    "\tWrite timing of all dependency graph operations to a file in the Chrome trace format.";
+static int arg_handle_debug_depsgraph_profile_set(int argc,
+                                                  const char **argv,
+                                                  void *UNUSED(data))
+{
+  const char *arg_id = "--debug-depsgraph-profile";
+  if (argc > 1) {
+    DEG_profile_begin(argv[1]);
+    return 1;
+  }
+  else {
+    printf("\nError: '%s' no args given.\n", arg_id);
+    return 0;
+  }
+}
+
 static const char arg_handle_debug_mode_io_doc[] =
     "\n\t"
     "Enable debug messages for I/O (collada, ...).";
@@ -1478,6 +1498,32 @@ static int arg_handle_threads_set(int argc, const char **argv, void *UNUSED(data
   }
 }
 
+static const char arg_handle_memory_backend_set_doc[] =
+    "<backend>\n"
+    "\tSet how memory is allocated, valid options are:\n"
+    "\t'CACHED' (default): small blocks are kept in per-thread caches,\n"
+    "\t'SYSTEM': all blocks are allocated by the system allocator.";
+static int arg_handle_memory_backend_set(int argc, const char **argv, void *UNUSED(data))
+{
+  const char *arg_id = "--memory-backend";
+  if (argc > 1) {
+    if (STREQ(argv[1], "CACHED")) {
+      MEM_use_lockfree_backend(MEM_LOCKFREE_BACKEND_THREAD_CACHE);
+    }
+    else if (STREQ(argv[1], "SYSTEM")) {
+      MEM_use_lockfree_backend(MEM_LOCKFREE_BACKEND_SYSTEM);
+    }
+    else {
+      printf("\nError: unknown memory backend '%s %s'.\n", arg_id, argv[1]);
+    }
+    return 1;
+  }
+  else {
+    printf("\nError: you must specify a memory backend '%s'.\n", arg_id);
+    return 0;
+  }
+}
+
 static const char arg_handle_verbosity_set_doc[] =
     "<verbose>\n"
     "\tSet logging verbosity level for debug messages which supports it.";
@@ -2166,6 +2212,12 @@ void main_args_setup(bContext *C, bArgs *ba)
               "--debug-depsgraph-pretty",
               CB_EX(arg_handle_debug_mode_generic_set, depsgraph_pretty),
               (void *)G_DEBUG_DEPSGRAPH_PRETTY);
+  BLI_argsAdd(ba,
+              1,
+              NULL,
+              "--debug-depsgraph-profile",
+              CB(arg_handle_debug_depsgraph_profile_set),
+              NULL);
   BLI_argsAdd(ba,
               1,
               NULL,
@@ -2237,6 +2289,7 @@ void main_args_setup(bContext *C, bArgs *ba)
 
   BLI_argsAdd(ba, 4, "-F", "--render-format", CB(arg_handle_image_type_set), C);
   BLI_argsAdd(ba, 1, "-t", "--threads", CB(arg_handle_threads_set), NULL);
+  BLI_argsAdd(ba, 1, NULL, "--memory-backend", CB(arg_handle_memory_backend_set), NULL);
   BLI_argsAdd(ba, 4, "-x", "--use-extension", CB(arg_handle_extension_set), C);
 
 #  undef CB
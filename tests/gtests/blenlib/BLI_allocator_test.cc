@@ -0,0 +1,108 @@
+#include "testing/testing.h"
+#include "BLI_allocator.h"
+#include "BLI_map.h"
+#include "BLI_vector.h"
+
+using BLI::ArenaAllocator;
+using BLI::ArenaAllocatorScope;
+using BLI::GuardedAllocator;
+using BLI::Map;
+using BLI::Vector;
+
+/* Fill a family of temporary containers, like a single evaluation step would. */
+template<typename Allocator> static void fill_containers(uint amount)
+{
+  for (uint i = 0; i < amount; i++) {
+    Vector<uint, 4, Allocator> vector;
+    Map<uint, uint, Allocator> map;
+    for (uint j = 0; j < 100; j++) {
+      vector.append(j);
+      map.add(j, i);
+    }
+    EXPECT_EQ(vector.size(), 100);
+    EXPECT_EQ(map.lookup(50), i);
+  }
+}
+
+TEST(arena_allocator, VectorAndMap)
+{
+  ArenaAllocatorScope scope;
+
+  Vector<int, 4, ArenaAllocator> vector;
+  for (int i = 0; i < 1000; i++) {
+    vector.append(i);
+  }
+  EXPECT_EQ(vector.size(), 1000);
+  EXPECT_EQ(vector[999], 999);
+
+  Map<int, int, ArenaAllocator> map;
+  for (int i = 0; i < 1000; i++) {
+    map.add(i, i * 2);
+  }
+  EXPECT_EQ(map.size(), 1000);
+  EXPECT_EQ(map.lookup(500), 1000);
+}
+
+TEST(arena_allocator, NestedScopes)
+{
+  ArenaAllocatorScope outer;
+  EXPECT_EQ(ArenaAllocator::active_arena(), outer.arena());
+  {
+    ArenaAllocatorScope inner;
+    EXPECT_EQ(ArenaAllocator::active_arena(), inner.arena());
+    Vector<int, 4, ArenaAllocator> vector = {1, 2, 3, 4, 5};
+    EXPECT_EQ(vector.size(), 5);
+  }
+  EXPECT_EQ(ArenaAllocator::active_arena(), outer.arena());
+}
+
+TEST(arena_allocator, AlignedAllocation)
+{
+  ArenaAllocatorScope scope;
+  ArenaAllocator allocator;
+  for (uint alignment = 1; alignment <= 128; alignment *= 2) {
+    void *ptr = allocator.allocate_aligned(3, alignment, __func__);
+    EXPECT_EQ((uintptr_t)ptr % alignment, 0);
+  }
+}
+
+/* Guarded allocator that counts how often it is used. */
+class CountingAllocator : public GuardedAllocator {
+ public:
+  static uint count;
+
+  void *allocate(uint size, const char *name)
+  {
+    count++;
+    return GuardedAllocator::allocate(size, name);
+  }
+
+  void *allocate_aligned(uint size, uint alignment, const char *name)
+  {
+    count++;
+    return GuardedAllocator::allocate_aligned(size, alignment, name);
+  }
+};
+uint CountingAllocator::count = 0;
+
+/* Compare the number of guarded allocations made for the same work. */
+TEST(arena_allocator, AllocationCount)
+{
+  const uint amount = 1000;
+
+  CountingAllocator::count = 0;
+  fill_containers<CountingAllocator>(amount);
+  const uint guarded_count = CountingAllocator::count;
+
+  const uint blocks_before = MEM_get_memory_blocks_in_use();
+  uint arena_count;
+  {
+    ArenaAllocatorScope scope;
+    fill_containers<ArenaAllocator>(amount);
+    /* Only the arena's own buffers are allocated. */
+    arena_count = MEM_get_memory_blocks_in_use() - blocks_before;
+  }
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_before);
+
+  EXPECT_LT(arena_count * 100, guarded_count);
+}
@@ -0,0 +1,119 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_array_parallel.h"
+#include "BLI_rand.h"
+#include "BLI_threads.h"
+}
+
+/* Large enough to be split over multiple threads. */
+#define LARGE_LEN 200000
+
+TEST(array_parallel, PrefixSum)
+{
+  BLI_threadapi_init();
+
+  for (int len : {0, 1, 7, LARGE_LEN}) {
+    int *data = (int *)MEM_mallocN(sizeof(int) * (size_t)MAX2(len, 1), __func__);
+    for (int i = 0; i < len; i++) {
+      data[i] = i % 5;
+    }
+
+    const int total = BLI_parallel_prefix_sum_int(data, len);
+
+    int expected = 0;
+    for (int i = 0; i < len; i++) {
+      EXPECT_EQ(data[i], expected);
+      expected += i % 5;
+    }
+    EXPECT_EQ(total, expected);
+
+    MEM_freeN(data);
+  }
+
+  BLI_threadapi_exit();
+}
+
+TEST(array_parallel, RadixSortUint)
+{
+  BLI_threadapi_init();
+
+  for (int len : {1, 100, LARGE_LEN}) {
+    uint *keys = (uint *)MEM_mallocN(sizeof(uint) * (size_t)len, __func__);
+    int *values = (int *)MEM_mallocN(sizeof(int) * (size_t)len, __func__);
+    RNG *rng = BLI_rng_new(len);
+    for (int i = 0; i < len; i++) {
+      /* Many duplicates, and keys using all digits. */
+      keys[i] = (i % 2) ? BLI_rng_get_uint(rng) % 1000 : BLI_rng_get_uint(rng);
+      values[i] = i;
+    }
+    BLI_rng_free(rng);
+
+    BLI_parallel_radix_sort_uint(keys, values, len);
+
+    for (int i = 1; i < len; i++) {
+      EXPECT_LE(keys[i - 1], keys[i]);
+      if (keys[i - 1] == keys[i]) {
+        /* Stable. */
+        EXPECT_LT(values[i - 1], values[i]);
+      }
+    }
+
+    MEM_freeN(keys);
+    MEM_freeN(values);
+  }
+
+  BLI_threadapi_exit();
+}
+
+TEST(array_parallel, RadixSortUintNoValues)
+{
+  uint keys[] = {5, 3, 0xffffffff, 3, 0, 1 << 20};
+  BLI_parallel_radix_sort_uint(keys, NULL, ARRAY_SIZE(keys));
+
+  const uint expected[] = {0, 3, 3, 5, 1 << 20, 0xffffffff};
+  for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+    EXPECT_EQ(keys[i], expected[i]);
+  }
+}
+
+TEST(array_parallel, RadixSortFloat)
+{
+  BLI_threadapi_init();
+
+  const int len = LARGE_LEN;
+  float *keys = (float *)MEM_mallocN(sizeof(float) * (size_t)len, __func__);
+  int *values = (int *)MEM_mallocN(sizeof(int) * (size_t)len, __func__);
+  RNG *rng = BLI_rng_new(0);
+  for (int i = 0; i < len; i++) {
+    keys[i] = BLI_rng_get_float(rng) * 2000.0f - 1000.0f;
+    values[i] = i;
+  }
+  BLI_rng_free(rng);
+  keys[0] = -0.0f;
+  keys[1] = 0.0f;
+  const float key_10 = keys[10];
+
+  BLI_parallel_radix_sort_float(keys, values, len);
+
+  bool found_key_10 = false;
+  for (int i = 1; i < len; i++) {
+    EXPECT_LE(keys[i - 1], keys[i]);
+    if (values[i] == 10) {
+      EXPECT_EQ(keys[i], key_10);
+      found_key_10 = true;
+    }
+  }
+  EXPECT_TRUE(found_key_10);
+
+  MEM_freeN(keys);
+  MEM_freeN(values);
+
+  BLI_threadapi_exit();
+}
@@ -0,0 +1,100 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "atomic_ops.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_concurrent_hash.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+};
+
+#define NUM_ITEMS 10000
+/* Every key is added by several iterations, which are likely to run on different threads. */
+#define NUM_REPEAT 8
+
+TEST(concurrent_hash, AddLookupRemove)
+{
+  ConcurrentHash *ch = BLI_concurrent_hash_int_new(__func__);
+
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    EXPECT_TRUE(BLI_concurrent_hash_add(ch, POINTER_FROM_INT(i), POINTER_FROM_INT(i + 1)));
+  }
+  EXPECT_FALSE(BLI_concurrent_hash_add(ch, POINTER_FROM_INT(0), POINTER_FROM_INT(-1)));
+  EXPECT_EQ(BLI_concurrent_hash_len(ch), NUM_ITEMS);
+
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    EXPECT_EQ(POINTER_AS_INT(BLI_concurrent_hash_lookup(ch, POINTER_FROM_INT(i))), i + 1);
+  }
+  EXPECT_FALSE(BLI_concurrent_hash_haskey(ch, POINTER_FROM_INT(NUM_ITEMS)));
+
+  for (int i = 0; i < NUM_ITEMS; i += 2) {
+    EXPECT_TRUE(BLI_concurrent_hash_remove(ch, POINTER_FROM_INT(i), NULL, NULL));
+  }
+  EXPECT_EQ(BLI_concurrent_hash_len(ch), NUM_ITEMS / 2);
+
+  BLI_concurrent_hash_clear(ch, NULL, NULL);
+  EXPECT_EQ(BLI_concurrent_hash_len(ch), 0);
+
+  BLI_concurrent_hash_free(ch, NULL, NULL);
+}
+
+typedef struct ConcurrentHashTestData {
+  ConcurrentHash *ch;
+  int num_created;
+} ConcurrentHashTestData;
+
+static void *concurrent_hash_create_func(const void *key, void *userdata)
+{
+  ConcurrentHashTestData *data = (ConcurrentHashTestData *)userdata;
+  atomic_add_and_fetch_int32(&data->num_created, 1);
+  return POINTER_FROM_INT(POINTER_AS_INT(key) * 2 + 1);
+}
+
+static void concurrent_hash_add_func(void *__restrict userdata,
+                                     const int index,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ConcurrentHashTestData *data = (ConcurrentHashTestData *)userdata;
+  const int key = index % NUM_ITEMS;
+
+  void *val = BLI_concurrent_hash_lookup_or_create(
+      data->ch, POINTER_FROM_INT(key), concurrent_hash_create_func, data, NULL);
+  EXPECT_EQ(POINTER_AS_INT(val), key * 2 + 1);
+}
+
+static void concurrent_hash_sum_func(void *key, void *val, void *userdata)
+{
+  EXPECT_EQ(POINTER_AS_INT(val), POINTER_AS_INT(key) * 2 + 1);
+  atomic_add_and_fetch_int32((int32_t *)userdata, POINTER_AS_INT(key));
+}
+
+TEST(concurrent_hash, LookupOrCreateParallel)
+{
+  BLI_threadapi_init();
+
+  ConcurrentHashTestData data;
+  data.ch = BLI_concurrent_hash_int_new(__func__);
+  data.num_created = 0;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  BLI_task_parallel_range(0, NUM_ITEMS * NUM_REPEAT, &data, concurrent_hash_add_func, &settings);
+
+  /* Each value must have been created exactly once. */
+  EXPECT_EQ(data.num_created, NUM_ITEMS);
+  EXPECT_EQ(BLI_concurrent_hash_len(data.ch), NUM_ITEMS);
+
+  int32_t sum = 0;
+  BLI_concurrent_hash_foreach_parallel(data.ch, concurrent_hash_sum_func, &sum);
+  EXPECT_EQ(sum, NUM_ITEMS * (NUM_ITEMS - 1) / 2);
+
+  BLI_concurrent_hash_free(data.ch, NULL, NULL);
+
+  BLI_threadapi_exit();
+}
@@ -102,6 +102,8 @@ TEST_PARSE_FAIL(BadArgCount2, "sqrt(1,2)")
 TEST_PARSE_FAIL(BadArgCount3, "pi()")
 TEST_PARSE_FAIL(BadArgCount4, "max()")
 TEST_PARSE_FAIL(BadArgCount5, "min()")
+TEST_PARSE_FAIL(BadArgCount6, "log()")
+TEST_PARSE_FAIL(BadArgCount7, "log(1,2,3)")
 
 TEST_PARSE_FAIL(Truncated1, "(1+2")
 TEST_PARSE_FAIL(Truncated2, "1 if 2")
@@ -145,6 +147,8 @@ TEST_CONST(TenE, "1.e+1", 10.0)
 TEST_CONST(Half, ".5", 0.5)
 
 TEST_CONST(Pi, "pi", M_PI)
+TEST_CONST(E, "e", M_E)
+TEST_CONST(Tau, "tau", 2.0 * M_PI)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
 
@@ -157,6 +161,22 @@ TEST_EVAL(FMod, "fmod(x, 2)", 3.5, 1.5)
 TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
+TEST_CONST(Log, "log(e)", 1.0)
+TEST_CONST(LogBase, "log(8, 2)", 3.0)
+TEST_EVAL(LogBase, "log(x, 10)", 100.0, 2.0)
+
+TEST_CONST(Log2, "log2(8)", 3.0)
+TEST_CONST(Log10, "log10(1000)", 3.0)
+
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_EVAL(CopySign, "copysign(2, x)", -1.0, -2.0)
+TEST_EVAL(Tanh, "tanh(x)", 0.0, 0.0)
+
+TEST_CONST(Round1, "round(1.4)", 1.0)
+TEST_CONST(Round2, "round(-1.6)", -2.0)
+TEST_EVAL(Round3, "round(x)", 2.5, 2.0)
+TEST_EVAL(Round4, "round(x)", 3.5, 4.0)
+
 TEST_RESULT(Min1, "min(3,1,2)", 1.0)
 TEST_RESULT(Max1, "max(3,1,2)", 3.0)
 TEST_RESULT(Min2, "min(1,2,3)", 1.0)
@@ -314,6 +334,10 @@ TEST_ERROR(PowDomain1, "pow(-1, 0.5)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain2, "pow(-1, x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain3, "pow(-1, x)", 2.0, EXPR_PYLIKE_SUCCESS)
 
+TEST_ERROR(LogDomain1, "log(x)", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
+TEST_ERROR(LogDomain2, "log(x, 1)", 2.0, EXPR_PYLIKE_DIV_BY_ZERO)
+TEST_ERROR(LogDomain3, "acosh(x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
+
 TEST_ERROR(Mixed1, "sqrt(x) + 1 / max(0, x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(Mixed2, "sqrt(x) + 1 / max(0, x)", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(Mixed3, "sqrt(x) + 1 / max(0, x)", 1.0, EXPR_PYLIKE_SUCCESS)
@@ -0,0 +1,226 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+#include "BLI_flathash.h"
+#include "BLI_ghash.h"
+#include "BLI_rand.h"
+#include "PIL_time_utildefines.h"
+}
+
+/* Run the longest tests! */
+//#define FLATHASH_RUN_BIG
+
+/* Each test fills a #GHash and a #FlatHash with the same keys, so their timings can be compared
+ * directly. The keys are unique, as neither map checks for duplicates on insertion. */
+
+static unsigned int *flathash_tests_keys_random(const unsigned int nbr)
+{
+  unsigned int *data = (unsigned int *)MEM_mallocN(sizeof(*data) * (size_t)nbr, __func__);
+  GSet *used = BLI_gset_int_new_ex(__func__, nbr);
+  RNG *rng = BLI_rng_new(0);
+
+  for (unsigned int i = 0; i < nbr;) {
+    const unsigned int key = BLI_rng_get_uint(rng);
+    if (BLI_gset_add(used, POINTER_FROM_UINT(key))) {
+      data[i++] = key;
+    }
+  }
+
+  BLI_rng_free(rng);
+  BLI_gset_free(used, NULL);
+  return data;
+}
+
+static unsigned int *flathash_tests_keys_sequential(const unsigned int nbr)
+{
+  unsigned int *data = (unsigned int *)MEM_mallocN(sizeof(*data) * (size_t)nbr, __func__);
+  for (unsigned int i = 0; i < nbr; i++) {
+    data[i] = i;
+  }
+  return data;
+}
+
+static void ghash_tests(GHash *ghash, const unsigned int *data, const unsigned int nbr)
+{
+  {
+    TIMEIT_START(ghash_insert);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      BLI_ghash_insert(ghash, POINTER_FROM_UINT(data[i]), POINTER_FROM_UINT(i));
+    }
+
+    TIMEIT_END(ghash_insert);
+  }
+
+  {
+    TIMEIT_START(ghash_lookup);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      void *v = BLI_ghash_lookup(ghash, POINTER_FROM_UINT(data[i]));
+      EXPECT_EQ(POINTER_AS_UINT(v), i);
+    }
+
+    TIMEIT_END(ghash_lookup);
+  }
+
+  {
+    TIMEIT_START(ghash_remove);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      BLI_ghash_remove(ghash, POINTER_FROM_UINT(data[i]), NULL, NULL);
+    }
+
+    TIMEIT_END(ghash_remove);
+  }
+  EXPECT_EQ(BLI_ghash_len(ghash), 0);
+
+  BLI_ghash_free(ghash, NULL, NULL);
+}
+
+static void flathash_tests(FlatHash *fh, const unsigned int *data, const unsigned int nbr)
+{
+  {
+    TIMEIT_START(flathash_insert);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      BLI_flathash_insert(fh, POINTER_FROM_UINT(data[i]), POINTER_FROM_UINT(i));
+    }
+
+    TIMEIT_END(flathash_insert);
+  }
+
+  {
+    TIMEIT_START(flathash_lookup);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      void *v = BLI_flathash_lookup(fh, POINTER_FROM_UINT(data[i]));
+      EXPECT_EQ(POINTER_AS_UINT(v), i);
+    }
+
+    TIMEIT_END(flathash_lookup);
+  }
+
+  {
+    TIMEIT_START(flathash_remove);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      BLI_flathash_remove(fh, POINTER_FROM_UINT(data[i]), NULL, NULL);
+    }
+
+    TIMEIT_END(flathash_remove);
+  }
+  EXPECT_EQ(BLI_flathash_len(fh), 0);
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+static void int_tests(unsigned int *data, const char *id, const unsigned int nbr)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  ghash_tests(BLI_ghash_int_new(__func__), data, nbr);
+  flathash_tests(BLI_flathash_int_new(__func__), data, nbr);
+
+  MEM_freeN(data);
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(flathash, Int100000)
+{
+  int_tests(flathash_tests_keys_sequential(100000), "Int - 100000", 100000);
+}
+
+TEST(flathash, IntRand100000)
+{
+  int_tests(flathash_tests_keys_random(100000), "RandInt - 100000", 100000);
+}
+
+#ifdef FLATHASH_RUN_BIG
+TEST(flathash, IntRand10000000)
+{
+  int_tests(flathash_tests_keys_random(10000000), "RandInt - 10000000", 10000000);
+}
+#endif
+
+/* Ptr: addresses of consecutive 32 bytes elements, like the old pointers of the structs read
+ * from a file. They are inserted in order and looked up in random order. */
+
+#define PTR_TESTS_STRIDE 32
+
+static void ptr_tests(const char *id, const unsigned int nbr)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  char *data = (char *)MEM_mallocN(PTR_TESTS_STRIDE * (size_t)nbr, __func__);
+  void **keys = (void **)MEM_mallocN(sizeof(*keys) * (size_t)nbr, __func__);
+  void **keys_shuffled = (void **)MEM_mallocN(sizeof(*keys) * (size_t)nbr, __func__);
+  for (unsigned int i = 0; i < nbr; i++) {
+    keys[i] = keys_shuffled[i] = &data[PTR_TESTS_STRIDE * i];
+  }
+  {
+    RNG *rng = BLI_rng_new(0);
+    BLI_rng_shuffle_array(rng, keys_shuffled, sizeof(*keys), nbr);
+    BLI_rng_free(rng);
+  }
+
+  {
+    GHash *ghash = BLI_ghash_ptr_new(__func__);
+
+    TIMEIT_START(ghash_ptr_insert);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      BLI_ghash_insert(ghash, keys[i], keys[i]);
+    }
+
+    TIMEIT_END(ghash_ptr_insert);
+
+    TIMEIT_START(ghash_ptr_lookup);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      EXPECT_EQ(BLI_ghash_lookup(ghash, keys_shuffled[i]), keys_shuffled[i]);
+    }
+
+    TIMEIT_END(ghash_ptr_lookup);
+
+    BLI_ghash_free(ghash, NULL, NULL);
+  }
+
+  {
+    FlatHash *fh = BLI_flathash_ptr_new(__func__);
+
+    TIMEIT_START(flathash_ptr_insert);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      BLI_flathash_insert(fh, keys[i], keys[i]);
+    }
+
+    TIMEIT_END(flathash_ptr_insert);
+
+    TIMEIT_START(flathash_ptr_lookup);
+
+    for (unsigned int i = 0; i < nbr; i++) {
+      EXPECT_EQ(BLI_flathash_lookup(fh, keys_shuffled[i]), keys_shuffled[i]);
+    }
+
+    TIMEIT_END(flathash_ptr_lookup);
+
+    BLI_flathash_free(fh, NULL, NULL);
+  }
+
+  MEM_freeN(keys_shuffled);
+  MEM_freeN(keys);
+  MEM_freeN(data);
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(flathash, Ptr1000000)
+{
+  ptr_tests("Ptr - 1000000", 1000000);
+}
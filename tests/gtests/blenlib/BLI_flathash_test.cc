@@ -0,0 +1,174 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+#include "BLI_flathash.h"
+#include "BLI_ghash.h"
+}
+
+#define TESTCASE_SIZE 10000
+
+/* Spread the keys, so they don't all end up in consecutive slots. */
+#define KEY(i) POINTER_FROM_UINT((unsigned int)(i)*2654435761u)
+
+TEST(flathash, InsertLookup)
+{
+  FlatHash *fh = BLI_flathash_int_new(__func__);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_flathash_insert(fh, KEY(i), POINTER_FROM_INT(i));
+  }
+  EXPECT_EQ(BLI_flathash_len(fh), TESTCASE_SIZE);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, KEY(i))), i);
+  }
+  EXPECT_FALSE(BLI_flathash_haskey(fh, KEY(TESTCASE_SIZE)));
+  EXPECT_EQ(BLI_flathash_lookup(fh, KEY(TESTCASE_SIZE)), (void *)NULL);
+  EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup_default(fh, KEY(-1), POINTER_FROM_INT(-1))), -1);
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+TEST(flathash, Remove)
+{
+  FlatHash *fh = BLI_flathash_int_new(__func__);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_flathash_insert(fh, KEY(i), POINTER_FROM_INT(i));
+  }
+  for (int i = 0; i < TESTCASE_SIZE; i += 2) {
+    EXPECT_TRUE(BLI_flathash_remove(fh, KEY(i), NULL, NULL));
+  }
+  EXPECT_FALSE(BLI_flathash_remove(fh, KEY(0), NULL, NULL));
+  EXPECT_EQ(BLI_flathash_len(fh), TESTCASE_SIZE / 2);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(BLI_flathash_haskey(fh, KEY(i)), (i % 2) != 0);
+  }
+  for (int i = 1; i < TESTCASE_SIZE; i += 2) {
+    EXPECT_EQ(POINTER_AS_INT(BLI_flathash_popkey(fh, KEY(i), NULL)), i);
+  }
+  EXPECT_EQ(BLI_flathash_len(fh), 0);
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+/* Keep the number of entries small while inserting and removing many keys, deleted slots must
+ * be reused or cleaned up instead of filling up the table. */
+TEST(flathash, InsertRemoveCycle)
+{
+  FlatHash *fh = BLI_flathash_int_new(__func__);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_flathash_insert(fh, KEY(i), POINTER_FROM_INT(i));
+    if (i >= 10) {
+      EXPECT_TRUE(BLI_flathash_remove(fh, KEY(i - 10), NULL, NULL));
+    }
+  }
+  EXPECT_EQ(BLI_flathash_len(fh), 10);
+
+  for (int i = TESTCASE_SIZE - 10; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, KEY(i))), i);
+  }
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+TEST(flathash, ReinsertEnsure)
+{
+  FlatHash *fh = BLI_flathash_int_new(__func__);
+  void **val_p;
+
+  EXPECT_TRUE(BLI_flathash_reinsert(fh, KEY(1), POINTER_FROM_INT(1), NULL, NULL));
+  EXPECT_FALSE(BLI_flathash_reinsert(fh, KEY(1), POINTER_FROM_INT(2), NULL, NULL));
+  EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, KEY(1))), 2);
+
+  EXPECT_FALSE(BLI_flathash_ensure_p(fh, KEY(3), &val_p));
+  *val_p = POINTER_FROM_INT(3);
+  EXPECT_TRUE(BLI_flathash_ensure_p(fh, KEY(3), &val_p));
+  EXPECT_EQ(POINTER_AS_INT(*val_p), 3);
+
+  val_p = BLI_flathash_lookup_p(fh, KEY(1));
+  ASSERT_NE(val_p, (void **)NULL);
+  *val_p = POINTER_FROM_INT(4);
+  EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, KEY(1))), 4);
+  EXPECT_EQ(BLI_flathash_lookup_p(fh, KEY(5)), (void **)NULL);
+
+  EXPECT_EQ(BLI_flathash_len(fh), 2);
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+TEST(flathash, Iterator)
+{
+  FlatHash *fh = BLI_flathash_int_new_ex(__func__, TESTCASE_SIZE);
+  FlatHashIterator fh_iter;
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_flathash_insert(fh, POINTER_FROM_INT(i), POINTER_FROM_INT(i));
+  }
+  for (int i = 0; i < TESTCASE_SIZE; i += 3) {
+    BLI_flathash_remove(fh, POINTER_FROM_INT(i), NULL, NULL);
+  }
+
+  unsigned int count = 0;
+  FLATHASH_ITER (fh_iter, fh) {
+    const int key = POINTER_AS_INT(BLI_flathashIterator_getKey(&fh_iter));
+    EXPECT_NE(key % 3, 0);
+    EXPECT_EQ(POINTER_AS_INT(BLI_flathashIterator_getValue(&fh_iter)), key);
+    *BLI_flathashIterator_getValue_p(&fh_iter) = POINTER_FROM_INT(-key);
+    count++;
+  }
+  EXPECT_EQ(count, BLI_flathash_len(fh));
+
+  for (int i = 1; i < TESTCASE_SIZE; i += 3) {
+    EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, POINTER_FROM_INT(i))), -i);
+  }
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+TEST(flathash, Clear)
+{
+  FlatHash *fh = BLI_flathash_int_new(__func__);
+
+  for (int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_flathash_insert(fh, KEY(i), POINTER_FROM_INT(i));
+  }
+  BLI_flathash_clear(fh, NULL, NULL);
+  EXPECT_EQ(BLI_flathash_len(fh), 0);
+  EXPECT_FALSE(BLI_flathash_haskey(fh, KEY(0)));
+
+  BLI_flathash_insert(fh, KEY(0), POINTER_FROM_INT(1));
+  EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup(fh, KEY(0))), 1);
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+static unsigned int flathash_tests_badhash_p(const void *UNUSED(p))
+{
+  return 42;
+}
+
+/* All keys having the same hash must still work, only slower. */
+TEST(flathash, Collisions)
+{
+  FlatHash *fh = BLI_flathash_new(flathash_tests_badhash_p, BLI_ghashutil_intcmp, __func__);
+
+  for (int i = 0; i < 100; i++) {
+    BLI_flathash_insert(fh, POINTER_FROM_INT(i), POINTER_FROM_INT(i));
+  }
+  for (int i = 0; i < 100; i += 2) {
+    BLI_flathash_remove(fh, POINTER_FROM_INT(i), NULL, NULL);
+  }
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(POINTER_AS_INT(BLI_flathash_lookup_default(fh, POINTER_FROM_INT(i), NULL)),
+              (i % 2) ? i : 0);
+  }
+  EXPECT_EQ(BLI_flathash_len(fh), 50);
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
@@ -0,0 +1,132 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_kdopbvh.h"
+#include "BLI_math_geom.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+#include "BLI_threads.h"
+
+#include "PIL_time.h"
+}
+
+#include "stubs/bf_intern_eigen_stubs.h"
+
+#define NUM_RUN_AVERAGED 10
+
+/* Triangles scattered in a unit cube, the usual shape of a BVH over mesh faces. */
+static float (*tris_create(const int tris_len, struct RNG *rng))[3][3]
+{
+  float(*tris)[3][3] = (float(*)[3][3])MEM_mallocN(sizeof(*tris) * tris_len, __func__);
+  for (int i = 0; i < tris_len; i++) {
+    float center[3];
+    BLI_rng_get_float_unit_v3(rng, center);
+    mul_v3_fl(center, BLI_rng_get_float(rng));
+    for (int j = 0; j < 3; j++) {
+      float offset[3];
+      BLI_rng_get_float_unit_v3(rng, offset);
+      madd_v3_v3v3fl(tris[i][j], center, offset, 0.01f);
+    }
+  }
+  return tris;
+}
+
+static void tris_raycast_callback(void *userdata,
+                                  int index,
+                                  const BVHTreeRay *ray,
+                                  BVHTreeRayHit *hit)
+{
+  const float(*tris)[3][3] = (const float(*)[3][3])userdata;
+  float dist;
+  if (isect_ray_tri_v3(ray->origin, ray->direction, UNPACK3(tris[index]), &dist, NULL) &&
+      dist < hit->dist) {
+    hit->index = index;
+    hit->dist = dist;
+    madd_v3_v3v3fl(hit->co, ray->origin, ray->direction, dist);
+  }
+}
+
+static void kdopbvh_test_do(const char *id, const int tris_len, const int rays_len)
+{
+  BLI_threadapi_init();
+
+  struct RNG *rng = BLI_rng_new(1234);
+  float(*tris)[3][3] = tris_create(tris_len, rng);
+
+  float(*co)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  float(*dir)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  for (int i = 0; i < rays_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, co[i]);
+    mul_v3_fl(co[i], 2.0f);
+    negate_v3_v3(dir[i], co[i]);
+    normalize_v3(dir[i]);
+  }
+
+  BVHTree *tree = NULL;
+  double time_balance = 0.0;
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    if (tree != NULL) {
+      BLI_bvhtree_free(tree);
+    }
+    tree = BLI_bvhtree_new(tris_len, 0.0f, 4, 6);
+    for (int j = 0; j < tris_len; j++) {
+      BLI_bvhtree_insert(tree, j, &tris[j][0][0], 3);
+    }
+
+    const double init_time = PIL_check_seconds_timer();
+    BLI_bvhtree_balance(tree);
+    time_balance += PIL_check_seconds_timer() - init_time;
+  }
+  EXPECT_EQ(BLI_bvhtree_get_len(tree), tris_len);
+
+  int hits_num = 0;
+  double time_raycast = 0.0;
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    hits_num = 0;
+    const double init_time = PIL_check_seconds_timer();
+    for (int j = 0; j < rays_len; j++) {
+      BVHTreeRayHit hit;
+      hit.index = -1;
+      hit.dist = BVH_RAYCAST_DIST_MAX;
+      BLI_bvhtree_ray_cast(tree, co[j], dir[j], 0.0f, &hit, tris_raycast_callback, tris);
+      hits_num += (hit.index != -1);
+    }
+    time_raycast += PIL_check_seconds_timer() - init_time;
+  }
+  /* Make sure the test is meaningful. */
+  EXPECT_GT(hits_num, rays_len / 10);
+
+  printf("\t%s: balance done in %fs on average over %d runs\n",
+         id,
+         time_balance / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+  printf("\t%s: %d rays cast in %fs on average over %d runs\n",
+         id,
+         rays_len,
+         time_raycast / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(tris);
+  MEM_freeN(co);
+  MEM_freeN(dir);
+
+  BLI_threadapi_exit();
+}
+
+TEST(kdopbvh, Tris100K)
+{
+  kdopbvh_test_do("BVH - 100K triangles", 100000, 100000);
+}
+
+TEST(kdopbvh, Tris1M)
+{
+  kdopbvh_test_do("BVH - 1M triangles", 1000000, 100000);
+}
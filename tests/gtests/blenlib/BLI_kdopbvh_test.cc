@@ -11,6 +11,7 @@ extern "C" {
 #include "BLI_kdopbvh.h"
 #include "BLI_rand.h"
 #include "BLI_math_vector.h"
+#include "BLI_threads.h"
 }
 
 #include "stubs/bf_intern_eigen_stubs.h"
@@ -136,3 +137,204 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+/* Large enough to partition the first levels of the tree using threads. */
+TEST(kdopbvh, FindNearest_100000)
+{
+  BLI_threadapi_init();
+  find_nearest_points_test(100000, 1.0, 1000, 1234);
+  BLI_threadapi_exit();
+}
+
+TEST(kdopbvh, UpdateTree_100000)
+{
+  const int points_len = 100000;
+  const float offset[3] = {0.5f, -1.0f, 2.0f};
+
+  BLI_threadapi_init();
+
+  struct RNG *rng = BLI_rng_new(4321);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 4, 8);
+
+  void *mem = MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  float(*points)[3] = (float(*)[3])mem;
+
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  for (int i = 0; i < points_len; i++) {
+    add_v3_v3(points[i], offset);
+    EXPECT_TRUE(BLI_bvhtree_update_node(tree, i, points[i], NULL, 1));
+  }
+  BLI_bvhtree_update_tree(tree);
+
+  for (int i = 0; i < points_len; i++) {
+    const int j = BLI_bvhtree_find_nearest(tree, points[i], NULL, NULL, NULL);
+    EXPECT_GE(j, 0);
+    EXPECT_LT(j, points_len);
+    EXPECT_EQ_ARRAY(points[i], points[j], 3);
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+
+  BLI_threadapi_exit();
+}
+
+static void points_nearest_callback(void *userdata,
+                                    int index,
+                                    const float co[3],
+                                    BVHTreeNearest *nearest)
+{
+  const float(*points)[3] = (const float(*)[3])userdata;
+  const float dist_sq = len_squared_v3v3(co, points[index]);
+  if (dist_sq < nearest->dist_sq) {
+    nearest->index = index;
+    nearest->dist_sq = dist_sq;
+    copy_v3_v3(nearest->co, points[index]);
+  }
+}
+
+static void find_nearest_batch_test(bool use_callback, int flag)
+{
+  const int points_len = 10000;
+  const int queries_len = 5000;
+
+  struct RNG *rng = BLI_rng_new(1234);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 4, 8);
+
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  float(*queries)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * queries_len, __func__);
+  BVHTreeNearest *nearest = (BVHTreeNearest *)MEM_mallocN(sizeof(*nearest) * queries_len,
+                                                          __func__);
+  for (int i = 0; i < queries_len; i++) {
+    rng_v3_round(queries[i], 3, rng, 1000, 1.5f);
+    nearest[i].index = -1;
+    nearest[i].dist_sq = FLT_MAX;
+  }
+
+  BVHTree_NearestPointCallback callback = use_callback ? points_nearest_callback : NULL;
+  BLI_bvhtree_find_nearest_batch(tree, queries, queries_len, nearest, callback, points, flag);
+
+  for (int i = 0; i < queries_len; i++) {
+    BVHTreeNearest expected;
+    expected.index = -1;
+    expected.dist_sq = FLT_MAX;
+    BLI_bvhtree_find_nearest_ex(tree, queries[i], &expected, callback, points, flag);
+
+    EXPECT_NE(nearest[i].index, -1);
+    EXPECT_EQ(nearest[i].dist_sq, expected.dist_sq);
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+  MEM_freeN(queries);
+  MEM_freeN(nearest);
+}
+
+TEST(kdopbvh, FindNearestBatch)
+{
+  BLI_threadapi_init();
+  find_nearest_batch_test(false, 0);
+  find_nearest_batch_test(true, 0);
+  find_nearest_batch_test(true, BVH_NEAREST_OPTIMAL_ORDER);
+  BLI_threadapi_exit();
+}
+
+#define RAY_SPHERE_RADIUS 0.05f
+
+/* Hit spheres around the points, at the point of the ray closest to the center. */
+static void points_raycast_callback(void *userdata,
+                                    int index,
+                                    const BVHTreeRay *ray,
+                                    BVHTreeRayHit *hit)
+{
+  const float(*points)[3] = (const float(*)[3])userdata;
+  float offset[3];
+  sub_v3_v3v3(offset, points[index], ray->origin);
+  const float dist = dot_v3v3(offset, ray->direction);
+  const float dist_to_ray_sq = len_squared_v3(offset) - dist * dist;
+  if (dist >= 0.0f && dist < hit->dist &&
+      dist_to_ray_sq <= (RAY_SPHERE_RADIUS + ray->radius) * (RAY_SPHERE_RADIUS + ray->radius)) {
+    hit->index = index;
+    hit->dist = dist;
+    madd_v3_v3v3fl(hit->co, ray->origin, ray->direction, dist);
+  }
+}
+
+static void ray_cast_batch_test(bool use_callback, float radius)
+{
+  const int points_len = 10000;
+  const int rays_len = 5001;
+
+  struct RNG *rng = BLI_rng_new(1234);
+  BVHTree *tree = BLI_bvhtree_new(points_len, RAY_SPHERE_RADIUS, 4, 6);
+
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  float(*co)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  float(*dir)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  BVHTreeRayHit *hits = (BVHTreeRayHit *)MEM_mallocN(sizeof(*hits) * rays_len, __func__);
+  for (int i = 0; i < rays_len; i++) {
+    rng_v3_round(co[i], 3, rng, 1000, 2.0f);
+    BLI_rng_get_float_unit_v3(rng, dir[i]);
+    /* Include axis aligned rays. */
+    if (i % 10 == 0) {
+      zero_v3(dir[i]);
+      dir[i][i % 3] = (i % 20) ? 1.0f : -1.0f;
+    }
+    hits[i].index = -1;
+    hits[i].dist = BVH_RAYCAST_DIST_MAX;
+  }
+
+  BVHTree_RayCastCallback callback = use_callback ? points_raycast_callback : NULL;
+  BLI_bvhtree_ray_cast_batch(
+      tree, co, dir, rays_len, radius, hits, callback, points, BVH_RAYCAST_DEFAULT);
+
+  int hits_num = 0;
+  for (int i = 0; i < rays_len; i++) {
+    BVHTreeRayHit expected;
+    expected.index = -1;
+    expected.dist = BVH_RAYCAST_DIST_MAX;
+    BLI_bvhtree_ray_cast_ex(
+        tree, co[i], dir[i], radius, &expected, callback, points, BVH_RAYCAST_DEFAULT);
+
+    EXPECT_EQ(hits[i].index, expected.index);
+    EXPECT_EQ(hits[i].dist, expected.dist);
+    hits_num += (hits[i].index != -1);
+  }
+  /* Make sure the test is meaningful. */
+  EXPECT_GT(hits_num, rays_len / 10);
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+  MEM_freeN(co);
+  MEM_freeN(dir);
+  MEM_freeN(hits);
+}
+
+TEST(kdopbvh, RayCastBatch)
+{
+  BLI_threadapi_init();
+  ray_cast_batch_test(false, 0.0f);
+  ray_cast_batch_test(true, 0.0f);
+  ray_cast_batch_test(true, 0.01f);
+  BLI_threadapi_exit();
+}
@@ -0,0 +1,157 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+#include "BLI_threads.h"
+}
+
+/* Large enough for the tree to be balanced on multiple threads. */
+#define POINTS_LEN 50000
+#define QUERIES_LEN 2000
+
+static KDTree_3d *kdtree_random_new(RNG *rng, float (*co)[3], const int co_len)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(co_len);
+  for (int i = 0; i < co_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, co[i]);
+    mul_v3_fl(co[i], BLI_rng_get_float(rng));
+    BLI_kdtree_3d_insert(tree, i, co[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+  return tree;
+}
+
+static float nearest_dist_brute_force(const float (*co)[3], const int co_len, const float q[3])
+{
+  float dist_sq = FLT_MAX;
+  for (int i = 0; i < co_len; i++) {
+    dist_sq = min_ff(dist_sq, len_squared_v3v3(co[i], q));
+  }
+  return sqrtf(dist_sq);
+}
+
+TEST(kdtree, FindNearest)
+{
+  BLI_threadapi_init();
+
+  for (int co_len : {1, 5, 100, POINTS_LEN}) {
+    RNG *rng = BLI_rng_new(co_len);
+    float(*co)[3] = (float(*)[3])MEM_mallocN(sizeof(*co) * (size_t)co_len, __func__);
+    KDTree_3d *tree = kdtree_random_new(rng, co, co_len);
+
+    float(*queries)[3] = (float(*)[3])MEM_mallocN(sizeof(*queries) * QUERIES_LEN, __func__);
+    for (int i = 0; i < QUERIES_LEN; i++) {
+      BLI_rng_get_float_unit_v3(rng, queries[i]);
+    }
+
+    KDTreeNearest_3d *batch = (KDTreeNearest_3d *)MEM_mallocN(sizeof(*batch) * QUERIES_LEN,
+                                                              __func__);
+    BLI_kdtree_3d_find_nearest_batch(tree, queries, QUERIES_LEN, batch);
+
+    for (int i = 0; i < QUERIES_LEN; i++) {
+      const float dist = nearest_dist_brute_force(co, co_len, queries[i]);
+
+      KDTreeNearest_3d nearest;
+      const int index = BLI_kdtree_3d_find_nearest(tree, queries[i], &nearest);
+      EXPECT_EQ(index, nearest.index);
+      EXPECT_EQ(nearest.dist, dist);
+      EXPECT_V3_NEAR(nearest.co, co[index], 0.0f);
+
+      EXPECT_EQ(batch[i].dist, dist);
+      EXPECT_V3_NEAR(batch[i].co, co[batch[i].index], 0.0f);
+    }
+
+    MEM_freeN(batch);
+    MEM_freeN(queries);
+    MEM_freeN(co);
+    BLI_kdtree_3d_free(tree);
+    BLI_rng_free(rng);
+  }
+
+  BLI_threadapi_exit();
+}
+
+static bool range_search_count_cb(void *user_data,
+                                  int UNUSED(index),
+                                  const float UNUSED(co[3]),
+                                  float UNUSED(dist_sq))
+{
+  (*(int *)user_data)++;
+  return true;
+}
+
+TEST(kdtree, RangeSearch)
+{
+  BLI_threadapi_init();
+
+  const float range = 0.1f;
+  RNG *rng = BLI_rng_new(0);
+  float(*co)[3] = (float(*)[3])MEM_mallocN(sizeof(*co) * POINTS_LEN, __func__);
+  KDTree_3d *tree = kdtree_random_new(rng, co, POINTS_LEN);
+
+  for (int i = 0; i < 100; i++) {
+    float q[3];
+    BLI_rng_get_float_unit_v3(rng, q);
+    mul_v3_fl(q, 0.5f);
+
+    int expected = 0;
+    for (int j = 0; j < POINTS_LEN; j++) {
+      if (len_squared_v3v3(co[j], q) <= range * range) {
+        expected++;
+      }
+    }
+
+    KDTreeNearest_3d *nearest = NULL;
+    const int found = BLI_kdtree_3d_range_search(tree, q, &nearest, range);
+    EXPECT_EQ(found, expected);
+    for (int j = 0; j < found; j++) {
+      EXPECT_LE(nearest[j].dist, range);
+      if (j > 0) {
+        EXPECT_LE(nearest[j - 1].dist, nearest[j].dist);
+      }
+    }
+    MEM_SAFE_FREE(nearest);
+
+    int found_cb = 0;
+    BLI_kdtree_3d_range_search_cb(tree, q, range, range_search_count_cb, &found_cb);
+    EXPECT_EQ(found_cb, expected);
+  }
+
+  MEM_freeN(co);
+  BLI_kdtree_3d_free(tree);
+  BLI_rng_free(rng);
+
+  BLI_threadapi_exit();
+}
+
+/* Balancing again after inserting more points must not keep state from the old tree. */
+TEST(kdtree, Rebalance)
+{
+  const int co_len = 1000;
+  RNG *rng = BLI_rng_new(0);
+  float(*co)[3] = (float(*)[3])MEM_mallocN(sizeof(*co) * (size_t)co_len, __func__);
+  KDTree_3d *tree = BLI_kdtree_3d_new(co_len);
+
+  for (int i = 0; i < co_len; i++) {
+    BLI_rng_get_float_unit_v3(rng, co[i]);
+    BLI_kdtree_3d_insert(tree, i, co[i]);
+    if (ELEM(i, 10, 100, 500, co_len - 1)) {
+      BLI_kdtree_3d_balance(tree);
+      for (int j = 0; j <= i; j++) {
+        EXPECT_EQ(BLI_kdtree_3d_find_nearest(tree, co[j], NULL), j);
+      }
+    }
+  }
+
+  MEM_freeN(co);
+  BLI_kdtree_3d_free(tree);
+  BLI_rng_free(rng);
+}
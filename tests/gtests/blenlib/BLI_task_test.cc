@@ -206,6 +206,107 @@ TEST(task, MempoolIter)
   BLI_threadapi_exit();
 }
 
+/* *** Parallel allocation of mempool items. *** */
+
+static void task_mempool_alloc_func(void *userdata,
+                                    const int index,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  int **data = (int **)userdata;
+  BLI_mempool_threadlocal *tl = (BLI_mempool_threadlocal *)tls->userdata_chunk;
+
+  data[index] = (int *)BLI_mempool_threadlocal_alloc(tl);
+  *data[index] = index - 1;
+}
+
+static void task_mempool_alloc_finalize(void *__restrict UNUSED(userdata),
+                                        void *__restrict userdata_chunk)
+{
+  BLI_mempool_threadlocal_end((BLI_mempool_threadlocal *)userdata_chunk);
+}
+
+TEST(task, MempoolThreadedAlloc)
+{
+  int *data[NUM_ITEMS];
+  BLI_threadapi_init();
+  BLI_mempool *mempool = BLI_mempool_create(sizeof(*data[0]), 0, 32, BLI_MEMPOOL_ALLOW_ITER);
+
+  BLI_mempool_threadlocal tl;
+  BLI_mempool_threadlocal_begin(mempool, &tl);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 100;
+  settings.userdata_chunk = &tl;
+  settings.userdata_chunk_size = sizeof(tl);
+  settings.func_finalize = task_mempool_alloc_finalize;
+
+  BLI_task_parallel_range(0, NUM_ITEMS, data, task_mempool_alloc_func, &settings);
+
+  EXPECT_EQ(BLI_mempool_len(mempool), NUM_ITEMS);
+
+  /* Elements not allocated by threads are free, and can be used again. */
+  for (int i = 0; i < NUM_ITEMS; i += 3) {
+    BLI_mempool_free(mempool, data[i]);
+    data[i] = (int *)BLI_mempool_alloc(mempool);
+    *data[i] = i - 1;
+  }
+
+  int num_items = NUM_ITEMS;
+  BLI_task_parallel_mempool(mempool, &num_items, task_mempool_iter_func, true);
+
+  EXPECT_EQ(num_items, 0);
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    EXPECT_EQ(*data[i], i);
+  }
+
+  BLI_mempool_destroy(mempool);
+  BLI_threadapi_exit();
+}
+
+static void task_mempool_range_func(void *userdata,
+                                    const int index,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BLI_mempool_range *range = (BLI_mempool_range *)userdata;
+  int *elem = (int *)BLI_mempool_range_elem(range, (uint)index);
+  *elem = index;
+}
+
+TEST(task, MempoolRangeAlloc)
+{
+  BLI_threadapi_init();
+  BLI_mempool *mempool = BLI_mempool_create(sizeof(int), 100, 32, BLI_MEMPOOL_ALLOW_ITER);
+
+  BLI_mempool_range range;
+  BLI_mempool_range_alloc(mempool, NUM_ITEMS, &range);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 100;
+  BLI_task_parallel_range(0, NUM_ITEMS, &range, task_mempool_range_func, &settings);
+  BLI_mempool_range_end(&range);
+
+  EXPECT_EQ(BLI_mempool_len(mempool), NUM_ITEMS);
+
+  /* Iteration follows the order of the range. */
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(mempool, &iter);
+  int i = 0;
+  for (int *elem = (int *)BLI_mempool_iterstep(&iter); elem;
+       elem = (int *)BLI_mempool_iterstep(&iter), i++) {
+    EXPECT_EQ(*elem, i);
+  }
+  EXPECT_EQ(i, NUM_ITEMS);
+
+  int *elem = (int *)BLI_mempool_alloc(mempool);
+  *elem = NUM_ITEMS;
+  EXPECT_EQ(BLI_mempool_len(mempool), NUM_ITEMS + 1);
+
+  BLI_mempool_destroy(mempool);
+  BLI_threadapi_exit();
+}
+
 /* *** Parallel iterations over double-linked list items. *** */
 
 static void task_listbase_iter_func(void *userdata,
@@ -253,3 +354,56 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** Parallel ranges started from within pool tasks. *** */
+
+#define NUM_NESTED_TASKS 32
+
+static void task_nested_range_iter_func(void *userdata,
+                                        int index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  int *data = (int *)userdata;
+  atomic_add_and_fetch_int32(&data[index % 64], 1);
+}
+
+static void task_nested_range_pool_func(TaskPool *__restrict UNUSED(pool),
+                                        void *taskdata,
+                                        int UNUSED(threadid))
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  BLI_task_parallel_range(0, NUM_ITEMS, taskdata, task_nested_range_iter_func, &settings);
+}
+
+TEST(task, PoolNestedRange)
+{
+  int data[NUM_NESTED_TASKS][64] = {{0}};
+
+  /* Force several worker threads, so tasks actually get stolen between them. */
+  BLI_system_num_threads_override_set(4);
+  BLI_threadapi_init();
+
+  TaskPool *pool = BLI_task_pool_create(BLI_task_scheduler_get(), NULL);
+
+  for (int i = 0; i < NUM_NESTED_TASKS; i++) {
+    BLI_task_pool_push(pool, task_nested_range_pool_func, data[i], false, TASK_PRIORITY_LOW);
+  }
+
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+
+  /* All iterations of all nested ranges must have been processed once, and only once. */
+  for (int i = 0; i < NUM_NESTED_TASKS; i++) {
+    int num_iters = 0;
+    for (int j = 0; j < 64; j++) {
+      num_iters += data[i][j];
+    }
+    EXPECT_EQ(num_iters, NUM_ITEMS);
+  }
+
+  BLI_threadapi_exit();
+  BLI_system_num_threads_override_set(0);
+}
@@ -0,0 +1,189 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_math.h"
+#include "BLI_threads.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_customdata.h"
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+
+#include "PIL_time.h"
+}
+
+#include "bmesh.h"
+
+#define NUM_RUN_AVERAGED 5
+
+/* Index of the vertex and the edges of a grid of `res * res` quads. */
+#define GRID_VERT(res, x, y) ((y) * ((res) + 1) + (x))
+#define GRID_EDGE_X(res, x, y) ((y) * (res) + (x))
+#define GRID_EDGE_Y(res, x, y) ((res) * ((res) + 1) + (y) * ((res) + 1) + (x))
+
+static Mesh *mesh_grid_create(const int res)
+{
+  const int totvert = (res + 1) * (res + 1);
+  const int totedge = 2 * res * (res + 1);
+  const int totpoly = res * res;
+  Mesh *me = BKE_mesh_new_nomain(totvert, totedge, 0, totpoly * 4, totpoly);
+
+  /* Typical layers of scanned meshes. */
+  CustomData_add_layer(&me->ldata, CD_MLOOPUV, CD_CALLOC, NULL, me->totloop);
+  CustomData_add_layer(&me->vdata, CD_PROP_FLT, CD_CALLOC, NULL, me->totvert);
+  BKE_mesh_update_customdata_pointers(me, false);
+
+  for (int y = 0; y <= res; y++) {
+    for (int x = 0; x <= res; x++) {
+      MVert *mv = &me->mvert[GRID_VERT(res, x, y)];
+      mv->co[0] = (float)x;
+      mv->co[1] = (float)y;
+      mv->co[2] = sinf((float)(x + y));
+      mv->flag = ((x + y) % 7) ? 0 : SELECT;
+    }
+  }
+
+  for (int y = 0; y <= res; y++) {
+    for (int x = 0; x <= res; x++) {
+      if (x < res) {
+        MEdge *med = &me->medge[GRID_EDGE_X(res, x, y)];
+        med->v1 = GRID_VERT(res, x, y);
+        med->v2 = GRID_VERT(res, x + 1, y);
+        med->flag = ME_EDGEDRAW | ME_EDGERENDER;
+      }
+      if (y < res) {
+        MEdge *med = &me->medge[GRID_EDGE_Y(res, x, y)];
+        med->v1 = GRID_VERT(res, x, y);
+        med->v2 = GRID_VERT(res, x, y + 1);
+        med->flag = ME_EDGEDRAW | ME_EDGERENDER;
+      }
+    }
+  }
+
+  for (int y = 0; y < res; y++) {
+    for (int x = 0; x < res; x++) {
+      const int poly_index = y * res + x;
+      MPoly *mp = &me->mpoly[poly_index];
+      MLoop *ml = &me->mloop[poly_index * 4];
+      MLoopUV *mluv = &me->mloopuv[poly_index * 4];
+
+      mp->loopstart = poly_index * 4;
+      mp->totloop = 4;
+      mp->flag = ME_SMOOTH;
+
+      ml[0].v = GRID_VERT(res, x, y);
+      ml[0].e = GRID_EDGE_X(res, x, y);
+      ml[1].v = GRID_VERT(res, x + 1, y);
+      ml[1].e = GRID_EDGE_Y(res, x + 1, y);
+      ml[2].v = GRID_VERT(res, x + 1, y + 1);
+      ml[2].e = GRID_EDGE_X(res, x, y + 1);
+      ml[3].v = GRID_VERT(res, x, y + 1);
+      ml[3].e = GRID_EDGE_Y(res, x, y);
+
+      for (int j = 0; j < 4; j++) {
+        const float *co = me->mvert[ml[j].v].co;
+        mluv[j].uv[0] = co[0] / (float)res;
+        mluv[j].uv[1] = co[1] / (float)res;
+      }
+    }
+  }
+
+  BKE_mesh_calc_normals(me);
+
+  return me;
+}
+
+static void mesh_conv_test_do(const char *id, const int res)
+{
+  BKE_idtype_init();
+  BLI_threadapi_init();
+
+  Mesh *me_src = mesh_grid_create(res);
+  Mesh *me_dst = NULL;
+  double time_from_me = 0.0, time_to_me = 0.0;
+
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    const BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_ME(me_src);
+    BMeshCreateParams create_params = {0};
+    create_params.use_toolflags = true;
+    BMesh *bm = BM_mesh_create(&allocsize, &create_params);
+
+    BMeshFromMeshParams from_me_params = {0};
+    from_me_params.calc_face_normal = true;
+
+    double init_time = PIL_check_seconds_timer();
+    BM_mesh_bm_from_me(bm, me_src, &from_me_params);
+    time_from_me += PIL_check_seconds_timer() - init_time;
+
+    EXPECT_EQ(bm->totvert, me_src->totvert);
+    EXPECT_EQ(bm->totedge, me_src->totedge);
+    EXPECT_EQ(bm->totloop, me_src->totloop);
+    EXPECT_EQ(bm->totface, me_src->totpoly);
+
+    if (me_dst != NULL) {
+      BKE_id_free(NULL, me_dst);
+    }
+    me_dst = BKE_mesh_new_nomain(0, 0, 0, 0, 0);
+
+    BMeshToMeshParams to_me_params = {0};
+
+    init_time = PIL_check_seconds_timer();
+    BM_mesh_bm_to_me(NULL, bm, me_dst, &to_me_params);
+    time_to_me += PIL_check_seconds_timer() - init_time;
+
+    BM_mesh_free(bm);
+  }
+
+  /* The round trip keeps the mesh as it was. */
+  ASSERT_EQ(me_dst->totvert, me_src->totvert);
+  ASSERT_EQ(me_dst->totloop, me_src->totloop);
+  for (int i = 0; i < me_src->totvert; i++) {
+    EXPECT_V3_NEAR(me_dst->mvert[i].co, me_src->mvert[i].co, 0.0f);
+    EXPECT_EQ(me_dst->mvert[i].flag, me_src->mvert[i].flag);
+  }
+  for (int i = 0; i < me_src->totloop; i++) {
+    EXPECT_EQ(me_dst->mloop[i].v, me_src->mloop[i].v);
+    EXPECT_EQ(me_dst->mloop[i].e, me_src->mloop[i].e);
+    EXPECT_FLOAT_EQ(me_dst->mloopuv[i].uv[0], me_src->mloopuv[i].uv[0]);
+    EXPECT_FLOAT_EQ(me_dst->mloopuv[i].uv[1], me_src->mloopuv[i].uv[1]);
+  }
+
+  printf("\t%s: Mesh to BMesh done in %fs on average over %d runs\n",
+         id,
+         time_from_me / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+  printf("\t%s: BMesh to Mesh done in %fs on average over %d runs\n",
+         id,
+         time_to_me / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+
+  BKE_id_free(NULL, me_dst);
+  BKE_id_free(NULL, me_src);
+
+  BLI_threadapi_exit();
+}
+
+TEST(bmesh_mesh_conv, Grid100K)
+{
+  mesh_conv_test_do("Mesh conversion - 100K vertices", 316);
+}
+
+TEST(bmesh_mesh_conv, Grid1M)
+{
+  mesh_conv_test_do("Mesh conversion - 1M vertices", 1000);
+}
+
+TEST(bmesh_mesh_conv, Grid5M)
+{
+  mesh_conv_test_do("Mesh conversion - 5M vertices", 2236);
+}
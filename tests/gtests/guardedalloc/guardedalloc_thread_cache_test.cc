@@ -0,0 +1,88 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+namespace {
+
+void AllocFreeSmallBlocks()
+{
+  std::vector<void *> blocks;
+  for (int round = 0; round < 10; round++) {
+    for (size_t len = 0; len < 1024; len += 3) {
+      void *block = MEM_mallocN(len, "test");
+      memset(block, 1, len);
+      blocks.push_back(block);
+    }
+    for (void *block : blocks) {
+      MEM_freeN(block);
+    }
+    blocks.clear();
+  }
+}
+
+}  // namespace
+
+TEST(guardedalloc, LockfreeThreadCacheReuse)
+{
+  const size_t mem_in_use = MEM_get_memory_in_use();
+
+  AllocFreeSmallBlocks();
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+
+  int *data = (int *)MEM_mallocN(sizeof(int) * 16, "test");
+  memset(data, 1, sizeof(int) * 16);
+  MEM_freeN(data);
+
+  /* Cached blocks are cleared when allocated with calloc. */
+  data = (int *)MEM_callocN(sizeof(int) * 16, "test");
+  for (int i = 0; i < 16; i++) {
+    EXPECT_EQ(data[i], 0);
+  }
+  EXPECT_EQ(MEM_allocN_len(data), sizeof(int) * 16);
+  MEM_freeN(data);
+}
+
+TEST(guardedalloc, LockfreeThreadStatistics)
+{
+  const size_t mem_in_use = MEM_get_memory_in_use();
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+
+  std::vector<void *> blocks(8, nullptr);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&blocks, i]() {
+      AllocFreeSmallBlocks();
+      blocks[i] = MEM_callocN(100, "test");
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use + 8);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use + 8 * 100);
+  EXPECT_GE(MEM_get_peak_memory(), mem_in_use + 8 * 100);
+
+  /* Freeing from another thread than the allocating one. */
+  for (void *block : blocks) {
+    MEM_freeN(block);
+  }
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+}
+
+TEST(guardedalloc, LockfreeSystemBackend)
+{
+  void *block = MEM_mallocN(64, "test");
+  MEM_use_lockfree_backend(MEM_LOCKFREE_BACKEND_SYSTEM);
+  /* Blocks allocated with the cache can be freed with another backend. */
+  MEM_freeN(block);
+  AllocFreeSmallBlocks();
+  MEM_use_lockfree_backend(MEM_LOCKFREE_BACKEND_THREAD_CACHE);
+}